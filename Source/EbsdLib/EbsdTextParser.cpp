@@ -0,0 +1,317 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "EbsdTextParser.h"
+
+#include <cfloat>
+#include <cstdint>
+#include <cmath>
+
+#include <QtCore/QByteArray>
+
+#if EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_scheduler_init.h>
+#endif
+
+namespace
+{
+  // Every power of 10 up to 1e22 is exactly representable as a double which is what makes the
+  // fast path below give the correctly rounded result.
+  const double k_Pow10[] =
+  {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+  const uint64_t k_MaxExactMantissa = (static_cast<uint64_t>(1) << 53);
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  bool SlowParseFloat(const char* begin, const char* end, float& value, bool allowDecimalComma)
+  {
+    bool ok = false;
+    if(allowDecimalComma)
+    {
+      QByteArray token(begin, static_cast<int>(end - begin));
+      token.replace(',', '.');
+      value = token.toFloat(&ok);
+    }
+    else
+    {
+      value = QByteArray::fromRawData(begin, static_cast<int>(end - begin)).toFloat(&ok);
+    }
+    if(!ok)
+    {
+      value = 0.0f;
+    }
+    return ok;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+EbsdTextParser::EbsdTextParser()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+EbsdTextParser::~EbsdTextParser()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EbsdTextParser::ParseFloat(const char* begin, const char* end, float& value, bool allowDecimalComma)
+{
+  TrimLine(begin, end);
+  const char* p = begin;
+  bool negative = false;
+  if(p != end && (*p == '-' || *p == '+'))
+  {
+    negative = (*p == '-');
+    ++p;
+  }
+
+  uint64_t mantissa = 0;
+  int significantDigits = 0;
+  int exponent = 0;
+  bool anyDigits = false;
+  bool exact = true;
+
+  while(p != end && *p >= '0' && *p <= '9')
+  {
+    anyDigits = true;
+    if(significantDigits < 19)
+    {
+      mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+      if(mantissa != 0) { ++significantDigits; }
+    }
+    else
+    {
+      exact = false;
+    }
+    ++p;
+  }
+  if(p != end && (*p == '.' || (allowDecimalComma && *p == ',')))
+  {
+    ++p;
+    while(p != end && *p >= '0' && *p <= '9')
+    {
+      anyDigits = true;
+      if(significantDigits < 19)
+      {
+        mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+        if(mantissa != 0) { ++significantDigits; }
+        --exponent;
+      }
+      else
+      {
+        exact = false;
+      }
+      ++p;
+    }
+  }
+  if(!anyDigits)
+  {
+    // Could still be something like "nan" or "inf" so let Qt decide
+    return SlowParseFloat(begin, end, value, allowDecimalComma);
+  }
+  if(p != end && (*p == 'e' || *p == 'E'))
+  {
+    ++p;
+    bool negativeExp = false;
+    if(p != end && (*p == '-' || *p == '+'))
+    {
+      negativeExp = (*p == '-');
+      ++p;
+    }
+    if(p == end || *p < '0' || *p > '9')
+    {
+      value = 0.0f;
+      return false;
+    }
+    int expValue = 0;
+    while(p != end && *p >= '0' && *p <= '9')
+    {
+      if(expValue < 10000) { expValue = expValue * 10 + (*p - '0'); }
+      ++p;
+    }
+    exponent += negativeExp ? -expValue : expValue;
+  }
+  if(p != end)
+  {
+    value = 0.0f;
+    return false;
+  }
+
+  if(!exact || mantissa >= k_MaxExactMantissa || exponent < -22 || exponent > 22)
+  {
+    return SlowParseFloat(begin, end, value, allowDecimalComma);
+  }
+
+  double d = static_cast<double>(mantissa);
+  d = (exponent < 0) ? d / k_Pow10[-exponent] : d * k_Pow10[exponent];
+  if(d != 0.0 && (d < FLT_MIN || d > FLT_MAX))
+  {
+    // Out of range for a float. Qt has its own rules for these so defer to it.
+    return SlowParseFloat(begin, end, value, allowDecimalComma);
+  }
+  value = static_cast<float>(negative ? -d : d);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EbsdTextParser::ParseInt32(const char* begin, const char* end, int32_t& value)
+{
+  TrimLine(begin, end);
+  value = 0;
+  const char* p = begin;
+  bool negative = false;
+  if(p != end && (*p == '-' || *p == '+'))
+  {
+    negative = (*p == '-');
+    ++p;
+  }
+  if(p == end)
+  {
+    return false;
+  }
+  int64_t result = 0;
+  while(p != end)
+  {
+    if(*p < '0' || *p > '9')
+    {
+      return false;
+    }
+    result = result * 10 + (*p - '0');
+    if(result > static_cast<int64_t>(INT32_MAX) + 1)
+    {
+      return false;
+    }
+    ++p;
+  }
+  if(negative)
+  {
+    result = -result;
+  }
+  if(result > INT32_MAX || result < INT32_MIN)
+  {
+    return false;
+  }
+  value = static_cast<int32_t>(result);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const char* EbsdTextParser::SkipLines(const char* begin, const char* end, size_t numLines)
+{
+  const char* p = begin;
+  for(size_t i = 0; i < numLines && p != end; i++)
+  {
+    p = FindLineEnd(p, end);
+    if(p != end)
+    {
+      ++p;
+    }
+  }
+  return p;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<EbsdTextParser::LineChunk> EbsdTextParser::SplitIntoLineChunks(const char* begin, const char* end, size_t maxLines, size_t numChunks, size_t& totalLines)
+{
+  QVector<LineChunk> chunks;
+  totalLines = 0;
+  if(numChunks < 1)
+  {
+    numChunks = 1;
+  }
+  size_t targetBytes = static_cast<size_t>(end - begin) / numChunks + 1;
+
+  LineChunk chunk;
+  chunk.begin = begin;
+  chunk.end = begin;
+  chunk.firstLine = 0;
+  chunk.numLines = 0;
+
+  const char* p = begin;
+  while(p != end && totalLines < maxLines)
+  {
+    const char* lineEnd = FindLineEnd(p, end);
+    if(lineEnd == end && lineEnd == p)
+    {
+      break; // Empty unterminated run at the end of the buffer is not a line
+    }
+    p = (lineEnd == end) ? end : lineEnd + 1;
+    ++totalLines;
+    ++chunk.numLines;
+    chunk.end = p;
+    if(static_cast<size_t>(chunk.end - chunk.begin) >= targetBytes)
+    {
+      chunks.push_back(chunk);
+      chunk.begin = p;
+      chunk.end = p;
+      chunk.firstLine = totalLines;
+      chunk.numLines = 0;
+    }
+  }
+  if(chunk.numLines > 0)
+  {
+    chunks.push_back(chunk);
+  }
+  return chunks;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t EbsdTextParser::GetDefaultChunkCount()
+{
+#if EbsdLib_USE_PARALLEL_ALGORITHMS
+  return static_cast<size_t>(tbb::task_scheduler_init::default_num_threads()) * 4;
+#else
+  return 1;
+#endif
+}
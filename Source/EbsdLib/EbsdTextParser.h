@@ -0,0 +1,146 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _ebsdtextparser_h_
+#define _ebsdtextparser_h_
+
+#include <cstdint>
+#include <cstring>
+
+#include <QtCore/QVector>
+
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/EbsdSetGetMacros.h"
+
+/**
+ * @class EbsdTextParser EbsdTextParser.h EbsdLib/EbsdTextParser.h
+ * @brief This class holds the allocation free helpers used by the .ang and .ctf readers
+ * to parse the data section of a file directly out of a memory mapped buffer. The
+ * numeric conversions give the same values and the same success/failure results
+ * as QByteArray::toFloat() and QByteArray::toInt() so the readers keep their
+ * existing error codes.
+ *
+ * A "line" is a run of characters terminated by a '\n'. A final run that is not
+ * terminated by a '\n' counts as a line only if it is not empty.
+ */
+class EbsdLib_EXPORT EbsdTextParser
+{
+  public:
+    virtual ~EbsdTextParser();
+
+    /**
+     * @brief The LineChunk struct describes a contiguous range of whole lines
+     */
+    struct LineChunk
+    {
+      const char* begin;
+      const char* end;
+      size_t firstLine;
+      size_t numLines;
+    };
+
+    /**
+     * @brief ParseFloat Converts the characters in [begin, end) into a float
+     * @param begin Start of the token
+     * @param end One past the last character of the token
+     * @param value The parsed value. This is 0.0 if the token is not a valid number.
+     * @param allowDecimalComma If true a ',' is accepted as the decimal separator
+     * @return true if the complete token was a valid number
+     */
+    static bool ParseFloat(const char* begin, const char* end, float& value, bool allowDecimalComma = false);
+
+    /**
+     * @brief ParseInt32 Converts the characters in [begin, end) into a base 10 integer
+     * @param begin Start of the token
+     * @param end One past the last character of the token
+     * @param value The parsed value. This is 0 if the token is not a valid integer.
+     * @return true if the complete token was a valid integer that fits in 32 bits
+     */
+    static bool ParseInt32(const char* begin, const char* end, int32_t& value);
+
+    /**
+     * @brief FindLineEnd Returns a pointer to the '\n' that ends the line starting at p or end
+     * if the line is not terminated
+     */
+    static inline const char* FindLineEnd(const char* p, const char* end)
+    {
+      const void* nl = ::memchr(p, '\n', end - p);
+      return (nullptr == nl) ? end : static_cast<const char*>(nl);
+    }
+
+    /**
+     * @brief TrimLine Moves begin and end inward past any white space (including the '\r' of
+     * Windows line endings)
+     */
+    static inline void TrimLine(const char*& begin, const char*& end)
+    {
+      while(begin != end && IsSpace(*begin)) { ++begin; }
+      while(end != begin && IsSpace(*(end - 1))) { --end; }
+    }
+
+    static inline bool IsSpace(char c)
+    {
+      return (c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f');
+    }
+
+    /**
+     * @brief SkipLines Returns a pointer to the first character after numLines lines
+     */
+    static const char* SkipLines(const char* begin, const char* end, size_t numLines);
+
+    /**
+     * @brief SplitIntoLineChunks Splits at most the first maxLines lines of [begin, end) into
+     * approximately numChunks ranges of whole lines with similar byte counts. The
+     * line index of the first line in each chunk is recorded so the chunks can be
+     * parsed independently of each other.
+     * @param totalLines The number of lines covered by all the chunks
+     */
+    static QVector<LineChunk> SplitIntoLineChunks(const char* begin, const char* end, size_t maxLines, size_t numChunks, size_t& totalLines);
+
+    /**
+     * @brief GetDefaultChunkCount Returns the number of chunks to split a data section into
+     * so that each thread gets several chunks to balance the load.
+     */
+    static size_t GetDefaultChunkCount();
+
+  protected:
+    EbsdTextParser();
+
+  private:
+    EbsdTextParser(const EbsdTextParser&); // Copy Constructor Not Implemented
+    void operator=(const EbsdTextParser&); // Operator '=' Not Implemented
+};
+
+#endif /* _ebsdtextparser_h_ */
@@ -51,6 +51,10 @@ H5EbsdVolumeReader::H5EbsdVolumeReader() :
   m_SliceEnd(0),
   m_ManageMemory(true),
   m_NumberOfElements(0),
+  m_TransposeSliceAxes(false),
+  m_FlipSliceX(false),
+  m_FlipSliceY(false),
+  m_SliceObserver(nullptr),
   m_ReadAllArrays(true)
 {
 
@@ -134,3 +138,31 @@ void H5EbsdVolumeReader::readAllArrays(bool b)
 {
   m_ReadAllArrays = b;
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void H5EbsdVolumeReader::setArrayDestination(const QString& name, void* buffer, int numComponents, int componentIndex)
+{
+  ArrayDestination dest;
+  dest.buffer = buffer;
+  dest.numComponents = numComponents;
+  dest.componentIndex = componentIndex;
+  m_ArrayDestinations[name] = dest;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool H5EbsdVolumeReader::hasArrayDestination(const QString& name)
+{
+  return m_ArrayDestinations.contains(name);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void H5EbsdVolumeReader::clearArrayDestinations()
+{
+  m_ArrayDestinations.clear();
+}
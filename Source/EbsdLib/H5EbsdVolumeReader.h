@@ -37,6 +37,9 @@
 #ifndef _h5ebsdvolumereader_h_
 #define _h5ebsdvolumereader_h_
 
+#include <cstring>
+
+#include <QtCore/QMap>
 #include <QtCore/QString>
 #include <QtCore/QVector>
 #include <QtCore/QSet>
@@ -47,6 +50,22 @@
 #include "EbsdLib/H5EbsdVolumeInfo.h"
 
 
+/**
+ * @brief The H5EbsdSliceObserver class is notified by H5EbsdVolumeReader::loadData() each time a
+ * slice has been copied into the volume. This lets callers post-process each plane while it is
+ * still in the cache and while the read of the next slice is in flight.
+ */
+class EbsdLib_EXPORT H5EbsdSliceObserver
+{
+  public:
+    virtual ~H5EbsdSliceObserver() {}
+
+    /**
+     * @brief Called after every array of a slice has been copied into the volume
+     * @param zval The Z index of the plane in the volume that was just written
+     */
+    virtual void sliceLoaded(int64_t zval) = 0;
+};
 
 /**
  * @class H5EbsdVolumeReader H5EbsdVolumeReader EbsdLib/H5EbsdVolumeReader.h
@@ -106,6 +125,19 @@ class EbsdLib_EXPORT H5EbsdVolumeReader : public H5EbsdVolumeInfo
     /** @brief The number of elements in a column of data. This should be rows * columns */
     EBSD_INSTANCE_PROPERTY(size_t, NumberOfElements)
 
+    /**
+     * @brief These describe an in plane remap that loadData() applies while copying each slice. The
+     * X and Y axes of every plane are swapped first (which makes the volume YPoints wide) and then
+     * the flips are applied to the axes of the remapped plane. Together they cover every 90 degree
+     * rotation and mirror of the sample about the Z axis.
+     */
+    EBSD_INSTANCE_PROPERTY(bool, TransposeSliceAxes)
+    EBSD_INSTANCE_PROPERTY(bool, FlipSliceX)
+    EBSD_INSTANCE_PROPERTY(bool, FlipSliceY)
+
+    /** @brief Optional observer that is notified after each slice is copied. The reader does not own it. */
+    EBSD_INSTANCE_PROPERTY(H5EbsdSliceObserver*, SliceObserver)
+
     /**
     * @brief Returns the pointer to the data for a given feature
     * @param featureName The name of the feature to return the pointer to.
@@ -143,12 +175,111 @@ class EbsdLib_EXPORT H5EbsdVolumeReader : public H5EbsdVolumeInfo
     virtual void readAllArrays(bool b);
     virtual bool getReadAllArrays();
 
+    /**
+     * @brief Registers an externally owned buffer that loadData() copies the named array into
+     * instead of allocating a volume sized array of its own. The buffer must hold NumberOfElements
+     * tuples of numComponents values and the named array is written into component componentIndex
+     * of each tuple. Arrays with a destination are not allocated by initPointers() so getPointerByName()
+     * returns nullptr for them.
+     * @param name The name of the array (Ebsd::Ang::Phi1, Ebsd::Ctf::Phase, ...)
+     * @param buffer The destination buffer
+     * @param numComponents The number of components in each tuple of the destination
+     * @param componentIndex The component of each tuple that receives the values
+     */
+    virtual void setArrayDestination(const QString& name, void* buffer, int numComponents = 1, int componentIndex = 0);
+    virtual bool hasArrayDestination(const QString& name);
+    virtual void clearArrayDestinations();
+
   protected:
     H5EbsdVolumeReader();
 
+    /**
+     * @brief Copies a single slice of data into its place in the volume, applying the slice remap.
+     * Rows are moved with memcpy unless the remap or the registered destination make the
+     * destination elements non contiguous.
+     * @param name The name of the array
+     * @param slice The slice data as read from the file. Nothing is copied if this is nullptr
+     * @param volume The volume array allocated by initPointers(). Ignored if a destination was registered
+     * @param xpoints Number of X voxels in the volume before the remap
+     * @param ypoints Number of Y voxels in the volume before the remap
+     * @param zval The Z index of the slice in the volume
+     * @param xpointsslice Number of X voxels in the slice
+     * @param ypointsslice Number of Y voxels in the slice
+     * @param xstartspot X offset of the slice inside the volume
+     * @param ystartspot Y offset of the slice inside the volume
+     */
+    template<typename T>
+    void copySliceIntoVolume(const QString& name, const T* slice, T* volume, int64_t xpoints, int64_t ypoints, int64_t zval,
+                             int64_t xpointsslice, int64_t ypointsslice, int64_t xstartspot, int64_t ystartspot)
+    {
+      if(nullptr == slice) { return; }
+      T* dest = volume;
+      int64_t numComps = 1;
+      int64_t compIndex = 0;
+      QMap<QString, ArrayDestination>::const_iterator iter = m_ArrayDestinations.constFind(name);
+      if(iter != m_ArrayDestinations.constEnd())
+      {
+        dest = static_cast<T*>(iter.value().buffer);
+        numComps = iter.value().numComponents;
+        compIndex = iter.value().componentIndex;
+      }
+      if(nullptr == dest) { return; }
+
+      // Dimensions of a plane after the remap
+      int64_t width = m_TransposeSliceAxes ? ypoints : xpoints;
+      int64_t height = m_TransposeSliceAxes ? xpoints : ypoints;
+      int64_t planeOffset = zval * xpoints * ypoints;
+
+      for(int64_t j = 0; j < ypointsslice; j++)
+      {
+        const T* src = slice + j * xpointsslice;
+        int64_t col = xstartspot;
+        int64_t row = j + ystartspot;
+        // Index of the first element of the row and the distance between consecutive elements
+        int64_t index = 0;
+        int64_t step = 1;
+        if(m_TransposeSliceAxes)
+        {
+          int64_t x = m_FlipSliceX ? (width - 1 - row) : row;
+          int64_t y = m_FlipSliceY ? (height - 1 - col) : col;
+          index = planeOffset + y * width + x;
+          step = m_FlipSliceY ? -width : width;
+        }
+        else
+        {
+          int64_t x = m_FlipSliceX ? (width - 1 - col) : col;
+          int64_t y = m_FlipSliceY ? (height - 1 - row) : row;
+          index = planeOffset + y * width + x;
+          step = m_FlipSliceX ? -1 : 1;
+        }
+
+        if(numComps == 1 && step == 1)
+        {
+          ::memcpy(dest + index, src, sizeof(T) * xpointsslice);
+        }
+        else
+        {
+          T* dst = dest + index * numComps + compIndex;
+          int64_t dstStep = step * numComps;
+          for(int64_t i = 0; i < xpointsslice; i++)
+          {
+            dst[i * dstStep] = src[i];
+          }
+        }
+      }
+    }
+
   private:
+    struct ArrayDestination
+    {
+      void* buffer;
+      int numComponents;
+      int componentIndex;
+    };
+
     QSet<QString>         m_ArrayNames;
     bool                  m_ReadAllArrays;
+    QMap<QString, ArrayDestination> m_ArrayDestinations;
 
 
     H5EbsdVolumeReader(const H5EbsdVolumeReader&); // Copy Constructor Not Implemented
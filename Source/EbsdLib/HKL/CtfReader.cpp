@@ -47,6 +47,68 @@
 #include "CtfPhase.h"
 #include "EbsdLib/EbsdMacros.h"
 #include "EbsdLib/EbsdMath.h"
+#include "EbsdLib/EbsdTextParser.h"
+
+#if EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+/**
+ * @brief The CtfDataParserImpl class parses a set of chunks of whole data lines. Each
+ * chunk records the index of the first line that failed to parse along with the
+ * error code so the reader can report the same error the serial reader would.
+ */
+class CtfDataParserImpl
+{
+  public:
+    CtfDataParserImpl(CtfReader* reader, const EbsdTextParser::LineChunk* chunks, DataParser* const* columnParsers, int numColumns, int* errorCodes, size_t* errorLines) :
+      m_Reader(reader),
+      m_Chunks(chunks),
+      m_ColumnParsers(columnParsers),
+      m_NumColumns(numColumns),
+      m_ErrorCodes(errorCodes),
+      m_ErrorLines(errorLines)
+    {}
+    virtual ~CtfDataParserImpl() {}
+
+    void parse(size_t start, size_t end) const
+    {
+      for(size_t c = start; c < end; c++)
+      {
+        const EbsdTextParser::LineChunk& chunk = m_Chunks[c];
+        const char* p = chunk.begin;
+        for(size_t l = 0; l < chunk.numLines; l++)
+        {
+          const char* lineEnd = EbsdTextParser::FindLineEnd(p, chunk.end);
+          int err = m_Reader->parseDataLine(p, lineEnd, chunk.firstLine + l, m_ColumnParsers, m_NumColumns);
+          if(err < 0)
+          {
+            m_ErrorCodes[c] = err;
+            m_ErrorLines[c] = chunk.firstLine + l;
+            break;
+          }
+          p = (lineEnd == chunk.end) ? lineEnd : lineEnd + 1;
+        }
+      }
+    }
+
+#if EbsdLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      parse(r.begin(), r.end());
+    }
+#endif
+  private:
+    CtfReader* m_Reader;
+    const EbsdTextParser::LineChunk* m_Chunks;
+    DataParser* const* m_ColumnParsers;
+    int m_NumColumns;
+    int* m_ErrorCodes;
+    size_t* m_ErrorLines;
+};
 
 
 
@@ -302,7 +364,7 @@ int CtfReader::readFile()
     return -103;
   }
 
-  err = readData(in);
+  err = readData(in, headerLines.size());
 
   return err;
 }
@@ -318,7 +380,7 @@ void CtfReader::readOnlySliceIndex(int slice)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int CtfReader::readData(QFile& in)
+int CtfReader::readData(QFile& in, int numHeaderLines)
 {
   // Delete any currently existing pointers
   deletePointers();
@@ -328,7 +390,6 @@ int CtfReader::readData(QFile& in)
   size_t yCells = getYCells();
   size_t xCells = getXCells();
   int zCells = getZCells();
-  int zStart = 0;
   int zEnd = zCells;
   if(zCells < 0 || m_SingleSliceRead >= 0)
   {
@@ -404,50 +465,124 @@ int CtfReader::readData(QFile& in)
 
   }
 
-  // Now start reading the data line by line
-  int err = 0;
-  size_t counter = 0;
-  for (int slice = zStart; slice < zEnd; ++slice)
+  // Index the parsers by column so each line can be parsed without walking the map
+  QVector<DataParser*> columnParsers(size, nullptr);
+  QMapIterator<QString, DataParser::Pointer> iter(m_NamePointerMap);
+  while (iter.hasNext())
   {
-    for (size_t row = 0; row < yCells; ++row)
-    {
-      for (size_t col = 0; col < xCells; ++col)
-      {
-        buf = in.readLine(); // Read the line into a QByteArray including the newline
-        buf = buf.trimmed(); // Remove leading and trailing whitespace
+    iter.next();
+    columnParsers[iter.value()->getColumnIndex()] = iter.value().get();
+  }
+  int numColumns = m_NamePointerMap.size();
+
+  // Map the file so the data section can be parsed in place without copying each
+  // line into its own QByteArray. If the file can not be mapped fall back to reading
+  // it into memory in one go.
+  qint64 fileSize = in.size();
+  uchar* mapped = (fileSize > 0) ? in.map(0, fileSize) : nullptr;
+  QByteArray contents;
+  const char* fileBegin = nullptr;
+  const char* fileEnd = nullptr;
+  if(nullptr != mapped)
+  {
+    fileBegin = reinterpret_cast<const char*>(mapped);
+    fileEnd = fileBegin + fileSize;
+  }
+  else
+  {
+    in.seek(0);
+    contents = in.readAll();
+    fileBegin = contents.constData();
+    fileEnd = fileBegin + contents.size();
+  }
 
-        if ( (m_SingleSliceRead < 0) || (m_SingleSliceRead >= 0 && slice == m_SingleSliceRead) )
-        {
+  // Skip the header and the column header line
+  const char* dataBegin = EbsdTextParser::SkipLines(fileBegin, fileEnd, numHeaderLines + 1);
 
-          if(in.atEnd() == true && buf.isEmpty() == true) // We have to have read to the end of the file AND the buffer is empty
-            // otherwise we read EXACTLY the last line and we still need to parse the line.
-          {
-            //  ++counter; // We need to make sure this gets incremented before leaving
-            break;
-          }
-          err = parseDataLine(buf, row, col, counter, xCells, yCells);
-          if (err < 0) { return err; }
-          ++counter;
-        }
+  // A white space only line at the very end of the file is not a data line
+  const char* dataEnd = fileEnd;
+  const char* lastLineEnd = dataEnd;
+  if(lastLineEnd != dataBegin && *(lastLineEnd - 1) == '\n')
+  {
+    --lastLineEnd;
+  }
+  const char* lastLineBegin = lastLineEnd;
+  while(lastLineBegin != dataBegin && *(lastLineBegin - 1) != '\n')
+  {
+    --lastLineBegin;
+  }
+  const char* trimBegin = lastLineBegin;
+  const char* trimEnd = lastLineEnd;
+  EbsdTextParser::TrimLine(trimBegin, trimEnd);
+  if(lastLineBegin != dataEnd && trimBegin == trimEnd)
+  {
+    dataEnd = lastLineBegin;
+  }
 
-      }
-      if(in.atEnd() == true)
+  // When only a single slice is read the lines of the slices before it are skipped
+  size_t sliceLines = xCells * yCells;
+  size_t linesToRead = (zEnd > 0) ? static_cast<size_t>(zEnd) * sliceLines : 0;
+  if(m_SingleSliceRead >= 0)
+  {
+    dataBegin = EbsdTextParser::SkipLines(dataBegin, dataEnd, static_cast<size_t>(m_SingleSliceRead) * sliceLines);
+    linesToRead = (m_SingleSliceRead < zEnd) ? sliceLines : 0;
+  }
+
+  size_t numLines = 0;
+  QVector<EbsdTextParser::LineChunk> chunks = EbsdTextParser::SplitIntoLineChunks(dataBegin, dataEnd, linesToRead, EbsdTextParser::GetDefaultChunkCount(), numLines);
+  QVector<int> errorCodes(chunks.size(), 0);
+  QVector<size_t> errorLines(chunks.size(), 0);
+
+  CtfDataParserImpl parser(this, chunks.data(), columnParsers.data(), numColumns, errorCodes.data(), errorLines.data());
+#if EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, static_cast<size_t>(chunks.size()), 1), parser, tbb::simple_partitioner());
+#else
+  parser.parse(0, static_cast<size_t>(chunks.size()));
+#endif
+
+  // The chunks are in file order so the first chunk with an error holds the first bad line
+  int err = 0;
+  for(int c = 0; c < chunks.size(); c++)
+  {
+    if(errorCodes[c] < 0)
+    {
+      size_t errorLine = errorLines[c];
+      const char* lineBegin = EbsdTextParser::SkipLines(chunks[c].begin, chunks[c].end, errorLine - chunks[c].firstLine);
+      const char* lineEnd = EbsdTextParser::FindLineEnd(lineBegin, chunks[c].end);
+      EbsdTextParser::TrimLine(lineBegin, lineEnd);
+      size_t numTokens = 1;
+      for(const char* t = lineBegin; t != lineEnd; ++t)
       {
-        break;
+        if(*t == '\t') { ++numTokens; }
       }
-    }
-    //   std::cout << ".ctf Z Slice " << slice << " Reading complete." << std::endl;
-    if(m_SingleSliceRead >= 0 && slice == m_SingleSliceRead)
-    {
+      size_t row = (errorLine % sliceLines) / xCells;
+
+      setErrorCode(-107);
+      ss.string()->clear();
+      ss << "The number of tab delimited data columns (" << numTokens << ") does not match the number of tab delimited header columns (";
+      ss << numColumns << "). Please check the CTF file for mistakes.";
+      ss << "The error occurred at data row " << row << " which is " << row << " past ";
+      ss << "the column header row.";
+      ss << "\nThe CTF Reader will now abort reading any further in the file.";
+      setErrorMessage(*(ss.string()));
+      err = errorCodes[c];
       break;
     }
   }
 
-  if(counter != getNumberOfElements() && in.atEnd() == true)
+  if(nullptr != mapped)
+  {
+    in.unmap(mapped);
+  }
+  if (err < 0) { return err; }
+
+  // Running out of lines before all of them were read means the file ended early
+  if(numLines != getNumberOfElements() && numLines < linesToRead)
   {
     ss.string()->clear();
-    ss << "Premature End Of File reached.\n" << getFileName() << "\nNumRows=" << getNumberOfElements() << "\ncounter=" << counter
-       << "\nTotal Data Points Read=" << counter << "\n";
+    ss << "Premature End Of File reached.\n" << getFileName() << "\nNumRows=" << getNumberOfElements() << "\ncounter=" << numLines
+       << "\nTotal Data Points Read=" << numLines << "\n";
     setErrorMessage(ss.string());
     setErrorCode(-105);
     return -105;
@@ -579,47 +714,38 @@ int CtfReader::parseHeaderLines(QList<QByteArray>& headerLines)
 // -----------------------------------------------------------------------------
 //  Read the data part of the .ctf file
 // -----------------------------------------------------------------------------
-int CtfReader::parseDataLine(QByteArray& line, size_t row, size_t col, size_t offset, size_t xCells, size_t yCells )
+int CtfReader::parseDataLine(const char* begin, const char* end, size_t i, DataParser* const* columnParsers, int numColumns)
 {
   /* When reading the data there should be at least 11 cols of data.
+   * European style decimal commas are handled by the FloatParser.
    */
-  //  float x, y,  p1, p, p2, mad;
-  //  int phase, bCount, error, bc, bs;
-  //  size_t offset = i;
-
-  // Filter the line to convert European command style decimals to US/UK style points
-  //  QVector<char> cLine(line.size()+1);
-  //  ::memcpy( &(cLine.front()), line.c_str(), line.size() + 1);
-  for (int c = 0; c < line.size(); ++c)
-  {
-    if(line.at(c) == ',')
-    {
-      line[c] = '.';
-    }
-  }
+  EbsdTextParser::TrimLine(begin, end);
 
-  QList<QByteArray> tokens = line.split('\t');
-  if(tokens.size() != m_NamePointerMap.size())
+  int numTokens = 1;
+  const char* p = begin;
+  while(nullptr != (p = static_cast<const char*>(::memchr(p, '\t', end - p))))
   {
-    setErrorCode(-107);
-    QString msg;
-    QTextStream ss(&msg);
-    ss << "The number of tab delimited data columns (" << tokens.size() << ") does not match the number of tab delimited header columns (";
-    ss << m_NamePointerMap.size() << "). Please check the CTF file for mistakes.";
-    ss << "The error occurred at data row " << row << " which is " << row << " past ";
-    ss << "the column header row.";
-    ss << "\nThe CTF Reader will now abort reading any further in the file.";
-
-    setErrorMessage(msg);
-    return -106; // Could not allocate the memory
+    ++numTokens;
+    ++p;
   }
-  QMapIterator<QString, DataParser::Pointer> iter(m_NamePointerMap);
-  while (iter.hasNext())
+  if(numTokens != numColumns)
   {
-    iter.next();
+    return -106;
+  }
 
-    DataParser::Pointer dparser = iter.value();
-    dparser->parse(tokens[dparser->getColumnIndex()], offset);
+  p = begin;
+  for(int c = 0; c < numTokens; c++)
+  {
+    const char* tokenEnd = static_cast<const char*>(::memchr(p, '\t', end - p));
+    if(nullptr == tokenEnd)
+    {
+      tokenEnd = end;
+    }
+    if(nullptr != columnParsers[c])
+    {
+      columnParsers[c]->parse(p, tokenEnd, i);
+    }
+    p = (tokenEnd == end) ? end : tokenEnd + 1;
   }
   return 0;
 }
@@ -198,21 +198,28 @@ class EbsdLib_EXPORT CtfReader : public EbsdReader
     int parseHeaderLines(QList<QByteArray>& headerLines);
 
     /**
-       * @brief
-       * @param in The input file stream to read from
+       * @brief Reads the column header line and then the data section. The data section is
+       * memory mapped and split into chunks of whole lines that are parsed in parallel
+       * when TBB is available.
+       * @param in The input file stream to read from, positioned at the column header line
+       * @param numHeaderLines The number of lines that come before the column header line
        */
-    int readData(QFile& in);
+    int readData(QFile& in, int numHeaderLines);
 
     /**
-    * @brief Reads a line of Data from the ASCII based file
-    * @param line The current line of data
-    * @param row Current Row of Data
+    * @brief Reads a line of Data from the ASCII based file. This does not allocate or touch
+    * any shared state other than index i of each column so it is safe to call
+    * concurrently for different lines.
+    * @param begin Start of the line
+    * @param end One past the last character of the line
     * @param i The current index into a flat array
-    * @param xCells Number of X Data Points
-    * @param yCells Number of Y Data Points
-    * @param col The current Column of Data
+    * @param columnParsers The parser for each column, indexed by column
+    * @param numColumns The number of columns each line must have
+    * @return 0 on success or -106 if the number of columns does not match
     */
-    int parseDataLine(QByteArray& line, size_t row, size_t col, size_t i, size_t xCells, size_t yCells );
+    int parseDataLine(const char* begin, const char* end, size_t i, DataParser* const* columnParsers, int numColumns);
+
+    friend class CtfDataParserImpl;
 
     CtfReader(const CtfReader&); // Copy Constructor Not Implemented
     void operator=(const CtfReader&); // Operator '=' Not Implemented
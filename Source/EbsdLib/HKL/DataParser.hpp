@@ -39,6 +39,7 @@
 #include <QtCore/QString>
 
 #include "EbsdLib/EbsdSetGetMacros.h"
+#include "EbsdLib/EbsdTextParser.h"
 
 class DataParser
 {
@@ -58,7 +59,11 @@ class DataParser
     EBSD_INSTANCE_PROPERTY(int, ColumnIndex)
 
 
-    virtual void parse(const QByteArray& token, size_t index) {}
+    /**
+     * @brief parse Converts the token [begin, end) and stores the value at index. This
+     * does not allocate so it may be called concurrently for different indices.
+     */
+    virtual void parse(const char* begin, const char* end, size_t index) {}
   protected:
     DataParser() {}
 
@@ -112,10 +117,11 @@ class Int32Parser : public DataParser
     int32_t* getPointer(size_t offset) { return m_Ptr + offset; }
 
 
-    virtual void parse(const QByteArray& token, size_t index)
+    virtual void parse(const char* begin, const char* end, size_t index)
     {
-      bool ok = false;
-      m_Ptr[index] = token.toInt(&ok, 10);
+      int32_t value = 0;
+      EbsdTextParser::ParseInt32(begin, end, value);
+      m_Ptr[index] = value;
     }
 
   protected:
@@ -179,10 +185,12 @@ class FloatParser : public DataParser
 
     float* getPointer(size_t offset) { return m_Ptr + offset; }
 
-    virtual void parse(const QByteArray& token, size_t index)
+    virtual void parse(const char* begin, const char* end, size_t index)
     {
-      bool ok = false;
-      m_Ptr[index] = token.toFloat(&ok);
+      // Some .ctf files are written with a ',' as the decimal separator
+      float value = 0.0f;
+      EbsdTextParser::ParseFloat(begin, end, value, true);
+      m_Ptr[index] = value;
     }
 
   protected:
@@ -44,10 +44,38 @@
 #include "EbsdLib/EbsdConstants.h"
 #include "EbsdLib/HKL/H5CtfReader.h"
 
+#if EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_group.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #if defined (H5Support_NAMESPACE)
 using namespace H5Support_NAMESPACE;
 #endif
 
+/**
+ * @brief The H5CtfSliceReaderImpl class reads a single slice out of the .h5ebsd file so that
+ * the volume reader can overlap the HDF5 read of the next slice with the copy of the current one.
+ */
+class H5CtfSliceReaderImpl
+{
+  public:
+    H5CtfSliceReaderImpl(H5CtfReader::Pointer reader, int* err) :
+      m_Reader(reader),
+      m_Err(err)
+    {}
+    virtual ~H5CtfSliceReaderImpl() {}
+
+    void operator()() const
+    {
+      *m_Err = m_Reader->readFile();
+    }
+
+  private:
+    H5CtfReader::Pointer m_Reader;
+    int* m_Err;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -79,7 +107,7 @@ H5CtfVolumeReader::~H5CtfVolumeReader()
 
 
 #define H5CTFREADER_ALLOCATE_ARRAY(name, type)\
-  if (readAllArrays == true || arrayNames.find(Ebsd::Ctf::name) != arrayNames.end()) {\
+  if ((readAllArrays == true || arrayNames.find(Ebsd::Ctf::name) != arrayNames.end()) && hasArrayDestination(Ebsd::Ctf::name) == false) {\
     type* _##name = allocateArray<type>(numElements);\
     if (nullptr != _##name) {\
       ::memset(_##name, 0, numBytes);\
@@ -212,108 +240,109 @@ int H5CtfVolumeReader::loadData(int64_t xpoints,
                                 int64_t zpoints,
                                 uint32_t ZDir)
 {
-  int index = 0;
   int err = -1;
 // Initialize all the pointers
   initPointers(xpoints * ypoints * zpoints);
 
-  int readerIndex = 0;
-  int64_t xpointsslice = 0;
-  int64_t ypointsslice = 0;
-  int64_t xpointstemp = 0;
-  int64_t ypointstemp = 0;
-  int zval = 0;
-
+  err = readVolumeInfo();
 
-  int xstartspot = 0;
-  int ystartspot = 0;
+  // If no stacking order preference was passed, read it from the file and use that value
+  if(ZDir == SIMPL::RefFrameZDir::UnknownRefFrameZDirection)
+  {
+    ZDir = getStackingOrder();
+  }
 
-  err = readVolumeInfo();
+#if EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  tbb::task_group g;
+#endif
 
+  // Read the first slice up front. Every pass through the loop below then starts the read
+  // of the next slice before copying the current one into the volume.
+  H5CtfReader::Pointer reader = createSliceReader(0);
+  int readErr = reader->readFile();
   for (int slice = 0; slice < zpoints; ++slice)
   {
-    H5CtfReader::Pointer reader = H5CtfReader::New();
-    reader->setFileName(getFileName());
-    reader->setHDF5Path(QString::number(slice + getSliceStart()));
-    reader->setUserZDir(getStackingOrder());
-    reader->setSampleTransformationAngle(getSampleTransformationAngle());
-    reader->setSampleTransformationAxis(getSampleTransformationAxis());
-    reader->setEulerTransformationAngle(getEulerTransformationAngle());
-    reader->setEulerTransformationAxis(getEulerTransformationAxis());
-    reader->readAllArrays(getReadAllArrays());
-    reader->setArraysToRead(getArraysToRead());
-
-    err = reader->readFile();
-    if (err < 0)
+    if (readErr < 0)
     {
       std::cout << "H5CtfVolumeReader Error: There was an issue loading the data from the hdf5 file." << std::endl;
       return -77000;
     }
-    readerIndex = 0;
-    xpointsslice = reader->getXCells();
-    ypointsslice = reader->getYCells();
-    int* phasePtr = reader->getPhasePointer();
-    float* xPtr = reader->getXPointer();
-    float* yPtr = reader->getYPointer();
-    int* bandPtr = reader->getBandCountPointer();
-    int* errorPtr = reader->getErrorPointer();
-    float* euler1Ptr = reader->getEuler1Pointer();
-    float* euler2Ptr = reader->getEuler2Pointer();
-    float* euler3Ptr = reader->getEuler3Pointer();
-    float* madPtr = reader->getMeanAngularDeviationPointer();
-    int* bcPtr = reader->getBandContrastPointer();
-    int* bsPtr = reader->getBandSlopePointer();
-
-    xpointstemp = xpoints;
-    ypointstemp = ypoints;
-    xstartspot = static_cast<int>( (xpointstemp - xpointsslice) / 2 );
-    ystartspot = static_cast<int>( (ypointstemp - ypointsslice) / 2 );
-
-    // If no stacking order preference was passed, read it from the file and use that value
-    if(ZDir == SIMPL::RefFrameZDir::UnknownRefFrameZDirection)
+
+    H5CtfReader::Pointer nextReader = H5CtfReader::NullPointer();
+    int nextErr = 0;
+    if(slice + 1 < zpoints)
     {
-      ZDir = getStackingOrder();
+      nextReader = createSliceReader(slice + 1);
+#if EbsdLib_USE_PARALLEL_ALGORITHMS
+      g.run(H5CtfSliceReaderImpl(nextReader, &nextErr));
+#endif
     }
+
+    int64_t xpointsslice = reader->getXCells();
+    int64_t ypointsslice = reader->getYCells();
+    int64_t xstartspot = (xpoints - xpointsslice) / 2;
+    int64_t ystartspot = (ypoints - ypointsslice) / 2;
+    int64_t zval = 0;
     if (ZDir == 0) { zval = slice; }
-    if (ZDir == 1) { zval = static_cast<int>( (zpoints - 1) - slice ); }
+    if (ZDir == 1) { zval = (zpoints - 1) - slice; }
+
+    /* For HKL OIM Files if there is a single phase then the value of the phase
+     * data is one (1). If there are 2 or more phases then the lowest value
+     * of phase is also one (1). However, if there are "zero solutions" in the data
+     * then those points are assigned a phase of zero.  Since those points can be identified
+     * by other methods, the phase of these points should be changed to one since in the rest
+     * of the reconstruction code we follow the convention that the lowest value is One (1)
+     * even if there is only a single phase. The phase values are therefore copied as is.
+     */
 
     // Copy the data from the current storage into the Storage Location
-    for (int j = 0; j < ypointsslice; j++)
+    copySliceIntoVolume<int>(Ebsd::Ctf::Phase, reader->getPhasePointer(), m_Phase, xpoints, ypoints, zval, xpointsslice, ypointsslice, xstartspot, ystartspot);
+    copySliceIntoVolume<float>(Ebsd::Ctf::X, reader->getXPointer(), m_X, xpoints, ypoints, zval, xpointsslice, ypointsslice, xstartspot, ystartspot);
+    copySliceIntoVolume<float>(Ebsd::Ctf::Y, reader->getYPointer(), m_Y, xpoints, ypoints, zval, xpointsslice, ypointsslice, xstartspot, ystartspot);
+    copySliceIntoVolume<int>(Ebsd::Ctf::Bands, reader->getBandCountPointer(), m_Bands, xpoints, ypoints, zval, xpointsslice, ypointsslice, xstartspot, ystartspot);
+    copySliceIntoVolume<int>(Ebsd::Ctf::Error, reader->getErrorPointer(), m_Error, xpoints, ypoints, zval, xpointsslice, ypointsslice, xstartspot, ystartspot);
+    copySliceIntoVolume<float>(Ebsd::Ctf::Euler1, reader->getEuler1Pointer(), m_Euler1, xpoints, ypoints, zval, xpointsslice, ypointsslice, xstartspot, ystartspot);
+    copySliceIntoVolume<float>(Ebsd::Ctf::Euler2, reader->getEuler2Pointer(), m_Euler2, xpoints, ypoints, zval, xpointsslice, ypointsslice, xstartspot, ystartspot);
+    copySliceIntoVolume<float>(Ebsd::Ctf::Euler3, reader->getEuler3Pointer(), m_Euler3, xpoints, ypoints, zval, xpointsslice, ypointsslice, xstartspot, ystartspot);
+    copySliceIntoVolume<float>(Ebsd::Ctf::MAD, reader->getMeanAngularDeviationPointer(), m_MAD, xpoints, ypoints, zval, xpointsslice, ypointsslice, xstartspot, ystartspot);
+    copySliceIntoVolume<int>(Ebsd::Ctf::BC, reader->getBandContrastPointer(), m_BC, xpoints, ypoints, zval, xpointsslice, ypointsslice, xstartspot, ystartspot);
+    copySliceIntoVolume<int>(Ebsd::Ctf::BS, reader->getBandSlopePointer(), m_BS, xpoints, ypoints, zval, xpointsslice, ypointsslice, xstartspot, ystartspot);
+    if(nullptr != getSliceObserver())
     {
-      for (int i = 0; i < xpointsslice; i++)
-      {
-        index = static_cast<int>( (zval * xpointstemp * ypointstemp) + ((j + ystartspot) * xpointstemp) + (i + xstartspot) );
-        if (nullptr != phasePtr) {m_Phase[index] = phasePtr[readerIndex];}
-        if (nullptr != xPtr) {m_X[index] = xPtr[readerIndex];}
-        if (nullptr != yPtr) {m_Y[index] = yPtr[readerIndex];}
-        if (nullptr != bandPtr) {m_Bands[index] = bandPtr[readerIndex];}
-        if (nullptr != errorPtr) {m_Error[index] = errorPtr[readerIndex];}
-        if (nullptr != euler1Ptr) {m_Euler1[index] = euler1Ptr[readerIndex];}
-        if (nullptr != euler2Ptr) {m_Euler2[index] = euler2Ptr[readerIndex];}
-        if (nullptr != euler3Ptr) {m_Euler3[index] = euler3Ptr[readerIndex];}
-        if (nullptr != madPtr) {m_MAD[index] = madPtr[readerIndex];}
-        if (nullptr != bcPtr) {m_BC[index] = bcPtr[readerIndex];}
-        if (nullptr != bsPtr) {m_BS[index] = bsPtr[readerIndex];}
-
-        /* For HKL OIM Files if there is a single phase then the value of the phase
-         * data is one (1). If there are 2 or more phases then the lowest value
-         * of phase is also one (1). However, if there are "zero solutions" in the data
-         * then those points are assigned a phase of zero.  Since those points can be identified
-         * by other methods, the phase of these points should be changed to one since in the rest
-         * of the reconstruction code we follow the convention that the lowest value is One (1)
-         * even if there is only a single phase. The next if statement converts all zeros to ones
-         * if there is a single phase in the OIM data.
-         */
-//        if(nullptr != phasePtr && m_Phase[index] < 1)
-//        {
-//          m_Phase[index] = 1;
-//        }
-
-        ++readerIndex;
-      }
+      getSliceObserver()->sliceLoaded(zval);
+    }
+
+    if(nullptr != nextReader.get())
+    {
+#if EbsdLib_USE_PARALLEL_ALGORITHMS
+      g.wait();
+#else
+      nextErr = nextReader->readFile();
+#endif
     }
+    reader = nextReader;
+    readErr = nextErr;
   }
   return err;
 
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5CtfReader::Pointer H5CtfVolumeReader::createSliceReader(int slice)
+{
+  H5CtfReader::Pointer reader = H5CtfReader::New();
+  reader->setFileName(getFileName());
+  reader->setHDF5Path(QString::number(slice + getSliceStart()));
+  reader->setUserZDir(getStackingOrder());
+  reader->setSampleTransformationAngle(getSampleTransformationAngle());
+  reader->setSampleTransformationAxis(getSampleTransformationAxis());
+  reader->setEulerTransformationAngle(getEulerTransformationAngle());
+  reader->setEulerTransformationAxis(getEulerTransformationAxis());
+  reader->readAllArrays(getReadAllArrays());
+  reader->setArraysToRead(getArraysToRead());
+  return reader;
+}
+
@@ -45,6 +45,7 @@
 #include "EbsdLib/EbsdConstants.h"
 #include "EbsdLib/H5EbsdVolumeReader.h"
 #include "EbsdLib/HKL/CtfPhase.h"
+#include "EbsdLib/HKL/H5CtfReader.h"
 
 
 /**
@@ -125,6 +126,13 @@ class EbsdLib_EXPORT H5CtfVolumeReader : public H5EbsdVolumeReader
   protected:
     H5CtfVolumeReader();
 
+    /**
+     * @brief Creates a reader for a single slice of the volume that is configured from this reader
+     * @param slice The index of the slice relative to SliceStart
+     * @return The configured but not yet read H5CtfReader
+     */
+    H5CtfReader::Pointer createSliceReader(int slice);
+
   private:
     QVector<CtfPhase::Pointer> m_Phases;
 
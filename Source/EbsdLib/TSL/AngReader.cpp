@@ -44,6 +44,91 @@
 #include "AngConstants.h"
 #include "EbsdLib/EbsdMacros.h"
 #include "EbsdLib/EbsdMath.h"
+#include "EbsdLib/EbsdTextParser.h"
+
+#if EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+/**
+ * @brief The AngDataParserImpl class parses a set of chunks of whole data lines. Each
+ * chunk records the index of the first line that failed to parse along with the
+ * error code so the reader can report the same error the serial reader would.
+ */
+class AngDataParserImpl
+{
+  public:
+    AngDataParserImpl(AngReader* reader, const EbsdTextParser::LineChunk* chunks, int* errorCodes, size_t* errorLines) :
+      m_Reader(reader),
+      m_Chunks(chunks),
+      m_ErrorCodes(errorCodes),
+      m_ErrorLines(errorLines)
+    {}
+    virtual ~AngDataParserImpl() {}
+
+    void parse(size_t start, size_t end) const
+    {
+      for(size_t c = start; c < end; c++)
+      {
+        const EbsdTextParser::LineChunk& chunk = m_Chunks[c];
+        const char* p = chunk.begin;
+        for(size_t l = 0; l < chunk.numLines; l++)
+        {
+          const char* lineEnd = EbsdTextParser::FindLineEnd(p, chunk.end);
+          int err = m_Reader->parseDataLine(p, lineEnd, chunk.firstLine + l);
+          if(err < 0)
+          {
+            m_ErrorCodes[c] = err;
+            m_ErrorLines[c] = chunk.firstLine + l;
+            break;
+          }
+          p = (lineEnd == chunk.end) ? lineEnd : lineEnd + 1;
+        }
+      }
+    }
+
+#if EbsdLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      parse(r.begin(), r.end());
+    }
+#endif
+  private:
+    AngReader* m_Reader;
+    const EbsdTextParser::LineChunk* m_Chunks;
+    int* m_ErrorCodes;
+    size_t* m_ErrorLines;
+};
+
+namespace
+{
+  // -----------------------------------------------------------------------------
+  // Replays the row/column bookkeeping of the scan for the first numPoints points so
+  // that error messages can report where in the grid the parsing stopped.
+  // -----------------------------------------------------------------------------
+  void FindParsePosition(const float* y, size_t numPoints, int& yChange, int& col)
+  {
+    yChange = 0;
+    col = 0;
+    float oldY = 0.0f;
+    for(size_t i = 0; i < numPoints; ++i)
+    {
+      if(fabs(y[i] - oldY) > 1e-6)
+      {
+        ++yChange;
+        oldY = y[i];
+        col = 0;
+      }
+      else
+      {
+        col++;
+      }
+    }
+  }
+}
 
 // -----------------------------------------------------------------------------
 //
@@ -336,8 +421,7 @@ int AngReader::readFile()
     setErrorMessage("No phase was parsed in the header portion of the file. This possibly means that part of the header is missing.");
     return -150;
   }
-  // We need to pass in the buffer because it has the first line of data
-  readData(in, buf);
+  readData(in);
   if(getErrorCode() < 0)
   {
     return getErrorCode();
@@ -349,7 +433,7 @@ int AngReader::readFile()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void AngReader::readData(QFile& in, QByteArray& buf)
+void AngReader::readData(QFile& in)
 {
   QString streamBuf;
   QTextStream ss(&streamBuf);
@@ -427,68 +511,74 @@ void AngReader::readData(QFile& in, QByteArray& buf)
     return;
   }
 
-  size_t counter = 1; // Because we are on the first line now.
+  // Map the file so the data section can be parsed in place without copying each
+  // line into its own QByteArray. If the file can not be mapped fall back to reading
+  // it into memory in one go.
+  qint64 fileSize = in.size();
+  uchar* mapped = (fileSize > 0) ? in.map(0, fileSize) : nullptr;
+  QByteArray contents;
+  const char* fileBegin = nullptr;
+  const char* fileEnd = nullptr;
+  if(nullptr != mapped)
+  {
+    fileBegin = reinterpret_cast<const char*>(mapped);
+    fileEnd = fileBegin + fileSize;
+  }
+  else
+  {
+    in.seek(0);
+    contents = in.readAll();
+    fileBegin = contents.constData();
+    fileEnd = fileBegin + contents.size();
+  }
 
-  bool onEvenRow = false;
-  int col = 0;
+  // Skip over the header lines, they all start with a '#'
+  const char* dataBegin = fileBegin;
+  while(dataBegin != fileEnd && *dataBegin == '#')
+  {
+    dataBegin = EbsdTextParser::SkipLines(dataBegin, fileEnd, 1);
+  }
 
-  int yChange = 0;
-  float oldY = m_Y[0];
-  int nxOdd = 0;
-  int nxEven = 0;
-  // int nRows = 0;
+  size_t numLines = 0;
+  QVector<EbsdTextParser::LineChunk> chunks = EbsdTextParser::SplitIntoLineChunks(dataBegin, fileEnd, totalDataPoints, EbsdTextParser::GetDefaultChunkCount(), numLines);
+  QVector<int> errorCodes(chunks.size(), 0);
+  QVector<size_t> errorLines(chunks.size(), 0);
 
-  for(size_t i = 0; i < totalDataPoints; ++i)
+  AngDataParserImpl parser(this, chunks.data(), errorCodes.data(), errorLines.data());
+#if EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, static_cast<size_t>(chunks.size()), 1), parser, tbb::simple_partitioner());
+#else
+  parser.parse(0, static_cast<size_t>(chunks.size()));
+#endif
+
+  // The chunks are in file order so the first chunk with an error holds the first bad line
+  int yChange = 0;
+  int col = 0;
+  for(int c = 0; c < chunks.size(); c++)
   {
-    if(i > 0)
-    {
-      //  ::memset(buf, 0, bufSize); // Clear the buffer
-      buf = in.readLine();
-      ++counter;
-    }
-    this->parseDataLine(buf, i);
-    if(getErrorCode() < 0)
+    if(errorCodes[c] < 0)
     {
-      ss.string()->clear();
+      size_t errorLine = errorLines[c];
+      const char* lineBegin = EbsdTextParser::SkipLines(chunks[c].begin, chunks[c].end, errorLine - chunks[c].firstLine);
+      const char* lineEnd = EbsdTextParser::FindLineEnd(lineBegin, chunks[c].end);
+      QByteArray line(lineBegin, static_cast<int>(lineEnd - lineBegin));
+      FindParsePosition(m_Y, errorLine, yChange, col);
 
+      setErrorCode(errorCodes[c]);
+      ss.string()->clear();
       ss << "Error parsing the data line.\n"
-         << buf << "\n*** Header information ***\nRows=" << numRows << " EvenCols=" << nEvenCols << " OddCols=" << nOddCols << "  Calculated Data Points: " << totalDataPoints
-         << "\n***Parsing Position ***\nCurrent Row: " << yChange << "  Current Column Index: " << col << "  Current Data Point Count: " << counter << "\n";
+         << line << "\n*** Header information ***\nRows=" << numRows << " EvenCols=" << nEvenCols << " OddCols=" << nOddCols << "  Calculated Data Points: " << totalDataPoints
+         << "\n***Parsing Position ***\nCurrent Row: " << yChange << "  Current Column Index: " << col << "  Current Data Point Count: " << (errorLine + 1) << "\n";
       setErrorMessage(*(ss.string()));
       break;
     }
-
-    if(fabs(m_Y[i] - oldY) > 1e-6)
-    {
-      ++yChange;
-      oldY = m_Y[i];
-      onEvenRow = !onEvenRow;
-      col = 0;
-    }
-    else
-    {
-      col++;
-    }
-    if(yChange == 0)
-    {
-      ++nxOdd;
-    }
-    if(yChange == 1)
-    {
-      ++nxEven;
-    }
-    if(in.atEnd() == true)
-    {
-      break;
-    }
   }
 
-#if 0
-  nRows = yChange + 1;
-
-  std::cout << "Header: nRows: " << numRows << " Odd Cols: " << nOddCols << "  Even Cols: " << nEvenCols << std::endl;
-  std::cout << "File:   nRows: " << nRows << " Odd Cols: " << nxOdd << "  Even Cols: " << nxEven << std::endl;
-#endif
+  if(nullptr != mapped)
+  {
+    in.unmap(mapped);
+  }
 
   if(getNumFeatures() < 10)
   {
@@ -503,13 +593,14 @@ void AngReader::readData(QFile& in, QByteArray& buf)
     return;
   }
 
-  if(counter != totalDataPoints && in.atEnd() == true)
+  if(numLines != totalDataPoints)
   {
+    FindParsePosition(m_Y, numLines, yChange, col);
     ss.string()->clear();
 
     ss << "End of ANG file reached before all data was parsed.\n"
        << getFileName() << "\n*** Header information ***\nRows=" << numRows << " EvenCols=" << nEvenCols << " OddCols=" << nOddCols << "  Calculated Data Points: " << totalDataPoints
-       << "\n***Parsing Position ***\nCurrent Row: " << yChange << "  Current Column Index: " << col << "  Current Data Point Count: " << counter << "\n";
+       << "\n***Parsing Position ***\nCurrent Row: " << yChange << "  Current Column Index: " << col << "  Current Data Point Count: " << numLines << "\n";
     setErrorMessage(*(ss.string()));
     setErrorCode(-600);
   }
@@ -645,7 +736,7 @@ std::cout << "m_HeaderMap[Ebsd::Ang::" << word << "] = AngHeaderEntry<float>::Ne
 // -----------------------------------------------------------------------------
 //  Read the data part of the ANG file
 // -----------------------------------------------------------------------------
-void AngReader::parseDataLine(QByteArray& line, size_t i)
+int AngReader::parseDataLine(const char* begin, const char* end, size_t i)
 {
   /* When reading the data there should be at least 8 cols of data. There may even
    * be 10 columns of data. The column names should be the following:
@@ -663,95 +754,56 @@ void AngReader::parseDataLine(QByteArray& line, size_t i)
    * Some TSL ang files do NOT have all 10 columns. Assume these are lacking the last
    * 2 columns and all the other columns are the same as above.
    */
-  float p1 = 0.0f, p = 0.0f, p2 = 0.0f, x = -1.0f, y = -1.0f, iqual = -1.0f, conf = -1.0f, semSignal = -1.0f, fit = -1.0f;
-  int ph = 0;
-  size_t offset = 0;
-  QList<QByteArray> tokens = line.trimmed().simplified().split(' ');
-  bool ok = true;
-  offset = i;
-  if(tokens.size() >= 1)
-  {
-    p1 = tokens[0].toFloat(&ok);
-    if(!ok)
-    {
-      setErrorCode(-2501);
-    }
-    m_Phi1[offset] = p1;
-  }
-  if(tokens.size() >= 2)
+  // Columns 0-6 and 8-9 are floats, column 7 is the phase. Only the first 8 columns
+  // produce an error code, the last failing column is the one that is reported.
+  float* floatColumns[10] = { m_Phi1, m_Phi, m_Phi2, m_X, m_Y, m_Iq, m_Ci, nullptr, m_SEMSignal, m_Fit };
+  int err = 0;
+  int column = 0;
+  const char* p = begin;
+  while(column < 10)
   {
-    p = tokens[1].toFloat(&ok);
-    if(!ok)
+    while(p != end && EbsdTextParser::IsSpace(*p))
     {
-      setErrorCode(-2502);
+      ++p;
     }
-    m_Phi[offset] = p;
-  }
-  if(tokens.size() >= 3)
-  {
-    p2 = tokens[2].toFloat(&ok);
-    if(!ok)
-    {
-      setErrorCode(-2503);
-    }
-    m_Phi2[offset] = p2;
-  }
-  if(tokens.size() >= 4)
-  {
-    x = tokens[3].toFloat(&ok);
-    if(!ok)
+    if(p == end)
     {
-      setErrorCode(-2504);
+      break;
     }
-    m_X[offset] = x;
-  }
-  if(tokens.size() >= 5)
-  {
-    y = tokens[4].toFloat(&ok);
-    if(!ok)
+    const char* tokenEnd = p;
+    while(tokenEnd != end && !EbsdTextParser::IsSpace(*tokenEnd))
     {
-      setErrorCode(-2505);
+      ++tokenEnd;
     }
-    m_Y[offset] = y;
-  }
-  if(tokens.size() >= 6)
-  {
-    iqual = tokens[5].toFloat(&ok);
-    if(!ok)
+
+    bool ok = true;
+    if(column == 7)
     {
-      setErrorCode(-2506);
+      int32_t ph = 0;
+      ok = EbsdTextParser::ParseInt32(p, tokenEnd, ph);
+      m_PhaseData[i] = ph;
     }
-    m_Iq[offset] = iqual;
-  }
-  if(tokens.size() >= 7)
-  {
-    conf = tokens[6].toFloat(&ok);
-    if(!ok)
+    else
     {
-      setErrorCode(-2507);
+      float value = 0.0f;
+      ok = EbsdTextParser::ParseFloat(p, tokenEnd, value);
+      floatColumns[column][i] = value;
     }
-    m_Ci[offset] = conf;
-  }
-  if(tokens.size() >= 8)
-  {
-    ph = tokens[7].toInt(&ok);
-    if(!ok)
+    if(!ok && column < 8)
     {
-      setErrorCode(-2508);
+      err = -2501 - column;
     }
-    m_PhaseData[offset] = ph;
+    ++column;
+    p = tokenEnd;
   }
 
-  if(tokens.size() >= 9)
-  {
-    semSignal = tokens[8].toFloat(&ok);
-    m_SEMSignal[offset] = semSignal;
-  }
-  if(tokens.size() >= 10)
+  // A blank line is a single empty token which can not be parsed as phi1
+  if(column == 0)
   {
-    fit = tokens[9].toFloat(&ok);
-    m_Fit[offset] = fit;
+    m_Phi1[i] = 0.0f;
+    err = -2501;
   }
+  return err;
 }
 
 // -----------------------------------------------------------------------------
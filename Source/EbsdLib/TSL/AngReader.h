@@ -148,17 +148,28 @@ class EbsdLib_EXPORT AngReader : public EbsdReader
     AngPhase::Pointer   m_CurrentPhase;
 
 
-    void readData(QFile& in, QByteArray& buf);
+    /** @brief Parses the data section of the file. The file is memory mapped and split
+     * into chunks of whole lines that are parsed in parallel when TBB is available.
+     * @param in The open file, positioned anywhere
+     */
+    void readData(QFile& in);
 
     /** @brief Parses the value from a single line of the header section of the TSL .ang file
     * @param line The line to parse
     */
     void parseHeaderLine(QByteArray& buf);
 
-    /** @brief Parses the data from a line of data from the TSL .ang file
-      * @param line The line of data to parse
+    /** @brief Parses the data from a line of data from the TSL .ang file. This does not
+      * allocate or touch any shared state other than index i of each column so
+      * it is safe to call concurrently for different lines.
+      * @param begin Start of the line
+      * @param end One past the last character of the line
+      * @param i The index of the scan point
+      * @return 0 on success or one of the -2501 to -2508 error codes
       */
-    void parseDataLine(QByteArray& line, size_t i);
+    int parseDataLine(const char* begin, const char* end, size_t i);
+
+    friend class AngDataParserImpl;
 
     AngReader(const AngReader&);    // Copy Constructor Not Implemented
     void operator=(const AngReader&);  // Operator '=' Not Implemented
@@ -46,10 +46,40 @@
 #include "EbsdLib/EbsdConstants.h"
 #include "EbsdLib/TSL/H5AngReader.h"
 
+#if EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_group.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #if defined (H5Support_NAMESPACE)
 using namespace H5Support_NAMESPACE;
 #endif
 
+/**
+ * @brief The H5AngSliceReaderImpl class reads a single slice out of the .h5ebsd file. The volume
+ * reader runs it as a task so the HDF5 read of the next slice overlaps the copy of the current
+ * slice. Only a single one of these tasks is ever in flight so the HDF5 library is never entered
+ * from more than one thread at a time.
+ */
+class H5AngSliceReaderImpl
+{
+  public:
+    H5AngSliceReaderImpl(H5AngReader::Pointer reader, int* err) :
+      m_Reader(reader),
+      m_Err(err)
+    {}
+    virtual ~H5AngSliceReaderImpl() {}
+
+    void operator()() const
+    {
+      *m_Err = m_Reader->readFile();
+    }
+
+  private:
+    H5AngReader::Pointer m_Reader;
+    int* m_Err;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -79,7 +109,7 @@ H5AngVolumeReader::~H5AngVolumeReader()
 
 
 #define H5ANGREADER_ALLOCATE_ARRAY(name, type)\
-  if (readAllArrays == true || arrayNames.find(Ebsd::Ang::name) != arrayNames.end()) {\
+  if ((readAllArrays == true || arrayNames.find(Ebsd::Ang::name) != arrayNames.end()) && hasArrayDestination(Ebsd::Ang::name) == false) {\
     type* _##name = allocateArray<type>(numElements);\
     if (nullptr != _##name) {\
       ::memset(_##name, 0, numBytes);\
@@ -211,108 +241,127 @@ int H5AngVolumeReader::loadData(int64_t xpoints,
                                 int64_t zpoints,
                                 uint32_t ZDir )
 {
-  int index = 0;
   int err = -1;
   // Initialize all the pointers
   initPointers(xpoints * ypoints * zpoints);
 
-
-  int readerIndex = 0;
-  int xpointsslice = 0;
-  int ypointsslice = 0;
-  int xpointstemp = 0;
-  int ypointstemp = 0;
-  int xstop = 0;
-  int ystop = 0;
-  int zval = 0;
-
-  int xstartspot = 0;
-  int ystartspot = 0;
   int numPhases = getNumPhases();
   err = readVolumeInfo();
+
+  // If no stacking order preference was passed, read it from the file and use that value
+  if(ZDir == SIMPL::RefFrameZDir::UnknownRefFrameZDirection)
+  {
+    ZDir = getStackingOrder();
+  }
+
+#if EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  tbb::task_group g;
+#endif
+
+  // Read the first slice up front. Every pass through the loop below then starts the read
+  // of the next slice before copying the current one into the volume.
+  H5AngReader::Pointer reader = createSliceReader(0);
+  int readErr = reader->readFile();
   for (int slice = 0; slice < zpoints; ++slice)
   {
-    H5AngReader::Pointer reader = H5AngReader::New();
-    reader->setFileName(getFileName());
-    reader->setHDF5Path(QString::number(slice + getSliceStart()));
-    reader->setUserZDir(getStackingOrder());
-    reader->setSampleTransformationAngle(getSampleTransformationAngle());
-    reader->setSampleTransformationAxis(getSampleTransformationAxis());
-    reader->setEulerTransformationAngle(getEulerTransformationAngle());
-    reader->setEulerTransformationAxis(getEulerTransformationAxis());
-    reader->readAllArrays(getReadAllArrays());
-    reader->setArraysToRead(getArraysToRead());
-    err = reader->readFile();
-    if(err < 0)
+    if(readErr < 0)
     {
       setErrorCode(reader->getErrorCode());
       setErrorMessage(reader->getErrorMessage());
       return getErrorCode();
     }
-    readerIndex = 0;
-    xpointsslice = reader->getNumEvenCols();
-    ypointsslice = reader->getNumRows();
+
+    H5AngReader::Pointer nextReader = H5AngReader::NullPointer();
+    int nextErr = 0;
+    if(slice + 1 < zpoints)
+    {
+      nextReader = createSliceReader(slice + 1);
+#if EbsdLib_USE_PARALLEL_ALGORITHMS
+      g.run(H5AngSliceReaderImpl(nextReader, &nextErr));
+#endif
+    }
+
+    int64_t xpointsslice = reader->getNumEvenCols();
+    int64_t ypointsslice = reader->getNumRows();
     float* euler1Ptr = reader->getPhi1Pointer();
-    if (nullptr == euler1Ptr) { setErrorCode(-99090); setErrorMessage("Euler1 Pointer was nullptr from Reader"); return getErrorCode(); }
-    float* euler2Ptr = reader->getPhiPointer();
-    float* euler3Ptr = reader->getPhi2Pointer();
-    float* xPtr = reader->getXPositionPointer();
-    float* yPtr = reader->getYPositionPointer();
-    float* iqPtr = reader->getImageQualityPointer();
-    float* ciPtr = reader->getConfidenceIndexPointer();
-    int* phasePtr = reader->getPhaseDataPointer();
-    float* sigPtr = reader->getSEMSignalPointer();
-    float* fitPtr = reader->getFitPointer();
-
-    xpointstemp = static_cast<int>(xpoints);
-    ypointstemp = static_cast<int>(ypoints);
-    xstartspot = (xpointstemp - xpointsslice) / 2;
-    ystartspot = (ypointstemp - ypointsslice) / 2;
-    xstop = xpointsslice;
-    ystop = ypointsslice;
-
-    // If no stacking order preference was passed, read it from the file and use that value
-    if(ZDir == SIMPL::RefFrameZDir::UnknownRefFrameZDirection)
+    if (nullptr == euler1Ptr)
     {
-      ZDir = getStackingOrder();
+#if EbsdLib_USE_PARALLEL_ALGORITHMS
+      g.wait();
+#endif
+      setErrorCode(-99090); setErrorMessage("Euler1 Pointer was nullptr from Reader"); return getErrorCode();
     }
-    if(ZDir == SIMPL::RefFrameZDir::LowtoHigh) { zval = slice; }
-    if(ZDir == SIMPL::RefFrameZDir::HightoLow) { zval = static_cast<int>( (zpoints - 1) - slice ); }
+    int* phasePtr = reader->getPhaseDataPointer();
 
-    // Copy the data from the current storage into the new memory Location
-    for (int j = 0; j < ystop; j++)
+    int64_t xstartspot = (xpoints - xpointsslice) / 2;
+    int64_t ystartspot = (ypoints - ypointsslice) / 2;
+    int64_t zval = 0;
+    if(ZDir == SIMPL::RefFrameZDir::LowtoHigh) { zval = slice; }
+    if(ZDir == SIMPL::RefFrameZDir::HightoLow) { zval = (zpoints - 1) - slice; }
+
+    /* For TSL OIM Files if there is a single phase then the value of the phase
+     * data is zero (0). If there are 2 or more phases then the lowest value
+     * of phase is one (1). In the rest of the reconstruction code we follow the
+     * convention that the lowest value is One (1) even if there is only a single
+     * phase. The next if statement converts all zeros to ones if there is a single
+     * phase in the OIM data.
+     */
+    if (numPhases == 1 && nullptr != phasePtr)
     {
-      for (int i = 0; i < xstop; i++)
+      size_t sliceElements = static_cast<size_t>(xpointsslice * ypointsslice);
+      for(size_t i = 0; i < sliceElements; i++)
       {
-        index = (zval * xpointstemp * ypointstemp) + ((j + ystartspot) * xpointstemp) + (i + xstartspot);
-        if (nullptr != euler1Ptr) {m_Phi1[index] = euler1Ptr[readerIndex];}
-        if (nullptr != euler2Ptr) {m_Phi[index] = euler2Ptr[readerIndex];}
-        if (nullptr != euler3Ptr) {m_Phi2[index] = euler3Ptr[readerIndex];}
-        if (nullptr != xPtr) {m_X[index] = xPtr[readerIndex];}
-        if (nullptr != yPtr) {m_Y[index] = yPtr[readerIndex];}
-        if (nullptr != iqPtr) {m_Iq[index] = iqPtr[readerIndex];}
-        if (nullptr != ciPtr) {m_Ci[index] = ciPtr[readerIndex];}
-        if (nullptr != phasePtr) {m_PhaseData[index] = phasePtr[readerIndex];} // Phase
-        if (nullptr != sigPtr) {m_SEMSignal[index] = sigPtr[readerIndex];}
-        if (nullptr != fitPtr) {m_Fit[index] = fitPtr[readerIndex];}
-
-        /* For TSL OIM Files if there is a single phase then the value of the phase
-         * data is zero (0). If there are 2 or more phases then the lowest value
-         * of phase is one (1). In the rest of the reconstruction code we follow the
-         * convention that the lowest value is One (1) even if there is only a single
-         * phase. The next if statement converts all zeros to ones if there is a single
-         * phase in the OIM data.
-         */
-        if (numPhases == 1 && nullptr != phasePtr && m_PhaseData[index] < 1)
-        {
-          m_PhaseData[index] = 1;
-        }
-
-        ++readerIndex;
+        if(phasePtr[i] < 1) { phasePtr[i] = 1; }
       }
     }
+
+    // Copy the data from the current storage into the new memory Location
+    copySliceIntoVolume<float>(Ebsd::Ang::Phi1, euler1Ptr, m_Phi1, xpoints, ypoints, zval, xpointsslice, ypointsslice, xstartspot, ystartspot);
+    copySliceIntoVolume<float>(Ebsd::Ang::Phi, reader->getPhiPointer(), m_Phi, xpoints, ypoints, zval, xpointsslice, ypointsslice, xstartspot, ystartspot);
+    copySliceIntoVolume<float>(Ebsd::Ang::Phi2, reader->getPhi2Pointer(), m_Phi2, xpoints, ypoints, zval, xpointsslice, ypointsslice, xstartspot, ystartspot);
+    copySliceIntoVolume<float>(Ebsd::Ang::XPosition, reader->getXPositionPointer(), m_X, xpoints, ypoints, zval, xpointsslice, ypointsslice, xstartspot, ystartspot);
+    copySliceIntoVolume<float>(Ebsd::Ang::YPosition, reader->getYPositionPointer(), m_Y, xpoints, ypoints, zval, xpointsslice, ypointsslice, xstartspot, ystartspot);
+    copySliceIntoVolume<float>(Ebsd::Ang::ImageQuality, reader->getImageQualityPointer(), m_Iq, xpoints, ypoints, zval, xpointsslice, ypointsslice, xstartspot, ystartspot);
+    copySliceIntoVolume<float>(Ebsd::Ang::ConfidenceIndex, reader->getConfidenceIndexPointer(), m_Ci, xpoints, ypoints, zval, xpointsslice, ypointsslice, xstartspot, ystartspot);
+    copySliceIntoVolume<int>(Ebsd::Ang::PhaseData, phasePtr, m_PhaseData, xpoints, ypoints, zval, xpointsslice, ypointsslice, xstartspot, ystartspot);
+    copySliceIntoVolume<float>(Ebsd::Ang::SEMSignal, reader->getSEMSignalPointer(), m_SEMSignal, xpoints, ypoints, zval, xpointsslice, ypointsslice, xstartspot, ystartspot);
+    copySliceIntoVolume<float>(Ebsd::Ang::Fit, reader->getFitPointer(), m_Fit, xpoints, ypoints, zval, xpointsslice, ypointsslice, xstartspot, ystartspot);
+    if(nullptr != getSliceObserver())
+    {
+      getSliceObserver()->sliceLoaded(zval);
+    }
+
+    if(nullptr != nextReader.get())
+    {
+#if EbsdLib_USE_PARALLEL_ALGORITHMS
+      g.wait();
+#else
+      nextErr = nextReader->readFile();
+#endif
+    }
+    reader = nextReader;
+    readErr = nextErr;
   }
   return err;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5AngReader::Pointer H5AngVolumeReader::createSliceReader(int slice)
+{
+  H5AngReader::Pointer reader = H5AngReader::New();
+  reader->setFileName(getFileName());
+  reader->setHDF5Path(QString::number(slice + getSliceStart()));
+  reader->setUserZDir(getStackingOrder());
+  reader->setSampleTransformationAngle(getSampleTransformationAngle());
+  reader->setSampleTransformationAxis(getSampleTransformationAxis());
+  reader->setEulerTransformationAngle(getEulerTransformationAngle());
+  reader->setEulerTransformationAxis(getEulerTransformationAxis());
+  reader->readAllArrays(getReadAllArrays());
+  reader->setArraysToRead(getArraysToRead());
+  return reader;
+}
+
 
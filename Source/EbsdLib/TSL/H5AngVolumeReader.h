@@ -46,6 +46,7 @@
 #include "EbsdLib/H5EbsdVolumeReader.h"
 
 #include "EbsdLib/TSL/AngPhase.h"
+#include "EbsdLib/TSL/H5AngReader.h"
 
 
 
@@ -119,6 +120,13 @@ class EbsdLib_EXPORT H5AngVolumeReader : public H5EbsdVolumeReader
   protected:
     H5AngVolumeReader();
 
+    /**
+     * @brief Creates a reader for a single slice of the volume that is configured from this reader
+     * @param slice The index of the slice relative to SliceStart
+     * @return The configured but not yet read H5AngReader
+     */
+    H5AngReader::Pointer createSliceReader(int slice);
+
   private:
     QVector<AngPhase::Pointer> m_Phases;
 
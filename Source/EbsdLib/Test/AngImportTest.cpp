@@ -39,6 +39,7 @@
 
 #include <QtCore/QDir>
 #include <QtCore/QFile>
+#include <QtCore/QTextStream>
 #include <QtCore/QtDebug>
 
 #include "EbsdLib/EbsdLib.h"
@@ -73,6 +74,7 @@ public:
   {
 #if REMOVE_TEST_FILES
     QFile::remove(UnitTest::AngImportTest::H5EbsdOutputFile);
+    QFile::remove(UnitTest::AngImportTest::BadDataLineFile);
 #endif
   }
 
@@ -173,6 +175,51 @@ public:
     DREAM3D_REQUIRED(ptr[159], ==, 12.56637f)
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void WriteSmallAngFile(const QString& badValue)
+  {
+    QFile out(UnitTest::AngImportTest::BadDataLineFile);
+    DREAM3D_REQUIRE(out.open(QIODevice::WriteOnly | QIODevice::Text))
+    QTextStream ss(&out);
+    ss << "# XSTEP: 1.0\n# YSTEP: 1.0\n# NCOLS_ODD: 10\n# NCOLS_EVEN: 10\n# NROWS: 10\n# GRID: SqrGrid\n";
+    ss << "# Phase 1\n# MaterialName  Nickel\n# Symmetry  43\n";
+    for(int i = 0; i < 100; i++)
+    {
+      int x = i % 10;
+      int y = i / 10;
+      ss << "  0.5 " << ((i == 57) ? badValue : QString("1.25")) << " 2.0e-1 " << x << ".00000 " << y << ".00000 100.0 0.9 1 0 1.5\r\n";
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestBadDataLine()
+  {
+    // A well formed file with Windows line endings should read every point
+    WriteSmallAngFile("1.25");
+    AngReader reader;
+    reader.setFileName(UnitTest::AngImportTest::BadDataLineFile);
+    int err = reader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+    DREAM3D_REQUIRED(reader.getNumberOfElements(), ==, 100)
+    DREAM3D_REQUIRED(reader.getPhiPointer()[99], ==, 1.25f)
+    DREAM3D_REQUIRED(reader.getPhi2Pointer()[99], ==, 0.2f)
+    DREAM3D_REQUIRED(reader.getYPositionPointer()[99], ==, 9.0f)
+    DREAM3D_REQUIRED(reader.getPhaseDataPointer()[99], ==, 1)
+    DREAM3D_REQUIRED(reader.getFitPointer()[99], ==, 1.5f)
+
+    // A bad value in the second column must still give the same error code
+    WriteSmallAngFile("1.2x5");
+    AngReader badReader;
+    badReader.setFileName(UnitTest::AngImportTest::BadDataLineFile);
+    err = badReader.readFile();
+    DREAM3D_REQUIRED(err, ==, -2502)
+    DREAM3D_REQUIRE(badReader.getErrorMessage().contains("Current Data Point Count: 58"))
+  }
+
   void operator()()
   {
     int err = EXIT_SUCCESS;
@@ -182,6 +229,7 @@ public:
     DREAM3D_REGISTER_TEST(TestMissingGrid())
     DREAM3D_REGISTER_TEST(TestShortFile())
     DREAM3D_REGISTER_TEST(TestNormalFile())
+    DREAM3D_REGISTER_TEST(TestBadDataLine())
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
   }
 };
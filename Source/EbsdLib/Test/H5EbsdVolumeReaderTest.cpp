@@ -0,0 +1,284 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <QtCore/QFile>
+
+#include "EbsdLib/EbsdLib.h"
+
+#include "H5Support/QH5Lite.h"
+#include "H5Support/QH5Utilities.h"
+
+#include "EbsdLib/TSL/H5AngImporter.h"
+#include "EbsdLib/TSL/H5AngReader.h"
+#include "EbsdLib/TSL/H5AngVolumeReader.h"
+
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "EbsdLib/Test/EbsdLibTestFileLocations.h"
+
+/**
+ * @brief Counts the planes that H5EbsdVolumeReader::loadData() reports as loaded
+ */
+class H5EbsdVolumeReaderTestObserver : public H5EbsdSliceObserver
+{
+  public:
+    H5EbsdVolumeReaderTestObserver()
+    : slicesLoaded(0)
+    {
+    }
+    virtual ~H5EbsdVolumeReaderTestObserver() {}
+
+    void sliceLoaded(int64_t zval)
+    {
+      DREAM3D_REQUIRE_EQUAL(zval, slicesLoaded)
+      slicesLoaded++;
+    }
+
+    int64_t slicesLoaded;
+};
+
+class H5EbsdVolumeReaderTest
+{
+public:
+  H5EbsdVolumeReaderTest()
+  {
+  }
+  virtual ~H5EbsdVolumeReaderTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(UnitTest::H5EbsdVolumeReaderTest::H5EbsdOutputFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  // Writes the 3 test .ang files into an .h5ebsd file the same way EbsdToH5Ebsd does. If
+  // breakMiddleSlice is true the Phi array of the second slice is removed from the file.
+  // -----------------------------------------------------------------------------
+  void WriteH5EbsdFile(bool breakMiddleSlice)
+  {
+    QFile::remove(UnitTest::H5EbsdVolumeReaderTest::H5EbsdOutputFile);
+    hid_t fileId = QH5Utilities::createFile(UnitTest::H5EbsdVolumeReaderTest::H5EbsdOutputFile);
+    DREAM3D_REQUIRE(fileId >= 0)
+
+    float zRes = 0.25f;
+    uint32_t stackingOrder = SIMPL::RefFrameZDir::LowtoHigh;
+    float angle = 0.0f;
+    float axis[3] = {0.0f, 0.0f, 1.0f};
+    hsize_t axisDims[1] = {3};
+    DREAM3D_REQUIRE(QH5Lite::writeScalarDataset(fileId, Ebsd::H5::ZResolution, zRes) >= 0)
+    DREAM3D_REQUIRE(QH5Lite::writeScalarDataset(fileId, Ebsd::H5::StackingOrder, stackingOrder) >= 0)
+    DREAM3D_REQUIRE(QH5Lite::writeScalarDataset(fileId, Ebsd::H5::SampleTransformationAngle, angle) >= 0)
+    DREAM3D_REQUIRE(QH5Lite::writePointerDataset<float>(fileId, Ebsd::H5::SampleTransformationAxis, 1, axisDims, axis) >= 0)
+    DREAM3D_REQUIRE(QH5Lite::writeScalarDataset(fileId, Ebsd::H5::EulerTransformationAngle, angle) >= 0)
+    DREAM3D_REQUIRE(QH5Lite::writePointerDataset<float>(fileId, Ebsd::H5::EulerTransformationAxis, 1, axisDims, axis) >= 0)
+    DREAM3D_REQUIRE(QH5Lite::writeStringDataset(fileId, Ebsd::H5::Manufacturer, Ebsd::Ang::Manufacturer) >= 0)
+
+    QVector<QString> files;
+    files << UnitTest::AngImportTest::TestFile1 << UnitTest::AngImportTest::TestFile2 << UnitTest::AngImportTest::TestFile3;
+    H5AngImporter::Pointer importer = H5AngImporter::New();
+    QVector<int32_t> indices;
+    int64_t xDim = 0, yDim = 0;
+    float xRes = 0.0f, yRes = 0.0f;
+    for(int32_t z = 0; z < files.size(); z++)
+    {
+      DREAM3D_REQUIRE(importer->importFile(fileId, z + 1, files[z]) >= 0)
+      importer->getDims(xDim, yDim);
+      importer->getResolution(xRes, yRes);
+      indices.push_back(z + 1);
+    }
+
+    int64_t zStart = 1;
+    int64_t zEnd = files.size();
+    DREAM3D_REQUIRE(QH5Lite::writeScalarDataset(fileId, Ebsd::H5::ZStartIndex, zStart) >= 0)
+    DREAM3D_REQUIRE(QH5Lite::writeScalarDataset(fileId, Ebsd::H5::ZEndIndex, zEnd) >= 0)
+    DREAM3D_REQUIRE(QH5Lite::writeScalarDataset(fileId, Ebsd::H5::XPoints, xDim) >= 0)
+    DREAM3D_REQUIRE(QH5Lite::writeScalarDataset(fileId, Ebsd::H5::YPoints, yDim) >= 0)
+    DREAM3D_REQUIRE(QH5Lite::writeScalarDataset(fileId, Ebsd::H5::XResolution, xRes) >= 0)
+    DREAM3D_REQUIRE(QH5Lite::writeScalarDataset(fileId, Ebsd::H5::YResolution, yRes) >= 0)
+    QVector<hsize_t> indexDims(1, indices.size());
+    DREAM3D_REQUIRE(QH5Lite::writeVectorDataset(fileId, Ebsd::H5::Index, indexDims, indices) >= 0)
+
+    if(breakMiddleSlice == true)
+    {
+      QString path = QString("2/%1/%2").arg(Ebsd::H5::Data).arg(Ebsd::Ang::Phi);
+      DREAM3D_REQUIRE(H5Ldelete(fileId, path.toLatin1().data(), H5P_DEFAULT) >= 0)
+    }
+    QH5Utilities::closeFile(fileId);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Sets up a volume reader that copies the Euler angles into one interleaved buffer and the
+  // phases into another, and allocates the Confidence Index itself
+  // -----------------------------------------------------------------------------
+  H5AngVolumeReader::Pointer CreateVolumeReader(std::vector<float>& eulers, std::vector<int32_t>& phases, int64_t dims[3])
+  {
+    H5AngVolumeReader::Pointer reader = H5AngVolumeReader::New();
+    reader->setFileName(UnitTest::H5EbsdVolumeReaderTest::H5EbsdOutputFile);
+    DREAM3D_REQUIRE(reader->readVolumeInfo() >= 0)
+    DREAM3D_REQUIRE(reader->getDims(dims[0], dims[1], dims[2]) >= 0)
+    DREAM3D_REQUIRE_EQUAL(dims[2], 3)
+
+    size_t numElements = static_cast<size_t>(dims[0] * dims[1] * dims[2]);
+    eulers.assign(numElements * 3, -1000.0f);
+    phases.assign(numElements, -1000);
+
+    reader->setSliceStart(reader->getZStart());
+    reader->setSliceEnd(reader->getZEnd());
+    reader->readAllArrays(false);
+    QSet<QString> names;
+    names << Ebsd::Ang::Phi1 << Ebsd::Ang::Phi << Ebsd::Ang::Phi2 << Ebsd::Ang::PhaseData << Ebsd::Ang::ConfidenceIndex;
+    reader->setArraysToRead(names);
+    reader->setArrayDestination(Ebsd::Ang::Phi1, eulers.data(), 3, 0);
+    reader->setArrayDestination(Ebsd::Ang::Phi, eulers.data(), 3, 1);
+    reader->setArrayDestination(Ebsd::Ang::Phi2, eulers.data(), 3, 2);
+    reader->setArrayDestination(Ebsd::Ang::PhaseData, phases.data());
+    return reader;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Requires that plane z of the volume holds exactly what the slice reader reads from the file
+  // -----------------------------------------------------------------------------
+  void CheckPlane(H5AngVolumeReader::Pointer reader, const std::vector<float>& eulers, const std::vector<int32_t>& phases, int64_t dims[3], int64_t z)
+  {
+    H5AngReader::Pointer sliceReader = H5AngReader::New();
+    sliceReader->setFileName(UnitTest::H5EbsdVolumeReaderTest::H5EbsdOutputFile);
+    sliceReader->setHDF5Path(QString::number(z + 1));
+    sliceReader->readAllArrays(true);
+    DREAM3D_REQUIRE(sliceReader->readFile() >= 0)
+    DREAM3D_REQUIRE_EQUAL(sliceReader->getNumEvenCols(), dims[0])
+    DREAM3D_REQUIRE_EQUAL(sliceReader->getNumRows(), dims[1])
+
+    float* ci = reinterpret_cast<float*>(reader->getPointerByName(Ebsd::Ang::ConfidenceIndex));
+    DREAM3D_REQUIRE_VALID_POINTER(ci)
+    DREAM3D_REQUIRE_NULL_POINTER(reader->getPointerByName(Ebsd::Ang::Phi1))
+
+    size_t planeSize = static_cast<size_t>(dims[0] * dims[1]);
+    for(size_t i = 0; i < planeSize; i++)
+    {
+      size_t index = z * planeSize + i;
+      DREAM3D_REQUIRE_EQUAL(eulers[index * 3], sliceReader->getPhi1Pointer()[i])
+      DREAM3D_REQUIRE_EQUAL(eulers[index * 3 + 1], sliceReader->getPhiPointer()[i])
+      DREAM3D_REQUIRE_EQUAL(eulers[index * 3 + 2], sliceReader->getPhi2Pointer()[i])
+      DREAM3D_REQUIRE_EQUAL(ci[index], sliceReader->getConfidenceIndexPointer()[i])
+      // A single phase file has its phase 0 points moved to phase 1
+      int32_t phase = sliceReader->getPhaseDataPointer()[i];
+      if(reader->getNumPhases() == 1 && phase < 1)
+      {
+        phase = 1;
+      }
+      DREAM3D_REQUIRE_EQUAL(phases[index], phase)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestLoadVolume()
+  {
+    WriteH5EbsdFile(false);
+
+    std::vector<float> eulers;
+    std::vector<int32_t> phases;
+    int64_t dims[3] = {0, 0, 0};
+    H5AngVolumeReader::Pointer reader = CreateVolumeReader(eulers, phases, dims);
+    H5EbsdVolumeReaderTestObserver observer;
+    reader->setSliceObserver(&observer);
+    int err = reader->loadData(dims[0], dims[1], dims[2], SIMPL::RefFrameZDir::LowtoHigh);
+    reader->setSliceObserver(nullptr);
+    DREAM3D_REQUIRED(err, >=, 0)
+    DREAM3D_REQUIRE_EQUAL(observer.slicesLoaded, dims[2])
+
+    for(int64_t z = 0; z < dims[2]; z++)
+    {
+      CheckPlane(reader, eulers, phases, dims, z);
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestFailingMiddleSlice()
+  {
+    WriteH5EbsdFile(true);
+
+    std::vector<float> eulers;
+    std::vector<int32_t> phases;
+    int64_t dims[3] = {0, 0, 0};
+    H5AngVolumeReader::Pointer reader = CreateVolumeReader(eulers, phases, dims);
+    H5EbsdVolumeReaderTestObserver observer;
+    reader->setSliceObserver(&observer);
+    int err = reader->loadData(dims[0], dims[1], dims[2], SIMPL::RefFrameZDir::LowtoHigh);
+    reader->setSliceObserver(nullptr);
+
+    // The error of the slice reader is passed on once the loop reaches the broken slice
+    DREAM3D_REQUIRED(err, ==, -90020)
+    DREAM3D_REQUIRED(reader->getErrorCode(), ==, -90020)
+    DREAM3D_REQUIRE_EQUAL(observer.slicesLoaded, 1)
+
+    // The slice in front of the broken one was loaded and nothing was written after it
+    CheckPlane(reader, eulers, phases, dims, 0);
+    size_t planeSize = static_cast<size_t>(dims[0] * dims[1]);
+    for(size_t i = planeSize; i < phases.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(eulers[i * 3], -1000.0f)
+      DREAM3D_REQUIRE_EQUAL(eulers[i * 3 + 1], -1000.0f)
+      DREAM3D_REQUIRE_EQUAL(eulers[i * 3 + 2], -1000.0f)
+      DREAM3D_REQUIRE_EQUAL(phases[i], -1000)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestLoadVolume())
+    DREAM3D_REGISTER_TEST(TestFailingMiddleSlice())
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+private:
+  H5EbsdVolumeReaderTest(const H5EbsdVolumeReaderTest&); // Copy Constructor Not Implemented
+  void operator=(const H5EbsdVolumeReaderTest&);         // Operator '=' Not Implemented
+};
@@ -260,6 +260,33 @@ float CubicLowOps::getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float
   return _calcMisoQuat(CubicLowQuatSym, numsym, q1, q2, n1, n2, n3);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubicLowOps::getMisoQuats(const QuatF* q1s, const QuatF* q2s, size_t count, float* angles, float* n1s, float* n2s, float* n3s)
+{
+  int numsym = 12;
+  _calcMisoQuats(CubicLowQuatSym, numsym, q1s, q2s, count, angles, n1s, n2s, n3s);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool CubicLowOps::isMisoQuatBelow(const QuatF& q1, const QuatF& q2, float threshold)
+{
+  int numsym = 12;
+  return _calcIsMisoQuatBelow(CubicLowQuatSym, numsym, q1, q2, threshold);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t CubicLowOps::getMisoQuatsBelow(const QuatF* q1s, const QuatF* q2s, size_t count, float threshold, bool* below)
+{
+  int numsym = 12;
+  return _calcMisoQuatsBelow(CubicLowQuatSym, numsym, q1s, q2s, count, threshold, below);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -99,6 +99,9 @@ class OrientationLib_EXPORT CubicLowOps : public LaueOps
     QString getSymmetryName();
 
     virtual float getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float& n3);
+    virtual void getMisoQuats(const QuatF* q1s, const QuatF* q2s, size_t count, float* angles, float* n1s, float* n2s, float* n3s);
+    virtual bool isMisoQuatBelow(const QuatF& q1, const QuatF& q2, float threshold);
+    virtual size_t getMisoQuatsBelow(const QuatF* q1s, const QuatF* q2s, size_t count, float threshold, bool* below);
     virtual void getQuatSymOp(int i, QuatF& q);
     virtual void getRodSymOp(int i, float* r);
     virtual void getMatSymOp(int i, float g[3][3]);
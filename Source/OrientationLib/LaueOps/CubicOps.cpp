@@ -35,6 +35,8 @@
 
 #include "CubicOps.h"
 
+#include <algorithm>
+
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
@@ -68,6 +70,104 @@ namespace Detail
     static const int symSize0 = 6;
     static const int symSize1 = 12;
     static const int symSize2 = 8;
+
+    /**
+     * @brief SortedAbsMisoQuat Computes q1 * conjugate(q2) and sorts the absolute values of its components
+     * into ascending order (x <= y <= z <= w). The sort is a compare-exchange network so there are no
+     * data dependent branches.
+     */
+    inline void SortedAbsMisoQuat(const QuatF& q1, const QuatF& q2, QuatF& qco)
+    {
+      QuatF q1c = q1;
+      QuatF q2c = q2;
+      QuatF q2inv;
+      QuatF qc;
+      QuaternionMathF::Conjugate(q2c, q2inv); // Computes the Conjugate of q2 and places the result in q2inv
+      QuaternionMathF::Multiply(q1c, q2inv, qc);
+      QuaternionMathF::ElementWiseAbs(qc);
+
+      float a = qc.x, b = qc.y, c = qc.z, d = qc.w, t = 0.0f;
+      t = std::min(a, b), b = std::max(a, b), a = t;
+      t = std::min(c, d), d = std::max(c, d), c = t;
+      t = std::min(a, c), c = std::max(a, c), a = t;
+      t = std::min(b, d), d = std::max(b, d), b = t;
+      t = std::min(b, c), c = std::max(b, c), b = t;
+      qco.x = a, qco.y = b, qco.z = c, qco.w = d;
+    }
+
+    /**
+     * @brief MisoQuatFromSorted Finds the misorientation angle (and optionally the axis) from the sorted
+     * absolute quaternion components by picking the largest of the three cubic candidates.
+     */
+    inline float MisoQuatFromSorted(const QuatF& qco, bool computeAxis, float& n1, float& n2, float& n3)
+    {
+      float wmin = qco.w;
+      int type = 1;
+      float sin_wmin_over_2 = 0.0;
+      if (((qco.z + qco.w) / (SIMPLib::Constants::k_Sqrt2)) > wmin)
+      {
+        wmin = ((qco.z + qco.w) / (SIMPLib::Constants::k_Sqrt2));
+        type = 2;
+      }
+      if (((qco.x + qco.y + qco.z + qco.w) / 2) > wmin)
+      {
+        wmin = ((qco.x + qco.y + qco.z + qco.w) / 2);
+        type = 3;
+      }
+      if (wmin < -1.0)
+      {
+        //  wmin = -1.0;
+        wmin = SIMPLib::Constants::k_ACosNeg1;
+        sin_wmin_over_2 = sinf(wmin);
+      }
+      else if (wmin > 1.0)
+      {
+        //   wmin = 1.0;
+        wmin = SIMPLib::Constants::k_ACos1;
+        sin_wmin_over_2 = sinf(wmin);
+      }
+      else
+      {
+        wmin = acos(wmin);
+        sin_wmin_over_2 = sinf(wmin);
+      }
+
+      if(computeAxis)
+      {
+        if(type == 1)
+        {
+          n1 = qco.x / sin_wmin_over_2;
+          n2 = qco.y / sin_wmin_over_2;
+          n3 = qco.z / sin_wmin_over_2;
+        }
+        if(type == 2)
+        {
+          n1 = ((qco.x - qco.y) / (SIMPLib::Constants::k_Sqrt2)) / sin_wmin_over_2;
+          n2 = ((qco.x + qco.y) / (SIMPLib::Constants::k_Sqrt2)) / sin_wmin_over_2;
+          n3 = ((qco.z - qco.w) / (SIMPLib::Constants::k_Sqrt2)) / sin_wmin_over_2;
+        }
+        if(type == 3)
+        {
+          n1 = ((qco.x - qco.y + qco.z - qco.w) / (2.0f)) / sin_wmin_over_2;
+          n2 = ((qco.x + qco.y - qco.z - qco.w) / (2.0f)) / sin_wmin_over_2;
+          n3 = ((-qco.x + qco.y + qco.z - qco.w) / (2.0f)) / sin_wmin_over_2;
+        }
+        float denom = sqrt((n1 * n1 + n2 * n2 + n3 * n3));
+        n1 = n1 / denom;
+        n2 = n2 / denom;
+        n3 = n3 / denom;
+        if(denom == 0)
+        {
+          n1 = 0.0, n2 = 0.0, n3 = 1.0;
+        }
+        if(wmin == 0)
+        {
+          n1 = 0.0, n2 = 0.0, n3 = 1.0;
+        }
+      }
+      wmin = 2.0f * wmin;
+      return wmin;
+    }
   }
 }
 
@@ -349,255 +449,69 @@ float CubicOps::_calcMisoQuat(const QuatF quatsym[24], int numsym,
                               QuatF& q1, QuatF& q2,
                               float& n1, float& n2, float& n3)
 {
-  float wmin = 9999999.0f; //,na,nb,nc;
   QuatF qco;
-  QuatF qc;
-  QuatF q2inv;
-  int type = 1;
-  float sin_wmin_over_2 = 0.0;
-
-  QuaternionMathF::Conjugate(q2, q2inv); // Computes the Conjugate of q2 and places the result in q2inv
-  QuaternionMathF::Multiply(q1, q2inv, qc);
-  QuaternionMathF::ElementWiseAbs(qc);
+  Detail::CubicHigh::SortedAbsMisoQuat(q1, q2, qco);
+  return Detail::CubicHigh::MisoQuatFromSorted(qco, true, n1, n2, n3);
+}
 
-  //if qc.x is smallest
-  if ( qc.x <= qc.y && qc.x <= qc.z && qc.x <= qc.w)
-  {
-    qco.x = qc.x;
-    //if qc.y is next smallest
-    if (qc.y <= qc.z && qc.y <= qc.w)
-    {
-      qco.y = qc.y;
-      if(qc.z <= qc.w)
-      {
-        qco.z = qc.z, qco.w = qc.w;
-      }
-      else
-      {
-        qco.z = qc.w, qco.w = qc.z;
-      }
-    }
-    //if qc.z is next smallest
-    else if (qc.z <= qc.y && qc.z <= qc.w)
-    {
-      qco.y = qc.z;
-      if(qc.y <= qc.w)
-      {
-        qco.z = qc.y, qco.w = qc.w;
-      }
-      else
-      {
-        qco.z = qc.w, qco.w = qc.y;
-      }
-    }
-    //if qc.w is next smallest
-    else
-    {
-      qco.y = qc.w;
-      if(qc.y <= qc.z)
-      {
-        qco.z = qc.y, qco.w = qc.z;
-      }
-      else
-      {
-        qco.z = qc.z, qco.w = qc.y;
-      }
-    }
-  }
-  //if qc.y is smallest
-  else if ( qc.y <= qc.x && qc.y <= qc.z && qc.y <= qc.w)
-  {
-    qco.x = qc.y;
-    //if qc.x is next smallest
-    if (qc.x <= qc.z && qc.x <= qc.w)
-    {
-      qco.y = qc.x;
-      if(qc.z <= qc.w)
-      {
-        qco.z = qc.z, qco.w = qc.w;
-      }
-      else
-      {
-        qco.z = qc.w, qco.w = qc.z;
-      }
-    }
-    //if qc.z is next smallest
-    else if (qc.z <= qc.x && qc.z <= qc.w)
-    {
-      qco.y = qc.z;
-      if(qc.x <= qc.w)
-      {
-        qco.z = qc.x, qco.w = qc.w;
-      }
-      else
-      {
-        qco.z = qc.w, qco.w = qc.x;
-      }
-    }
-    //if qc.w is next smallest
-    else
-    {
-      qco.y = qc.w;
-      if(qc.x <= qc.z)
-      {
-        qco.z = qc.x, qco.w = qc.z;
-      }
-      else
-      {
-        qco.z = qc.z, qco.w = qc.x;
-      }
-    }
-  }
-  //if qc.z is smallest
-  else if ( qc.z <= qc.x && qc.z <= qc.y && qc.z <= qc.w)
-  {
-    qco.x = qc.z;
-    //if qc.x is next smallest
-    if (qc.x <= qc.y && qc.x <= qc.w)
-    {
-      qco.y = qc.x;
-      if(qc.y <= qc.w)
-      {
-        qco.z = qc.y, qco.w = qc.w;
-      }
-      else
-      {
-        qco.z = qc.w, qco.w = qc.y;
-      }
-    }
-    //if qc.y is next smallest
-    else if (qc.y <= qc.x && qc.y <= qc.w)
-    {
-      qco.y = qc.y;
-      if(qc.x <= qc.w)
-      {
-        qco.z = qc.x, qco.w = qc.w;
-      }
-      else
-      {
-        qco.z = qc.w, qco.w = qc.x;
-      }
-    }
-    //if qc.w is next smallest
-    else
-    {
-      qco.y = qc.w;
-      if(qc.x <= qc.y)
-      {
-        qco.z = qc.x, qco.w = qc.y;
-      }
-      else
-      {
-        qco.z = qc.y, qco.w = qc.x;
-      }
-    }
-  }
-  //if qc.w is smallest
-  else
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubicOps::getMisoQuats(const QuatF* q1s, const QuatF* q2s, size_t count, float* angles, float* n1s, float* n2s, float* n3s)
+{
+  bool computeAxis = (nullptr != n1s && nullptr != n2s && nullptr != n3s);
+  QuatF qco;
+  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+  for(size_t i = 0; i < count; i++)
   {
-    qco.x = qc.w;
-    //if qc.x is next smallest
-    if (qc.x <= qc.y && qc.x <= qc.z)
-    {
-      qco.y = qc.x;
-      if(qc.y <= qc.z)
-      {
-        qco.z = qc.y, qco.w = qc.z;
-      }
-      else
-      {
-        qco.z = qc.z, qco.w = qc.y;
-      }
-    }
-    //if qc.y is next smallest
-    else if (qc.y <= qc.x && qc.y <= qc.z)
-    {
-      qco.y = qc.y;
-      if(qc.x <= qc.z)
-      {
-        qco.z = qc.x, qco.w = qc.z;
-      }
-      else
-      {
-        qco.z = qc.z, qco.w = qc.x;
-      }
-    }
-    //if qc.z is next smallest
-    else
+    Detail::CubicHigh::SortedAbsMisoQuat(q1s[i], q2s[i], qco);
+    angles[i] = Detail::CubicHigh::MisoQuatFromSorted(qco, computeAxis, n1, n2, n3);
+    if(computeAxis)
     {
-      qco.y = qc.z;
-      if(qc.x <= qc.y)
-      {
-        qco.z = qc.x, qco.w = qc.y;
-      }
-      else
-      {
-        qco.z = qc.y, qco.w = qc.x;
-      }
+      n1s[i] = n1;
+      n2s[i] = n2;
+      n3s[i] = n3;
     }
   }
-  wmin = qco.w;
-  if (((qco.z + qco.w) / (SIMPLib::Constants::k_Sqrt2)) > wmin)
-  {
-    wmin = ((qco.z + qco.w) / (SIMPLib::Constants::k_Sqrt2));
-    type = 2;
-  }
-  if (((qco.x + qco.y + qco.z + qco.w) / 2) > wmin)
-  {
-    wmin = ((qco.x + qco.y + qco.z + qco.w) / 2);
-    type = 3;
-  }
-  if (wmin < -1.0)
-  {
-    //  wmin = -1.0;
-    wmin = SIMPLib::Constants::k_ACosNeg1;
-    sin_wmin_over_2 = sinf(wmin);
-  }
-  else if (wmin > 1.0)
-  {
-    //   wmin = 1.0;
-    wmin = SIMPLib::Constants::k_ACos1;
-    sin_wmin_over_2 = sinf(wmin);
-  }
-  else
-  {
-    wmin = acos(wmin);
-    sin_wmin_over_2 = sinf(wmin);
-  }
+}
 
-  if(type == 1)
-  {
-    n1 = qco.x / sin_wmin_over_2;
-    n2 = qco.y / sin_wmin_over_2;
-    n3 = qco.z / sin_wmin_over_2;
-  }
-  if(type == 2)
-  {
-    n1 = ((qco.x - qco.y) / (SIMPLib::Constants::k_Sqrt2)) / sin_wmin_over_2;
-    n2 = ((qco.x + qco.y) / (SIMPLib::Constants::k_Sqrt2)) / sin_wmin_over_2;
-    n3 = ((qco.z - qco.w) / (SIMPLib::Constants::k_Sqrt2)) / sin_wmin_over_2;
-  }
-  if(type == 3)
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool CubicOps::isMisoQuatBelow(const QuatF& q1, const QuatF& q2, float threshold)
+{
+  // angle < threshold  <=>  the largest candidate scalar part > cos(threshold / 2)
+  float wThreshold = cosf(threshold * 0.5f);
+  QuatF qco;
+  Detail::CubicHigh::SortedAbsMisoQuat(q1, q2, qco);
+  if(qco.w > wThreshold)
   {
-    n1 = ((qco.x - qco.y + qco.z - qco.w) / (2.0f)) / sin_wmin_over_2;
-    n2 = ((qco.x + qco.y - qco.z - qco.w) / (2.0f)) / sin_wmin_over_2;
-    n3 = ((-qco.x + qco.y + qco.z - qco.w) / (2.0f)) / sin_wmin_over_2;
+    return true;
   }
-  float denom = sqrt((n1 * n1 + n2 * n2 + n3 * n3));
-  n1 = n1 / denom;
-  n2 = n2 / denom;
-  n3 = n3 / denom;
-  if(denom == 0)
+  if(((qco.z + qco.w) / (SIMPLib::Constants::k_Sqrt2)) > wThreshold)
   {
-    n1 = 0.0, n2 = 0.0, n3 = 1.0;
+    return true;
   }
-  if(wmin == 0)
+  return ((qco.x + qco.y + qco.z + qco.w) / 2) > wThreshold;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t CubicOps::getMisoQuatsBelow(const QuatF* q1s, const QuatF* q2s, size_t count, float threshold, bool* below)
+{
+  float wThreshold = cosf(threshold * 0.5f);
+  size_t numBelow = 0;
+  QuatF qco;
+  for(size_t i = 0; i < count; i++)
   {
-    n1 = 0.0, n2 = 0.0, n3 = 1.0;
+    Detail::CubicHigh::SortedAbsMisoQuat(q1s[i], q2s[i], qco);
+    float w2 = (qco.z + qco.w) / (SIMPLib::Constants::k_Sqrt2);
+    float w3 = (qco.x + qco.y + qco.z + qco.w) / 2;
+    below[i] = (qco.w > wThreshold) | (w2 > wThreshold) | (w3 > wThreshold);
+    numBelow += below[i] ? 1 : 0;
   }
-  wmin = 2.0f * wmin;
-  return wmin;
-
+  return numBelow;
 }
 
 void CubicOps::getQuatSymOp(int i, QuatF& q)
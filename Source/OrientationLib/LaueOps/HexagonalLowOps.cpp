@@ -256,6 +256,33 @@ float HexagonalLowOps::getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, f
   return _calcMisoQuat(HexQuatSym, numsym, q1, q2, n1, n2, n3);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void HexagonalLowOps::getMisoQuats(const QuatF* q1s, const QuatF* q2s, size_t count, float* angles, float* n1s, float* n2s, float* n3s)
+{
+  int numsym = 6;
+  _calcMisoQuats(HexQuatSym, numsym, q1s, q2s, count, angles, n1s, n2s, n3s);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool HexagonalLowOps::isMisoQuatBelow(const QuatF& q1, const QuatF& q2, float threshold)
+{
+  int numsym = 6;
+  return _calcIsMisoQuatBelow(HexQuatSym, numsym, q1, q2, threshold);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t HexagonalLowOps::getMisoQuatsBelow(const QuatF* q1s, const QuatF* q2s, size_t count, float threshold, bool* below)
+{
+  int numsym = 6;
+  return _calcMisoQuatsBelow(HexQuatSym, numsym, q1s, q2s, count, threshold, below);
+}
+
 void HexagonalLowOps::getQuatSymOp(int i, QuatF& q)
 {
   QuaternionMathF::Copy(HexQuatSym[i], q);
@@ -291,6 +291,33 @@ float HexagonalOps::getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, floa
   return _calcMisoQuat(HexQuatSym, numsym, q1, q2, n1, n2, n3);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void HexagonalOps::getMisoQuats(const QuatF* q1s, const QuatF* q2s, size_t count, float* angles, float* n1s, float* n2s, float* n3s)
+{
+  int numsym = 12;
+  _calcMisoQuats(HexQuatSym, numsym, q1s, q2s, count, angles, n1s, n2s, n3s);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool HexagonalOps::isMisoQuatBelow(const QuatF& q1, const QuatF& q2, float threshold)
+{
+  int numsym = 12;
+  return _calcIsMisoQuatBelow(HexQuatSym, numsym, q1, q2, threshold);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t HexagonalOps::getMisoQuatsBelow(const QuatF* q1s, const QuatF* q2s, size_t count, float threshold, bool* below)
+{
+  int numsym = 12;
+  return _calcMisoQuatsBelow(HexQuatSym, numsym, q1s, q2s, count, threshold, below);
+}
+
 void HexagonalOps::getQuatSymOp(int i, QuatF& q)
 {
   QuaternionMathF::Copy(HexQuatSym[i], q);
@@ -35,6 +35,7 @@
 
 #include "LaueOps.h"
 
+#include <algorithm>
 #include <limits>
 
 #include <boost/random/mersenne_twister.hpp>
@@ -163,6 +164,137 @@ float LaueOps::_calcMisoQuat(const QuatF quatsym[24], int numsym,
   return wmin;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LaueOps::_calcMisoQuats(const QuatF quatsym[24], int numsym,
+                             const QuatF* q1s, const QuatF* q2s, size_t count,
+                             float* angles, float* n1s, float* n2s, float* n3s)
+{
+  static const size_t k_BlockSize = 64;
+  float qrx[k_BlockSize];
+  float qry[k_BlockSize];
+  float qrz[k_BlockSize];
+  float qrw[k_BlockSize];
+  float wmax[k_BlockSize];
+  int32_t symIndex[k_BlockSize];
+  bool computeAxis = (nullptr != n1s && nullptr != n2s && nullptr != n3s);
+
+  for(size_t start = 0; start < count; start += k_BlockSize)
+  {
+    size_t blockSize = std::min(k_BlockSize, count - start);
+    const QuatF* q1 = q1s + start;
+    const QuatF* q2 = q2s + start;
+
+    // Relative rotation of every pair in the block, stored as separate component arrays
+    for(size_t i = 0; i < blockSize; i++)
+    {
+      QuatF q1c = q1[i];
+      QuatF q2inv = q2[i];
+      QuatF qr;
+      QuaternionMathF::Conjugate(q2inv);
+      QuaternionMathF::Multiply(q1c, q2inv, qr);
+      qrx[i] = qr.x;
+      qry[i] = qr.y;
+      qrz[i] = qr.z;
+      qrw[i] = qr.w;
+      wmax[i] = -1.0f;
+      symIndex[i] = 0;
+    }
+
+    // The smallest misorientation angle belongs to the largest (clamped) absolute scalar part
+    for(int32_t s = 0; s < numsym; s++)
+    {
+      for(size_t i = 0; i < blockSize; i++)
+      {
+        QuatF qr = QuaternionMathF::New(qrx[i], qry[i], qrz[i], qrw[i]);
+        QuatF qc;
+        QuaternionMathF::Multiply(quatsym[s], qr, qc);
+        float w = std::min(fabsf(qc.w), 1.0f);
+        bool larger = w > wmax[i];
+        wmax[i] = larger ? w : wmax[i];
+        symIndex[i] = larger ? s : symIndex[i];
+      }
+    }
+
+    for(size_t i = 0; i < blockSize; i++)
+    {
+      float wmin = 2.0 * acos(wmax[i]);
+      angles[start + i] = wmin;
+      if(computeAxis == false)
+      {
+        continue;
+      }
+      QuatF qr = QuaternionMathF::New(qrx[i], qry[i], qrz[i], qrw[i]);
+      QuatF qc;
+      QuaternionMathF::Multiply(quatsym[symIndex[i]], qr, qc);
+      // Same normalization sequence as qu2ax followed by the normalization in _calcMisoQuat
+      float n1 = 0.0f, n2 = 0.0f, n3 = 1.0f;
+      if(wmin != 0)
+      {
+        float mag = 1.0 / sqrt(qc.x * qc.x + qc.y * qc.y + qc.z * qc.z);
+        n1 = qc.x * mag;
+        n2 = qc.y * mag;
+        n3 = qc.z * mag;
+        float denom = sqrt((n1 * n1 + n2 * n2 + n3 * n3));
+        n1 = n1 / denom;
+        n2 = n2 / denom;
+        n3 = n3 / denom;
+        if(denom == 0)
+        {
+          n1 = 0.0f, n2 = 0.0f, n3 = 1.0f;
+        }
+      }
+      n1s[start + i] = n1;
+      n2s[start + i] = n2;
+      n3s[start + i] = n3;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool LaueOps::_calcIsMisoQuatBelow(const QuatF quatsym[24], int numsym, const QuatF& q1, const QuatF& q2, float threshold)
+{
+  // angle < threshold  <=>  |w| > cos(threshold / 2) for at least one symmetry operator
+  float wThreshold = cosf(threshold * 0.5f);
+  QuatF q1c = q1;
+  QuatF q2inv = q2;
+  QuatF qr;
+  QuatF qc;
+  QuaternionMathF::Conjugate(q2inv);
+  QuaternionMathF::Multiply(q1c, q2inv, qr);
+  for(int32_t s = 0; s < numsym; s++)
+  {
+    QuaternionMathF::Multiply(quatsym[s], qr, qc);
+    if(fabsf(qc.w) > wThreshold)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t LaueOps::_calcMisoQuatsBelow(const QuatF quatsym[24], int numsym,
+                                    const QuatF* q1s, const QuatF* q2s, size_t count,
+                                    float threshold, bool* below)
+{
+  size_t numBelow = 0;
+  for(size_t i = 0; i < count; i++)
+  {
+    below[i] = _calcIsMisoQuatBelow(quatsym, numsym, q1s[i], q2s[i], threshold);
+    if(below[i])
+    {
+      numBelow++;
+    }
+  }
+  return numBelow;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -127,6 +127,41 @@ class OrientationLib_EXPORT LaueOps
      */
     virtual float getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float& n3) = 0;
 
+    /**
+     * @brief getMisoQuats Finds the misorientation of each of N quaternion pairs (q1s[i], q2s[i]). This gives
+     * the same angles as calling getMisoQuat on each pair but amortizes the virtual call and lays the symmetry
+     * loop out so that it runs across the pairs.
+     * @param q1s Array of N quaternions
+     * @param q2s Array of N quaternions
+     * @param count Number of pairs (N)
+     * @param angles [output] Array of N misorientation angles (radians)
+     * @param n1s [output] Array of N axis components. The three axis arrays may be nullptr if only the angles are needed
+     * @param n2s [output] Array of N axis components
+     * @param n3s [output] Array of N axis components
+     */
+    virtual void getMisoQuats(const QuatF* q1s, const QuatF* q2s, size_t count, float* angles, float* n1s, float* n2s, float* n3s) = 0;
+
+    /**
+     * @brief isMisoQuatBelow Determines if the misorientation between two quaternions is less than a threshold
+     * without computing the angle or the axis. Returns as soon as a symmetry operator brings the pair within the threshold.
+     * @param q1
+     * @param q2
+     * @param threshold Misorientation threshold (radians)
+     * @return
+     */
+    virtual bool isMisoQuatBelow(const QuatF& q1, const QuatF& q2, float threshold) = 0;
+
+    /**
+     * @brief getMisoQuatsBelow Batch version of isMisoQuatBelow
+     * @param q1s Array of N quaternions
+     * @param q2s Array of N quaternions
+     * @param count Number of pairs (N)
+     * @param threshold Misorientation threshold (radians)
+     * @param below [output] Array of N flags that are true if the pair misorientation is less than the threshold
+     * @return The number of pairs below the threshold
+     */
+    virtual size_t getMisoQuatsBelow(const QuatF* q1s, const QuatF* q2s, size_t count, float threshold, bool* below) = 0;
+
     /**
      * @brief getQuatSymOp Copies the symmetry operator at index i into q
      * @param i The index into the Symmetry operators array
@@ -214,6 +249,20 @@ class OrientationLib_EXPORT LaueOps
                         QuatF& q1, QuatF& q2,
                         float& n1, float& n2, float& n3);
 
+    /**
+     * @brief _calcMisoQuats Batch version of _calcMisoQuat. Pairs are processed in blocks: each symmetry operator is
+     * applied to the whole block and only the largest scalar part is kept, so the axis is computed once per pair.
+     */
+    void _calcMisoQuats(const QuatF quatsym[24], int numsym,
+                        const QuatF* q1s, const QuatF* q2s, size_t count,
+                        float* angles, float* n1s, float* n2s, float* n3s);
+
+    bool _calcIsMisoQuatBelow(const QuatF quatsym[24], int numsym, const QuatF& q1, const QuatF& q2, float threshold);
+
+    size_t _calcMisoQuatsBelow(const QuatF quatsym[24], int numsym,
+                               const QuatF* q1s, const QuatF* q2s, size_t count,
+                               float threshold, bool* below);
+
     FOrientArrayType _calcRodNearestOrigin(const float rodsym[24][3], int numsym, FOrientArrayType rod);
     void _calcNearestQuat(const QuatF quatsym[24], int numsym, QuatF& q1, QuatF& q2);
     void _calcQuatNearestOrigin(const QuatF quatsym[24], int numsym, QuatF& qr);
@@ -162,6 +162,33 @@ float MonoclinicOps::getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, flo
   return _calcMisoQuat(MonoclinicQuatSym, numsym, q1, q2, n1, n2, n3);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MonoclinicOps::getMisoQuats(const QuatF* q1s, const QuatF* q2s, size_t count, float* angles, float* n1s, float* n2s, float* n3s)
+{
+  int numsym = 2;
+  _calcMisoQuats(MonoclinicQuatSym, numsym, q1s, q2s, count, angles, n1s, n2s, n3s);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MonoclinicOps::isMisoQuatBelow(const QuatF& q1, const QuatF& q2, float threshold)
+{
+  int numsym = 2;
+  return _calcIsMisoQuatBelow(MonoclinicQuatSym, numsym, q1, q2, threshold);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t MonoclinicOps::getMisoQuatsBelow(const QuatF* q1s, const QuatF* q2s, size_t count, float threshold, bool* below)
+{
+  int numsym = 2;
+  return _calcMisoQuatsBelow(MonoclinicQuatSym, numsym, q1s, q2s, count, threshold, below);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
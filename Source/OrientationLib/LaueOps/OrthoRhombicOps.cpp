@@ -238,6 +238,33 @@ float OrthoRhombicOps::getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, f
   return _calcMisoQuat(OrthoQuatSym, numsym, q1, q2, n1, n2, n3);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void OrthoRhombicOps::getMisoQuats(const QuatF* q1s, const QuatF* q2s, size_t count, float* angles, float* n1s, float* n2s, float* n3s)
+{
+  int numsym = 4;
+  _calcMisoQuats(OrthoQuatSym, numsym, q1s, q2s, count, angles, n1s, n2s, n3s);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool OrthoRhombicOps::isMisoQuatBelow(const QuatF& q1, const QuatF& q2, float threshold)
+{
+  int numsym = 4;
+  return _calcIsMisoQuatBelow(OrthoQuatSym, numsym, q1, q2, threshold);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t OrthoRhombicOps::getMisoQuatsBelow(const QuatF* q1s, const QuatF* q2s, size_t count, float threshold, bool* below)
+{
+  int numsym = 4;
+  return _calcMisoQuatsBelow(OrthoQuatSym, numsym, q1s, q2s, count, threshold, below);
+}
+
 void OrthoRhombicOps::getQuatSymOp(int i, QuatF& q)
 {
   QuaternionMathF::Copy(OrthoQuatSym[i], q);
@@ -156,6 +156,33 @@ float TriclinicOps::getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, floa
   return _calcMisoQuat(TriclinicQuatSym, numsym, q1, q2, n1, n2, n3);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TriclinicOps::getMisoQuats(const QuatF* q1s, const QuatF* q2s, size_t count, float* angles, float* n1s, float* n2s, float* n3s)
+{
+  int numsym = 1;
+  _calcMisoQuats(TriclinicQuatSym, numsym, q1s, q2s, count, angles, n1s, n2s, n3s);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool TriclinicOps::isMisoQuatBelow(const QuatF& q1, const QuatF& q2, float threshold)
+{
+  int numsym = 1;
+  return _calcIsMisoQuatBelow(TriclinicQuatSym, numsym, q1, q2, threshold);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t TriclinicOps::getMisoQuatsBelow(const QuatF* q1s, const QuatF* q2s, size_t count, float threshold, bool* below)
+{
+  int numsym = 1;
+  return _calcMisoQuatsBelow(TriclinicQuatSym, numsym, q1s, q2s, count, threshold, below);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -0,0 +1,331 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _FixedOrientationArray_H_
+#define _FixedOrientationArray_H_
+
+#include <assert.h>
+#include <string.h>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Math/QuaternionMath.hpp"
+
+#include "OrientationLib/OrientationLib.h"
+
+
+template<typename T, size_t Capacity = 9>
+/**
+ * @brief The FixedOrientationArray class holds a single orientation representation
+ * in storage that is part of the object itself, so creating or copying one never
+ * allocates memory. It has the same interface as the owning OrientationArray and can
+ * be used as the container type of the OrientationTransforms class, whose
+ * conversions create their temporaries of up to 9 elements (an Orientation Matrix)
+ * from the same type. The number of elements is set at run time but can not grow
+ * beyond the Capacity. Unlike OrientationArray it never wraps an existing array:
+ * the pointer constructor copies the values in and copyTo() writes them back out.
+ */
+class FixedOrientationArray
+{
+
+  public:
+    /**
+     * @brief FixedOrientationArray Constructor
+     * @param size The number of elements
+     * @param init Initialization value to be assigned to each element
+     */
+    FixedOrientationArray(size_t size, T init = (T)(0) ) :
+      m_Size(size)
+    {
+      assert(m_Size <= Capacity);
+      for(size_t i = 0; i < m_Size; i++)
+      {
+        m_Data[i] = init;
+      }
+    }
+
+    /**
+     * @brief FixedOrientationArray Constructor that copies the values of an existing array
+     * @param ptr Pointer to an existing array of values
+     * @param size How many elements are in the array
+     */
+    FixedOrientationArray(const T* ptr, size_t size) :
+      m_Size(size)
+    {
+      assert(m_Size <= Capacity);
+      for(size_t i = 0; i < m_Size; i++)
+      {
+        m_Data[i] = ptr[i];
+      }
+    }
+
+    /**
+     * @brief FixedOrientationArray
+     * @param val0
+     * @param val1
+     * @param val2
+     */
+    FixedOrientationArray(T val0, T val1, T val2 ) :
+      m_Size(3)
+    {
+      m_Data[0] = val0;
+      m_Data[1] = val1;
+      m_Data[2] = val2;
+    }
+
+    /**
+     * @brief FixedOrientationArray
+     * @param val0
+     * @param val1
+     * @param val2
+     * @param val3
+     */
+    FixedOrientationArray(T val0, T val1, T val2, T val3 ) :
+      m_Size(4)
+    {
+      m_Data[0] = val0;
+      m_Data[1] = val1;
+      m_Data[2] = val2;
+      m_Data[3] = val3;
+    }
+
+    /**
+    * @brief FixedOrientationArray Constructor from a Quaternion
+    * @param quat
+    */
+    explicit FixedOrientationArray(typename QuaternionMath<T>::Quaternion quat) :
+      m_Size(4)
+    {
+      m_Data[0] = quat.x;
+      m_Data[1] = quat.y;
+      m_Data[2] = quat.z;
+      m_Data[3] = quat.w;
+    }
+
+    /**
+    * @brief FixedOrientationArray Constructor from a 3x3 "G" Matrix
+    * @param g
+    */
+    explicit FixedOrientationArray(T g[3][3]) :
+      m_Size(9)
+    {
+      for(size_t i = 0; i < 9; i++)
+      {
+        m_Data[i] = g[i / 3][i % 3];
+      }
+    }
+
+    /**
+     * @brief FixedOrientationArray Copy Constructor
+     * @param rhs Incoming FixedOrientationArray to copy
+     */
+    FixedOrientationArray(const FixedOrientationArray& rhs) :
+      m_Size(rhs.m_Size)
+    {
+      ::memcpy(m_Data, rhs.m_Data, sizeof(m_Data)); // A constant size copy is cheaper than a loop over m_Size
+    }
+
+    /**
+     * @brief operator = Copies the size and the elements of the incoming array
+     */
+    FixedOrientationArray& operator=(const FixedOrientationArray& rhs)
+    {
+      m_Size = rhs.m_Size;
+      ::memcpy(m_Data, rhs.m_Data, sizeof(m_Data));
+      return *this;
+    }
+
+    /**
+     * @brief Returns the number of elements
+     * @return
+     */
+    size_t size() const { return m_Size; }
+
+    /**
+     * @brief operator [] Returns a reference to the value at the indicated offset.
+     * This will assert if "i" is not within the bounds of the array size
+     * @param i
+     * @return
+     */
+    T& operator[](size_t i)
+    {
+      assert(i < m_Size);
+      return m_Data[i];
+    }
+
+    /**
+     * @brief operator [] Returns a const reference to the value at the indicated offset.
+     * @param i
+     * @return
+     */
+    const T& operator[](size_t i) const
+    {
+      assert(i < m_Size);
+      return m_Data[i];
+    }
+
+    /**
+     * @brief data Returns a pointer to the internal data array
+     * @return
+     */
+    T* data() { return m_Data; }
+
+    /**
+     * @brief data Returns a const pointer to the internal data array
+     * @return
+     */
+    const T* data() const { return m_Data; }
+
+    /**
+     * @brief copyTo Copies the elements out to an existing array
+     * @param ptr Array that receives size() values
+     */
+    void copyTo(T* ptr) const
+    {
+      for(size_t i = 0; i < m_Size; i++)
+      {
+        ptr[i] = m_Data[i];
+      }
+    }
+
+    /**
+     * @brief toQuat
+     * @param layout
+     * @return
+     */
+    typename QuaternionMath<T>::Quaternion toQuaternion(typename QuaternionMath<T>::Order layout = QuaternionMath<T>::QuaternionVectorScalar) const
+    {
+      assert(m_Size == 4);
+      typename QuaternionMath<T>::Quaternion quat;
+      if(layout == QuaternionMath<T>::QuaternionVectorScalar)
+      {
+        quat.x = m_Data[0], quat.y = m_Data[1], quat.z = m_Data[2], quat.w = m_Data[3];
+      }
+      else
+      {
+        quat.x = m_Data[1], quat.y = m_Data[2], quat.z = m_Data[3], quat.w = m_Data[0];
+      }
+      return quat;
+    }
+
+    /**
+     * @brief fromQuaternion Copies the values from quat into the internal memory
+     * @param quat The quaternion to copy
+     */
+    void fromQuaternion(typename QuaternionMath<T>::Quaternion quat)
+    {
+      resize(4);
+      m_Data[0] = quat.x;
+      m_Data[1] = quat.y;
+      m_Data[2] = quat.z;
+      m_Data[3] = quat.w;
+    }
+
+    /**
+     * @brief fromAxisAngle Copies the Axis-Angle values into this object.
+     * @param x X Component of the Axis
+     * @param y Y Component of the Axis
+     * @param z Z Component of the Axis
+     * @param w The "Angle" part
+     */
+    void fromAxisAngle(T x, T y, T z, T w)
+    {
+      resize(4);
+      m_Data[0] = x;
+      m_Data[1] = y;
+      m_Data[2] = z;
+      m_Data[3] = w;
+    }
+
+    /**
+     * @brief toGMatrix Copies the internal values into the 3x3 "G" Matrix
+     * @param g
+     */
+    void toGMatrix(T g[3][3]) const
+    {
+      assert(m_Size == 9);
+      for(size_t i = 0; i < 9; i++)
+      {
+        g[i / 3][i % 3] = m_Data[i];
+      }
+    }
+
+    /**
+     * @brief toAxisAngle Copies the values out to an Axis-Angle representation. Note that
+     * arguments will have values copied into them as they are pass-by-reference.
+     * @param x
+     * @param y
+     * @param z
+     * @param w
+     */
+    void toAxisAngle(T& x, T& y, T& z, T& w) const
+    {
+      x = m_Data[0];
+      y = m_Data[1];
+      z = m_Data[2];
+      w = m_Data[3];
+    }
+
+    /**
+     * @brief resize Changes the number of elements. New elements are set to zero.
+     * @param size The number of elements, at most the Capacity
+     */
+    void resize(size_t size)
+    {
+      assert(size <= Capacity);
+      for(size_t i = m_Size; i < size; i++)
+      {
+        m_Data[i] = (T)(0);
+      }
+      m_Size = size;
+    }
+
+  private:
+    T m_Data[Capacity];
+    size_t m_Size;
+
+};
+
+/**
+ * @brief FFixedOrientArrayType A convenience Typedef for a FixedOrientationArray<float>
+ */
+typedef FixedOrientationArray<float> FFixedOrientArrayType;
+
+/**
+ * @brief DFixedOrientArrayType A convenience Typedef for a FixedOrientationArray<double>
+ */
+typedef FixedOrientationArray<double> DFixedOrientArrayType;
+
+#endif /* _FixedOrientationArray_H_ */
@@ -0,0 +1,432 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _OrientationBatchTransforms_H_
+#define _OrientationBatchTransforms_H_
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+
+#include "OrientationLib/OrientationLib.h"
+#include "OrientationLib/OrientationLibConstants.h"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
+/**
+ * @brief The OrientationBatchTransforms class converts many orientations at once for the conversions that are
+ * used the most. Each function works through the tuples in blocks: a block is read into one array per component
+ * (structure of arrays), every component is computed in a loop over the block and the block is written back out.
+ * In eu2qu, eu2om and ro2ho the branches of the single orientation functions become selects, so the compiler can
+ * vectorize those loops as far as the math functions allow. qu2eu, qu2ro and ho2cu keep the branches of their
+ * degenerate cases and only gain from the block layout. A block is read completely before it is written, so the
+ * input and output may be the same array when both representations have the same number of components.
+ *
+ * The results are the same as those of the matching OrientationTransforms function. Quaternions are stored with
+ * the vector part first (QuaternionVectorScalar), as in the rest of DREAM3D.
+ *
+ * @param in Pointer to the first input tuple
+ * @param inStride Number of values between two input tuples
+ * @param out Pointer to the first output tuple, the output tuples are packed
+ * @param count Number of tuples to convert
+ */
+template<typename T>
+class OrientationBatchTransforms
+{
+  public:
+    typedef T K;
+
+    static const size_t k_BlockSize = 64;
+
+    /**
+     * @brief eu2qu Converts Euler angles to quaternions, @see OrientationTransforms::eu2qu
+     */
+    static void eu2qu(const T* in, size_t inStride, T* out, size_t count)
+    {
+      K e0[k_BlockSize], e1[k_BlockSize], e2[k_BlockSize];
+      K qx[k_BlockSize], qy[k_BlockSize], qz[k_BlockSize], qw[k_BlockSize];
+      for(size_t start = 0; start < count; start += k_BlockSize)
+      {
+        size_t n = std::min(k_BlockSize, count - start);
+        const T* src = in + start * inStride;
+        for(size_t i = 0; i < n; i++)
+        {
+          e0[i] = src[i * inStride];
+          e1[i] = src[i * inStride + 1];
+          e2[i] = src[i * inStride + 2];
+        }
+        for(size_t i = 0; i < n; i++)
+        {
+          K ee0 = 0.5 * e0[i];
+          K ee1 = 0.5 * e1[i];
+          K ee2 = 0.5 * e2[i];
+          K cPhi = cos(ee1);
+          K sPhi = sin(ee1);
+          K cm = cos(ee0 - ee2);
+          K sm = sin(ee0 - ee2);
+          K cp = cos(ee0 + ee2);
+          K sp = sin(ee0 + ee2);
+          K w = cPhi * cp;
+          K sign = (w < 0.0) ? static_cast<K>(-1.0) : static_cast<K>(1.0);
+          qw[i] = sign * w;
+          qx[i] = sign * (-RConst::epsijk * sPhi * cm);
+          qy[i] = sign * (-RConst::epsijk * sPhi * sm);
+          qz[i] = sign * (-RConst::epsijk * cPhi * sp);
+        }
+        T* dst = out + start * 4;
+        for(size_t i = 0; i < n; i++)
+        {
+          dst[i * 4] = qx[i];
+          dst[i * 4 + 1] = qy[i];
+          dst[i * 4 + 2] = qz[i];
+          dst[i * 4 + 3] = qw[i];
+        }
+      }
+    }
+
+    /**
+     * @brief eu2om Converts Euler angles to orientation matrices, @see OrientationTransforms::eu2om
+     */
+    static void eu2om(const T* in, size_t inStride, T* out, size_t count)
+    {
+      K e0[k_BlockSize], e1[k_BlockSize], e2[k_BlockSize];
+      K om[9][k_BlockSize];
+      K eps = 1.0E-7f;
+      for(size_t start = 0; start < count; start += k_BlockSize)
+      {
+        size_t n = std::min(k_BlockSize, count - start);
+        const T* src = in + start * inStride;
+        for(size_t i = 0; i < n; i++)
+        {
+          e0[i] = src[i * inStride];
+          e1[i] = src[i * inStride + 1];
+          e2[i] = src[i * inStride + 2];
+        }
+        for(size_t i = 0; i < n; i++)
+        {
+          K c1 = cos(e0[i]);
+          K c = cos(e1[i]);
+          K c2 = cos(e2[i]);
+          K s1 = sin(e0[i]);
+          K s = sin(e1[i]);
+          K s2 = sin(e2[i]);
+          om[0][i] = c1 * c2 - s1 * s2 * c;
+          om[1][i] = s1 * c2 + c1 * s2 * c;
+          om[2][i] = s2 * s;
+          om[3][i] = -c1 * s2 - s1 * c2 * c;
+          om[4][i] = -s1 * s2 + c1 * c2 * c;
+          om[5][i] = c2 * s;
+          om[6][i] = s1 * s;
+          om[7][i] = -c1 * s;
+          om[8][i] = c;
+        }
+        T* dst = out + start * 9;
+        for(size_t j = 0; j < 9; j++)
+        {
+          for(size_t i = 0; i < n; i++)
+          {
+            dst[i * 9 + j] = (fabs(om[j][i]) < eps) ? static_cast<K>(0.0) : om[j][i];
+          }
+        }
+      }
+    }
+
+    /**
+     * @brief qu2eu Converts quaternions to Euler angles, @see OrientationTransforms::qu2eu
+     */
+    static void qu2eu(const T* in, size_t inStride, T* out, size_t count)
+    {
+      K qx[k_BlockSize], qy[k_BlockSize], qz[k_BlockSize], qw[k_BlockSize];
+      K phi1[k_BlockSize], Phi[k_BlockSize], phi2[k_BlockSize];
+      for(size_t start = 0; start < count; start += k_BlockSize)
+      {
+        size_t n = std::min(k_BlockSize, count - start);
+        const T* src = in + start * inStride;
+        for(size_t i = 0; i < n; i++)
+        {
+          qx[i] = src[i * inStride];
+          qy[i] = src[i * inStride + 1];
+          qz[i] = src[i * inStride + 2];
+          qw[i] = src[i * inStride + 3];
+        }
+        for(size_t i = 0; i < n; i++)
+        {
+          K q03 = qw[i] * qw[i] + qz[i] * qz[i];
+          K q12 = qx[i] * qx[i] + qy[i] * qy[i];
+          K chi = sqrt(q03 * q12);
+          if(chi == 0.0)
+          {
+            // Rotations about the sample Z axis, or by 180 degrees about an axis in the XY plane
+            phi2[i] = 0.0;
+            if(q12 == 0.0)
+            {
+              Phi[i] = 0.0;
+              phi1[i] = atan2(-RConst::epsijk * 2.0 * qw[i] * qz[i], qw[i] * qw[i] - qz[i] * qz[i]);
+            }
+            else
+            {
+              Phi[i] = SIMPLib::Constants::k_Pi;
+              phi1[i] = atan2(2.0 * qx[i] * qy[i], qx[i] * qx[i] - qy[i] * qy[i]);
+            }
+          }
+          else
+          {
+            Phi[i] = atan2( 2.0 * chi, q03 - q12 );
+            chi = 1.0 / chi;
+            phi1[i] = atan2((-RConst::epsijk * qw[i] * qy[i] + qx[i] * qz[i]) * chi, (-RConst::epsijk * qw[i] * qx[i] - qy[i] * qz[i]) * chi);
+            phi2[i] = atan2((RConst::epsijk * qw[i] * qy[i] + qx[i] * qz[i]) * chi, (-RConst::epsijk * qw[i] * qx[i] + qy[i] * qz[i]) * chi);
+          }
+        }
+        T* dst = out + start * 3;
+        for(size_t i = 0; i < n; i++)
+        {
+          dst[i * 3] = (phi1[i] < 0.0) ? static_cast<K>(fmod(phi1[i] + 100.0 * DConst::k_Pi, DConst::k_2Pi)) : phi1[i];
+          dst[i * 3 + 1] = (Phi[i] < 0.0) ? static_cast<K>(fmod(Phi[i] + 100.0 * DConst::k_Pi, DConst::k_Pi)) : Phi[i];
+          dst[i * 3 + 2] = (phi2[i] < 0.0) ? static_cast<K>(fmod(phi2[i] + 100.0 * DConst::k_Pi, DConst::k_2Pi)) : phi2[i];
+        }
+      }
+    }
+
+    /**
+     * @brief qu2ro Converts quaternions to Rodrigues vectors, @see OrientationTransforms::qu2ro
+     */
+    static void qu2ro(const T* in, size_t inStride, T* out, size_t count)
+    {
+      K qx[k_BlockSize], qy[k_BlockSize], qz[k_BlockSize], qw[k_BlockSize];
+      K ro[4][k_BlockSize];
+      K thr = static_cast<K>(1.0E-8L);
+      for(size_t start = 0; start < count; start += k_BlockSize)
+      {
+        size_t n = std::min(k_BlockSize, count - start);
+        const T* src = in + start * inStride;
+        for(size_t i = 0; i < n; i++)
+        {
+          qx[i] = src[i * inStride];
+          qy[i] = src[i * inStride + 1];
+          qz[i] = src[i * inStride + 2];
+          qw[i] = src[i * inStride + 3];
+        }
+        for(size_t i = 0; i < n; i++)
+        {
+          K axis[3] = { qx[i], qy[i], qz[i] };
+          K s = MatrixMath::Magnitude3x1(axis);
+          if(qw[i] < thr)
+          {
+            // A rotation by 180 degrees
+            ro[0][i] = qx[i];
+            ro[1][i] = qy[i];
+            ro[2][i] = qz[i];
+            ro[3][i] = std::numeric_limits<K>::infinity();
+          }
+          else if(s < thr)
+          {
+            ro[0][i] = 0.0;
+            ro[1][i] = 0.0;
+            ro[2][i] = 0.0;
+            ro[3][i] = 0.0;
+          }
+          else
+          {
+            ro[0][i] = qx[i] / s;
+            ro[1][i] = qy[i] / s;
+            ro[2][i] = qz[i] / s;
+            ro[3][i] = tan(acos(qw[i]));
+          }
+        }
+        T* dst = out + start * 4;
+        for(size_t i = 0; i < n; i++)
+        {
+          dst[i * 4] = ro[0][i];
+          dst[i * 4 + 1] = ro[1][i];
+          dst[i * 4 + 2] = ro[2][i];
+          dst[i * 4 + 3] = ro[3][i];
+        }
+      }
+    }
+
+    /**
+     * @brief ro2ho Converts Rodrigues vectors to homochoric vectors, @see OrientationTransforms::ro2ho
+     */
+    static void ro2ho(const T* in, size_t inStride, T* out, size_t count)
+    {
+      K r0[k_BlockSize], r1[k_BlockSize], r2[k_BlockSize], r3[k_BlockSize];
+      K f[k_BlockSize];
+      for(size_t start = 0; start < count; start += k_BlockSize)
+      {
+        size_t n = std::min(k_BlockSize, count - start);
+        const T* src = in + start * inStride;
+        for(size_t i = 0; i < n; i++)
+        {
+          r0[i] = src[i * inStride];
+          r1[i] = src[i * inStride + 1];
+          r2[i] = src[i * inStride + 2];
+          r3[i] = src[i * inStride + 3];
+        }
+        for(size_t i = 0; i < n; i++)
+        {
+          K rv = r0[i] * r0[i] + r1[i] * r1[i] + r2[i] * r2[i] + r3[i] * r3[i];
+          K t = 2.0 * atan(r3[i]);
+          K fi = (r3[i] == std::numeric_limits<K>::infinity()) ? static_cast<K>(0.75 * SIMPLib::Constants::k_Pi) : static_cast<K>(0.75 * (t - sin(t)));
+          fi = pow(fi, 1.0 / 3.0);
+          f[i] = (rv == 0.0) ? static_cast<K>(0.0) : fi;
+        }
+        T* dst = out + start * 3;
+        for(size_t i = 0; i < n; i++)
+        {
+          dst[i * 3] = r0[i] * f[i];
+          dst[i * 3 + 1] = r1[i] * f[i];
+          dst[i * 3 + 2] = r2[i] * f[i];
+        }
+      }
+    }
+
+    /**
+     * @brief ho2cu Converts homochoric vectors to cubochoric vectors, @see ModifiedLambertProjection3D::LambertBallToCube
+     */
+    static void ho2cu(const T* in, size_t inStride, T* out, size_t count)
+    {
+      K h[3][k_BlockSize];
+      K cu[3][k_BlockSize];
+      const K sc = LPs::sc;
+      for(size_t start = 0; start < count; start += k_BlockSize)
+      {
+        size_t n = std::min(k_BlockSize, count - start);
+        const T* src = in + start * inStride;
+        for(size_t i = 0; i < n; i++)
+        {
+          h[0][i] = src[i * inStride];
+          h[1][i] = src[i * inStride + 1];
+          h[2][i] = src[i * inStride + 2];
+        }
+        for(size_t i = 0; i < n; i++)
+        {
+          K x = h[0][i];
+          K y = h[1][i];
+          K z = h[2][i];
+          K rs = sqrt(x * x + y * y + z * z);
+          if(rs > LPs::R1 || (x == 0.0 && y == 0.0 && z == 0.0))
+          {
+            cu[0][i] = 0.0;
+            cu[1][i] = 0.0;
+            cu[2][i] = 0.0;
+            continue;
+          }
+
+          // Rotate the coordinates so that the pyramid pair that holds the point lies along Z
+          int32_t p = 0;
+          if((fabs(x) <= z && fabs(y) <= z) || (fabs(x) <= -z && fabs(y) <= -z))
+          {
+            p = 0;
+          }
+          else if((fabs(z) <= x && fabs(y) <= x) || (fabs(z) <= -x && fabs(y) <= -x))
+          {
+            p = 1;
+          }
+          else
+          {
+            p = 2;
+          }
+          K xyz3[3] = { x, y, z };
+          if(p == 1)
+          {
+            xyz3[0] = y;
+            xyz3[1] = z;
+            xyz3[2] = x;
+          }
+          else if(p == 2)
+          {
+            xyz3[0] = z;
+            xyz3[1] = x;
+            xyz3[2] = y;
+          }
+
+          // inverse M_3
+          K q = sqrt( 2.0 * rs / (rs + fabs(xyz3[2])) );
+          K xyz20 = xyz3[0] * q;
+          K xyz21 = xyz3[1] * q;
+          K xyz22 = (fabs(xyz3[2]) / xyz3[2]) * rs / LPs::pref;
+
+          // inverse M_2
+          K qxy = xyz20 * xyz20 + xyz21 * xyz21;
+          K sx = (xyz20 != 0.0) ? static_cast<K>(fabs(xyz20) / xyz20) : static_cast<K>(1.0);
+          K sy = (xyz21 != 0.0) ? static_cast<K>(fabs(xyz21) / xyz21) : static_cast<K>(1.0);
+          K T1inv = 0.0;
+          K T2inv = 0.0;
+          if(qxy != 0.0)
+          {
+            bool xMajor = (fabs(xyz21) <= fabs(xyz20));
+            K major = xMajor ? xyz20 : xyz21;
+            K minor = xMajor ? xyz21 : xyz20;
+            K q2xy = qxy + major * major;
+            K sq2xy = sqrt(q2xy);
+            q = (LPs::beta / LPs::r2 / LPs::R1) * sqrt(q2xy * qxy / (q2xy - fabs(major) * sq2xy));
+            K tt = (minor * minor + fabs(major) * sq2xy) / LPs::r2 / qxy;
+            tt = std::min(std::max(tt, static_cast<K>(-1.0)), static_cast<K>(1.0));
+            K ac = acos(tt);
+            T1inv = xMajor ? static_cast<K>(q * sx) : static_cast<K>(q * sx * ac / LPs::pi12);
+            T2inv = xMajor ? static_cast<K>(q * sy * ac / LPs::pi12) : static_cast<K>(q * sy);
+          }
+
+          // inverse M_1, then rotate the coordinates back
+          K xyz1[3] = { T1inv / sc, T2inv / sc, xyz22 / sc };
+          cu[p % 3][i] = xyz1[0];
+          cu[(p + 1) % 3][i] = xyz1[1];
+          cu[(p + 2) % 3][i] = xyz1[2];
+        }
+        T* dst = out + start * 3;
+        for(size_t i = 0; i < n; i++)
+        {
+          dst[i * 3] = cu[0][i];
+          dst[i * 3 + 1] = cu[1][i];
+          dst[i * 3 + 2] = cu[2][i];
+        }
+      }
+    }
+
+  protected:
+    OrientationBatchTransforms() {}
+
+  private:
+    OrientationBatchTransforms(const OrientationBatchTransforms&); // Copy Constructor Not Implemented
+    void operator=(const OrientationBatchTransforms&); // Operator '=' Not Implemented
+};
+
+template<typename T>
+const size_t OrientationBatchTransforms<T>::k_BlockSize;
+
+#endif /* _OrientationBatchTransforms_H_ */
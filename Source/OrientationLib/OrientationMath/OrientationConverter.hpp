@@ -48,8 +48,55 @@
 
 #include "OrientationLib/OrientationLib.h"
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/FixedOrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationBatchTransforms.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+/**
+ * @brief The OrientationConversionImpl class converts a range of the tuples of an orientation array. The
+ * conversion function is called with the first input tuple, the input stride, the first output tuple and
+ * the number of tuples of the range.
+ */
+template<typename T, typename ConversionFunction>
+class OrientationConversionImpl
+{
+  public:
+    OrientationConversionImpl(const T* input, size_t inStride, T* output, size_t outStride, ConversionFunction function) :
+      m_Input(input),
+      m_InStride(inStride),
+      m_Output(output),
+      m_OutStride(outStride),
+      m_Function(function)
+    {}
+    virtual ~OrientationConversionImpl() {}
+
+    void convert(size_t start, size_t end) const
+    {
+      m_Function(m_Input + start * m_InStride, m_InStride, m_Output + start * m_OutStride, end - start);
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const T* m_Input;
+    size_t m_InStride;
+    T* m_Output;
+    size_t m_OutStride;
+    ConversionFunction m_Function;
+};
+
 template<typename T>
 class OrientationConverter
 {
@@ -97,6 +144,21 @@ class OrientationConverter
       else if(repType == Cubochoric) { toCubochoric(); }
     }
 
+    /**
+    * @brief convertRepresentationTo Converts the input orientations straight into an existing array, which is
+    * also set as the output data. The array must have as many tuples as the input and the number of components
+    * of the new representation, otherwise the output data is set to nullptr. It may be the input array itself
+    * when both representations have the same number of components, which converts the orientations in place.
+    * @param repType
+    * @param destination
+    */
+    void convertRepresentationTo(OrientationType repType, typename DataArray<T>::Pointer destination)
+    {
+      m_Destination = destination;
+      convertRepresentationTo(repType);
+      m_Destination = typename DataArray<T>::Pointer();
+    }
+
     /**
      * @brief toEulers Converts the input orientations to Euler Angles
      */
@@ -233,31 +295,122 @@ class OrientationConverter
   protected:
     OrientationConverter() {}
 
+    /**
+     * @brief createOutputData Returns the array that the conversion writes to: the destination array if one
+     * was given, or a new array. The values of a new array are not initialized since the conversion writes all
+     * of them.
+     * @param nTuples
+     * @param outStride
+     * @param name
+     * @return The array, or nullptr if the destination array does not have the needed size
+     */
+    typename DataArray<T>::Pointer createOutputData(size_t nTuples, int outStride, const QString& name)
+    {
+      if(nullptr != m_Destination.get())
+      {
+        if(m_Destination->getNumberOfTuples() != nTuples || m_Destination->getNumberOfComponents() != outStride)
+        {
+          return typename DataArray<T>::Pointer();
+        }
+        return m_Destination;
+      }
+      QVector<size_t> cDims(1, outStride); /* Create the n component (nx1) based array.*/
+      return DataArray<T>::CreateArray(nTuples, cDims, name, true);
+    }
+
+    /**
+     * @brief convertTuples Converts every tuple of the input data into the output data, in parallel ranges of
+     * tuples when DREAM3D is built with parallel algorithms
+     * @param outStride Number of components of the new representation
+     * @param name Name of the output array, if a new one is created
+     * @param function Conversion of a range of tuples, @see OrientationConversionImpl
+     */
+    template<typename ConversionFunction>
+    void convertTuples(int outStride, const QString& name, ConversionFunction function)
+    {
+      typename DataArray<T>::Pointer input = getInputData();
+      size_t nTuples = input->getNumberOfTuples();
+      int inStride = input->getNumberOfComponents();
+
+      typename DataArray<T>::Pointer output = createOutputData(nTuples, outStride, name);
+      setOutputData(output);
+      if(nullptr == output.get())
+      {
+        return;
+      }
+      // Converting in place only works when every tuple keeps its position
+      if((output == input && inStride != outStride) || inStride < GetComponentCounts()[getOrientationRepresentation()])
+      {
+        setOutputData(typename DataArray<T>::Pointer());
+        return;
+      }
+
+      OrientationConversionImpl<T, ConversionFunction> impl(input->getPointer(0), inStride, output->getPointer(0), outStride, function);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      tbb::task_scheduler_init init;
+      bool doParallel = true;
+      if(doParallel == true)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, nTuples, 4096), impl, tbb::simple_partitioner());
+      }
+      else
+#endif
+      {
+        impl.convert(0, nTuples);
+      }
+    }
+
+    /**
+     * @brief copyInputData Sets the output data to a copy of the input data, for a conversion to the same
+     * representation. Nothing is copied when the destination array is the input array.
+     */
+    void copyInputData()
+    {
+      typename DataArray<T>::Pointer input = getInputData();
+      if(nullptr == m_Destination.get())
+      {
+        setOutputData(std::dynamic_pointer_cast<DataArray<T> >(input->deepCopy()));
+        return;
+      }
+      if(m_Destination->getNumberOfTuples() != input->getNumberOfTuples() || m_Destination->getNumberOfComponents() != input->getNumberOfComponents())
+      {
+        setOutputData(typename DataArray<T>::Pointer());
+        return;
+      }
+      if(m_Destination != input)
+      {
+        std::copy(input->getPointer(0), input->getPointer(0) + input->getSize(), m_Destination->getPointer(0));
+      }
+      setOutputData(m_Destination);
+    }
+
   private:
+    typename DataArray<T>::Pointer m_Destination;
+
     OrientationConverter(const OrientationConverter&); // Copy Constructor Not Implemented
     void operator=( const OrientationConverter& ); // Operator '=' Not Implemented
 
 };
 
+// The orientations are converted in FixedOrientationArray values so that the temporaries of the conversions
+// do not allocate memory for every element
 #define OC_CONVERT_BODY(OUTSTRIDE, OUT_ARRAY_NAME, CONVERSION_METHOD)\
-  typedef OrientationArray<T> OrientationArray_t;\
-  typename DataArray<T>::Pointer input = this->getInputData();\
-  T* inPtr = input->getPointer(0);\
-  size_t nTuples = input->getNumberOfTuples();\
-  int inStride = input->getNumberOfComponents();\
-  int outStride = OUTSTRIDE;\
-  QVector<size_t> cDims(1, outStride); /* Create the n component (nx1) based array.*/ \
-  typename DataArray<T>::Pointer output = DataArray<T>::CreateArray(nTuples, cDims, #OUT_ARRAY_NAME);\
-  output->initializeWithZeros(); /* Intialize the array with Zeros */ \
-  T* OUT_ARRAY_NAME##Ptr = output->getPointer(0);\
-  for (size_t i = 0; i < nTuples; ++i) { \
-    OrientationArray_t rot(inPtr, inStride); \
-    OrientationArray_t res(OUT_ARRAY_NAME##Ptr, outStride); \
-    OrientationTransforms<OrientationArray_t, T>::CONVERSION_METHOD(rot, res); \
-    inPtr = inPtr + inStride; /* Increment input pointer */ \
-    OUT_ARRAY_NAME##Ptr = OUT_ARRAY_NAME##Ptr + outStride; /* Increment output pointer*/ \
-  }\
-  this->setOutputData(output);
+  typedef FixedOrientationArray<T> OrientationArray_t;\
+  size_t inComps = OrientationConverter<T>::GetComponentCounts()[this->getOrientationRepresentation()];\
+  this->convertTuples(OUTSTRIDE, #OUT_ARRAY_NAME, [inComps](const T* inPtr, size_t inStride, T* outPtr, size_t count) {\
+    for (size_t i = 0; i < count; ++i) { \
+      OrientationArray_t rot(inPtr + i * inStride, inComps); \
+      OrientationArray_t res(OUTSTRIDE); \
+      OrientationTransforms<OrientationArray_t, T>::CONVERSION_METHOD(rot, res); \
+      res.copyTo(outPtr + i * OUTSTRIDE); \
+    }\
+  });
+
+// The conversions that OrientationBatchTransforms implements convert blocks of tuples at once
+#define OC_BATCH_CONVERT_BODY(OUTSTRIDE, OUT_ARRAY_NAME, CONVERSION_METHOD)\
+  this->convertTuples(OUTSTRIDE, #OUT_ARRAY_NAME, [](const T* inPtr, size_t inStride, T* outPtr, size_t count) {\
+    OrientationBatchTransforms<T>::CONVERSION_METHOD(inPtr, inStride, outPtr, count);\
+  });
 
 
 
@@ -281,22 +434,19 @@ class EulerConverter : public OrientationConverter<T>
 
     virtual void toEulers()
     {
-      typedef typename DataArray<T>::Pointer PointerType;
-      PointerType input = this->getInputData();
-      PointerType output = std::dynamic_pointer_cast<DataArray<T> >(input->deepCopy());
-      this->setOutputData(output);
+      this->copyInputData();
     }
 
     virtual void toOrientationMatrix()
     {
       sanityCheckInputData();
-      OC_CONVERT_BODY(9, OrientationMatrix, eu2om)
+      OC_BATCH_CONVERT_BODY(9, OrientationMatrix, eu2om)
     }
 
     virtual void toQuaternion()
     {
       sanityCheckInputData();
-      OC_CONVERT_BODY(4, Quaternions, eu2qu)
+      OC_BATCH_CONVERT_BODY(4, Quaternions, eu2qu)
     }
 
     virtual void toAxisAngle()
@@ -403,10 +553,7 @@ class OrientationMatrixConverter : public OrientationConverter<T>
 
     virtual void toOrientationMatrix()
     {
-      typedef typename DataArray<T>::Pointer PointerType;
-      PointerType input = this->getInputData();
-      PointerType output = std::dynamic_pointer_cast<DataArray<T> >(input->deepCopy());
-      this->setOutputData(output);
+      this->copyInputData();
     }
 
     virtual void toQuaternion()
@@ -520,7 +667,7 @@ class QuaternionConverter : public OrientationConverter<T>
 
     virtual void toEulers()
     {
-      OC_CONVERT_BODY(3, Eulers, qu2eu)
+      OC_BATCH_CONVERT_BODY(3, Eulers, qu2eu)
     }
 
     virtual void toOrientationMatrix()
@@ -530,10 +677,7 @@ class QuaternionConverter : public OrientationConverter<T>
 
     virtual void toQuaternion()
     {
-      typedef typename DataArray<T>::Pointer PointerType;
-      PointerType input = this->getInputData();
-      PointerType output = std::dynamic_pointer_cast<DataArray<T> >(input->deepCopy());
-      this->setOutputData(output);
+      this->copyInputData();
     }
 
     virtual void toAxisAngle()
@@ -543,7 +687,7 @@ class QuaternionConverter : public OrientationConverter<T>
 
     virtual void toRodrigues()
     {
-      OC_CONVERT_BODY(4, Rodrigues, qu2ro)
+      OC_BATCH_CONVERT_BODY(4, Rodrigues, qu2ro)
     }
 
     virtual void toHomochoric()
@@ -635,10 +779,7 @@ class AxisAngleConverter : public OrientationConverter<T>
 
     virtual void toAxisAngle()
     {
-      typedef typename DataArray<T>::Pointer PointerType;
-      PointerType input = this->getInputData();
-      PointerType output = std::dynamic_pointer_cast<DataArray<T> >(input->deepCopy());
-      this->setOutputData(output);
+      this->copyInputData();
     }
 
     virtual void toRodrigues()
@@ -735,15 +876,12 @@ class RodriguesConverter : public OrientationConverter<T>
 
     virtual void toRodrigues()
     {
-      typedef typename DataArray<T>::Pointer PointerType;
-      PointerType input = this->getInputData();
-      PointerType output = std::dynamic_pointer_cast<DataArray<T> >(input->deepCopy());
-      this->setOutputData(output);
+      this->copyInputData();
     }
 
     virtual void toHomochoric()
     {
-      OC_CONVERT_BODY(3, Homochoric, ro2ho)
+      OC_BATCH_CONVERT_BODY(3, Homochoric, ro2ho)
     }
 
     virtual void toCubochoric()
@@ -835,15 +973,12 @@ class HomochoricConverter : public OrientationConverter<T>
 
     virtual void toHomochoric()
     {
-      typedef typename DataArray<T>::Pointer PointerType;
-      PointerType input = this->getInputData();
-      PointerType output = std::dynamic_pointer_cast<DataArray<T> >(input->deepCopy());
-      this->setOutputData(output);
+      this->copyInputData();
     }
 
     virtual void toCubochoric()
     {
-      OC_CONVERT_BODY(3, Cubochoric, ho2cu)
+      OC_BATCH_CONVERT_BODY(3, Cubochoric, ho2cu)
     }
 
     virtual void sanityCheckInputData()
@@ -936,10 +1071,7 @@ class CubochoricConverter : public OrientationConverter<T>
 
     virtual void toCubochoric()
     {
-      typedef typename DataArray<T>::Pointer PointerType;
-      PointerType input = this->getInputData();
-      PointerType output = std::dynamic_pointer_cast<DataArray<T> >(input->deepCopy());
-      this->setOutputData(output);
+      this->copyInputData();
     }
 
     virtual void sanityCheckInputData()
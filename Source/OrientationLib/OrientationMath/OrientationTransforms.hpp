@@ -55,6 +55,7 @@
 
 #include "OrientationLib/OrientationLib.h"
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/FixedOrientationArray.hpp"
 #include "OrientationLib/Utilities/ModifiedLambertProjection3D.hpp"
 
 
@@ -133,7 +134,7 @@ namespace DConst = SIMPLib::Constants;
 
 /**
  * @brief The OrientationTransforms class
- * template parameter T can be one of std::vector<T>, QVector<T> or OrientationArray<T>
+ * template parameter T can be one of std::vector<T>, QVector<T>, OrientationArray<T> or FixedOrientationArray<T>
  * and template parameter K is the type specified in T. For example if T is std::vector<float>
  * then K is float.
  */
@@ -2149,6 +2150,8 @@ class OrientationTransforms
 
 typedef OrientationTransforms<FOrientArrayType, float>     FOrientTransformsType;
 typedef OrientationTransforms<DOrientArrayType, double>     DOrientTransformsType;
+typedef OrientationTransforms<FFixedOrientArrayType, float>     FFixedOrientTransformsType;
+typedef OrientationTransforms<DFixedOrientArrayType, double>     DFixedOrientTransformsType;
 
 
 #endif /* _OrientationTransforms_H_ */
@@ -39,6 +39,8 @@ set(OrientationLib_OrientationMath_HDRS
   ${OrientationLib_SOURCE_DIR}/OrientationMath/OrientationMath.h
   ${OrientationLib_SOURCE_DIR}/OrientationMath/OrientationTransforms.hpp
   ${OrientationLib_SOURCE_DIR}/OrientationMath/OrientationArray.hpp
+  ${OrientationLib_SOURCE_DIR}/OrientationMath/FixedOrientationArray.hpp
+  ${OrientationLib_SOURCE_DIR}/OrientationMath/OrientationBatchTransforms.hpp
   ${OrientationLib_SOURCE_DIR}/OrientationMath/OrientationConverter.hpp
 )
 
@@ -0,0 +1,293 @@
+/* ============================================================================
+ * Copyright (c) 2015 BlueQuartz Softwae, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <QtCore/QtGlobal>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "OrientationLibTestFileLocations.h"
+
+#include "OrientationLib/OrientationMath/FixedOrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
+// One entry of the conversion table, holding the conversion for both container types
+#define FOA_CONVERSION(FROM, TO)\
+  { #FROM "2" #TO, FROM##_Index, TO##_Index,\
+    [](const FOrientArrayType& in, FOrientArrayType& out) { FOrientTransformsType::FROM##2##TO(in, out); },\
+    [](const FFixedOrientArrayType& in, FFixedOrientArrayType& out) { FFixedOrientTransformsType::FROM##2##TO(in, out); } }
+
+class FixedOrientationArrayTest
+{
+  public:
+    FixedOrientationArrayTest(){}
+    virtual ~FixedOrientationArrayTest(){}
+
+    enum RepresentationIndex
+    {
+      eu_Index = 0,
+      om_Index,
+      ax_Index,
+      ro_Index,
+      qu_Index,
+      ho_Index,
+      cu_Index,
+      NumRepresentations
+    };
+
+    typedef void (*ArrayConversion)(const FOrientArrayType&, FOrientArrayType&);
+    typedef void (*FixedConversion)(const FFixedOrientArrayType&, FFixedOrientArrayType&);
+
+    typedef struct
+    {
+      const char* name;
+      int from;
+      int to;
+      ArrayConversion arrayConversion;
+      FixedConversion fixedConversion;
+    } Conversion_t;
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void RemoveTestFiles()
+    {
+#if REMOVE_TEST_FILES
+      // QFile::remove();
+#endif
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    std::vector<Conversion_t> GetConversions()
+    {
+      Conversion_t conversions[42] = {
+        FOA_CONVERSION(eu, om), FOA_CONVERSION(eu, ax), FOA_CONVERSION(eu, ro), FOA_CONVERSION(eu, qu), FOA_CONVERSION(eu, ho), FOA_CONVERSION(eu, cu),
+        FOA_CONVERSION(om, eu), FOA_CONVERSION(om, ax), FOA_CONVERSION(om, ro), FOA_CONVERSION(om, qu), FOA_CONVERSION(om, ho), FOA_CONVERSION(om, cu),
+        FOA_CONVERSION(ax, eu), FOA_CONVERSION(ax, om), FOA_CONVERSION(ax, ro), FOA_CONVERSION(ax, qu), FOA_CONVERSION(ax, ho), FOA_CONVERSION(ax, cu),
+        FOA_CONVERSION(ro, eu), FOA_CONVERSION(ro, om), FOA_CONVERSION(ro, ax), FOA_CONVERSION(ro, qu), FOA_CONVERSION(ro, ho), FOA_CONVERSION(ro, cu),
+        FOA_CONVERSION(qu, eu), FOA_CONVERSION(qu, om), FOA_CONVERSION(qu, ax), FOA_CONVERSION(qu, ro), FOA_CONVERSION(qu, ho), FOA_CONVERSION(qu, cu),
+        FOA_CONVERSION(ho, eu), FOA_CONVERSION(ho, om), FOA_CONVERSION(ho, ax), FOA_CONVERSION(ho, ro), FOA_CONVERSION(ho, qu), FOA_CONVERSION(ho, cu),
+        FOA_CONVERSION(cu, eu), FOA_CONVERSION(cu, om), FOA_CONVERSION(cu, ax), FOA_CONVERSION(cu, ro), FOA_CONVERSION(cu, qu), FOA_CONVERSION(cu, ho)
+      };
+      return std::vector<Conversion_t>(conversions, conversions + 42);
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int GetStride(int representation)
+    {
+      int strides[NumRepresentations] = {3, 9, 4, 4, 4, 3, 3};
+      return strides[representation];
+    }
+
+    // -----------------------------------------------------------------------------
+    // Creates the same set of orientations in every representation, starting from a grid of Euler angles
+    // -----------------------------------------------------------------------------
+    std::vector<std::vector<float> > CreateInputs(size_t& count)
+    {
+      const size_t steps = 24;
+      count = steps * steps * steps;
+      std::vector<std::vector<float> > inputs(NumRepresentations);
+      inputs[eu_Index].resize(count * 3);
+      size_t i = 0;
+      for(size_t p2 = 0; p2 < steps; p2++)
+      {
+        for(size_t p = 0; p < steps; p++)
+        {
+          for(size_t p1 = 0; p1 < steps; p1++)
+          {
+            inputs[eu_Index][i * 3] = (static_cast<float>(p1) + 0.25f) * SIMPLib::Constants::k_2Pi / steps;
+            inputs[eu_Index][i * 3 + 1] = (static_cast<float>(p) + 0.25f) * SIMPLib::Constants::k_Pi / steps;
+            inputs[eu_Index][i * 3 + 2] = (static_cast<float>(p2) + 0.25f) * SIMPLib::Constants::k_2Pi / steps;
+            i++;
+          }
+        }
+      }
+
+      std::vector<Conversion_t> conversions = GetConversions();
+      for(size_t c = 0; c < conversions.size(); c++)
+      {
+        if(conversions[c].from != eu_Index)
+        {
+          continue;
+        }
+        int to = conversions[c].to;
+        int stride = GetStride(to);
+        inputs[to].resize(count * stride);
+        for(size_t j = 0; j < count; j++)
+        {
+          FOrientArrayType eu(&(inputs[eu_Index][j * 3]), 3);
+          FOrientArrayType res(&(inputs[to][j * stride]), stride);
+          conversions[c].arrayConversion(eu, res);
+        }
+      }
+      return inputs;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Converts every orientation the way OC_CONVERT_BODY did before, by wrapping the input and output arrays
+    // -----------------------------------------------------------------------------
+    void ConvertWithOrientationArray(const Conversion_t& conversion, std::vector<float>& input, std::vector<float>& output, size_t count)
+    {
+      int inStride = GetStride(conversion.from);
+      int outStride = GetStride(conversion.to);
+      for(size_t i = 0; i < count; i++)
+      {
+        FOrientArrayType rot(&(input[i * inStride]), inStride);
+        FOrientArrayType res(&(output[i * outStride]), outStride);
+        conversion.arrayConversion(rot, res);
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    // Converts every orientation the way OC_CONVERT_BODY does now, through FixedOrientationArray values
+    // -----------------------------------------------------------------------------
+    void ConvertWithFixedOrientationArray(const Conversion_t& conversion, std::vector<float>& input, std::vector<float>& output, size_t count)
+    {
+      int inStride = GetStride(conversion.from);
+      int outStride = GetStride(conversion.to);
+      for(size_t i = 0; i < count; i++)
+      {
+        FFixedOrientArrayType rot(&(input[i * inStride]), inStride);
+        FFixedOrientArrayType res(outStride);
+        conversion.fixedConversion(rot, res);
+        res.copyTo(&(output[i * outStride]));
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void TestFixedOrientationArray()
+    {
+      FFixedOrientArrayType eu(0.5f, 1.0f, 1.5f);
+      DREAM3D_REQUIRE_EQUAL(eu.size(), 3)
+
+      FFixedOrientArrayType copy(eu);
+      DREAM3D_REQUIRE_EQUAL(copy.size(), 3)
+      DREAM3D_REQUIRE_EQUAL(copy[2], 1.5f)
+
+      copy.resize(4);
+      DREAM3D_REQUIRE_EQUAL(copy[3], 0.0f)
+      copy[3] = 2.0f;
+      QuatF q = copy.toQuaternion();
+      DREAM3D_REQUIRE_EQUAL(q.x, 0.5f)
+      DREAM3D_REQUIRE_EQUAL(q.w, 2.0f)
+
+      copy = eu;
+      DREAM3D_REQUIRE_EQUAL(copy.size(), 3)
+
+      float values[9] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f};
+      FFixedOrientArrayType om(values, 9);
+      float out[9] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+      om.copyTo(out);
+      for(int i = 0; i < 9; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(out[i], values[i])
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    // Every conversion gives the same values through FixedOrientationArray as through OrientationArray. The time
+    // per conversion of both is printed as a benchmark when DREAM3D_PRINT_BENCHMARKS is set in the environment.
+    // -----------------------------------------------------------------------------
+    void TestConversionsMatch()
+    {
+      size_t count = 0;
+      std::vector<std::vector<float> > inputs = CreateInputs(count);
+      std::vector<Conversion_t> conversions = GetConversions();
+
+      bool printTimes = !qgetenv("DREAM3D_PRINT_BENCHMARKS").isEmpty();
+      if(printTimes)
+      {
+        std::cout << "Conversion    OrientationArray (ns)   FixedOrientationArray (ns)" << std::endl;
+      }
+      for(size_t c = 0; c < conversions.size(); c++)
+      {
+        const Conversion_t& conversion = conversions[c];
+        int outStride = GetStride(conversion.to);
+        std::vector<float> arrayOutput(count * outStride, 0.0f);
+        std::vector<float> fixedOutput(count * outStride, 0.0f);
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        ConvertWithOrientationArray(conversion, inputs[conversion.from], arrayOutput, count);
+        std::chrono::steady_clock::time_point middle = std::chrono::steady_clock::now();
+        ConvertWithFixedOrientationArray(conversion, inputs[conversion.from], fixedOutput, count);
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+        for(size_t i = 0; i < arrayOutput.size(); i++)
+        {
+          if(std::isfinite(arrayOutput[i]))
+          {
+            DREAM3D_REQUIRE(std::fabs(arrayOutput[i] - fixedOutput[i]) <= 1.0E-6f * std::max(1.0f, std::fabs(arrayOutput[i])))
+          }
+          else
+          {
+            DREAM3D_REQUIRE(!std::isfinite(fixedOutput[i]))
+          }
+        }
+
+        if(printTimes)
+        {
+          double arrayTime = std::chrono::duration<double, std::nano>(middle - start).count() / count;
+          double fixedTime = std::chrono::duration<double, std::nano>(end - middle).count() / count;
+          std::cout << std::setw(10) << conversion.name << std::fixed << std::setprecision(1) << std::setw(20) << arrayTime << std::setw(25) << fixedTime << std::endl;
+        }
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+      DREAM3D_REGISTER_TEST( TestFixedOrientationArray() )
+      DREAM3D_REGISTER_TEST( TestConversionsMatch() )
+      DREAM3D_REGISTER_TEST( RemoveTestFiles() )
+    }
+
+  private:
+    FixedOrientationArrayTest(const FixedOrientationArrayTest&); // Copy Constructor Not Implemented
+    void operator=(const FixedOrientationArrayTest&); // Operator '=' Not Implemented
+};
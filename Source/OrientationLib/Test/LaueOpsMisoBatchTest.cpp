@@ -0,0 +1,158 @@
+/* ============================================================================
+ * Copyright (c) 2015 BlueQuartz Softwae, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Math/QuaternionMath.hpp"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "OrientationLibTestFileLocations.h"
+
+#include "OrientationLib/LaueOps/LaueOps.h"
+
+class LaueOpsMisoBatchTest
+{
+  public:
+    LaueOpsMisoBatchTest(){}
+    virtual ~LaueOpsMisoBatchTest(){}
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void RemoveTestFiles()
+    {
+#if REMOVE_TEST_FILES
+      // QFile::remove();
+#endif
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    QuatF RandomUnitQuat(uint32_t& seed)
+    {
+      float v[4];
+      float mag = 0.0f;
+      for(int i = 0; i < 4; i++)
+      {
+        seed = seed * 1664525u + 1013904223u;
+        v[i] = static_cast<float>(seed >> 8) / static_cast<float>(1 << 24) * 2.0f - 1.0f;
+        mag += v[i] * v[i];
+      }
+      mag = sqrtf(mag);
+      return QuaternionMathF::New(v[0] / mag, v[1] / mag, v[2] / mag, v[3] / mag);
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void TestBatchMatchesScalar()
+    {
+      // 150 pairs so the 64 wide block kernel sees two full blocks and a partial one
+      const size_t count = 150;
+      std::vector<QuatF> q1s(count);
+      std::vector<QuatF> q2s(count);
+      uint32_t seed = 5489u;
+      for(size_t i = 0; i < count; i++)
+      {
+        q1s[i] = RandomUnitQuat(seed);
+        q2s[i] = RandomUnitQuat(seed);
+      }
+      // Make a few pairs nearly identical so the threshold test sees both outcomes
+      for(size_t i = 0; i < count; i += 7)
+      {
+        q2s[i] = q1s[i];
+      }
+
+      std::vector<float> angles(count, 0.0f);
+      std::vector<float> n1s(count, 0.0f);
+      std::vector<float> n2s(count, 0.0f);
+      std::vector<float> n3s(count, 0.0f);
+      bool* below = new bool[count];
+      const float threshold = 5.0f * SIMPLib::Constants::k_PiOver180;
+
+      QVector<LaueOps::Pointer> ops = LaueOps::getOrientationOpsQVector();
+      for(int o = 0; o < ops.size(); o++)
+      {
+        if(nullptr == ops[o].get()) { continue; }
+        ops[o]->getMisoQuats(q1s.data(), q2s.data(), count, angles.data(), n1s.data(), n2s.data(), n3s.data());
+        size_t numBelow = ops[o]->getMisoQuatsBelow(q1s.data(), q2s.data(), count, threshold, below);
+
+        size_t expectedBelow = 0;
+        for(size_t i = 0; i < count; i++)
+        {
+          QuatF q1 = q1s[i];
+          QuatF q2 = q2s[i];
+          float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+          float w = ops[o]->getMisoQuat(q1, q2, n1, n2, n3);
+          DREAM3D_REQUIRE(fabsf(w - angles[i]) < 1.0E-4f)
+          if(w > 1.0E-3f)
+          {
+            DREAM3D_REQUIRE(fabsf(n1 - n1s[i]) < 1.0E-3f)
+            DREAM3D_REQUIRE(fabsf(n2 - n2s[i]) < 1.0E-3f)
+            DREAM3D_REQUIRE(fabsf(n3 - n3s[i]) < 1.0E-3f)
+          }
+          // Stay clear of the threshold itself where float rounding may legitimately differ
+          if(fabsf(w - threshold) > 1.0E-4f)
+          {
+            DREAM3D_REQUIRE_EQUAL(below[i], (w < threshold))
+            DREAM3D_REQUIRE_EQUAL(ops[o]->isMisoQuatBelow(q1s[i], q2s[i], threshold), (w < threshold))
+          }
+          if(below[i]) { expectedBelow++; }
+        }
+        DREAM3D_REQUIRE_EQUAL(numBelow, expectedBelow)
+        DREAM3D_REQUIRE(numBelow > 0)
+
+        // The axis arrays are optional
+        ops[o]->getMisoQuats(q1s.data(), q2s.data(), count, angles.data(), nullptr, nullptr, nullptr);
+      }
+      delete[] below;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+      DREAM3D_REGISTER_TEST( TestBatchMatchesScalar() )
+      DREAM3D_REGISTER_TEST( RemoveTestFiles() )
+    }
+
+  private:
+    LaueOpsMisoBatchTest(const LaueOpsMisoBatchTest&); // Copy Constructor Not Implemented
+    void operator=(const LaueOpsMisoBatchTest&); // Operator '=' Not Implemented
+};
+
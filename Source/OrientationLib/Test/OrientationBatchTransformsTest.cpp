@@ -0,0 +1,284 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "OrientationLib/OrientationLibConstants.h"
+#include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationBatchTransforms.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
+#include "OrientationLibTestFileLocations.h"
+
+class OrientationBatchTransformsTest
+{
+  public:
+    OrientationBatchTransformsTest(){}
+    virtual ~OrientationBatchTransformsTest(){}
+
+    typedef OrientationTransforms<FOrientArrayType, float> OrientationTransformType;
+    typedef OrientationBatchTransforms<float> BatchTransformType;
+    typedef void (*BatchFunctionType)(const float*, size_t, float*, size_t);
+    typedef void (*ScalarFunctionType)(const FOrientArrayType&, FOrientArrayType&);
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void RemoveTestFiles()
+    {
+#if REMOVE_TEST_FILES
+      // QFile::remove();
+#endif
+    }
+
+    // -----------------------------------------------------------------------------
+    // The scalar conversions with the default quaternion layout, so that they can be passed around
+    // -----------------------------------------------------------------------------
+    static void eu2qu(const FOrientArrayType& in, FOrientArrayType& out) { OrientationTransformType::eu2qu(in, out); }
+    static void eu2om(const FOrientArrayType& in, FOrientArrayType& out) { OrientationTransformType::eu2om(in, out); }
+    static void qu2eu(const FOrientArrayType& in, FOrientArrayType& out) { OrientationTransformType::qu2eu(in, out); }
+    static void qu2ro(const FOrientArrayType& in, FOrientArrayType& out) { OrientationTransformType::qu2ro(in, out); }
+    static void ro2ho(const FOrientArrayType& in, FOrientArrayType& out) { OrientationTransformType::ro2ho(in, out); }
+    static void ho2cu(const FOrientArrayType& in, FOrientArrayType& out) { OrientationTransformType::ho2cu(in, out); }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    float RandomValue(uint32_t& seed, float lo, float hi)
+    {
+      seed = seed * 1664525u + 1013904223u;
+      return lo + (hi - lo) * static_cast<float>(seed >> 8) / static_cast<float>(1 << 24);
+    }
+
+    // -----------------------------------------------------------------------------
+    // Pads the special tuples with random ones, so that the batch spans several blocks and ends
+    // in a partial block, and spreads the special tuples over the block boundaries
+    // -----------------------------------------------------------------------------
+    std::vector<float> MakeInput(const std::vector<float>& special, size_t numComps, float lo, float hi, bool normalize)
+    {
+      uint32_t seed = 12345u;
+      size_t numSpecial = special.size() / numComps;
+      size_t count = 2 * BatchTransformType::k_BlockSize + 37;
+      std::vector<float> input(count * numComps, 0.0f);
+      for(size_t t = 0; t < count; t++)
+      {
+        float mag = 0.0f;
+        for(size_t c = 0; c < numComps; c++)
+        {
+          input[t * numComps + c] = RandomValue(seed, lo, hi);
+          mag += input[t * numComps + c] * input[t * numComps + c];
+        }
+        if(normalize == true)
+        {
+          mag = sqrtf(mag);
+          for(size_t c = 0; c < numComps; c++)
+          {
+            input[t * numComps + c] /= mag;
+          }
+        }
+      }
+      for(size_t s = 0; s < numSpecial; s++)
+      {
+        size_t t = (s * 29) % count;
+        for(size_t c = 0; c < numComps; c++)
+        {
+          input[t * numComps + c] = special[s * numComps + c];
+        }
+      }
+      return input;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Converts the packed tuples with the batch and the scalar function, reading them once packed and once
+    // with a padded stride, and requires the results to be identical
+    // -----------------------------------------------------------------------------
+    void CompareBatchToScalar(const std::vector<float>& input, size_t inComps, size_t outComps, BatchFunctionType batch, ScalarFunctionType scalar)
+    {
+      size_t count = input.size() / inComps;
+      size_t paddedStride = inComps + 2;
+      std::vector<float> padded(count * paddedStride, -7.0f);
+      for(size_t t = 0; t < count; t++)
+      {
+        for(size_t c = 0; c < inComps; c++)
+        {
+          padded[t * paddedStride + c] = input[t * inComps + c];
+        }
+      }
+
+      std::vector<float> packedOut(count * outComps, 0.0f);
+      std::vector<float> paddedOut(count * outComps, 0.0f);
+      batch(input.data(), inComps, packedOut.data(), count);
+      batch(padded.data(), paddedStride, paddedOut.data(), count);
+
+      FOrientArrayType in(inComps);
+      FOrientArrayType out(outComps);
+      for(size_t t = 0; t < count; t++)
+      {
+        for(size_t c = 0; c < inComps; c++)
+        {
+          in[c] = input[t * inComps + c];
+        }
+        scalar(in, out);
+        for(size_t c = 0; c < outComps; c++)
+        {
+          DREAM3D_REQUIRE_EQUAL(packedOut[t * outComps + c], out[c])
+          DREAM3D_REQUIRE_EQUAL(paddedOut[t * outComps + c], out[c])
+        }
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void TestEulerConversions()
+    {
+      const float pi = SIMPLib::Constants::k_Pi;
+      // Identity, Phi at its limits and angles that wrap around
+      std::vector<float> special = { 0.0f, 0.0f, 0.0f,
+                                     pi, 0.0f, 0.0f,
+                                     0.0f, pi, 0.0f,
+                                     pi, pi, pi,
+                                     2.0f * pi, 0.5f * pi, 2.0f * pi,
+                                     0.5f * pi, 0.5f * pi, 1.5f * pi,
+                                     1.0e-8f, 1.0e-8f, 1.0e-8f };
+      std::vector<float> eulers = MakeInput(special, 3, 0.0f, 2.0f * pi, false);
+      CompareBatchToScalar(eulers, 3, 4, &BatchTransformType::eu2qu, &eu2qu);
+      CompareBatchToScalar(eulers, 3, 9, &BatchTransformType::eu2om, &eu2om);
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void TestQuaternionConversions()
+    {
+      // Quaternions are stored with the vector part first
+      std::vector<float> special = { 0.0f, 0.0f, 0.0f, 1.0f,     // Identity, chi == 0 with q12 == 0
+                                     0.0f, 0.0f, 0.6f, 0.8f,     // Rotation about Z, chi == 0 with q12 == 0
+                                     0.0f, 0.0f, 1.0f, 0.0f,     // 180 degrees about Z, chi == 0 with q12 == 0 and qw < 1e-8
+                                     0.6f, 0.8f, 0.0f, 0.0f,     // 180 degrees about an axis in XY, chi == 0 with q12 != 0
+                                     1.0f, 0.0f, 0.0f, 0.0f,     // 180 degrees about X
+                                     0.6f, 0.0f, 0.8f, 5.0e-9f,  // qw < 1e-8 but not 0
+                                     0.0f, 0.6f, 0.0f, -0.8f,    // qw < 0
+                                     5.0e-9f, 0.0f, 0.0f, 1.0f,  // Vector part shorter than 1e-8
+                                     0.5f, 0.5f, 0.5f, 0.5f };
+      std::vector<float> quats = MakeInput(special, 4, -1.0f, 1.0f, true);
+      CompareBatchToScalar(quats, 4, 3, &BatchTransformType::qu2eu, &qu2eu);
+      CompareBatchToScalar(quats, 4, 4, &BatchTransformType::qu2ro, &qu2ro);
+
+      // Both representations have 4 components, so the conversion may write over its input
+      std::vector<float> inPlace = quats;
+      std::vector<float> expected(quats.size(), 0.0f);
+      BatchTransformType::qu2ro(quats.data(), 4, expected.data(), quats.size() / 4);
+      BatchTransformType::qu2ro(inPlace.data(), 4, inPlace.data(), inPlace.size() / 4);
+      for(size_t i = 0; i < quats.size(); i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(inPlace[i], expected[i])
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void TestRodriguesConversions()
+    {
+      const float inf = std::numeric_limits<float>::infinity();
+      // Rodrigues vectors are stored as the unit axis followed by tan(omega / 2)
+      std::vector<float> special = { 0.0f, 0.0f, 0.0f, 0.0f,     // Identity, rv == 0
+                                     1.0f, 0.0f, 0.0f, inf,      // 180 degrees, r3 == inf
+                                     0.6f, 0.0f, 0.8f, inf,
+                                     0.0f, 0.0f, 1.0f, 0.0f,     // A unit axis with no rotation
+                                     0.0f, 1.0f, 0.0f, 1.0e-8f,
+                                     0.0f, 0.6f, 0.8f, 1.0e8f };
+      std::vector<float> quats = MakeInput(std::vector<float>(), 4, -1.0f, 1.0f, true);
+      std::vector<float> rods = quats;
+      BatchTransformType::qu2ro(quats.data(), 4, rods.data(), quats.size() / 4);
+      for(size_t s = 0; s < special.size() / 4; s++)
+      {
+        size_t t = (s * 29) % (rods.size() / 4);
+        for(size_t c = 0; c < 4; c++)
+        {
+          rods[t * 4 + c] = special[s * 4 + c];
+        }
+      }
+      CompareBatchToScalar(rods, 4, 3, &BatchTransformType::ro2ho, &ro2ho);
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void TestHomochoricConversions()
+    {
+      const float r1 = static_cast<float>(LPs::R1);
+      std::vector<float> special = { 0.0f, 0.0f, 0.0f,           // Zero vector
+                                     2.0f, 0.0f, 0.0f,           // rs > R1
+                                     0.0f, 0.0f, -1.5f,
+                                     0.0f, 0.0f, r1,             // On the surface of the ball
+                                     0.0f, 0.0f, 0.5f,           // On the Z axis, qxy == 0
+                                     0.0f, -0.5f, 0.0f,          // On the Y axis
+                                     0.7f, 0.0f, 0.0f,           // On the X axis
+                                     0.3f, 0.3f, 0.3f,           // On the corner of the three pyramid pairs
+                                     -0.4f, 0.4f, -0.4f,
+                                     0.5f, 0.5f, 0.0f,           // On the boundary of the X and Y pyramids
+                                     0.2f, 0.0f, -0.2f,          // On the boundary of the X and Z pyramids
+                                     0.0f, 0.25f, 0.25f,         // On the boundary of the Y and Z pyramids
+                                     0.3f, 0.1f, 0.3f,
+                                     0.1f, -0.3f, -0.3f };
+      std::vector<float> homochoric = MakeInput(special, 3, -0.75f, 0.75f, false);
+      CompareBatchToScalar(homochoric, 3, 3, &BatchTransformType::ho2cu, &ho2cu);
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+      DREAM3D_REGISTER_TEST( TestEulerConversions() )
+      DREAM3D_REGISTER_TEST( TestQuaternionConversions() )
+      DREAM3D_REGISTER_TEST( TestRodriguesConversions() )
+      DREAM3D_REGISTER_TEST( TestHomochoricConversions() )
+      DREAM3D_REGISTER_TEST( RemoveTestFiles() )
+    }
+
+  private:
+    OrientationBatchTransformsTest(const OrientationBatchTransformsTest&); // Copy Constructor Not Implemented
+    void operator=(const OrientationBatchTransformsTest&); // Operator '=' Not Implemented
+};
@@ -36,6 +36,7 @@
 
 #include <stdio.h>
 
+#include <cmath>
 #include <iostream>
 #include <iomanip>
 
@@ -189,11 +190,71 @@ class OrientationConverterTest
 
     }
 
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void TestDestinationConversion()
+    {
+      // Enough tuples that the conversion is split into several blocks
+      size_t nTuples = 10000;
+      QVector<size_t> cDims(1, 3);
+      FloatArrayType::Pointer eulers = FloatArrayType::CreateArray(nTuples, cDims, "Eulers");
+      for(size_t i = 0; i < nTuples; i++)
+      {
+        eulers->setComponent(i, 0, static_cast<float>((i * 37) % 360) * SIMPLib::Constants::k_PiOver180);
+        eulers->setComponent(i, 1, static_cast<float>((i * 11) % 180) * SIMPLib::Constants::k_PiOver180);
+        eulers->setComponent(i, 2, static_cast<float>((i * 53) % 360) * SIMPLib::Constants::k_PiOver180);
+      }
+
+      typedef OrientationConverter<float> OCType;
+      QVector<OCType::OrientationType> ocTypes = OCType::GetOrientationTypes();
+      QVector<int> strides = OCType::GetComponentCounts();
+      OCType::Pointer ocEulers = EulerConverter<float>::New();
+      ocEulers->setInputData(eulers);
+
+      for(int t = 0; t < ocTypes.size(); t++)
+      {
+        ocEulers->convertRepresentationTo(ocTypes[t]);
+        FloatArrayType::Pointer expected = ocEulers->getOutputData();
+
+        // Converting into a given array must fill that array with the same values
+        QVector<size_t> outDims(1, strides[t]);
+        FloatArrayType::Pointer destination = FloatArrayType::CreateArray(nTuples, outDims, "Destination");
+        ocEulers->convertRepresentationTo(ocTypes[t], destination);
+        DREAM3D_REQUIRE_EQUAL(ocEulers->getOutputData().get(), destination.get())
+        for(size_t i = 0; i < nTuples * strides[t]; i++)
+        {
+          DREAM3D_REQUIRE(expected->getValue(i) == destination->getValue(i) || (std::isnan(expected->getValue(i)) && std::isnan(destination->getValue(i))))
+        }
+
+        // An array with the wrong number of components is not accepted
+        outDims[0] = strides[t] + 1;
+        FloatArrayType::Pointer wrongSize = FloatArrayType::CreateArray(nTuples, outDims, "WrongSize");
+        ocEulers->convertRepresentationTo(ocTypes[t], wrongSize);
+        DREAM3D_REQUIRE_NULL_POINTER(ocEulers->getOutputData().get())
+      }
+
+      // Representations with the same number of components can be converted in place
+      ocEulers->convertRepresentationTo(OCType::Quaternion);
+      FloatArrayType::Pointer quats = ocEulers->getOutputData();
+      OCType::Pointer ocQuats = QuaternionConverter<float>::New();
+      ocQuats->setInputData(quats);
+      ocQuats->convertRepresentationTo(OCType::Rodrigues);
+      FloatArrayType::Pointer expected = ocQuats->getOutputData();
+      ocQuats->convertRepresentationTo(OCType::Rodrigues, quats);
+      DREAM3D_REQUIRE_EQUAL(ocQuats->getOutputData().get(), quats.get())
+      for(size_t i = 0; i < nTuples * 4; i++)
+      {
+        DREAM3D_REQUIRE(expected->getValue(i) == quats->getValue(i) || (std::isnan(expected->getValue(i)) && std::isnan(quats->getValue(i))))
+      }
+    }
+
     void operator()()
     {
       int err = 0;
       DREAM3D_REGISTER_TEST( TestEulerConversion() );
       DREAM3D_REGISTER_TEST( TestFilterDesign() );
+      DREAM3D_REGISTER_TEST( TestDestinationConversion() );
     }
 
   private:
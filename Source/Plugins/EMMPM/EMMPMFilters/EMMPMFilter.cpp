@@ -292,15 +292,12 @@ void EMMPMFilter::execute()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void EMMPMFilter::segment(EMMPM_InitializationType initType)
+InitializationFunction::Pointer EMMPMFilter::CreateInitializationFunction(EMMPM_InitializationType initType)
 {
-  // Copy all the variables from the filter into the EMmpm Data structure.
-  m_Data->initType = initType;
-
   InitializationFunction::Pointer initFunction = BasicInitialization::New();
 
   // Set the initialization function based on the parameters
-  switch(m_Data->initType)
+  switch(initType)
   {
   case EMMPM_ManualInit:
     initFunction = InitializationFunction::New();
@@ -312,63 +309,81 @@ void EMMPMFilter::segment(EMMPM_InitializationType initType)
     initFunction = BasicInitialization::New();
     break;
   }
+  return initFunction;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMMPMFilter::configureData(EMMPM_Data::Pointer data, EMMPM_InitializationType initType, size_t columns, size_t rows, uint8_t* inputImage, uint8_t* outputImage)
+{
+  // Copy all the variables from the filter into the EMmpm Data structure.
+  data->initType = initType;
 
-  m_Data->classes = getNumClasses();
-  m_Data->in_beta = getExchangeEnergy();
-  m_Data->emIterations = getHistogramLoops();
-  m_Data->mpmIterations = getSegmentationLoops();
+  data->classes = getNumClasses();
+  data->in_beta = getExchangeEnergy();
+  data->emIterations = getHistogramLoops();
+  data->mpmIterations = getSegmentationLoops();
 
   DynamicTableData tableDataObj = getEMMPMTableData();
   std::vector<std::vector<double> > tableData = tableDataObj.getTableData();
-  for(int32_t i = 0; i < m_Data->classes; i++)
+  for(int32_t i = 0; i < data->classes; i++)
   {
-    int32_t gray = 255 / (m_Data->classes - 1);
+    int32_t gray = 255 / (data->classes - 1);
     // Generate a Gray Scale Color Table
-    m_Data->colorTable[i] = qRgb(i * gray, i * gray, i * gray);
+    data->colorTable[i] = qRgb(i * gray, i * gray, i * gray);
     // Hard code the minimum variance to 4.5; This could be a user option.
-    m_Data->min_variance[i] = tableData[i][1];
+    data->min_variance[i] = tableData[i][1];
     // Do we know what w_gamma is?
-    m_Data->w_gamma[i] = tableData[i][0];
+    data->w_gamma[i] = tableData[i][0];
   }
 
-  DataArrayPath dap = getInputDataArrayPath();
-  AttributeMatrix::Pointer am = getDataContainerArray()->getAttributeMatrix(dap);
-  QVector<size_t> tDims = am->getTupleDimensions();
-  IDataArray::Pointer iDataArray = am->getAttributeArray(getInputDataArrayPath().getDataArrayName());
-  QVector<size_t> cDims = iDataArray->getComponentDimensions();
-
-  m_Data->columns = tDims[0];
-  m_Data->rows = tDims[1];
-  m_Data->inputImageChannels = cDims[0];
+  data->columns = columns;
+  data->rows = rows;
+  data->inputImageChannels = 1; // We operate on a single component gray scale image
 
-  m_Data->simulatedAnnealing = (char)(getUseSimulatedAnnealing());
-  m_Data->useGradientPenalty = getUseGradientPenalty();
-  m_Data->beta_e = getGradientBetaE();
-  m_Data->useCurvaturePenalty = getUseCurvaturePenalty();
-  m_Data->beta_c = getCurvatureBetaC();
-  m_Data->r_max = getCurvatureRMax();
-  m_Data->ccostLoopDelay = getCurvatureEMLoopDelay();
+  data->simulatedAnnealing = (char)(getUseSimulatedAnnealing());
+  data->useGradientPenalty = getUseGradientPenalty();
+  data->beta_e = getGradientBetaE();
+  data->useCurvaturePenalty = getUseCurvaturePenalty();
+  data->beta_c = getCurvatureBetaC();
+  data->r_max = getCurvatureRMax();
+  data->ccostLoopDelay = getCurvatureEMLoopDelay();
 
   // Assign our Data array allocated input and output images into the EMMPData class
-  m_Data->inputImage = m_InputImage;
-  m_Data->xt = m_OutputImage;
+  data->inputImage = inputImage;
+  data->xt = outputImage;
 
   // Allocate all the memory here
-  m_Data->allocateDataStructureMemory();
+  data->allocateDataStructureMemory();
 
   // If we are using the "Feedback" loop then we copy the previous Mu/Sigma values into the Mean/Variance
   // variables
-  if(m_Data->initType == EMMPM_ManualInit)
+  if(data->initType == EMMPM_ManualInit)
   {
-    for(int32_t i = 0; i < m_Data->classes; i++)
+    for(int32_t i = 0; i < data->classes; i++)
     {
-      for(uint32_t d = 0; d < m_Data->dims; d++)
+      for(uint32_t d = 0; d < data->dims; d++)
       {
-        m_Data->mean[i * m_Data->dims + d] = m_PreviousMu[i * m_Data->dims + d];
-        m_Data->variance[i * m_Data->dims + d] = m_PreviousSigma[i * m_Data->dims + d];
+        data->mean[i * data->dims + d] = m_PreviousMu[i * data->dims + d];
+        data->variance[i * data->dims + d] = m_PreviousSigma[i * data->dims + d];
       }
     }
   }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMMPMFilter::segment(EMMPM_InitializationType initType)
+{
+  InitializationFunction::Pointer initFunction = CreateInitializationFunction(initType);
+
+  DataArrayPath dap = getInputDataArrayPath();
+  AttributeMatrix::Pointer am = getDataContainerArray()->getAttributeMatrix(dap);
+  QVector<size_t> tDims = am->getTupleDimensions();
+
+  configureData(m_Data, initType, tDims[0], tDims[1], m_InputImage, m_OutputImage);
 
   // Create a new StatsDelegate so the EMMPM algorith has somewhere to write its statistics
   StatsDelegate::Pointer statsDelegate = StatsDelegate::New();
@@ -44,6 +44,7 @@
 
 #include "EMMPMLib/Core/EMMPM_Constants.h"
 #include "EMMPM/EMMPMLib/Core/EMMPM_Data.h"
+#include "EMMPM/EMMPMLib/Core/InitializationFunctions.h"
 
 /**
  * @brief The EMMPMFilter class. See [Filter documentation](@ref emmpmfilter) for details.
@@ -207,6 +208,26 @@ class EMMPMFilter : public AbstractFilter
      */
     virtual void segment(EMMPM_InitializationType initType);
 
+    /**
+     * @brief configureData Copies the parameters of the filter into data, assigns the input and output
+     * images and allocates the working memory of the EM/MPM algorithm
+     * @param data Initialized EM/MPM data
+     * @param initType Enumeration of EMMPM initialization types
+     * @param columns Width of the image
+     * @param rows Height of the image
+     * @param inputImage Gray scale input image
+     * @param outputImage Output image that receives the class of each pixel
+     */
+    void configureData(EMMPM_Data::Pointer data, EMMPM_InitializationType initType, size_t columns, size_t rows, uint8_t* inputImage, uint8_t* outputImage);
+
+    /**
+     * @brief CreateInitializationFunction Returns the parameter initialization of the EM/MPM algorithm for
+     * an initialization type
+     * @param initType Enumeration of EMMPM initialization types
+     * @return
+     */
+    static InitializationFunction::Pointer CreateInitializationFunction(EMMPM_InitializationType initType);
+
     /**
      * @brief getPreviousMu
      * @return
@@ -34,6 +34,15 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "MultiEmmpmFilter.h"
 
+#include <vector>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "EMMPM/EMMPMConstants.h"
 #include "EMMPM/EMMPMLib/Common/EMMPM_Math.h"
 #include "EMMPM/EMMPMLib/Common/EMTime.h"
@@ -56,6 +65,91 @@
 // Include the MOC generated file for this class
 #include "moc_MultiEmmpmFilter.cpp"
 
+/**
+ * @brief The MultiEmmpmSegmentImpl class segments a range of the selected arrays. Every array gets its own
+ * EM/MPM data and seeds so that arrays running at the same time do not share any state.
+ */
+class MultiEmmpmSegmentImpl
+{
+  MultiEmmpmFilter* m_Filter;
+  size_t m_Columns;
+  size_t m_Rows;
+  size_t m_NumTuples;
+  const std::vector<uint8_t*>& m_InputImages;
+  const std::vector<uint8_t*>& m_OutputImages;
+  const std::vector<EMMPM_InitializationType>& m_InitTypes;
+  unsigned long m_BaseSeed;
+  std::vector<int32_t>& m_Errors;
+
+public:
+  MultiEmmpmSegmentImpl(MultiEmmpmFilter* filter, QVector<size_t> tDims, const std::vector<uint8_t*>& inputImages, const std::vector<uint8_t*>& outputImages,
+                        const std::vector<EMMPM_InitializationType>& initTypes, unsigned long baseSeed, std::vector<int32_t>& errors)
+  : m_Filter(filter)
+  , m_Columns(tDims[0])
+  , m_Rows(tDims[1])
+  , m_NumTuples(1)
+  , m_InputImages(inputImages)
+  , m_OutputImages(outputImages)
+  , m_InitTypes(initTypes)
+  , m_BaseSeed(baseSeed)
+  , m_Errors(errors)
+  {
+    for(int32_t i = 0; i < tDims.size(); i++)
+    {
+      m_NumTuples *= tDims[i];
+    }
+  }
+  virtual ~MultiEmmpmSegmentImpl()
+  {
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      if(m_Filter->getCancel() == true)
+      {
+        return;
+      }
+
+      EMMPM_Data::Pointer data = EMMPM_Data::New();
+      data->initVariables();
+      data->dims = 1; // We operate on a single channel | single component "image".
+      // Every EM loop of an array seeds its own stream from rngSeed, so leave room for them between arrays
+      data->rngSeed = m_BaseSeed + (i + 1) * 65536;
+      m_Filter->configureData(data, m_InitTypes[i], m_Columns, m_Rows, m_InputImages[i], m_OutputImages[i]);
+
+      StatsDelegate::Pointer statsDelegate = StatsDelegate::New();
+      EMMPM::Pointer emmpm = EMMPM::New();
+      emmpm->setData(data);
+      emmpm->setStatsDelegate(statsDelegate.get());
+      emmpm->setInitializationFunction(EMMPMFilter::CreateInitializationFunction(m_InitTypes[i]));
+      emmpm->execute();
+      m_Errors[i] = emmpm->getErrorCondition();
+
+      // We manually set the pointers to nullptr so that the EMMPData class does not try to free the memory
+      data->inputImage = nullptr;
+      data->xt = nullptr;
+
+      if(m_Filter->getUseOneBasedValues() == true)
+      {
+        uint8_t* output = m_OutputImages[i];
+        for(size_t t = 0; t < m_NumTuples; t++)
+        {
+          output[t] = output[t] + 1;
+        }
+      }
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -64,6 +158,7 @@ MultiEmmpmFilter::MultiEmmpmFilter()
 , m_OutputAttributeMatrixName("MultiArrayEMMPMOutput")
 , m_OutputArrayPrefix("Segmented_")
 , m_UsePreviousMuSigma(true)
+, m_SegmentArraysInParallel(false)
 {
   setupFilterParameters();
 }
@@ -84,6 +179,7 @@ void MultiEmmpmFilter::setupFilterParameters()
 
   parameters.push_back(SIMPL_NEW_BOOL_FP("Use Mu/Sigma from Previous Image as Initialization for Current Image", UsePreviousMuSigma, FilterParameter::Parameter, MultiEmmpmFilter));
   parameters.push_back(SIMPL_NEW_STRING_FP("Output Array Prefix", OutputArrayPrefix, FilterParameter::Parameter, MultiEmmpmFilter));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Segment Arrays in Parallel", SegmentArraysInParallel, FilterParameter::Parameter, MultiEmmpmFilter));
 
   for(qint32 i = 0; i < parameters.size(); i++)
   {
@@ -133,6 +229,7 @@ void MultiEmmpmFilter::readFilterParameters(AbstractFilterParametersReader* read
   setOutputAttributeMatrixName(reader->readString("OutputAttributeMatrixName", getOutputAttributeMatrixName()));
   setUsePreviousMuSigma(reader->readValue("UsePreviousMuSigma", getUsePreviousMuSigma()));
   setOutputArrayPrefix(reader->readString("OutputArrayPrefix", getOutputArrayPrefix()));
+  setSegmentArraysInParallel(reader->readValue("SegmentArraysInParallel", getSegmentArraysInParallel()));
   reader->closeFilterGroup();
 }
 
@@ -273,6 +370,19 @@ void MultiEmmpmFilter::execute()
   }
   initialize();
 
+  if(getSegmentArraysInParallel() == true)
+  {
+    segmentArraysInParallel();
+    if(getErrorCondition() < 0 || getCancel() == true)
+    {
+      return;
+    }
+
+    /* Let the GUI know we are done with this filter */
+    notifyStatusMessage(getHumanLabel(), "Complete");
+    return;
+  }
+
   DataArrayPath inputAMPath = DataArrayPath::GetAttributeMatrixPath(getInputDataArrayVector());
 
   QList<QString> arrayNames = DataArrayPath::GetDataArrayNames(getInputDataArrayVector());
@@ -333,6 +443,64 @@ void MultiEmmpmFilter::execute()
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MultiEmmpmFilter::segmentArraysInParallel()
+{
+  DataArrayPath inputAMPath = DataArrayPath::GetAttributeMatrixPath(getInputDataArrayVector());
+  DataArrayPath outputAMPath = inputAMPath;
+  outputAMPath.setAttributeMatrixName(getOutputAttributeMatrixName());
+  AttributeMatrix::Pointer inAM = getDataContainerArray()->getAttributeMatrix(inputAMPath);
+  AttributeMatrix::Pointer outAM = getDataContainerArray()->getAttributeMatrix(outputAMPath);
+
+  QList<QString> arrayNames = DataArrayPath::GetDataArrayNames(getInputDataArrayVector());
+  size_t numArrays = static_cast<size_t>(arrayNames.size());
+
+  std::vector<uint8_t*> inputImages(numArrays, nullptr);
+  std::vector<uint8_t*> outputImages(numArrays, nullptr);
+  std::vector<EMMPM_InitializationType> initTypes(numArrays, EMMPM_Basic);
+  for(size_t i = 0; i < numArrays; i++)
+  {
+    inputImages[i] = inAM->getAttributeArrayAs<UInt8ArrayType>(arrayNames[i])->getPointer(0);
+    outputImages[i] = outAM->getAttributeArrayAs<UInt8ArrayType>(getOutputArrayPrefix() + arrayNames[i])->getPointer(0);
+    // Use the same initialization for each array as the sequential segmentation
+    if(i == 1 && getUsePreviousMuSigma())
+    {
+      initTypes[i] = EMMPM_ManualInit;
+    }
+  }
+
+  QString ss = QObject::tr("Segmenting %1 Arrays in Parallel").arg(numArrays);
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+
+  std::vector<int32_t> errors(numArrays, 0);
+  MultiEmmpmSegmentImpl impl(this, inAM->getTupleDimensions(), inputImages, outputImages, initTypes, static_cast<unsigned long>(EMMPM_getMilliSeconds()), errors);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numArrays, 1), impl, tbb::simple_partitioner());
+  }
+  else
+#endif
+  {
+    impl.convert(0, numArrays);
+  }
+
+  for(size_t i = 0; i < numArrays; i++)
+  {
+    if(errors[i] < 0)
+    {
+      QString ss = QObject::tr("Error occurred running the EM/MPM algorithm on %1").arg(arrayNames[i]);
+      setErrorCondition(-60009);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -354,6 +522,7 @@ AbstractFilter::Pointer MultiEmmpmFilter::newFilterInstance(bool copyFilterParam
     SIMPL_COPY_INSTANCEVAR(CurvatureRMax)
     SIMPL_COPY_INSTANCEVAR(CurvatureEMLoopDelay)
     SIMPL_COPY_INSTANCEVAR(OutputAttributeMatrixName)
+    SIMPL_COPY_INSTANCEVAR(SegmentArraysInParallel)
   }
   return filter;
 }
@@ -69,6 +69,9 @@ class MultiEmmpmFilter : public EMMPMFilter
     SIMPL_FILTER_PARAMETER(bool, UsePreviousMuSigma)
     Q_PROPERTY(bool UsePreviousMuSigma READ getUsePreviousMuSigma WRITE setUsePreviousMuSigma)
 
+    SIMPL_FILTER_PARAMETER(bool, SegmentArraysInParallel)
+    Q_PROPERTY(bool SegmentArraysInParallel READ getSegmentArraysInParallel WRITE setSegmentArraysInParallel)
+
     /**
      * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
      */
@@ -140,7 +143,15 @@ class MultiEmmpmFilter : public EMMPMFilter
      */
     void initialize();
 
+    /**
+     * @brief segmentArraysInParallel Segments the selected arrays concurrently, each with its own EM/MPM
+     * data and random number streams
+     */
+    void segmentArraysInParallel();
+
   private:
+    friend class MultiEmmpmSegmentImpl;
+
     DEFINE_DATAARRAY_VARIABLE(uint8_t, InputImage)
     DEFINE_DATAARRAY_VARIABLE(uint8_t, OutputImage)
 
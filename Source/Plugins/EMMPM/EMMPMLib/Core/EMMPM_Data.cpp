@@ -77,6 +77,7 @@ EMMPM_Data::~EMMPM_Data()
   EMMPM_FREE_POINTER(this->prev_mu)
   EMMPM_FREE_POINTER(this->prev_variance)
   EMMPM_FREE_POINTER(this->probs)
+  EMMPM_FREE_POINTER(this->yk)
   EMMPM_FREE_POINTER(this->ccost)
   EMMPM_FREE_POINTER(this->ns)
   EMMPM_FREE_POINTER(this->ew)
@@ -228,6 +229,7 @@ void EMMPM_Data::initVariables()
   this->prev_mu = nullptr;
   this->prev_variance = nullptr;
   this->probs = nullptr;
+  this->yk = nullptr;
   this->ccost = nullptr;
 
   this->input_file_name = nullptr;
@@ -264,6 +266,7 @@ void EMMPM_Data::initVariables()
   this->histograms = nullptr;
 
   // this->rngVars = nullptr;
+  this->rngSeed = 0;
 
   this->tiffResSet = 0;
   this->xResolution = 0;
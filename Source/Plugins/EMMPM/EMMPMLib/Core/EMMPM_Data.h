@@ -132,9 +132,11 @@ class EMMPMLib_EXPORT EMMPM_Data
     real_t* prev_variance; /**< Previous EM Loop Value of Variance or Sigma Squared  { classes * dims array (classes is slowest moving dimension) }*/
     real_t  N[EMMPM_MAX_CLASSES]; /**< Dimensions { classes * dims array (classes is slowest moving dimension )}*/
     real_t* probs; /**< Probabilities for each pixel  classes * rows * cols (slowest to fastest)*/
+    real_t* yk; /**< Log likelihood of each class for each pixel, reused by every MPM loop  classes * rows * cols (slowest to fastest)*/
     real_t  workingKappa; /**< Current Kappa Value being used  */
     real_t* couplingBeta; /**< Beta Matrix for Coupling */
     std::vector<CoupleType> coupleEntries; /**< The entries that map the 2 classes that will be coupled along with their value  */
+    unsigned long rngSeed; /**< Seed for the random number generators. 0 seeds them from the current time */
 
     // -----------------------------------------------------------------------------
     //  Curvature Penalty Function Related variables
@@ -242,7 +242,14 @@ void XtArrayInitialization::initialize(EMMPM_Data::Pointer data)
   NumberDistribution distribution(rangeMin, rangeMax);
   RandomNumberGenerator generator;
   Generator numberGenerator(generator, distribution);
-  generator.seed(EMMPM_getMilliSeconds()); // seed with the current time
+  if(data->rngSeed != 0)
+  {
+    generator.seed(data->rngSeed);
+  }
+  else
+  {
+    generator.seed(EMMPM_getMilliSeconds()); // seed with the current time
+  }
 
   /* Initialize classification of each pixel randomly with a uniform disribution */
   for(size_t i = 0; i < total; i++)
@@ -48,6 +48,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
+#include <vector>
+
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/random/uniform_real.hpp>
 #include <boost/random/variate_generator.hpp>
@@ -68,17 +71,6 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #endif
 
-#define COMPUTE_C_CLIQUE(C, x, y, ci, cj)                                                                                                                                                              \
-  if((x) < 0 || (x) >= colEnd || (y) < 0 || (y) >= rowEnd)                                                                                                                                             \
-  {                                                                                                                                                                                                    \
-    C[ci][cj] = classes;                                                                                                                                                                               \
-  }                                                                                                                                                                                                    \
-  else                                                                                                                                                                                                 \
-  {                                                                                                                                                                                                    \
-    ij = (cols * (y)) + (x);                                                                                                                                                                           \
-    C[ci][cj] = xt[ij];                                                                                                                                                                                \
-  }
-
 /**
  * @class ParallelCalcLoop ParallelCalcLoop.h EMMPM/Curvature/ParallelCalcLoop.h
  * @brief This class can calculate the parts of the MPM loop in parallel
@@ -113,15 +105,10 @@ public:
   void calc(int rowStart, int rowEnd, int colStart, int colEnd) const
   {
     // uint64_t millis = EMMPM_getMilliSeconds();
-    //  int l;
-    real_t prior;
-    int32_t ij, lij;
-    int rows = data->rows;
-    int cols = data->columns;
-    int classes = data->classes;
-
-    real_t xrnd, current;
-    real_t post[EMMPM_MAX_CLASSES], sum, edge;
+    int32_t rows = data->rows;
+    int32_t cols = data->columns;
+    int32_t classes = data->classes;
+    size_t plane = static_cast<size_t>(rows) * static_cast<size_t>(cols);
 
     size_t nsCols = data->columns - 1;
     size_t ewCols = data->columns;
@@ -130,164 +117,135 @@ public:
 
     unsigned char* xt = data->xt;
     real_t* probs = data->probs;
-    real_t* ccost = data->ccost;
-    real_t* ns = data->ns;
-    real_t* ew = data->ew;
-    real_t* sw = data->sw;
-    real_t* nw = data->nw;
-    real_t curvature_value = (real_t)0.0;
-
-    int C[3][3]; // This is the Clique for the current Pixel
-                 //      --------- X -----
-                 //      |   | 0 | 1 | 2 |
-                 //      -----------------
-                 //   Y  | 0 |   |   |   |
-                 //      -----------------
-                 //      | 1 |   | P |   |
-                 //      -----------------
-                 //      | 2 |   |   |   |
-                 //
-                 // When we calculate the "C" matrix if the pixel value for the specific index of
-                 // the clique would be off the image then a value = number of classes is
-                 // used for the C[i][j]. That way we can figure out if we are off the image
-
-    std::stringstream ss;
-    unsigned int cSize = classes + 1;
-    real_t* coupling = data->couplingBeta;
+    const real_t* ccost = data->ccost;
+    const real_t* ns = data->ns;
+    const real_t* ew = data->ew;
+    const real_t* sw = data->sw;
+    const real_t* nw = data->nw;
+    const real_t* coupling = data->couplingBeta;
+    const real_t* gamma = data->w_gamma;
+    const real_t kappa = data->workingKappa;
+    const real_t betaC = data->beta_c;
+    const bool useGradientPenalty = (data->useGradientPenalty != 0);
+    const bool useCurvaturePenalty = (data->useCurvaturePenalty != 0);
+    size_t cSize = static_cast<size_t>(classes) + 1;
+
+    // The clique of the current pixel, in the order that the prior and the gradient penalty are summed
+    //      --------- X -----
+    //      |   | 0 | 1 | 2 |
+    //      -----------------
+    //   Y  | 0 | 0 | 1 | 2 |
+    //      -----------------
+    //      | 1 | 3 | P | 4 |
+    //      -----------------
+    //      | 2 | 5 | 6 | 7 |
+    //
+    // A neighbor that would be off the image gets the class value = number of classes and a gradient
+    // penalty of zero, so it never adds to the edge term.
+    const int32_t k_CliqueX[8] = {-1, 0, 1, -1, 1, -1, 0, 1};
+    const int32_t k_CliqueY[8] = {-1, -1, -1, 0, 0, 1, 1, 1};
+    int32_t clique[8];
+    real_t edgeWeight[8] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+
+    real_t arg[EMMPM_MAX_CLASSES];
+    real_t post[EMMPM_MAX_CLASSES];
 
     for(int32_t y = rowStart; y < rowEnd; y++)
     {
+      bool interiorRow = (y > 0 && y < rows - 1);
       for(int32_t x = colStart; x < colEnd; x++)
       {
+        size_t ij = static_cast<size_t>(cols) * y + x;
 
         /* -------------  */
-        COMPUTE_C_CLIQUE(C, x - 1, y - 1, 0, 0);
-        COMPUTE_C_CLIQUE(C, x, y - 1, 1, 0);
-        COMPUTE_C_CLIQUE(C, x + 1, y - 1, 2, 0);
-        COMPUTE_C_CLIQUE(C, x - 1, y, 0, 1);
-        COMPUTE_C_CLIQUE(C, x + 1, y, 2, 1);
-        COMPUTE_C_CLIQUE(C, x - 1, y + 1, 0, 2);
-        COMPUTE_C_CLIQUE(C, x, y + 1, 1, 2);
-        COMPUTE_C_CLIQUE(C, x + 1, y + 1, 2, 2);
-
-#if 0
-          if (y == rowStart + 1 && x == colStart + 1)
+        if(interiorRow && x > 0 && x < cols - 1)
+        {
+          const unsigned char* above = xt + ij - cols;
+          const unsigned char* below = xt + ij + cols;
+          clique[0] = above[-1];
+          clique[1] = above[0];
+          clique[2] = above[1];
+          clique[3] = xt[ij - 1];
+          clique[4] = xt[ij + 1];
+          clique[5] = below[-1];
+          clique[6] = below[0];
+          clique[7] = below[1];
+        }
+        else
+        {
+          for(int32_t c = 0; c < 8; c++)
           {
-            ss << "------------------------------" << std::endl;
-            ss << "|" << C[0][0] << "\t" << C[1][0] << "\t" << C[2][0] << std::endl;
-            ss << "|" << C[0][1] << "\t" << C[1][1] << "\t" << C[2][1] << std::endl;
-            ss << "|" << C[0][2] << "\t" << C[1][2] << "\t" << C[2][2] << std::endl;
-            ss << "------------------------------" << std::endl;
-            std::cout << ss.str() << std::endl;
+            int32_t cx = x + k_CliqueX[c];
+            int32_t cy = y + k_CliqueY[c];
+            clique[c] = (cx < 0 || cx >= cols || cy < 0 || cy >= rows) ? classes : xt[static_cast<size_t>(cols) * cy + cx];
           }
-#endif
+        }
 
-        ij = (cols * y) + x;
-        sum = 0;
-        for(int l = 0; l < classes; ++l)
+        // The gradient penalties only depend on the position of the neighbor, so look them up once for all classes
+        if(useGradientPenalty)
         {
-          prior = 0;
-          edge = 0;
-
-          prior += coupling[(cSize * l) + C[0][0]];
-          prior += coupling[(cSize * l) + C[1][0]];
-          prior += coupling[(cSize * l) + C[2][0]];
-          prior += coupling[(cSize * l) + C[0][1]];
-          prior += coupling[(cSize * l) + C[2][1]];
-          prior += coupling[(cSize * l) + C[0][2]];
-          prior += coupling[(cSize * l) + C[1][2]];
-          prior += coupling[(cSize * l) + C[2][2]];
-
-#if 0
-            if (y == rowStart + 1 && x == colStart + 1)
-            {
-              std::cout << "Class: " << l << "\t prior: " << prior << std::endl;
-            }
-#endif
+          edgeWeight[0] = (clique[0] != classes) ? sw[(swCols * (y - 1)) + x - 1] : 0.0f;
+          edgeWeight[1] = (clique[1] != classes) ? ew[(ewCols * (y - 1)) + x] : 0.0f;
+          edgeWeight[2] = (clique[2] != classes) ? nw[(nwCols * (y - 1)) + x] : 0.0f;
+          edgeWeight[3] = (clique[3] != classes) ? ns[(nsCols * y) + x - 1] : 0.0f;
+          edgeWeight[4] = (clique[4] != classes) ? ns[(nsCols * y) + x] : 0.0f;
+          edgeWeight[5] = (clique[5] != classes) ? nw[(nwCols * y) + x - 1] : 0.0f;
+          edgeWeight[6] = (clique[6] != classes) ? ew[(ewCols * y) + x] : 0.0f;
+          edgeWeight[7] = (clique[7] != classes) ? sw[(swCols * y) + x] : 0.0f;
+        }
 
-          // now check for the gradient penalty. If our current class is NOT equal
-          // to the class at index[i][j] AND the value of C[i][j] does NOT equal
-          // to the Number of Classes then add in the gradient penalty.
-          if(data->useGradientPenalty)
+        // Build the exponent for every class without branching on the clique. The terms are summed in the
+        // same order as the per neighbor tests did, and adding a zero penalty leaves the sum unchanged, so
+        // the posteriors are identical to evaluating each neighbor separately.
+        for(int32_t l = 0; l < classes; ++l)
+        {
+          const real_t* couplingRow = coupling + cSize * l;
+          real_t prior = 0;
+          prior += couplingRow[clique[0]];
+          prior += couplingRow[clique[1]];
+          prior += couplingRow[clique[2]];
+          prior += couplingRow[clique[3]];
+          prior += couplingRow[clique[4]];
+          prior += couplingRow[clique[5]];
+          prior += couplingRow[clique[6]];
+          prior += couplingRow[clique[7]];
+
+          real_t edge = 0;
+          if(useGradientPenalty)
           {
-            if(C[0][0] != l && C[0][0] != classes)
-            {
-              edge += sw[(swCols * (y - 1)) + x - 1];
-            }
-            if(C[1][0] != l && C[1][0] != classes)
-            {
-              edge += ew[(ewCols * (y - 1)) + x];
-            }
-            if(C[2][0] != l && C[2][0] != classes)
-            {
-              edge += nw[(nwCols * (y - 1)) + x];
-            }
-            if(C[0][1] != l && C[0][1] != classes)
-            {
-              edge += ns[(nsCols * y) + x - 1];
-            }
-            if(C[2][1] != l && C[2][1] != classes)
-            {
-              edge += ns[(nsCols * y) + x];
-            }
-            if(C[0][2] != l && C[0][2] != classes)
+            for(int32_t c = 0; c < 8; c++)
             {
-              edge += nw[(nwCols * y) + x - 1];
-            }
-            if(C[1][2] != l && C[1][2] != classes)
-            {
-              edge += ew[(ewCols * y) + x];
-            }
-            if(C[2][2] != l && C[2][2] != classes)
-            {
-              edge += sw[(swCols * y) + x];
+              edge += (clique[c] != l) ? edgeWeight[c] : 0.0f;
             }
           }
 
-          lij = (cols * rows * l) + (cols * y) + x;
-          curvature_value = 0.0;
-          if(data->useCurvaturePenalty)
+          real_t curvature_value = 0.0f;
+          if(useCurvaturePenalty)
           {
-            curvature_value = data->beta_c * ccost[lij];
+            curvature_value = betaC * ccost[plane * l + ij];
           }
-          real_t arg = data->workingKappa * (yk[lij] - (prior) - (edge) - (curvature_value)-data->w_gamma[l]);
-          post[l] = expf(arg);
-          sum += post[l];
+          arg[l] = kappa * (yk[plane * l + ij] - (prior) - (edge) - (curvature_value)-gamma[l]);
         }
 
-        xrnd = rnd[ij];
-        current = 0.0;
+        real_t sum = 0;
+        for(int32_t l = 0; l < classes; ++l)
+        {
+          post[l] = expf(arg[l]);
+          sum += post[l];
+        }
 
-        for(int l = 0; l < classes; l++)
+        real_t xrnd = rnd[ij];
+        real_t current = 0.0;
+        for(int32_t l = 0; l < classes; l++)
         {
-          lij = (cols * rows * l) + ij;
-          real_t arg = post[l] / sum;
-          if((xrnd >= current) && (xrnd <= (current + arg)))
+          real_t p = post[l] / sum;
+          if((xrnd >= current) && (xrnd <= (current + p)))
           {
             xt[ij] = l;
-            probs[lij] += 1.0;
+            probs[plane * l + ij] += 1.0;
           }
-          current += arg;
+          current += p;
         }
-#if 0
-          Dont even THINK about using this code...
-          This classifys the pixel based on the largest
-          in magnitude  probability
-          real_t max = 0.0;
-          int maxClass = 0;
-          for (int l = 0; l < classes; l++)
-          {
-            lij = (cols * rows * l) + ij;
-            //real_t arg = post[l] / sum;
-            if (probs[lij] > max)
-            {
-              max = probs[lij];
-              maxClass = l;
-            }
-          }
-          //Assign class based on Maximum probability
-          xt[ij] = maxClass;
-#endif
       }
     }
     //  std::cout << "     --" << EMMPM_getMilliSeconds() - millis << "--" << std::endl;
@@ -343,7 +301,6 @@ void MPMCalculation::execute()
 {
   EMMPM_Data* data = m_Data.get();
 
-  real_t* yk;
   real_t sqrt2pi, con[EMMPM_MAX_CLASSES];
   real_t post[EMMPM_MAX_CLASSES];
 
@@ -375,7 +332,17 @@ void MPMCalculation::execute()
   memset(msgbuff, 0, 256);
   data->progress++;
 
-  yk = (real_t*)malloc(cols * rows * classes * sizeof(real_t));
+  // The log likelihoods are kept on the data so every EM loop reuses the same buffer
+  if(nullptr == data->yk)
+  {
+    data->yk = (real_t*)malloc(cols * rows * classes * sizeof(real_t));
+  }
+  if(nullptr == data->yk)
+  {
+    setErrorCondition(-1);
+    return;
+  }
+  real_t* yk = data->yk;
 
   sqrt2pi = sqrt(2.0 * M_PI);
 
@@ -389,6 +356,17 @@ void MPMCalculation::execute()
     }
   }
 
+  // The pixel values are bytes, so the Gaussian term of every class and vector element only has 256
+  // possible values. Evaluate them once and look them up for each pixel.
+  std::vector<double> gaussTable(classes * dims * 256);
+  for(uint32_t c = 0; c < classes * dims; c++)
+  {
+    for(uint32_t g = 0; g < 256; g++)
+    {
+      gaussTable[c * 256 + g] = ((g - m[c]) * (g - m[c]) / (-2.0 * v[c]));
+    }
+  }
+
   for(uint32_t i = 0; i < rows; i++)
   {
     for(uint32_t j = 0; j < cols; j++)
@@ -402,7 +380,7 @@ void MPMCalculation::execute()
         {
           ld = dims * l + d;
           ijd = (dims * cols * i) + (dims * j) + d;
-          yk[lij] += ((y[ijd] - m[ld]) * (y[ijd] - m[ld]) / (-2.0 * v[ld]));
+          yk[lij] += gaussTable[ld * 256 + y[ijd]];
         }
       }
     }
@@ -417,7 +395,15 @@ void MPMCalculation::execute()
   NumberDistribution distribution(rangeMin, rangeMax);
   RandomNumberGenerator generator;
   Generator numberGenerator(generator, distribution);
-  generator.seed(EMMPM_getMilliSeconds()); // seed with the current time
+  if(data->rngSeed != 0)
+  {
+    // Every EM loop draws a different stream, which is also different from the Xt initialization's
+    generator.seed(data->rngSeed + data->currentEMLoop + 1);
+  }
+  else
+  {
+    generator.seed(EMMPM_getMilliSeconds()); // seed with the current time
+  }
 
   // Generate all the numbers up front
   size_t total = rows * cols;
@@ -463,7 +449,9 @@ void MPMCalculation::execute()
     g->wait();
     delete g;
 #else
-    tbb::parallel_for(tbb::blocked_range2d<int>(0, rows, rows / threads, 0, cols, cols), ParallelMPMLoop(data, yk, &(rndNumbers.front())), tbb::simple_partitioner());
+    // An image with fewer rows than threads would get a grain size of zero, which never stops splitting
+    int rowGrain = std::max(static_cast<int>(rows) / threads, 1);
+    tbb::parallel_for(tbb::blocked_range2d<int>(0, rows, rowGrain, 0, cols, cols), ParallelMPMLoop(data, yk, &(rndNumbers.front())), tbb::simple_partitioner());
 #endif
 
 #else
@@ -514,8 +502,6 @@ void MPMCalculation::execute()
     }
   }
 
-  /* Clean Up Memory */
-  free(yk);
 }
 
 // -----------------------------------------------------------------------------
@@ -33,6 +33,14 @@
 *
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDir>
 
@@ -43,12 +51,16 @@
 #include "SIMPLib/Common/FilterPipeline.h"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Plugin/ISIMPLibPlugin.h"
 #include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/Utilities/QMetaObjectUtilities.h"
 #include "SIMPLib/Utilities/UnitTestSupport.hpp"
 
+#include "EMMPM/EMMPMLib/Core/EMMPM_Data.h"
+#include "EMMPM/EMMPMLib/Core/MPMCalculation.h"
+
 #include "EMMPMTestFileLocations.h"
 
 class EMMPMSegmentationTest
@@ -353,6 +365,349 @@ public:
     return EXIT_SUCCESS;
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestParallelMultiEMMPMSegmentation()
+  {
+    const size_t xDim = 64;
+    const size_t yDim = 48;
+    const int32_t numArrays = 6;
+
+    for(int32_t parallel = 0; parallel < 2; parallel++)
+    {
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      DataContainer::Pointer dc = DataContainer::New("ImageDataContainer");
+      dca->addDataContainer(dc);
+      ImageGeom::Pointer image = ImageGeom::New();
+      image->setDimensions(xDim, yDim, 1);
+      dc->setGeometry(image);
+      QVector<size_t> tDims(3, 1);
+      tDims[0] = xDim;
+      tDims[1] = yDim;
+      AttributeMatrix::Pointer am = AttributeMatrix::New(tDims, "CellData", AttributeMatrix::Type::Cell);
+      dc->addAttributeMatrix(am->getName(), am);
+
+      // Every image has a dark and a bright phase, split at a different column
+      QVector<DataArrayPath> inputPaths;
+      for(int32_t a = 0; a < numArrays; a++)
+      {
+        QString name = QString("Image_%1").arg(a);
+        UInt8ArrayType::Pointer gray = UInt8ArrayType::CreateArray(xDim * yDim, name, true);
+        for(size_t y = 0; y < yDim; y++)
+        {
+          for(size_t x = 0; x < xDim; x++)
+          {
+            uint8_t noise = static_cast<uint8_t>(((x * 7 + y * 13 + a * 5) % 11));
+            gray->setValue(y * xDim + x, (x < 16 + a * 5) ? 40 + noise : 200 + noise);
+          }
+        }
+        am->addAttributeArray(name, gray);
+        inputPaths.push_back(DataArrayPath("ImageDataContainer", "CellData", name));
+      }
+
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter("MultiEmmpmFilter");
+      AbstractFilter::Pointer filter = filterFactory->create();
+      filter->setDataContainerArray(dca);
+      QVariant var;
+      var.setValue(inputPaths);
+      bool propWasSet = filter->setProperty("InputDataArrayVector", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      propWasSet = filter->setProperty("SegmentArraysInParallel", parallel == 1);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      filter->execute();
+      DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), NO_ERROR)
+
+      // Each image must come out as its two phases, labeled with the 1-based class values
+      AttributeMatrix::Pointer outAM = dc->getAttributeMatrix("MultiArrayEMMPMOutput");
+      DREAM3D_REQUIRE_VALID_POINTER(outAM.get())
+      for(int32_t a = 0; a < numArrays; a++)
+      {
+        UInt8ArrayType::Pointer segmented = outAM->getAttributeArrayAs<UInt8ArrayType>(QString("Segmented_Image_%1").arg(a));
+        DREAM3D_REQUIRE_VALID_POINTER(segmented.get())
+        uint8_t dark = segmented->getValue(0);
+        uint8_t bright = segmented->getValue(xDim - 1);
+        DREAM3D_REQUIRE(dark >= 1 && dark <= 2)
+        DREAM3D_REQUIRE(bright >= 1 && bright <= 2)
+        DREAM3D_REQUIRE(dark != bright)
+        for(size_t y = 0; y < yDim; y++)
+        {
+          for(size_t x = 0; x < xDim; x++)
+          {
+            DREAM3D_REQUIRE_EQUAL(segmented->getValue(y * xDim + x), (x < 16 + a * 5) ? dark : bright)
+          }
+        }
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Creates EM/MPM data for an image of three noisy bands, with every working array filled with fixed values
+  // -----------------------------------------------------------------------------
+  EMMPM_Data::Pointer CreateMPMData(unsigned int rows, unsigned int cols, bool useGradientPenalty, bool useCurvaturePenalty)
+  {
+    EMMPM_Data::Pointer data = EMMPM_Data::New();
+    data->initVariables();
+    data->rows = rows;
+    data->columns = cols;
+    data->dims = 1;
+    data->classes = 3;
+    data->mpmIterations = 4;
+    data->currentEMLoop = 1;
+    data->rngSeed = 4242;
+    data->workingKappa = 1.0f;
+    data->beta_c = 0.3f;
+    data->useGradientPenalty = useGradientPenalty ? 1 : 0;
+    data->useCurvaturePenalty = useCurvaturePenalty ? 1 : 0;
+    DREAM3D_REQUIRE_EQUAL(data->allocateDataStructureMemory(), 0)
+    data->calculateBetaMatrix(0.5);
+
+    const real_t means[3] = {60.0f, 128.0f, 190.0f};
+    const real_t variances[3] = {900.0f, 700.0f, 1100.0f};
+    for(int32_t l = 0; l < data->classes; l++)
+    {
+      data->mean[l] = means[l];
+      data->variance[l] = variances[l];
+      data->w_gamma[l] = 0.1f * l;
+    }
+
+    for(unsigned int y = 0; y < rows; y++)
+    {
+      for(unsigned int x = 0; x < cols; x++)
+      {
+        size_t ij = static_cast<size_t>(cols) * y + x;
+        int32_t band = static_cast<int32_t>((3 * (x + y)) / (cols + rows));
+        int32_t noise = static_cast<int32_t>((x * 7 + y * 13) % 61) - 30;
+        data->y[ij] = static_cast<unsigned char>(static_cast<int32_t>(means[band]) + noise);
+        data->xt[ij] = static_cast<unsigned char>((x * 5 + y * 3) % data->classes);
+      }
+    }
+
+    size_t plane = static_cast<size_t>(rows) * cols;
+    data->ccost = static_cast<real_t*>(malloc(data->classes * plane * sizeof(real_t)));
+    for(size_t i = 0; i < data->classes * plane; i++)
+    {
+      data->ccost[i] = 0.1f * static_cast<real_t>((i * 37) % 17);
+    }
+    // The gradient penalty weights of the edges between a pixel and its neighbors
+    size_t edgeSizes[4] = {rows * (cols - 1), (rows - 1) * cols, (rows - 1) * (cols - 1), (rows - 1) * (cols - 1)};
+    real_t** edges[4] = {&(data->ns), &(data->ew), &(data->sw), &(data->nw)};
+    for(int32_t e = 0; e < 4; e++)
+    {
+      *(edges[e]) = static_cast<real_t*>(malloc((edgeSizes[e] + 1) * sizeof(real_t)));
+      for(size_t i = 0; i < edgeSizes[e]; i++)
+      {
+        (*(edges[e]))[i] = 0.05f * static_cast<real_t>((i * 11 + e) % 7);
+      }
+    }
+    return data;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The MPM loops as they were computed before, one neighbor test at a time and over the whole image at once
+  // -----------------------------------------------------------------------------
+  void ReferenceMPM(EMMPM_Data::Pointer data, std::vector<unsigned char>& xt, std::vector<real_t>& probs)
+  {
+    int32_t rows = data->rows;
+    int32_t cols = data->columns;
+    int32_t classes = data->classes;
+    size_t plane = static_cast<size_t>(rows) * cols;
+    size_t nsCols = data->columns - 1;
+    size_t ewCols = data->columns;
+    size_t swCols = data->columns - 1;
+    size_t nwCols = data->columns - 1;
+    const real_t* ns = data->ns;
+    const real_t* ew = data->ew;
+    const real_t* sw = data->sw;
+    const real_t* nw = data->nw;
+    unsigned int cSize = classes + 1;
+    real_t* coupling = data->couplingBeta;
+
+    real_t sqrt2pi = sqrt(2.0 * M_PI);
+    real_t con[EMMPM_MAX_CLASSES];
+    std::vector<real_t> yk(classes * plane);
+    probs.assign(classes * plane, 0.0f);
+    for(int32_t l = 0; l < classes; l++)
+    {
+      con[l] = 0;
+      con[l] += -log(sqrt2pi * sqrt(data->variance[l]));
+      for(size_t ij = 0; ij < plane; ij++)
+      {
+        yk[plane * l + ij] = con[l];
+        yk[plane * l + ij] += ((data->y[ij] - data->mean[l]) * (data->y[ij] - data->mean[l]) / (-2.0 * data->variance[l]));
+      }
+    }
+
+    typedef boost::variate_generator<boost::mt19937&, boost::uniform_real<real_t>> Generator;
+    boost::uniform_real<real_t> distribution(0.0f, 1.0f);
+    boost::mt19937 generator;
+    Generator numberGenerator(generator, distribution);
+    generator.seed(data->rngSeed + data->currentEMLoop + 1);
+    std::vector<real_t> rnd(plane);
+    for(size_t i = 0; i < plane; i++)
+    {
+      rnd[i] = numberGenerator();
+    }
+
+    const int32_t cliqueX[8] = {-1, 0, 1, -1, 1, -1, 0, 1};
+    const int32_t cliqueY[8] = {-1, -1, -1, 0, 0, 1, 1, 1};
+    int32_t C[8];
+    real_t post[EMMPM_MAX_CLASSES];
+    for(int32_t k = 0; k < data->mpmIterations; k++)
+    {
+      for(int32_t y = 0; y < rows; y++)
+      {
+        for(int32_t x = 0; x < cols; x++)
+        {
+          for(int32_t c = 0; c < 8; c++)
+          {
+            int32_t cx = x + cliqueX[c];
+            int32_t cy = y + cliqueY[c];
+            C[c] = (cx < 0 || cx >= cols || cy < 0 || cy >= rows) ? classes : xt[cols * cy + cx];
+          }
+
+          size_t ij = static_cast<size_t>(cols) * y + x;
+          real_t sum = 0;
+          for(int32_t l = 0; l < classes; ++l)
+          {
+            real_t prior = 0;
+            real_t edge = 0;
+            for(int32_t c = 0; c < 8; c++)
+            {
+              prior += coupling[(cSize * l) + C[c]];
+            }
+            if(data->useGradientPenalty)
+            {
+              if(C[0] != l && C[0] != classes)
+              {
+                edge += sw[(swCols * (y - 1)) + x - 1];
+              }
+              if(C[1] != l && C[1] != classes)
+              {
+                edge += ew[(ewCols * (y - 1)) + x];
+              }
+              if(C[2] != l && C[2] != classes)
+              {
+                edge += nw[(nwCols * (y - 1)) + x];
+              }
+              if(C[3] != l && C[3] != classes)
+              {
+                edge += ns[(nsCols * y) + x - 1];
+              }
+              if(C[4] != l && C[4] != classes)
+              {
+                edge += ns[(nsCols * y) + x];
+              }
+              if(C[5] != l && C[5] != classes)
+              {
+                edge += nw[(nwCols * y) + x - 1];
+              }
+              if(C[6] != l && C[6] != classes)
+              {
+                edge += ew[(ewCols * y) + x];
+              }
+              if(C[7] != l && C[7] != classes)
+              {
+                edge += sw[(swCols * y) + x];
+              }
+            }
+            size_t lij = plane * l + ij;
+            real_t curvature_value = 0.0;
+            if(data->useCurvaturePenalty)
+            {
+              curvature_value = data->beta_c * data->ccost[lij];
+            }
+            real_t arg = data->workingKappa * (yk[lij] - (prior) - (edge) - (curvature_value)-data->w_gamma[l]);
+            post[l] = expf(arg);
+            sum += post[l];
+          }
+
+          real_t xrnd = rnd[ij];
+          real_t current = 0.0;
+          for(int32_t l = 0; l < classes; l++)
+          {
+            real_t arg = post[l] / sum;
+            if((xrnd >= current) && (xrnd <= (current + arg)))
+            {
+              xt[ij] = l;
+              probs[plane * l + ij] += 1.0;
+            }
+            current += arg;
+          }
+        }
+      }
+    }
+    for(size_t i = 0; i < probs.size(); i++)
+    {
+      probs[i] = probs[i] / (real_t)data->mpmIterations;
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs the MPM calculation and checks its classes and probabilities against the reference
+  // -----------------------------------------------------------------------------
+  void CheckMPMCalculation(unsigned int rows, unsigned int cols, bool useGradientPenalty, bool useCurvaturePenalty)
+  {
+    EMMPM_Data::Pointer data = CreateMPMData(rows, cols, useGradientPenalty, useCurvaturePenalty);
+    size_t plane = static_cast<size_t>(rows) * cols;
+    std::vector<unsigned char> xt(data->xt, data->xt + plane);
+    std::vector<real_t> probs;
+    ReferenceMPM(data, xt, probs);
+
+    MPMCalculation::Pointer mpm = MPMCalculation::New();
+    mpm->setData(data);
+    mpm->execute();
+    DREAM3D_REQUIRE_EQUAL(mpm->getErrorCondition(), 0)
+
+    int32_t classCounts[EMMPM_MAX_CLASSES] = {0};
+    for(size_t ij = 0; ij < plane; ij++)
+    {
+      DREAM3D_REQUIRE_EQUAL(data->xt[ij], xt[ij])
+      classCounts[xt[ij]]++;
+    }
+    for(size_t i = 0; i < probs.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(data->probs[i], probs[i])
+    }
+    // The image has three bands, so every class has to be used
+    if(plane > 100)
+    {
+      for(int32_t l = 0; l < data->classes; l++)
+      {
+        DREAM3D_REQUIRED(classCounts[l], >, 0)
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestMPMPenalties()
+  {
+    CheckMPMCalculation(29, 37, true, true);
+    CheckMPMCalculation(29, 37, true, false);
+    CheckMPMCalculation(29, 37, false, true);
+    CheckMPMCalculation(29, 37, false, false);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Tall and wide images are split into many blocks when the MPM loop runs in parallel. The neighbors of the
+  // pixels on the edges of a block are inside the image, so they have to count just like in the reference.
+  // Images of a single row or column check the bounds of the image itself.
+  // -----------------------------------------------------------------------------
+  int TestMPMImageBounds()
+  {
+    CheckMPMCalculation(211, 13, true, true);
+    CheckMPMCalculation(7, 193, true, true);
+    CheckMPMCalculation(1, 50, true, true);
+    CheckMPMCalculation(50, 1, true, true);
+    return EXIT_SUCCESS;
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -366,6 +721,9 @@ void operator()()
       DREAM3D_REGISTER_TEST(TestEMMPMSegmentation())
       DREAM3D_REGISTER_TEST(TestMultiEMMPMSegmentation())
   }
+  DREAM3D_REGISTER_TEST(TestParallelMultiEMMPMSegmentation())
+  DREAM3D_REGISTER_TEST(TestMPMPenalties())
+  DREAM3D_REGISTER_TEST(TestMPMImageBounds())
   DREAM3D_REGISTER_TEST(RemoveTestFiles())
 
 }
@@ -223,8 +223,9 @@ template <typename T> void generateRepresentation(ConvertOrientations* filter, t
 
   QVector<typename OCType::OrientationType> ocTypes = OCType::GetOrientationTypes();
 
+  // Convert straight into the output array instead of converting into a new array and copying it over
   converters[filter->getInputType()]->setInputData(inputOrientations);
-  converters[filter->getInputType()]->convertRepresentationTo(ocTypes[filter->getOutputType()]);
+  converters[filter->getInputType()]->convertRepresentationTo(ocTypes[filter->getOutputType()], outputOrientations);
 
   ArrayType output = converters[filter->getInputType()]->getOutputData();
   if(nullptr == output.get())
@@ -234,13 +235,6 @@ template <typename T> void generateRepresentation(ConvertOrientations* filter, t
     filter->notifyErrorMessage(filter->getHumanLabel(), ss, filter->getErrorCondition());
     return;
   }
-
-  if(!output->copyIntoArray(outputOrientations))
-  {
-    QString ss = QObject::tr("There was an error copying the final results into the output array.");
-    filter->setErrorCondition(-1003);
-    filter->notifyErrorMessage(filter->getHumanLabel(), ss, filter->getErrorCondition());
-  }
 }
 
 // -----------------------------------------------------------------------------
@@ -37,12 +37,20 @@
 
 #include <QtCore/QFileInfo>
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/Common/FilterManager.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Math/MatrixMath.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
 #include "EbsdLib/H5EbsdVolumeInfo.h"
@@ -51,10 +59,135 @@
 #include "EbsdLib/TSL/AngFields.h"
 #include "EbsdLib/TSL/H5AngVolumeReader.h"
 
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
 #include "OrientationAnalysis/FilterParameters/ReadH5EbsdFilterParameter.h"
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+/**
+ * @brief The ReadH5EbsdEulerTransformImpl class converts the Euler angles exactly as they were read from
+ * the file into the ones stored in the data container: the conversion to radians, the 30 degree offset
+ * for hexagonal HKL phases and the optional rotation of the Euler reference frame.
+ */
+class ReadH5EbsdEulerTransformImpl
+{
+  float* m_CellEulerAngles;
+  int32_t* m_CellPhases;
+  uint32_t* m_CrystalStructures;
+  float m_DegToRad;
+  bool m_OffsetHexagonal;
+  bool m_Rotate;
+  float m_RotMat[3][3];
+
+public:
+  ReadH5EbsdEulerTransformImpl(float* eulers, int32_t* phases, uint32_t* crystalStructures, float degToRad, bool offsetHexagonal)
+  : m_CellEulerAngles(eulers)
+  , m_CellPhases(phases)
+  , m_CrystalStructures(crystalStructures)
+  , m_DegToRad(degToRad)
+  , m_OffsetHexagonal(offsetHexagonal && nullptr != phases)
+  , m_Rotate(false)
+  {
+    for(int32_t i = 0; i < 3; i++)
+    {
+      for(int32_t j = 0; j < 3; j++)
+      {
+        m_RotMat[i][j] = (i == j) ? 1.0f : 0.0f;
+      }
+    }
+  }
+  virtual ~ReadH5EbsdEulerTransformImpl()
+  {
+  }
+
+  /**
+   * @brief setRotation Also rotates every orientation by the given axis-angle pair in the same way as RotateEulerRefFrame
+   * @param angle Rotation angle in degrees
+   * @param axis Rotation axis. Does not need to be normalized
+   */
+  void setRotation(float angle, float axis[3])
+  {
+    float rotAngle = angle * SIMPLib::Constants::k_Pi / 180.0f;
+    float rotAxis[3] = {axis[0], axis[1], axis[2]};
+    MatrixMath::Normalize3x1(rotAxis);
+    FOrientArrayType om(9, 0.0f);
+    FOrientTransformsType::ax2om(FOrientArrayType(rotAxis[0], rotAxis[1], rotAxis[2], rotAngle), om);
+    om.toGMatrix(m_RotMat);
+    m_Rotate = true;
+  }
+
+  bool isIdentity() const
+  {
+    return (m_DegToRad == 1.0f && m_OffsetHexagonal == false && m_Rotate == false);
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    float g[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    float gNew[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    for(size_t i = start; i < end; i++)
+    {
+      float* eulers = m_CellEulerAngles + 3 * i;
+      eulers[0] = eulers[0] * m_DegToRad;
+      eulers[1] = eulers[1] * m_DegToRad;
+      eulers[2] = eulers[2] * m_DegToRad;
+      if(m_OffsetHexagonal == true && m_CrystalStructures[m_CellPhases[i]] == Ebsd::CrystalStructure::Hexagonal_High)
+      {
+        eulers[2] = eulers[2] + (30.0 * m_DegToRad);
+      }
+      if(m_Rotate == true)
+      {
+        FOrientArrayType om(9);
+        FOrientTransformsType::eu2om(FOrientArrayType(eulers[0], eulers[1], eulers[2]), om);
+        om.toGMatrix(g);
+        MatrixMath::Multiply3x3with3x3(g, m_RotMat, gNew);
+        MatrixMath::Normalize3x3(gNew);
+        FOrientArrayType eu(eulers, 3);
+        FOrientTransformsType::om2eu(FOrientArrayType(gNew), eu);
+      }
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+};
+
+/**
+ * @brief The ReadH5EbsdSliceObserver class runs the Euler angle transform over each plane of the volume
+ * as soon as the reader has copied it, overlapping the work with the read of the next slice.
+ */
+class ReadH5EbsdSliceObserver : public H5EbsdSliceObserver
+{
+  ReadH5EbsdEulerTransformImpl m_Transform;
+  size_t m_PlaneSize;
+
+public:
+  ReadH5EbsdSliceObserver(const ReadH5EbsdEulerTransformImpl& transform, size_t planeSize)
+  : m_Transform(transform)
+  , m_PlaneSize(planeSize)
+  {
+  }
+  virtual ~ReadH5EbsdSliceObserver()
+  {
+  }
+
+  void sliceLoaded(int64_t zval)
+  {
+    size_t start = static_cast<size_t>(zval) * m_PlaneSize;
+    size_t end = start + m_PlaneSize;
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(start, end), m_Transform, tbb::auto_partitioner());
+#else
+    m_Transform.convert(start, end);
+#endif
+  }
+};
+
 // Include the MOC generated file for this class
 #include "moc_ReadH5Ebsd.cpp"
 
@@ -73,6 +206,7 @@ ReadH5Ebsd::ReadH5Ebsd()
 , m_ZEndIndex(0)
 , m_UseTransformations(true)
 , m_AngleRepresentation(Ebsd::AngleRepresentation::Radians)
+, m_FuseTransformations(true)
 , m_RefFrameZDir(SIMPL::RefFrameZDir::UnknownRefFrameZDirection)
 , m_Manufacturer(Ebsd::UnknownManufacturer)
 , m_CrystalStructuresArrayName(SIMPL::EnsembleData::CrystalStructures)
@@ -559,34 +693,71 @@ void ReadH5Ebsd::execute()
   ebsdReader->setSliceEnd(m_ZEndIndex);
   ebsdReader->readAllArrays(false);
   ebsdReader->setArraysToRead(m_SelectedArrayNames);
-  err = ebsdReader->loadData(m->getGeometryAs<ImageGeom>()->getXPoints(), m->getGeometryAs<ImageGeom>()->getYPoints(), m->getGeometryAs<ImageGeom>()->getZPoints(), m_RefFrameZDir);
-  if(err < 0)
+
+  // The reader works in the frame of the file so keep those dimensions before any remap is applied
+  int64_t xpoints = m->getGeometryAs<ImageGeom>()->getXPoints();
+  int64_t ypoints = m->getGeometryAs<ImageGeom>()->getYPoints();
+  int64_t zpoints = m->getGeometryAs<ImageGeom>()->getZPoints();
+
+  // Axis aligned sample rotations are applied as an index remap while each slice is copied and
+  // the Euler rotation as a per voxel transform of each plane once it has been loaded. Rotations
+  // that can not be expressed that way fall back to the RotateSampleRefFrame/RotateEulerRefFrame filters.
+  bool fuseTransformations = (m_FuseTransformations == true) && setupSliceRemap(ebsdReader.get());
+
+  // Create the cell arrays up front and hand them to the reader so each slice is copied
+  // straight from the file into the data container without any volume sized temporaries.
+  bool isTSL = (manufacturer.compare(Ebsd::Ang::Manufacturer) == 0);
+  if(isTSL == true)
   {
-    setErrorCondition(err);
-    notifyErrorMessage(ebsdReader->getNameOfClass(), ebsdReader->getErrorMessage(), getErrorCondition());
-    notifyErrorMessage(getHumanLabel(), "Error Loading Data from Ebsd Data file.", -1);
-    return;
+    createTSLArrays(ebsdReader.get());
+  }
+  else
+  {
+    createHKLArrays(ebsdReader.get());
   }
 
-  // Copy the data from the pointers embedded in the reader object into our data container (Cell array).
-  if(manufacturer.compare(Ebsd::Ang::Manufacturer) == 0)
+  QSharedPointer<ReadH5EbsdSliceObserver> sliceObserver;
+  if(fuseTransformations == true && m_SelectedArrayNames.find(m_CellEulerAnglesArrayName) != m_SelectedArrayNames.end())
   {
-    copyTSLArrays(ebsdReader.get());
+    AttributeMatrix::Pointer cellAttrMatrix = m->getAttributeMatrix(getCellAttributeMatrixName());
+    FloatArrayType::Pointer eulers = cellAttrMatrix->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::EulerAngles);
+    Int32ArrayType::Pointer phases = cellAttrMatrix->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::Phases);
+    ReadH5EbsdEulerTransformImpl transform(eulers->getPointer(0), (nullptr != phases.get()) ? phases->getPointer(0) : nullptr, m_CrystalStructures, getDegToRad(), isTSL == false);
+    if(m_UseTransformations == true && m_EulerTransformation.angle > 0)
+    {
+      float eulerAxis[3] = {m_EulerTransformation.h, m_EulerTransformation.k, m_EulerTransformation.l};
+      transform.setRotation(m_EulerTransformation.angle, eulerAxis);
+    }
+    if(transform.isIdentity() == false)
+    {
+      sliceObserver = QSharedPointer<ReadH5EbsdSliceObserver>(new ReadH5EbsdSliceObserver(transform, static_cast<size_t>(xpoints * ypoints)));
+      ebsdReader->setSliceObserver(sliceObserver.data());
+    }
   }
-  else if(manufacturer.compare(Ebsd::Ctf::Manufacturer) == 0)
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+#endif
+  err = ebsdReader->loadData(xpoints, ypoints, zpoints, m_RefFrameZDir);
+  ebsdReader->setSliceObserver(nullptr);
+  ebsdReader->clearArrayDestinations();
+  if(err < 0)
   {
-    copyHKLArrays(ebsdReader.get());
+    setErrorCondition(err);
+    notifyErrorMessage(ebsdReader->getNameOfClass(), ebsdReader->getErrorMessage(), getErrorCondition());
+    notifyErrorMessage(getHumanLabel(), "Error Loading Data from Ebsd Data file.", -1);
+    return;
   }
 
-  else
+  if(fuseTransformations == true)
   {
-    QString ss =
-        QObject::tr("Could not determine or match a supported manufacturer from the data file. Supported manufacturer codes are: %1 and %2").arg(Ebsd::Ctf::Manufacturer).arg(Ebsd::Ang::Manufacturer);
-    setErrorCondition(-109875);
-    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    notifyStatusMessage(getHumanLabel(), "Complete");
     return;
   }
 
+  // The Euler angles are stored as read from the file so convert them in place
+  convertEulerAngles(isTSL == false);
+
   if(m_UseTransformations == true)
   {
 
@@ -810,15 +981,39 @@ H5EbsdVolumeReader::Pointer ReadH5Ebsd::initHKLEbsdVolumeReader()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void ReadH5Ebsd::copyTSLArrays(H5EbsdVolumeReader* ebsdReader)
+template <typename ArrayType>
+typename ArrayType::Pointer createDestinationArray(H5EbsdVolumeReader* ebsdReader, AttributeMatrix::Pointer cellAttrMatrix, const QString& readerName, const QString& arrayName,
+                                                   const QVector<size_t>& tDims, const QVector<size_t>& cDims)
+{
+  typename ArrayType::Pointer array = ArrayType::CreateArray(tDims, cDims, arrayName);
+  array->initializeWithZeros();
+  ebsdReader->setArrayDestination(readerName, static_cast<void*>(array->getPointer(0)));
+  cellAttrMatrix->addAttributeArray(arrayName, array);
+  return array;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ReadH5Ebsd::createEulerAnglesArray(H5EbsdVolumeReader* ebsdReader, const QString& euler1, const QString& euler2, const QString& euler3)
 {
-  float* f1 = nullptr;
-  float* f2 = nullptr;
-  float* f3 = nullptr;
-  int32_t* phasePtr = nullptr;
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+  AttributeMatrix::Pointer cellAttrMatrix = m->getAttributeMatrix(getCellAttributeMatrixName());
+  QVector<size_t> cDims(1, 3);
+  FloatArrayType::Pointer fArray = FloatArrayType::CreateArray(cellAttrMatrix->getTupleDimensions(), cDims, SIMPL::CellData::EulerAngles);
+  fArray->initializeWithZeros();
+  // The three angles are interleaved into the single 3 component array
+  ebsdReader->setArrayDestination(euler1, static_cast<void*>(fArray->getPointer(0)), 3, 0);
+  ebsdReader->setArrayDestination(euler2, static_cast<void*>(fArray->getPointer(0)), 3, 1);
+  ebsdReader->setArrayDestination(euler3, static_cast<void*>(fArray->getPointer(0)), 3, 2);
+  cellAttrMatrix->addAttributeArray(SIMPL::CellData::EulerAngles, fArray);
+}
 
-  FloatArrayType::Pointer fArray = FloatArrayType::NullPointer();
-  Int32ArrayType::Pointer iArray = Int32ArrayType::NullPointer();
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ReadH5Ebsd::createTSLArrays(H5EbsdVolumeReader* ebsdReader)
+{
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
 
   AttributeMatrix::Pointer cellAttrMatrix = m->getAttributeMatrix(getCellAttributeMatrixName());
@@ -828,102 +1023,53 @@ void ReadH5Ebsd::copyTSLArrays(H5EbsdVolumeReader* ebsdReader)
   tDims[2] = m->getGeometryAs<ImageGeom>()->getZPoints();
   cellAttrMatrix->resizeAttributeArrays(tDims); // Resize the attribute Matrix to the proper dimensions
 
-  size_t totalPoints = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
   QVector<size_t> cDims(1, 1);
   if(m_SelectedArrayNames.find(m_CellPhasesArrayName) != m_SelectedArrayNames.end())
   {
-    phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ang::PhaseData));
-    iArray = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::CellData::Phases);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-    cellAttrMatrix->addAttributeArray(SIMPL::CellData::Phases, iArray);
+    createDestinationArray<Int32ArrayType>(ebsdReader, cellAttrMatrix, Ebsd::Ang::PhaseData, SIMPL::CellData::Phases, tDims, cDims);
   }
 
   if(m_SelectedArrayNames.find(m_CellEulerAnglesArrayName) != m_SelectedArrayNames.end())
   {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::Phi1));
-    f2 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::Phi));
-    f3 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::Phi2));
-    cDims[0] = 3;
-    fArray = FloatArrayType::CreateArray(tDims, cDims, SIMPL::CellData::EulerAngles);
-    float* cellEulerAngles = fArray->getPointer(0);
-    float degToRad = 1.0f;
-    if(m_AngleRepresentation != Ebsd::AngleRepresentation::Radians && m_UseTransformations == true)
-    {
-      degToRad = SIMPLib::Constants::k_PiOver180;
-    }
-    for(size_t i = 0; i < totalPoints; i++)
-    {
-      cellEulerAngles[3 * i] = f1[i] * degToRad;
-      cellEulerAngles[3 * i + 1] = f2[i] * degToRad;
-      cellEulerAngles[3 * i + 2] = f3[i] * degToRad;
-    }
-    cellAttrMatrix->addAttributeArray(SIMPL::CellData::EulerAngles, fArray);
+    createEulerAnglesArray(ebsdReader, Ebsd::Ang::Phi1, Ebsd::Ang::Phi, Ebsd::Ang::Phi2);
   }
 
-  // Reset this back to 1 for the rest of the arrays
-  cDims[0] = 1;
-
   if(m_SelectedArrayNames.find(Ebsd::Ang::ImageQuality) != m_SelectedArrayNames.end())
   {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::ImageQuality));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ang::ImageQuality);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ang::ImageQuality, fArray);
+    createDestinationArray<FloatArrayType>(ebsdReader, cellAttrMatrix, Ebsd::Ang::ImageQuality, Ebsd::Ang::ImageQuality, tDims, cDims);
   }
 
   if(m_SelectedArrayNames.find(Ebsd::Ang::ConfidenceIndex) != m_SelectedArrayNames.end())
   {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::ConfidenceIndex));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ang::ConfidenceIndex);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ang::ConfidenceIndex, fArray);
+    createDestinationArray<FloatArrayType>(ebsdReader, cellAttrMatrix, Ebsd::Ang::ConfidenceIndex, Ebsd::Ang::ConfidenceIndex, tDims, cDims);
   }
 
   if(m_SelectedArrayNames.find(Ebsd::Ang::SEMSignal) != m_SelectedArrayNames.end())
   {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::SEMSignal));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ang::SEMSignal);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ang::SEMSignal, fArray);
+    createDestinationArray<FloatArrayType>(ebsdReader, cellAttrMatrix, Ebsd::Ang::SEMSignal, Ebsd::Ang::SEMSignal, tDims, cDims);
   }
 
   if(m_SelectedArrayNames.find(Ebsd::Ang::Fit) != m_SelectedArrayNames.end())
   {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::Fit));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ang::Fit);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ang::Fit, fArray);
+    createDestinationArray<FloatArrayType>(ebsdReader, cellAttrMatrix, Ebsd::Ang::Fit, Ebsd::Ang::Fit, tDims, cDims);
   }
 
   if(m_SelectedArrayNames.find(Ebsd::Ang::XPosition) != m_SelectedArrayNames.end())
   {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::XPosition));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ang::XPosition);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ang::XPosition, fArray);
+    createDestinationArray<FloatArrayType>(ebsdReader, cellAttrMatrix, Ebsd::Ang::XPosition, Ebsd::Ang::XPosition, tDims, cDims);
   }
 
   if(m_SelectedArrayNames.find(Ebsd::Ang::YPosition) != m_SelectedArrayNames.end())
   {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::YPosition));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ang::YPosition);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ang::YPosition, fArray);
+    createDestinationArray<FloatArrayType>(ebsdReader, cellAttrMatrix, Ebsd::Ang::YPosition, Ebsd::Ang::YPosition, tDims, cDims);
   }
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void ReadH5Ebsd::copyHKLArrays(H5EbsdVolumeReader* ebsdReader)
+void ReadH5Ebsd::createHKLArrays(H5EbsdVolumeReader* ebsdReader)
 {
-  float* f1 = nullptr;
-  float* f2 = nullptr;
-  float* f3 = nullptr;
-  int32_t* phasePtr = nullptr;
-
-  FloatArrayType::Pointer fArray = FloatArrayType::NullPointer();
-  Int32ArrayType::Pointer iArray = Int32ArrayType::NullPointer();
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
   AttributeMatrix::Pointer cellAttrMatrix = m->getAttributeMatrix(getCellAttributeMatrixName());
   QVector<size_t> tDims(3, 0);
@@ -932,95 +1078,159 @@ void ReadH5Ebsd::copyHKLArrays(H5EbsdVolumeReader* ebsdReader)
   tDims[2] = m->getGeometryAs<ImageGeom>()->getZPoints();
   cellAttrMatrix->resizeAttributeArrays(tDims); // Resize the attribute Matrix to the proper dimensions
 
-  size_t totalPoints = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
   QVector<size_t> cDims(1, 1);
-  phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ctf::Phase));
-  iArray = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::CellData::Phases);
-  ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-  cellAttrMatrix->addAttributeArray(SIMPL::CellData::Phases, iArray);
+  createDestinationArray<Int32ArrayType>(ebsdReader, cellAttrMatrix, Ebsd::Ctf::Phase, SIMPL::CellData::Phases, tDims, cDims);
 
   if(m_SelectedArrayNames.find(m_CellEulerAnglesArrayName) != m_SelectedArrayNames.end())
   {
-    //  radianconversion = M_PI / 180.0;
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::Euler1));
-    f2 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::Euler2));
-    f3 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::Euler3));
-    cDims[0] = 3;
-    fArray = FloatArrayType::CreateArray(tDims, cDims, SIMPL::CellData::EulerAngles);
-    float* cellEulerAngles = fArray->getPointer(0);
-    int32_t* cellPhases = iArray->getPointer(0);
-    float degToRad = 1.0f;
-    if(m_AngleRepresentation != Ebsd::AngleRepresentation::Radians && m_UseTransformations == true)
-    {
-      degToRad = SIMPLib::Constants::k_PiOver180;
-    }
-    for(size_t i = 0; i < totalPoints; i++)
-    {
-      cellEulerAngles[3 * i] = f1[i] * degToRad;
-      cellEulerAngles[3 * i + 1] = f2[i] * degToRad;
-      cellEulerAngles[3 * i + 2] = f3[i] * degToRad;
-      if(m_CrystalStructures[cellPhases[i]] == Ebsd::CrystalStructure::Hexagonal_High)
-      {
-        cellEulerAngles[3 * i + 2] = cellEulerAngles[3 * i + 2] + (30.0 * degToRad);
-      }
-    }
-    cellAttrMatrix->addAttributeArray(SIMPL::CellData::EulerAngles, fArray);
+    createEulerAnglesArray(ebsdReader, Ebsd::Ctf::Euler1, Ebsd::Ctf::Euler2, Ebsd::Ctf::Euler3);
   }
 
-  cDims[0] = 1;
   if(m_SelectedArrayNames.find(Ebsd::Ctf::Bands) != m_SelectedArrayNames.end())
   {
-    phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ctf::Bands));
-    iArray = Int32ArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::Bands);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ctf::Bands, iArray);
+    createDestinationArray<Int32ArrayType>(ebsdReader, cellAttrMatrix, Ebsd::Ctf::Bands, Ebsd::Ctf::Bands, tDims, cDims);
   }
 
   if(m_SelectedArrayNames.find(Ebsd::Ctf::Error) != m_SelectedArrayNames.end())
   {
-    phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ctf::Error));
-    iArray = Int32ArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::Error);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ctf::Error, iArray);
+    createDestinationArray<Int32ArrayType>(ebsdReader, cellAttrMatrix, Ebsd::Ctf::Error, Ebsd::Ctf::Error, tDims, cDims);
   }
 
   if(m_SelectedArrayNames.find(Ebsd::Ctf::MAD) != m_SelectedArrayNames.end())
   {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::MAD));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::MAD);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ctf::MAD, fArray);
+    createDestinationArray<FloatArrayType>(ebsdReader, cellAttrMatrix, Ebsd::Ctf::MAD, Ebsd::Ctf::MAD, tDims, cDims);
   }
 
   if(m_SelectedArrayNames.find(Ebsd::Ctf::BC) != m_SelectedArrayNames.end())
   {
-    phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ctf::BC));
-    iArray = Int32ArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::BC);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ctf::BC, iArray);
+    createDestinationArray<Int32ArrayType>(ebsdReader, cellAttrMatrix, Ebsd::Ctf::BC, Ebsd::Ctf::BC, tDims, cDims);
   }
 
   if(m_SelectedArrayNames.find(Ebsd::Ctf::BS) != m_SelectedArrayNames.end())
   {
-    phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ctf::BS));
-    iArray = Int32ArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::BS);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ctf::BS, iArray);
+    createDestinationArray<Int32ArrayType>(ebsdReader, cellAttrMatrix, Ebsd::Ctf::BS, Ebsd::Ctf::BS, tDims, cDims);
   }
   if(m_SelectedArrayNames.find(Ebsd::Ctf::X) != m_SelectedArrayNames.end())
   {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::X));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::X);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ctf::X, fArray);
+    createDestinationArray<FloatArrayType>(ebsdReader, cellAttrMatrix, Ebsd::Ctf::X, Ebsd::Ctf::X, tDims, cDims);
   }
   if(m_SelectedArrayNames.find(Ebsd::Ctf::Y) != m_SelectedArrayNames.end())
   {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::Y));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::Y);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ctf::Y, fArray);
+    createDestinationArray<FloatArrayType>(ebsdReader, cellAttrMatrix, Ebsd::Ctf::Y, Ebsd::Ctf::Y, tDims, cDims);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ReadH5Ebsd::convertEulerAngles(bool offsetHexagonal)
+{
+  if(m_SelectedArrayNames.find(m_CellEulerAnglesArrayName) == m_SelectedArrayNames.end())
+  {
+    return;
+  }
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+  AttributeMatrix::Pointer cellAttrMatrix = m->getAttributeMatrix(getCellAttributeMatrixName());
+  FloatArrayType::Pointer fArray = cellAttrMatrix->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::EulerAngles);
+  Int32ArrayType::Pointer iArray = cellAttrMatrix->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::Phases);
+  if(nullptr == fArray.get())
+  {
+    return;
+  }
+
+  ReadH5EbsdEulerTransformImpl transform(fArray->getPointer(0), (nullptr != iArray.get()) ? iArray->getPointer(0) : nullptr, m_CrystalStructures, getDegToRad(), offsetHexagonal);
+  if(transform.isIdentity() == true)
+  {
+    return;
+  }
+  transform.convert(0, fArray->getNumberOfTuples());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float ReadH5Ebsd::getDegToRad()
+{
+  if(m_AngleRepresentation != Ebsd::AngleRepresentation::Radians && m_UseTransformations == true)
+  {
+    return SIMPLib::Constants::k_PiOver180;
+  }
+  return 1.0f;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ReadH5Ebsd::setupSliceRemap(H5EbsdVolumeReader* ebsdReader)
+{
+  if(m_UseTransformations == false || m_SampleTransformation.angle <= 0)
+  {
+    return true;
+  }
+
+  // Build the same rotation matrix that RotateSampleRefFrame would use
+  float rotAngle = m_SampleTransformation.angle * SIMPLib::Constants::k_Pi / 180.0;
+  float rotMat[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+  FOrientArrayType om(9);
+  FOrientTransformsType::ax2om(FOrientArrayType(m_SampleTransformation.h, m_SampleTransformation.k, m_SampleTransformation.l, rotAngle), om);
+  om.toGMatrix(rotMat);
+
+  // The rotation can only be done as a remap of each slice if it is a signed permutation that leaves the Z axis in place
+  int32_t r[3][3] = {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}};
+  for(int32_t i = 0; i < 3; i++)
+  {
+    for(int32_t j = 0; j < 3; j++)
+    {
+      r[i][j] = static_cast<int32_t>(nearbyint(rotMat[i][j]));
+      if(fabs(rotMat[i][j] - r[i][j]) > 1.0E-4)
+      {
+        return false;
+      }
+    }
+  }
+  if(r[2][0] != 0 || r[2][1] != 0 || r[0][2] != 0 || r[1][2] != 0 || abs(r[2][2]) != 1)
+  {
+    return false;
+  }
+  bool transpose = (r[0][0] == 0);
+  int32_t signX = transpose ? r[0][1] : r[0][0];
+  int32_t signY = transpose ? r[1][0] : r[1][1];
+  int32_t offX = transpose ? r[0][0] : r[0][1];
+  int32_t offY = transpose ? r[1][1] : r[1][0];
+  if(abs(signX) != 1 || abs(signY) != 1 || offX != 0 || offY != 0)
+  {
+    return false;
+  }
+
+  // Update the geometry to what RotateSampleRefFrame would produce when rotating slice by slice
+  ImageGeom::Pointer image = getDataContainerArray()->getDataContainer(getDataContainerName())->getGeometryAs<ImageGeom>();
+  size_t dims[3] = {0, 0, 0};
+  float res[3] = {0.0f, 0.0f, 0.0f};
+  image->getDimensions(dims);
+  image->getResolution(res);
+  size_t newDims[3] = {transpose ? dims[1] : dims[0], transpose ? dims[0] : dims[1], dims[2]};
+  float newRes[3] = {transpose ? res[1] : res[0], transpose ? res[0] : res[1], res[2]};
+  float origin[3] = {0.0f, 0.0f, 0.0f};
+  if(signX < 0)
+  {
+    origin[0] = -static_cast<float>(newDims[0] - 1) * newRes[0];
+  }
+  if(signY < 0)
+  {
+    origin[1] = -static_cast<float>(newDims[1] - 1) * newRes[1];
+  }
+  if(r[2][2] < 0)
+  {
+    origin[2] = -static_cast<float>(newDims[2] - 1) * newRes[2];
   }
+  image->setDimensions(newDims);
+  image->setResolution(newRes);
+  image->setOrigin(origin);
+
+  ebsdReader->setTransposeSliceAxes(transpose);
+  ebsdReader->setFlipSliceX(signX < 0);
+  ebsdReader->setFlipSliceY(signY < 0);
+  return true;
 }
 
 // -----------------------------------------------------------------------------
@@ -1047,6 +1257,7 @@ AbstractFilter::Pointer ReadH5Ebsd::newFilterInstance(bool copyFilterParameters)
     filter->setSelectedArrayNames(getSelectedArrayNames());
     filter->setDataArrayNames(getDataArrayNames());
     filter->setAngleRepresentation(getAngleRepresentation());
+    filter->setFuseTransformations(getFuseTransformations());
   }
   return filter;
 }
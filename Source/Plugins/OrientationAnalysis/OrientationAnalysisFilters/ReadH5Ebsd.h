@@ -94,6 +94,11 @@ class ReadH5Ebsd : public AbstractFilter
     SIMPL_FILTER_PARAMETER(int, AngleRepresentation)
     Q_PROPERTY(int AngleRepresentation READ getAngleRepresentation WRITE setAngleRepresentation)
 
+    // Not exposed as a filter parameter: turning this off always applies the transformations with the
+    // RotateSampleRefFrame/RotateEulerRefFrame filters after the load
+    SIMPL_INSTANCE_PROPERTY(bool, FuseTransformations)
+    Q_PROPERTY(bool FuseTransformations READ getFuseTransformations WRITE setFuseTransformations)
+
 
     //-------------------------------------------------------
     // Not sure why these are here. We would be reading all of these from the file
@@ -230,16 +235,50 @@ class ReadH5Ebsd : public AbstractFilter
     H5EbsdVolumeReader::Pointer initHKLEbsdVolumeReader();
 
     /**
-     * @brief copyTSLArrays Copies the read arrays into the data container structure (TSL variant)
+     * @brief createTSLArrays Creates the cell arrays in the data container structure and registers
+     * them with the reader so the data is loaded straight into them (TSL variant)
+     * @param ebsdReader H5EbsdVolumeReader instance pointer
+     */
+    void createTSLArrays(H5EbsdVolumeReader* ebsdReader);
+
+    /**
+     * @brief createHKLArrays Creates the cell arrays in the data container structure and registers
+     * them with the reader so the data is loaded straight into them (HKL variant)
      * @param ebsdReader H5EbsdVolumeReader instance pointer
      */
-    void copyTSLArrays(H5EbsdVolumeReader* ebsdReader);
+    void createHKLArrays(H5EbsdVolumeReader* ebsdReader);
+
+    /**
+     * @brief createEulerAnglesArray Creates the 3 component Euler angles array and registers
+     * each of the three angles as one of its components
+     * @param ebsdReader H5EbsdVolumeReader instance pointer
+     * @param euler1 Reader name of the first angle
+     * @param euler2 Reader name of the second angle
+     * @param euler3 Reader name of the third angle
+     */
+    void createEulerAnglesArray(H5EbsdVolumeReader* ebsdReader, const QString& euler1, const QString& euler2, const QString& euler3);
+
+    /**
+     * @brief convertEulerAngles Converts the loaded Euler angles to radians in place and, for HKL
+     * data, adds the 30 degree offset to hexagonal phases
+     * @param offsetHexagonal Whether the hexagonal offset should be applied
+     */
+    void convertEulerAngles(bool offsetHexagonal);
+
+    /**
+     * @brief getDegToRad Returns the factor that converts the Euler angles stored in the file to radians
+     * @return The conversion factor
+     */
+    float getDegToRad();
 
     /**
-     * @brief copyHKLArrays Copies the read arrays into the data container structure (HKL variant)
+     * @brief setupSliceRemap Checks whether the sample transformation can be applied as an in plane remap
+     * while the slices are loaded. If it can the reader is configured to do so and the geometry is updated
+     * to match what RotateSampleRefFrame would have produced.
      * @param ebsdReader H5EbsdVolumeReader instance pointer
+     * @return false if the transformations have to be applied by the RotateSampleRefFrame/RotateEulerRefFrame filters
      */
-    void copyHKLArrays(H5EbsdVolumeReader* ebsdReader);
+    bool setupSliceRemap(H5EbsdVolumeReader* ebsdReader);
 
     /**
     * @brief loadInfo Reads the values for the phase type, crystal structure
@@ -0,0 +1,264 @@
+/* ============================================================================
+ * Copyright (c) 2015 BlueQuartz Softwae, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+
+#include <cmath>
+#include <cstring>
+
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "Plugins/OrientationAnalysis/OrientationAnalysisFilters/EbsdToH5Ebsd.h"
+#include "Plugins/OrientationAnalysis/OrientationAnalysisFilters/ReadH5Ebsd.h"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+class ReadH5EbsdTest
+{
+public:
+  ReadH5EbsdTest()
+  {
+  }
+  virtual ~ReadH5EbsdTest()
+  {
+  }
+  SIMPL_TYPE_MACRO(ReadH5EbsdTest)
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(UnitTest::ReadH5EbsdTest::H5EbsdFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // ReadH5Ebsd falls back to these filters for the transformations it can not apply while loading
+    QStringList filtNames;
+    filtNames << "RotateSampleRefFrame"
+              << "RotateEulerRefFrame";
+    FilterManager* fm = FilterManager::Instance();
+    for(int32_t i = 0; i < filtNames.size(); i++)
+    {
+      IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtNames[i]);
+      if(nullptr == filterFactory.get())
+      {
+        std::stringstream ss;
+        ss << "The ReadH5EbsdTest requires the use of the " << filtNames[i].toStdString() << " filter";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Converts the 3 test .ang files into an .h5ebsd file that stores the given sample transformation
+  // and a 90 degree rotation about <001> for the Euler angles
+  // -----------------------------------------------------------------------------
+  void WriteH5EbsdFile(float sampleAngle, float sampleAxis[3])
+  {
+    QFile::remove(UnitTest::ReadH5EbsdTest::H5EbsdFile);
+    EbsdToH5Ebsd::Pointer writer = EbsdToH5Ebsd::New();
+    writer->setOutputFile(UnitTest::ReadH5EbsdTest::H5EbsdFile);
+    writer->setZStartIndex(1);
+    writer->setZEndIndex(3);
+    writer->setZResolution(0.25f);
+    writer->setRefFrameZDir(SIMPL::RefFrameZDir::LowtoHigh);
+    writer->setInputPath(UnitTest::ReadH5EbsdTest::InputDir);
+    writer->setFilePrefix("Test_");
+    writer->setFileSuffix("");
+    writer->setFileExtension("ang");
+    writer->setPaddingDigits(1);
+
+    AxisAngleInput_t sampleTransformation;
+    sampleTransformation.angle = sampleAngle;
+    sampleTransformation.h = sampleAxis[0];
+    sampleTransformation.k = sampleAxis[1];
+    sampleTransformation.l = sampleAxis[2];
+    writer->setSampleTransformation(sampleTransformation);
+    AxisAngleInput_t eulerTransformation;
+    eulerTransformation.angle = 90.0f;
+    eulerTransformation.h = 0.0f;
+    eulerTransformation.k = 0.0f;
+    eulerTransformation.l = 1.0f;
+    writer->setEulerTransformation(eulerTransformation);
+
+    writer->execute();
+    DREAM3D_REQUIRED(writer->getErrorCondition(), >=, 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer LoadH5EbsdFile(bool useTransformations, bool fuseTransformations)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    ReadH5Ebsd::Pointer reader = ReadH5Ebsd::New();
+    reader->setDataContainerArray(dca);
+    reader->setInputFile(UnitTest::ReadH5EbsdTest::H5EbsdFile);
+    reader->setZStartIndex(1);
+    reader->setZEndIndex(3);
+    reader->setUseTransformations(useTransformations);
+    QSet<QString> arrayNames;
+    arrayNames << SIMPL::CellData::EulerAngles << SIMPL::CellData::Phases << Ebsd::Ang::ConfidenceIndex << Ebsd::Ang::ImageQuality;
+    reader->setSelectedArrayNames(arrayNames);
+    reader->setFuseTransformations(fuseTransformations);
+    reader->execute();
+    DREAM3D_REQUIRED(reader->getErrorCondition(), >=, 0)
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Loads the file with the transformations applied while the slices are read and with the
+  // RotateSampleRefFrame/RotateEulerRefFrame filters, which must give the same data container
+  // -----------------------------------------------------------------------------
+  void CompareFusedToFilters(float sampleAngle, float sampleAxis[3], bool transposed)
+  {
+    WriteH5EbsdFile(sampleAngle, sampleAxis);
+    DataContainerArray::Pointer fused = LoadH5EbsdFile(true, true);
+    DataContainerArray::Pointer filtered = LoadH5EbsdFile(true, false);
+    DataContainerArray::Pointer untransformed = LoadH5EbsdFile(false, true);
+
+    DataContainer::Pointer fusedDc = fused->getDataContainer(SIMPL::Defaults::ImageDataContainerName);
+    DataContainer::Pointer filteredDc = filtered->getDataContainer(SIMPL::Defaults::ImageDataContainerName);
+    DREAM3D_REQUIRE_VALID_POINTER(fusedDc.get())
+    DREAM3D_REQUIRE_VALID_POINTER(filteredDc.get())
+
+    ImageGeom::Pointer fusedGeom = fusedDc->getGeometryAs<ImageGeom>();
+    ImageGeom::Pointer filteredGeom = filteredDc->getGeometryAs<ImageGeom>();
+    size_t fusedDims[3] = {0, 0, 0};
+    size_t filteredDims[3] = {0, 0, 0};
+    fusedGeom->getDimensions(fusedDims);
+    filteredGeom->getDimensions(filteredDims);
+    float fusedRes[3] = {0.0f, 0.0f, 0.0f};
+    float filteredRes[3] = {0.0f, 0.0f, 0.0f};
+    fusedGeom->getResolution(fusedRes);
+    filteredGeom->getResolution(filteredRes);
+    float fusedOrigin[3] = {0.0f, 0.0f, 0.0f};
+    float filteredOrigin[3] = {0.0f, 0.0f, 0.0f};
+    fusedGeom->getOrigin(fusedOrigin);
+    filteredGeom->getOrigin(filteredOrigin);
+    for(int32_t i = 0; i < 3; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(fusedDims[i], filteredDims[i])
+      DREAM3D_REQUIRE_EQUAL(fusedRes[i], filteredRes[i])
+      // RotateSampleRefFrame finds the origin by rotating the corners of the volume with a rotation
+      // matrix whose zero entries are only zero to within float precision
+      DREAM3D_REQUIRE(std::fabs(fusedOrigin[i] - filteredOrigin[i]) < 1.0E-4f)
+    }
+
+    // The slices were remapped while they were read
+    size_t fileDims[3] = {0, 0, 0};
+    untransformed->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getGeometryAs<ImageGeom>()->getDimensions(fileDims);
+    DREAM3D_REQUIRE_EQUAL(fusedDims[0], fileDims[transposed ? 1 : 0])
+    DREAM3D_REQUIRE_EQUAL(fusedDims[1], fileDims[transposed ? 0 : 1])
+    DREAM3D_REQUIRE_EQUAL(fusedDims[2], fileDims[2])
+
+    AttributeMatrix::Pointer fusedCells = fusedDc->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName);
+    AttributeMatrix::Pointer filteredCells = filteredDc->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName);
+    DREAM3D_REQUIRE_VALID_POINTER(fusedCells.get())
+    DREAM3D_REQUIRE_VALID_POINTER(filteredCells.get())
+    DREAM3D_REQUIRE(fusedCells->getTupleDimensions() == filteredCells->getTupleDimensions())
+
+    QList<QString> names = fusedCells->getAttributeArrayNames();
+    DREAM3D_REQUIRE_EQUAL(names.size(), filteredCells->getAttributeArrayNames().size())
+    DREAM3D_REQUIRE(names.contains(SIMPL::CellData::EulerAngles))
+    DREAM3D_REQUIRE(names.contains(SIMPL::CellData::Phases))
+    for(int32_t i = 0; i < names.size(); i++)
+    {
+      IDataArray::Pointer fusedArray = fusedCells->getAttributeArray(names[i]);
+      IDataArray::Pointer filteredArray = filteredCells->getAttributeArray(names[i]);
+      DREAM3D_REQUIRE_VALID_POINTER(filteredArray.get())
+      DREAM3D_REQUIRE_EQUAL(fusedArray->getNumberOfTuples(), filteredArray->getNumberOfTuples())
+      DREAM3D_REQUIRE_EQUAL(fusedArray->getNumberOfComponents(), filteredArray->getNumberOfComponents())
+      DREAM3D_REQUIRE_EQUAL(fusedArray->getTypeAsString(), filteredArray->getTypeAsString())
+      size_t numBytes = fusedArray->getNumberOfTuples() * fusedArray->getNumberOfComponents() * fusedArray->getTypeSize();
+      DREAM3D_REQUIRE_EQUAL(::memcmp(fusedArray->getVoidPointer(0), filteredArray->getVoidPointer(0), numBytes), 0)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestMirroredSample()
+  {
+    // The default TSL sample transformation mirrors X and Z
+    float axis[3] = {0.0f, 1.0f, 0.0f};
+    CompareFusedToFilters(180.0f, axis, false);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestTransposedSample()
+  {
+    // Swaps the X and Y axes of every slice and mirrors the new X axis
+    float axis[3] = {0.0f, 0.0f, 1.0f};
+    CompareFusedToFilters(90.0f, axis, true);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestMirroredSample())
+    DREAM3D_REGISTER_TEST(TestTransposedSample())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+private:
+  ReadH5EbsdTest(const ReadH5EbsdTest&); // Copy Constructor Not Implemented
+  void operator=(const ReadH5EbsdTest&); // Operator '=' Not Implemented
+};
@@ -45,11 +45,49 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "Processing/ProcessingConstants.h"
+#include "Processing/ProcessingFilters/util/FrontierDilation.hpp"
+#include "Processing/ProcessingFilters/util/VoxelNeighborhood.hpp"
 #include "Processing/ProcessingVersion.h"
 
 // Include the MOC generated file for this class
 #include "moc_ErodeDilateBadData.cpp"
 
+namespace ErodeDilateBadDataDetail
+{
+/**
+ * @brief Dilating the bad data turns the Feature voxels next to it into bad data (0). Of several bad data
+ * neighbors the one with the highest index is copied.
+ */
+struct DilateRule
+{
+  static bool IsTarget(int32_t featureId)
+  {
+    return featureId > 0;
+  }
+  static bool IsSource(int32_t featureId)
+  {
+    return featureId == 0;
+  }
+  static const bool k_MajorityVote = false;
+};
+
+/**
+ * @brief Eroding the bad data gives its voxels the most common neighboring Feature
+ */
+struct ErodeRule
+{
+  static bool IsTarget(int32_t featureId)
+  {
+    return featureId == 0;
+  }
+  static bool IsSource(int32_t featureId)
+  {
+    return featureId > 0;
+  }
+  static const bool k_MajorityVote = true;
+};
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -61,7 +99,6 @@ ErodeDilateBadData::ErodeDilateBadData()
 , m_YDirOn(true)
 , m_ZDirOn(true)
 , m_FeatureIdsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds)
-, m_Neighbors(nullptr)
 , m_FeatureIds(nullptr)
 {
   setupFilterParameters();
@@ -127,7 +164,6 @@ void ErodeDilateBadData::readFilterParameters(AbstractFilterParametersReader* re
 // -----------------------------------------------------------------------------
 void ErodeDilateBadData::initialize()
 {
-  m_Neighbors = nullptr;
 }
 
 // -----------------------------------------------------------------------------
@@ -183,10 +219,6 @@ void ErodeDilateBadData::execute()
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getFeatureIdsArrayPath().getDataContainerName());
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
 
-  Int32ArrayType::Pointer neighborsPtr = Int32ArrayType::CreateArray(totalPoints, "_INTERNAL_USE_ONLY_Neighbors");
-  m_Neighbors = neighborsPtr->getPointer(0);
-  neighborsPtr->initializeWithValue(-1);
-
   size_t udims[3] = {0, 0, 0};
   m->getGeometryAs<ImageGeom>()->getDimensions(udims);
 
@@ -194,158 +226,19 @@ void ErodeDilateBadData::execute()
       static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
   };
 
-  int32_t good = 1;
-  int64_t count = 0;
-  int64_t kstride = 0, jstride = 0;
-  int32_t featurename = 0, feature = 0;
-  int32_t current = 0;
-  int32_t most = 0;
-  int64_t neighpoint = 0;
-  size_t numfeatures = 0;
+  VoxelNeighborhood<6> neighborhood(dims, m_XDirOn, m_YDirOn, m_ZDirOn);
+
+  AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(m_FeatureIdsArrayPath.getAttributeMatrixName());
 
-  for(size_t i = 0; i < totalPoints; i++)
+  if(m_Direction == 0)
   {
-    featurename = m_FeatureIds[i];
-    if(featurename > numfeatures)
-    {
-      numfeatures = featurename;
-    }
+    FrontierDilation<ErodeDilateBadDataDetail::DilateRule> dilation(neighborhood, m_FeatureIds, totalPoints, cellAttrMat);
+    dilation.run(m_NumIterations);
   }
-
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -dims[0] * dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0] * dims[1];
-
-  QVector<int32_t> n(numfeatures + 1, 0);
-
-  for(int32_t iteration = 0; iteration < m_NumIterations; iteration++)
+  else
   {
-    for(int64_t k = 0; k < dims[2]; k++)
-    {
-      kstride = dims[0] * dims[1] * k;
-      for(int64_t j = 0; j < dims[1]; j++)
-      {
-        jstride = dims[0] * j;
-        for(int64_t i = 0; i < dims[0]; i++)
-        {
-          count = kstride + jstride + i;
-          featurename = m_FeatureIds[count];
-          if(featurename == 0)
-          {
-            current = 0;
-            most = 0;
-            for(int32_t l = 0; l < 6; l++)
-            {
-              good = 1;
-              neighpoint = count + neighpoints[l];
-              if(l == 0 && (k == 0 || m_ZDirOn == false))
-              {
-                good = 0;
-              }
-              else if(l == 5 && (k == (dims[2] - 1) || m_ZDirOn == false))
-              {
-                good = 0;
-              }
-              else if(l == 1 && (j == 0 || m_YDirOn == false))
-              {
-                good = 0;
-              }
-              else if(l == 4 && (j == (dims[1] - 1) || m_YDirOn == false))
-              {
-                good = 0;
-              }
-              else if(l == 2 && (i == 0 || m_XDirOn == false))
-              {
-                good = 0;
-              }
-              else if(l == 3 && (i == (dims[0] - 1) || m_XDirOn == false))
-              {
-                good = 0;
-              }
-              if(good == 1)
-              {
-                feature = m_FeatureIds[neighpoint];
-                if(m_Direction == 0 && feature > 0)
-                {
-                  m_Neighbors[neighpoint] = count;
-                }
-                if(feature > 0 && m_Direction == 1)
-                {
-                  n[feature]++;
-                  current = n[feature];
-                  if(current > most)
-                  {
-                    most = current;
-                    m_Neighbors[count] = neighpoint;
-                  }
-                }
-              }
-            }
-            if(m_Direction == 1)
-            {
-              for(int32_t l = 0; l < 6; l++)
-              {
-                good = 1;
-                neighpoint = count + neighpoints[l];
-                if(l == 0 && k == 0)
-                {
-                  good = 0;
-                }
-                if(l == 5 && k == (dims[2] - 1))
-                {
-                  good = 0;
-                }
-                if(l == 1 && j == 0)
-                {
-                  good = 0;
-                }
-                if(l == 4 && j == (dims[1] - 1))
-                {
-                  good = 0;
-                }
-                if(l == 2 && i == 0)
-                {
-                  good = 0;
-                }
-                if(l == 3 && i == (dims[0] - 1))
-                {
-                  good = 0;
-                }
-                if(good == 1)
-                {
-                  feature = m_FeatureIds[neighpoint];
-                  n[feature] = 0;
-                }
-              }
-            }
-          }
-        }
-      }
-    }
-
-    QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
-    QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
-
-    for(size_t j = 0; j < totalPoints; j++)
-    {
-      featurename = m_FeatureIds[j];
-      int32_t neighbor = m_Neighbors[j];
-      if(neighbor >= 0)
-      {
-        if((featurename == 0 && m_FeatureIds[neighbor] > 0 && m_Direction == 1) || (featurename > 0 && m_FeatureIds[neighbor] == 0 && m_Direction == 0))
-        {
-          for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-          {
-            IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(*iter);
-            p->copyTuple(neighbor, j);
-          }
-        }
-      }
-    }
+    FrontierDilation<ErodeDilateBadDataDetail::ErodeRule> dilation(neighborhood, m_FeatureIds, totalPoints, cellAttrMat);
+    dilation.run(m_NumIterations);
   }
 
   // If there is an error set this to something negative and also set a message
@@ -45,6 +45,7 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "Processing/ProcessingConstants.h"
+#include "Processing/ProcessingFilters/util/VoxelNeighborhood.hpp"
 #include "Processing/ProcessingVersion.h"
 
 // Include the MOC generated file for this class
@@ -196,18 +197,7 @@ void ErodeDilateMask::execute()
       static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
   };
 
-  int32_t good = 1;
-  int64_t count = 0;
-  int64_t kstride = 0, jstride = 0;
-  int64_t neighpoint = 0;
-
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -dims[0] * dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0] * dims[1];
+  VoxelNeighborhood<6> neighborhood(dims, m_XDirOn, m_YDirOn, m_ZDirOn);
 
   for(int32_t iteration = 0; iteration < m_NumIterations; iteration++)
   {
@@ -215,61 +205,21 @@ void ErodeDilateMask::execute()
     {
       m_MaskCopy[j] = m_Mask[j];
     }
-    for(int64_t k = 0; k < dims[2]; k++)
-    {
-      kstride = dims[0] * dims[1] * k;
-      for(int64_t j = 0; j < dims[1]; j++)
+    neighborhood.forEachVoxel([&](int64_t count, int64_t i, int64_t j, int64_t k, bool interior) {
+      if(m_Mask[count] == false)
       {
-        jstride = dims[0] * j;
-        for(int64_t i = 0; i < dims[0]; i++)
-        {
-          count = kstride + jstride + i;
-          if(m_Mask[count] == false)
+        neighborhood.forEachNeighbor(count, i, j, k, interior, [&](int32_t, int64_t neighpoint) {
+          if(m_Direction == 0 && m_Mask[neighpoint] == true)
           {
-            for(int32_t l = 0; l < 6; l++)
-            {
-              good = 1;
-              neighpoint = count + neighpoints[l];
-              if(l == 0 && (k == 0 || m_ZDirOn == false))
-              {
-                good = 0;
-              }
-              else if(l == 5 && (k == (dims[2] - 1) || m_ZDirOn == false))
-              {
-                good = 0;
-              }
-              else if(l == 1 && (j == 0 || m_YDirOn == false))
-              {
-                good = 0;
-              }
-              else if(l == 4 && (j == (dims[1] - 1) || m_YDirOn == false))
-              {
-                good = 0;
-              }
-              else if(l == 2 && (i == 0 || m_XDirOn == false))
-              {
-                good = 0;
-              }
-              else if(l == 3 && (i == (dims[0] - 1) || m_XDirOn == false))
-              {
-                good = 0;
-              }
-              if(good == 1)
-              {
-                if(m_Direction == 0 && m_Mask[neighpoint] == true)
-                {
-                  m_MaskCopy[count] = true;
-                }
-                if(m_Direction == 1 && m_Mask[neighpoint] == true)
-                {
-                  m_MaskCopy[neighpoint] = false;
-                }
-              }
-            }
+            m_MaskCopy[count] = true;
           }
-        }
+          if(m_Direction == 1 && m_Mask[neighpoint] == true)
+          {
+            m_MaskCopy[neighpoint] = false;
+          }
+        });
       }
-    }
+    });
     for(size_t j = 0; j < totalPoints; j++)
     {
       m_Mask[j] = m_MaskCopy[j];
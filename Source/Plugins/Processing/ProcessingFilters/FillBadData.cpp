@@ -45,11 +45,32 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "Processing/ProcessingConstants.h"
+#include "Processing/ProcessingFilters/util/FrontierDilation.hpp"
+#include "Processing/ProcessingFilters/util/VoxelNeighborhood.hpp"
 #include "Processing/ProcessingVersion.h"
 
 // Include the MOC generated file for this class
 #include "moc_FillBadData.cpp"
 
+namespace FillBadDataDetail
+{
+/**
+ * @brief Defects that are too small (-1) take on the most common neighboring Feature
+ */
+struct FillRule
+{
+  static bool IsTarget(int32_t featureId)
+  {
+    return featureId < 0;
+  }
+  static bool IsSource(int32_t featureId)
+  {
+    return featureId > 0;
+  }
+  static const bool k_MajorityVote = true;
+};
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -60,7 +81,6 @@ FillBadData::FillBadData()
 , m_FeatureIdsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds)
 , m_CellPhasesArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases)
 , m_AlreadyChecked(nullptr)
-, m_Neighbors(nullptr)
 , m_FeatureIds(nullptr)
 , m_CellPhases(nullptr)
 {
@@ -117,7 +137,6 @@ void FillBadData::readFilterParameters(AbstractFilterParametersReader* reader, i
 void FillBadData::initialize()
 {
   m_AlreadyChecked = nullptr;
-  m_Neighbors = nullptr;
 }
 
 // -----------------------------------------------------------------------------
@@ -189,10 +208,6 @@ void FillBadData::execute()
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
 
-  Int32ArrayType::Pointer neighborsPtr = Int32ArrayType::CreateArray(totalPoints, "_INTERNAL_USE_ONLY_Neighbors");
-  m_Neighbors = neighborsPtr->getPointer(0);
-  neighborsPtr->initializeWithValue(-1);
-
   BoolArrayType::Pointer alreadCheckedPtr = BoolArrayType::CreateArray(totalPoints, "_INTERNAL_USE_ONLY_AlreadyChecked");
   m_AlreadyChecked = alreadCheckedPtr->getPointer(0);
   alreadCheckedPtr->initializeWithZeros();
@@ -205,25 +220,9 @@ void FillBadData::execute()
   };
 
   size_t count = 1;
-  int32_t good = 1;
-  int64_t neighbor;
   int64_t index = 0;
-  float x = 0.0f, y = 0.0f, z = 0.0f;
-  int64_t column = 0, row = 0, plane = 0;
-  int64_t neighpoint = 0;
-  int32_t featurename = 0, feature = 0;
-  size_t numfeatures = 0;
   size_t maxPhase = 0;
 
-  for(size_t i = 0; i < totalPoints; i++)
-  {
-    featurename = m_FeatureIds[i];
-    if(featurename > numfeatures)
-    {
-      numfeatures = featurename;
-    }
-  }
-
   if(m_StoreAsNewPhase == true)
   {
     for(size_t i = 0; i < totalPoints; i++)
@@ -235,13 +234,7 @@ void FillBadData::execute()
     }
   }
 
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -dims[0] * dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0] * dims[1];
+  VoxelNeighborhood<6> neighborhood(dims);
   std::vector<int64_t> currentvlist;
 
   for(size_t iter = 0; iter < totalPoints; iter++)
@@ -262,43 +255,13 @@ void FillBadData::execute()
       while(count < currentvlist.size())
       {
         index = currentvlist[count];
-        column = index % dims[0];
-        row = (index / dims[0]) % dims[1];
-        plane = index / (dims[0] * dims[1]);
-        for(int32_t j = 0; j < 6; j++)
-        {
-          good = 1;
-          neighbor = index + neighpoints[j];
-          if(j == 0 && plane == 0)
-          {
-            good = 0;
-          }
-          if(j == 5 && plane == (dims[2] - 1))
-          {
-            good = 0;
-          }
-          if(j == 1 && row == 0)
+        neighborhood.forEachNeighbor(index, [&](int32_t, int64_t neighpoint) {
+          if(m_FeatureIds[neighpoint] == 0 && m_AlreadyChecked[neighpoint] == false)
           {
-            good = 0;
+            currentvlist.push_back(neighpoint);
+            m_AlreadyChecked[neighpoint] = true;
           }
-          if(j == 4 && row == (dims[1] - 1))
-          {
-            good = 0;
-          }
-          if(j == 2 && column == 0)
-          {
-            good = 0;
-          }
-          if(j == 3 && column == (dims[0] - 1))
-          {
-            good = 0;
-          }
-          if(good == 1 && m_FeatureIds[neighbor] == 0 && m_AlreadyChecked[neighbor] == false)
-          {
-            currentvlist.push_back(neighbor);
-            m_AlreadyChecked[neighbor] = true;
-          }
-        }
+        });
         count++;
       }
       if((int32_t)currentvlist.size() >= m_MinAllowedDefectSize)
@@ -323,124 +286,12 @@ void FillBadData::execute()
     }
   }
 
-  int32_t current = 0;
-  int32_t most = 0;
-  std::vector<int32_t> n(numfeatures + 1, 0);
+  // Grow the neighboring Features into the small defects that were flagged with -1, always taking the
+  // most common neighboring Feature, until every reachable defect voxel is filled
+  AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(m_FeatureIdsArrayPath.getAttributeMatrixName());
 
-  while(count != 0)
-  {
-    count = 0;
-    for(size_t i = 0; i < totalPoints; i++)
-    {
-      featurename = m_FeatureIds[i];
-      if(featurename < 0)
-      {
-        count++;
-        current = 0;
-        most = 0;
-        x = static_cast<float>(i % dims[0]);
-        y = static_cast<float>((i / dims[0]) % dims[1]);
-        z = static_cast<float>(i / (dims[0] * dims[1]));
-        for(int32_t j = 0; j < 6; j++)
-        {
-          good = 1;
-          neighpoint = static_cast<int64_t>(i + neighpoints[j]);
-          if(j == 0 && z == 0)
-          {
-            good = 0;
-          }
-          if(j == 5 && z == (dims[2] - 1))
-          {
-            good = 0;
-          }
-          if(j == 1 && y == 0)
-          {
-            good = 0;
-          }
-          if(j == 4 && y == (dims[1] - 1))
-          {
-            good = 0;
-          }
-          if(j == 2 && x == 0)
-          {
-            good = 0;
-          }
-          if(j == 3 && x == (dims[0] - 1))
-          {
-            good = 0;
-          }
-          if(good == 1)
-          {
-            feature = m_FeatureIds[neighpoint];
-            if(feature > 0)
-            {
-              n[feature]++;
-              current = n[feature];
-              if(current > most)
-              {
-                most = current;
-                m_Neighbors[i] = neighpoint;
-              }
-            }
-          }
-        }
-        for(int32_t l = 0; l < 6; l++)
-        {
-          good = 1;
-          neighpoint = i + neighpoints[l];
-          if(l == 0 && z == 0)
-          {
-            good = 0;
-          }
-          if(l == 5 && z == (dims[2] - 1))
-          {
-            good = 0;
-          }
-          if(l == 1 && y == 0)
-          {
-            good = 0;
-          }
-          if(l == 4 && y == (dims[1] - 1))
-          {
-            good = 0;
-          }
-          if(l == 2 && x == 0)
-          {
-            good = 0;
-          }
-          if(l == 3 && x == (dims[0] - 1))
-          {
-            good = 0;
-          }
-          if(good == 1)
-          {
-            feature = m_FeatureIds[neighpoint];
-            if(feature > 0)
-            {
-              n[feature] = 0;
-            }
-          }
-        }
-      }
-    }
-
-    QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
-    QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
-
-    for(size_t j = 0; j < totalPoints; j++)
-    {
-      featurename = m_FeatureIds[j];
-      neighbor = m_Neighbors[j];
-      if(featurename < 0 && neighbor != -1 && m_FeatureIds[neighbor] > 0)
-      {
-        for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-        {
-          IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(*iter);
-          p->copyTuple(neighbor, j);
-        }
-      }
-    }
-  }
+  FrontierDilation<FillBadDataDetail::FillRule> dilation(neighborhood, m_FeatureIds, totalPoints, cellAttrMat);
+  dilation.run(-1);
 
   // If there is an error set this to something negative and also set a message
   notifyStatusMessage(getHumanLabel(), "Complete");
@@ -43,6 +43,7 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "Processing/ProcessingConstants.h"
+#include "Processing/ProcessingFilters/util/VoxelNeighborhood.hpp"
 #include "Processing/ProcessingVersion.h"
 
 // Include the MOC generated file for this class
@@ -153,24 +154,16 @@ void IdentifySample::execute()
       static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
   };
 
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
   int64_t xp = dims[0];
   int64_t yp = dims[1];
   int64_t zp = dims[2];
 
-  neighpoints[0] = -(xp * yp);
-  neighpoints[1] = -xp;
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = xp;
-  neighpoints[5] = (xp * yp);
+  VoxelNeighborhood<6> neighborhood(dims);
   std::vector<int64_t> currentvlist;
   std::vector<bool> checked(totalPoints, false);
   std::vector<bool> sample(totalPoints, false);
   int64_t biggestBlock = 0;
   size_t count = 0;
-  int32_t good = 0;
-  int64_t neighbor = 0;
   int64_t column = 0, row = 0, plane = 0;
   int64_t index = 0;
 
@@ -185,43 +178,13 @@ void IdentifySample::execute()
       while(count < currentvlist.size())
       {
         index = currentvlist[count];
-        column = index % xp;
-        row = (index / xp) % yp;
-        plane = index / (xp * yp);
-        for(int32_t j = 0; j < 6; j++)
-        {
-          good = 1;
-          neighbor = index + neighpoints[j];
-          if(j == 0 && plane == 0)
-          {
-            good = 0;
-          }
-          if(j == 5 && plane == (zp - 1))
-          {
-            good = 0;
-          }
-          if(j == 1 && row == 0)
-          {
-            good = 0;
-          }
-          if(j == 4 && row == (yp - 1))
-          {
-            good = 0;
-          }
-          if(j == 2 && column == 0)
-          {
-            good = 0;
-          }
-          if(j == 3 && column == (xp - 1))
-          {
-            good = 0;
-          }
-          if(good == 1 && checked[neighbor] == false && m_GoodVoxels[neighbor] == true)
+        neighborhood.forEachNeighbor(index, [&](int32_t, int64_t neighbor) {
+          if(checked[neighbor] == false && m_GoodVoxels[neighbor] == true)
           {
             currentvlist.push_back(neighbor);
             checked[neighbor] = true;
           }
-        }
+        });
         count++;
       }
       if(static_cast<int64_t>(currentvlist.size()) >= biggestBlock)
@@ -261,47 +224,18 @@ void IdentifySample::execute()
         while(count < currentvlist.size())
         {
           index = currentvlist[count];
-          column = index % xp;
-          row = (index / xp) % yp;
-          plane = index / (xp * yp);
+          neighborhood.toCoordinates(index, column, row, plane);
           if(column == 0 || column == (xp - 1) || row == 0 || row == (yp - 1) || plane == 0 || plane == (zp - 1))
           {
             touchesBoundary = true;
           }
-          for(int32_t j = 0; j < 6; j++)
-          {
-            good = 1;
-            neighbor = index + neighpoints[j];
-            if(j == 0 && plane == 0)
-            {
-              good = 0;
-            }
-            if(j == 5 && plane == (zp - 1))
-            {
-              good = 0;
-            }
-            if(j == 1 && row == 0)
-            {
-              good = 0;
-            }
-            if(j == 4 && row == (yp - 1))
-            {
-              good = 0;
-            }
-            if(j == 2 && column == 0)
-            {
-              good = 0;
-            }
-            if(j == 3 && column == (xp - 1))
-            {
-              good = 0;
-            }
-            if(good == 1 && checked[neighbor] == false && m_GoodVoxels[neighbor] == false)
+          neighborhood.forEachNeighbor(index, column, row, plane, [&](int32_t, int64_t neighbor) {
+            if(checked[neighbor] == false && m_GoodVoxels[neighbor] == false)
             {
               currentvlist.push_back(neighbor);
               checked[neighbor] = true;
             }
-          }
+          });
           count++;
         }
         if(touchesBoundary == false)
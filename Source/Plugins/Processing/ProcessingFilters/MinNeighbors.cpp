@@ -44,6 +44,7 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "Processing/ProcessingConstants.h"
+#include "Processing/ProcessingFilters/util/TupleRemap.hpp"
 #include "Processing/ProcessingVersion.h"
 
 // Include the MOC generated file for this class
@@ -292,6 +293,9 @@ void MinNeighbors::assign_badpoints()
   int32_t featurename = 0, feature = 0;
   int32_t neighbor = 0;
   QVector<int32_t> n(numfeatures + 1, 0);
+  TupleRemap cellArrays(m->getAttributeMatrix(m_FeatureIdsArrayPath.getAttributeMatrixName()));
+  std::vector<int64_t> sources;
+  std::vector<int64_t> destinations;
   while(counter != 0)
   {
     counter = 0;
@@ -394,21 +398,19 @@ void MinNeighbors::assign_badpoints()
         }
       }
     }
-    QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
-    QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
+    sources.clear();
+    destinations.clear();
     for(size_t j = 0; j < totalPoints; j++)
     {
       featurename = m_FeatureIds[j];
       neighbor = m_Neighbors[j];
       if(featurename < 0 && neighbor >= 0 && m_FeatureIds[neighbor] >= 0)
       {
-        for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-        {
-          IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(*iter);
-          p->copyTuple(neighbor, j);
-        }
+        sources.push_back(neighbor);
+        destinations.push_back(static_cast<int64_t>(j));
       }
     }
+    cellArrays.copyTuples(sources, destinations);
   }
 }
 
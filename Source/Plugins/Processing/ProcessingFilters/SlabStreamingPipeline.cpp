@@ -0,0 +1,493 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "SlabStreamingPipeline.h"
+
+#include <algorithm>
+
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
+#include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/InputFileFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
+#include "SIMPLib/FilterParameters/JsonFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/OutputFileFilterParameter.h"
+#include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/FilterParameters/StringFilterParameter.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "Processing/ProcessingConstants.h"
+#include "Processing/ProcessingFilters/util/H5SlabStreamer.h"
+#include "Processing/ProcessingVersion.h"
+
+// Include the MOC generated file for this class
+#include "moc_SlabStreamingPipeline.cpp"
+
+namespace SlabStreamingPipelineDetail
+{
+/**
+ * @brief GetZReach Returns how many Z planes away from a Cell the given filter can look when it computes
+ * that Cell, or -1 if the filter is not known to be local. Per Cell filters reach 0 planes; filters
+ * with a fixed stencil reach the stencil radius times the number of iterations they run.
+ */
+int32_t GetZReach(AbstractFilter::Pointer filter)
+{
+  static const char* k_PerCellFilters[] = {"ArrayCalculator",      "ConditionalSetValue", "ConvertColorToGrayScale", "ConvertData",        "ConvertOrientations",
+                                           "CreateDataArray",      "FindCAxisLocations",  "GenerateIPFColors",       "MultiThresholdObjects", "MultiThresholdObjects2",
+                                           "ReplaceValueInArray",  "RotateEulerRefFrame"};
+
+  QString name = filter->getNameOfClass();
+  for(size_t i = 0; i < sizeof(k_PerCellFilters) / sizeof(k_PerCellFilters[0]); i++)
+  {
+    if(name == k_PerCellFilters[i])
+    {
+      return 0;
+    }
+  }
+
+  if(name == "FindBoundaryCells")
+  {
+    return 1;
+  }
+  if(name == "ErodeDilateMask" || name == "ErodeDilateBadData")
+  {
+    if(filter->property("ZDirOn").toBool() == false)
+    {
+      return 0;
+    }
+    return std::max(0, filter->property("NumIterations").toInt());
+  }
+  if(name == "ErodeDilateCoordinationNumber")
+  {
+    // With 'Loop' set the filter repeats until nothing changes, so its reach is not bounded
+    return (filter->property("Loop").toBool() == true) ? -1 : 1;
+  }
+  if(name == "FindKernelAvgMisorientations")
+  {
+    return std::max(0, filter->property("KernelSize").value<IntVec3_t>().z);
+  }
+
+  return -1;
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SlabStreamingPipeline::SlabStreamingPipeline()
+: AbstractFilter()
+, m_InputFile("")
+, m_OutputFile("")
+, m_PipelineFile("")
+, m_DataContainerName(SIMPL::Defaults::ImageDataContainerName)
+, m_CellAttributeMatrixName(SIMPL::Defaults::CellAttributeMatrixName)
+, m_SlabThickness(64)
+, m_HaloThickness(1)
+{
+  setupFilterParameters();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SlabStreamingPipeline::~SlabStreamingPipeline()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SlabStreamingPipeline::setupFilterParameters()
+{
+  FilterParameterVector parameters;
+
+  parameters.push_back(SIMPL_NEW_INPUT_FILE_FP("Input File", InputFile, FilterParameter::Parameter, SlabStreamingPipeline, "*.dream3d"));
+  parameters.push_back(SIMPL_NEW_OUTPUT_FILE_FP("Output File", OutputFile, FilterParameter::Parameter, SlabStreamingPipeline, "*.dream3d", "DREAM3D File"));
+  parameters.push_back(SIMPL_NEW_INPUT_FILE_FP("Pipeline File", PipelineFile, FilterParameter::Parameter, SlabStreamingPipeline, "*.json", "Pipeline File"));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Slab Thickness (Z Planes)", SlabThickness, FilterParameter::Parameter, SlabStreamingPipeline));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Halo Thickness (Z Planes)", HaloThickness, FilterParameter::Parameter, SlabStreamingPipeline));
+  parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Data Container", DataContainerName, FilterParameter::RequiredArray, SlabStreamingPipeline));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Cell Attribute Matrix", CellAttributeMatrixName, FilterParameter::RequiredArray, SlabStreamingPipeline));
+  setFilterParameters(parameters);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SlabStreamingPipeline::readFilterParameters(AbstractFilterParametersReader* reader, int index)
+{
+  reader->openFilterGroup(this, index);
+  setInputFile(reader->readString("InputFile", getInputFile()));
+  setOutputFile(reader->readString("OutputFile", getOutputFile()));
+  setPipelineFile(reader->readString("PipelineFile", getPipelineFile()));
+  setDataContainerName(reader->readString("DataContainerName", getDataContainerName()));
+  setCellAttributeMatrixName(reader->readString("CellAttributeMatrixName", getCellAttributeMatrixName()));
+  setSlabThickness(reader->readValue("SlabThickness", getSlabThickness()));
+  setHaloThickness(reader->readValue("HaloThickness", getHaloThickness()));
+  reader->closeFilterGroup();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SlabStreamingPipeline::initialize()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SlabStreamingPipeline::dataCheck()
+{
+  setErrorCondition(0);
+  initialize();
+
+  if(getInputFile().isEmpty() || !QFileInfo(getInputFile()).exists())
+  {
+    QString ss = QObject::tr("The input file '%1' does not exist").arg(getInputFile());
+    setErrorCondition(-11000);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+  }
+
+  if(getOutputFile().isEmpty())
+  {
+    QString ss = QObject::tr("The output file must be set");
+    setErrorCondition(-11001);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+  }
+
+  if(getPipelineFile().isEmpty() || !QFileInfo(getPipelineFile()).exists())
+  {
+    QString ss = QObject::tr("The pipeline file '%1' does not exist").arg(getPipelineFile());
+    setErrorCondition(-11002);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+  }
+
+  if(getSlabThickness() <= 0)
+  {
+    QString ss = QObject::tr("The slab thickness (%1) must be positive").arg(getSlabThickness());
+    setErrorCondition(-11003);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+  }
+
+  if(getHaloThickness() < 0)
+  {
+    QString ss = QObject::tr("The halo thickness (%1) must not be negative").arg(getHaloThickness());
+    setErrorCondition(-11004);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+  }
+
+  if(getDataContainerName().isEmpty() || getCellAttributeMatrixName().isEmpty())
+  {
+    QString ss = QObject::tr("The Data Container and Cell Attribute Matrix names must be set");
+    setErrorCondition(-11005);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+  }
+
+  // Every slab reads its halo from the input file, so the input must not be overwritten while streaming
+  if(!getInputFile().isEmpty() && !getOutputFile().isEmpty() && QFileInfo(getOutputFile()).absoluteFilePath() == QFileInfo(getInputFile()).absoluteFilePath())
+  {
+    QString ss = QObject::tr("The output file must be different from the input file");
+    setErrorCondition(-11006);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+  }
+
+  if(!getPipelineFile().isEmpty() && QFileInfo(getPipelineFile()).exists())
+  {
+    FilterPipeline::Pointer pipeline = JsonFilterParametersReader::ReadPipelineFromFile(getPipelineFile());
+    if(nullptr == pipeline.get() || pipeline->getFilterContainer().isEmpty())
+    {
+      QString ss = QObject::tr("No filters could be read from the pipeline file '%1'").arg(getPipelineFile());
+      setErrorCondition(-11007);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+
+    // A slab gives the same result as the whole volume only if every filter is local and the halo covers
+    // the planes that the filters can reach in Z, added up over the pipeline
+    int32_t requiredHalo = 0;
+    FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+    for(FilterPipeline::FilterContainerType::iterator iter = filters.begin(); iter != filters.end(); ++iter)
+    {
+      int32_t reach = SlabStreamingPipelineDetail::GetZReach(*iter);
+      if(reach < 0)
+      {
+        QString ss = QObject::tr("'%1' is not a local Cell filter and cannot be executed in slabs").arg((*iter)->getHumanLabel());
+        setErrorCondition(-11008);
+        notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+        return;
+      }
+      requiredHalo += reach;
+    }
+
+    if(getHaloThickness() < requiredHalo)
+    {
+      QString ss = QObject::tr("The pipeline reaches %1 Z planes from each Cell, but the halo thickness is only %2").arg(requiredHalo).arg(getHaloThickness());
+      setErrorCondition(-11009);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SlabStreamingPipeline::preflight()
+{
+  setInPreflight(true);
+  emit preflightAboutToExecute();
+  emit updateFilterParameters(this);
+  dataCheck();
+  emit preflightExecuted();
+  setInPreflight(false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SlabStreamingPipeline::execute()
+{
+  setErrorCondition(0);
+  dataCheck();
+  if(getErrorCondition() < 0)
+  {
+    return;
+  }
+
+  FilterPipeline::Pointer pipeline = JsonFilterParametersReader::ReadPipelineFromFile(getPipelineFile());
+  if(nullptr == pipeline.get() || pipeline->getFilterContainer().isEmpty())
+  {
+    QString ss = QObject::tr("No filters could be read from the pipeline file '%1'").arg(getPipelineFile());
+    setErrorCondition(-11010);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+  FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+
+  // The output file is a copy of the input file whose cell arrays are updated one slab at a time. The slabs
+  // and their halos are always read from the unchanged input file.
+  notifyStatusMessage(getHumanLabel(), "Copying input file");
+  QFile::remove(getOutputFile());
+  if(!QFile::copy(getInputFile(), getOutputFile()))
+  {
+    QString ss = QObject::tr("Error copying '%1' to '%2'").arg(getInputFile()).arg(getOutputFile());
+    setErrorCondition(-11011);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+
+  H5SlabStreamer reader;
+  int err = reader.open(getInputFile(), getDataContainerName(), getCellAttributeMatrixName(), true);
+  ImageGeom::Pointer volume = (err < 0) ? ImageGeom::NullPointer() : reader.readGeometry();
+  if(nullptr == volume.get())
+  {
+    setErrorCondition(-11012);
+    notifyErrorMessage(getHumanLabel(), reader.getErrorMessage(), getErrorCondition());
+    return;
+  }
+
+  H5SlabStreamer writer;
+  err = writer.open(getOutputFile(), getDataContainerName(), getCellAttributeMatrixName(), false);
+  if(err < 0)
+  {
+    setErrorCondition(-11017);
+    notifyErrorMessage(getHumanLabel(), writer.getErrorMessage(), getErrorCondition());
+    return;
+  }
+
+  QVector<size_t> dims = reader.getDimensions();
+  float res[3] = {0.0f, 0.0f, 0.0f};
+  float origin[3] = {0.0f, 0.0f, 0.0f};
+  volume->getResolution(res);
+  volume->getOrigin(origin);
+
+  // Feature and Ensemble level data (e.g. CrystalStructures) is small and shared by every slab
+  QList<AttributeMatrix::Pointer> attrMats = reader.readAttributeMatrices();
+
+  size_t slabThickness = static_cast<size_t>(getSlabThickness());
+  size_t halo = static_cast<size_t>(getHaloThickness());
+  for(size_t zStart = 0; zStart < dims[2]; zStart += slabThickness)
+  {
+    if(getCancel())
+    {
+      return;
+    }
+
+    // Read the slab together with its halo planes, clipped at the ends of the volume
+    size_t numPlanes = std::min(slabThickness, dims[2] - zStart);
+    size_t readStart = (zStart > halo) ? zStart - halo : 0;
+    size_t readEnd = std::min(dims[2], zStart + numPlanes + halo);
+    size_t readPlanes = readEnd - readStart;
+
+    QString ss = QObject::tr("Z Planes %1 to %2 of %3").arg(zStart).arg(zStart + numPlanes - 1).arg(dims[2]);
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer m = DataContainer::New(getDataContainerName());
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(dims[0], dims[1], readPlanes);
+    image->setResolution(res);
+    image->setOrigin(origin[0], origin[1], origin[2] + static_cast<float>(readStart) * res[2]);
+    m->setGeometry(image);
+
+    QVector<size_t> tDims(3, 0);
+    tDims[0] = dims[0];
+    tDims[1] = dims[1];
+    tDims[2] = readPlanes;
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, getCellAttributeMatrixName(), AttributeMatrix::Type::Cell);
+    QStringList arrayNames = reader.getCellArrayNames();
+    for(QStringList::iterator iter = arrayNames.begin(); iter != arrayNames.end(); ++iter)
+    {
+      IDataArray::Pointer array = reader.readSlab(*iter, readStart, readPlanes);
+      if(nullptr == array.get())
+      {
+        setErrorCondition(-11013);
+        notifyErrorMessage(getHumanLabel(), reader.getErrorMessage(), getErrorCondition());
+        return;
+      }
+      cellAttrMat->addAttributeArray(array->getName(), array);
+    }
+    m->addAttributeMatrix(cellAttrMat->getName(), cellAttrMat);
+    for(QList<AttributeMatrix::Pointer>::iterator iter = attrMats.begin(); iter != attrMats.end(); ++iter)
+    {
+      m->addAttributeMatrix((*iter)->getName(), (*iter)->deepCopy());
+    }
+    dca->addDataContainer(m);
+
+    for(FilterPipeline::FilterContainerType::iterator iter = filters.begin(); iter != filters.end(); ++iter)
+    {
+      (*iter)->setDataContainerArray(dca);
+      (*iter)->execute();
+      if((*iter)->getErrorCondition() < 0)
+      {
+        ss = QObject::tr("'%1' failed with error %2 on Z planes %3 to %4").arg((*iter)->getHumanLabel()).arg((*iter)->getErrorCondition()).arg(readStart).arg(readEnd - 1);
+        setErrorCondition(-11014);
+        notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+        return;
+      }
+    }
+
+    // Only the planes owned by this slab are written back; the halo planes belong to the neighbors
+    cellAttrMat = m->getAttributeMatrix(getCellAttributeMatrixName());
+    if(nullptr == cellAttrMat.get() || cellAttrMat->getNumberOfTuples() != dims[0] * dims[1] * readPlanes)
+    {
+      ss = QObject::tr("The pipeline removed or resized the Cell Attribute Matrix '%1'").arg(getCellAttributeMatrixName());
+      setErrorCondition(-11015);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+    arrayNames = cellAttrMat->getAttributeArrayNames();
+    for(QStringList::iterator iter = arrayNames.begin(); iter != arrayNames.end(); ++iter)
+    {
+      err = writer.writeSlab(cellAttrMat->getAttributeArray(*iter), zStart - readStart, zStart, numPlanes);
+      if(err < 0)
+      {
+        setErrorCondition(-11016);
+        notifyErrorMessage(getHumanLabel(), writer.getErrorMessage(), getErrorCondition());
+        return;
+      }
+    }
+  }
+
+  notifyStatusMessage(getHumanLabel(), "Complete");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer SlabStreamingPipeline::newFilterInstance(bool copyFilterParameters)
+{
+  SlabStreamingPipeline::Pointer filter = SlabStreamingPipeline::New();
+  if(true == copyFilterParameters)
+  {
+    copyFilterParameterInstanceVariables(filter.get());
+  }
+  return filter;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString SlabStreamingPipeline::getCompiledLibraryName()
+{
+  return ProcessingConstants::ProcessingBaseName;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString SlabStreamingPipeline::getBrandingString()
+{
+  return "Processing";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString SlabStreamingPipeline::getFilterVersion()
+{
+  QString version;
+  QTextStream vStream(&version);
+  vStream << Processing::Version::Major() << "." << Processing::Version::Minor() << "." << Processing::Version::Patch();
+  return version;
+}
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString SlabStreamingPipeline::getGroupName()
+{
+  return SIMPL::FilterGroups::ProcessingFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString SlabStreamingPipeline::getSubGroupName()
+{
+  return SIMPL::FilterSubGroups::MemoryManagementFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString SlabStreamingPipeline::getHumanLabel()
+{
+  return "Execute Pipeline in Slabs (Out-of-Core)";
+}
@@ -0,0 +1,286 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _frontierdilation_hpp_
+#define _frontierdilation_hpp_
+
+#include <cstdint>
+#include <vector>
+
+#include <QtCore/QVector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/IDataArray.h"
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "Processing/ProcessingFilters/util/TupleRemap.hpp"
+#include "Processing/ProcessingFilters/util/VoxelNeighborhood.hpp"
+
+/**
+ * @brief The FrontierDilation class grows the voxels of a Cell Attribute Matrix into their neighbors, one
+ * layer per iteration, as done by the Fill Bad Data, Minimum Size and Erode/Dilate Bad Data filters. In every
+ * iteration each _target_ voxel that touches a _source_ voxel picks one of those neighbors and all of its
+ * cell arrays are copied from it. The Rule template argument decides which voxels are targets and sources
+ * and how the neighbor is picked:
+ *
+ * @code
+ * struct Rule
+ * {
+ *   static bool IsTarget(int32_t featureId);
+ *   static bool IsSource(int32_t featureId);
+ *   // true: the first neighbor whose Feature is seen more often than any Feature before it wins (majority vote)
+ *   // false: the source neighbor with the highest voxel index wins
+ *   static const bool k_MajorityVote = true;
+ * };
+ * @endcode
+ *
+ * The picks of an iteration are all made on the Feature Ids as they were at the start of the iteration and
+ * sources are never targets, so the voxels are independent of each other and the picks and the copies (see
+ * TupleRemap) are done in parallel. A target voxel can only start touching a source voxel when one of its
+ * neighbors changed in the previous iteration, so after a first full sweep only the target neighbors of the
+ * changed voxels (the frontier) are visited instead of the whole volume. The results are identical to sweeping every voxel in
+ * every iteration.
+ */
+template <typename Rule, int Connectivity = 6>
+class FrontierDilation
+{
+public:
+  /**
+   * @param neighborhood Neighborhood of the Image Geometry
+   * @param featureIds Feature Ids of the voxels. This array must also be one of the cellArrays.
+   * @param cellArrays Every array of the Cell Attribute Matrix, copied from the source to the target voxel
+   */
+  FrontierDilation(const VoxelNeighborhood<Connectivity>& neighborhood, int32_t* featureIds, size_t totalPoints, const QVector<IDataArray::Pointer>& cellArrays)
+  : m_Neighborhood(neighborhood)
+  , m_FeatureIds(featureIds)
+  , m_TotalPoints(totalPoints)
+  , m_CellArrays(cellArrays)
+  {
+  }
+
+  /**
+   * @brief Same as above, copying every array of the Cell Attribute Matrix cellAttrMat
+   */
+  FrontierDilation(const VoxelNeighborhood<Connectivity>& neighborhood, int32_t* featureIds, size_t totalPoints, AttributeMatrix::Pointer cellAttrMat)
+  : m_Neighborhood(neighborhood)
+  , m_FeatureIds(featureIds)
+  , m_TotalPoints(totalPoints)
+  , m_CellArrays(cellAttrMat)
+  {
+  }
+
+  virtual ~FrontierDilation()
+  {
+  }
+
+  /**
+   * @brief Picks the source neighbor of the target voxel at index, or returns -1 if it touches no source
+   */
+  static int64_t FindSource(const VoxelNeighborhood<Connectivity>& neighborhood, const int32_t* featureIds, int64_t index)
+  {
+    int32_t features[Connectivity];
+    int32_t numSources = 0;
+    int32_t most = 0;
+    int64_t source = -1;
+    neighborhood.forEachNeighbor(index, [&](int32_t, int64_t neighpoint) {
+      int32_t feature = featureIds[neighpoint];
+      if(!Rule::IsSource(feature))
+      {
+        return;
+      }
+      if(!Rule::k_MajorityVote)
+      {
+        source = neighpoint;
+        return;
+      }
+      features[numSources] = feature;
+      numSources++;
+      int32_t current = 0;
+      for(int32_t n = 0; n < numSources; n++)
+      {
+        if(features[n] == feature)
+        {
+          current++;
+        }
+      }
+      if(current > most)
+      {
+        most = current;
+        source = neighpoint;
+      }
+    });
+    return source;
+  }
+
+  /**
+   * @brief Runs at most maxIterations iterations, or until no voxel changes any more if maxIterations is
+   * negative. Target voxels that can never be reached from a source voxel are left unchanged.
+   * @return The number of voxels that were changed
+   */
+  size_t run(int32_t maxIterations)
+  {
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+#endif
+
+    std::vector<int64_t> frontier;
+    for(size_t i = 0; i < m_TotalPoints; i++)
+    {
+      if(Rule::IsTarget(m_FeatureIds[i]))
+      {
+        frontier.push_back(static_cast<int64_t>(i));
+      }
+    }
+
+    std::vector<int64_t> sources;
+    std::vector<int64_t> changedTargets;
+    std::vector<int64_t> changedSources;
+    std::vector<uint8_t> queued(m_TotalPoints, 0);
+    size_t numChanged = 0;
+
+    for(int32_t iteration = 0; (maxIterations < 0 || iteration < maxIterations) && !frontier.empty(); iteration++)
+    {
+      sources.resize(frontier.size());
+      VoteImpl voteImpl(m_Neighborhood, m_FeatureIds, frontier.data(), sources.data());
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      if(doParallel == true)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, frontier.size(), k_GrainSize), voteImpl, tbb::simple_partitioner());
+      }
+      else
+#endif
+      {
+        voteImpl.convert(0, frontier.size());
+      }
+
+      changedTargets.clear();
+      changedSources.clear();
+      for(size_t c = 0; c < frontier.size(); c++)
+      {
+        if(sources[c] >= 0)
+        {
+          changedTargets.push_back(frontier[c]);
+          changedSources.push_back(sources[c]);
+        }
+      }
+      if(changedTargets.empty())
+      {
+        break;
+      }
+      numChanged += changedTargets.size();
+
+      m_CellArrays.copyTuples(changedSources, changedTargets);
+
+      // The next frontier is every target voxel next to a voxel that just changed
+      frontier.clear();
+      for(size_t c = 0; c < changedTargets.size(); c++)
+      {
+        m_Neighborhood.forEachNeighbor(changedTargets[c], [&](int32_t, int64_t neighpoint) {
+          if(queued[neighpoint] == 0 && Rule::IsTarget(m_FeatureIds[neighpoint]))
+          {
+            queued[neighpoint] = 1;
+            frontier.push_back(neighpoint);
+          }
+        });
+      }
+      for(size_t c = 0; c < frontier.size(); c++)
+      {
+        queued[frontier[c]] = 0;
+      }
+    }
+
+    return numChanged;
+  }
+
+protected:
+  static const size_t k_GrainSize = 4096;
+
+  /**
+   * @brief Picks the source neighbor of a range of frontier voxels
+   */
+  class VoteImpl
+  {
+    const VoxelNeighborhood<Connectivity>& m_Neighborhood;
+    const int32_t* m_FeatureIds;
+    const int64_t* m_Frontier;
+    int64_t* m_Sources;
+
+  public:
+    VoteImpl(const VoxelNeighborhood<Connectivity>& neighborhood, const int32_t* featureIds, const int64_t* frontier, int64_t* sources)
+    : m_Neighborhood(neighborhood)
+    , m_FeatureIds(featureIds)
+    , m_Frontier(frontier)
+    , m_Sources(sources)
+    {
+    }
+    virtual ~VoteImpl()
+    {
+    }
+
+    void convert(size_t start, size_t end) const
+    {
+      for(size_t c = start; c < end; c++)
+      {
+        m_Sources[c] = FindSource(m_Neighborhood, m_FeatureIds, m_Frontier[c]);
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+  };
+
+private:
+  const VoxelNeighborhood<Connectivity>& m_Neighborhood;
+  int32_t* m_FeatureIds;
+  size_t m_TotalPoints;
+  TupleRemap m_CellArrays;
+
+  FrontierDilation(const FrontierDilation&); // Copy Constructor Not Implemented
+  void operator=(const FrontierDilation&);   // Operator '=' Not Implemented
+};
+
+#endif /* _frontierdilation_hpp_ */
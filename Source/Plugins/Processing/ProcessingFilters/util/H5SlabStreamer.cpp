@@ -0,0 +1,587 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "H5SlabStreamer.h"
+
+#include "H5Support/H5Utilities.h"
+#include "H5Support/QH5Lite.h"
+#include "H5Support/QH5Utilities.h"
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+
+namespace
+{
+const QString k_DataArrayPrefix("DataArray<");
+
+/**
+ * @brief Returns the primitive type name of a DataArray from its HDF5 ObjectType attribute
+ * or an empty string if the object is not a plain DataArray
+ */
+QString PrimitiveTypeFromObjectType(const QString& objectType)
+{
+  if(!objectType.startsWith(k_DataArrayPrefix) || !objectType.endsWith(">"))
+  {
+    return QString();
+  }
+  return objectType.mid(k_DataArrayPrefix.size(), objectType.size() - k_DataArrayPrefix.size() - 1);
+}
+
+/**
+ * @brief Returns the native HDF5 type that matches the in memory layout of a DataArray
+ */
+hid_t NativeTypeForPrimitive(const QString& type)
+{
+  if(type == "int8_t")
+  {
+    return H5T_NATIVE_INT8;
+  }
+  if(type == "uint8_t" || type == "bool")
+  {
+    return H5T_NATIVE_UINT8;
+  }
+  if(type == "int16_t")
+  {
+    return H5T_NATIVE_INT16;
+  }
+  if(type == "uint16_t")
+  {
+    return H5T_NATIVE_UINT16;
+  }
+  if(type == "int32_t")
+  {
+    return H5T_NATIVE_INT32;
+  }
+  if(type == "uint32_t")
+  {
+    return H5T_NATIVE_UINT32;
+  }
+  if(type == "int64_t")
+  {
+    return H5T_NATIVE_INT64;
+  }
+  if(type == "uint64_t")
+  {
+    return H5T_NATIVE_UINT64;
+  }
+  if(type == "float")
+  {
+    return H5T_NATIVE_FLOAT;
+  }
+  if(type == "double")
+  {
+    return H5T_NATIVE_DOUBLE;
+  }
+  return -1;
+}
+
+/**
+ * @brief Allocates a DataArray of the given primitive type
+ */
+IDataArray::Pointer CreateArray(const QString& type, const QVector<size_t>& tDims, const QVector<size_t>& cDims, const QString& name)
+{
+  IDataArray::Pointer array = IDataArray::NullPointer();
+  if(type == "int8_t")
+  {
+    array = Int8ArrayType::CreateArray(tDims, cDims, name, true);
+  }
+  else if(type == "uint8_t")
+  {
+    array = UInt8ArrayType::CreateArray(tDims, cDims, name, true);
+  }
+  else if(type == "int16_t")
+  {
+    array = Int16ArrayType::CreateArray(tDims, cDims, name, true);
+  }
+  else if(type == "uint16_t")
+  {
+    array = UInt16ArrayType::CreateArray(tDims, cDims, name, true);
+  }
+  else if(type == "int32_t")
+  {
+    array = Int32ArrayType::CreateArray(tDims, cDims, name, true);
+  }
+  else if(type == "uint32_t")
+  {
+    array = UInt32ArrayType::CreateArray(tDims, cDims, name, true);
+  }
+  else if(type == "int64_t")
+  {
+    array = Int64ArrayType::CreateArray(tDims, cDims, name, true);
+  }
+  else if(type == "uint64_t")
+  {
+    array = UInt64ArrayType::CreateArray(tDims, cDims, name, true);
+  }
+  else if(type == "float")
+  {
+    array = FloatArrayType::CreateArray(tDims, cDims, name, true);
+  }
+  else if(type == "double")
+  {
+    array = DoubleArrayType::CreateArray(tDims, cDims, name, true);
+  }
+  else if(type == "bool")
+  {
+    array = BoolArrayType::CreateArray(tDims, cDims, name, true);
+  }
+  return array;
+}
+
+/**
+ * @brief Reads the ObjectType and ComponentDimensions attributes of a DataArray dataset
+ * @return The primitive type name or an empty string if the dataset is not a DataArray
+ */
+QString ReadArrayMetaData(hid_t gid, const QString& name, QVector<size_t>& cDims)
+{
+  QString objectType;
+  if(QH5Lite::readStringAttribute(gid, name, SIMPL::HDF5::ObjectType, objectType) < 0)
+  {
+    return QString();
+  }
+  QVector<hsize_t> dims;
+  if(QH5Lite::readVectorAttribute(gid, name, SIMPL::HDF5::ComponentDimensions, dims) < 0 || dims.isEmpty())
+  {
+    return QString();
+  }
+  cDims.resize(dims.size());
+  for(int32_t i = 0; i < dims.size(); i++)
+  {
+    cDims[i] = static_cast<size_t>(dims[i]);
+  }
+  return PrimitiveTypeFromObjectType(objectType);
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5SlabStreamer::H5SlabStreamer()
+: m_FileId(-1)
+, m_DcGid(-1)
+, m_AmGid(-1)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5SlabStreamer::~H5SlabStreamer()
+{
+  close();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5SlabStreamer::open(const QString& filePath, const QString& dataContainerName, const QString& cellAttributeMatrixName, bool readOnly)
+{
+  close();
+  m_CellAttributeMatrixName = cellAttributeMatrixName;
+
+  m_FileId = QH5Utilities::openFile(filePath, readOnly);
+  if(m_FileId < 0)
+  {
+    m_ErrorMessage = readOnly ? QObject::tr("Error opening file '%1' for reading").arg(filePath) : QObject::tr("Error opening file '%1' for reading and writing").arg(filePath);
+    return -1;
+  }
+
+  QString dcPath = SIMPL::StringConstants::DataContainerGroupName + "/" + dataContainerName;
+  m_DcGid = H5Gopen(m_FileId, dcPath.toLatin1().data(), H5P_DEFAULT);
+  if(m_DcGid < 0)
+  {
+    m_ErrorMessage = QObject::tr("Data Container '%1' was not found in file '%2'").arg(dataContainerName).arg(filePath);
+    return -2;
+  }
+
+  m_AmGid = H5Gopen(m_DcGid, cellAttributeMatrixName.toLatin1().data(), H5P_DEFAULT);
+  if(m_AmGid < 0)
+  {
+    m_ErrorMessage = QObject::tr("Attribute Matrix '%1' was not found in Data Container '%2'").arg(cellAttributeMatrixName).arg(dataContainerName);
+    return -3;
+  }
+
+  QVector<hsize_t> tDims;
+  if(QH5Lite::readVectorAttribute(m_DcGid, cellAttributeMatrixName, SIMPL::HDF5::TupleDimensions, tDims) < 0 || tDims.size() != 3)
+  {
+    m_ErrorMessage = QObject::tr("Attribute Matrix '%1' does not have 3 dimensional tuple dimensions").arg(cellAttributeMatrixName);
+    return -4;
+  }
+  m_Dims.resize(3);
+  for(int32_t i = 0; i < 3; i++)
+  {
+    m_Dims[i] = static_cast<size_t>(tDims[i]);
+  }
+
+  QList<QString> names;
+  QH5Utilities::getGroupObjects(m_AmGid, H5Utilities::H5Support_DATASET, names);
+  for(QList<QString>::iterator iter = names.begin(); iter != names.end(); ++iter)
+  {
+    QVector<size_t> cDims;
+    if(!ReadArrayMetaData(m_AmGid, *iter, cDims).isEmpty())
+    {
+      m_CellArrayNames.push_back(*iter);
+    }
+  }
+
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void H5SlabStreamer::close()
+{
+  if(m_AmGid >= 0)
+  {
+    H5Gclose(m_AmGid);
+    m_AmGid = -1;
+  }
+  if(m_DcGid >= 0)
+  {
+    H5Gclose(m_DcGid);
+    m_DcGid = -1;
+  }
+  if(m_FileId >= 0)
+  {
+    QH5Utilities::closeFile(m_FileId);
+    m_FileId = -1;
+  }
+  m_Dims.clear();
+  m_CellArrayNames.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString H5SlabStreamer::getErrorMessage() const
+{
+  return m_ErrorMessage;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<size_t> H5SlabStreamer::getDimensions() const
+{
+  return m_Dims;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList H5SlabStreamer::getCellArrayNames() const
+{
+  return m_CellArrayNames;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ImageGeom::Pointer H5SlabStreamer::readGeometry()
+{
+  hid_t geomGid = H5Gopen(m_DcGid, SIMPL::Geometry::Geometry.toLatin1().data(), H5P_DEFAULT);
+  if(geomGid < 0)
+  {
+    m_ErrorMessage = QObject::tr("The Data Container does not have a Geometry");
+    return ImageGeom::NullPointer();
+  }
+
+  QString geomType;
+  QH5Lite::readStringAttribute(m_DcGid, SIMPL::Geometry::Geometry, SIMPL::Geometry::GeometryTypeName, geomType);
+  ImageGeom::Pointer image = ImageGeom::New();
+  int err = -1;
+  if(geomType == SIMPL::Geometry::ImageGeometry)
+  {
+    err = image->readGeometryFromHDF5(geomGid, false);
+  }
+  H5Gclose(geomGid);
+  if(err < 0)
+  {
+    m_ErrorMessage = QObject::tr("The Data Container does not have an Image Geometry");
+    return ImageGeom::NullPointer();
+  }
+  return image;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QList<AttributeMatrix::Pointer> H5SlabStreamer::readAttributeMatrices()
+{
+  QList<AttributeMatrix::Pointer> attrMats;
+
+  QList<QString> amNames;
+  QH5Utilities::getGroupObjects(m_DcGid, H5Utilities::H5Support_GROUP, amNames);
+  for(QList<QString>::iterator amIter = amNames.begin(); amIter != amNames.end(); ++amIter)
+  {
+    if(*amIter == m_CellAttributeMatrixName || *amIter == SIMPL::Geometry::Geometry)
+    {
+      continue;
+    }
+    uint32_t amType = 0;
+    QVector<hsize_t> hTupleDims;
+    if(QH5Lite::readScalarAttribute(m_DcGid, *amIter, SIMPL::StringConstants::AttributeMatrixType, amType) < 0 ||
+       QH5Lite::readVectorAttribute(m_DcGid, *amIter, SIMPL::HDF5::TupleDimensions, hTupleDims) < 0)
+    {
+      continue;
+    }
+    QVector<size_t> tDims(hTupleDims.size(), 0);
+    for(int32_t i = 0; i < hTupleDims.size(); i++)
+    {
+      tDims[i] = static_cast<size_t>(hTupleDims[i]);
+    }
+    AttributeMatrix::Pointer attrMat = AttributeMatrix::New(tDims, *amIter, static_cast<AttributeMatrix::Type>(amType));
+
+    hid_t amGid = H5Gopen(m_DcGid, amIter->toLatin1().data(), H5P_DEFAULT);
+    if(amGid < 0)
+    {
+      continue;
+    }
+    QList<QString> names;
+    QH5Utilities::getGroupObjects(amGid, H5Utilities::H5Support_DATASET, names);
+    for(QList<QString>::iterator iter = names.begin(); iter != names.end(); ++iter)
+    {
+      // Only plain DataArrays are supplied; NeighborLists, strings and statistics are skipped
+      QVector<size_t> cDims;
+      QString type = ReadArrayMetaData(amGid, *iter, cDims);
+      IDataArray::Pointer array = CreateArray(type, tDims, cDims, *iter);
+      if(nullptr == array.get())
+      {
+        continue;
+      }
+      hid_t did = H5Dopen(amGid, iter->toLatin1().data(), H5P_DEFAULT);
+      if(did < 0)
+      {
+        continue;
+      }
+      herr_t err = H5Dread(did, NativeTypeForPrimitive(type), H5S_ALL, H5S_ALL, H5P_DEFAULT, array->getVoidPointer(0));
+      H5Dclose(did);
+      if(err >= 0)
+      {
+        attrMat->addAttributeArray(array->getName(), array);
+      }
+    }
+    H5Gclose(amGid);
+    attrMats.push_back(attrMat);
+  }
+
+  return attrMats;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5SlabStreamer::selectPlanes(hid_t dataSpace, size_t zStart, size_t numPlanes, QVector<hsize_t>& count)
+{
+  int32_t rank = H5Sget_simple_extent_ndims(dataSpace);
+  if(rank < 1)
+  {
+    return -1;
+  }
+  QVector<hsize_t> dims(rank, 0);
+  H5Sget_simple_extent_dims(dataSpace, dims.data(), nullptr);
+
+  QVector<hsize_t> start(rank, 0);
+  count = dims;
+  hsize_t planeSize = static_cast<hsize_t>(m_Dims[0] * m_Dims[1]);
+  if(rank >= 3 && dims[0] == m_Dims[2] && dims[1] == m_Dims[1] && dims[2] == m_Dims[0])
+  {
+    // [Z][Y][X][Comp] layout written by the DataContainerWriter
+    start[0] = zStart;
+    count[0] = numPlanes;
+  }
+  else if(dims[0] == planeSize * m_Dims[2])
+  {
+    // Flat [Tuple][Comp] layout written by older versions
+    start[0] = zStart * planeSize;
+    count[0] = numPlanes * planeSize;
+  }
+  else
+  {
+    return -1;
+  }
+  return H5Sselect_hyperslab(dataSpace, H5S_SELECT_SET, start.data(), nullptr, count.data(), nullptr);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IDataArray::Pointer H5SlabStreamer::readSlab(const QString& arrayName, size_t zStart, size_t numPlanes)
+{
+  QVector<size_t> cDims;
+  QString type = ReadArrayMetaData(m_AmGid, arrayName, cDims);
+  QVector<size_t> tDims(3, 0);
+  tDims[0] = m_Dims[0];
+  tDims[1] = m_Dims[1];
+  tDims[2] = numPlanes;
+  IDataArray::Pointer array = CreateArray(type, tDims, cDims, arrayName);
+  if(nullptr == array.get())
+  {
+    m_ErrorMessage = QObject::tr("Cell array '%1' is not a DataArray that can be streamed").arg(arrayName);
+    return IDataArray::NullPointer();
+  }
+
+  hid_t did = H5Dopen(m_AmGid, arrayName.toLatin1().data(), H5P_DEFAULT);
+  if(did < 0)
+  {
+    m_ErrorMessage = QObject::tr("Error opening dataset '%1'").arg(arrayName);
+    return IDataArray::NullPointer();
+  }
+  hid_t fileSpace = H5Dget_space(did);
+  QVector<hsize_t> count;
+  herr_t err = selectPlanes(fileSpace, zStart, numPlanes, count);
+  if(err >= 0)
+  {
+    hid_t memSpace = H5Screate_simple(count.size(), count.data(), nullptr);
+    err = H5Dread(did, NativeTypeForPrimitive(type), memSpace, fileSpace, H5P_DEFAULT, array->getVoidPointer(0));
+    H5Sclose(memSpace);
+  }
+  H5Sclose(fileSpace);
+  H5Dclose(did);
+
+  if(err < 0)
+  {
+    m_ErrorMessage = QObject::tr("Error reading Z planes %1 to %2 of dataset '%3'").arg(zStart).arg(zStart + numPlanes - 1).arg(arrayName);
+    return IDataArray::NullPointer();
+  }
+  return array;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5SlabStreamer::createDataset(IDataArray::Pointer array)
+{
+  QString type = array->getTypeAsString();
+  hid_t dataType = NativeTypeForPrimitive(type);
+  if(dataType < 0)
+  {
+    m_ErrorMessage = QObject::tr("Cell array '%1' is not a DataArray that can be streamed").arg(array->getName());
+    return -1;
+  }
+
+  QVector<size_t> cDims = array->getComponentDimensions();
+  QVector<hsize_t> dims(3 + cDims.size(), 0);
+  dims[0] = m_Dims[2];
+  dims[1] = m_Dims[1];
+  dims[2] = m_Dims[0];
+  for(int32_t i = 0; i < cDims.size(); i++)
+  {
+    dims[3 + i] = cDims[i];
+  }
+
+  hid_t dataSpace = H5Screate_simple(dims.size(), dims.data(), nullptr);
+  hid_t did = H5Dcreate(m_AmGid, array->getName().toLatin1().data(), dataType, dataSpace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  H5Sclose(dataSpace);
+  if(did < 0)
+  {
+    m_ErrorMessage = QObject::tr("Error creating dataset '%1'").arg(array->getName());
+    return -1;
+  }
+  H5Dclose(did);
+
+  // Write the same meta data that DataArray::writeH5Data() writes so the file can be read normally
+  QVector<hsize_t> hcDims(cDims.size(), 0);
+  for(int32_t i = 0; i < cDims.size(); i++)
+  {
+    hcDims[i] = static_cast<hsize_t>(cDims[i]);
+  }
+  QVector<hsize_t> htDims(3, 0);
+  for(int32_t i = 0; i < 3; i++)
+  {
+    htDims[i] = static_cast<hsize_t>(m_Dims[i]);
+  }
+  hsize_t rank = static_cast<hsize_t>(hcDims.size());
+  int32_t version = 2;
+  herr_t err = QH5Lite::writeStringAttribute(m_AmGid, array->getName(), SIMPL::HDF5::ObjectType, "DataArray<" + type + ">");
+  err |= QH5Lite::writePointerAttribute(m_AmGid, array->getName(), SIMPL::HDF5::ComponentDimensions, 1, &rank, hcDims.data());
+  rank = 3;
+  err |= QH5Lite::writePointerAttribute(m_AmGid, array->getName(), SIMPL::HDF5::TupleDimensions, 1, &rank, htDims.data());
+  err |= QH5Lite::writeScalarAttribute(m_AmGid, array->getName(), SIMPL::HDF5::DataArrayVersion, version);
+  if(err < 0)
+  {
+    m_ErrorMessage = QObject::tr("Error writing the attributes of dataset '%1'").arg(array->getName());
+    return -1;
+  }
+  m_CellArrayNames.push_back(array->getName());
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5SlabStreamer::writeSlab(IDataArray::Pointer array, size_t srcPlane, size_t zStart, size_t numPlanes)
+{
+  if(!m_CellArrayNames.contains(array->getName()))
+  {
+    if(QH5Lite::datasetExists(m_AmGid, array->getName()))
+    {
+      m_ErrorMessage = QObject::tr("Cell array '%1' exists in the file but is not a DataArray that can be streamed").arg(array->getName());
+      return -1;
+    }
+    if(createDataset(array) < 0)
+    {
+      return -1;
+    }
+  }
+
+  hid_t dataType = NativeTypeForPrimitive(array->getTypeAsString());
+  hid_t did = H5Dopen(m_AmGid, array->getName().toLatin1().data(), H5P_DEFAULT);
+  if(did < 0 || dataType < 0)
+  {
+    m_ErrorMessage = QObject::tr("Error opening dataset '%1'").arg(array->getName());
+    return -1;
+  }
+  hid_t fileSpace = H5Dget_space(did);
+  QVector<hsize_t> count;
+  herr_t err = selectPlanes(fileSpace, zStart, numPlanes, count);
+  if(err >= 0)
+  {
+    size_t offset = srcPlane * m_Dims[0] * m_Dims[1] * static_cast<size_t>(array->getNumberOfComponents());
+    hid_t memSpace = H5Screate_simple(count.size(), count.data(), nullptr);
+    err = H5Dwrite(did, dataType, memSpace, fileSpace, H5P_DEFAULT, array->getVoidPointer(offset));
+    H5Sclose(memSpace);
+  }
+  H5Sclose(fileSpace);
+  H5Dclose(did);
+
+  if(err < 0)
+  {
+    m_ErrorMessage = QObject::tr("Error writing Z planes %1 to %2 of dataset '%3'").arg(zStart).arg(zStart + numPlanes - 1).arg(array->getName());
+    return -1;
+  }
+  return 0;
+}
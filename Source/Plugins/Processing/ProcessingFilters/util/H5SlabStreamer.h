@@ -0,0 +1,137 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _h5slabstreamer_h_
+#define _h5slabstreamer_h_
+
+#include <hdf5.h>
+
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+/**
+ * @brief The H5SlabStreamer class gives Z slab access to the cell arrays of an Image
+ * Geometry that is stored in a .dream3d file. The cell arrays are stored as [Z][Y][X][Comp]
+ * datasets so a range of Z planes is a single contiguous hyperslab that can be read into,
+ * or written from, a DataArray without ever loading the whole volume. Feature and Ensemble
+ * level Attribute Matrices are small and are read whole.
+ */
+class H5SlabStreamer
+{
+  public:
+    H5SlabStreamer();
+    virtual ~H5SlabStreamer();
+
+    /**
+     * @brief open Opens the file and reads the meta data of the given cell Attribute Matrix
+     * @param filePath The .dream3d file
+     * @param dataContainerName Data Container holding an Image Geometry
+     * @param cellAttributeMatrixName Cell Attribute Matrix that will be streamed
+     * @param readOnly Opens the file for reading only, in which case writeSlab() fails
+     * @return Negative value on error
+     */
+    int open(const QString& filePath, const QString& dataContainerName, const QString& cellAttributeMatrixName, bool readOnly);
+
+    /**
+     * @brief close Closes the file. This is also done by the destructor.
+     */
+    void close();
+
+    /**
+     * @brief getErrorMessage Returns a description of the last error
+     */
+    QString getErrorMessage() const;
+
+    /**
+     * @brief getDimensions Returns the X, Y, Z dimensions of the cell Attribute Matrix
+     */
+    QVector<size_t> getDimensions() const;
+
+    /**
+     * @brief getCellArrayNames Returns the names of the DataArray objects in the cell
+     * Attribute Matrix that can be streamed
+     */
+    QStringList getCellArrayNames() const;
+
+    /**
+     * @brief readGeometry Reads the complete Image Geometry of the Data Container
+     */
+    ImageGeom::Pointer readGeometry();
+
+    /**
+     * @brief readAttributeMatrices Reads every Attribute Matrix of the Data Container
+     * except the cell Attribute Matrix
+     */
+    QList<AttributeMatrix::Pointer> readAttributeMatrices();
+
+    /**
+     * @brief readSlab Reads the Z planes [zStart, zStart + numPlanes) of a cell array
+     * @return The slab or a null pointer on error
+     */
+    IDataArray::Pointer readSlab(const QString& arrayName, size_t zStart, size_t numPlanes);
+
+    /**
+     * @brief writeSlab Writes numPlanes Z planes of array, starting at plane srcPlane of
+     * array, into the file at plane zStart. A full volume dataset is created for arrays that
+     * are not in the file yet.
+     * @return Negative value on error
+     */
+    int writeSlab(IDataArray::Pointer array, size_t srcPlane, size_t zStart, size_t numPlanes);
+
+  protected:
+    int selectPlanes(hid_t dataSpace, size_t zStart, size_t numPlanes, QVector<hsize_t>& count);
+    int createDataset(IDataArray::Pointer array);
+
+  private:
+    hid_t m_FileId;
+    hid_t m_DcGid;
+    hid_t m_AmGid;
+    QString m_ErrorMessage;
+    QVector<size_t> m_Dims;
+    QStringList m_CellArrayNames;
+    QString m_CellAttributeMatrixName;
+
+    H5SlabStreamer(const H5SlabStreamer&); // Copy Constructor Not Implemented
+    void operator=(const H5SlabStreamer&); // Operator '=' Not Implemented
+};
+
+#endif /* _h5slabstreamer_h_ */
@@ -0,0 +1,248 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <QtCore/QCoreApplication>
+
+#include <map>
+#include <vector>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "Processing/ProcessingFilters/util/FrontierDilation.hpp"
+#include "Processing/ProcessingFilters/util/VoxelNeighborhood.hpp"
+
+namespace FrontierDilationTestDetail
+{
+struct MajorityRule
+{
+  static bool IsTarget(int32_t featureId)
+  {
+    return featureId < 0;
+  }
+  static bool IsSource(int32_t featureId)
+  {
+    return featureId > 0;
+  }
+  static const bool k_MajorityVote = true;
+};
+
+struct HighestIndexRule
+{
+  static bool IsTarget(int32_t featureId)
+  {
+    return featureId > 0;
+  }
+  static bool IsSource(int32_t featureId)
+  {
+    return featureId == 0;
+  }
+  static const bool k_MajorityVote = false;
+};
+}
+
+class FrontierDilationTest
+{
+public:
+  FrontierDilationTest()
+  {
+  }
+  virtual ~FrontierDilationTest()
+  {
+  }
+  SIMPL_TYPE_MACRO(FrontierDilationTest)
+
+  // -----------------------------------------------------------------------------
+  // Grows the sources into the targets by sweeping every voxel in every iteration, which is what the
+  // filters did before the frontier was introduced
+  // -----------------------------------------------------------------------------
+  template <typename Rule>
+  void SweepAll(const VoxelNeighborhood<6>& neighborhood, std::vector<int32_t>& featureIds, std::vector<float>& values, int32_t maxIterations)
+  {
+    for(int32_t iteration = 0; iteration != maxIterations; iteration++)
+    {
+      std::vector<int64_t> sources(featureIds.size(), -1);
+      neighborhood.forEachVoxel([&](int64_t index, int64_t x, int64_t y, int64_t z, bool interior) {
+        if(!Rule::IsTarget(featureIds[index]))
+        {
+          return;
+        }
+        std::map<int32_t, int32_t> counts;
+        int32_t most = 0;
+        neighborhood.forEachNeighbor(index, x, y, z, interior, [&](int32_t, int64_t neighbor) {
+          int32_t feature = featureIds[neighbor];
+          if(Rule::IsSource(feature) && (!Rule::k_MajorityVote || ++counts[feature] > most))
+          {
+            most = counts[feature];
+            sources[index] = neighbor;
+          }
+        });
+      });
+
+      bool changed = false;
+      std::vector<int32_t> newIds = featureIds;
+      for(size_t i = 0; i < sources.size(); i++)
+      {
+        if(sources[i] >= 0)
+        {
+          newIds[i] = featureIds[sources[i]];
+          values[i] = values[sources[i]];
+          changed = true;
+        }
+      }
+      featureIds = newIds;
+      if(!changed)
+      {
+        break;
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename Rule>
+  int CheckRule(int32_t targetValue, int32_t maxIterations)
+  {
+    int64_t dims[3] = {7, 5, 6};
+    size_t totalPoints = dims[0] * dims[1] * dims[2];
+    VoxelNeighborhood<6> neighborhood(dims);
+
+    for(uint32_t seed = 0; seed < 50; seed++)
+    {
+      QVector<size_t> tDims(1, totalPoints);
+      QVector<size_t> cDims(1, 1);
+      Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(tDims, cDims, "FeatureIds");
+      FloatArrayType::Pointer values = FloatArrayType::CreateArray(tDims, cDims, "Values");
+      std::vector<int32_t> expectedIds(totalPoints, 0);
+      std::vector<float> expectedValues(totalPoints, 0.0f);
+
+      // Simple linear congruential generator so the volumes are the same on every platform
+      uint32_t state = seed * 2654435761u + 1;
+      for(size_t i = 0; i < totalPoints; i++)
+      {
+        state = state * 1664525u + 1013904223u;
+        int32_t feature = static_cast<int32_t>((state >> 16) % 5);
+        if(((state >> 8) % 100) < seed * 2)
+        {
+          feature = targetValue;
+        }
+        featureIds->setValue(i, feature);
+        values->setValue(i, static_cast<float>(i));
+        expectedIds[i] = feature;
+        expectedValues[i] = static_cast<float>(i);
+      }
+
+      SweepAll<Rule>(neighborhood, expectedIds, expectedValues, maxIterations);
+
+      QVector<IDataArray::Pointer> cellArrays;
+      cellArrays.push_back(featureIds);
+      cellArrays.push_back(values);
+      FrontierDilation<Rule> dilation(neighborhood, featureIds->getPointer(0), totalPoints, cellArrays);
+      dilation.run(maxIterations);
+
+      for(size_t i = 0; i < totalPoints; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(featureIds->getValue(i), expectedIds[i])
+        DREAM3D_REQUIRE_EQUAL(values->getValue(i), expectedValues[i])
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestMajorityVote()
+  {
+    DREAM3D_REQUIRE_EQUAL(CheckRule<FrontierDilationTestDetail::MajorityRule>(-1, -1), EXIT_SUCCESS)
+    DREAM3D_REQUIRE_EQUAL(CheckRule<FrontierDilationTestDetail::MajorityRule>(-1, 2), EXIT_SUCCESS)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestHighestIndex()
+  {
+    DREAM3D_REQUIRE_EQUAL(CheckRule<FrontierDilationTestDetail::HighestIndexRule>(0, 1), EXIT_SUCCESS)
+    DREAM3D_REQUIRE_EQUAL(CheckRule<FrontierDilationTestDetail::HighestIndexRule>(0, 3), EXIT_SUCCESS)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Targets that are not connected to any source are left alone instead of looping forever
+  // -----------------------------------------------------------------------------
+  int TestUnreachableTargets()
+  {
+    int64_t dims[3] = {4, 4, 1};
+    VoxelNeighborhood<6> neighborhood(dims);
+    QVector<size_t> tDims(1, 16);
+    QVector<size_t> cDims(1, 1);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(tDims, cDims, "FeatureIds");
+    featureIds->initializeWithValue(-1);
+    featureIds->setValue(0, 0);
+
+    QVector<IDataArray::Pointer> cellArrays;
+    cellArrays.push_back(featureIds);
+    FrontierDilation<FrontierDilationTestDetail::MajorityRule> dilation(neighborhood, featureIds->getPointer(0), 16, cellArrays);
+    DREAM3D_REQUIRE_EQUAL(dilation.run(-1), 0)
+    for(size_t i = 1; i < 16; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(featureIds->getValue(i), -1)
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "#### FrontierDilationTest Starting ####" << std::endl;
+
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestMajorityVote())
+    DREAM3D_REGISTER_TEST(TestHighestIndex())
+    DREAM3D_REGISTER_TEST(TestUnreachableTargets())
+  }
+
+private:
+  FrontierDilationTest(const FrontierDilationTest&); // Copy Constructor Not Implemented
+  void operator=(const FrontierDilationTest&);       // Operator '=' Not Implemented
+};
@@ -0,0 +1,288 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/CoreFilters/DataContainerReader.h"
+#include "SIMPLib/CoreFilters/DataContainerWriter.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/FilterParameters/JsonFilterParametersWriter.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "ProcessingTestFileLocations.h"
+
+namespace SlabStreamingPipelineTestConsts
+{
+const QString k_InputFile = UnitTest::TestTempDir + "/SlabStreamingPipelineTest_Input.dream3d";
+const QString k_OutputFile = UnitTest::TestTempDir + "/SlabStreamingPipelineTest_Output.dream3d";
+const QString k_PipelineFile = UnitTest::TestTempDir + "/SlabStreamingPipelineTest_Pipeline.json";
+const size_t k_Dims[3] = {17, 13, 29};
+}
+
+class SlabStreamingPipelineTest
+{
+public:
+  SlabStreamingPipelineTest()
+  {
+  }
+  virtual ~SlabStreamingPipelineTest()
+  {
+  }
+  SIMPL_TYPE_MACRO(SlabStreamingPipelineTest)
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(SlabStreamingPipelineTestConsts::k_InputFile);
+    QFile::remove(SlabStreamingPipelineTestConsts::k_OutputFile);
+    QFile::remove(SlabStreamingPipelineTestConsts::k_PipelineFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the SlabStreamingPipeline Filter from the FilterManager
+    QString filtName = "SlabStreamingPipeline";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The SlabStreamingPipelineTest requires the use of the " << filtName.toStdString() << " filter which is found in the Processing Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateTestData()
+  {
+    const size_t* dims = SlabStreamingPipelineTestConsts::k_Dims;
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer m = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addDataContainer(m);
+
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(dims[0], dims[1], dims[2]);
+    m->setGeometry(image);
+
+    QVector<size_t> tDims(3, 0);
+    tDims[0] = dims[0];
+    tDims[1] = dims[1];
+    tDims[2] = dims[2];
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    m->addAttributeMatrix(cellAttrMat->getName(), cellAttrMat);
+
+    // Scattered seeds that grow into blobs spanning several Z planes when they are dilated
+    size_t numCells = dims[0] * dims[1] * dims[2];
+    BoolArrayType::Pointer mask = BoolArrayType::CreateArray(numCells, SIMPL::CellData::Mask, true);
+    for(size_t i = 0; i < numCells; i++)
+    {
+      mask->setValue(i, (i * 2654435761u) % 97 < 4);
+    }
+    cellAttrMat->addAttributeArray(mask->getName(), mask);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer CreateErodeDilateMask(uint32_t direction, int32_t numIterations)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter("ErodeDilateMask");
+    DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get())
+    AbstractFilter::Pointer filter = filterFactory->create();
+
+    bool ok = filter->setProperty("Direction", direction);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+    ok = filter->setProperty("NumIterations", numIterations);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  FilterPipeline::Pointer CreatePipeline()
+  {
+    // Dilating twice and eroding once reaches 3 Z planes
+    FilterPipeline::Pointer pipeline = FilterPipeline::New();
+    pipeline->pushBack(CreateErodeDilateMask(0, 2));
+    pipeline->pushBack(CreateErodeDilateMask(1, 1));
+    return pipeline;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  BoolArrayType::Pointer ReadMask(const QString& filePath)
+  {
+    DataContainerReader::Pointer reader = DataContainerReader::New();
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    reader->setDataContainerArray(dca);
+    reader->setInputFile(filePath);
+    reader->setInputFileDataContainerArrayProxy(reader->readDataContainerArrayStructure(filePath));
+    reader->execute();
+    DREAM3D_REQUIRE(reader->getErrorCondition() >= 0)
+
+    AttributeMatrix::Pointer cellAttrMat = dca->getAttributeMatrix(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, ""));
+    DREAM3D_REQUIRE_VALID_POINTER(cellAttrMat.get())
+    return cellAttrMat->getAttributeArrayAs<BoolArrayType>(SIMPL::CellData::Mask);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer CreateStreamingFilter(int32_t slabThickness, int32_t haloThickness)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter("SlabStreamingPipeline");
+    DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get())
+    AbstractFilter::Pointer filter = filterFactory->create();
+
+    bool ok = filter->setProperty("InputFile", SlabStreamingPipelineTestConsts::k_InputFile);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+    ok = filter->setProperty("OutputFile", SlabStreamingPipelineTestConsts::k_OutputFile);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+    ok = filter->setProperty("PipelineFile", SlabStreamingPipelineTestConsts::k_PipelineFile);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+    ok = filter->setProperty("SlabThickness", slabThickness);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+    ok = filter->setProperty("HaloThickness", haloThickness);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestStreaming()
+  {
+    QDir().mkpath(UnitTest::TestTempDir);
+
+    DataContainerWriter::Pointer writer = DataContainerWriter::New();
+    writer->setDataContainerArray(CreateTestData());
+    writer->setOutputFile(SlabStreamingPipelineTestConsts::k_InputFile);
+    writer->setWriteXdmfFile(false);
+    writer->execute();
+    DREAM3D_REQUIRE(writer->getErrorCondition() >= 0)
+
+    int err = JsonFilterParametersWriter::WritePipelineToFile(CreatePipeline(), SlabStreamingPipelineTestConsts::k_PipelineFile, "SlabStreamingPipelineTest");
+    DREAM3D_REQUIRE(err >= 0)
+
+    // The in memory result of the same pipeline
+    DataContainerArray::Pointer dca = CreateTestData();
+    FilterPipeline::Pointer pipeline = CreatePipeline();
+    FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+    for(FilterPipeline::FilterContainerType::iterator iter = filters.begin(); iter != filters.end(); ++iter)
+    {
+      (*iter)->setDataContainerArray(dca);
+      (*iter)->execute();
+      DREAM3D_REQUIRE((*iter)->getErrorCondition() >= 0)
+    }
+    BoolArrayType::Pointer expected =
+        dca->getAttributeMatrix(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, ""))->getAttributeArrayAs<BoolArrayType>(SIMPL::CellData::Mask);
+    DREAM3D_REQUIRE_VALID_POINTER(expected.get())
+
+    // Slab thicknesses that are thinner than the halo and that do not divide the volume must all agree
+    int32_t slabThicknesses[2] = {2, 7};
+    for(int32_t s = 0; s < 2; s++)
+    {
+      AbstractFilter::Pointer filter = CreateStreamingFilter(slabThicknesses[s], 3);
+      filter->execute();
+      DREAM3D_REQUIRE(filter->getErrorCondition() >= 0)
+
+      BoolArrayType::Pointer mask = ReadMask(SlabStreamingPipelineTestConsts::k_OutputFile);
+      DREAM3D_REQUIRE_VALID_POINTER(mask.get())
+      DREAM3D_REQUIRE_EQUAL(mask->getNumberOfTuples(), expected->getNumberOfTuples())
+      for(size_t i = 0; i < expected->getNumberOfTuples(); i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(mask->getValue(i), expected->getValue(i))
+      }
+    }
+
+    // A halo that does not cover the 3 planes the pipeline reaches is rejected
+    AbstractFilter::Pointer filter = CreateStreamingFilter(7, 2);
+    filter->preflight();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), -11009)
+
+    // Writing over the input file is rejected
+    filter = CreateStreamingFilter(7, 3);
+    filter->setProperty("OutputFile", SlabStreamingPipelineTestConsts::k_InputFile);
+    filter->preflight();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), -11006)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestStreaming())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+private:
+  SlabStreamingPipelineTest(const SlabStreamingPipelineTest&); // Copy Constructor Not Implemented
+  void operator=(const SlabStreamingPipelineTest&);            // Operator '=' Not Implemented
+};
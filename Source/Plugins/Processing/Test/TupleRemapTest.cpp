@@ -0,0 +1,185 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <QtCore/QCoreApplication>
+
+#include <vector>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "Processing/ProcessingFilters/util/TupleRemap.hpp"
+
+class TupleRemapTest
+{
+public:
+  TupleRemapTest()
+  {
+  }
+  virtual ~TupleRemapTest()
+  {
+  }
+  SIMPL_TYPE_MACRO(TupleRemapTest)
+
+  // -----------------------------------------------------------------------------
+  // Fills a 3 component array with values that identify each tuple and component
+  // -----------------------------------------------------------------------------
+  FloatArrayType::Pointer CreateArray(size_t numTuples)
+  {
+    QVector<size_t> tDims(1, numTuples);
+    QVector<size_t> cDims(1, 3);
+    FloatArrayType::Pointer array = FloatArrayType::CreateArray(tDims, cDims, "Values");
+    for(size_t i = 0; i < numTuples * 3; i++)
+    {
+      array->setValue(i, static_cast<float>(i + 1));
+    }
+    return array;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestShiftSlices()
+  {
+    size_t dims[3] = {5, 4, 6};
+    int64_t shifts[6][2] = {{0, 0}, {1, 0}, {-2, 1}, {3, -2}, {0, -1}, {-6, 9}};
+    std::vector<int64_t> xShifts(dims[2], 0);
+    std::vector<int64_t> yShifts(dims[2], 0);
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      xShifts[z] = shifts[z][0];
+      yShifts[z] = shifts[z][1];
+    }
+
+    size_t totalPoints = dims[0] * dims[1] * dims[2];
+    FloatArrayType::Pointer original = CreateArray(totalPoints);
+    FloatArrayType::Pointer values = CreateArray(totalPoints);
+    QVector<IDataArray::Pointer> arrays;
+    arrays.push_back(values);
+    TupleRemap remap(arrays);
+    remap.shiftSlices(dims, xShifts, yShifts);
+
+    for(int64_t z = 0; z < static_cast<int64_t>(dims[2]); z++)
+    {
+      for(int64_t y = 0; y < static_cast<int64_t>(dims[1]); y++)
+      {
+        for(int64_t x = 0; x < static_cast<int64_t>(dims[0]); x++)
+        {
+          int64_t srcX = x + xShifts[z];
+          int64_t srcY = y + yShifts[z];
+          bool inside = srcX >= 0 && srcX < static_cast<int64_t>(dims[0]) && srcY >= 0 && srcY < static_cast<int64_t>(dims[1]);
+          size_t dest = (z * dims[1] + y) * dims[0] + x;
+          size_t src = (z * dims[1] + srcY) * dims[0] + srcX;
+          for(size_t c = 0; c < 3; c++)
+          {
+            float expected = inside ? original->getValue(src * 3 + c) : 0.0f;
+            DREAM3D_REQUIRE_EQUAL(values->getValue(dest * 3 + c), expected)
+          }
+        }
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestCopyTuples()
+  {
+    size_t totalPoints = 100;
+    FloatArrayType::Pointer original = CreateArray(totalPoints);
+    FloatArrayType::Pointer values = CreateArray(totalPoints);
+    QVector<size_t> tDims(1, totalPoints);
+    QVector<size_t> cDims(1, 1);
+    Int32ArrayType::Pointer ids = Int32ArrayType::CreateArray(tDims, cDims, "Ids");
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      ids->setValue(i, static_cast<int32_t>(i));
+    }
+
+    // Every odd tuple takes the value of the even tuple before or after it
+    std::vector<int64_t> sources;
+    std::vector<int64_t> destinations;
+    for(int64_t i = 1; i < static_cast<int64_t>(totalPoints); i += 2)
+    {
+      destinations.push_back(i);
+      sources.push_back((i % 4 == 1 || i + 1 == static_cast<int64_t>(totalPoints)) ? i - 1 : i + 1);
+    }
+
+    QVector<IDataArray::Pointer> arrays;
+    arrays.push_back(values);
+    arrays.push_back(ids);
+    TupleRemap remap(arrays);
+    remap.copyTuples(sources, destinations);
+
+    std::vector<int64_t> expected(totalPoints, 0);
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      expected[i] = static_cast<int64_t>(i);
+    }
+    for(size_t i = 0; i < sources.size(); i++)
+    {
+      expected[destinations[i]] = sources[i];
+    }
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(ids->getValue(i), expected[i])
+      for(size_t c = 0; c < 3; c++)
+      {
+        DREAM3D_REQUIRE_EQUAL(values->getValue(i * 3 + c), original->getValue(expected[i] * 3 + c))
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "#### TupleRemapTest Starting ####" << std::endl;
+
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestShiftSlices())
+    DREAM3D_REGISTER_TEST(TestCopyTuples())
+  }
+
+private:
+  TupleRemapTest(const TupleRemapTest&); // Copy Constructor Not Implemented
+  void operator=(const TupleRemapTest&); // Operator '=' Not Implemented
+};
@@ -0,0 +1,155 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <QtCore/QCoreApplication>
+
+#include <vector>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "Processing/ProcessingFilters/util/VoxelNeighborhood.hpp"
+
+class VoxelNeighborhoodTest
+{
+public:
+  VoxelNeighborhoodTest()
+  {
+  }
+  virtual ~VoxelNeighborhoodTest()
+  {
+  }
+  SIMPL_TYPE_MACRO(VoxelNeighborhoodTest)
+
+  // -----------------------------------------------------------------------------
+  // Compares the neighbors visited for every voxel of an xp * yp * zp grid against a brute force
+  // enumeration that checks every candidate neighbor against the grid bounds
+  // -----------------------------------------------------------------------------
+  template <int Connectivity>
+  int CheckGrid(int64_t xp, int64_t yp, int64_t zp, bool xDirOn, bool yDirOn, bool zDirOn)
+  {
+    int64_t dims[3] = {xp, yp, zp};
+    VoxelNeighborhood<Connectivity> neighborhood(dims, xDirOn, yDirOn, zDirOn);
+    int32_t maxSteps = (Connectivity == 6) ? 1 : ((Connectivity == 18) ? 2 : 3);
+
+    std::vector<int32_t> visits(xp * yp * zp, 0);
+    std::vector<int32_t> directions;
+    std::vector<int64_t> neighbors;
+
+    neighborhood.forEachVoxel([&](int64_t index, int64_t x, int64_t y, int64_t z, bool interior) {
+      visits[index]++;
+      directions.clear();
+      neighbors.clear();
+      neighborhood.forEachNeighbor(index, x, y, z, interior, [&](int32_t direction, int64_t neighbor) {
+        directions.push_back(direction);
+        neighbors.push_back(neighbor);
+      });
+
+      size_t n = 0;
+      int32_t direction = 0;
+      for(int64_t k = -1; k <= 1; k++)
+      {
+        for(int64_t j = -1; j <= 1; j++)
+        {
+          for(int64_t i = -1; i <= 1; i++)
+          {
+            int32_t steps = std::abs(i) + std::abs(j) + std::abs(k);
+            if(steps == 0 || steps > maxSteps)
+            {
+              continue;
+            }
+            bool enabled = (i == 0 || xDirOn) && (j == 0 || yDirOn) && (k == 0 || zDirOn);
+            int64_t nx = x + i;
+            int64_t ny = y + j;
+            int64_t nz = z + k;
+            if(enabled && nx >= 0 && nx < xp && ny >= 0 && ny < yp && nz >= 0 && nz < zp)
+            {
+              DREAM3D_REQUIRE(n < neighbors.size())
+              DREAM3D_REQUIRE_EQUAL(directions[n], direction)
+              DREAM3D_REQUIRE_EQUAL(neighbors[n], (nz * yp + ny) * xp + nx)
+              n++;
+            }
+            direction++;
+          }
+        }
+      }
+      DREAM3D_REQUIRE_EQUAL(n, neighbors.size())
+    });
+
+    for(size_t i = 0; i < visits.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(visits[i], 1)
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestNeighborhoods()
+  {
+    for(int64_t xp = 1; xp <= 4; xp++)
+    {
+      for(int64_t yp = 1; yp <= 4; yp++)
+      {
+        for(int64_t zp = 1; zp <= 4; zp++)
+        {
+          DREAM3D_REQUIRE_EQUAL(CheckGrid<6>(xp, yp, zp, true, true, true), EXIT_SUCCESS)
+          DREAM3D_REQUIRE_EQUAL(CheckGrid<18>(xp, yp, zp, true, true, true), EXIT_SUCCESS)
+          DREAM3D_REQUIRE_EQUAL(CheckGrid<26>(xp, yp, zp, true, true, true), EXIT_SUCCESS)
+          DREAM3D_REQUIRE_EQUAL(CheckGrid<6>(xp, yp, zp, true, false, true), EXIT_SUCCESS)
+          DREAM3D_REQUIRE_EQUAL(CheckGrid<26>(xp, yp, zp, false, true, true), EXIT_SUCCESS)
+        }
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "#### VoxelNeighborhoodTest Starting ####" << std::endl;
+
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestNeighborhoods())
+  }
+
+private:
+  VoxelNeighborhoodTest(const VoxelNeighborhoodTest&); // Copy Constructor Not Implemented
+  void operator=(const VoxelNeighborhoodTest&);        // Operator '=' Not Implemented
+};
@@ -35,14 +35,26 @@
 
 #include "AlignSections.h"
 
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
-#include "SIMPLib/Common/TemplateHelpers.hpp"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/OutputFileFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "Reconstruction/ReconstructionFilters/util/TupleRemap.hpp"
+
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
 
@@ -58,6 +70,7 @@ AlignSections::AlignSections()
 , m_CellAttributeMatrixName(SIMPL::Defaults::CellAttributeMatrixName)
 , m_WriteAlignmentShifts(false)
 , m_AlignmentShiftFileName("")
+, m_UseCoarseToFineSearch(false)
 {
   setupFilterParameters();
 }
@@ -145,6 +158,57 @@ void AlignSections::preflight()
   setInPreflight(false);
 }
 
+/**
+ * @brief The AlignSectionsSearchImpl class searches the shifts of a range of section pairs. Pair iter aligns
+ * slice (dims[2] - 1 - iter) to the slice above it.
+ */
+class AlignSectionsSearchImpl
+{
+  AlignSections* m_Filter;
+  const int64_t* m_Dims;
+  bool m_PreferSmallShifts;
+  int64_t* m_XShifts;
+  int64_t* m_YShifts;
+
+public:
+  AlignSectionsSearchImpl(AlignSections* filter, const int64_t dims[3], bool preferSmallShifts, int64_t* xShifts, int64_t* yShifts)
+  : m_Filter(filter)
+  , m_Dims(dims)
+  , m_PreferSmallShifts(preferSmallShifts)
+  , m_XShifts(xShifts)
+  , m_YShifts(yShifts)
+  {
+  }
+  virtual ~AlignSectionsSearchImpl()
+  {
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t iter = start; iter < end; iter++)
+    {
+      if(m_Filter->getCancel() == true)
+      {
+        return;
+      }
+      int64_t slice = (m_Dims[2] - 1) - static_cast<int64_t>(iter);
+      AlignSections::SectionShiftCostPointer cost = m_Filter->create_shift_cost(slice);
+      if(nullptr == cost.get())
+      {
+        continue;
+      }
+      AlignSections::SearchSectionShift(*cost, m_Dims, m_Filter->getUseCoarseToFineSearch(), m_PreferSmallShifts, m_XShifts[iter], m_YShifts[iter]);
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -156,12 +220,138 @@ void AlignSections::find_shifts(std::vector<int64_t>& xshifts, std::vector<int64
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-template <typename T> void initializeArrayValues(IDataArray::Pointer p, size_t index)
+AlignSections::SectionShiftCostPointer AlignSections::create_shift_cost(int64_t slice)
 {
+  // Filters that search for shifts override this; without a cost the pair keeps a zero shift
+  Q_UNUSED(slice)
+  return SectionShiftCostPointer();
+}
 
-  typename DataArray<T>::Pointer ptr = std::dynamic_pointer_cast<DataArray<T>>(p);
-  T var = static_cast<T>(0);
-  ptr->initializeTuple(index, &var);
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AlignSections::SearchSectionShift(SectionShiftCost& cost, const int64_t dims[3], bool coarseToFine, bool preferSmallShifts, int64_t& xShift, int64_t& yShift)
+{
+  // Every level doubles the shift step and the sampling step of the level below it. The coarsest level still
+  // samples at least 32 Cells along X and Y.
+  int32_t level = 0;
+  if(coarseToFine == true)
+  {
+    while(std::min(dims[0], dims[1]) / (static_cast<int64_t>(4) << (level + 1)) >= 32)
+    {
+      level++;
+    }
+  }
+
+  const int64_t halfDim0 = dims[0] / 2;
+  const int64_t halfDim1 = dims[1] / 2;
+  std::vector<bool> visited(dims[0] * dims[1], false);
+
+  xShift = 0;
+  yShift = 0;
+  for(; level >= 0; level--)
+  {
+    int64_t unit = static_cast<int64_t>(1) << level;
+    int64_t step = 4 * unit;
+    float minCost = std::numeric_limits<float>::max();
+    int64_t oldxshift = xShift + 1;
+    int64_t oldyshift = yShift + 1;
+    int64_t newxshift = xShift;
+    int64_t newyshift = yShift;
+    visited.assign(visited.size(), false);
+
+    while(newxshift != oldxshift || newyshift != oldyshift)
+    {
+      oldxshift = newxshift;
+      oldyshift = newyshift;
+      for(int32_t j = -3; j < 4; j++)
+      {
+        for(int32_t k = -3; k < 4; k++)
+        {
+          int64_t x = oldxshift + k * unit;
+          int64_t y = oldyshift + j * unit;
+          if(llabs(x) >= halfDim0 || llabs(y) >= halfDim1)
+          {
+            continue;
+          }
+          int64_t idx = (dims[0] * (y + halfDim1)) + (x + halfDim0);
+          if(visited[idx] == true)
+          {
+            continue;
+          }
+          visited[idx] = true;
+          float value = cost(x, y, step);
+          if(value < minCost || (preferSmallShifts == true && value == minCost && ((llabs(x) < llabs(newxshift)) || (llabs(y) < llabs(newyshift)))))
+          {
+            newxshift = x;
+            newyshift = y;
+            minCost = value;
+          }
+        }
+      }
+    }
+    xShift = newxshift;
+    yShift = newyshift;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AlignSections::search_shifts(std::vector<int64_t>& xshifts, std::vector<int64_t>& yshifts, bool preferSmallShifts)
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+
+  size_t udims[3] = {0, 0, 0};
+  m->getGeometryAs<ImageGeom>()->getDimensions(udims);
+
+  int64_t dims[3] = {
+      static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
+  };
+
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), "Aligning Sections || Determining Shifts");
+
+  // The shift of each section relative to the section above it only depends on those two sections
+  std::vector<int64_t> pairXShifts(dims[2], 0);
+  std::vector<int64_t> pairYShifts(dims[2], 0);
+  AlignSectionsSearchImpl impl(this, dims, preferSmallShifts, pairXShifts.data(), pairYShifts.data());
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, dims[2], 1), impl, tbb::simple_partitioner());
+  }
+  else
+#endif
+  {
+    impl.convert(1, dims[2]);
+  }
+
+  if(getCancel() == true)
+  {
+    return;
+  }
+
+  std::ofstream outFile;
+  if(getWriteAlignmentShifts() == true)
+  {
+    outFile.open(getAlignmentShiftFileName().toLatin1().data());
+  }
+  for(int64_t iter = 1; iter < dims[2]; iter++)
+  {
+    int64_t slice = (dims[2] - 1) - iter;
+    xshifts[iter] = xshifts[iter - 1] + pairXShifts[iter];
+    yshifts[iter] = yshifts[iter - 1] + pairYShifts[iter];
+    if(getWriteAlignmentShifts() == true)
+    {
+      outFile << slice << "\t" << slice + 1 << "\t" << pairXShifts[iter] << "\t" << pairYShifts[iter] << "\t" << xshifts[iter] << "\t" << yshifts[iter] << "\n";
+    }
+  }
+  if(getWriteAlignmentShifts() == true)
+  {
+    outFile.close();
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -181,78 +371,32 @@ void AlignSections::execute()
   size_t dims[3] = {0, 0, 0};
   m->getGeometryAs<ImageGeom>()->getDimensions(dims);
 
-  int64_t xspot = 0, yspot = 0;
-  int64_t newPosition = 0;
-  int64_t currentPosition = 0;
-
   std::vector<int64_t> xshifts(dims[2], 0);
   std::vector<int64_t> yshifts(dims[2], 0);
 
   find_shifts(xshifts, yshifts);
 
-  QList<QString> voxelArrayNames = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArrayNames();
-  size_t progIncrement = dims[2] / 100;
-  size_t prog = 1;
-  size_t progressInt = 0;
-  size_t slice = 0;
+  if(getCancel() == true)
+  {
+    return;
+  }
 
+  // The shift found for section i is applied to slice (dims[2] - 1 - i); the last slice is the reference
+  std::vector<int64_t> sliceXShifts(dims[2], 0);
+  std::vector<int64_t> sliceYShifts(dims[2], 0);
   for(size_t i = 1; i < dims[2]; i++)
   {
-    if(i > prog)
-    {
-
-      progressInt = ((float)i / dims[2]) * 100.0f;
-      QString ss = QObject::tr("Transferring Cell Data || %1% Complete").arg(progressInt);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-      prog = prog + progIncrement;
-    }
-    if(getCancel() == true)
-    {
-      return;
-    }
-    slice = (dims[2] - 1) - i;
-    for(size_t l = 0; l < dims[1]; l++)
-    {
-      for(size_t n = 0; n < dims[0]; n++)
-      {
-        if(yshifts[i] >= 0)
-        {
-          yspot = l;
-        }
-        else if(yshifts[i] < 0)
-        {
-          yspot = dims[1] - 1 - l;
-        }
-        if(xshifts[i] >= 0)
-        {
-          xspot = n;
-        }
-        else if(xshifts[i] < 0)
-        {
-          xspot = dims[0] - 1 - n;
-        }
-        newPosition = (slice * dims[0] * dims[1]) + (yspot * dims[0]) + xspot;
-        currentPosition = (slice * dims[0] * dims[1]) + ((yspot + yshifts[i]) * dims[0]) + (xspot + xshifts[i]);
-        if((yspot + yshifts[i]) >= 0 && (yspot + yshifts[i]) <= static_cast<int64_t>(dims[1]) - 1 && (xspot + xshifts[i]) >= 0 && (xspot + xshifts[i]) <= static_cast<int64_t>(dims[0]) - 1)
-        {
-          for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-          {
-            IDataArray::Pointer p = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArray(*iter);
-            p->copyTuple(static_cast<size_t>(currentPosition), static_cast<size_t>(newPosition));
-          }
-        }
-        if((yspot + yshifts[i]) < 0 || (yspot + yshifts[i]) > static_cast<int64_t>(dims[1] - 1) || (xspot + xshifts[i]) < 0 || (xspot + xshifts[i]) > static_cast<int64_t>(dims[0]) - 1)
-        {
-          for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-          {
-            IDataArray::Pointer p = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArray(*iter);
-            EXECUTE_FUNCTION_TEMPLATE(this, initializeArrayValues, p, p, newPosition)
-          }
-        }
-      }
-    }
+    size_t slice = (dims[2] - 1) - i;
+    sliceXShifts[slice] = xshifts[i];
+    sliceYShifts[slice] = yshifts[i];
   }
 
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), "Transferring Cell Data");
+
+  // Shift every Cell array in one pass, moving whole rows of each slice
+  TupleRemap cellArrays(m->getAttributeMatrix(getCellAttributeMatrixName()));
+  cellArrays.shiftSlices(dims, sliceXShifts, sliceYShifts);
+
   // If there is an error set this to something negative and also set a message
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
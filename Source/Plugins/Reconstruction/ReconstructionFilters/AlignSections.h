@@ -37,6 +37,9 @@
 #ifndef _alignsections_h_
 #define _alignsections_h_
 
+#include <memory>
+#include <vector>
+
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/Common/AbstractFilter.h"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
@@ -65,6 +68,42 @@ class AlignSections : public AbstractFilter
     SIMPL_INSTANCE_STRING_PROPERTY(AlignmentShiftFileName)
     Q_PROPERTY(QString AlignmentShiftFileName READ getAlignmentShiftFileName WRITE setAlignmentShiftFileName)
 
+    SIMPL_INSTANCE_PROPERTY(bool, UseCoarseToFineSearch)
+    Q_PROPERTY(bool UseCoarseToFineSearch READ getUseCoarseToFineSearch WRITE setUseCoarseToFineSearch)
+
+    /**
+     * @brief The SectionShiftCost class scores how badly a section matches the section above it when it is
+     * shifted in X and Y. The filters that search for the best shift of each section create one per pair of
+     * sections; the pairs are searched in parallel, so the cost objects must only read the filter's data.
+     */
+    class SectionShiftCost
+    {
+      public:
+        virtual ~SectionShiftCost()
+        {
+        }
+
+        /**
+         * @brief Returns the cost of shifting the section by (xShift, yShift), comparing every step'th Cell
+         * of the section above it in X and Y. Lower is better.
+         */
+        virtual float operator()(int64_t xShift, int64_t yShift, int64_t step) = 0;
+    };
+    typedef std::shared_ptr<SectionShiftCost> SectionShiftCostPointer;
+
+    /**
+     * @brief SearchSectionShift Finds the shift with the lowest cost by hill climbing over +/- 3 Cell steps
+     * around the best shift so far, starting from no shift. With coarseToFine the search first runs on coarser
+     * steps and sampling grids and each finer level starts from the shift found on the coarser one.
+     * @param cost Cost of the section pair
+     * @param dims Dimensions of the volume
+     * @param coarseToFine Whether to search from coarse to fine steps
+     * @param preferSmallShifts Whether a shift with the same cost but a smaller X or Y component replaces the best one
+     * @param xShift Found X shift
+     * @param yShift Found Y shift
+     */
+    static void SearchSectionShift(SectionShiftCost& cost, const int64_t dims[3], bool coarseToFine, bool preferSmallShifts, int64_t& xShift, int64_t& yShift);
+
     /**
      * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
      */
@@ -167,7 +206,28 @@ class AlignSections : public AbstractFilter
      */
     virtual void find_shifts(std::vector<int64_t>& xshifts, std::vector<int64_t>& yshifts);
 
+    /**
+     * @brief search_shifts Finds the shift of every section relative to the section above it with
+     * SearchSectionShift(), running the section pairs in parallel, accumulates them into the shifts of the
+     * sections and writes the alignment shift file if requested
+     * @param xshifts Vector of integer shifts in x direction
+     * @param yshifts Vector of integer shifts in y direction
+     * @param preferSmallShifts See SearchSectionShift()
+     */
+    void search_shifts(std::vector<int64_t>& xshifts, std::vector<int64_t>& yshifts, bool preferSmallShifts);
+
+    /**
+     * @brief create_shift_cost Creates the cost used by search_shifts() to align slice to slice + 1. This is not
+     * pure virtual because AlignSections is itself instantiated (SIMPL_STATIC_NEW_MACRO, newFilterInstance) and
+     * AlignSectionsFeatureCentroid and AlignSectionsList find their shifts without a search. The default returns
+     * a null pointer for every slice, which search_shifts() treats as a pair that is not shifted.
+     * @param slice The lower section of the pair
+     * @return The cost of the pair, or a null pointer
+     */
+    virtual SectionShiftCostPointer create_shift_cost(int64_t slice);
+
   private:
+    friend class AlignSectionsSearchImpl;
 
     AlignSections(const AlignSections&); // Copy Constructor Not Implemented
     void operator=(const AlignSections&); // Operator '=' Not Implemented
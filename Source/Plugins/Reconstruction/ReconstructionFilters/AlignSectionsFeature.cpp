@@ -35,10 +35,9 @@
 
 #include "AlignSectionsFeature.h"
 
-#include <fstream>
-
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
@@ -47,6 +46,62 @@
 #include "Reconstruction/ReconstructionVersion.h"
 
 #include "moc_AlignSectionsFeature.cpp"
+namespace AlignSectionsFeatureDetail
+{
+/**
+ * @brief The MaskMismatchCost class scores a shift of a section by the fraction of sampled Cells whose mask
+ * value differs from the Cell above them.
+ */
+class MaskMismatchCost : public AlignSections::SectionShiftCost
+{
+public:
+  MaskMismatchCost(bool* goodVoxels, const int64_t dims[3], int64_t slice)
+  : m_GoodVoxels(goodVoxels)
+  , m_Slice(slice)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+  virtual ~MaskMismatchCost()
+  {
+  }
+
+  virtual float operator()(int64_t xShift, int64_t yShift, int64_t step)
+  {
+    float disorientation = 0.0f;
+    float count = 0.0f;
+    for(int64_t l = 0; l < m_Dims[1]; l = l + step)
+    {
+      if((l + yShift) < 0 || (l + yShift) >= m_Dims[1])
+      {
+        continue;
+      }
+      for(int64_t n = 0; n < m_Dims[0]; n = n + step)
+      {
+        if((n + xShift) < 0 || (n + xShift) >= m_Dims[0])
+        {
+          continue;
+        }
+        int64_t refposition = ((m_Slice + 1) * m_Dims[0] * m_Dims[1]) + (l * m_Dims[0]) + n;
+        int64_t curposition = (m_Slice * m_Dims[0] * m_Dims[1]) + ((l + yShift) * m_Dims[0]) + (n + xShift);
+        if(m_GoodVoxels[refposition] != m_GoodVoxels[curposition])
+        {
+          disorientation++;
+        }
+        count++;
+      }
+    }
+    return disorientation / count;
+  }
+
+private:
+  bool* m_GoodVoxels;
+  int64_t m_Dims[3];
+  int64_t m_Slice;
+};
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -73,6 +128,7 @@ void AlignSectionsFeature::setupFilterParameters()
 {
   // getting the current parameters that were set by the parent and adding to it before resetting it
   FilterParameterVector parameters = getFilterParameters();
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Coarse-to-Fine Search", UseCoarseToFineSearch, FilterParameter::Parameter, AlignSectionsFeature));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req =
@@ -90,6 +146,7 @@ void AlignSectionsFeature::readFilterParameters(AbstractFilterParametersReader*
   AlignSections::readFilterParameters(reader, index);
   reader->openFilterGroup(this, index);
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
+  setUseCoarseToFineSearch(reader->readValue("UseCoarseToFineSearch", getUseCoarseToFineSearch()));
   reader->closeFilterGroup();
 }
 
@@ -144,14 +201,17 @@ void AlignSectionsFeature::preflight()
 //
 // -----------------------------------------------------------------------------
 void AlignSectionsFeature::find_shifts(std::vector<int64_t>& xshifts, std::vector<int64_t>& yshifts)
+{
+  search_shifts(xshifts, yshifts, false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AlignSections::SectionShiftCostPointer AlignSectionsFeature::create_shift_cost(int64_t slice)
 {
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
 
-  std::ofstream outFile;
-  if(getWriteAlignmentShifts() == true)
-  {
-    outFile.open(getAlignmentShiftFileName().toLatin1().data());
-  }
   size_t udims[3] = {0, 0, 0};
   m->getGeometryAs<ImageGeom>()->getDimensions(udims);
 
@@ -159,94 +219,8 @@ void AlignSectionsFeature::find_shifts(std::vector<int64_t>& xshifts, std::vecto
       static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
   };
 
-  float disorientation = 0.0f;
-  float mindisorientation = std::numeric_limits<float>::max();
-  int32_t newxshift = 0;
-  int32_t newyshift = 0;
-  int32_t oldxshift = 0;
-  int32_t oldyshift = 0;
-  float count = 0.0f;
-  int64_t slice = 0;
-  int64_t refposition = 0;
-  int64_t curposition = 0;
-  std::vector<std::vector<float>> misorients(dims[0]);
-
-  for(int64_t a = 0; a < dims[0]; a++)
-  {
-    misorients[a].assign(dims[1], 0.0f);
-  }
-
-  for(int64_t iter = 1; iter < dims[2]; iter++)
-  {
-    QString ss = QObject::tr("Aligning Sections || Determining Shifts || %1% Complete").arg(((float)iter / dims[2]) * 100);
-    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-    mindisorientation = std::numeric_limits<float>::max();
-    slice = (dims[2] - 1) - iter;
-    oldxshift = -1;
-    oldyshift = -1;
-    newxshift = 0;
-    newyshift = 0;
-    for(int64_t a = 0; a < dims[0]; a++)
-    {
-      for(int64_t b = 0; b < dims[1]; b++)
-      {
-        misorients[a][b] = 0;
-      }
-    }
-    while(newxshift != oldxshift || newyshift != oldyshift)
-    {
-      oldxshift = newxshift;
-      oldyshift = newyshift;
-      for(int32_t j = -3; j < 4; j++)
-      {
-        for(int32_t k = -3; k < 4; k++)
-        {
-          disorientation = 0.0f;
-          count = 0.0f;
-          if(misorients[k + oldxshift + dims[0] / 2][j + oldyshift + dims[1] / 2] == 0.0f && abs(k + oldxshift) < (dims[0] / 2) && (j + oldyshift) < (dims[1] / 2))
-          {
-            for(int64_t l = 0; l < dims[1]; l = l + 4)
-            {
-              for(int64_t n = 0; n < dims[0]; n = n + 4)
-              {
-                if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
-                {
-                  refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
-                  curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
-                  if(m_GoodVoxels[refposition] != m_GoodVoxels[curposition])
-                  {
-                    disorientation++;
-                  }
-                  count++;
-                }
-                else
-                {
-                }
-              }
-            }
-            disorientation = disorientation / count;
-            misorients[k + oldxshift + dims[0] / 2][j + oldyshift + dims[1] / 2] = disorientation;
-            if(disorientation < mindisorientation)
-            {
-              newxshift = k + oldxshift;
-              newyshift = j + oldyshift;
-              mindisorientation = disorientation;
-            }
-          }
-        }
-      }
-    }
-    xshifts[iter] = xshifts[iter - 1] + newxshift;
-    yshifts[iter] = yshifts[iter - 1] + newyshift;
-    if(getWriteAlignmentShifts() == true)
-    {
-      outFile << slice << "	" << slice + 1 << "	" << newxshift << "	" << newyshift << "	" << xshifts[iter] << "	" << yshifts[iter] << std::endl;
-    }
-  }
-  if(getWriteAlignmentShifts() == true)
-  {
-    outFile.close();
-  }
+  SectionShiftCostPointer cost(new AlignSectionsFeatureDetail::MaskMismatchCost(m_GoodVoxels, dims, slice));
+  return cost;
 }
 
 // -----------------------------------------------------------------------------
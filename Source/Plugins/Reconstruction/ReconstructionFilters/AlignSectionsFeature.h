@@ -139,6 +139,11 @@ class AlignSectionsFeature : public AlignSections
      */
     virtual void find_shifts(std::vector<int64_t>& xshifts, std::vector<int64_t>& yshifts);
 
+    /**
+     * @brief create_shift_cost Reimplemented from @see AlignSections class
+     */
+    virtual SectionShiftCostPointer create_shift_cost(int64_t slice);
+
   private:
     DEFINE_DATAARRAY_VARIABLE(bool, GoodVoxels)
 
@@ -35,12 +35,13 @@
 
 #include "AlignSectionsMisorientation.h"
 
-#include <fstream>
+#include <limits>
 
 #include <QtCore/QDateTime>
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DoubleFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
@@ -50,6 +51,90 @@
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
 #include "moc_AlignSectionsMisorientation.cpp"
+namespace AlignSectionsMisorientationDetail
+{
+static const uint8_t k_NoLaueClass = 0xFF;
+
+/**
+ * @brief The MisorientationCost class scores a shift of a section by the fraction of sampled Cells that are
+ * misoriented by more than the tolerance to the Cell above them, or whose mask value differs from it.
+ */
+class MisorientationCost : public AlignSections::SectionShiftCost
+{
+public:
+  MisorientationCost(QuatF* quats, const uint8_t* laueClasses, bool* goodVoxels, const QVector<LaueOps::Pointer>& orientationOps, float tolerance, const int64_t dims[3], int64_t slice)
+  : m_Quats(quats)
+  , m_LaueClasses(laueClasses)
+  , m_GoodVoxels(goodVoxels)
+  , m_OrientationOps(orientationOps)
+  , m_Tolerance(tolerance)
+  , m_Slice(slice)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+  virtual ~MisorientationCost()
+  {
+  }
+
+  virtual float operator()(int64_t xShift, int64_t yShift, int64_t step)
+  {
+    float disorientation = 0.0f;
+    float count = 0.0f;
+    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+    QuatF q1 = QuaternionMathF::New();
+    QuatF q2 = QuaternionMathF::New();
+    for(int64_t l = 0; l < m_Dims[1]; l = l + step)
+    {
+      if((l + yShift) < 0 || (l + yShift) >= m_Dims[1])
+      {
+        continue;
+      }
+      for(int64_t n = 0; n < m_Dims[0]; n = n + step)
+      {
+        if((n + xShift) < 0 || (n + xShift) >= m_Dims[0])
+        {
+          continue;
+        }
+        count++;
+        int64_t refposition = ((m_Slice + 1) * m_Dims[0] * m_Dims[1]) + (l * m_Dims[0]) + n;
+        int64_t curposition = (m_Slice * m_Dims[0] * m_Dims[1]) + ((l + yShift) * m_Dims[0]) + (n + xShift);
+        if(nullptr == m_GoodVoxels || (m_GoodVoxels[refposition] == true && m_GoodVoxels[curposition] == true))
+        {
+          float w = std::numeric_limits<float>::max();
+          uint8_t laueClass = m_LaueClasses[refposition];
+          if(laueClass != k_NoLaueClass && laueClass == m_LaueClasses[curposition])
+          {
+            QuaternionMathF::Copy(m_Quats[refposition], q1);
+            QuaternionMathF::Copy(m_Quats[curposition], q2);
+            w = m_OrientationOps[laueClass]->getMisoQuat(q1, q2, n1, n2, n3);
+          }
+          if(w > m_Tolerance)
+          {
+            disorientation++;
+          }
+        }
+        if(nullptr != m_GoodVoxels && m_GoodVoxels[refposition] != m_GoodVoxels[curposition])
+        {
+          disorientation++;
+        }
+      }
+    }
+    return disorientation / count;
+  }
+
+private:
+  QuatF* m_Quats;
+  const uint8_t* m_LaueClasses;
+  bool* m_GoodVoxels;
+  const QVector<LaueOps::Pointer>& m_OrientationOps;
+  float m_Tolerance;
+  int64_t m_Dims[3];
+  int64_t m_Slice;
+};
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -89,6 +174,7 @@ void AlignSectionsMisorientation::setupFilterParameters()
   // getting the current parameters that were set by the parent and adding to it before resetting it
   FilterParameterVector parameters = getFilterParameters();
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("Misorientation Tolerance (Degrees)", MisorientationTolerance, FilterParameter::Parameter, AlignSectionsMisorientation));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Coarse-to-Fine Search", UseCoarseToFineSearch, FilterParameter::Parameter, AlignSectionsMisorientation));
   QStringList linkedProps("GoodVoxelsArrayPath");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask Array", UseGoodVoxels, FilterParameter::Parameter, AlignSectionsMisorientation, linkedProps));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
@@ -130,6 +216,7 @@ void AlignSectionsMisorientation::readFilterParameters(AbstractFilterParametersR
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setQuatsArrayPath(reader->readDataArrayPath("QuatsArrayPath", getQuatsArrayPath()));
   setMisorientationTolerance(reader->readValue("MisorientationTolerance", getMisorientationTolerance()));
+  setUseCoarseToFineSearch(reader->readValue("UseCoarseToFineSearch", getUseCoarseToFineSearch()));
   reader->closeFilterGroup();
 }
 
@@ -227,14 +314,31 @@ void AlignSectionsMisorientation::preflight()
 // -----------------------------------------------------------------------------
 void AlignSectionsMisorientation::find_shifts(std::vector<int64_t>& xshifts, std::vector<int64_t>& yshifts)
 {
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+  size_t totalPoints = m_CellPhasesPtr.lock()->getNumberOfTuples();
 
-  std::ofstream outFile;
-  if(getWriteAlignmentShifts() == true)
+  // Only Cells with the same Laue class are compared, so look up the Laue class of every Cell once
+  m_CellLaueClasses.assign(totalPoints, AlignSectionsMisorientationDetail::k_NoLaueClass);
+  for(size_t i = 0; i < totalPoints; i++)
   {
-    outFile.open(getAlignmentShiftFileName().toLatin1().data());
+    if(m_CellPhases[i] > 0 && m_CrystalStructures[m_CellPhases[i]] < static_cast<uint32_t>(m_OrientationOps.size()))
+    {
+      m_CellLaueClasses[i] = static_cast<uint8_t>(m_CrystalStructures[m_CellPhases[i]]);
+    }
   }
 
+  search_shifts(xshifts, yshifts, true);
+
+  m_CellLaueClasses.clear();
+  m_CellLaueClasses.shrink_to_fit();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AlignSections::SectionShiftCostPointer AlignSectionsMisorientation::create_shift_cost(int64_t slice)
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+
   size_t udims[3] = {0, 0, 0};
   m->getGeometryAs<ImageGeom>()->getDimensions(udims);
 
@@ -242,144 +346,11 @@ void AlignSectionsMisorientation::find_shifts(std::vector<int64_t>& xshifts, std
       static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
   };
 
-  float disorientation = 0.0f;
-  float mindisorientation = std::numeric_limits<float>::max();
-  int64_t newxshift = 0;
-  int64_t newyshift = 0;
-  int64_t oldxshift = 0;
-  int64_t oldyshift = 0;
-  float count = 0.0f;
-  int64_t slice = 0;
-  float w = 0.0f;
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  int64_t refposition = 0;
-  int64_t curposition = 0;
-  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
-
-  uint32_t phase1 = 0, phase2 = 0;
-  int64_t progInt = 0;
-
-  // Allocate a 2D Array which will be reused from slice to slice
-  BoolArrayType::Pointer misorientsPtr = BoolArrayType::CreateArray(dims[0] * dims[1], "_INTERNAL_USE_ONLY_Misorients");
-  misorientsPtr->initializeWithValue(false);
-  bool* misorients = misorientsPtr->getPointer(0); // Get the raw pointer to use in our calculations for speed.
-
-  int64_t idx = 0; // This will be used to compute the index into the flat array
-  int64_t xIdx = 0;
-  int64_t yIdx = 0;
-
-  const int64_t halfDim0 = static_cast<int64_t>(dims[0] * 0.5f);
-  const int64_t halfDim1 = static_cast<int64_t>(dims[1] * 0.5f);
-
-  // Loop over the Z Direction
-  for(int64_t iter = 1; iter < dims[2]; iter++)
-  {
-    progInt = ((float)iter / dims[2]) * 100.0f;
-    QString ss = QObject::tr("Aligning Sections || Determining Shifts || %1% Complete").arg(progInt);
-    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-    if(getCancel() == true)
-    {
-      return;
-    }
-    mindisorientation = std::numeric_limits<float>::max();
-    slice = (dims[2] - 1) - iter;
-    oldxshift = -1;
-    oldyshift = -1;
-    newxshift = 0;
-    newyshift = 0;
-
-    misorientsPtr->initializeWithValue(false); // Initialize everything to false
+  float misorientationTolerance = m_MisorientationTolerance * SIMPLib::Constants::k_Pif / 180.0f;
+  bool* goodVoxels = (m_UseGoodVoxels == true) ? m_GoodVoxels : nullptr;
 
-    float misorientationTolerance = m_MisorientationTolerance * SIMPLib::Constants::k_Pif / 180.0f;
-
-    while(newxshift != oldxshift || newyshift != oldyshift)
-    {
-      oldxshift = newxshift;
-      oldyshift = newyshift;
-      for(int32_t j = -3; j < 4; j++)
-      {
-        for(int32_t k = -3; k < 4; k++)
-        {
-          disorientation = 0.0f;
-          count = 0.0f;
-          xIdx = k + oldxshift + halfDim0;
-          yIdx = j + oldyshift + halfDim1;
-          idx = (dims[0] * yIdx) + xIdx;
-          if(misorients[idx] == false && llabs(k + oldxshift) < halfDim0 && llabs(j + oldyshift) < halfDim1)
-          {
-            for(int64_t l = 0; l < dims[1]; l = l + 4)
-            {
-              for(int64_t n = 0; n < dims[0]; n = n + 4)
-              {
-                if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
-                {
-                  count++;
-                  refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
-                  curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
-                  if(m_UseGoodVoxels == false || (m_GoodVoxels[refposition] == true && m_GoodVoxels[curposition] == true))
-                  {
-                    w = std::numeric_limits<float>::max();
-                    if(m_CellPhases[refposition] > 0 && m_CellPhases[curposition] > 0)
-                    {
-                      QuaternionMathF::Copy(quats[refposition], q1);
-                      phase1 = m_CrystalStructures[m_CellPhases[refposition]];
-                      QuaternionMathF::Copy(quats[curposition], q2);
-                      phase2 = m_CrystalStructures[m_CellPhases[curposition]];
-                      if(phase1 == phase2 && phase1 < static_cast<uint32_t>(m_OrientationOps.size()))
-                      {
-                        w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-                      }
-                    }
-                    if(w > misorientationTolerance)
-                    {
-                      disorientation++;
-                    }
-                  }
-                  if(m_UseGoodVoxels == true)
-                  {
-                    if(m_GoodVoxels[refposition] == true && m_GoodVoxels[curposition] == false)
-                    {
-                      disorientation++;
-                    }
-                    if(m_GoodVoxels[refposition] == false && m_GoodVoxels[curposition] == true)
-                    {
-                      disorientation++;
-                    }
-                  }
-                }
-                else
-                {
-                }
-              }
-            }
-            disorientation = disorientation / count;
-            xIdx = k + oldxshift + halfDim0;
-            yIdx = j + oldyshift + halfDim1;
-            idx = (dims[0] * yIdx) + xIdx;
-            misorients[idx] = true;
-            if(disorientation < mindisorientation || (disorientation == mindisorientation && ((llabs(k + oldxshift) < llabs(newxshift)) || (llabs(j + oldyshift) < llabs(newyshift)))))
-            {
-              newxshift = k + oldxshift;
-              newyshift = j + oldyshift;
-              mindisorientation = disorientation;
-            }
-          }
-        }
-      }
-    }
-    xshifts[iter] = xshifts[iter - 1] + newxshift;
-    yshifts[iter] = yshifts[iter - 1] + newyshift;
-    if(getWriteAlignmentShifts() == true)
-    {
-      outFile << slice << "	" << slice + 1 << "	" << newxshift << "	" << newyshift << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
-    }
-  }
-  if(getWriteAlignmentShifts() == true)
-  {
-    outFile.close();
-  }
+  SectionShiftCostPointer cost(new AlignSectionsMisorientationDetail::MisorientationCost(reinterpret_cast<QuatF*>(m_Quats), m_CellLaueClasses.data(), goodVoxels, m_OrientationOps, misorientationTolerance, dims, slice));
+  return cost;
 }
 
 // -----------------------------------------------------------------------------
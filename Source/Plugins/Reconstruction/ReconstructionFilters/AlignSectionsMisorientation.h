@@ -153,6 +153,11 @@ class AlignSectionsMisorientation : public AlignSections
      */
     virtual void find_shifts(std::vector<int64_t>& xshifts, std::vector<int64_t>& yshifts);
 
+    /**
+     * @brief create_shift_cost Reimplemented from @see AlignSections class
+     */
+    virtual SectionShiftCostPointer create_shift_cost(int64_t slice);
+
   private:
     DEFINE_DATAARRAY_VARIABLE(float, Quats)
     DEFINE_DATAARRAY_VARIABLE(int32_t, CellPhases)
@@ -160,6 +165,7 @@ class AlignSectionsMisorientation : public AlignSections
     DEFINE_DATAARRAY_VARIABLE(uint32_t, CrystalStructures)
 
     QVector<LaueOps::Pointer> m_OrientationOps;
+    std::vector<uint8_t> m_CellLaueClasses;
 
     uint64_t m_RandomSeed;
 
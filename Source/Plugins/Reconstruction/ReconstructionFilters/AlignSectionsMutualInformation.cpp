@@ -34,10 +34,12 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "AlignSectionsMutualInformation.h"
 
-#include <fstream>
+#include <algorithm>
+#include <cmath>
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DoubleFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
@@ -49,6 +51,108 @@
 #include "Reconstruction/ReconstructionVersion.h"
 
 #include "moc_AlignSectionsMutualInformation.cpp"
+namespace AlignSectionsMutualInformationDetail
+{
+/**
+ * @brief The MutualInformationCost class scores a shift of a section by the inverse of the mutual information
+ * of the in-section features of the sampled Cells and of the Cells above them. It owns the histograms of its
+ * section pair.
+ */
+class MutualInformationCost : public AlignSections::SectionShiftCost
+{
+public:
+  MutualInformationCost(int32_t* miFeatureIds, int32_t featureCount1, int32_t featureCount2, const int64_t dims[3], int64_t slice)
+  : m_MIFeatureIds(miFeatureIds)
+  , m_FeatureCount1(featureCount1)
+  , m_FeatureCount2(featureCount2)
+  , m_Slice(slice)
+  , m_MutualInfo12(static_cast<size_t>(featureCount1) * featureCount2, 0.0f)
+  , m_MutualInfo1(featureCount1, 0.0f)
+  , m_MutualInfo2(featureCount2, 0.0f)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+  virtual ~MutualInformationCost()
+  {
+  }
+
+  virtual float operator()(int64_t xShift, int64_t yShift, int64_t step)
+  {
+    float* mutualinfo12 = m_MutualInfo12.data();
+    float* mutualinfo1 = m_MutualInfo1.data();
+    float* mutualinfo2 = m_MutualInfo2.data();
+    float disorientation = 0.0f;
+    float count = 0.0f;
+    for(int64_t l = 0; l < m_Dims[1]; l = l + step)
+    {
+      for(int64_t n = 0; n < m_Dims[0]; n = n + step)
+      {
+        if((l + yShift) >= 0 && (l + yShift) < m_Dims[1] && (n + xShift) >= 0 && (n + xShift) < m_Dims[0])
+        {
+          int64_t refposition = ((m_Slice + 1) * m_Dims[0] * m_Dims[1]) + (l * m_Dims[0]) + n;
+          int64_t curposition = (m_Slice * m_Dims[0] * m_Dims[1]) + ((l + yShift) * m_Dims[0]) + (n + xShift);
+          int32_t refgnum = m_MIFeatureIds[refposition];
+          int32_t curgnum = m_MIFeatureIds[curposition];
+          if(curgnum >= 0 && refgnum >= 0)
+          {
+            mutualinfo12[curgnum * m_FeatureCount2 + refgnum]++;
+            mutualinfo1[curgnum]++;
+            mutualinfo2[refgnum]++;
+            count++;
+          }
+        }
+        else
+        {
+          mutualinfo12[0]++;
+          mutualinfo1[0]++;
+          mutualinfo2[0]++;
+        }
+      }
+    }
+    for(int32_t b = 0; b < m_FeatureCount1; b++)
+    {
+      mutualinfo1[b] = mutualinfo1[b] / count;
+    }
+    for(int32_t c = 0; c < m_FeatureCount2; c++)
+    {
+      mutualinfo2[c] = mutualinfo2[c] / count;
+    }
+    for(int32_t b = 0; b < m_FeatureCount1; b++)
+    {
+      for(int32_t c = 0; c < m_FeatureCount2; c++)
+      {
+        float pab = mutualinfo12[b * m_FeatureCount2 + c] / count;
+        float value = 0.0f;
+        if(mutualinfo1[b] > 0 && mutualinfo2[c] > 0)
+        {
+          value = (pab / (mutualinfo1[b] * mutualinfo2[c]));
+        }
+        if(value != 0)
+        {
+          disorientation = disorientation + (pab * logf(value));
+        }
+      }
+    }
+    std::fill(m_MutualInfo12.begin(), m_MutualInfo12.end(), 0.0f);
+    std::fill(m_MutualInfo1.begin(), m_MutualInfo1.end(), 0.0f);
+    std::fill(m_MutualInfo2.begin(), m_MutualInfo2.end(), 0.0f);
+    return 1.0f / disorientation;
+  }
+
+private:
+  int32_t* m_MIFeatureIds;
+  int32_t m_FeatureCount1;
+  int32_t m_FeatureCount2;
+  int64_t m_Dims[3];
+  int64_t m_Slice;
+  std::vector<float> m_MutualInfo12;
+  std::vector<float> m_MutualInfo1;
+  std::vector<float> m_MutualInfo2;
+};
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -90,6 +194,7 @@ void AlignSectionsMutualInformation::setupFilterParameters()
   // getting the current parameters that were set by the parent and adding to it before resetting it
   FilterParameterVector parameters = getFilterParameters();
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("Misorientation Tolerance", MisorientationTolerance, FilterParameter::Parameter, AlignSectionsMutualInformation));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Coarse-to-Fine Search", UseCoarseToFineSearch, FilterParameter::Parameter, AlignSectionsMutualInformation));
   QStringList linkedProps("GoodVoxelsArrayPath");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask Array", UseGoodVoxels, FilterParameter::Parameter, AlignSectionsMutualInformation, linkedProps));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
@@ -131,6 +236,7 @@ void AlignSectionsMutualInformation::readFilterParameters(AbstractFilterParamete
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setQuatsArrayPath(reader->readDataArrayPath("QuatsArrayPath", getQuatsArrayPath()));
   setMisorientationTolerance(reader->readValue("MisorientationTolerance", getMisorientationTolerance()));
+  setUseCoarseToFineSearch(reader->readValue("UseCoarseToFineSearch", getUseCoarseToFineSearch()));
   reader->closeFilterGroup();
 }
 
@@ -234,13 +340,20 @@ void AlignSectionsMutualInformation::find_shifts(std::vector<int64_t>& xshifts,
   int64_t totalPoints = m->getAttributeMatrix(getCellAttributeMatrixName())->getNumberOfTuples();
   m_MIFeaturesPtr = Int32ArrayType::CreateArray((totalPoints * 1), "_INTERNAL_USE_ONLY_MIFeatureIds");
   m_MIFeaturesPtr->initializeWithZeros();
-  int32_t* miFeatureIds = m_MIFeaturesPtr->getPointer(0);
 
-  std::ofstream outFile;
-  if(getWriteAlignmentShifts() == true)
-  {
-    outFile.open(getAlignmentShiftFileName().toLatin1().data());
-  }
+  form_features_sections();
+
+  search_shifts(xshifts, yshifts, false);
+
+  m->getAttributeMatrix(getCellAttributeMatrixName())->removeAttributeArray(SIMPL::CellData::FeatureIds);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AlignSections::SectionShiftCostPointer AlignSectionsMutualInformation::create_shift_cost(int64_t slice)
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
 
   size_t udims[3] = {0, 0, 0};
   m->getGeometryAs<ImageGeom>()->getDimensions(udims);
@@ -249,188 +362,9 @@ void AlignSectionsMutualInformation::find_shifts(std::vector<int64_t>& xshifts,
       static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
   };
 
-  float disorientation = 0.0f;
-  float mindisorientation = std::numeric_limits<float>::max();
-  float** mutualinfo12 = nullptr;
-  float* mutualinfo1 = nullptr;
-  float* mutualinfo2 = nullptr;
-  int32_t featurecount1 = 0, featurecount2 = 0;
-  int64_t newxshift = 0;
-  int64_t newyshift = 0;
-  int64_t oldxshift = 0;
-  int64_t oldyshift = 0;
-  float count = 0.0f;
-  int64_t slice = 0;
-
-  int32_t refgnum = 0, curgnum = 0;
-  int64_t refposition = 0;
-  int64_t curposition = 0;
-
-  form_features_sections();
-
-  std::vector<std::vector<float>> misorients;
-  misorients.resize(dims[0]);
-  for(int64_t a = 0; a < dims[0]; a++)
-  {
-    misorients[a].assign(dims[1], 0.0f);
-  }
-
-  for(int64_t iter = 1; iter < dims[2]; iter++)
-  {
-    float prog = ((float)iter / dims[2]) * 100;
-    QString ss = QObject::tr("Aligning Sections || Determining Shifts || %1% Complete").arg(QString::number(prog, 'f', 0));
-    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-    mindisorientation = std::numeric_limits<float>::max();
-    slice = (dims[2] - 1) - iter;
-    featurecount1 = featurecounts[slice];
-    featurecount2 = featurecounts[slice + 1];
-    mutualinfo12 = new float*[featurecount1];
-    mutualinfo1 = new float[featurecount1];
-    mutualinfo2 = new float[featurecount2];
-
-    for(int32_t a = 0; a < featurecount1; a++)
-    {
-      mutualinfo1[a] = 0.0f;
-      mutualinfo12[a] = new float[featurecount2];
-      for(int32_t b = 0; b < featurecount2; b++)
-      {
-        mutualinfo12[a][b] = 0.0f;
-        mutualinfo2[b] = 0.0f;
-      }
-    }
-    oldxshift = -1;
-    oldyshift = -1;
-    newxshift = 0;
-    newyshift = 0;
-    for(int64_t a = 0; a < dims[0]; a++)
-    {
-      for(int64_t b = 0; b < dims[1]; b++)
-      {
-        misorients[a][b] = 0;
-      }
-    }
-    while(newxshift != oldxshift || newyshift != oldyshift)
-    {
-      oldxshift = newxshift;
-      oldyshift = newyshift;
-      for(int32_t j = -3; j < 4; j++)
-      {
-        for(int32_t k = -3; k < 4; k++)
-        {
-          disorientation = 0;
-          count = 0;
-          if(misorients[k + oldxshift + dims[0] / 2][j + oldyshift + dims[1] / 2] == 0 && llabs(k + oldxshift) < (dims[0] / 2) && (j + oldyshift) < (dims[1] / 2))
-          {
-            for(int64_t l = 0; l < dims[1]; l = l + 4)
-            {
-              for(int64_t n = 0; n < dims[0]; n = n + 4)
-              {
-                if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
-                {
-                  refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
-                  curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
-                  refgnum = miFeatureIds[refposition];
-                  curgnum = miFeatureIds[curposition];
-                  if(curgnum >= 0 && refgnum >= 0)
-                  {
-                    mutualinfo12[curgnum][refgnum]++;
-                    mutualinfo1[curgnum]++;
-                    mutualinfo2[refgnum]++;
-                    count++;
-                  }
-                }
-                else
-                {
-                  mutualinfo12[0][0]++;
-                  mutualinfo1[0]++;
-                  mutualinfo2[0]++;
-                }
-              }
-            }
-            float ha = 0.0f;
-            float hb = 0.0f;
-            float hab = 0.0f;
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              mutualinfo1[b] = mutualinfo1[b] / count;
-              if(mutualinfo1[b] != 0)
-              {
-                ha = ha + mutualinfo1[b] * logf(mutualinfo1[b]);
-              }
-            }
-            for(int32_t c = 0; c < featurecount2; c++)
-            {
-              mutualinfo2[c] = mutualinfo2[c] / float(count);
-              if(mutualinfo2[c] != 0)
-              {
-                hb = hb + mutualinfo2[c] * logf(mutualinfo2[c]);
-              }
-            }
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              for(int32_t c = 0; c < featurecount2; c++)
-              {
-                mutualinfo12[b][c] = mutualinfo12[b][c] / count;
-                if(mutualinfo12[b][c] != 0)
-                {
-                  hab = hab + mutualinfo12[b][c] * logf(mutualinfo12[b][c]);
-                }
-                float value = 0.0f;
-                if(mutualinfo1[b] > 0 && mutualinfo2[c] > 0)
-                {
-                  value = (mutualinfo12[b][c] / (mutualinfo1[b] * mutualinfo2[c]));
-                }
-                if(value != 0)
-                {
-                  disorientation = disorientation + (mutualinfo12[b][c] * logf(value));
-                }
-              }
-            }
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              for(int32_t c = 0; c < featurecount2; c++)
-              {
-                mutualinfo12[b][c] = 0.0f;
-                mutualinfo1[b] = 0.0f;
-                mutualinfo2[c] = 0.0f;
-              }
-            }
-            disorientation = 1.0f / disorientation;
-            misorients[k + oldxshift + dims[0] / 2][j + oldyshift + dims[1] / 2] = disorientation;
-            if(disorientation < mindisorientation)
-            {
-              newxshift = k + oldxshift;
-              newyshift = j + oldyshift;
-              mindisorientation = disorientation;
-            }
-          }
-        }
-      }
-    }
-    xshifts[iter] = xshifts[iter - 1] + newxshift;
-    yshifts[iter] = yshifts[iter - 1] + newyshift;
-    if(getWriteAlignmentShifts() == true)
-    {
-      outFile << slice << "	" << slice + 1 << "	" << newxshift << "	" << newyshift << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
-    }
-    delete[] mutualinfo1;
-    delete[] mutualinfo2;
-    for(int32_t i = 0; i < featurecount1; i++)
-    {
-      delete mutualinfo12[i];
-    }
-    delete[] mutualinfo12;
-    mutualinfo1 = nullptr;
-    mutualinfo2 = nullptr;
-    mutualinfo12 = nullptr;
-  }
-
-  m->getAttributeMatrix(getCellAttributeMatrixName())->removeAttributeArray(SIMPL::CellData::FeatureIds);
-
-  if(getWriteAlignmentShifts() == true)
-  {
-    outFile.close();
-  }
+  SectionShiftCostPointer cost(
+      new AlignSectionsMutualInformationDetail::MutualInformationCost(m_MIFeaturesPtr->getPointer(0), featurecounts[slice], featurecounts[slice + 1], dims, slice));
+  return cost;
 }
 
 // -----------------------------------------------------------------------------
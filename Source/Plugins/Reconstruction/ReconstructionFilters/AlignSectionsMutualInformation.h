@@ -160,6 +160,11 @@ class AlignSectionsMutualInformation : public AlignSections
      */
     void form_features_sections();
 
+    /**
+     * @brief create_shift_cost Reimplemented from @see AlignSections class
+     */
+    virtual SectionShiftCostPointer create_shift_cost(int64_t slice);
+
   private:
     //DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
     DEFINE_DATAARRAY_VARIABLE(float, Quats)
@@ -39,6 +39,7 @@
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
@@ -65,6 +66,14 @@ public:
   {
     return false;
   }
+
+  /**
+   * @brief compare Performs the comparison without assigning any Feature Id
+   */
+  virtual bool compare(int64_t index, int64_t neighIndex)
+  {
+    return false;
+  }
 };
 
 /**
@@ -84,6 +93,16 @@ public:
   }
 
   virtual bool operator()(int64_t referencepoint, int64_t neighborpoint, int32_t gnum)
+  {
+    if(compare(referencepoint, neighborpoint) == true)
+    {
+      m_FeatureIds[neighborpoint] = gnum;
+      return true;
+    }
+    return false;
+  }
+
+  virtual bool compare(int64_t referencepoint, int64_t neighborpoint)
   {
     // Sanity check the indices that are being passed in.
     if(referencepoint >= m_Length || neighborpoint >= m_Length)
@@ -91,12 +110,7 @@ public:
       return false;
     }
 
-    if(m_Data[neighborpoint] == m_Data[referencepoint])
-    {
-      m_FeatureIds[neighborpoint] = gnum;
-      return true;
-    }
-    return false;
+    return m_Data[neighborpoint] == m_Data[referencepoint];
   }
 
 protected:
@@ -128,6 +142,16 @@ public:
   }
 
   virtual bool operator()(int64_t referencepoint, int64_t neighborpoint, int32_t gnum)
+  {
+    if(compare(referencepoint, neighborpoint) == true)
+    {
+      m_FeatureIds[neighborpoint] = gnum;
+      return true;
+    }
+    return false;
+  }
+
+  virtual bool compare(int64_t referencepoint, int64_t neighborpoint)
   {
     // Sanity check the indices that are being passed in.
     if(referencepoint >= m_Length || neighborpoint >= m_Length)
@@ -137,21 +161,9 @@ public:
 
     if(m_Data[referencepoint] >= m_Data[neighborpoint])
     {
-      if((m_Data[referencepoint] - m_Data[neighborpoint]) <= m_Tolerance)
-      {
-        m_FeatureIds[neighborpoint] = gnum;
-        return true;
-      }
-    }
-    else
-    {
-      if((m_Data[neighborpoint] - m_Data[referencepoint]) <= m_Tolerance)
-      {
-        m_FeatureIds[neighborpoint] = gnum;
-        return true;
-      }
+      return (m_Data[referencepoint] - m_Data[neighborpoint]) <= m_Tolerance;
     }
-    return false;
+    return (m_Data[neighborpoint] - m_Data[referencepoint]) <= m_Tolerance;
   }
 
 protected:
@@ -206,6 +218,7 @@ void ScalarSegmentFeatures::setupFilterParameters()
   QStringList linkedProps("GoodVoxelsArrayPath");
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Scalar Tolerance", ScalarTolerance, FilterParameter::Parameter, ScalarSegmentFeatures));
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask Array", UseGoodVoxels, FilterParameter::Parameter, ScalarSegmentFeatures, linkedProps));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Parallel Labeling", UseParallelLabeling, FilterParameter::Parameter, ScalarSegmentFeatures));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req =
@@ -240,6 +253,7 @@ void ScalarSegmentFeatures::readFilterParameters(AbstractFilterParametersReader*
   setFeatureIdsArrayName(reader->readString("FeatureIdsArrayName", getFeatureIdsArrayName()));
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
   setUseGoodVoxels(reader->readValue("UseGoodVoxels", getUseGoodVoxels()));
+  setUseParallelLabeling(reader->readValue("UseParallelLabeling", getUseParallelLabeling()));
   setScalarArrayPath(reader->readDataArrayPath("ScalarArrayPath", getScalarArrayPath()));
   setScalarTolerance(reader->readValue("ScalarTolerance", getScalarTolerance()));
   reader->closeFilterGroup();
@@ -420,7 +434,7 @@ int64_t ScalarSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   {
     if(m_FeatureIds[randpoint] == 0) // If the GrainId of the voxel is ZERO then we can use this as a seed point
     {
-      if(m_UseGoodVoxels == false || m_GoodVoxels[randpoint] == true)
+      if(isSeedCandidate(randpoint) == true)
       {
         seed = randpoint;
       }
@@ -444,6 +458,22 @@ int64_t ScalarSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   return seed;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ScalarSegmentFeatures::isSeedCandidate(int64_t point)
+{
+  return m_UseGoodVoxels == false || m_GoodVoxels[point] == true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ScalarSegmentFeatures::isGroupable(int64_t referencepoint, int64_t neighborpoint)
+{
+  return m_Compare->compare(referencepoint, neighborpoint);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -461,6 +491,25 @@ bool ScalarSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t ne
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t* ScalarSegmentFeatures::getFeatureIdsPointer()
+{
+  return m_FeatureIds;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ScalarSegmentFeatures::resizeFeatureAttributeMatrix(size_t numTuples)
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+  QVector<size_t> tDims(1, numTuples);
+  m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -170,6 +170,26 @@ class ScalarSegmentFeatures : public SegmentFeatures
      */
     virtual bool determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum);
 
+    /**
+     * @brief isSeedCandidate Reimplemented from @see SegmentFeatures class
+     */
+    virtual bool isSeedCandidate(int64_t point);
+
+    /**
+     * @brief isGroupable Reimplemented from @see SegmentFeatures class
+     */
+    virtual bool isGroupable(int64_t referencepoint, int64_t neighborpoint);
+
+    /**
+     * @brief getFeatureIdsPointer Reimplemented from @see SegmentFeatures class
+     */
+    virtual int32_t* getFeatureIdsPointer();
+
+    /**
+     * @brief resizeFeatureAttributeMatrix Reimplemented from @see SegmentFeatures class
+     */
+    virtual void resizeFeatureAttributeMatrix(size_t numTuples);
+
   private:
     DEFINE_DATAARRAY_VARIABLE(bool, GoodVoxels)
     DEFINE_IDATAARRAY_VARIABLE(InputData)
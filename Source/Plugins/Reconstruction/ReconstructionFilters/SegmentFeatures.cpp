@@ -35,13 +35,157 @@
 
 #include "SegmentFeatures.h"
 
+#include <algorithm>
+#include <vector>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "Reconstruction/ReconstructionFilters/util/VoxelNeighborhood.hpp"
+
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
 
+namespace
+{
+/**
+ * @brief findRoot Returns the root of the union-find tree containing the given point, halving the
+ * path along the way
+ */
+int64_t findRoot(int64_t* parents, int64_t point)
+{
+  while(parents[point] != point)
+  {
+    parents[point] = parents[parents[point]];
+    point = parents[point];
+  }
+  return point;
+}
+
+/**
+ * @brief unite Merges the trees containing the two points. The lower root always wins so that the root
+ * of every tree is the lowest point index of its Feature
+ */
+void unite(int64_t* parents, int64_t point1, int64_t point2)
+{
+  int64_t root1 = findRoot(parents, point1);
+  int64_t root2 = findRoot(parents, point2);
+  if(root1 < root2)
+  {
+    parents[root2] = root1;
+  }
+  else if(root2 < root1)
+  {
+    parents[root1] = root2;
+  }
+}
+}
+
+/**
+ * @brief The SegmentFeaturesUnionFindImpl class labels independent slabs of contiguous rows of a grid
+ * with a union-find over the backward face neighbors of each point. Links that cross into the previous
+ * slab are only evaluated here and recorded, so that the serial seam merge does no comparisons.
+ */
+class SegmentFeaturesUnionFindImpl
+{
+public:
+  SegmentFeaturesUnionFindImpl(SegmentFeatures* filter, int64_t* parents, int64_t* dims, int64_t rowsPerSlab, std::vector<std::vector<int64_t>>* seamLinks)
+  : m_Filter(filter)
+  , m_Parents(parents)
+  , m_Dims(dims)
+  , m_RowsPerSlab(rowsPerSlab)
+  , m_SeamLinks(seamLinks)
+  {
+  }
+  virtual ~SegmentFeaturesUnionFindImpl()
+  {
+  }
+
+  void label(int64_t slabStart, int64_t slabEnd) const
+  {
+    int64_t totalRows = m_Dims[1] * m_Dims[2];
+    int64_t planeSize = m_Dims[0] * m_Dims[1];
+    for(int64_t slab = slabStart; slab < slabEnd; slab++)
+    {
+      int64_t rowStart = slab * m_RowsPerSlab;
+      int64_t rowEnd = std::min(rowStart + m_RowsPerSlab, totalRows);
+      int64_t firstPoint = rowStart * m_Dims[0];
+      std::vector<int64_t>& seam = (*m_SeamLinks)[slab];
+
+      for(int64_t r = rowStart; r < rowEnd; r++)
+      {
+        int64_t row = r % m_Dims[1];
+        int64_t plane = r / m_Dims[1];
+        for(int64_t col = 0; col < m_Dims[0]; col++)
+        {
+          int64_t point = r * m_Dims[0] + col;
+          if(m_Filter->isSeedCandidate(point) == false)
+          {
+            m_Parents[point] = -1;
+            continue;
+          }
+          m_Parents[point] = point;
+
+          int64_t neighbors[3] = {-1, -1, -1};
+          if(col > 0)
+          {
+            neighbors[0] = point - 1;
+          }
+          if(row > 0)
+          {
+            neighbors[1] = point - m_Dims[0];
+          }
+          if(plane > 0)
+          {
+            neighbors[2] = point - planeSize;
+          }
+          for(int32_t i = 0; i < 3; i++)
+          {
+            int64_t neighbor = neighbors[i];
+            if(neighbor < 0)
+            {
+              continue;
+            }
+            if(neighbor >= firstPoint)
+            {
+              if(m_Parents[neighbor] >= 0 && m_Filter->isGroupable(neighbor, point) == true)
+              {
+                unite(m_Parents, neighbor, point);
+              }
+            }
+            else if(m_Filter->isSeedCandidate(neighbor) == true && m_Filter->isGroupable(neighbor, point) == true)
+            {
+              seam.push_back(neighbor);
+              seam.push_back(point);
+            }
+          }
+        }
+      }
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<int64_t>& r) const
+  {
+    label(r.begin(), r.end());
+  }
+#endif
+private:
+  SegmentFeatures* m_Filter;
+  int64_t* m_Parents;
+  int64_t* m_Dims;
+  int64_t m_RowsPerSlab;
+  std::vector<std::vector<int64_t>>* m_SeamLinks;
+};
+
 // Include the MOC generated file for this class
 #include "moc_SegmentFeatures.cpp"
 
@@ -51,6 +195,7 @@
 SegmentFeatures::SegmentFeatures()
 : AbstractFilter()
 , m_DataContainerName(SIMPL::Defaults::ImageDataContainerName)
+, m_UseParallelLabeling(false)
 {
 }
 
@@ -116,6 +261,137 @@ bool SegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neighbor
   return false;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SegmentFeatures::isSeedCandidate(int64_t point)
+{
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SegmentFeatures::isGroupable(int64_t referencepoint, int64_t neighborpoint)
+{
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t* SegmentFeatures::getFeatureIdsPointer()
+{
+  return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SegmentFeatures::resizeFeatureAttributeMatrix(size_t numTuples)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SegmentFeatures::executeParallelLabeling(int64_t dims[3])
+{
+  int32_t* featureIds = getFeatureIdsPointer();
+  if(nullptr == featureIds)
+  {
+    return;
+  }
+
+  int64_t totalPoints = dims[0] * dims[1] * dims[2];
+  int64_t totalRows = dims[1] * dims[2];
+  if(totalPoints == 0)
+  {
+    return;
+  }
+
+  // Split the grid into slabs of whole planes when there is more than one plane, otherwise into groups of
+  // rows. The slab layout only affects the amount of parallelism, never the resulting Feature Ids
+  const int64_t k_SlabsPerThread = 4;
+  int64_t numThreads = 1;
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  numThreads = static_cast<int64_t>(tbb::task_scheduler_init::default_num_threads());
+#endif
+  int64_t targetSlabs = numThreads * k_SlabsPerThread;
+  int64_t rowsPerSlab = 0;
+  if(dims[2] > 1)
+  {
+    rowsPerSlab = dims[1] * ((dims[2] + targetSlabs - 1) / targetSlabs);
+  }
+  else
+  {
+    rowsPerSlab = (totalRows + targetSlabs - 1) / targetSlabs;
+  }
+  int64_t numSlabs = (totalRows + rowsPerSlab - 1) / rowsPerSlab;
+
+  std::vector<int64_t> parents(totalPoints, -1);
+  std::vector<std::vector<int64_t>> seamLinks(numSlabs);
+
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), QObject::tr("Labeling %1 Slabs").arg(numSlabs));
+
+  SegmentFeaturesUnionFindImpl slabLabeler(this, parents.data(), dims, rowsPerSlab, &seamLinks);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if(numThreads > 1)
+  {
+    tbb::parallel_for(tbb::blocked_range<int64_t>(0, numSlabs, 1), slabLabeler, tbb::simple_partitioner());
+  }
+  else
+#endif
+  {
+    slabLabeler.label(0, numSlabs);
+  }
+
+  if(getCancel())
+  {
+    return;
+  }
+
+  // Merge the seams between the slabs; the comparisons were already made by the slab labeler
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), "Merging Slab Seams");
+  for(int64_t slab = 1; slab < numSlabs; slab++)
+  {
+    std::vector<int64_t>& seam = seamLinks[slab];
+    for(size_t i = 0; i < seam.size(); i += 2)
+    {
+      unite(parents.data(), seam[i], seam[i + 1]);
+    }
+    std::vector<int64_t>().swap(seam);
+  }
+
+  // Number the Features in order of their lowest point index, which is the order the serial burn
+  // algorithm visits its seeds in. Every root is the lowest index of its tree so it is numbered first.
+  int32_t gnum = 0;
+  for(int64_t i = 0; i < totalPoints; i++)
+  {
+    if(parents[i] < 0)
+    {
+      featureIds[i] = 0;
+      continue;
+    }
+    int64_t root = findRoot(parents.data(), i);
+    if(root == i)
+    {
+      gnum++;
+      featureIds[i] = gnum;
+    }
+    else
+    {
+      featureIds[i] = featureIds[root];
+    }
+  }
+
+  QString ss = QObject::tr("Total Features: %1").arg(gnum + 1);
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+
+  resizeFeatureAttributeMatrix(static_cast<size_t>(gnum) + 1);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -137,21 +413,19 @@ void SegmentFeatures::execute()
       static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
   };
 
+  if(getUseParallelLabeling())
+  {
+    executeParallelLabeling(dims);
+    notifyStatusMessage(getHumanLabel(), "Complete");
+    return;
+  }
+
   int32_t gnum = 1;
   int64_t seed = 0;
-  int64_t neighbor = 0;
-  bool good = 0;
-  int64_t col = 0, row = 0, plane = 0;
   size_t size = 0;
   size_t initialVoxelsListSize = 100000;
   std::vector<int64_t> voxelslist(initialVoxelsListSize, -1);
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -(dims[0] * dims[1]);
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = (dims[0] * dims[1]);
+  VoxelNeighborhood<6> neighborhood(dims);
   int64_t nextSeed = 0;
 
   while(seed >= 0)
@@ -167,59 +441,26 @@ void SegmentFeatures::execute()
       {
         int64_t currentpoint = voxelslist[size - 1];
         size -= 1;
-        col = currentpoint % dims[0];
-        row = (currentpoint / dims[0]) % dims[1];
-        plane = currentpoint / (dims[0] * dims[1]);
-        for(int32_t i = 0; i < 6; i++)
-        {
-          good = true;
-          neighbor = currentpoint + neighpoints[i];
-          if(i == 0 && plane == 0)
-          {
-            good = false;
-          }
-          if(i == 5 && plane == (dims[2] - 1))
-          {
-            good = false;
-          }
-          if(i == 1 && row == 0)
-          {
-            good = false;
-          }
-          if(i == 4 && row == (dims[1] - 1))
-          {
-            good = false;
-          }
-          if(i == 2 && col == 0)
+        neighborhood.forEachNeighbor(currentpoint, [&](int32_t, int64_t neighbor) {
+          if(determineGrouping(currentpoint, neighbor, gnum) == true)
           {
-            good = false;
-          }
-          if(i == 3 && col == (dims[0] - 1))
-          {
-            good = false;
-          }
-          if(good == true)
-          {
-            if(determineGrouping(currentpoint, neighbor, gnum) == true)
+            voxelslist[size] = neighbor;
+            size++;
+            if(neighbor == nextSeed)
             {
-              voxelslist[size] = neighbor;
-              size++;
-              if(neighbor == nextSeed)
-              {
-                nextSeed = neighbor + 1;
-              }
-              if(size >= voxelslist.size())
+              nextSeed = neighbor + 1;
+            }
+            if(size >= voxelslist.size())
+            {
+              size = voxelslist.size();
+              voxelslist.resize(size + initialVoxelsListSize);
+              for(std::vector<int64_t>::size_type j = size; j < voxelslist.size(); ++j)
               {
-                size = voxelslist.size();
-                voxelslist.resize(size + initialVoxelsListSize);
-                for(std::vector<int64_t>::size_type j = size; j < voxelslist.size(); ++j)
-                {
-                  voxelslist[j] = -1;
-                }
+                voxelslist[j] = -1;
               }
             }
           }
-        }
+        });
       }
       voxelslist.clear();
       voxelslist.resize(initialVoxelsListSize, -1);
@@ -60,6 +60,9 @@ class SegmentFeatures : public AbstractFilter
 
     SIMPL_INSTANCE_STRING_PROPERTY(DataContainerName)
 
+    SIMPL_FILTER_PARAMETER(bool, UseParallelLabeling)
+    Q_PROPERTY(bool UseParallelLabeling READ getUseParallelLabeling WRITE setUseParallelLabeling)
+
     /**
      * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
      */
@@ -167,7 +170,48 @@ class SegmentFeatures : public AbstractFilter
      */
     virtual bool determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum);
 
+    /**
+     * @brief isSeedCandidate Determines if a point may belong to any Feature at all (mask, phase, etc.). Used
+     * by the parallel labeling mode and must not depend on the current Feature Ids
+     * @param point Point to check
+     * @return Boolean check for whether the point may be segmented
+     */
+    virtual bool isSeedCandidate(int64_t point);
+
+    /**
+     * @brief isGroupable Side-effect free version of the grouping criterion used by @see determineGrouping.
+     * Both points are already known to be seed candidates. The criterion must be symmetric and thread safe
+     * @param referencepoint Point of growing seed
+     * @param neighborpoint Point to be compared for adding
+     * @return Boolean check for whether the two points belong to the same Feature
+     */
+    virtual bool isGroupable(int64_t referencepoint, int64_t neighborpoint);
+
+    /**
+     * @brief getFeatureIdsPointer Returns the raw pointer to the Feature Ids array being generated
+     * @return Feature Ids pointer
+     */
+    virtual int32_t* getFeatureIdsPointer();
+
+    /**
+     * @brief resizeFeatureAttributeMatrix Resizes the Feature Attribute Matrix after the parallel labeling
+     * mode has determined the total number of Features
+     * @param numTuples Number of Features, including the zeroth Feature
+     */
+    virtual void resizeFeatureAttributeMatrix(size_t numTuples);
+
   private:
+    friend class SegmentFeaturesUnionFindImpl;
+
+    /**
+     * @brief executeParallelLabeling Labels the connected components of the grouping criterion by running a
+     * union-find over independent slabs of the volume, merging the seams between the slabs and finally
+     * numbering the Features by their lowest voxel index. This produces the same Feature Ids as the serial
+     * burn algorithm for any number of threads
+     * @param dims Dimensions of the grid
+     */
+    void executeParallelLabeling(int64_t dims[3]);
+
     SegmentFeatures(const SegmentFeatures&); // Copy Constructor Not Implemented
     void operator=(const SegmentFeatures&); // Operator '=' Not Implemented
 };
@@ -170,6 +170,10 @@ class SineParamsSegmentFeatures : public SegmentFeatures
 
     virtual int64_t getSeed(int32_t gnum, int64_t nextSeed);
     virtual bool determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum);
+    virtual bool isSeedCandidate(int64_t point);
+    virtual bool isGroupable(int64_t referencepoint, int64_t neighborpoint);
+    virtual int32_t* getFeatureIdsPointer();
+    virtual void resizeFeatureAttributeMatrix(size_t numTuples);
 
   private:
     IDataArray::Pointer m_InputData;
@@ -0,0 +1,397 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _tupleremap_hpp_
+#define _tupleremap_hpp_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+
+// The Processing and Reconstruction plugins each carry an identical copy of this header so that
+// no plugin includes the sources of another one. Keep the copies in sync.
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+/**
+ * @brief The TupleRemap class moves tuples around in every array of an Attribute Matrix at once. The arrays
+ * are resolved and cast to their element type once, when the TupleRemap is built, so moving a tuple is a
+ * typed copy of its components instead of a name lookup in the Attribute Matrix followed by a virtual
+ * IDataArray::copyTuple() for every voxel and every array. Whole rows of an Image Geometry are moved with
+ * memmove(). The arrays (and for the tuple lists, ranges of the list) are processed in parallel.
+ *
+ * Arrays that are not a DataArray of a primitive type (e.g. strings) fall back to IDataArray::copyTuple().
+ */
+class TupleRemap
+{
+public:
+  explicit TupleRemap(const QVector<IDataArray::Pointer>& arrays)
+  {
+    for(int32_t i = 0; i < arrays.size(); i++)
+    {
+      addArray(arrays[i]);
+    }
+  }
+
+  explicit TupleRemap(AttributeMatrix::Pointer attrMat)
+  {
+    QList<QString> names = attrMat->getAttributeArrayNames();
+    for(QList<QString>::iterator iter = names.begin(); iter != names.end(); ++iter)
+    {
+      addArray(attrMat->getAttributeArray(*iter));
+    }
+  }
+
+  virtual ~TupleRemap()
+  {
+  }
+
+  /**
+   * @brief Copies tuple sources[i] onto tuple destinations[i] in every array. A tuple must not be both a
+   * source and a destination in the same call, so the copies can be done in any order.
+   */
+  void copyTuples(const int64_t* sources, const int64_t* destinations, size_t count)
+  {
+    if(count == 0 || m_Arrays.empty())
+    {
+      return;
+    }
+    size_t numChunks = (count + k_ChunkSize - 1) / k_ChunkSize;
+    CopyTuplesImpl impl(m_Arrays, sources, destinations, count, numChunks);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, m_Arrays.size() * numChunks, 1), impl, tbb::simple_partitioner());
+    }
+    else
+#endif
+    {
+      impl.convert(0, m_Arrays.size() * numChunks);
+    }
+  }
+
+  void copyTuples(const std::vector<int64_t>& sources, const std::vector<int64_t>& destinations)
+  {
+    copyTuples(sources.data(), destinations.data(), std::min(sources.size(), destinations.size()));
+  }
+
+  /**
+   * @brief Shifts every Z slice of an Image Geometry with dimensions dims in X and Y. After the shift the
+   * tuple at (x, y, z) holds what was at (x + xShifts[z], y + yShifts[z], z). Tuples whose source lies
+   * outside of the slice are set to zero (left unchanged for arrays that are not primitive DataArrays).
+   */
+  void shiftSlices(const size_t dims[3], const std::vector<int64_t>& xShifts, const std::vector<int64_t>& yShifts)
+  {
+    if(m_Arrays.empty() || dims[2] == 0)
+    {
+      return;
+    }
+    ShiftSlicesImpl impl(m_Arrays, dims, xShifts.data(), yShifts.data());
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, m_Arrays.size() * dims[2], 1), impl, tbb::simple_partitioner());
+    }
+    else
+#endif
+    {
+      impl.convert(0, m_Arrays.size() * dims[2]);
+    }
+  }
+
+protected:
+  static const size_t k_ChunkSize = 65536;
+
+  /**
+   * @brief Moves the tuples of one array
+   */
+  class ArrayRemap
+  {
+  public:
+    virtual ~ArrayRemap()
+    {
+    }
+    virtual void copyTuples(const int64_t* sources, const int64_t* destinations, size_t start, size_t end) = 0;
+    virtual void shiftSlice(const size_t dims[3], size_t z, int64_t xShift, int64_t yShift) = 0;
+  };
+  typedef std::shared_ptr<ArrayRemap> ArrayRemapPointer;
+
+  template <typename T>
+  class TypedArrayRemap : public ArrayRemap
+  {
+  public:
+    TypedArrayRemap(T* data, size_t numComponents)
+    : m_Data(data)
+    , m_NumComponents(numComponents)
+    {
+    }
+    virtual ~TypedArrayRemap()
+    {
+    }
+
+    virtual void copyTuples(const int64_t* sources, const int64_t* destinations, size_t start, size_t end)
+    {
+      if(m_NumComponents == 1)
+      {
+        for(size_t i = start; i < end; i++)
+        {
+          m_Data[destinations[i]] = m_Data[sources[i]];
+        }
+        return;
+      }
+      for(size_t i = start; i < end; i++)
+      {
+        T* dest = m_Data + destinations[i] * m_NumComponents;
+        const T* src = m_Data + sources[i] * m_NumComponents;
+        std::copy(src, src + m_NumComponents, dest);
+      }
+    }
+
+    virtual void shiftSlice(const size_t dims[3], size_t z, int64_t xShift, int64_t yShift)
+    {
+      if(xShift == 0 && yShift == 0)
+      {
+        return;
+      }
+      int64_t xPoints = static_cast<int64_t>(dims[0]);
+      int64_t yPoints = static_cast<int64_t>(dims[1]);
+      size_t rowSize = dims[0] * m_NumComponents;
+      T* slice = m_Data + z * dims[1] * rowSize;
+      // Destination x range whose source x + xShift lies inside the row
+      int64_t xBegin = std::min(xPoints, std::max(static_cast<int64_t>(0), -xShift));
+      int64_t xEnd = std::max(xBegin, std::min(xPoints, xPoints - xShift));
+
+      // Walk the rows in the direction of the shift so every source row is read before it is overwritten
+      for(int64_t l = 0; l < yPoints; l++)
+      {
+        int64_t y = (yShift >= 0) ? l : yPoints - 1 - l;
+        int64_t srcY = y + yShift;
+        T* dest = slice + y * rowSize;
+        if(srcY < 0 || srcY >= yPoints || xBegin == xEnd)
+        {
+          std::fill(dest, dest + rowSize, static_cast<T>(0));
+          continue;
+        }
+        const T* src = slice + srcY * rowSize;
+        ::memmove(dest + xBegin * m_NumComponents, src + (xBegin + xShift) * m_NumComponents, (xEnd - xBegin) * m_NumComponents * sizeof(T));
+        std::fill(dest, dest + xBegin * m_NumComponents, static_cast<T>(0));
+        std::fill(dest + xEnd * m_NumComponents, dest + rowSize, static_cast<T>(0));
+      }
+    }
+
+  private:
+    T* m_Data;
+    size_t m_NumComponents;
+  };
+
+  class GenericArrayRemap : public ArrayRemap
+  {
+  public:
+    explicit GenericArrayRemap(IDataArray::Pointer array)
+    : m_Array(array)
+    {
+    }
+    virtual ~GenericArrayRemap()
+    {
+    }
+
+    virtual void copyTuples(const int64_t* sources, const int64_t* destinations, size_t start, size_t end)
+    {
+      for(size_t i = start; i < end; i++)
+      {
+        m_Array->copyTuple(static_cast<size_t>(sources[i]), static_cast<size_t>(destinations[i]));
+      }
+    }
+
+    virtual void shiftSlice(const size_t dims[3], size_t z, int64_t xShift, int64_t yShift)
+    {
+      int64_t xPoints = static_cast<int64_t>(dims[0]);
+      int64_t yPoints = static_cast<int64_t>(dims[1]);
+      size_t sliceStart = z * dims[0] * dims[1];
+      for(int64_t l = 0; l < yPoints; l++)
+      {
+        int64_t y = (yShift >= 0) ? l : yPoints - 1 - l;
+        for(int64_t n = 0; n < xPoints; n++)
+        {
+          int64_t x = (xShift >= 0) ? n : xPoints - 1 - n;
+          if(y + yShift >= 0 && y + yShift < yPoints && x + xShift >= 0 && x + xShift < xPoints)
+          {
+            m_Array->copyTuple(sliceStart + (y + yShift) * xPoints + x + xShift, sliceStart + y * xPoints + x);
+          }
+        }
+      }
+    }
+
+  private:
+    IDataArray::Pointer m_Array;
+  };
+
+  template <typename T>
+  bool addTypedArray(IDataArray::Pointer array)
+  {
+    typename DataArray<T>::Pointer typed = std::dynamic_pointer_cast<DataArray<T>>(array);
+    if(nullptr == typed.get())
+    {
+      return false;
+    }
+    m_Arrays.push_back(ArrayRemapPointer(new TypedArrayRemap<T>(typed->getPointer(0), static_cast<size_t>(typed->getNumberOfComponents()))));
+    return true;
+  }
+
+  void addArray(IDataArray::Pointer array)
+  {
+    if(nullptr == array.get() || array->getNumberOfTuples() == 0)
+    {
+      return;
+    }
+    if(addTypedArray<int8_t>(array) || addTypedArray<uint8_t>(array) || addTypedArray<int16_t>(array) || addTypedArray<uint16_t>(array) || addTypedArray<int32_t>(array) ||
+       addTypedArray<uint32_t>(array) || addTypedArray<int64_t>(array) || addTypedArray<uint64_t>(array) || addTypedArray<float>(array) || addTypedArray<double>(array) ||
+       addTypedArray<bool>(array))
+    {
+      return;
+    }
+    m_Arrays.push_back(ArrayRemapPointer(new GenericArrayRemap(array)));
+  }
+
+  /**
+   * @brief Each task copies one chunk of the tuple list in one array
+   */
+  class CopyTuplesImpl
+  {
+    const std::vector<ArrayRemapPointer>& m_Arrays;
+    const int64_t* m_Sources;
+    const int64_t* m_Destinations;
+    size_t m_Count;
+    size_t m_NumChunks;
+
+  public:
+    CopyTuplesImpl(const std::vector<ArrayRemapPointer>& arrays, const int64_t* sources, const int64_t* destinations, size_t count, size_t numChunks)
+    : m_Arrays(arrays)
+    , m_Sources(sources)
+    , m_Destinations(destinations)
+    , m_Count(count)
+    , m_NumChunks(numChunks)
+    {
+    }
+    virtual ~CopyTuplesImpl()
+    {
+    }
+
+    void convert(size_t start, size_t end) const
+    {
+      for(size_t task = start; task < end; task++)
+      {
+        size_t chunk = task % m_NumChunks;
+        size_t chunkEnd = std::min(m_Count, (chunk + 1) * k_ChunkSize);
+        m_Arrays[task / m_NumChunks]->copyTuples(m_Sources, m_Destinations, chunk * k_ChunkSize, chunkEnd);
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+  };
+
+  /**
+   * @brief Each task shifts one slice of one array
+   */
+  class ShiftSlicesImpl
+  {
+    const std::vector<ArrayRemapPointer>& m_Arrays;
+    const size_t* m_Dims;
+    const int64_t* m_XShifts;
+    const int64_t* m_YShifts;
+
+  public:
+    ShiftSlicesImpl(const std::vector<ArrayRemapPointer>& arrays, const size_t dims[3], const int64_t* xShifts, const int64_t* yShifts)
+    : m_Arrays(arrays)
+    , m_Dims(dims)
+    , m_XShifts(xShifts)
+    , m_YShifts(yShifts)
+    {
+    }
+    virtual ~ShiftSlicesImpl()
+    {
+    }
+
+    void convert(size_t start, size_t end) const
+    {
+      for(size_t task = start; task < end; task++)
+      {
+        size_t z = task % m_Dims[2];
+        m_Arrays[task / m_Dims[2]]->shiftSlice(m_Dims, z, m_XShifts[z], m_YShifts[z]);
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+  };
+
+private:
+  std::vector<ArrayRemapPointer> m_Arrays;
+
+  TupleRemap(const TupleRemap&);      // Copy Constructor Not Implemented
+  void operator=(const TupleRemap&); // Operator '=' Not Implemented
+};
+
+#endif /* _tupleremap_hpp_ */
@@ -0,0 +1,349 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _voxelneighborhood_hpp_
+#define _voxelneighborhood_hpp_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+// The Processing, Reconstruction and Statistics plugins each carry an identical copy of this header
+// so that no plugin includes the sources of another one. Keep the copies in sync.
+
+/**
+ * @brief The VoxelNeighborhood class describes the neighborhood of a voxel on a regular (Image) grid
+ * and visits the neighbors of a voxel without the per-neighbor boundary tests that were repeated in
+ * every filter. The template argument selects the connectivity: 6 (faces), 18 (faces and edges) or
+ * 26 (faces, edges and vertices).
+ *
+ * Neighbors are numbered in z-major, then y, then x order, which for 6 connectivity is the familiar
+ * -Z, -Y, -X, +X, +Y, +Z ordering of the neighpoints[6] arrays. Neighbors that can never exist because
+ * the grid is only one voxel thick along an axis (e.g. a 2D slice), or because that axis was switched
+ * off, are dropped up front, so a voxel in the middle of a 2D slice is still an interior voxel.
+ *
+ * Interior voxels have every neighbor inside the grid and are visited with no checks at all; only
+ * voxels on the outer shell of the grid go through the checked path. The forEachVoxel() sweep splits
+ * each row into its boundary and interior parts so callers never test per voxel either.
+ */
+template <int Connectivity = 6>
+class VoxelNeighborhood
+{
+  static_assert(Connectivity == 6 || Connectivity == 18 || Connectivity == 26, "VoxelNeighborhood supports 6, 18 or 26 connectivity");
+
+public:
+  static const int32_t k_MaxNeighbors = Connectivity;
+
+  VoxelNeighborhood(int64_t xPoints, int64_t yPoints, int64_t zPoints)
+  {
+    initialize(xPoints, yPoints, zPoints, true, true, true);
+  }
+
+  explicit VoxelNeighborhood(const int64_t dims[3])
+  {
+    initialize(dims[0], dims[1], dims[2], true, true, true);
+  }
+
+  explicit VoxelNeighborhood(const size_t dims[3])
+  {
+    initialize(static_cast<int64_t>(dims[0]), static_cast<int64_t>(dims[1]), static_cast<int64_t>(dims[2]), true, true, true);
+  }
+
+  /**
+   * @brief Builds a neighborhood that ignores neighbors along the disabled axes, as used by the
+   * filters that let the user erode or dilate along selected directions only
+   */
+  VoxelNeighborhood(const int64_t dims[3], bool xDirOn, bool yDirOn, bool zDirOn)
+  {
+    initialize(dims[0], dims[1], dims[2], xDirOn, yDirOn, zDirOn);
+  }
+
+  /**
+   * @brief Returns the number of neighbors that can exist on this grid
+   */
+  int32_t size() const
+  {
+    return m_NumNeighbors;
+  }
+
+  /**
+   * @brief Returns the neighbor number (in the full z, y, x ordered neighborhood) of the n'th active neighbor
+   */
+  int32_t direction(int32_t n) const
+  {
+    return m_Direction[n];
+  }
+
+  /**
+   * @brief Returns the linear index offset of the n'th active neighbor
+   */
+  int64_t offset(int32_t n) const
+  {
+    return m_Offsets[n];
+  }
+
+  /**
+   * @brief Returns the X, Y and Z steps of the n'th active neighbor
+   */
+  int32_t dx(int32_t n) const
+  {
+    return m_Delta[n][0];
+  }
+  int32_t dy(int32_t n) const
+  {
+    return m_Delta[n][1];
+  }
+  int32_t dz(int32_t n) const
+  {
+    return m_Delta[n][2];
+  }
+
+  /**
+   * @brief Returns whether every neighbor of the voxel at (x, y, z) lies inside the grid
+   */
+  bool isInterior(int64_t x, int64_t y, int64_t z) const
+  {
+    return isInteriorX(x) && isInteriorY(y) && isInteriorZ(z);
+  }
+
+  /**
+   * @brief Returns whether the n'th active neighbor of the voxel at (x, y, z) lies inside the grid
+   */
+  bool isValid(int32_t n, int64_t x, int64_t y, int64_t z) const
+  {
+    int64_t nx = x + m_Delta[n][0];
+    int64_t ny = y + m_Delta[n][1];
+    int64_t nz = z + m_Delta[n][2];
+    return nx >= 0 && nx < m_Dims[0] && ny >= 0 && ny < m_Dims[1] && nz >= 0 && nz < m_Dims[2];
+  }
+
+  /**
+   * @brief Splits a linear voxel index into its x, y and z coordinates
+   */
+  void toCoordinates(int64_t index, int64_t& x, int64_t& y, int64_t& z) const
+  {
+    x = index % m_Dims[0];
+    y = (index / m_Dims[0]) % m_Dims[1];
+    z = index / m_PlaneSize;
+  }
+
+  /**
+   * @brief Calls func(direction, neighborIndex) for every neighbor of an interior voxel without any
+   * boundary checks. The caller guarantees that the voxel is interior.
+   */
+  template <typename Func>
+  void forEachInteriorNeighbor(int64_t index, Func& func) const
+  {
+    for(int32_t n = 0; n < m_NumNeighbors; n++)
+    {
+      func(m_Direction[n], index + m_Offsets[n]);
+    }
+  }
+
+  /**
+   * @brief Calls func(direction, neighborIndex) for every neighbor of the voxel at (x, y, z) that lies
+   * inside the grid
+   */
+  template <typename Func>
+  void forEachBoundaryNeighbor(int64_t index, int64_t x, int64_t y, int64_t z, Func& func) const
+  {
+    for(int32_t n = 0; n < m_NumNeighbors; n++)
+    {
+      if(isValid(n, x, y, z))
+      {
+        func(m_Direction[n], index + m_Offsets[n]);
+      }
+    }
+  }
+
+  /**
+   * @brief Calls func(direction, neighborIndex) for every neighbor of the voxel at (x, y, z) that lies
+   * inside the grid, in neighbor order
+   */
+  template <typename Func>
+  void forEachNeighbor(int64_t index, int64_t x, int64_t y, int64_t z, Func func) const
+  {
+    if(isInterior(x, y, z))
+    {
+      forEachInteriorNeighbor(index, func);
+    }
+    else
+    {
+      forEachBoundaryNeighbor(index, x, y, z, func);
+    }
+  }
+
+  /**
+   * @brief Same as above for callers that already know whether the voxel is interior, e.g. from forEachVoxel()
+   */
+  template <typename Func>
+  void forEachNeighbor(int64_t index, int64_t x, int64_t y, int64_t z, bool interior, Func func) const
+  {
+    if(interior)
+    {
+      forEachInteriorNeighbor(index, func);
+    }
+    else
+    {
+      forEachBoundaryNeighbor(index, x, y, z, func);
+    }
+  }
+
+  /**
+   * @brief Calls func(direction, neighborIndex) for every neighbor of the voxel at index that lies
+   * inside the grid, in neighbor order
+   */
+  template <typename Func>
+  void forEachNeighbor(int64_t index, Func func) const
+  {
+    int64_t x = 0, y = 0, z = 0;
+    toCoordinates(index, x, y, z);
+    forEachNeighbor(index, x, y, z, func);
+  }
+
+  /**
+   * @brief Sweeps the rows [rowStart, rowEnd) of the grid, where row r holds the voxels with
+   * y = r % yPoints and z = r / yPoints, and calls func(index, x, y, z, interior) for every voxel. The
+   * interior flag is a compile time constant in each of the three loops a row is split into, so an
+   * inlined functor that branches on it gets its interior path with the checks removed.
+   */
+  template <typename Func>
+  void forEachVoxel(int64_t rowStart, int64_t rowEnd, Func func) const
+  {
+    int64_t xInteriorStart = m_Active[0] ? 1 : 0;
+    int64_t xInteriorEnd = m_Active[0] ? m_Dims[0] - 1 : m_Dims[0];
+    for(int64_t r = rowStart; r < rowEnd; r++)
+    {
+      int64_t y = r % m_Dims[1];
+      int64_t z = r / m_Dims[1];
+      int64_t offset = r * m_Dims[0];
+      if(!isInteriorY(y) || !isInteriorZ(z))
+      {
+        for(int64_t x = 0; x < m_Dims[0]; x++)
+        {
+          func(offset + x, x, y, z, false);
+        }
+        continue;
+      }
+      for(int64_t x = 0; x < xInteriorStart; x++)
+      {
+        func(offset + x, x, y, z, false);
+      }
+      for(int64_t x = xInteriorStart; x < xInteriorEnd; x++)
+      {
+        func(offset + x, x, y, z, true);
+      }
+      for(int64_t x = std::max(xInteriorEnd, xInteriorStart); x < m_Dims[0]; x++)
+      {
+        func(offset + x, x, y, z, false);
+      }
+    }
+  }
+
+  /**
+   * @brief Sweeps every voxel of the grid, see forEachVoxel(rowStart, rowEnd, func)
+   */
+  template <typename Func>
+  void forEachVoxel(Func func) const
+  {
+    forEachVoxel(0, m_Dims[1] * m_Dims[2], func);
+  }
+
+protected:
+  bool isInteriorX(int64_t x) const
+  {
+    return !m_Active[0] || (x > 0 && x < m_Dims[0] - 1);
+  }
+  bool isInteriorY(int64_t y) const
+  {
+    return !m_Active[1] || (y > 0 && y < m_Dims[1] - 1);
+  }
+  bool isInteriorZ(int64_t z) const
+  {
+    return !m_Active[2] || (z > 0 && z < m_Dims[2] - 1);
+  }
+
+  void initialize(int64_t xPoints, int64_t yPoints, int64_t zPoints, bool xDirOn, bool yDirOn, bool zDirOn)
+  {
+    m_Dims[0] = xPoints;
+    m_Dims[1] = yPoints;
+    m_Dims[2] = zPoints;
+    m_PlaneSize = xPoints * yPoints;
+    m_Active[0] = xDirOn && xPoints > 1;
+    m_Active[1] = yDirOn && yPoints > 1;
+    m_Active[2] = zDirOn && zPoints > 1;
+
+    // Number of non zero steps allowed for the connectivity
+    int32_t maxSteps = (Connectivity == 6) ? 1 : ((Connectivity == 18) ? 2 : 3);
+    int32_t direction = 0;
+    m_NumNeighbors = 0;
+    for(int32_t k = -1; k <= 1; k++)
+    {
+      for(int32_t j = -1; j <= 1; j++)
+      {
+        for(int32_t i = -1; i <= 1; i++)
+        {
+          int32_t steps = std::abs(i) + std::abs(j) + std::abs(k);
+          if(steps == 0 || steps > maxSteps)
+          {
+            continue;
+          }
+          bool possible = (i == 0 || m_Active[0]) && (j == 0 || m_Active[1]) && (k == 0 || m_Active[2]);
+          if(possible)
+          {
+            m_Direction[m_NumNeighbors] = direction;
+            m_Offsets[m_NumNeighbors] = k * m_PlaneSize + j * xPoints + i;
+            m_Delta[m_NumNeighbors][0] = static_cast<int8_t>(i);
+            m_Delta[m_NumNeighbors][1] = static_cast<int8_t>(j);
+            m_Delta[m_NumNeighbors][2] = static_cast<int8_t>(k);
+            m_NumNeighbors++;
+          }
+          direction++;
+        }
+      }
+    }
+  }
+
+private:
+  int64_t m_Dims[3];
+  int64_t m_PlaneSize;
+  bool m_Active[3];
+  int32_t m_NumNeighbors;
+  int32_t m_Direction[Connectivity];
+  int64_t m_Offsets[Connectivity];
+  int8_t m_Delta[Connectivity][3];
+};
+
+#endif /* _voxelneighborhood_hpp_ */
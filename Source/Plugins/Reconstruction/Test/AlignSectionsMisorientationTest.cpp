@@ -0,0 +1,231 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "ReconstructionTestFileLocations.h"
+
+class AlignSectionsMisorientationTest
+{
+
+  public:
+    AlignSectionsMisorientationTest() {}
+    virtual ~AlignSectionsMisorientationTest() {}
+
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void RemoveTestFiles()
+    {
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestFilterAvailability()
+    {
+      // Now instantiate the AlignSectionsMisorientation Filter from the FilterManager
+      QString filtName = "AlignSectionsMisorientation";
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+      if (nullptr == filterFactory.get())
+      {
+        std::stringstream ss;
+        ss << "The Reconstruction Requires the use of the " << filtName.toStdString() << " filter which is found in the Reconstruction Plugin";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+      return 0;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    bool MaskValue(int64_t x, int64_t y)
+    {
+      // A smooth, non periodic pattern so that the best alignment is unique
+      double value = sin(x * 0.11 + 1.3) * cos(y * 0.087) + 0.6 * sin((x + 2 * y) * 0.061) + 0.4 * cos((x - y) * 0.139 + 0.5);
+      return value > 0.1;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    DataContainerArray::Pointer CreateTestData(size_t xDim, size_t yDim, size_t zDim, const std::vector<int64_t>& xOffsets, const std::vector<int64_t>& yOffsets)
+    {
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      DataContainer::Pointer dc = DataContainer::New("Test");
+      dca->addDataContainer(dc);
+
+      ImageGeom::Pointer igeom = ImageGeom::New();
+      igeom->setDimensions(xDim, yDim, zDim);
+      dc->setGeometry(igeom);
+      QVector<size_t> dims(3, 0);
+      dims[0] = xDim;
+      dims[1] = yDim;
+      dims[2] = zDim;
+      AttributeMatrix::Pointer cellAM = AttributeMatrix::New(dims, "CellData", AttributeMatrix::Type::Cell);
+      dc->addAttributeMatrix(cellAM->getName(), cellAM);
+
+      // Every slice holds the same pattern of two orientations that are 30 degrees apart about Z, moved by the
+      // offsets of that slice. The Grain array records the pattern so that it can be checked after the alignment.
+      QVector<size_t> cDims(1, 4);
+      FloatArrayType::Pointer quats = FloatArrayType::CreateArray(xDim * yDim * zDim, cDims, "Quats", true);
+      Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(xDim * yDim * zDim, "Phases", true);
+      Int32ArrayType::Pointer grain = Int32ArrayType::CreateArray(xDim * yDim * zDim, "Grain", true);
+      float angle = 15.0f * SIMPLib::Constants::k_Pif / 180.0f;
+      for(size_t z = 0; z < zDim; z++)
+      {
+        for(size_t y = 0; y < yDim; y++)
+        {
+          for(size_t x = 0; x < xDim; x++)
+          {
+            size_t index = (z * yDim + y) * xDim + x;
+            bool rotated = MaskValue(static_cast<int64_t>(x) - xOffsets[z], static_cast<int64_t>(y) - yOffsets[z]);
+            quats->setComponent(index, 0, 0.0f);
+            quats->setComponent(index, 1, 0.0f);
+            quats->setComponent(index, 2, rotated ? sinf(angle) : 0.0f);
+            quats->setComponent(index, 3, rotated ? cosf(angle) : 1.0f);
+            phases->setValue(index, 1);
+            grain->setValue(index, rotated ? 2 : 1);
+          }
+        }
+      }
+      cellAM->addAttributeArray(quats->getName(), quats);
+      cellAM->addAttributeArray(phases->getName(), phases);
+      cellAM->addAttributeArray(grain->getName(), grain);
+
+      QVector<size_t> ensembleDims(1, 2);
+      AttributeMatrix::Pointer ensembleAM = AttributeMatrix::New(ensembleDims, "EnsembleData", AttributeMatrix::Type::CellEnsemble);
+      dc->addAttributeMatrix(ensembleAM->getName(), ensembleAM);
+      UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(2, "CrystalStructures", true);
+      crystalStructures->setValue(0, Ebsd::CrystalStructure::UnknownCrystalStructure);
+      crystalStructures->setValue(1, Ebsd::CrystalStructure::Cubic_High);
+      ensembleAM->addAttributeArray(crystalStructures->getName(), crystalStructures);
+
+      return dca;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void RunAlignment(DataContainerArray::Pointer dca, bool useCoarseToFineSearch)
+    {
+      QString filtName = "AlignSectionsMisorientation";
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+
+      AbstractFilter::Pointer filter = filterFactory->create();
+      filter->setDataContainerArray(dca);
+
+      QVariant variant;
+      variant.setValue(DataArrayPath("Test", "CellData", "Quats"));
+      bool ok = filter->setProperty("QuatsArrayPath", variant);
+      DREAM3D_REQUIRE_EQUAL(ok, true)
+      variant.setValue(DataArrayPath("Test", "CellData", "Phases"));
+      ok = filter->setProperty("CellPhasesArrayPath", variant);
+      DREAM3D_REQUIRE_EQUAL(ok, true)
+      variant.setValue(DataArrayPath("Test", "EnsembleData", "CrystalStructures"));
+      ok = filter->setProperty("CrystalStructuresArrayPath", variant);
+      DREAM3D_REQUIRE_EQUAL(ok, true)
+      ok = filter->setProperty("UseGoodVoxels", false);
+      DREAM3D_REQUIRE_EQUAL(ok, true)
+      ok = filter->setProperty("MisorientationTolerance", 5.0f);
+      DREAM3D_REQUIRE_EQUAL(ok, true)
+
+      ok = filter->setProperty("UseCoarseToFineSearch", useCoarseToFineSearch);
+      DREAM3D_REQUIRE_EQUAL(ok, true)
+
+      filter->execute();
+      int err = filter->getErrorCondition();
+      DREAM3D_REQUIRE(err >= 0)
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestAlignment()
+    {
+      // The coarse-to-fine search only has coarser levels for sections of at least 256 Cells in X and Y
+      size_t dims[2][3] = {{96, 80, 6}, {300, 280, 5}};
+      for(int32_t d = 0; d < 2; d++)
+      {
+        size_t xDim = dims[d][0];
+        size_t yDim = dims[d][1];
+        size_t zDim = dims[d][2];
+        std::vector<int64_t> xOffsets(zDim, 0);
+        std::vector<int64_t> yOffsets(zDim, 0);
+        int64_t margin = 0;
+        for(size_t z = 1; z < zDim; z++)
+        {
+          xOffsets[z] = xOffsets[z - 1] + static_cast<int64_t>((z * 7) % 5) - 2;
+          yOffsets[z] = yOffsets[z - 1] + static_cast<int64_t>((z * 3) % 5) - 2;
+          margin = std::max<int64_t>(margin, std::max<int64_t>(llabs(xOffsets[z] - xOffsets[zDim - 1]), llabs(yOffsets[z] - yOffsets[zDim - 1])));
+        }
+
+        for(int32_t coarseToFine = 0; coarseToFine < 2; coarseToFine++)
+        {
+          DataContainerArray::Pointer dca = CreateTestData(xDim, yDim, zDim, xOffsets, yOffsets);
+          RunAlignment(dca, coarseToFine == 1);
+
+          // Once aligned, every slice matches the last slice away from the edges that were shifted in
+          Int32ArrayType::Pointer grain = dca->getAttributeMatrix(DataArrayPath("Test", "CellData", ""))->getAttributeArrayAs<Int32ArrayType>("Grain");
+          DREAM3D_REQUIRE_VALID_POINTER(grain.get())
+          for(size_t z = 0; z < zDim; z++)
+          {
+            for(size_t y = margin; y < yDim - margin; y++)
+            {
+              for(size_t x = margin; x < xDim - margin; x++)
+              {
+                size_t index = (z * yDim + y) * xDim + x;
+                size_t refIndex = ((zDim - 1) * yDim + y) * xDim + x;
+                DREAM3D_REQUIRE_EQUAL(grain->getValue(index), grain->getValue(refIndex))
+              }
+            }
+          }
+        }
+      }
+
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+
+      DREAM3D_REGISTER_TEST( TestFilterAvailability() );
+
+      DREAM3D_REGISTER_TEST( TestAlignment() )
+
+      DREAM3D_REGISTER_TEST( RemoveTestFiles() )
+    }
+
+  private:
+    AlignSectionsMisorientationTest(const AlignSectionsMisorientationTest&); // Copy Constructor Not Implemented
+    void operator=(const AlignSectionsMisorientationTest&); // Operator '=' Not Implemented
+
+
+};
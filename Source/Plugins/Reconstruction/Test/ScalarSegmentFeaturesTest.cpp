@@ -0,0 +1,198 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+
+#include "ReconstructionTestFileLocations.h"
+
+class ScalarSegmentFeaturesTest
+{
+
+  public:
+    ScalarSegmentFeaturesTest() {}
+    virtual ~ScalarSegmentFeaturesTest() {}
+
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void RemoveTestFiles()
+    {
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestFilterAvailability()
+    {
+      // Now instantiate the ScalarSegmentFeatures Filter from the FilterManager
+      QString filtName = "ScalarSegmentFeatures";
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+      if (nullptr == filterFactory.get())
+      {
+        std::stringstream ss;
+        ss << "The Reconstruction Requires the use of the " << filtName.toStdString() << " filter which is found in the Reconstruction Plugin";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+      return 0;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    DataContainerArray::Pointer CreateTestData(size_t xDim, size_t yDim, size_t zDim)
+    {
+      DataContainerArray::Pointer dca = DataContainerArray::New();
+      DataContainer::Pointer dc = DataContainer::New("Test");
+      dca->addDataContainer(dc);
+
+      ImageGeom::Pointer igeom = ImageGeom::New();
+      igeom->setDimensions(xDim, yDim, zDim);
+      dc->setGeometry(igeom);
+      QVector<size_t> dims(3, 0);
+      dims[0] = xDim;
+      dims[1] = yDim;
+      dims[2] = zDim;
+      AttributeMatrix::Pointer cellAM = AttributeMatrix::New(dims, "CellData", AttributeMatrix::Type::Cell);
+      dc->addAttributeMatrix(cellAM->getName(), cellAM);
+
+      // Build a field of interleaved, irregularly shaped regions so that many Features cross the
+      // slab boundaries used by the parallel labeling
+      size_t totalPoints = xDim * yDim * zDim;
+      UInt8ArrayType::Pointer scalars = UInt8ArrayType::CreateArray(totalPoints, "Scalars", true);
+      for(size_t z = 0; z < zDim; z++)
+      {
+        for(size_t y = 0; y < yDim; y++)
+        {
+          for(size_t x = 0; x < xDim; x++)
+          {
+            size_t index = (z * yDim + y) * xDim + x;
+            uint8_t value = static_cast<uint8_t>(((x / 3 + (y * y) / 7 + (z * x) / 11) % 4) * 50);
+            if((index * 2654435761u) % 17 == 0)
+            {
+              value = 255;
+            }
+            scalars->setValue(index, value);
+          }
+        }
+      }
+      cellAM->addAttributeArray(scalars->getName(), scalars);
+
+      return dca;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    Int32ArrayType::Pointer RunSegmentation(DataContainerArray::Pointer dca, bool useParallelLabeling, size_t& numFeatures)
+    {
+      QString filtName = "ScalarSegmentFeatures";
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+
+      AbstractFilter::Pointer filter = filterFactory->create();
+      filter->setDataContainerArray(dca);
+
+      QVariant variant;
+      variant.setValue(DataArrayPath("Test", "CellData", "Scalars"));
+      bool ok = filter->setProperty("ScalarArrayPath", variant);
+      DREAM3D_REQUIRE_EQUAL(ok, true)
+
+      ok = filter->setProperty("ScalarTolerance", 10.0f);
+      DREAM3D_REQUIRE_EQUAL(ok, true)
+
+      ok = filter->setProperty("UseGoodVoxels", false);
+      DREAM3D_REQUIRE_EQUAL(ok, true)
+
+      ok = filter->setProperty("UseParallelLabeling", useParallelLabeling);
+      DREAM3D_REQUIRE_EQUAL(ok, true)
+
+      filter->execute();
+      int err = filter->getErrorCondition();
+      DREAM3D_REQUIRE(err >= 0)
+
+      AttributeMatrix::Pointer featureAM = dca->getAttributeMatrix(DataArrayPath("Test", SIMPL::Defaults::CellFeatureAttributeMatrixName, ""));
+      DREAM3D_REQUIRE_VALID_POINTER(featureAM.get())
+      numFeatures = featureAM->getNumberOfTuples();
+
+      AttributeMatrix::Pointer cellAM = dca->getAttributeMatrix(DataArrayPath("Test", "CellData", ""));
+      Int32ArrayType::Pointer featureIds = cellAM->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds);
+      DREAM3D_REQUIRE_VALID_POINTER(featureIds.get())
+      return featureIds;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int TestParallelLabeling()
+    {
+      size_t dims[3][3] = {{23, 17, 13}, {41, 29, 1}, {9, 1, 31}};
+      for(int32_t d = 0; d < 3; d++)
+      {
+        size_t serialFeatures = 0;
+        size_t parallelFeatures = 0;
+        Int32ArrayType::Pointer serialIds = RunSegmentation(CreateTestData(dims[d][0], dims[d][1], dims[d][2]), false, serialFeatures);
+        Int32ArrayType::Pointer parallelIds = RunSegmentation(CreateTestData(dims[d][0], dims[d][1], dims[d][2]), true, parallelFeatures);
+
+        DREAM3D_REQUIRE_EQUAL(serialFeatures, parallelFeatures)
+        DREAM3D_REQUIRE_EQUAL(serialIds->getNumberOfTuples(), parallelIds->getNumberOfTuples())
+
+        // The Feature Ids are randomized, so require that both runs produce the same partition, i.e. that
+        // the Feature Ids of one run map one-to-one onto the Feature Ids of the other
+        std::vector<int32_t> forward(serialFeatures, -1);
+        std::vector<int32_t> backward(parallelFeatures, -1);
+        for(size_t i = 0; i < serialIds->getNumberOfTuples(); i++)
+        {
+          int32_t s = serialIds->getValue(i);
+          int32_t p = parallelIds->getValue(i);
+          if(forward[s] == -1)
+          {
+            forward[s] = p;
+          }
+          if(backward[p] == -1)
+          {
+            backward[p] = s;
+          }
+          DREAM3D_REQUIRE_EQUAL(forward[s], p)
+          DREAM3D_REQUIRE_EQUAL(backward[p], s)
+        }
+      }
+
+      return EXIT_SUCCESS;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void operator()()
+    {
+      int err = EXIT_SUCCESS;
+
+      DREAM3D_REGISTER_TEST( TestFilterAvailability() );
+
+      DREAM3D_REGISTER_TEST( TestParallelLabeling() )
+
+      DREAM3D_REGISTER_TEST( RemoveTestFiles() )
+    }
+
+  private:
+    ScalarSegmentFeaturesTest(const ScalarSegmentFeaturesTest&); // Copy Constructor Not Implemented
+    void operator=(const ScalarSegmentFeaturesTest&); // Operator '=' Not Implemented
+
+
+};
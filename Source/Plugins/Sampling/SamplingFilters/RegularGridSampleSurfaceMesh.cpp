@@ -37,6 +37,7 @@
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatVec3FilterParameter.h"
 #include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
@@ -62,6 +63,7 @@ RegularGridSampleSurfaceMesh::RegularGridSampleSurfaceMesh()
 , m_YPoints(0)
 , m_ZPoints(0)
 , m_FeatureIdsArrayName(SIMPL::CellData::FeatureIds)
+, m_UseScanConversion(false)
 , m_FeatureIds(nullptr)
 {
   m_Resolution.x = 1.0f;
@@ -94,6 +96,7 @@ void RegularGridSampleSurfaceMesh::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_FLOAT_VEC3_FP("Resolution", Resolution, FilterParameter::Parameter, RegularGridSampleSurfaceMesh));
 
   parameters.push_back(SIMPL_NEW_FLOAT_VEC3_FP("Origin", Origin, FilterParameter::Parameter, RegularGridSampleSurfaceMesh));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Scan Conversion", UseScanConversion, FilterParameter::Parameter, RegularGridSampleSurfaceMesh));
 
   parameters.push_back(SIMPL_NEW_STRING_FP("Data Container", DataContainerName, FilterParameter::CreatedArray, RegularGridSampleSurfaceMesh));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::CreatedArray));
@@ -114,6 +117,7 @@ void RegularGridSampleSurfaceMesh::readFilterParameters(AbstractFilterParameters
   setZPoints(reader->readValue("ZPoints", getZPoints()));
   setResolution(reader->readFloatVec3("Resolution", getResolution()));
   setOrigin(reader->readFloatVec3("Origin", getOrigin()));
+  setUseScanConversion(reader->readValue("UseScanConversion", getUseScanConversion()));
   setDataContainerName(reader->readString("DataContainerName", getDataContainerName()));
   setCellAttributeMatrixName(reader->readString("CellAttributeMatrixName", getCellAttributeMatrixName()));
   setFeatureIdsArrayName(reader->readString("FeatureIdsArrayName", getFeatureIdsArrayName()));
@@ -222,6 +226,23 @@ void RegularGridSampleSurfaceMesh::assign_points(Int32ArrayType::Pointer iArray)
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool RegularGridSampleSurfaceMesh::get_sampling_grid(int64_t dims[3], float resolution[3], float origin[3])
+{
+  dims[0] = m_XPoints;
+  dims[1] = m_YPoints;
+  dims[2] = m_ZPoints;
+  resolution[0] = m_Resolution.x;
+  resolution[1] = m_Resolution.y;
+  resolution[2] = m_Resolution.z;
+  origin[0] = m_Origin.x;
+  origin[1] = m_Origin.y;
+  origin[2] = m_Origin.z;
+  return m_UseScanConversion;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
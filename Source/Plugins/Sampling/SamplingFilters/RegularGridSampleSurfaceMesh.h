@@ -82,6 +82,9 @@ class RegularGridSampleSurfaceMesh : public SampleSurfaceMesh
     SIMPL_FILTER_PARAMETER(QString, FeatureIdsArrayName)
     Q_PROPERTY(QString FeatureIdsArrayName READ getFeatureIdsArrayName WRITE setFeatureIdsArrayName)
 
+    SIMPL_FILTER_PARAMETER(bool, UseScanConversion)
+    Q_PROPERTY(bool UseScanConversion READ getUseScanConversion WRITE setUseScanConversion)
+
     /**
      * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
      */
@@ -166,6 +169,12 @@ class RegularGridSampleSurfaceMesh : public SampleSurfaceMesh
      */
     virtual void assign_points(Int32ArrayType::Pointer iArray);
 
+    /**
+     * @brief get_sampling_grid Reimplemented from @see SampleSurfaceMesh class
+     * @return Whether the grid should be scan converted
+     */
+    virtual bool get_sampling_grid(int64_t dims[3], float resolution[3], float origin[3]);
+
   private:
     DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
 
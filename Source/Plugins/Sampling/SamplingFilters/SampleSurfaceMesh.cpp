@@ -35,6 +35,9 @@
 
 #include "SampleSurfaceMesh.h"
 
+#include <algorithm>
+#include <cmath>
+
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
@@ -54,6 +57,7 @@
 
 #include "Sampling/SamplingConstants.h"
 #include "Sampling/SamplingVersion.h"
+#include "Sampling/SamplingFilters/util/PointBins.hpp"
 
 /**
  * @brief The SampleSurfaceMeshImpl class implements a threaded algorithm that samples a surface mesh based on points passed from subclassed Filters.
@@ -62,16 +66,21 @@ class SampleSurfaceMeshImpl
 {
   TriangleGeom::Pointer m_Faces;
   Int32Int32DynamicListArray::Pointer m_FaceIds;
+  const int32_t* m_FaceCounts;
   VertexGeom::Pointer m_FaceBBs;
   VertexGeom::Pointer m_Points;
+  const SampleSurfaceMeshDetail::PointBins* m_PointBins;
   int32_t* m_PolyIds;
 
 public:
-  SampleSurfaceMeshImpl(TriangleGeom::Pointer faces, Int32Int32DynamicListArray::Pointer faceIds, VertexGeom::Pointer faceBBs, VertexGeom::Pointer points, int32_t* polyIds)
+  SampleSurfaceMeshImpl(TriangleGeom::Pointer faces, Int32Int32DynamicListArray::Pointer faceIds, const int32_t* faceCounts, VertexGeom::Pointer faceBBs, VertexGeom::Pointer points,
+                        const SampleSurfaceMeshDetail::PointBins* pointBins, int32_t* polyIds)
   : m_Faces(faces)
   , m_FaceIds(faceIds)
+  , m_FaceCounts(faceCounts)
   , m_FaceBBs(faceBBs)
   , m_Points(points)
+  , m_PointBins(pointBins)
   , m_PolyIds(polyIds)
   {
   }
@@ -83,7 +92,6 @@ public:
   {
     float radius = 0.0f;
     float distToBoundary = 0.0f;
-    int64_t numPoints = m_Points->getNumberOfVertices();
     FloatArrayType::Pointer llPtr = FloatArrayType::CreateArray(3, "_INTERNAL_USE_ONLY_Lower");
     FloatArrayType::Pointer urPtr = FloatArrayType::CreateArray(3, "_INTERNAL_USE_ONLY_Upper_Right");
     float* ll = llPtr->getPointer(0);
@@ -93,13 +101,17 @@ public:
 
     for(size_t iter = start; iter < end; iter++)
     {
+      if(m_FaceCounts[iter] == 0)
+      {
+        continue;
+      }
+
       // find bounding box for current feature
       GeometryMath::FindBoundingBoxOfFaces(m_Faces.get(), m_FaceIds->getElementList(iter), ll, ur);
       GeometryMath::FindDistanceBetweenPoints(ll, ur, radius);
 
-      // check points in vertex array to see if they are in the bounding box of the feature
-      for(int64_t i = 0; i < numPoints; i++)
-      {
+      // check the points in the bins that overlap the bounding box of the feature
+      m_PointBins->forEachPointInBox(ll, ur, [&](int64_t i) {
         point = m_Points->getVertexPointer(i);
         if(m_PolyIds[i] == 0 && GeometryMath::PointInBox(point, ll, ur) == true)
         {
@@ -109,7 +121,7 @@ public:
             m_PolyIds[i] = iter;
           }
         }
-      }
+      });
     }
   }
 
@@ -122,6 +134,215 @@ public:
 private:
 };
 
+/**
+ * @brief The SampleSurfaceMeshScanImpl class scan converts the surface mesh onto a regular grid of points, one Z
+ * plane of points at a time. A ray is cast along +X through every row of points. Each triangle that the ray
+ * crosses flips the inside/outside state of the two features it separates, so sweeping a row from left to right
+ * labels every point in a single pass. A point that lies exactly on a crossed triangle counts as inside, and
+ * when a point is inside of more than one feature the lowest feature Id owns it.
+ */
+class SampleSurfaceMeshScanImpl
+{
+public:
+  typedef struct
+  {
+    double x;
+    int32_t labels[2];
+  } RayCrossing_t;
+
+  SampleSurfaceMeshScanImpl(const float* vertices, const int64_t* triangles, const int32_t* faceLabels, const int64_t* planeStarts, const int64_t* planeFaces, const int64_t dims[3],
+                            const float resolution[3], const float origin[3], int32_t* polyIds)
+  : m_Vertices(vertices)
+  , m_Triangles(triangles)
+  , m_FaceLabels(faceLabels)
+  , m_PlaneStarts(planeStarts)
+  , m_PlaneFaces(planeFaces)
+  , m_PolyIds(polyIds)
+  {
+    for(int32_t d = 0; d < 3; d++)
+    {
+      m_Dims[d] = dims[d];
+      m_Resolution[d] = resolution[d];
+      m_Origin[d] = origin[d];
+    }
+  }
+
+  virtual ~SampleSurfaceMeshScanImpl()
+  {
+  }
+
+  /**
+   * @brief PointRange Returns the first and last grid point along axis d whose coordinate can lie in [low, high]
+   */
+  static void PointRange(float low, float high, int64_t dim, float resolution, float origin, int64_t& first, int64_t& last)
+  {
+    first = std::max(static_cast<int64_t>(0), static_cast<int64_t>(std::floor((low - origin) / resolution - 0.5f)));
+    last = std::min(dim - 1, static_cast<int64_t>(std::ceil((high - origin) / resolution - 0.5f)));
+  }
+
+  /**
+   * @brief EdgeSign Returns which side of the edge from vertex a to vertex b the ray at (y, z) passes. The edge is
+   * always evaluated from its lower vertex Id, so the two triangles that share an edge compute the same value
+   * with opposite signs. A ray that runs exactly through the edge is treated as if it were moved by (e, e^2) in
+   * (Y, Z) for a vanishing e, which makes exactly one of the two triangles claim it.
+   */
+  int32_t edgeSign(int64_t a, int64_t b, double y, double z, double& value) const
+  {
+    int32_t flip = 1;
+    if(a > b)
+    {
+      std::swap(a, b);
+      flip = -1;
+    }
+    const float* va = m_Vertices + 3 * a;
+    const float* vb = m_Vertices + 3 * b;
+    double dy = static_cast<double>(vb[1]) - static_cast<double>(va[1]);
+    double dz = static_cast<double>(vb[2]) - static_cast<double>(va[2]);
+    value = flip * (dy * (z - static_cast<double>(va[2])) - dz * (y - static_cast<double>(va[1])));
+    if(value != 0.0)
+    {
+      return value > 0.0 ? 1 : -1;
+    }
+    if(dz != 0.0)
+    {
+      return dz < 0.0 ? flip : -flip;
+    }
+    if(dy != 0.0)
+    {
+      return dy > 0.0 ? flip : -flip;
+    }
+    return 0;
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    std::vector<std::vector<RayCrossing_t>> rowCrossings(m_Dims[1]);
+    std::vector<int32_t> insideFeatures;
+
+    for(size_t k = start; k < end; k++)
+    {
+      float z = (float(k) + 0.5f) * m_Resolution[2] + m_Origin[2];
+
+      // Find where the rays of this plane cross the triangles that span it
+      for(int64_t f = m_PlaneStarts[k]; f < m_PlaneStarts[k + 1]; f++)
+      {
+        int64_t face = m_PlaneFaces[f];
+        const int64_t* tri = m_Triangles + 3 * face;
+        const float* v0 = m_Vertices + 3 * tri[0];
+        const float* v1 = m_Vertices + 3 * tri[1];
+        const float* v2 = m_Vertices + 3 * tri[2];
+        int64_t firstRow = 0;
+        int64_t lastRow = 0;
+        PointRange(std::min(v0[1], std::min(v1[1], v2[1])), std::max(v0[1], std::max(v1[1], v2[1])), m_Dims[1], m_Resolution[1], m_Origin[1], firstRow, lastRow);
+        for(int64_t j = firstRow; j <= lastRow; j++)
+        {
+          float y = (float(j) + 0.5f) * m_Resolution[1] + m_Origin[1];
+          double w0 = 0.0, w1 = 0.0, w2 = 0.0;
+          int32_t s0 = edgeSign(tri[1], tri[2], y, z, w0);
+          int32_t s1 = edgeSign(tri[2], tri[0], y, z, w1);
+          int32_t s2 = edgeSign(tri[0], tri[1], y, z, w2);
+          if(s0 == 0 || s0 != s1 || s0 != s2)
+          {
+            continue;
+          }
+          RayCrossing_t crossing;
+          double sum = w0 + w1 + w2;
+          if(sum != 0.0)
+          {
+            crossing.x = (w0 * v0[0] + w1 * v1[0] + w2 * v2[0]) / sum;
+          }
+          else
+          {
+            crossing.x = (static_cast<double>(v0[0]) + v1[0] + v2[0]) / 3.0;
+          }
+          crossing.labels[0] = m_FaceLabels[2 * face];
+          crossing.labels[1] = m_FaceLabels[2 * face + 1];
+          rowCrossings[j].push_back(crossing);
+        }
+      }
+
+      // Sweep every row from left to right
+      for(int64_t j = 0; j < m_Dims[1]; j++)
+      {
+        std::vector<RayCrossing_t>& crossings = rowCrossings[j];
+        if(crossings.empty())
+        {
+          continue;
+        }
+        std::sort(crossings.begin(), crossings.end(), [](const RayCrossing_t& a, const RayCrossing_t& b) { return a.x < b.x; });
+
+        insideFeatures.clear();
+        size_t c = 0;
+        int32_t* polyIds = m_PolyIds + (k * m_Dims[1] + j) * m_Dims[0];
+        for(int64_t i = 0; i < m_Dims[0]; i++)
+        {
+          double x = static_cast<double>((float(i) + 0.5f) * m_Resolution[0] + m_Origin[0]);
+          for(; c < crossings.size() && crossings[c].x < x; c++)
+          {
+            for(int32_t l = 0; l < 2; l++)
+            {
+              int32_t label = crossings[c].labels[l];
+              if(label <= 0)
+              {
+                continue;
+              }
+              std::vector<int32_t>::iterator iter = std::find(insideFeatures.begin(), insideFeatures.end(), label);
+              if(iter != insideFeatures.end())
+              {
+                insideFeatures.erase(iter);
+              }
+              else
+              {
+                insideFeatures.push_back(label);
+              }
+            }
+          }
+
+          int32_t id = 0;
+          for(size_t n = 0; n < insideFeatures.size(); n++)
+          {
+            if(id == 0 || insideFeatures[n] < id)
+            {
+              id = insideFeatures[n];
+            }
+          }
+          for(size_t e = c; e < crossings.size() && crossings[e].x == x; e++)
+          {
+            for(int32_t l = 0; l < 2; l++)
+            {
+              int32_t label = crossings[e].labels[l];
+              if(label > 0 && (id == 0 || label < id))
+              {
+                id = label;
+              }
+            }
+          }
+          polyIds[i] = id;
+        }
+        crossings.clear();
+      }
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const float* m_Vertices;
+  const int64_t* m_Triangles;
+  const int32_t* m_FaceLabels;
+  const int64_t* m_PlaneStarts;
+  const int64_t* m_PlaneFaces;
+  int64_t m_Dims[3];
+  float m_Resolution[3];
+  float m_Origin[3];
+  int32_t* m_PolyIds;
+};
+
 // Include the MOC generated file for this class
 #include "moc_SampleSurfaceMesh.cpp"
 
@@ -237,6 +458,81 @@ void SampleSurfaceMesh::assign_points(Int32ArrayType::Pointer iArray)
   return;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SampleSurfaceMesh::get_sampling_grid(int64_t dims[3], float resolution[3], float origin[3])
+{
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+Int32ArrayType::Pointer SampleSurfaceMesh::scan_convert_grid(TriangleGeom::Pointer triangleGeom, int64_t dims[3], float resolution[3], float origin[3])
+{
+  int64_t numFaces = m_SurfaceMeshFaceLabelsPtr.lock()->getNumberOfTuples();
+  float* vertices = triangleGeom->getVertexPointer(0);
+  int64_t* triangles = triangleGeom->getTriPointer(0);
+
+  // Sort the triangles into the Z planes of points that they span
+  std::vector<int64_t> firstPlane(numFaces, 0);
+  std::vector<int64_t> lastPlane(numFaces, -1);
+  std::vector<int64_t> planeStarts(dims[2] + 1, 0);
+  for(int64_t i = 0; i < numFaces; i++)
+  {
+    if(m_SurfaceMeshFaceLabels[2 * i] <= 0 && m_SurfaceMeshFaceLabels[2 * i + 1] <= 0)
+    {
+      continue;
+    }
+    float zMin = vertices[3 * triangles[3 * i] + 2];
+    float zMax = zMin;
+    for(int32_t v = 1; v < 3; v++)
+    {
+      float z = vertices[3 * triangles[3 * i + v] + 2];
+      zMin = std::min(zMin, z);
+      zMax = std::max(zMax, z);
+    }
+    SampleSurfaceMeshScanImpl::PointRange(zMin, zMax, dims[2], resolution[2], origin[2], firstPlane[i], lastPlane[i]);
+    for(int64_t k = firstPlane[i]; k <= lastPlane[i]; k++)
+    {
+      planeStarts[k + 1]++;
+    }
+  }
+  for(int64_t k = 0; k < dims[2]; k++)
+  {
+    planeStarts[k + 1] += planeStarts[k];
+  }
+  std::vector<int64_t> planeFaces(planeStarts[dims[2]]);
+  std::vector<int64_t> next(planeStarts.begin(), planeStarts.end() - 1);
+  for(int64_t i = 0; i < numFaces; i++)
+  {
+    for(int64_t k = firstPlane[i]; k <= lastPlane[i]; k++)
+    {
+      planeFaces[next[k]++] = i;
+    }
+  }
+
+  Int32ArrayType::Pointer iArray = Int32ArrayType::CreateArray(dims[0] * dims[1] * dims[2], "_INTERNAL_USE_ONLY_polyhedronIds");
+  iArray->initializeWithZeros();
+
+  SampleSurfaceMeshScanImpl impl(vertices, triangles, m_SurfaceMeshFaceLabels, planeStarts.data(), planeFaces.data(), dims, resolution, origin, iArray->getPointer(0));
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, dims[2]), impl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    impl.convert(0, dims[2]);
+  }
+
+  return iArray;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -259,6 +555,17 @@ void SampleSurfaceMesh::execute()
 
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
 
+  // A regular grid of points is scan converted without generating the points
+  int64_t gridDims[3] = {0, 0, 0};
+  float gridResolution[3] = {0.0f, 0.0f, 0.0f};
+  float gridOrigin[3] = {0.0f, 0.0f, 0.0f};
+  if(get_sampling_grid(gridDims, gridResolution, gridOrigin) == true)
+  {
+    assign_points(scan_convert_grid(triangleGeom, gridDims, gridResolution, gridOrigin));
+    notifyStatusMessage(getHumanLabel(), "Complete");
+    return;
+  }
+
   // pull down faces
   int64_t numFaces = m_SurfaceMeshFaceLabelsPtr.lock()->getNumberOfTuples();
 
@@ -348,15 +655,18 @@ void SampleSurfaceMesh::execute()
   iArray->initializeWithZeros();
   int32_t* polyIds = iArray->getPointer(0);
 
+  // Bin the points so that each feature only looks at the points near its bounding box
+  SampleSurfaceMeshDetail::PointBins pointBins(points.get());
+
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
   if(doParallel == true)
   {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures), SampleSurfaceMeshImpl(triangleGeom, faceLists, faceBBs, points, polyIds), tbb::auto_partitioner());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures), SampleSurfaceMeshImpl(triangleGeom, faceLists, linkCount.data(), faceBBs, points, &pointBins, polyIds), tbb::auto_partitioner());
   }
   else
 #endif
   {
-    SampleSurfaceMeshImpl serial(triangleGeom, faceLists, faceBBs, points, polyIds);
+    SampleSurfaceMeshImpl serial(triangleGeom, faceLists, linkCount.data(), faceBBs, points, &pointBins, polyIds);
     serial.checkPoints(0, numFeatures);
   }
 
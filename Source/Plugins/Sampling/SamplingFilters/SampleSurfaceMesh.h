@@ -40,6 +40,7 @@
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/Common/AbstractFilter.h"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/Geometry/VertexGeom.h"
 
 /**
@@ -166,9 +167,27 @@ class SampleSurfaceMesh : public AbstractFilter
      */
     virtual void assign_points(Int32ArrayType::Pointer iArray);
 
+    /**
+     * @brief get_sampling_grid Lets a subclass whose sampling points form a regular grid describe that grid, so
+     * that the grid is scan converted instead of generating and testing every point. The points sit at the
+     * centers of the grid Cells.
+     * @param dims Number of points along X, Y and Z
+     * @param resolution Spacing of the points along X, Y and Z
+     * @param origin Origin of the grid
+     * @return Whether the grid should be scan converted
+     */
+    virtual bool get_sampling_grid(int64_t dims[3], float resolution[3], float origin[3]);
+
   private:
     DEFINE_DATAARRAY_VARIABLE(int32_t, SurfaceMeshFaceLabels)
 
+    /**
+     * @brief scan_convert_grid Samples the surface mesh on a regular grid of points by casting a ray along X
+     * through every row of points
+     * @return Sampled Feature Ids of the grid points
+     */
+    Int32ArrayType::Pointer scan_convert_grid(TriangleGeom::Pointer triangleGeom, int64_t dims[3], float resolution[3], float origin[3]);
+
     SampleSurfaceMesh(const SampleSurfaceMesh&); // Copy Constructor Not Implemented
     void operator=(const SampleSurfaceMesh&); // Operator '=' Not Implemented
 };
@@ -0,0 +1,230 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _pointbins_hpp_
+#define _pointbins_hpp_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "SIMPLib/Geometry/VertexGeom.h"
+
+namespace SampleSurfaceMeshDetail
+{
+/**
+ * @brief The PointBins class sorts the sampling points into a uniform grid of bins, so that the points inside the
+ * bounding box of a feature can be found without looking at every point.
+ */
+class PointBins
+{
+public:
+  PointBins(VertexGeom* points)
+  {
+    int64_t numPoints = points->getNumberOfVertices();
+    float ll[3] = {0.0f, 0.0f, 0.0f};
+    float ur[3] = {0.0f, 0.0f, 0.0f};
+    for(int64_t i = 0; i < numPoints; i++)
+    {
+      float* point = points->getVertexPointer(i);
+      for(int32_t d = 0; d < 3; d++)
+      {
+        if(i == 0 || point[d] < ll[d])
+        {
+          ll[d] = point[d];
+        }
+        if(i == 0 || point[d] > ur[d])
+        {
+          ur[d] = point[d];
+        }
+      }
+    }
+
+    // Aim for about 8 points per bin, with cubic bins along the axes that the points spread over. An axis that is
+    // thinner than one bin is treated as flat, otherwise a near-planar point set would get a tiny bin size and a
+    // huge number of bins along the other axes.
+    int64_t targetBins = std::max(static_cast<int64_t>(1), numPoints / 8);
+    bool spread[3] = {ur[0] > ll[0], ur[1] > ll[1], ur[2] > ll[2]};
+    double binSize = 1.0;
+    bool flattened = true;
+    while(flattened == true)
+    {
+      flattened = false;
+      double volume = 1.0;
+      int32_t spreadAxes = 0;
+      for(int32_t d = 0; d < 3; d++)
+      {
+        if(spread[d] == true)
+        {
+          volume *= static_cast<double>(ur[d] - ll[d]);
+          spreadAxes++;
+        }
+      }
+      if(spreadAxes == 0)
+      {
+        break;
+      }
+      binSize = std::pow(volume / static_cast<double>(targetBins), 1.0 / spreadAxes);
+      for(int32_t d = 0; d < 3; d++)
+      {
+        if(spread[d] == true && static_cast<double>(ur[d] - ll[d]) < binSize)
+        {
+          spread[d] = false;
+          flattened = true;
+        }
+      }
+    }
+
+    int64_t numBins = 1;
+    for(int32_t d = 0; d < 3; d++)
+    {
+      m_Dims[d] = 1;
+      if(spread[d] == true)
+      {
+        m_Dims[d] = std::max(static_cast<int64_t>(1), std::min(targetBins, static_cast<int64_t>((ur[d] - ll[d]) / binSize)));
+      }
+      numBins *= m_Dims[d];
+    }
+    // Never allocate more bins than there are points, whatever the rounding above did
+    int64_t maxBins = std::max(static_cast<int64_t>(1), numPoints);
+    while(numBins > maxBins)
+    {
+      int32_t largest = (m_Dims[0] >= m_Dims[1] && m_Dims[0] >= m_Dims[2]) ? 0 : (m_Dims[1] >= m_Dims[2] ? 1 : 2);
+      numBins /= m_Dims[largest];
+      m_Dims[largest] = (m_Dims[largest] + 1) / 2;
+      numBins *= m_Dims[largest];
+    }
+    for(int32_t d = 0; d < 3; d++)
+    {
+      m_Origin[d] = ll[d];
+      m_Size[d] = (ur[d] - ll[d]) / static_cast<float>(m_Dims[d]);
+    }
+
+    // Counting sort of the points by bin
+    std::vector<int64_t> pointBins(numPoints);
+    m_Starts.assign(numBins + 1, 0);
+    for(int64_t i = 0; i < numPoints; i++)
+    {
+      float* point = points->getVertexPointer(i);
+      pointBins[i] = (binIndex(point[2], 2) * m_Dims[1] + binIndex(point[1], 1)) * m_Dims[0] + binIndex(point[0], 0);
+      m_Starts[pointBins[i] + 1]++;
+    }
+    for(int64_t b = 0; b < numBins; b++)
+    {
+      m_Starts[b + 1] += m_Starts[b];
+    }
+    std::vector<int64_t> next(m_Starts.begin(), m_Starts.end() - 1);
+    m_Points.resize(numPoints);
+    for(int64_t i = 0; i < numPoints; i++)
+    {
+      m_Points[next[pointBins[i]]++] = i;
+    }
+  }
+
+  virtual ~PointBins()
+  {
+  }
+
+  /**
+   * @brief getNumberOfBins Returns the total number of bins
+   */
+  int64_t getNumberOfBins() const
+  {
+    return static_cast<int64_t>(m_Starts.size()) - 1;
+  }
+
+  /**
+   * @brief getDimensions Returns the number of bins along each axis
+   */
+  void getDimensions(int64_t dims[3]) const
+  {
+    dims[0] = m_Dims[0];
+    dims[1] = m_Dims[1];
+    dims[2] = m_Dims[2];
+  }
+
+  /**
+   * @brief binIndex Returns the bin along axis d that holds the coordinate. Coordinates outside of the points'
+   * bounding box are clamped to the first or last bin, which keeps the bins of a box query ordered.
+   */
+  int64_t binIndex(float coord, int32_t d) const
+  {
+    if(m_Dims[d] == 1 || coord <= m_Origin[d])
+    {
+      return 0;
+    }
+    float bin = (coord - m_Origin[d]) / m_Size[d];
+    if(bin >= static_cast<float>(m_Dims[d] - 1))
+    {
+      return m_Dims[d] - 1;
+    }
+    return static_cast<int64_t>(bin);
+  }
+
+  /**
+   * @brief forEachPointInBox Calls the function with the Id of every point in the bins that overlap the box
+   */
+  template <typename Function> void forEachPointInBox(const float* ll, const float* ur, Function function) const
+  {
+    int64_t start[3] = {binIndex(ll[0], 0), binIndex(ll[1], 1), binIndex(ll[2], 2)};
+    int64_t end[3] = {binIndex(ur[0], 0), binIndex(ur[1], 1), binIndex(ur[2], 2)};
+    for(int64_t z = start[2]; z <= end[2]; z++)
+    {
+      for(int64_t y = start[1]; y <= end[1]; y++)
+      {
+        int64_t row = (z * m_Dims[1] + y) * m_Dims[0];
+        for(int64_t p = m_Starts[row + start[0]]; p < m_Starts[row + end[0] + 1]; p++)
+        {
+          function(m_Points[p]);
+        }
+      }
+    }
+  }
+
+private:
+  PointBins(const PointBins&);      // Copy Constructor Not Implemented
+  void operator=(const PointBins&); // Operator '=' Not Implemented
+
+  int64_t m_Dims[3];
+  float m_Origin[3];
+  float m_Size[3];
+  std::vector<int64_t> m_Starts;
+  std::vector<int64_t> m_Points;
+};
+}
+
+#endif /* _pointbins_hpp_ */
@@ -0,0 +1,229 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <QtCore/QCoreApplication>
+
+#include <random>
+#include <vector>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Geometry/VertexGeom.h"
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "Sampling/SamplingFilters/util/PointBins.hpp"
+
+class PointBinsTest
+{
+public:
+  PointBinsTest()
+  {
+  }
+  virtual ~PointBinsTest()
+  {
+  }
+  SIMPL_TYPE_MACRO(PointBinsTest)
+
+  // -----------------------------------------------------------------------------
+  // Creates points spread uniformly over the box [0, extent)
+  // -----------------------------------------------------------------------------
+  VertexGeom::Pointer CreatePoints(int64_t numPoints, const float extent[3], std::mt19937& generator)
+  {
+    VertexGeom::Pointer points = VertexGeom::CreateGeometry(numPoints, "Points");
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    for(int64_t i = 0; i < numPoints; i++)
+    {
+      float* point = points->getVertexPointer(i);
+      for(int32_t d = 0; d < 3; d++)
+      {
+        point[d] = extent[d] * distribution(generator);
+      }
+    }
+    return points;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Every point inside the box has to be visited exactly once by forEachPointInBox
+  // -----------------------------------------------------------------------------
+  void CheckBoxQuery(VertexGeom* points, const SampleSurfaceMeshDetail::PointBins& bins, const float ll[3], const float ur[3])
+  {
+    int64_t numPoints = points->getNumberOfVertices();
+    std::vector<int32_t> visits(numPoints, 0);
+    bins.forEachPointInBox(ll, ur, [&](int64_t i) { visits[i]++; });
+    for(int64_t i = 0; i < numPoints; i++)
+    {
+      DREAM3D_REQUIRED(visits[i], <=, 1)
+      float* point = points->getVertexPointer(i);
+      bool inside = true;
+      for(int32_t d = 0; d < 3; d++)
+      {
+        inside = inside && point[d] >= ll[d] && point[d] <= ur[d];
+      }
+      if(inside == true)
+      {
+        DREAM3D_REQUIRE_EQUAL(visits[i], 1)
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void CheckBins(VertexGeom* points, const float extent[3], std::mt19937& generator)
+  {
+    int64_t numPoints = points->getNumberOfVertices();
+    SampleSurfaceMeshDetail::PointBins bins(points);
+    DREAM3D_REQUIRED(bins.getNumberOfBins(), >=, 1)
+    DREAM3D_REQUIRED(bins.getNumberOfBins(), <=, std::max(static_cast<int64_t>(1), numPoints))
+
+    std::uniform_real_distribution<float> distribution(-0.25f, 1.25f);
+    for(int32_t q = 0; q < 20; q++)
+    {
+      float ll[3] = {0.0f, 0.0f, 0.0f};
+      float ur[3] = {0.0f, 0.0f, 0.0f};
+      for(int32_t d = 0; d < 3; d++)
+      {
+        float a = extent[d] * distribution(generator);
+        float b = extent[d] * distribution(generator);
+        ll[d] = std::min(a, b);
+        ur[d] = std::max(a, b);
+      }
+      CheckBoxQuery(points, bins, ll, ur);
+    }
+    // A box around everything has to return every point
+    float ll[3] = {-1.0f, -1.0f, -1.0f};
+    float ur[3] = {extent[0] + 1.0f, extent[1] + 1.0f, extent[2] + 1.0f};
+    CheckBoxQuery(points, bins, ll, ur);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestSpreadPoints()
+  {
+    std::mt19937 generator(5489u);
+    float extent[3] = {10.0f, 4.0f, 7.0f};
+    VertexGeom::Pointer points = CreatePoints(20000, extent, generator);
+    CheckBins(points.get(), extent, generator);
+
+    SampleSurfaceMeshDetail::PointBins bins(points.get());
+    int64_t dims[3] = {0, 0, 0};
+    bins.getDimensions(dims);
+    DREAM3D_REQUIRED(dims[0], >, 1)
+    DREAM3D_REQUIRED(dims[1], >, 1)
+    DREAM3D_REQUIRED(dims[2], >, 1)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The points lie in a plane that is jittered by far less than a bin, which used to produce
+  // a tiny bin size and a bin count many times the number of points
+  // -----------------------------------------------------------------------------
+  int TestNearPlanarPoints()
+  {
+    std::mt19937 generator(5489u);
+    float extent[3] = {10.0f, 10.0f, 1.0e-6f};
+    VertexGeom::Pointer points = CreatePoints(200000, extent, generator);
+    CheckBins(points.get(), extent, generator);
+
+    SampleSurfaceMeshDetail::PointBins bins(points.get());
+    int64_t dims[3] = {0, 0, 0};
+    bins.getDimensions(dims);
+    DREAM3D_REQUIRED(dims[0], >, 1)
+    DREAM3D_REQUIRED(dims[1], >, 1)
+    DREAM3D_REQUIRE_EQUAL(dims[2], 1)
+    DREAM3D_REQUIRED(bins.getNumberOfBins(), <=, 200000 / 8)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestNearLinearPoints()
+  {
+    std::mt19937 generator(5489u);
+    float extent[3] = {1.0e-6f, 25.0f, 1.0e-5f};
+    VertexGeom::Pointer points = CreatePoints(50000, extent, generator);
+    CheckBins(points.get(), extent, generator);
+
+    SampleSurfaceMeshDetail::PointBins bins(points.get());
+    int64_t dims[3] = {0, 0, 0};
+    bins.getDimensions(dims);
+    DREAM3D_REQUIRE_EQUAL(dims[0], 1)
+    DREAM3D_REQUIRED(dims[1], >, 1)
+    DREAM3D_REQUIRE_EQUAL(dims[2], 1)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestDegeneratePoints()
+  {
+    std::mt19937 generator(5489u);
+    float extent[3] = {0.0f, 0.0f, 0.0f};
+    VertexGeom::Pointer points = CreatePoints(100, extent, generator);
+    CheckBins(points.get(), extent, generator);
+
+    VertexGeom::Pointer single = CreatePoints(1, extent, generator);
+    CheckBins(single.get(), extent, generator);
+
+    VertexGeom::Pointer empty = VertexGeom::CreateGeometry(0, "Points");
+    SampleSurfaceMeshDetail::PointBins bins(empty.get());
+    DREAM3D_REQUIRE_EQUAL(bins.getNumberOfBins(), 1)
+    float ll[3] = {-1.0f, -1.0f, -1.0f};
+    float ur[3] = {1.0f, 1.0f, 1.0f};
+    int32_t visits = 0;
+    bins.forEachPointInBox(ll, ur, [&](int64_t) { visits++; });
+    DREAM3D_REQUIRE_EQUAL(visits, 0)
+    return EXIT_SUCCESS;
+  }
+
+  /**
+  * @brief
+  */
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestSpreadPoints())
+    DREAM3D_REGISTER_TEST(TestNearPlanarPoints())
+    DREAM3D_REGISTER_TEST(TestNearLinearPoints())
+    DREAM3D_REGISTER_TEST(TestDegeneratePoints())
+  }
+
+private:
+  PointBinsTest(const PointBinsTest&);  // Copy Constructor Not Implemented
+  void operator=(const PointBinsTest&); // Operator '=' Not Implemented
+};
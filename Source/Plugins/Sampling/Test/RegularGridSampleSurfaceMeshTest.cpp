@@ -0,0 +1,300 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "SamplingTestFileLocations.h"
+
+namespace RegularGridSampleSurfaceMeshTestConsts
+{
+const QString k_TriangleDataContainerName("TriangleDataContainer");
+const QString k_FaceAttributeMatrixName("FaceData");
+const QString k_FaceLabelsArrayName("FaceLabels");
+const QString k_ImageDataContainerName("ImageDataContainer");
+const int64_t k_VoxelDims[3] = {4, 3, 2};
+}
+
+class RegularGridSampleSurfaceMeshTest
+{
+public:
+  RegularGridSampleSurfaceMeshTest()
+  {
+  }
+  virtual ~RegularGridSampleSurfaceMeshTest()
+  {
+  }
+  SIMPL_TYPE_MACRO(RegularGridSampleSurfaceMeshTest)
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the RegularGridSampleSurfaceMesh Filter from the FilterManager
+    QString filtName = "RegularGridSampleSurfaceMesh";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The RegularGridSampleSurfaceMeshTest requires the use of the " << filtName.toStdString() << " filter which is found in the Sampling Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int32_t VoxelLabel(int64_t x, int64_t y, int64_t z)
+  {
+    const int64_t* dims = RegularGridSampleSurfaceMeshTestConsts::k_VoxelDims;
+    if(x < 0 || y < 0 || z < 0 || x >= dims[0] || y >= dims[1] || z >= dims[2])
+    {
+      return -1;
+    }
+    return static_cast<int32_t>(1 + (x + 2 * y + 3 * z) % 5);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateTestData()
+  {
+    const int64_t* dims = RegularGridSampleSurfaceMeshTestConsts::k_VoxelDims;
+
+    // Every face between two unit voxels with different labels, including the outside (-1), is split into two
+    // triangles. The vertices sit on the voxel corners so that neighboring faces share them.
+    std::vector<int64_t> quads;
+    std::vector<int32_t> quadLabels;
+    int64_t corner[3] = {0, 0, 0};
+    for(int64_t z = -1; z < dims[2]; z++)
+    {
+      for(int64_t y = -1; y < dims[1]; y++)
+      {
+        for(int64_t x = -1; x < dims[0]; x++)
+        {
+          int32_t label = VoxelLabel(x, y, z);
+          for(int32_t d = 0; d < 3; d++)
+          {
+            int64_t v[3] = {x, y, z};
+            v[d]++;
+            int32_t neighbor = VoxelLabel(v[0], v[1], v[2]);
+            if(neighbor == label || v[(d + 1) % 3] < 0 || v[(d + 2) % 3] < 0 || v[(d + 1) % 3] >= dims[(d + 1) % 3] || v[(d + 2) % 3] >= dims[(d + 2) % 3])
+            {
+              continue;
+            }
+            for(int32_t c = 0; c < 4; c++)
+            {
+              corner[0] = v[0];
+              corner[1] = v[1];
+              corner[2] = v[2];
+              corner[(d + 1) % 3] += (c == 1 || c == 2) ? 1 : 0;
+              corner[(d + 2) % 3] += (c >= 2) ? 1 : 0;
+              quads.push_back((corner[2] * (dims[1] + 1) + corner[1]) * (dims[0] + 1) + corner[0]);
+            }
+            quadLabels.push_back(label);
+            quadLabels.push_back(neighbor);
+          }
+        }
+      }
+    }
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer tdc = DataContainer::New(RegularGridSampleSurfaceMeshTestConsts::k_TriangleDataContainerName);
+    dca->addDataContainer(tdc);
+
+    int64_t numVertices = (dims[0] + 1) * (dims[1] + 1) * (dims[2] + 1);
+    int64_t numTriangles = static_cast<int64_t>(quads.size() / 2);
+    SharedVertexList::Pointer vertex = TriangleGeom::CreateSharedVertexList(numVertices);
+    TriangleGeom::Pointer triangle = TriangleGeom::CreateGeometry(numTriangles, vertex, SIMPL::Geometry::TriangleGeometry);
+    tdc->setGeometry(triangle);
+    float* vertices = triangle->getVertexPointer(0);
+    int64_t* tris = triangle->getTriPointer(0);
+    for(int64_t z = 0; z <= dims[2]; z++)
+    {
+      for(int64_t y = 0; y <= dims[1]; y++)
+      {
+        for(int64_t x = 0; x <= dims[0]; x++)
+        {
+          int64_t index = (z * (dims[1] + 1) + y) * (dims[0] + 1) + x;
+          vertices[3 * index] = static_cast<float>(x);
+          vertices[3 * index + 1] = static_cast<float>(y);
+          vertices[3 * index + 2] = static_cast<float>(z);
+        }
+      }
+    }
+
+    QVector<size_t> tDims(1, numTriangles);
+    AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New(tDims, RegularGridSampleSurfaceMeshTestConsts::k_FaceAttributeMatrixName, AttributeMatrix::Type::Face);
+    tdc->addAttributeMatrix(faceAttrMat->getName(), faceAttrMat);
+    QVector<size_t> cDims(1, 2);
+    Int32ArrayType::Pointer faceLabels = Int32ArrayType::CreateArray(tDims, cDims, RegularGridSampleSurfaceMeshTestConsts::k_FaceLabelsArrayName);
+    faceAttrMat->addAttributeArray(faceLabels->getName(), faceLabels);
+
+    for(size_t q = 0; q < quads.size() / 4; q++)
+    {
+      tris[6 * q + 0] = quads[4 * q + 0];
+      tris[6 * q + 1] = quads[4 * q + 1];
+      tris[6 * q + 2] = quads[4 * q + 2];
+      tris[6 * q + 3] = quads[4 * q + 0];
+      tris[6 * q + 4] = quads[4 * q + 2];
+      tris[6 * q + 5] = quads[4 * q + 3];
+      for(int32_t t = 0; t < 2; t++)
+      {
+        faceLabels->setComponent(2 * q + t, 0, quadLabels[2 * q]);
+        faceLabels->setComponent(2 * q + t, 1, quadLabels[2 * q + 1]);
+      }
+    }
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestSampling()
+  {
+    for(int32_t useScanConversion = 0; useScanConversion < 2; useScanConversion++)
+    {
+      DataContainerArray::Pointer dca = CreateTestData();
+
+      QString filtName = "RegularGridSampleSurfaceMesh";
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer factory = fm->getFactoryForFilter(filtName);
+      DREAM3D_REQUIRE(factory.get() != nullptr)
+
+      AbstractFilter::Pointer filter = factory->create();
+      DREAM3D_REQUIRE(filter.get() != nullptr)
+      filter->setDataContainerArray(dca);
+
+      // A grid that extends past the mesh on every side, with the Cell centers away from the voxel faces
+      FloatVec3_t resolution = {0.25f, 0.5f, 0.3f};
+      FloatVec3_t origin = {-0.5f, -1.0f, -0.6f};
+      int32_t points[3] = {20, 10, 10};
+
+      QVariant var;
+      var.setValue(DataArrayPath(RegularGridSampleSurfaceMeshTestConsts::k_TriangleDataContainerName, RegularGridSampleSurfaceMeshTestConsts::k_FaceAttributeMatrixName,
+                                 RegularGridSampleSurfaceMeshTestConsts::k_FaceLabelsArrayName));
+      bool propWasSet = filter->setProperty("SurfaceMeshFaceLabelsArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      propWasSet = filter->setProperty("XPoints", points[0]);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      propWasSet = filter->setProperty("YPoints", points[1]);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      propWasSet = filter->setProperty("ZPoints", points[2]);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(resolution);
+      propWasSet = filter->setProperty("Resolution", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(origin);
+      propWasSet = filter->setProperty("Origin", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      propWasSet = filter->setProperty("UseScanConversion", useScanConversion == 1);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+      filter->execute();
+      DREAM3D_REQUIRE(filter->getErrorCondition() >= 0)
+
+      Int32ArrayType::Pointer featureIds = dca->getAttributeMatrix(DataArrayPath(RegularGridSampleSurfaceMeshTestConsts::k_ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, ""))
+                                               ->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds);
+      DREAM3D_REQUIRE_VALID_POINTER(featureIds.get())
+
+      // Every Cell center holds the label of the voxel it falls in, or 0 outside of the mesh
+      size_t index = 0;
+      for(int32_t k = 0; k < points[2]; k++)
+      {
+        for(int32_t j = 0; j < points[1]; j++)
+        {
+          for(int32_t i = 0; i < points[0]; i++)
+          {
+            float x = (float(i) + 0.5f) * resolution.x + origin.x;
+            float y = (float(j) + 0.5f) * resolution.y + origin.y;
+            float z = (float(k) + 0.5f) * resolution.z + origin.z;
+            int32_t expected = VoxelLabel(static_cast<int64_t>(std::floor(x)), static_cast<int64_t>(std::floor(y)), static_cast<int64_t>(std::floor(z)));
+            if(expected < 0)
+            {
+              expected = 0;
+            }
+            DREAM3D_REQUIRE_EQUAL(featureIds->getValue(index), expected)
+            index++;
+          }
+        }
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestSampling())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+private:
+  RegularGridSampleSurfaceMeshTest(const RegularGridSampleSurfaceMeshTest&); // Copy Constructor Not Implemented
+  void operator=(const RegularGridSampleSurfaceMeshTest&);                   // Operator '=' Not Implemented
+};
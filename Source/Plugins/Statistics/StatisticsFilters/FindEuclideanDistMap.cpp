@@ -35,6 +35,11 @@
 
 #include "FindEuclideanDistMap.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
 #include <tbb/atomic.h>
 #include <tbb/blocked_range.h>
@@ -57,6 +62,262 @@
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
 
+/**
+ * @brief The DistanceFrontierImpl class finds the Cells of the next layer of a Manhattan distance map.
+ * An unassigned Cell takes the nearest boundary Cell of the last face neighbor (in -Z, -Y, -X, +X, +Y, +Z
+ * order) that already has a distance, exactly as a sweep over the whole volume would. All of those
+ * neighbors are in the current frontier, so the Cell is reported once, by that neighbor.
+ */
+class DistanceFrontierImpl
+{
+    const int32_t* m_FeatureIds;
+    const int32_t* m_NearestNeighbor;
+    const double* m_Distance;
+    const std::vector<int64_t>& m_Frontier;
+    std::vector<std::vector<std::pair<int64_t, int32_t>>>& m_Found;
+    int64_t m_Dims[3];
+    size_t m_ChunkSize;
+
+  public:
+    DistanceFrontierImpl(const int32_t* featureIds, const int32_t* nearestNeighbor, const double* distance, const std::vector<int64_t>& frontier,
+                         std::vector<std::vector<std::pair<int64_t, int32_t>>>& found, const int64_t dims[3], size_t chunkSize)
+    : m_FeatureIds(featureIds)
+    , m_NearestNeighbor(nearestNeighbor)
+    , m_Distance(distance)
+    , m_Frontier(frontier)
+    , m_Found(found)
+    , m_ChunkSize(chunkSize)
+    {
+      m_Dims[0] = dims[0];
+      m_Dims[1] = dims[1];
+      m_Dims[2] = dims[2];
+    }
+
+    virtual ~DistanceFrontierImpl()
+    {
+    }
+
+    /**
+     * @brief lastAssignedNeighbor Returns the last face neighbor of the Cell that has a distance or -1
+     */
+    int64_t lastAssignedNeighbor(int64_t index) const
+    {
+      int64_t zBlock = m_Dims[0] * m_Dims[1];
+      int64_t x = index % m_Dims[0];
+      int64_t y = (index / m_Dims[0]) % m_Dims[1];
+      int64_t z = index / zBlock;
+      int64_t owner = -1;
+      if(z > 0 && m_Distance[index - zBlock] != -1.0)
+      {
+        owner = index - zBlock;
+      }
+      if(y > 0 && m_Distance[index - m_Dims[0]] != -1.0)
+      {
+        owner = index - m_Dims[0];
+      }
+      if(x > 0 && m_Distance[index - 1] != -1.0)
+      {
+        owner = index - 1;
+      }
+      if(x < m_Dims[0] - 1 && m_Distance[index + 1] != -1.0)
+      {
+        owner = index + 1;
+      }
+      if(y < m_Dims[1] - 1 && m_Distance[index + m_Dims[0]] != -1.0)
+      {
+        owner = index + m_Dims[0];
+      }
+      if(z < m_Dims[2] - 1 && m_Distance[index + zBlock] != -1.0)
+      {
+        owner = index + zBlock;
+      }
+      return owner;
+    }
+
+    void convert(size_t chunkStart, size_t chunkEnd) const
+    {
+      int64_t zBlock = m_Dims[0] * m_Dims[1];
+      for(size_t c = chunkStart; c < chunkEnd; c++)
+      {
+        std::vector<std::pair<int64_t, int32_t>>& found = m_Found[c];
+        found.clear();
+        size_t end = std::min(m_Frontier.size(), (c + 1) * m_ChunkSize);
+        for(size_t f = c * m_ChunkSize; f < end; f++)
+        {
+          int64_t index = m_Frontier[f];
+          int64_t x = index % m_Dims[0];
+          int64_t y = (index / m_Dims[0]) % m_Dims[1];
+          int64_t z = index / zBlock;
+          int64_t neighbors[6] = {-1, -1, -1, -1, -1, -1};
+          if(z > 0)
+          {
+            neighbors[0] = index - zBlock;
+          }
+          if(y > 0)
+          {
+            neighbors[1] = index - m_Dims[0];
+          }
+          if(x > 0)
+          {
+            neighbors[2] = index - 1;
+          }
+          if(x < m_Dims[0] - 1)
+          {
+            neighbors[3] = index + 1;
+          }
+          if(y < m_Dims[1] - 1)
+          {
+            neighbors[4] = index + m_Dims[0];
+          }
+          if(z < m_Dims[2] - 1)
+          {
+            neighbors[5] = index + zBlock;
+          }
+          for(int32_t k = 0; k < 6; k++)
+          {
+            int64_t neighbor = neighbors[k];
+            if(neighbor < 0 || m_NearestNeighbor[neighbor] != -1 || m_FeatureIds[neighbor] <= 0)
+            {
+              continue;
+            }
+            if(lastAssignedNeighbor(neighbor) == index)
+            {
+              found.push_back(std::make_pair(neighbor, m_NearestNeighbor[index]));
+            }
+          }
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+};
+
+/**
+ * @brief The ExactDistanceTransformImpl class performs one axis pass of the separable exact squared
+ * Euclidean distance transform of Felzenszwalb and Huttenlocher. Each line along the axis is replaced
+ * by the lower envelope of the parabolas rooted at its Cells, using the physical spacing of the axis,
+ * and the index of the nearest seed Cell is carried along with the distance.
+ */
+class ExactDistanceTransformImpl
+{
+    double* m_SquaredDistance;
+    int32_t* m_Nearest;
+    int64_t m_Dims[3];
+    int32_t m_Axis;
+    double m_Spacing;
+
+  public:
+    ExactDistanceTransformImpl(double* squaredDistance, int32_t* nearest, const int64_t dims[3], int32_t axis, double spacing)
+    : m_SquaredDistance(squaredDistance)
+    , m_Nearest(nearest)
+    , m_Axis(axis)
+    , m_Spacing(spacing)
+    {
+      m_Dims[0] = dims[0];
+      m_Dims[1] = dims[1];
+      m_Dims[2] = dims[2];
+    }
+
+    virtual ~ExactDistanceTransformImpl()
+    {
+    }
+
+    /**
+     * @brief getNumberOfLines Returns the number of lines that run along the axis
+     */
+    size_t getNumberOfLines() const
+    {
+      return static_cast<size_t>(m_Dims[0] * m_Dims[1] * m_Dims[2] / m_Dims[m_Axis]);
+    }
+
+    void convert(size_t lineStart, size_t lineEnd) const
+    {
+      const double infinity = std::numeric_limits<double>::infinity();
+      int64_t length = m_Dims[m_Axis];
+      std::vector<double> f(length, 0.0);
+      std::vector<int32_t> nearest(length, -1);
+      std::vector<int64_t> v(length, 0);
+      std::vector<double> z(length + 1, 0.0);
+
+      for(size_t line = lineStart; line < lineEnd; line++)
+      {
+        int64_t start = 0;
+        int64_t stride = 1;
+        if(m_Axis == 0)
+        {
+          start = static_cast<int64_t>(line) * m_Dims[0];
+        }
+        else if(m_Axis == 1)
+        {
+          start = (static_cast<int64_t>(line) / m_Dims[0]) * m_Dims[0] * m_Dims[1] + static_cast<int64_t>(line) % m_Dims[0];
+          stride = m_Dims[0];
+        }
+        else
+        {
+          start = static_cast<int64_t>(line);
+          stride = m_Dims[0] * m_Dims[1];
+        }
+
+        // Build the lower envelope of the parabolas of the Cells that have a finite distance
+        int64_t k = -1;
+        for(int64_t q = 0; q < length; q++)
+        {
+          f[q] = m_SquaredDistance[start + q * stride];
+          nearest[q] = m_Nearest[start + q * stride];
+          if(f[q] == infinity)
+          {
+            continue;
+          }
+          double xq = static_cast<double>(q) * m_Spacing;
+          double s = 0.0;
+          while(k >= 0)
+          {
+            double xv = static_cast<double>(v[k]) * m_Spacing;
+            s = ((f[q] + xq * xq) - (f[v[k]] + xv * xv)) / (2.0 * (xq - xv));
+            if(s > z[k])
+            {
+              break;
+            }
+            k--;
+          }
+          k++;
+          v[k] = q;
+          z[k] = (k == 0) ? -infinity : s;
+          z[k + 1] = infinity;
+        }
+        if(k < 0)
+        {
+          continue;
+        }
+
+        int64_t j = 0;
+        for(int64_t p = 0; p < length; p++)
+        {
+          double xp = static_cast<double>(p) * m_Spacing;
+          while(z[j + 1] < xp)
+          {
+            j++;
+          }
+          double dx = xp - static_cast<double>(v[j]) * m_Spacing;
+          m_SquaredDistance[start + p * stride] = dx * dx + f[v[j]];
+          m_Nearest[start + p * stride] = nearest[v[j]];
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+};
+
 /**
  * @brief The ComputeDistanceMapImpl class implements a threaded algorithm that computes the  distance map
  * for each point in the supplied volume
@@ -95,11 +356,7 @@ class ComputeDistanceMapImpl
       ImageGeom::Pointer imageGeom = m_DataContainer->getGeometryAs<ImageGeom>();
       size_t totalPoints = imageGeom->getNumberOfElements();
       double Distance = 0.0;
-      size_t count = 1;
-      size_t changed = 1;
-      size_t neighpoint = 0;
       int64_t nearestneighbor;
-      int64_t neighbors[6] = {0, 0, 0, 0, 0, 0};
       int64_t xpoints = static_cast<int64_t>(imageGeom->getXPoints());
       int64_t ypoints = static_cast<int64_t>(imageGeom->getYPoints());
       int64_t zpoints = static_cast<int64_t>(imageGeom->getZPoints());
@@ -107,13 +364,6 @@ class ComputeDistanceMapImpl
       double resy = static_cast<double>(imageGeom->getYRes());
       double resz = static_cast<double>(imageGeom->getZRes());
 
-      neighbors[0] = -xpoints * ypoints;
-      neighbors[1] = -xpoints;
-      neighbors[2] = -1;
-      neighbors[3] = 1;
-      neighbors[4] = xpoints;
-      neighbors[5] = xpoints * ypoints;
-
       // Use a std::vector to get an auto cleaned up array thus not needing the 'delete' keyword later on.
       std::vector<int32_t> voxNN(totalPoints, 0);
       int32_t* voxel_NearestNeighbor = &(voxNN.front());
@@ -146,89 +396,76 @@ class ComputeDistanceMapImpl
       }
 
       // ------------- Calculate the Manhattan Distance ----------------
-      count = 1;
-      changed = 1;
-      int64_t i = 0;
-      int64_t zBlock = xpoints * ypoints;
-      int64_t zStride = 0, yStride = 0;
-      char mask[6] = {0, 0, 0, 0, 0, 0};
-      while(count > 0 && changed > 0)
-      {
-        count = 0;
-        changed = 0;
-        Distance++;
+      // Each layer only has to look at the neighbors of the previous layer
+      int64_t dims[3] = {xpoints, ypoints, zpoints};
+      std::vector<int64_t> frontier;
+      for(size_t a = 0; a < totalPoints; ++a)
+      {
+        if(voxel_Distance[a] != -1.0)
+        {
+          frontier.push_back(static_cast<int64_t>(a));
+        }
+      }
 
-        for(int64_t z = 0; z < zpoints; ++z)
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      size_t maxChunks = static_cast<size_t>(tbb::task_scheduler_init::default_num_threads()) * 8;
+#else
+      size_t maxChunks = 1;
+#endif
+      std::vector<std::vector<std::pair<int64_t, int32_t>>> found(maxChunks);
+      std::vector<int64_t> nextFrontier;
+      bool firstLayer = true;
+      do
+      {
+        Distance++;
+        size_t numChunks = std::min(maxChunks, frontier.size() / 4096 + 1);
+        size_t chunkSize = (frontier.size() + numChunks - 1) / numChunks;
+        DistanceFrontierImpl impl(m_FeatureIds, voxel_NearestNeighbor, voxel_Distance, frontier, found, dims, chunkSize);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        if(numChunks > 1)
         {
-          zStride = z * zBlock;
-          mask[0] = mask[5] = 1;
-          if(z == 0)
-          {
-            mask[0] = 0;
-          }
-          if(z == zpoints - 1)
-          {
-            mask[5] = 0;
-          }
+          tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks, 1), impl, tbb::simple_partitioner());
+        }
+        else
+#endif
+        {
+          impl.convert(0, numChunks);
+        }
 
-          for(int64_t y = 0; y < ypoints; ++y)
+        nextFrontier.clear();
+        if(firstLayer)
+        {
+          // Cells that start out with a nearest neighbor but without a distance are given the first layer's distance
+          for(size_t a = 0; a < totalPoints; ++a)
           {
-            yStride = y * xpoints;
-            mask[1] = mask[4] = 1;
-            if(y == 0)
+            if(voxel_NearestNeighbor[a] != -1 && voxel_Distance[a] == -1.0 && m_FeatureIds[a] > 0)
             {
-              mask[1] = 0;
-            }
-            if(y == ypoints - 1)
-            {
-              mask[4] = 0;
-            }
-
-            for(int64_t x = 0; x < xpoints; ++x)
-            {
-              mask[2] = mask[3] = 1;
-              if(x == 0)
-              {
-                mask[2] = 0;
-              }
-              if(x == xpoints - 1)
-              {
-                mask[3] = 0;
-              }
-
-              i = zStride + yStride + x;
-              if(voxel_NearestNeighbor[i] == -1 && m_FeatureIds[i] > 0)
-              {
-                count++;
-                for(int32_t j = 0; j < 6; j++)
-                {
-                  neighpoint = i + neighbors[j];
-                  if(mask[j] == 1)
-                  {
-                    if(voxel_Distance[neighpoint] != -1.0)
-                    {
-                      voxel_NearestNeighbor[i] = voxel_NearestNeighbor[neighpoint];
-                    }
-                  }
-                }
-              }
+              nextFrontier.push_back(static_cast<int64_t>(a));
             }
           }
+          firstLayer = false;
         }
-        for(size_t j = 0; j < totalPoints; ++j)
+        for(size_t c = 0; c < numChunks; c++)
         {
-          if(voxel_NearestNeighbor[j] != -1 && voxel_Distance[j] == -1.0 && m_FeatureIds[j] > 0)
+          for(std::vector<std::pair<int64_t, int32_t>>::iterator iter = found[c].begin(); iter != found[c].end(); ++iter)
           {
-            changed++;
-            voxel_Distance[j] = Distance;
+            voxel_NearestNeighbor[iter->first] = iter->second;
+            nextFrontier.push_back(iter->first);
           }
         }
-      }
+        for(std::vector<int64_t>::iterator iter = nextFrontier.begin(); iter != nextFrontier.end(); ++iter)
+        {
+          voxel_Distance[*iter] = Distance;
+        }
+        frontier.swap(nextFrontier);
+      } while(!frontier.empty());
 
       // ------------- Calculate the Euclidian Distance ----------------
 
       if(m_CalcManhattanDist == false)
       {
+        int64_t zBlock = xpoints * ypoints;
+        int64_t zStride = 0, yStride = 0;
         double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0, z1 = 0.0, z2 = 0.0;
         double dist = 0.0;
         double oneOverzBlock = 1.0 / double(zBlock);
@@ -295,6 +532,7 @@ FindEuclideanDistMap::FindEuclideanDistMap()
   , m_DoQuadPoints(false)
   , m_SaveNearestNeighbors(false)
   , m_CalcManhattanDist(true)
+  , m_ExactEuclideanDist(false)
   , m_FeatureIds(nullptr)
   , m_NearestNeighbors(nullptr)
   , m_GBEuclideanDistances(nullptr)
@@ -321,6 +559,7 @@ void FindEuclideanDistMap::setupFilterParameters()
 {
   FilterParameterVector parameters;
   parameters.push_back(SIMPL_NEW_BOOL_FP("Calculate Manhattan Distance", CalcManhattanDist, FilterParameter::Parameter, FindEuclideanDistMap));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Exact Euclidean Distance Transform", ExactEuclideanDist, FilterParameter::Parameter, FindEuclideanDistMap));
   QStringList linkedProps("GBDistancesArrayName");
 
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Calculate Distance to Boundaries", DoBoundaries, FilterParameter::Parameter, FindEuclideanDistMap, linkedProps));
@@ -366,6 +605,7 @@ void FindEuclideanDistMap::readFilterParameters(AbstractFilterParametersReader*
   setDoQuadPoints(reader->readValue("DoQuadPoints", getDoQuadPoints()));
   setSaveNearestNeighbors(reader->readValue("SaveNearestNeighbors", getSaveNearestNeighbors()));
   setCalcManhattanDist(reader->readValue("CalcOnlyManhattanDist", getCalcManhattanDist()));
+  setExactEuclideanDist(reader->readValue("ExactEuclideanDist", getExactEuclideanDist()));
   reader->closeFilterGroup();
 }
 
@@ -670,6 +910,23 @@ void FindEuclideanDistMap::findDistanceMap()
     }
   }
 
+  if(m_CalcManhattanDist == false && m_ExactEuclideanDist == true)
+  {
+    if(m_DoBoundaries == true)
+    {
+      findExactDistanceMap(MapType::FeatureBoundary, m_GBEuclideanDistances);
+    }
+    if(m_DoTripleLines == true)
+    {
+      findExactDistanceMap(MapType::TripleJunction, m_TJEuclideanDistances);
+    }
+    if(m_DoQuadPoints == true)
+    {
+      findExactDistanceMap(MapType::QuadPoint, m_QPEuclideanDistances);
+    }
+    return;
+  }
+
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
   tbb::task_scheduler_init init;
   bool doParallel = true;
@@ -747,6 +1004,75 @@ void FindEuclideanDistMap::findDistanceMap()
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindEuclideanDistMap::findExactDistanceMap(MapType mapType, float* distances)
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
+  ImageGeom::Pointer imageGeom = m->getGeometryAs<ImageGeom>();
+
+  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
+  int64_t dims[3] = {
+    static_cast<int64_t>(imageGeom->getXPoints()), static_cast<int64_t>(imageGeom->getYPoints()), static_cast<int64_t>(imageGeom->getZPoints()),
+  };
+  double spacing[3] = {
+    static_cast<double>(imageGeom->getXRes()), static_cast<double>(imageGeom->getYRes()), static_cast<double>(imageGeom->getZRes()),
+  };
+  uint32_t mapIndex = static_cast<uint32_t>(mapType);
+
+  // The Cells that were given a distance of 0 are the seeds of the transform
+  std::vector<double> squaredDistance(totalPoints, std::numeric_limits<double>::infinity());
+  std::vector<int32_t> nearest(totalPoints, -1);
+  for(size_t a = 0; a < totalPoints; ++a)
+  {
+    if(distances[a] == 0.0f)
+    {
+      squaredDistance[a] = 0.0;
+      nearest[a] = static_cast<int32_t>(a);
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  for(int32_t axis = 0; axis < 3; axis++)
+  {
+    if(dims[axis] < 2)
+    {
+      continue;
+    }
+    ExactDistanceTransformImpl impl(squaredDistance.data(), nearest.data(), dims, axis, spacing[axis]);
+    size_t numLines = impl.getNumberOfLines();
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numLines), impl, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      impl.convert(0, numLines);
+    }
+  }
+
+  for(size_t a = 0; a < totalPoints; ++a)
+  {
+    if(m_FeatureIds[a] > 0 && nearest[a] >= 0)
+    {
+      distances[a] = static_cast<float>(std::sqrt(squaredDistance[a]));
+      m_NearestNeighbors[a * 3 + mapIndex] = nearest[a];
+    }
+    else
+    {
+      distances[a] = -1.0f;
+      m_NearestNeighbors[a * 3 + mapIndex] = -1;
+    }
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -94,6 +94,9 @@ class FindEuclideanDistMap : public AbstractFilter
     SIMPL_FILTER_PARAMETER(bool, CalcManhattanDist)
     Q_PROPERTY(bool CalcManhattanDist READ getCalcManhattanDist WRITE setCalcManhattanDist)
 
+    SIMPL_FILTER_PARAMETER(bool, ExactEuclideanDist)
+    Q_PROPERTY(bool ExactEuclideanDist READ getExactEuclideanDist WRITE setExactEuclideanDist)
+
     /**
      * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
      */
@@ -195,6 +198,14 @@ class FindEuclideanDistMap : public AbstractFilter
      */
     void findDistanceMap();
 
+    /**
+     * @brief findExactDistanceMap Replaces the distances of one map with the exact Euclidean distance to the
+     * nearest Cell with a distance of 0, using a separable distance transform that is threaded over lines
+     * @param mapType Which of the maps to compute
+     * @param distances The distance array of that map
+     */
+    void findExactDistanceMap(MapType mapType, float* distances);
+
   private:
     DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
 
@@ -35,8 +35,16 @@
 
 #include "FindFeatureClustering.h"
 
+#include <algorithm>
 #include <fstream>
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
@@ -55,6 +63,81 @@
 // Include the MOC generated file for this class
 #include "moc_FindFeatureClustering.cpp"
 
+/**
+ * @brief The FindFeatureClusteringImpl class fills the clustering list of each feature in a range of the features
+ * of the selected phase with its distances to every other feature of that phase, in feature Id order. Each
+ * distance is computed from the lower feature Id to the higher one, as the serial pair loop did, so every
+ * feature can fill its own list independently. The smallest and largest distance of each list are kept as well.
+ */
+class FindFeatureClusteringImpl
+{
+public:
+  FindFeatureClusteringImpl(const std::vector<size_t>* phaseFeatures, const float* centroids, std::vector<std::vector<float>>* clusteringList, float* listMin, float* listMax)
+  : m_PhaseFeatures(phaseFeatures)
+  , m_Centroids(centroids)
+  , m_ClusteringList(clusteringList)
+  , m_ListMin(listMin)
+  , m_ListMax(listMax)
+  {
+  }
+
+  virtual ~FindFeatureClusteringImpl()
+  {
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    const std::vector<size_t>& phaseFeatures = *m_PhaseFeatures;
+    size_t numPhaseFeatures = phaseFeatures.size();
+    for(size_t p = start; p < end; p++)
+    {
+      size_t i = phaseFeatures[p];
+      std::vector<float>& distances = (*m_ClusteringList)[i];
+      distances.resize(numPhaseFeatures - 1);
+
+      float min = std::numeric_limits<float>::max();
+      float max = 0.0f;
+      const float* c = m_Centroids + 3 * i;
+      for(size_t q = 0; q < numPhaseFeatures; q++)
+      {
+        if(q == p)
+        {
+          continue;
+        }
+        const float* cn = m_Centroids + 3 * phaseFeatures[q];
+        const float* lower = (q < p) ? cn : c;
+        const float* upper = (q < p) ? c : cn;
+        float r = sqrtf((lower[0] - upper[0]) * (lower[0] - upper[0]) + (lower[1] - upper[1]) * (lower[1] - upper[1]) + (lower[2] - upper[2]) * (lower[2] - upper[2]));
+        distances[(q < p) ? q : q - 1] = r;
+        if(r > max)
+        {
+          max = r;
+        }
+        if(r < min)
+        {
+          min = r;
+        }
+      }
+      m_ListMin[p] = min;
+      m_ListMax[p] = max;
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const std::vector<size_t>* m_PhaseFeatures;
+  const float* m_Centroids;
+  std::vector<std::vector<float>>* m_ClusteringList;
+  float* m_ListMin;
+  float* m_ListMax;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -258,16 +341,11 @@ void FindFeatureClustering::find_clustering()
     writeErrorFile = true;
   }
 
-  float x = 0.0f, y = 0.0f, z = 0.0f;
-  float xn = 0.0f, yn = 0.0f, zn = 0.0f;
-  float r = 0.0f;
-
   int32_t bin = 0;
   int32_t ensemble = 0;
   int32_t totalPPTfeatures = 0;
   float min = std::numeric_limits<float>::max();
   float max = 0.0f;
-  float value = 0.0f;
   float sizex = 0.0f, sizey = 0.0f, sizez = 0.0f, totalvol = 0.0f, totalpoints = 0.0f;
   float normFactor = 0.0f;
 
@@ -298,71 +376,77 @@ void FindFeatureClustering::find_clustering()
   boxres[1] = m->getGeometryAs<ImageGeom>()->getYRes();
   boxres[2] = m->getGeometryAs<ImageGeom>()->getZRes();
 
+  // Every feature of the phase is paired with every other feature of the phase
+  std::vector<size_t> phaseFeatures;
   for(size_t i = 1; i < totalFeatures; i++)
   {
     if(m_FeaturePhases[i] == m_PhaseNumber)
     {
-      totalPPTfeatures++;
+      phaseFeatures.push_back(i);
     }
   }
+  totalPPTfeatures = static_cast<int32_t>(phaseFeatures.size());
 
   clusteringlist.resize(totalFeatures);
 
-  for(size_t i = 1; i < totalFeatures; i++)
+  size_t batchSize = 1000;
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  batchSize *= static_cast<size_t>(tbb::task_scheduler_init::default_num_threads());
+#endif
+
+  std::vector<float> listMin(phaseFeatures.size(), min);
+  std::vector<float> listMax(phaseFeatures.size(), max);
+  FindFeatureClusteringImpl impl(&phaseFeatures, m_Centroids, &clusteringlist, listMin.data(), listMax.data());
+  for(size_t batchStart = 0; batchStart < phaseFeatures.size(); batchStart += batchSize)
   {
-    if(m_FeaturePhases[i] == m_PhaseNumber)
+    if(getCancel() == true)
     {
-      if(i % 1000 == 0)
-      {
-        QString ss = QObject::tr("Working on Feature %1 of %2").arg(i).arg(totalPPTfeatures);
-        notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-      }
-
-      x = m_Centroids[3 * i];
-      y = m_Centroids[3 * i + 1];
-      z = m_Centroids[3 * i + 2];
-
-      for(size_t j = i + 1; j < totalFeatures; j++)
-      {
-        if(m_FeaturePhases[i] == m_FeaturePhases[j])
-        {
-          xn = m_Centroids[3 * j];
-          yn = m_Centroids[3 * j + 1];
-          zn = m_Centroids[3 * j + 2];
-
-          r = sqrtf((x - xn) * (x - xn) + (y - yn) * (y - yn) + (z - zn) * (z - zn));
+      return;
+    }
 
-          clusteringlist[i].push_back(r);
-          clusteringlist[j].push_back(r);
+    QString ss = QObject::tr("Working on Feature %1 of %2").arg(batchStart).arg(totalPPTfeatures);
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
 
-          if(writeErrorFile == true && m_FeaturePhases[j] == 2)
-          {
-            outFile << r << "\n" << r << "\n";
-          }
-        }
-      }
+    size_t batchEnd = std::min(batchStart + batchSize, phaseFeatures.size());
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(batchStart, batchEnd, 16), impl, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      impl.convert(batchStart, batchEnd);
     }
   }
 
-  for(size_t i = 1; i < totalFeatures; i++)
+  // The pairs are written in the order of the serial pair loop, which is the tail of each feature's list
+  if(writeErrorFile == true && m_PhaseNumber == 2)
   {
-    for(size_t j = 0; j < clusteringlist[i].size(); j++)
+    for(size_t p = 0; p < phaseFeatures.size(); p++)
     {
-      if(m_FeaturePhases[i] == m_PhaseNumber)
+      const std::vector<float>& distances = clusteringlist[phaseFeatures[p]];
+      for(size_t q = p; q < distances.size(); q++)
       {
-        value = clusteringlist[i][j];
-        if(value > max)
-        {
-          max = value;
-        }
-        if(value < min)
-        {
-          min = value;
-        }
+        outFile << distances[q] << "\n" << distances[q] << "\n";
       }
     }
   }
 
+  for(size_t p = 0; p < phaseFeatures.size(); p++)
+  {
+    if(listMax[p] > max)
+    {
+      max = listMax[p];
+    }
+    if(listMin[p] < min)
+    {
+      min = listMin[p];
+    }
+  }
+
   float stepsize = (max - min) / m_NumberOfBins;
 
   m_MaxMinArray[(m_PhaseNumber * 2)] = max;
@@ -437,7 +521,7 @@ void FindFeatureClustering::find_clustering()
   {
     // Set the vector for each list into the Clustering Object
     NeighborList<float>::SharedVectorType sharedClustLst(new std::vector<float>);
-    sharedClustLst->assign(clusteringlist[i].begin(), clusteringlist[i].end());
+    sharedClustLst->swap(clusteringlist[i]);
     m_ClusteringList.lock()->setList(static_cast<int>(i), sharedClustLst);
   }
 }
@@ -35,6 +35,16 @@
 
 #include "FindNeighborhoods.h"
 
+#include <algorithm>
+#include <limits>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -50,6 +60,128 @@
 // Include the MOC generated file for this class
 #include "moc_FindNeighborhoods.cpp"
 
+/**
+ * @brief The FindNeighborhoodsImpl class finds the neighborhood of each feature in a range of features. The
+ * features are sorted by their centroid bin (Z, then Y, then X, then feature Id), so the features of any run of
+ * bins along X are found with a binary search. Only the bins that are closer than the critical distance of a
+ * feature are visited, and every feature writes only its own list.
+ */
+class FindNeighborhoodsImpl
+{
+public:
+  typedef struct
+  {
+    int64_t bin[3];
+    int32_t feature;
+  } BinnedFeature_t;
+
+  FindNeighborhoodsImpl(const std::vector<BinnedFeature_t>* sortedFeatures, const int64_t* bins, const float* criticalDistance, const int64_t minBin[3], const int64_t maxBin[3],
+                        std::vector<std::vector<int32_t>>* neighborhoodList, int32_t* neighborhoods)
+  : m_SortedFeatures(sortedFeatures)
+  , m_Bins(bins)
+  , m_CriticalDistance(criticalDistance)
+  , m_NeighborhoodList(neighborhoodList)
+  , m_Neighborhoods(neighborhoods)
+  {
+    for(int32_t d = 0; d < 3; d++)
+    {
+      m_MinBin[d] = minBin[d];
+      m_MaxBin[d] = maxBin[d];
+    }
+  }
+
+  virtual ~FindNeighborhoodsImpl()
+  {
+  }
+
+  /**
+   * @brief LessThan Orders the binned features by Z, Y and X bin and then by feature Id
+   */
+  static bool LessThan(const BinnedFeature_t& a, const BinnedFeature_t& b)
+  {
+    for(int32_t d = 2; d >= 0; d--)
+    {
+      if(a.bin[d] != b.bin[d])
+      {
+        return a.bin[d] < b.bin[d];
+      }
+    }
+    return a.feature < b.feature;
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    const std::vector<BinnedFeature_t>& sortedFeatures = *m_SortedFeatures;
+    int64_t maxSpan = std::max(m_MaxBin[0] - m_MinBin[0], std::max(m_MaxBin[1] - m_MinBin[1], m_MaxBin[2] - m_MinBin[2]));
+
+    BinnedFeature_t lower;
+    BinnedFeature_t upper;
+    for(size_t i = start; i < end; i++)
+    {
+      std::vector<int32_t>& neighborhood = (*m_NeighborhoodList)[i];
+      neighborhood.clear();
+
+      // A feature j is in the neighborhood of i when its bin is less than the critical distance of i away
+      // along every axis, so the farthest bin offset that can still count is the largest integer below it
+      float criticalDistance = m_CriticalDistance[i];
+      if(criticalDistance > 0.0f)
+      {
+        int64_t reach = maxSpan;
+        if(criticalDistance <= static_cast<float>(maxSpan))
+        {
+          reach = static_cast<int64_t>(ceilf(criticalDistance)) - 1;
+        }
+
+        const int64_t* bin = m_Bins + 3 * i;
+        int64_t zStart = std::max(bin[2] - reach, m_MinBin[2]);
+        int64_t zEnd = std::min(bin[2] + reach, m_MaxBin[2]);
+        int64_t yStart = std::max(bin[1] - reach, m_MinBin[1]);
+        int64_t yEnd = std::min(bin[1] + reach, m_MaxBin[1]);
+        lower.bin[0] = bin[0] - reach;
+        lower.feature = std::numeric_limits<int32_t>::min();
+        upper.bin[0] = bin[0] + reach;
+        upper.feature = std::numeric_limits<int32_t>::max();
+
+        for(int64_t z = zStart; z <= zEnd; z++)
+        {
+          lower.bin[2] = upper.bin[2] = z;
+          for(int64_t y = yStart; y <= yEnd; y++)
+          {
+            lower.bin[1] = upper.bin[1] = y;
+            std::vector<BinnedFeature_t>::const_iterator first = std::lower_bound(sortedFeatures.begin(), sortedFeatures.end(), lower, LessThan);
+            std::vector<BinnedFeature_t>::const_iterator last = std::upper_bound(first, sortedFeatures.end(), upper, LessThan);
+            for(; first != last; ++first)
+            {
+              if(static_cast<size_t>(first->feature) != i)
+              {
+                neighborhood.push_back(first->feature);
+              }
+            }
+          }
+        }
+        std::sort(neighborhood.begin(), neighborhood.end());
+      }
+      m_Neighborhoods[i] = static_cast<int32_t>(neighborhood.size());
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const std::vector<BinnedFeature_t>* m_SortedFeatures;
+  const int64_t* m_Bins;
+  const float* m_CriticalDistance;
+  int64_t m_MinBin[3];
+  int64_t m_MaxBin[3];
+  std::vector<std::vector<int32_t>>* m_NeighborhoodList;
+  int32_t* m_Neighborhoods;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -255,56 +387,64 @@ void FindNeighborhoods::find_neighborhoods()
     bins[3 * i + 2] = zbin;
   }
 
-  int64_t bin1x = 0, bin2x = 0, bin1y = 0, bin2y = 0, bin1z = 0, bin2z = 0;
-  float dBinX = 0, dBinY = 0, dBinZ = 0;
-  float criticalDistance1 = 0, criticalDistance2 = 0;
+  if(totalFeatures < 2)
+  {
+    return;
+  }
 
+  // Sort the features by bin so that the features of a run of bins are contiguous
+  int64_t minBin[3] = {bins[3], bins[4], bins[5]};
+  int64_t maxBin[3] = {bins[3], bins[4], bins[5]};
+  std::vector<FindNeighborhoodsImpl::BinnedFeature_t> sortedFeatures(totalFeatures - 1);
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    if(i % 1000 == 0)
+    FindNeighborhoodsImpl::BinnedFeature_t& binned = sortedFeatures[i - 1];
+    for(int32_t d = 0; d < 3; d++)
     {
-
-      QString ss = QObject::tr("Working on Feature %1 of %2").arg(i).arg(totalFeatures);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+      binned.bin[d] = bins[3 * i + d];
+      minBin[d] = std::min(minBin[d], binned.bin[d]);
+      maxBin[d] = std::max(maxBin[d], binned.bin[d]);
     }
-    x = m_Centroids[3 * i];
-    y = m_Centroids[3 * i + 1];
-    z = m_Centroids[3 * i + 2];
-    bin1x = bins[3 * i];
-    bin1y = bins[3 * i + 1];
-    bin1z = bins[3 * i + 2];
-    criticalDistance1 = criticalDistance[i];
+    binned.feature = static_cast<int32_t>(i);
+  }
+  std::sort(sortedFeatures.begin(), sortedFeatures.end(), FindNeighborhoodsImpl::LessThan);
 
-    for(size_t j = i + 1; j < totalFeatures; j++)
+  size_t batchSize = 10000;
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  batchSize *= static_cast<size_t>(tbb::task_scheduler_init::default_num_threads());
+#endif
+
+  FindNeighborhoodsImpl impl(&sortedFeatures, bins.data(), criticalDistance.data(), minBin, maxBin, &neighborhoodlist, m_Neighborhoods);
+  for(size_t batchStart = 1; batchStart < totalFeatures; batchStart += batchSize)
+  {
+    if(getCancel() == true)
     {
-      bin2x = bins[3 * j];
-      bin2y = bins[3 * j + 1];
-      bin2z = bins[3 * j + 2];
-      criticalDistance2 = criticalDistance[j];
-      // Use the llabs version of the "C" abs function because we are using int64_t
-      // do NOT try to use the std::abs() function as this is C++11 ONLY
-      dBinX = llabs(bin2x - bin1x);
-      dBinY = llabs(bin2y - bin1y);
-      dBinZ = llabs(bin2z - bin1z);
-
-      if(dBinX < criticalDistance1 && dBinY < criticalDistance1 && dBinZ < criticalDistance1)
-      {
-        m_Neighborhoods[i]++;
-        neighborhoodlist[i].push_back(j);
-      }
+      return;
+    }
 
-      if(dBinX < criticalDistance2 && dBinY < criticalDistance2 && dBinZ < criticalDistance2)
-      {
-        m_Neighborhoods[j]++;
-        neighborhoodlist[j].push_back(i);
-      }
+    QString ss = QObject::tr("Working on Feature %1 of %2").arg(batchStart).arg(totalFeatures);
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+
+    size_t batchEnd = std::min(batchStart + batchSize, totalFeatures);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(batchStart, batchEnd, 256), impl, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      impl.convert(batchStart, batchEnd);
     }
   }
+
   for(size_t i = 1; i < totalFeatures; i++)
   {
     // Set the vector for each list into the NeighborhoodList Object
     NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>);
-    sharedNeiLst->assign(neighborhoodlist[i].begin(), neighborhoodlist[i].end());
+    sharedNeiLst->swap(neighborhoodlist[i]);
     m_NeighborhoodList.lock()->setList(static_cast<int32_t>(i), sharedNeiLst);
   }
 }
@@ -35,7 +35,15 @@
 
 #include "FindNeighbors.h"
 
-#include <QtCore/QDateTime>
+#include <algorithm>
+#include <unordered_map>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -46,12 +54,141 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "Statistics/StatisticsFilters/util/VoxelNeighborhood.hpp"
+
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
 
 // Include the MOC generated file for this class
 #include "moc_FindNeighbors.cpp"
 
+/**
+ * @brief The FindNeighborsImpl class scans chunks of consecutive rows (lines of voxels along X) and
+ * accumulates, for every pair of touching features, the number of faces they share into a hash map
+ * owned by the chunk. Each face is counted once by the voxel on its lower side, so chunks never write
+ * to the same map and a face that crosses a chunk boundary is still seen exactly once.
+ */
+class FindNeighborsImpl
+{
+public:
+  typedef std::unordered_map<uint64_t, int32_t> FaceCountMap;
+
+  FindNeighborsImpl(int32_t* featureIds, int8_t* boundaryCells, const int64_t dims[3], int64_t rowsPerChunk, std::vector<FaceCountMap>* faceCounts, std::vector<std::vector<int32_t>>* surfaceFeatures,
+                    bool findSurfaceFeatures)
+  : m_FeatureIds(featureIds)
+  , m_BoundaryCells(boundaryCells)
+  , m_Neighborhood(dims)
+  , m_RowsPerChunk(rowsPerChunk)
+  , m_FaceCounts(faceCounts)
+  , m_SurfaceFeatures(surfaceFeatures)
+  , m_FindSurfaceFeatures(findSurfaceFeatures)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+
+  virtual ~FindNeighborsImpl()
+  {
+  }
+
+  /**
+   * @brief PackPair Builds the hash key for an unordered pair of feature Ids
+   */
+  static uint64_t PackPair(int32_t a, int32_t b)
+  {
+    if(a > b)
+    {
+      std::swap(a, b);
+    }
+    return (static_cast<uint64_t>(static_cast<uint32_t>(a)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(b));
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    const int64_t xPoints = m_Dims[0];
+    const int64_t yPoints = m_Dims[1];
+    const int64_t zPoints = m_Dims[2];
+    const int64_t numRows = yPoints * zPoints;
+
+    for(size_t chunk = start; chunk < end; chunk++)
+    {
+      FaceCountMap& faceCounts = (*m_FaceCounts)[chunk];
+      std::vector<int32_t>& surfaceFeatures = (*m_SurfaceFeatures)[chunk];
+
+      // Neighboring voxels along a row usually see the same pair of features in a given direction,
+      // so remember the last slot per forward direction and skip the hash lookup when it repeats
+      uint64_t cachedKey[3] = {0, 0, 0};
+      int32_t* cachedCount[3] = {nullptr, nullptr, nullptr};
+
+      int64_t rowStart = static_cast<int64_t>(chunk) * m_RowsPerChunk;
+      int64_t rowEnd = std::min(numRows, rowStart + m_RowsPerChunk);
+      m_Neighborhood.forEachVoxel(rowStart, rowEnd, [&](int64_t j, int64_t column, int64_t row, int64_t plane, bool interior) {
+        int32_t feature = m_FeatureIds[j];
+        int8_t onsurf = 0;
+        if(feature > 0)
+        {
+          if(m_FindSurfaceFeatures && (surfaceFeatures.empty() || surfaceFeatures.back() != feature))
+          {
+            bool onShell = (column == 0 || column == xPoints - 1 || row == 0 || row == yPoints - 1);
+            if(zPoints != 1 && (plane == 0 || plane == zPoints - 1))
+            {
+              onShell = true;
+            }
+            if(onShell)
+            {
+              surfaceFeatures.push_back(feature);
+            }
+          }
+
+          m_Neighborhood.forEachNeighbor(j, column, row, plane, interior, [&](int32_t k, int64_t neighpoint) {
+            int32_t neighbor = m_FeatureIds[neighpoint];
+            if(neighbor == feature || neighbor <= 0)
+            {
+              return;
+            }
+            onsurf++;
+            if(k < 3)
+            {
+              // The voxel on the other side of this face counts it
+              return;
+            }
+            uint64_t key = PackPair(feature, neighbor);
+            int32_t d = k - 3;
+            if(nullptr == cachedCount[d] || cachedKey[d] != key)
+            {
+              cachedCount[d] = &(faceCounts[key]);
+              cachedKey[d] = key;
+            }
+            (*cachedCount[d])++;
+          });
+        }
+        if(nullptr != m_BoundaryCells)
+        {
+          m_BoundaryCells[j] = onsurf;
+        }
+      });
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  int32_t* m_FeatureIds;
+  int8_t* m_BoundaryCells;
+  int64_t m_Dims[3];
+  VoxelNeighborhood<6> m_Neighborhood;
+  int64_t m_RowsPerChunk;
+  std::vector<FaceCountMap>* m_FaceCounts;
+  std::vector<std::vector<int32_t>>* m_SurfaceFeatures;
+  bool m_FindSurfaceFeatures;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -235,198 +372,142 @@ void FindNeighbors::execute()
   }
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
-  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
+  ImageGeom::Pointer imageGeom = m->getGeometryAs<ImageGeom>();
   size_t totalFeatures = m_NumNeighborsPtr.lock()->getNumberOfTuples();
 
   size_t udims[3] = {0, 0, 0};
-  m->getGeometryAs<ImageGeom>()->getDimensions(udims);
+  imageGeom->getDimensions(udims);
 
   int64_t dims[3] = {
       static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
   };
 
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -dims[0] * dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0] * dims[1];
-
-  int64_t column = 0, row = 0, plane = 0;
-  int32_t feature = 0;
-  int32_t nnum = 0;
-  int8_t onsurf = 0;
-  bool good = false;
-  int64_t neighbor = 0;
-
-  std::vector<std::vector<int32_t>> neighborlist;
-  std::vector<std::vector<float>> neighborsurfacearealist;
-
-  int32_t nListSize = 100;
-  neighborlist.resize(totalFeatures);
-  neighborsurfacearealist.resize(totalFeatures);
-
-  uint64_t millis = QDateTime::currentMSecsSinceEpoch();
-  uint64_t currentMillis = millis;
-
-  for(size_t i = 1; i < totalFeatures; i++)
+  size_t numThreads = 1;
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  numThreads = static_cast<size_t>(tbb::task_scheduler_init::default_num_threads());
+#endif
+
+  // Split the volume into chunks of whole rows. Having several chunks per thread keeps the threads
+  // balanced when the features are unevenly distributed, and processing the chunks in batches
+  // gives us a natural place to report progress and check for a cancel.
+  int64_t numRows = dims[1] * dims[2];
+  int64_t numChunks = std::max(static_cast<int64_t>(1), std::min(numRows, static_cast<int64_t>(numThreads * 16)));
+  int64_t rowsPerChunk = std::max(static_cast<int64_t>(1), (numRows + numChunks - 1) / numChunks);
+  numChunks = std::max(static_cast<int64_t>(1), (numRows + rowsPerChunk - 1) / rowsPerChunk);
+  size_t batchSize = numThreads * 4;
+
+  std::vector<FindNeighborsImpl::FaceCountMap> faceCounts(numChunks);
+  std::vector<std::vector<int32_t>> surfaceFeatures(numChunks);
+  FindNeighborsImpl impl(m_FeatureIds, m_StoreBoundaryCells ? m_BoundaryCells : nullptr, dims, rowsPerChunk, &faceCounts, &surfaceFeatures, m_StoreSurfaceFeatures);
+
+  for(size_t batchStart = 0; batchStart < static_cast<size_t>(numChunks); batchStart += batchSize)
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Finding Neighbors || Initializing Neighbor Lists || %1% Complete").arg((static_cast<float>(i) / totalFeatures) * 100);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
-
     if(getCancel() == true)
     {
       return;
     }
 
-    m_NumNeighbors[i] = 0;
-    neighborlist[i].resize(nListSize);
-    neighborsurfacearealist[i].assign(nListSize, -1.0f);
-    if(m_StoreSurfaceFeatures == true)
-    {
-      m_SurfaceFeatures[i] = false;
-    }
+    size_t batchEnd = std::min(batchStart + batchSize, static_cast<size_t>(numChunks));
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(batchStart, batchEnd, 1), impl, tbb::simple_partitioner());
+#else
+    impl.convert(batchStart, batchEnd);
+#endif
+
+    QString ss = QObject::tr("Finding Neighbors || Determining Neighbor Lists || %1% Complete").arg((static_cast<float>(batchEnd) / numChunks) * 100);
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
   }
 
-  for(size_t j = 0; j < totalPoints; j++)
+  if(m_StoreSurfaceFeatures == true)
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
+    for(size_t i = 1; i < totalFeatures; i++)
     {
-      QString ss = QObject::tr("Finding Neighbors || Determining Neighbor Lists || %1% Complete").arg((static_cast<float>(j) / totalPoints) * 100);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
-
-    if(getCancel() == true)
-    {
-      return;
+      m_SurfaceFeatures[i] = false;
     }
-
-    onsurf = 0;
-    feature = m_FeatureIds[j];
-    if(feature > 0)
+    for(size_t c = 0; c < surfaceFeatures.size(); c++)
     {
-      column = static_cast<int64_t>(j % m->getGeometryAs<ImageGeom>()->getXPoints());
-      row = static_cast<int64_t>((j / m->getGeometryAs<ImageGeom>()->getXPoints()) % m->getGeometryAs<ImageGeom>()->getYPoints());
-      plane = static_cast<int64_t>(j / (m->getGeometryAs<ImageGeom>()->getXPoints() * m->getGeometryAs<ImageGeom>()->getYPoints()));
-      if(m_StoreSurfaceFeatures == true)
-      {
-        if((column == 0 || column == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getXPoints() - 1)) || row == 0 ||
-            row == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getYPoints()) - 1) || plane == 0 || plane == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getZPoints() - 1))) &&
-           m->getGeometryAs<ImageGeom>()->getZPoints() != 1)
-        {
-          m_SurfaceFeatures[feature] = true;
-        }
-        if((column == 0 || column == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getXPoints() - 1)) || row == 0 ||
-            row == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getYPoints() - 1))) &&
-           m->getGeometryAs<ImageGeom>()->getZPoints() == 1)
-        {
-          m_SurfaceFeatures[feature] = true;
-        }
-      }
-      for(int32_t k = 0; k < 6; k++)
+      for(size_t s = 0; s < surfaceFeatures[c].size(); s++)
       {
-        good = true;
-        neighbor = static_cast<int64_t>(j + neighpoints[k]);
-        if(k == 0 && plane == 0)
-        {
-          good = false;
-        }
-        if(k == 5 && plane == (m->getGeometryAs<ImageGeom>()->getZPoints() - 1))
-        {
-          good = false;
-        }
-        if(k == 1 && row == 0)
-        {
-          good = false;
-        }
-        if(k == 4 && row == (m->getGeometryAs<ImageGeom>()->getYPoints() - 1))
-        {
-          good = false;
-        }
-        if(k == 2 && column == 0)
-        {
-          good = false;
-        }
-        if(k == 3 && column == (m->getGeometryAs<ImageGeom>()->getXPoints() - 1))
-        {
-          good = false;
-        }
-        if(good == true && m_FeatureIds[neighbor] != feature && m_FeatureIds[neighbor] > 0)
-        {
-          onsurf++;
-          nnum = m_NumNeighbors[feature];
-          neighborlist[feature].push_back(m_FeatureIds[neighbor]);
-          nnum++;
-          m_NumNeighbors[feature] = nnum;
-        }
+        m_SurfaceFeatures[surfaceFeatures[c][s]] = true;
       }
     }
-    if(m_StoreBoundaryCells == true)
-    {
-      m_BoundaryCells[j] = onsurf;
-    }
   }
 
-  // We do this to create new set of NeighborList objects
-  for(size_t i = 1; i < totalFeatures; i++)
+  // Merge the chunk maps into a compressed sparse row table. Every pair of features contributes
+  // one entry to each of its two features, and the entries for feature i live in
+  // [featureOffsets[i], featureOffsets[i + 1]). A pair that was seen by more than one chunk shows up
+  // as duplicate entries, which are combined once each feature's entries have been sorted.
+  std::vector<size_t> featureOffsets(totalFeatures + 1, 0);
+  for(size_t c = 0; c < faceCounts.size(); c++)
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
+    for(FindNeighborsImpl::FaceCountMap::const_iterator iter = faceCounts[c].begin(); iter != faceCounts[c].end(); ++iter)
     {
-      QString ss = QObject::tr("Finding Neighbors || Calculating Surface Areas || %1% Complete").arg(((float)i / totalFeatures) * 100);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
+      featureOffsets[(iter->first >> 32) + 1]++;
+      featureOffsets[(iter->first & 0xFFFFFFFF) + 1]++;
     }
+  }
+  for(size_t i = 0; i < totalFeatures; i++)
+  {
+    featureOffsets[i + 1] += featureOffsets[i];
+  }
 
-    if(getCancel() == true)
+  std::vector<std::pair<int32_t, int32_t>> csrEntries(featureOffsets[totalFeatures]);
+  std::vector<size_t> insertPos(featureOffsets.begin(), featureOffsets.end() - 1);
+  for(size_t c = 0; c < faceCounts.size(); c++)
+  {
+    for(FindNeighborsImpl::FaceCountMap::const_iterator iter = faceCounts[c].begin(); iter != faceCounts[c].end(); ++iter)
     {
-      return;
+      int32_t first = static_cast<int32_t>(iter->first >> 32);
+      int32_t second = static_cast<int32_t>(iter->first & 0xFFFFFFFF);
+      csrEntries[insertPos[first]++] = std::make_pair(second, iter->second);
+      csrEntries[insertPos[second]++] = std::make_pair(first, iter->second);
     }
+    FindNeighborsImpl::FaceCountMap().swap(faceCounts[c]);
+  }
 
-    QMap<int32_t, int32_t> neighToCount;
-    int32_t numneighs = static_cast<int32_t>(neighborlist[i].size());
+  float xRes = imageGeom->getXRes();
+  float yRes = imageGeom->getYRes();
+  size_t progIncrement = std::max(totalFeatures / 100, static_cast<size_t>(1));
+  size_t progCounter = 0;
 
-    // this increments the voxel counts for each feature
-    for(int32_t j = 0; j < numneighs; j++)
+  // We do this to create new set of NeighborList objects
+  for(size_t i = 1; i < totalFeatures; i++)
+  {
+    if(++progCounter == progIncrement)
     {
-      neighToCount[neighborlist[i][j]]++;
+      progCounter = 0;
+      if(getCancel() == true)
+      {
+        return;
+      }
+      QString ss = QObject::tr("Finding Neighbors || Calculating Surface Areas || %1% Complete").arg((static_cast<float>(i) / totalFeatures) * 100);
+      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
     }
 
-    QMap<int32_t, int32_t>::Iterator neighiter = neighToCount.find(0);
-    neighToCount.erase(neighiter);
-    neighiter = neighToCount.find(-1);
-    neighToCount.erase(neighiter);
-    // Resize the features neighbor list to zero
-    neighborlist[i].resize(0);
-    neighborsurfacearealist[i].resize(0);
+    std::vector<std::pair<int32_t, int32_t>>::iterator segBegin = csrEntries.begin() + featureOffsets[i];
+    std::vector<std::pair<int32_t, int32_t>>::iterator segEnd = csrEntries.begin() + featureOffsets[i + 1];
+    std::sort(segBegin, segEnd);
 
-    for(QMap<int32_t, int32_t>::iterator iter = neighToCount.begin(); iter != neighToCount.end(); ++iter)
+    NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>);
+    NeighborList<float>::SharedVectorType sharedSAL(new std::vector<float>);
+    sharedNeiLst->reserve(segEnd - segBegin);
+    sharedSAL->reserve(segEnd - segBegin);
+    for(std::vector<std::pair<int32_t, int32_t>>::iterator iter = segBegin; iter != segEnd;)
     {
-      int32_t neigh = iter.key();    // get the neighbor feature
-      int32_t number = iter.value(); // get the number of voxels
-      float area = float(number) * m->getGeometryAs<ImageGeom>()->getXRes() * m->getGeometryAs<ImageGeom>()->getYRes();
-
-      // Push the neighbor feature id back onto the list so we stay synced up
-      neighborlist[i].push_back(neigh);
-      neighborsurfacearealist[i].push_back(area);
+      int32_t neigh = iter->first;
+      int32_t number = 0;
+      for(; iter != segEnd && iter->first == neigh; ++iter)
+      {
+        number += iter->second;
+      }
+      sharedNeiLst->push_back(neigh);
+      sharedSAL->push_back(float(number) * xRes * yRes);
     }
-    m_NumNeighbors[i] = int32_t(neighborlist[i].size());
+    m_NumNeighbors[i] = static_cast<int32_t>(sharedNeiLst->size());
 
     // Set the vector for each list into the NeighborList Object
-    NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>);
-    sharedNeiLst->assign(neighborlist[i].begin(), neighborlist[i].end());
     m_NeighborList.lock()->setList(static_cast<int32_t>(i), sharedNeiLst);
-
-    NeighborList<float>::SharedVectorType sharedSAL(new std::vector<float>);
-    sharedSAL->assign(neighborsurfacearealist[i].begin(), neighborsurfacearealist[i].end());
     m_SharedSurfaceAreaList.lock()->setList(static_cast<int32_t>(i), sharedSAL);
   }
 
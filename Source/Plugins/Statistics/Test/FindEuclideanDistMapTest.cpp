@@ -33,6 +33,10 @@
 *
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
@@ -347,6 +351,98 @@ public:
     return EXIT_SUCCESS;
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int RunExactTest()
+  {
+    QVector<size_t> tDims = {10, 6, 1};
+    DataContainerArray::Pointer dca = initializeDataContainerArray(tDims);
+
+    QString filtName = "FindEuclideanDistMap";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryForFilter(filtName);
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+
+    AbstractFilter::Pointer filter = factory->create();
+    DREAM3D_REQUIRE(filter.get() != nullptr)
+
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    var.setValue(k_FeatureIdsArrayPath);
+    bool propWasSet = filter->setProperty("FeatureIdsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(false);
+    propWasSet = filter->setProperty("CalcManhattanDist", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(true);
+    propWasSet = filter->setProperty("ExactEuclideanDist", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(true);
+    propWasSet = filter->setProperty("SaveNearestNeighbors", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(QString("GBExactDistance"));
+    propWasSet = filter->setProperty("GBDistancesArrayName", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    filter->execute();
+    DREAM3D_REQUIRE(filter->getErrorCondition() >= 0);
+
+    AttributeMatrix::Pointer am = dca->getAttributeMatrix(k_FeatureIdsArrayPath);
+    Int32ArrayType::Pointer featureIds = am->getAttributeArrayAs<Int32ArrayType>(k_FeatureIdsArrayPath.getDataArrayName());
+    FloatArrayType::Pointer distances = am->getAttributeArrayAs<FloatArrayType>("GBExactDistance");
+    Int32ArrayType::Pointer nearestNeighbors = am->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::NearestNeighbors);
+    DREAM3D_REQUIRE(distances.get() != nullptr)
+    DREAM3D_REQUIRE(nearestNeighbors.get() != nullptr)
+
+    // Boundary Cells have a face neighbor that belongs to a different Feature
+    int64_t xPoints = static_cast<int64_t>(tDims[0]);
+    int64_t yPoints = static_cast<int64_t>(tDims[1]);
+    std::vector<int64_t> boundaryCells;
+    for(int64_t y = 0; y < yPoints; y++)
+    {
+      for(int64_t x = 0; x < xPoints; x++)
+      {
+        int32_t feature = featureIds->getValue(y * xPoints + x);
+        if(feature <= 0)
+        {
+          continue;
+        }
+        bool boundary = (x > 0 && featureIds->getValue(y * xPoints + x - 1) != feature) || (x < xPoints - 1 && featureIds->getValue(y * xPoints + x + 1) != feature) ||
+                        (y > 0 && featureIds->getValue((y - 1) * xPoints + x) != feature) || (y < yPoints - 1 && featureIds->getValue((y + 1) * xPoints + x) != feature);
+        if(boundary)
+        {
+          boundaryCells.push_back(y * xPoints + x);
+        }
+      }
+    }
+
+    // The resolution is (1, 2, 1), so the exact distance is the smallest anisotropic distance to a boundary Cell
+    for(int64_t i = 0; i < xPoints * yPoints; i++)
+    {
+      if(featureIds->getValue(i) <= 0)
+      {
+        DREAM3D_REQUIRE_EQUAL(distances->getValue(i), -1.0f)
+        continue;
+      }
+      float refValue = std::numeric_limits<float>::max();
+      for(size_t b = 0; b < boundaryCells.size(); b++)
+      {
+        float dx = static_cast<float>(i % xPoints - boundaryCells[b] % xPoints);
+        float dy = 2.0f * static_cast<float>(i / xPoints - boundaryCells[b] / xPoints);
+        refValue = std::min(refValue, std::sqrt(dx * dx + dy * dy));
+      }
+      float computedValue = distances->getValue(i);
+      DREAM3D_COMPARE_FLOATS(&computedValue, &refValue, 1);
+
+      int32_t nearest = nearestNeighbors->getComponent(i, 0);
+      DREAM3D_REQUIRE(std::find(boundaryCells.begin(), boundaryCells.end(), static_cast<int64_t>(nearest)) != boundaryCells.end())
+    }
+
+    return EXIT_SUCCESS;
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -358,6 +454,7 @@ public:
     DREAM3D_REGISTER_TEST(TestFilterAvailability());
 
     DREAM3D_REGISTER_TEST(RunTest())
+    DREAM3D_REGISTER_TEST(RunExactTest())
 
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
   }
@@ -0,0 +1,279 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include <cmath>
+#include <cstdlib>
+
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "StatisticsTestFileLocations.h"
+
+namespace FindNeighborhoodsTestConsts
+{
+const QString k_DataContainerName("TestDataContainer");
+const QString k_FeatureAttributeMatrixName("FeatureData");
+const QString k_EquivalentDiametersArrayName("EquivalentDiameters");
+const QString k_PhasesArrayName("Phases");
+const QString k_CentroidsArrayName("Centroids");
+const size_t k_NumFeatures = 2000;
+}
+
+class FindNeighborhoodsTest
+{
+public:
+  FindNeighborhoodsTest()
+  {
+  }
+  virtual ~FindNeighborhoodsTest()
+  {
+  }
+  SIMPL_TYPE_MACRO(FindNeighborhoodsTest)
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FindNeighborhoods Filter from the FilterManager
+    QString filtName = "FindNeighborhoods";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The FindNeighborhoodsTest requires the use of the " << filtName.toStdString() << " filter which is found in the Statistics Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer initializeDataContainerArray()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+
+    DataContainer::Pointer m = DataContainer::New();
+    m->setName(FindNeighborhoodsTestConsts::k_DataContainerName);
+    ImageGeom::Pointer geom = ImageGeom::CreateGeometry("ImageGeometry");
+    m->setGeometry(geom);
+    geom->setDimensions(100, 80, 60);
+    geom->setOrigin(-3.0f, 2.0f, 0.5f);
+    dca->addDataContainer(m);
+
+    QVector<size_t> featureDims(1, FindNeighborhoodsTestConsts::k_NumFeatures);
+    AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(featureDims, FindNeighborhoodsTestConsts::k_FeatureAttributeMatrixName, AttributeMatrix::Type::CellFeature);
+    m->addAttributeMatrix(FindNeighborhoodsTestConsts::k_FeatureAttributeMatrixName, featureAttrMat);
+
+    QVector<size_t> cDims(1, 1);
+    FloatArrayType::Pointer diameters = FloatArrayType::CreateArray(featureDims, cDims, FindNeighborhoodsTestConsts::k_EquivalentDiametersArrayName);
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(featureDims, cDims, FindNeighborhoodsTestConsts::k_PhasesArrayName);
+    cDims[0] = 3;
+    FloatArrayType::Pointer centroids = FloatArrayType::CreateArray(featureDims, cDims, FindNeighborhoodsTestConsts::k_CentroidsArrayName);
+    featureAttrMat->addAttributeArray(diameters->getName(), diameters);
+    featureAttrMat->addAttributeArray(phases->getName(), phases);
+    featureAttrMat->addAttributeArray(centroids->getName(), centroids);
+
+    // Scattered centroids, some of them in front of the origin, and a spread of sizes so that the
+    // critical distances cover several bins
+    diameters->setValue(0, 0.0f);
+    phases->setValue(0, 0);
+    centroids->initializeWithZeros();
+    for(size_t i = 1; i < FindNeighborhoodsTestConsts::k_NumFeatures; i++)
+    {
+      diameters->setValue(i, 1.0f + static_cast<float>((i * 37) % 23) * 0.25f);
+      phases->setValue(i, 1);
+      centroids->setComponent(i, 0, static_cast<float>((i * 7919) % 1013) * 0.1f - 5.0f);
+      centroids->setComponent(i, 1, static_cast<float>((i * 104729) % 809) * 0.1f);
+      centroids->setComponent(i, 2, static_cast<float>((i * 1299709) % 601) * 0.1f);
+    }
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int validateResults(DataContainerArray::Pointer dca, float multiplesOfAverage)
+  {
+    DataContainer::Pointer m = dca->getDataContainer(FindNeighborhoodsTestConsts::k_DataContainerName);
+    AttributeMatrix::Pointer featureAttrMat = m->getAttributeMatrix(FindNeighborhoodsTestConsts::k_FeatureAttributeMatrixName);
+
+    FloatArrayType::Pointer diameters = featureAttrMat->getAttributeArrayAs<FloatArrayType>(FindNeighborhoodsTestConsts::k_EquivalentDiametersArrayName);
+    FloatArrayType::Pointer centroids = featureAttrMat->getAttributeArrayAs<FloatArrayType>(FindNeighborhoodsTestConsts::k_CentroidsArrayName);
+    Int32ArrayType::Pointer neighborhoods = featureAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::FeatureData::Neighborhoods);
+    NeighborList<int32_t>::Pointer neighborhoodList = featureAttrMat->getAttributeArrayAs<NeighborList<int32_t>>(SIMPL::FeatureData::NeighborhoodList);
+    DREAM3D_REQUIRE_VALID_POINTER(neighborhoods.get())
+    DREAM3D_REQUIRE_VALID_POINTER(neighborhoodList.get())
+
+    // Brute force reference: compare the centroid bins of every pair of features
+    size_t numFeatures = FindNeighborhoodsTestConsts::k_NumFeatures;
+    float aveDiam = 0.0f;
+    for(size_t i = 1; i < numFeatures; i++)
+    {
+      aveDiam += diameters->getValue(i);
+    }
+    aveDiam /= numFeatures;
+
+    float origin[3] = {0.0f, 0.0f, 0.0f};
+    m->getGeometryAs<ImageGeom>()->getOrigin(origin);
+    std::vector<int64_t> bins(3 * numFeatures, 0);
+    for(size_t i = 1; i < numFeatures; i++)
+    {
+      for(int32_t d = 0; d < 3; d++)
+      {
+        bins[3 * i + d] = int32_t((centroids->getComponent(i, d) - origin[d]) / aveDiam);
+      }
+    }
+
+    for(size_t i = 1; i < numFeatures; i++)
+    {
+      float criticalDistance = diameters->getValue(i) * multiplesOfAverage / aveDiam;
+      std::vector<int32_t> expected;
+      for(size_t j = 1; j < numFeatures; j++)
+      {
+        if(j == i)
+        {
+          continue;
+        }
+        float dBinX = llabs(bins[3 * j] - bins[3 * i]);
+        float dBinY = llabs(bins[3 * j + 1] - bins[3 * i + 1]);
+        float dBinZ = llabs(bins[3 * j + 2] - bins[3 * i + 2]);
+        if(dBinX < criticalDistance && dBinY < criticalDistance && dBinZ < criticalDistance)
+        {
+          expected.push_back(static_cast<int32_t>(j));
+        }
+      }
+
+      std::vector<int32_t>& neighbors = neighborhoodList->getListReference(static_cast<int32_t>(i));
+      DREAM3D_REQUIRE_EQUAL(neighborhoods->getValue(i), static_cast<int32_t>(expected.size()))
+      DREAM3D_REQUIRE_EQUAL(neighbors.size(), expected.size())
+      for(size_t n = 0; n < expected.size(); n++)
+      {
+        DREAM3D_REQUIRE_EQUAL(neighbors[n], expected[n])
+      }
+    }
+
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int RunTest()
+  {
+    float multiples[3] = {0.5f, 1.0f, 2.5f};
+    for(int32_t t = 0; t < 3; t++)
+    {
+      DataContainerArray::Pointer dca = initializeDataContainerArray();
+
+      QString filtName = "FindNeighborhoods";
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer factory = fm->getFactoryForFilter(filtName);
+      DREAM3D_REQUIRE(factory.get() != nullptr)
+
+      AbstractFilter::Pointer filter = factory->create();
+      DREAM3D_REQUIRE(filter.get() != nullptr)
+
+      filter->setDataContainerArray(dca);
+
+      QVariant var;
+      var.setValue(DataArrayPath(FindNeighborhoodsTestConsts::k_DataContainerName, FindNeighborhoodsTestConsts::k_FeatureAttributeMatrixName, FindNeighborhoodsTestConsts::k_EquivalentDiametersArrayName));
+      bool propWasSet = filter->setProperty("EquivalentDiametersArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+      var.setValue(DataArrayPath(FindNeighborhoodsTestConsts::k_DataContainerName, FindNeighborhoodsTestConsts::k_FeatureAttributeMatrixName, FindNeighborhoodsTestConsts::k_PhasesArrayName));
+      propWasSet = filter->setProperty("FeaturePhasesArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+      var.setValue(DataArrayPath(FindNeighborhoodsTestConsts::k_DataContainerName, FindNeighborhoodsTestConsts::k_FeatureAttributeMatrixName, FindNeighborhoodsTestConsts::k_CentroidsArrayName));
+      propWasSet = filter->setProperty("CentroidsArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+      var.setValue(multiples[t]);
+      propWasSet = filter->setProperty("MultiplesOfAverage", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+      filter->execute();
+      DREAM3D_REQUIRE(filter->getErrorCondition() >= 0);
+
+      int err = validateResults(dca, multiples[t]);
+      DREAM3D_REQUIRE(err >= 0);
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "#### FindNeighborhoodsTest Starting ####" << std::endl;
+
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(RunTest())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+private:
+  FindNeighborhoodsTest(const FindNeighborhoodsTest&); // Copy Constructor Not Implemented
+  void operator=(const FindNeighborhoodsTest&);        // Operator '=' Not Implemented
+};
@@ -0,0 +1,296 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include <map>
+
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "StatisticsTestFileLocations.h"
+
+namespace FindNeighborsTestConsts
+{
+const QString k_DataContainerName("TestDataContainer");
+const QString k_CellAttributeMatrixName("CellData");
+const QString k_FeatureAttributeMatrixName("FeatureData");
+const QString k_FeatureIdsArrayName("FeatureIds");
+const int32_t k_NumFeatures = 7;
+}
+
+class FindNeighborsTest
+{
+public:
+  FindNeighborsTest()
+  {
+  }
+  virtual ~FindNeighborsTest()
+  {
+  }
+  SIMPL_TYPE_MACRO(FindNeighborsTest)
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FindNeighbors Filter from the FilterManager
+    QString filtName = "FindNeighbors";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The FindNeighborsTest requires the use of the " << filtName.toStdString() << " filter which is found in the Statistics Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer initializeDataContainerArray(QVector<size_t> tDims)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+
+    DataContainer::Pointer m = DataContainer::New();
+    m->setName(FindNeighborsTestConsts::k_DataContainerName);
+    ImageGeom::Pointer geom = ImageGeom::CreateGeometry("ImageGeometry");
+    m->setGeometry(geom);
+    geom->setDimensions(tDims.data());
+    geom->setResolution(0.5f, 2.0f, 1.0f);
+    dca->addDataContainer(m);
+
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, FindNeighborsTestConsts::k_CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    m->addAttributeMatrix(FindNeighborsTestConsts::k_CellAttributeMatrixName, cellAttrMat);
+
+    QVector<size_t> featureDims(1, FindNeighborsTestConsts::k_NumFeatures);
+    AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(featureDims, FindNeighborsTestConsts::k_FeatureAttributeMatrixName, AttributeMatrix::Type::CellFeature);
+    m->addAttributeMatrix(FindNeighborsTestConsts::k_FeatureAttributeMatrixName, featureAttrMat);
+
+    QVector<size_t> cDims(1, 1);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(tDims, cDims, FindNeighborsTestConsts::k_FeatureIdsArrayName);
+    int err = cellAttrMat->addAttributeArray(FindNeighborsTestConsts::k_FeatureIdsArrayName, featureIds);
+    DREAM3D_REQUIRE(err >= 0);
+
+    // Blocky features with a scattering of unassigned (0) voxels so that runs, chunk boundaries and
+    // bad data all get exercised
+    size_t index = 0;
+    for(size_t z = 0; z < tDims[2]; z++)
+    {
+      for(size_t y = 0; y < tDims[1]; y++)
+      {
+        for(size_t x = 0; x < tDims[0]; x++)
+        {
+          int32_t feature = static_cast<int32_t>(1 + (x / 3) + 2 * (y / 3) + (z / 2) % 2);
+          if((index * 7) % 11 == 0)
+          {
+            feature = 0;
+          }
+          featureIds->setValue(index, feature);
+          index++;
+        }
+      }
+    }
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int validateResults(DataContainerArray::Pointer dca, QVector<size_t> tDims)
+  {
+    AttributeMatrix::Pointer cellAttrMat = dca->getAttributeMatrix(DataArrayPath(FindNeighborsTestConsts::k_DataContainerName, FindNeighborsTestConsts::k_CellAttributeMatrixName, ""));
+    AttributeMatrix::Pointer featureAttrMat = dca->getAttributeMatrix(DataArrayPath(FindNeighborsTestConsts::k_DataContainerName, FindNeighborsTestConsts::k_FeatureAttributeMatrixName, ""));
+
+    Int32ArrayType::Pointer featureIds = cellAttrMat->getAttributeArrayAs<Int32ArrayType>(FindNeighborsTestConsts::k_FeatureIdsArrayName);
+    Int8ArrayType::Pointer boundaryCells = cellAttrMat->getAttributeArrayAs<Int8ArrayType>(SIMPL::CellData::BoundaryCells);
+    BoolArrayType::Pointer surfaceFeatures = featureAttrMat->getAttributeArrayAs<BoolArrayType>(SIMPL::FeatureData::SurfaceFeatures);
+    Int32ArrayType::Pointer numNeighbors = featureAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::FeatureData::NumNeighbors);
+    NeighborList<int32_t>::Pointer neighborList = featureAttrMat->getAttributeArrayAs<NeighborList<int32_t>>(SIMPL::FeatureData::NeighborList);
+    NeighborList<float>::Pointer sharedSurfaceAreaList = featureAttrMat->getAttributeArrayAs<NeighborList<float>>(SIMPL::FeatureData::SharedSurfaceAreaList);
+    DREAM3D_REQUIRE_VALID_POINTER(boundaryCells.get())
+    DREAM3D_REQUIRE_VALID_POINTER(surfaceFeatures.get())
+    DREAM3D_REQUIRE_VALID_POINTER(numNeighbors.get())
+    DREAM3D_REQUIRE_VALID_POINTER(neighborList.get())
+    DREAM3D_REQUIRE_VALID_POINTER(sharedSurfaceAreaList.get())
+
+    // Brute force reference: visit all six faces of every voxel
+    int64_t dims[3] = {static_cast<int64_t>(tDims[0]), static_cast<int64_t>(tDims[1]), static_cast<int64_t>(tDims[2])};
+    std::vector<std::map<int32_t, int32_t>> faceCounts(FindNeighborsTestConsts::k_NumFeatures);
+    std::vector<bool> onSurface(FindNeighborsTestConsts::k_NumFeatures, false);
+    int64_t offsets[6][3] = {{0, 0, -1}, {0, -1, 0}, {-1, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    for(int64_t z = 0; z < dims[2]; z++)
+    {
+      for(int64_t y = 0; y < dims[1]; y++)
+      {
+        for(int64_t x = 0; x < dims[0]; x++)
+        {
+          int64_t index = (z * dims[1] + y) * dims[0] + x;
+          int32_t feature = featureIds->getValue(index);
+          int8_t count = 0;
+          if(feature > 0)
+          {
+            if(x == 0 || x == dims[0] - 1 || y == 0 || y == dims[1] - 1 || z == 0 || z == dims[2] - 1)
+            {
+              onSurface[feature] = true;
+            }
+            for(int32_t k = 0; k < 6; k++)
+            {
+              int64_t nx = x + offsets[k][0];
+              int64_t ny = y + offsets[k][1];
+              int64_t nz = z + offsets[k][2];
+              if(nx < 0 || ny < 0 || nz < 0 || nx >= dims[0] || ny >= dims[1] || nz >= dims[2])
+              {
+                continue;
+              }
+              int32_t neighbor = featureIds->getValue((nz * dims[1] + ny) * dims[0] + nx);
+              if(neighbor > 0 && neighbor != feature)
+              {
+                count++;
+                faceCounts[feature][neighbor]++;
+              }
+            }
+          }
+          DREAM3D_REQUIRE_EQUAL(boundaryCells->getValue(index), count)
+        }
+      }
+    }
+
+    for(int32_t i = 1; i < FindNeighborsTestConsts::k_NumFeatures; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(surfaceFeatures->getValue(i), onSurface[i])
+      DREAM3D_REQUIRE_EQUAL(numNeighbors->getValue(i), static_cast<int32_t>(faceCounts[i].size()))
+
+      std::vector<int32_t>& neighbors = neighborList->getListReference(i);
+      std::vector<float>& areas = sharedSurfaceAreaList->getListReference(i);
+      DREAM3D_REQUIRE_EQUAL(neighbors.size(), faceCounts[i].size())
+      DREAM3D_REQUIRE_EQUAL(areas.size(), faceCounts[i].size())
+
+      // The lists are sorted by neighbor Id
+      size_t n = 0;
+      for(std::map<int32_t, int32_t>::iterator iter = faceCounts[i].begin(); iter != faceCounts[i].end(); ++iter, ++n)
+      {
+        DREAM3D_REQUIRE_EQUAL(neighbors[n], iter->first)
+        float refArea = float(iter->second) * 0.5f * 2.0f;
+        DREAM3D_COMPARE_FLOATS(&areas[n], &refArea, 1)
+      }
+    }
+
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int RunTest()
+  {
+    QVector<size_t> tDims = {9, 8, 5};
+    DataContainerArray::Pointer dca = initializeDataContainerArray(tDims);
+
+    QString filtName = "FindNeighbors";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryForFilter(filtName);
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+
+    AbstractFilter::Pointer filter = factory->create();
+    DREAM3D_REQUIRE(filter.get() != nullptr)
+
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    var.setValue(DataArrayPath(FindNeighborsTestConsts::k_DataContainerName, FindNeighborsTestConsts::k_CellAttributeMatrixName, FindNeighborsTestConsts::k_FeatureIdsArrayName));
+    bool propWasSet = filter->setProperty("FeatureIdsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    var.setValue(DataArrayPath(FindNeighborsTestConsts::k_DataContainerName, FindNeighborsTestConsts::k_FeatureAttributeMatrixName, ""));
+    propWasSet = filter->setProperty("CellFeatureAttributeMatrixPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    var.setValue(true);
+    propWasSet = filter->setProperty("StoreBoundaryCells", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("StoreSurfaceFeatures", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    filter->execute();
+    DREAM3D_REQUIRE(filter->getErrorCondition() >= 0);
+
+    int err = validateResults(dca, tDims);
+    DREAM3D_REQUIRE(err >= 0);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "#### FindNeighborsTest Starting ####" << std::endl;
+
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(RunTest())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+private:
+  FindNeighborsTest(const FindNeighborsTest&); // Copy Constructor Not Implemented
+  void operator=(const FindNeighborsTest&);    // Operator '=' Not Implemented
+};
@@ -35,8 +35,17 @@
 
 #include "LaplacianSmoothing.h"
 
+#include <algorithm>
 #include <sstream>
 #include <stdio.h>
+#include <vector>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
 
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -53,6 +62,88 @@
 // Include the MOC generated file for this class
 #include "moc_LaplacianSmoothing.cpp"
 
+/**
+ * @brief The LaplacianSmoothingImpl class moves every vertex of a block towards the average of its neighbors. Each
+ * vertex only reads the input positions and writes its own output position, so the blocks are independent. The
+ * neighbors of a vertex are summed in the order of the unique edges, which gives the same result as scattering
+ * the edge differences into the vertices.
+ */
+class LaplacianSmoothingImpl
+{
+    const int64_t* m_Starts;
+    const int64_t* m_Neighbors;
+    const float* m_Lambda;
+    float m_Factor;
+    const float* const* m_Input;
+    float* const* m_Output;
+    const float* const* m_Reference;
+    int64_t m_NumVertices;
+    int64_t m_BlockSize;
+    float* m_BlockDisplacements;
+
+  public:
+    LaplacianSmoothingImpl(const int64_t* starts, const int64_t* neighbors, const float* lambda, float factor, const float* const* input, float* const* output, const float* const* reference,
+                           int64_t numVertices, int64_t blockSize, float* blockDisplacements)
+    : m_Starts(starts)
+    , m_Neighbors(neighbors)
+    , m_Lambda(lambda)
+    , m_Factor(factor)
+    , m_Input(input)
+    , m_Output(output)
+    , m_Reference(reference)
+    , m_NumVertices(numVertices)
+    , m_BlockSize(blockSize)
+    , m_BlockDisplacements(blockDisplacements)
+    {
+    }
+    virtual ~LaplacianSmoothingImpl()
+    {
+    }
+
+    void convert(size_t blockStart, size_t blockEnd) const
+    {
+      for(size_t b = blockStart; b < blockEnd; b++)
+      {
+        int64_t start = static_cast<int64_t>(b) * m_BlockSize;
+        int64_t end = std::min(m_NumVertices, start + m_BlockSize);
+        float maxDisplacement = 0.0f;
+        for(int64_t i = start; i < end; i++)
+        {
+          int64_t numConnections = m_Starts[i + 1] - m_Starts[i];
+          float ll = m_Lambda[i] * m_Factor;
+          float displacement = 0.0f;
+          for(int32_t j = 0; j < 3; j++)
+          {
+            const float* input = m_Input[j];
+            float value = input[i];
+            if(numConnections > 0)
+            {
+              double delta = 0.0;
+              for(int64_t n = m_Starts[i]; n < m_Starts[i + 1]; n++)
+              {
+                delta += input[m_Neighbors[n]] - input[i];
+              }
+              value += ll * (delta / numConnections);
+            }
+            // The reference may be the output buffer itself, so read it before writing the new position
+            float diff = value - m_Reference[j][i];
+            displacement += diff * diff;
+            m_Output[j][i] = value;
+          }
+          maxDisplacement = std::max(maxDisplacement, displacement);
+        }
+        m_BlockDisplacements[b] = maxDisplacement;
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -62,6 +153,7 @@ LaplacianSmoothing::LaplacianSmoothing()
 , m_SurfaceMeshNodeTypeArrayPath(SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::VertexAttributeMatrixName, SIMPL::VertexData::SurfaceMeshNodeType)
 , m_SurfaceMeshFaceLabelsArrayPath(SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceLabels)
 , m_IterationSteps(1)
+, m_ConvergenceTolerance(0.0f)
 , m_Lambda(0.1f)
 , m_SurfacePointLambda(0.0f)
 , m_TripleLineLambda(0.0f)
@@ -91,6 +183,7 @@ void LaplacianSmoothing::setupFilterParameters()
   FilterParameterVector parameters;
 
   parameters.push_back(SIMPL_NEW_INTEGER_FP("Iteration Steps", IterationSteps, FilterParameter::Parameter, LaplacianSmoothing));
+  parameters.push_back(SIMPL_NEW_DOUBLE_FP("Convergence Tolerance", ConvergenceTolerance, FilterParameter::Parameter, LaplacianSmoothing));
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("Default Lambda", Lambda, FilterParameter::Parameter, LaplacianSmoothing));
 
   QStringList linkedProps;
@@ -124,6 +217,7 @@ void LaplacianSmoothing::readFilterParameters(AbstractFilterParametersReader* re
 {
   reader->openFilterGroup(this, index);
   setIterationSteps(reader->readValue("IterationSteps", getIterationSteps()));
+  setConvergenceTolerance(reader->readValue("ConvergenceTolerance", getConvergenceTolerance()));
   setLambda(reader->readValue("Lambda", getLambda()));
   setTripleLineLambda(reader->readValue("TripleLineLambda", getTripleLineLambda()));
   setQuadPointLambda(reader->readValue("QuadPointLambda", getQuadPointLambda()));
@@ -278,8 +372,13 @@ int32_t LaplacianSmoothing::edgeBasedSmoothing()
   int32_t err = 0;
   DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceDataContainerName());
   IGeometry2D::Pointer surfaceMesh = sm->getGeometryAs<IGeometry2D>();
-  float* verts = surfaceMesh->getVertexPointer(0);
   int64_t nvert = surfaceMesh->getNumberOfVertices();
+  if(nvert == 0)
+  {
+    // Nothing to smooth, and there are no blocks to look for a largest displacement in
+    return err;
+  }
+  float* verts = surfaceMesh->getVertexPointer(0);
 
   // Generate the Lambda Array
   err = generateLambdaArray();
@@ -309,16 +408,59 @@ int32_t LaplacianSmoothing::edgeBasedSmoothing()
   int64_t* uedges = surfaceMesh->getEdgePointer(0);
   int64_t nedges = surfaceMesh->getNumberOfEdges();
 
-  DataArray<int32_t>::Pointer numConnections = DataArray<int32_t>::CreateArray(nvert, "_INTERNAL_USE_ONLY_Laplacian_Smoothing_NumberConnections_Array");
-  numConnections->initializeWithZeros();
-  int32_t* ncon = numConnections->getPointer(0);
+  // The connectivity does not change while smoothing, so gather the neighbors of every vertex once. The neighbors
+  // are stored in the order of the unique edges.
+  std::vector<int64_t> starts(nvert + 1, 0);
+  for(int64_t i = 0; i < nedges; i++)
+  {
+    starts[uedges[2 * i] + 1]++;
+    starts[uedges[2 * i + 1] + 1]++;
+  }
+  for(int64_t i = 0; i < nvert; i++)
+  {
+    starts[i + 1] += starts[i];
+  }
+  std::vector<int64_t> neighbors(starts[nvert]);
+  {
+    std::vector<int64_t> cursor(starts.begin(), starts.end() - 1);
+    for(int64_t i = 0; i < nedges; i++)
+    {
+      int64_t in1 = uedges[2 * i];     // row of the first vertex
+      int64_t in2 = uedges[2 * i + 1]; // row the second vertex
+      neighbors[cursor[in1]++] = in2;
+      neighbors[cursor[in2]++] = in1;
+    }
+  }
 
-  QVector<size_t> cDims(1, 3);
-  DataArray<double>::Pointer deltaArray = DataArray<double>::CreateArray(nvert, cDims, "_INTERNAL_USE_ONLY_Laplacian_Smoothing_Delta_Array");
-  deltaArray->initializeWithZeros();
-  double* delta = deltaArray->getPointer(0);
+  // Keep two copies of the coordinates, one array per axis, and move the vertices from one copy into the other
+  std::vector<float> buffers[2][3];
+  for(int32_t c = 0; c < 2; c++)
+  {
+    for(int32_t j = 0; j < 3; j++)
+    {
+      buffers[c][j].resize(nvert);
+    }
+  }
+  for(int64_t i = 0; i < nvert; i++)
+  {
+    for(int32_t j = 0; j < 3; j++)
+    {
+      buffers[0][j][i] = verts[3 * i + j];
+    }
+  }
+  float* positions[2][3] = {{buffers[0][0].data(), buffers[0][1].data(), buffers[0][2].data()}, {buffers[1][0].data(), buffers[1][1].data(), buffers[1][2].data()}};
+
+  const int64_t k_BlockSize = 16384;
+  size_t numBlocks = static_cast<size_t>((nvert + k_BlockSize - 1) / k_BlockSize);
+  std::vector<float> blockDisplacements(numBlocks, 0.0f);
+  float tolerance = m_ConvergenceTolerance * m_ConvergenceTolerance;
 
-  double dlta = 0.0;
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  int32_t current = 0;
   for(int32_t q = 0; q < m_IterationSteps; q++)
   {
     if(getCancel() == true)
@@ -327,85 +469,44 @@ int32_t LaplacianSmoothing::edgeBasedSmoothing()
     }
     QString ss = QObject::tr("Iteration %1 of %2").arg(q).arg(m_IterationSteps);
     notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-    // Compute the Deltas for each point
-    for(int64_t i = 0; i < nedges; i++)
-    {
-      int64_t in1 = uedges[2 * i];     // row of the first vertex
-      int64_t in2 = uedges[2 * i + 1]; // row the second vertex
 
-      for(int32_t j = 0; j < 3; j++)
+    // Move each point, then optionally apply a negative lambda based on the mu Factor value.
+    // This is from Taubin's paper on smoothing without shrinkage. This effectively
+    // runs a low pass filter on the data. The Taubin step moves the points back into the
+    // copy that the iteration started from, which is read just before it is written.
+    int32_t numSteps = m_UseTaubinSmoothing ? 2 : 1;
+    const float* const* reference = positions[current];
+    for(int32_t step = 0; step < numSteps; step++)
+    {
+      float factor = (step == 0) ? 1.0f : m_MuFactor;
+      LaplacianSmoothingImpl impl(starts.data(), neighbors.data(), lambda, factor, positions[current], positions[1 - current], reference, nvert, k_BlockSize, blockDisplacements.data());
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      if(doParallel == true)
       {
-        Q_ASSERT(static_cast<size_t>(3 * in1 + j) < static_cast<size_t>(nvert * 3));
-        Q_ASSERT(static_cast<size_t>(3 * in2 + j) < static_cast<size_t>(nvert * 3));
-        dlta = verts[3 * in2 + j] - verts[3 * in1 + j];
-        delta[3 * in1 + j] += dlta;
-        delta[3 * in2 + j] += -1.0 * dlta;
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks), impl, tbb::auto_partitioner());
       }
-      ncon[in1] += 1;
-      ncon[in2] += 1;
-    }
-
-    // Move each point
-    float ll = 0.0f;
-    for(int64_t i = 0; i < nvert; i++)
-    {
-      for(int32_t j = 0; j < 3; j++)
+      else
+#endif
       {
-        int64_t in0 = 3 * i + j;
-        dlta = delta[in0] / ncon[i];
-
-        ll = lambda[i];
-        verts[3 * i + j] += ll * dlta;
-        delta[in0] = 0.0; // reset for next iteration
+        impl.convert(0, numBlocks);
       }
-      ncon[i] = 0; // reset for next iteration
+      current = 1 - current;
     }
 
-    // Now optionally apply a negative lambda based on the mu Factor value.
-    // This is from Taubin's paper on smoothing without shrinkage. This effectively
-    // runs a low pass filter on the data
-    if(m_UseTaubinSmoothing)
+    // Stop early once no vertex moved further than the tolerance during this iteration
+    if(m_ConvergenceTolerance > 0.0f && *std::max_element(blockDisplacements.begin(), blockDisplacements.end()) <= tolerance)
     {
-
-      if(getCancel() == true)
-      {
-        return -1;
-      }
-      QString ss = QObject::tr("Iteration %1 of %2").arg(q).arg(m_IterationSteps);
+      ss = QObject::tr("Converged after %1 of %2 Iterations").arg(q + 1).arg(m_IterationSteps);
       notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-      // Compute the Delta's
-      for(int64_t i = 0; i < nedges; i++)
-      {
-        int64_t in1 = uedges[2 * i];     // row of the first vertex
-        int64_t in2 = uedges[2 * i + 1]; // row the second vertex
-
-        for(int32_t j = 0; j < 3; j++)
-        {
-          Q_ASSERT(static_cast<size_t>(3 * in1 + j) < static_cast<size_t>(nvert * 3));
-          Q_ASSERT(static_cast<size_t>(3 * in2 + j) < static_cast<size_t>(nvert * 3));
-          dlta = verts[3 * in2 + j] - verts[3 * in1 + j];
-          delta[3 * in1 + j] += dlta;
-          delta[3 * in2 + j] += -1.0 * dlta;
-        }
-        ncon[in1] += 1;
-        ncon[in2] += 1;
-      }
-
-      // MOve the points
-      float ll = 0.0f;
-      for(int64_t i = 0; i < nvert; i++)
-      {
-        for(int32_t j = 0; j < 3; j++)
-        {
-          int64_t in0 = 3 * i + j;
-          dlta = delta[in0] / ncon[i];
+      break;
+    }
+  }
 
-          ll = lambda[i] * m_MuFactor;
-          verts[3 * i + j] += ll * dlta;
-          delta[in0] = 0.0; // reset for next iteration
-        }
-        ncon[i] = 0; // reset for next iteration
-      }
+  for(int64_t i = 0; i < nvert; i++)
+  {
+    for(int32_t j = 0; j < 3; j++)
+    {
+      verts[3 * i + j] = positions[current][j][i];
     }
   }
 
@@ -70,6 +70,9 @@ class LaplacianSmoothing : public SurfaceMeshFilter
     SIMPL_FILTER_PARAMETER(int, IterationSteps)
     Q_PROPERTY(int IterationSteps READ getIterationSteps WRITE setIterationSteps)
 
+    SIMPL_FILTER_PARAMETER(float, ConvergenceTolerance)
+    Q_PROPERTY(float ConvergenceTolerance READ getConvergenceTolerance WRITE setConvergenceTolerance)
+
     SIMPL_FILTER_PARAMETER(float, Lambda)
     Q_PROPERTY(float Lambda READ getLambda WRITE setLambda)
 
@@ -182,7 +185,8 @@ class LaplacianSmoothing : public SurfaceMeshFilter
     virtual int32_t generateLambdaArray();
 
     /**
-     * @brief edgeBasedSmoothing Version of the smoothing algorithm uses Edge->Vertex connectivity information for its algorithm
+     * @brief edgeBasedSmoothing Version of the smoothing algorithm uses Edge->Vertex connectivity information for its algorithm.
+     * The neighbors of each vertex are gathered once from the unique edges and every iteration then moves the vertices in parallel
      * @return Integer error code
      */
     virtual int32_t edgeBasedSmoothing();
@@ -35,14 +35,30 @@
 
 #include "QuickSurfaceMesh.h"
 
+#include <algorithm>
+#include <memory>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/ScopedFileMonitor.hpp"
 #include "SIMPLib/Common/TemplateHelpers.hpp"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/MultiDataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/OutputFileFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
+#include "SIMPLib/Geometry/MeshStructs.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
@@ -63,6 +79,9 @@ QuickSurfaceMesh::QuickSurfaceMesh()
 , m_FaceLabelsArrayName(SIMPL::FaceData::SurfaceMeshFaceLabels)
 , m_NodeTypesArrayName(SIMPL::VertexData::SurfaceMeshNodeType)
 , m_FeatureAttributeMatrixName(SIMPL::Defaults::FaceFeatureAttributeMatrixName)
+, m_StreamMeshToFiles(false)
+, m_NodesFile("")
+, m_TrianglesFile("")
 , m_FeatureIds(nullptr)
 , m_FaceLabels(nullptr)
 , m_NodeTypes(nullptr)
@@ -107,6 +126,14 @@ void QuickSurfaceMesh::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_STRING_FP("Face Labels", FaceLabelsArrayName, FilterParameter::CreatedArray, QuickSurfaceMesh));
   parameters.push_back(SeparatorFilterParameter::New("Face Feature Data", FilterParameter::CreatedArray));
   parameters.push_back(SIMPL_NEW_STRING_FP("Face Feature Attribute Matrix", FeatureAttributeMatrixName, FilterParameter::CreatedArray, QuickSurfaceMesh));
+  {
+    QStringList linkedProps;
+    linkedProps << "NodesFile"
+                << "TrianglesFile";
+    parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Stream Mesh to Binary Files", StreamMeshToFiles, FilterParameter::Parameter, QuickSurfaceMesh, linkedProps));
+  }
+  parameters.push_back(SIMPL_NEW_OUTPUT_FILE_FP("Nodes File", NodesFile, FilterParameter::Parameter, QuickSurfaceMesh, "*.bin", "Binary Nodes File"));
+  parameters.push_back(SIMPL_NEW_OUTPUT_FILE_FP("Triangles File", TrianglesFile, FilterParameter::Parameter, QuickSurfaceMesh, "*.bin", "Binary Triangles File"));
   setFilterParameters(parameters);
 }
 
@@ -124,6 +151,9 @@ void QuickSurfaceMesh::readFilterParameters(AbstractFilterParametersReader* read
   setFaceLabelsArrayName(reader->readString("FaceLabelsArrayName", getFaceLabelsArrayName()));
   setFeatureIdsArrayPath(reader->readDataArrayPath("FeatureIdsArrayPath", getFeatureIdsArrayPath()));
   setFeatureAttributeMatrixName(reader->readString("FeatureAttributeMatrixName", getFeatureAttributeMatrixName()));
+  setStreamMeshToFiles(reader->readValue("StreamMeshToFiles", getStreamMeshToFiles()));
+  setNodesFile(reader->readString("NodesFile", getNodesFile()));
+  setTrianglesFile(reader->readString("TrianglesFile", getTrianglesFile()));
   reader->closeFilterGroup();
 }
 
@@ -154,26 +184,614 @@ void QuickSurfaceMesh::updateFaceInstancePointers()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-template <typename T>
-void copyCellArraysToFaceArrays(size_t faceIndex, size_t firstCellIndex, size_t secondCellIndex, IDataArray::Pointer cellArray, IDataArray::Pointer faceArray, bool forceSecondToZero = false)
+namespace QuickSurfaceMeshDetail
 {
-  typename DataArray<T>::Pointer cellPtr = std::dynamic_pointer_cast<DataArray<T>>(cellArray);
-  typename DataArray<T>::Pointer facePtr = std::dynamic_pointer_cast<DataArray<T>>(faceArray);
-
-  int32_t numComps = cellPtr->getNumberOfComponents();
-  QVector<size_t> cDims = facePtr->getComponentDimensions();
-
-  T* faceTuplePtr = facePtr->getTuplePointer(faceIndex);
-  T* firstCellTuplePtr = cellPtr->getTuplePointer(firstCellIndex);
-  T* secondCellTuplePtr = cellPtr->getTuplePointer(secondCellIndex);
+/**
+ * @brief The kinds of Cell faces that are meshed, listed in the order in which they are visited for each Cell
+ */
+enum FaceKind
+{
+  MinXFace = 0,
+  MinYFace,
+  MinZFace,
+  MaxXFace,
+  InteriorXFace,
+  MaxYFace,
+  InteriorYFace,
+  MaxZFace,
+  InteriorZFace
+};
+
+/**
+ * @brief The (x, y, z) offsets from the Cell of the 4 nodes of each face kind, in the order the nodes are numbered
+ */
+static const int8_t NodeOffsets[9][4][3] = {
+    {{0, 0, 0}, {0, 1, 0}, {0, 0, 1}, {0, 1, 1}}, {{0, 0, 0}, {1, 0, 0}, {0, 0, 1}, {1, 0, 1}}, {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0}},
+    {{1, 0, 0}, {1, 1, 0}, {1, 0, 1}, {1, 1, 1}}, {{1, 0, 0}, {1, 1, 0}, {1, 0, 1}, {1, 1, 1}}, {{1, 1, 0}, {0, 1, 0}, {1, 1, 1}, {0, 1, 1}},
+    {{1, 1, 0}, {0, 1, 0}, {1, 1, 1}, {0, 1, 1}}, {{1, 0, 1}, {0, 0, 1}, {1, 1, 1}, {0, 1, 1}}, {{1, 0, 1}, {0, 0, 1}, {1, 1, 1}, {0, 1, 1}}};
+
+/**
+ * @brief The face nodes that make up the 2 Triangles of each face kind
+ */
+static const int8_t Winding[9][6] = {{0, 1, 2, 1, 3, 2}, {0, 2, 1, 1, 2, 3}, {0, 1, 2, 1, 3, 2}, {2, 1, 0, 2, 3, 1}, {0, 1, 2, 1, 3, 2},
+                                     {2, 1, 0, 2, 3, 1}, {0, 1, 2, 1, 3, 2}, {1, 2, 0, 3, 2, 1}, {0, 2, 1, 1, 2, 3}};
+
+/**
+ * @brief The Face struct is one square face of a Cell that is meshed with 2 Triangles
+ */
+struct Face
+{
+  int32_t kind;
+  int32_t labels[2];
+  int64_t cells[2];
+  bool boundary;
+};
+
+/**
+ * @brief getCellFaces Finds the faces of Cell (i, j, k) that are meshed: the faces on the outside of the
+ * volume and the +X, +Y and +Z faces that separate two different Features
+ * @return The number of faces written into faces
+ */
+int32_t getCellFaces(const int32_t* featureIds, const int64_t dims[3], int64_t i, int64_t j, int64_t k, Face faces[6])
+{
+  int64_t point = (k * dims[0] * dims[1]) + (j * dims[0]) + i;
+  int64_t neighbors[3] = {point + 1, point + dims[0], point + (dims[0] * dims[1])};
+  int64_t index[3] = {i, j, k};
+  int32_t count = 0;
 
-  ::memcpy(faceTuplePtr, firstCellTuplePtr, sizeof(T) * numComps);
-  if(!forceSecondToZero)
+  for(int32_t axis = 0; axis < 3; axis++)
+  {
+    if(index[axis] == 0)
+    {
+      Face& face = faces[count++];
+      face.kind = MinXFace + axis;
+      face.labels[0] = featureIds[point];
+      face.labels[1] = -1;
+      face.cells[0] = point;
+      face.cells[1] = point;
+      face.boundary = true;
+    }
+  }
+  for(int32_t axis = 0; axis < 3; axis++)
   {
-    ::memcpy(faceTuplePtr + numComps, secondCellTuplePtr, sizeof(T) * numComps);
+    if(index[axis] == dims[axis] - 1)
+    {
+      Face& face = faces[count++];
+      face.kind = MaxXFace + 2 * axis;
+      face.labels[0] = featureIds[point];
+      face.labels[1] = -1;
+      face.cells[0] = point;
+      face.cells[1] = point;
+      face.boundary = true;
+    }
+    else if(featureIds[point] != featureIds[neighbors[axis]])
+    {
+      Face& face = faces[count++];
+      face.kind = InteriorXFace + 2 * axis;
+      face.labels[0] = featureIds[neighbors[axis]];
+      face.labels[1] = featureIds[point];
+      face.cells[0] = neighbors[axis];
+      face.cells[1] = point;
+      face.boundary = false;
+    }
   }
+  return count;
+}
+
+/**
+ * @brief The NodeOwners class collects the Feature Ids on either side of the faces that share a node.
+ * The node type is the number of distinct Feature Ids, capped at 4, plus 10 if the node is on the
+ * outside of the volume. Only the first 4 Feature Ids are needed for that, so no set is kept.
+ */
+class NodeOwners
+{
+  public:
+    NodeOwners()
+    : m_Count(0)
+    , m_Boundary(false)
+    {
+    }
+
+    void clear()
+    {
+      m_Count = 0;
+      m_Boundary = false;
+    }
+
+    void insert(int32_t featureId)
+    {
+      if(featureId == -1)
+      {
+        m_Boundary = true;
+        return;
+      }
+      for(int32_t i = 0; i < m_Count; i++)
+      {
+        if(m_Features[i] == featureId)
+        {
+          return;
+        }
+      }
+      if(m_Count < 4)
+      {
+        m_Features[m_Count++] = featureId;
+      }
+    }
+
+    int8_t getNodeType() const
+    {
+      int8_t nodeType = m_Count + (m_Boundary ? 1 : 0);
+      if(nodeType > 4)
+      {
+        nodeType = 4;
+      }
+      if(m_Boundary)
+      {
+        nodeType += 10;
+      }
+      return nodeType;
+    }
+
+  private:
+    int32_t m_Features[4];
+    int8_t m_Count;
+    bool m_Boundary;
+};
+
+/**
+ * @brief The FaceArrayCopier class copies the values of the two Cells on either side of a face into a
+ * transferred Face array. The type dispatch is done once per array instead of once per Triangle.
+ */
+class FaceArrayCopier
+{
+  public:
+    virtual ~FaceArrayCopier()
+    {
+    }
+    virtual void copy(size_t faceIndex, size_t firstCellIndex, size_t secondCellIndex, bool forceSecondToZero) const = 0;
+};
+
+template <typename T> class FaceArrayCopierImpl : public FaceArrayCopier
+{
+  public:
+    FaceArrayCopierImpl(IDataArray::Pointer cellArray, IDataArray::Pointer faceArray)
+    : m_CellPtr(std::dynamic_pointer_cast<DataArray<T>>(cellArray))
+    , m_FacePtr(std::dynamic_pointer_cast<DataArray<T>>(faceArray))
+    {
+    }
+    virtual ~FaceArrayCopierImpl()
+    {
+    }
+
+    virtual void copy(size_t faceIndex, size_t firstCellIndex, size_t secondCellIndex, bool forceSecondToZero) const
+    {
+      int32_t numComps = m_CellPtr->getNumberOfComponents();
+
+      T* faceTuplePtr = m_FacePtr->getTuplePointer(faceIndex);
+      T* firstCellTuplePtr = m_CellPtr->getTuplePointer(firstCellIndex);
+      T* secondCellTuplePtr = m_CellPtr->getTuplePointer(secondCellIndex);
+
+      ::memcpy(faceTuplePtr, firstCellTuplePtr, sizeof(T) * numComps);
+      if(!forceSecondToZero)
+      {
+        ::memcpy(faceTuplePtr + numComps, secondCellTuplePtr, sizeof(T) * numComps);
+      }
+    }
+
+  private:
+    typename DataArray<T>::Pointer m_CellPtr;
+    typename DataArray<T>::Pointer m_FacePtr;
+};
+
+typedef std::vector<std::shared_ptr<FaceArrayCopier>> FaceArrayCopiers;
+
+/**
+ * @brief The SlabBuffer struct holds the nodes and Triangles of one slab while the mesh is streamed to disk
+ */
+struct SlabBuffer
+{
+  std::vector<float> vertices;
+  std::vector<int8_t> nodeTypes;
+  std::vector<int64_t> triangles;
+  std::vector<int32_t> faceLabels;
+};
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename T>
+void createFaceArrayCopier(IDataArray::Pointer cellArray, IDataArray::Pointer faceArray, QuickSurfaceMeshDetail::FaceArrayCopiers& copiers)
+{
+  copiers.push_back(std::shared_ptr<QuickSurfaceMeshDetail::FaceArrayCopier>(new QuickSurfaceMeshDetail::FaceArrayCopierImpl<T>(cellArray, faceArray)));
+}
+
+/**
+ * @brief The QuickSurfaceMeshCountImpl class counts, for each Z layer of Cells, the nodes that are first used by
+ * the faces of that layer and the Triangles that the layer creates. A node on the bottom plane of a layer is
+ * first used by the layer below if any face of that layer touches it, so only the layer below the range is
+ * looked at again and every range can be counted independently.
+ */
+class QuickSurfaceMeshCountImpl
+{
+    const int32_t* m_FeatureIds;
+    int64_t m_Dims[3];
+    int64_t* m_NodeCounts;
+    int64_t* m_TriangleCounts;
+
+  public:
+    QuickSurfaceMeshCountImpl(const int32_t* featureIds, const int64_t dims[3], int64_t* nodeCounts, int64_t* triangleCounts)
+    : m_FeatureIds(featureIds)
+    , m_NodeCounts(nodeCounts)
+    , m_TriangleCounts(triangleCounts)
+    {
+      m_Dims[0] = dims[0];
+      m_Dims[1] = dims[1];
+      m_Dims[2] = dims[2];
+    }
+    virtual ~QuickSurfaceMeshCountImpl()
+    {
+    }
+
+    void convert(size_t zStart, size_t zEnd) const
+    {
+      int64_t xP = m_Dims[0];
+      int64_t yP = m_Dims[1];
+      int64_t planeSize = (xP + 1) * (yP + 1);
+      std::vector<uint8_t> lower(planeSize, 0);
+      std::vector<uint8_t> upper(planeSize, 0);
+      QuickSurfaceMeshDetail::Face faces[6];
+
+      if(zStart > 0)
+      {
+        int64_t k = static_cast<int64_t>(zStart) - 1;
+        for(int64_t j = 0; j < yP; j++)
+        {
+          for(int64_t i = 0; i < xP; i++)
+          {
+            int32_t numFaces = QuickSurfaceMeshDetail::getCellFaces(m_FeatureIds, m_Dims, i, j, k, faces);
+            for(int32_t f = 0; f < numFaces; f++)
+            {
+              for(int32_t n = 0; n < 4; n++)
+              {
+                const int8_t* offset = QuickSurfaceMeshDetail::NodeOffsets[faces[f].kind][n];
+                if(offset[2] == 1)
+                {
+                  lower[(j + offset[1]) * (xP + 1) + (i + offset[0])] = 1;
+                }
+              }
+            }
+          }
+        }
+      }
+
+      for(int64_t k = zStart; k < static_cast<int64_t>(zEnd); k++)
+      {
+        std::fill(upper.begin(), upper.end(), 0);
+        int64_t nodeCount = 0;
+        int64_t triangleCount = 0;
+        for(int64_t j = 0; j < yP; j++)
+        {
+          for(int64_t i = 0; i < xP; i++)
+          {
+            int32_t numFaces = QuickSurfaceMeshDetail::getCellFaces(m_FeatureIds, m_Dims, i, j, k, faces);
+            for(int32_t f = 0; f < numFaces; f++)
+            {
+              for(int32_t n = 0; n < 4; n++)
+              {
+                const int8_t* offset = QuickSurfaceMeshDetail::NodeOffsets[faces[f].kind][n];
+                uint8_t& seen = (offset[2] == 1 ? upper : lower)[(j + offset[1]) * (xP + 1) + (i + offset[0])];
+                if(seen == 0)
+                {
+                  seen = 1;
+                  nodeCount++;
+                }
+              }
+            }
+            triangleCount += 2 * numFaces;
+          }
+        }
+        m_NodeCounts[k] = nodeCount;
+        m_TriangleCounts[k] = triangleCount;
+        lower.swap(upper);
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+};
+
+/**
+ * @brief The QuickSurfaceMeshLayersImpl class meshes a range of Z layers of Cells. Nodes and Triangles are
+ * numbered in the same order as a serial sweep over the whole volume: the first node and Triangle Ids of each
+ * layer come from the counting pass. The nodes on the bottom plane of the range that the layer below already
+ * numbered (the seam nodes) get their Ids by replaying the numbering of that layer. Each range writes the
+ * coordinates and types of the nodes that it numbers itself. For the nodes on its top plane it therefore also
+ * visits the layer above the range to collect their remaining owners. The node lookup tables only span the
+ * two node planes of the current layer.
+ */
+class QuickSurfaceMeshLayersImpl
+{
+    const int32_t* m_FeatureIds;
+    int64_t m_Dims[3];
+    IGeometryGrid* m_Grid;
+    const int64_t* m_NodeStarts;
+    const int64_t* m_TriangleStarts;
+    int64_t m_NodeOffset;
+    int64_t m_TriangleOffset;
+    float* m_Vertices;
+    int8_t* m_NodeTypes;
+    int64_t* m_Triangles;
+    int32_t* m_FaceLabels;
+    const QuickSurfaceMeshDetail::FaceArrayCopiers* m_Copiers;
+
+  public:
+    QuickSurfaceMeshLayersImpl(const int32_t* featureIds, const int64_t dims[3], IGeometryGrid* grid, const int64_t* nodeStarts, const int64_t* triangleStarts, int64_t nodeOffset,
+                               int64_t triangleOffset, float* vertices, int8_t* nodeTypes, int64_t* triangles, int32_t* faceLabels, const QuickSurfaceMeshDetail::FaceArrayCopiers* copiers)
+    : m_FeatureIds(featureIds)
+    , m_Grid(grid)
+    , m_NodeStarts(nodeStarts)
+    , m_TriangleStarts(triangleStarts)
+    , m_NodeOffset(nodeOffset)
+    , m_TriangleOffset(triangleOffset)
+    , m_Vertices(vertices)
+    , m_NodeTypes(nodeTypes)
+    , m_Triangles(triangles)
+    , m_FaceLabels(faceLabels)
+    , m_Copiers(copiers)
+    {
+      m_Dims[0] = dims[0];
+      m_Dims[1] = dims[1];
+      m_Dims[2] = dims[2];
+    }
+    virtual ~QuickSurfaceMeshLayersImpl()
+    {
+    }
+
+    /**
+     * @brief numberLayer Numbers the unnumbered nodes of the faces of layer k, starting at nodeId
+     */
+    void numberLayer(int64_t k, std::vector<int64_t>& lowerIds, std::vector<int64_t>& upperIds, int64_t nodeId) const
+    {
+      int64_t xP = m_Dims[0];
+      int64_t yP = m_Dims[1];
+      QuickSurfaceMeshDetail::Face faces[6];
+      for(int64_t j = 0; j < yP; j++)
+      {
+        for(int64_t i = 0; i < xP; i++)
+        {
+          int32_t numFaces = QuickSurfaceMeshDetail::getCellFaces(m_FeatureIds, m_Dims, i, j, k, faces);
+          for(int32_t f = 0; f < numFaces; f++)
+          {
+            for(int32_t n = 0; n < 4; n++)
+            {
+              const int8_t* offset = QuickSurfaceMeshDetail::NodeOffsets[faces[f].kind][n];
+              int64_t& id = (offset[2] == 1 ? upperIds : lowerIds)[(j + offset[1]) * (xP + 1) + (i + offset[0])];
+              if(id == -1)
+              {
+                id = nodeId++;
+              }
+            }
+          }
+        }
+      }
+    }
+
+    /**
+     * @brief finishPlane Writes the coordinates and types of the nodes on plane z that were numbered by this range
+     */
+    void finishPlane(int64_t z, const std::vector<int64_t>& ids, const std::vector<QuickSurfaceMeshDetail::NodeOwners>& owners, int64_t firstNode, int64_t endNode) const
+    {
+      float coords[3] = {0.0f, 0.0f, 0.0f};
+      for(int64_t y = 0; y <= m_Dims[1]; y++)
+      {
+        for(int64_t x = 0; x <= m_Dims[0]; x++)
+        {
+          int64_t p = y * (m_Dims[0] + 1) + x;
+          int64_t id = ids[p];
+          if(id < firstNode || id >= endNode)
+          {
+            continue;
+          }
+          m_Grid->getPlaneCoords(x, y, z, coords);
+          float* vertex = m_Vertices + (id - m_NodeOffset) * 3;
+          vertex[0] = coords[0];
+          vertex[1] = coords[1];
+          vertex[2] = coords[2];
+          m_NodeTypes[id - m_NodeOffset] = owners[p].getNodeType();
+        }
+      }
+    }
+
+    void convert(size_t zStart, size_t zEnd) const
+    {
+      int64_t xP = m_Dims[0];
+      int64_t yP = m_Dims[1];
+      int64_t zP = m_Dims[2];
+      int64_t planeSize = (xP + 1) * (yP + 1);
+      std::vector<int64_t> lowerIds(planeSize, -1);
+      std::vector<int64_t> upperIds(planeSize, -1);
+      std::vector<QuickSurfaceMeshDetail::NodeOwners> lowerOwners(planeSize);
+      std::vector<QuickSurfaceMeshDetail::NodeOwners> upperOwners(planeSize);
+      QuickSurfaceMeshDetail::Face faces[6];
+
+      int64_t firstNode = m_NodeStarts[zStart];
+      int64_t endNode = m_NodeStarts[zEnd];
+
+      if(zStart > 0)
+      {
+        // Replay the layer below this range to get the Ids of the seam nodes. The nodes on its own bottom plane
+        // that the layer below it used are only marked as numbered.
+        int64_t below = static_cast<int64_t>(zStart) - 1;
+        if(below > 0)
+        {
+          std::vector<int64_t> marks(planeSize, -1);
+          numberLayer(below - 1, marks, lowerIds, 0);
+        }
+        numberLayer(below, lowerIds, upperIds, m_NodeStarts[below]);
+        lowerIds.swap(upperIds);
+        std::fill(upperIds.begin(), upperIds.end(), -1);
+      }
+
+      for(int64_t k = zStart; k < static_cast<int64_t>(zEnd); k++)
+      {
+        int64_t nodeId = m_NodeStarts[k];
+        int64_t triangleId = m_TriangleStarts[k];
+        for(int64_t j = 0; j < yP; j++)
+        {
+          for(int64_t i = 0; i < xP; i++)
+          {
+            int32_t numFaces = QuickSurfaceMeshDetail::getCellFaces(m_FeatureIds, m_Dims, i, j, k, faces);
+            for(int32_t f = 0; f < numFaces; f++)
+            {
+              const QuickSurfaceMeshDetail::Face& face = faces[f];
+              int64_t faceNodes[4] = {0, 0, 0, 0};
+              for(int32_t n = 0; n < 4; n++)
+              {
+                const int8_t* offset = QuickSurfaceMeshDetail::NodeOffsets[face.kind][n];
+                int64_t p = (j + offset[1]) * (xP + 1) + (i + offset[0]);
+                int64_t& id = (offset[2] == 1 ? upperIds : lowerIds)[p];
+                if(id == -1)
+                {
+                  id = nodeId++;
+                }
+                faceNodes[n] = id;
+                QuickSurfaceMeshDetail::NodeOwners& owners = (offset[2] == 1 ? upperOwners : lowerOwners)[p];
+                owners.insert(face.labels[0]);
+                owners.insert(face.labels[1]);
+              }
+
+              const int8_t* winding = QuickSurfaceMeshDetail::Winding[face.kind];
+              for(int32_t t = 0; t < 2; t++)
+              {
+                int64_t local = triangleId - m_TriangleOffset;
+                m_Triangles[local * 3 + 0] = faceNodes[winding[t * 3 + 0]];
+                m_Triangles[local * 3 + 1] = faceNodes[winding[t * 3 + 1]];
+                m_Triangles[local * 3 + 2] = faceNodes[winding[t * 3 + 2]];
+                m_FaceLabels[local * 2] = face.labels[0];
+                m_FaceLabels[local * 2 + 1] = face.labels[1];
+                for(size_t a = 0; a < m_Copiers->size(); a++)
+                {
+                  (*m_Copiers)[a]->copy(triangleId, face.cells[0], face.cells[1], face.boundary);
+                }
+                triangleId++;
+              }
+            }
+          }
+        }
+
+        finishPlane(k, lowerIds, lowerOwners, firstNode, endNode);
+
+        lowerIds.swap(upperIds);
+        lowerOwners.swap(upperOwners);
+        std::fill(upperIds.begin(), upperIds.end(), -1);
+        for(int64_t p = 0; p < planeSize; p++)
+        {
+          upperOwners[p].clear();
+        }
+      }
+
+      // The nodes on the top plane of the range also belong to the faces of the layer above it
+      if(static_cast<int64_t>(zEnd) < zP)
+      {
+        int64_t k = zEnd;
+        for(int64_t j = 0; j < yP; j++)
+        {
+          for(int64_t i = 0; i < xP; i++)
+          {
+            int32_t numFaces = QuickSurfaceMeshDetail::getCellFaces(m_FeatureIds, m_Dims, i, j, k, faces);
+            for(int32_t f = 0; f < numFaces; f++)
+            {
+              for(int32_t n = 0; n < 4; n++)
+              {
+                const int8_t* offset = QuickSurfaceMeshDetail::NodeOffsets[faces[f].kind][n];
+                if(offset[2] == 0)
+                {
+                  QuickSurfaceMeshDetail::NodeOwners& owners = lowerOwners[(j + offset[1]) * (xP + 1) + (i + offset[0])];
+                  owners.insert(faces[f].labels[0]);
+                  owners.insert(faces[f].labels[1]);
+                }
+              }
+            }
+          }
+        }
+      }
+      finishPlane(zEnd, lowerIds, lowerOwners, firstNode, endNode);
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+};
+
+/**
+ * @brief The QuickSurfaceMeshSlabsImpl class meshes a batch of slabs into separate buffers so that they can be
+ * appended to the binary files in order. Slab s spans the Z layers [slabStarts[s], slabStarts[s + 1]).
+ */
+class QuickSurfaceMeshSlabsImpl
+{
+    const int32_t* m_FeatureIds;
+    int64_t m_Dims[3];
+    IGeometryGrid* m_Grid;
+    const int64_t* m_NodeStarts;
+    const int64_t* m_TriangleStarts;
+    const size_t* m_SlabStarts;
+    QuickSurfaceMeshDetail::SlabBuffer* m_Buffers;
+
+  public:
+    QuickSurfaceMeshSlabsImpl(const int32_t* featureIds, const int64_t dims[3], IGeometryGrid* grid, const int64_t* nodeStarts, const int64_t* triangleStarts, const size_t* slabStarts,
+                              QuickSurfaceMeshDetail::SlabBuffer* buffers)
+    : m_FeatureIds(featureIds)
+    , m_Grid(grid)
+    , m_NodeStarts(nodeStarts)
+    , m_TriangleStarts(triangleStarts)
+    , m_SlabStarts(slabStarts)
+    , m_Buffers(buffers)
+    {
+      m_Dims[0] = dims[0];
+      m_Dims[1] = dims[1];
+      m_Dims[2] = dims[2];
+    }
+    virtual ~QuickSurfaceMeshSlabsImpl()
+    {
+    }
+
+    void convert(size_t start, size_t end) const
+    {
+      QuickSurfaceMeshDetail::FaceArrayCopiers noCopiers;
+      for(size_t s = start; s < end; s++)
+      {
+        size_t zStart = m_SlabStarts[s];
+        size_t zEnd = m_SlabStarts[s + 1];
+        int64_t numNodes = m_NodeStarts[zEnd] - m_NodeStarts[zStart];
+        int64_t numTriangles = m_TriangleStarts[zEnd] - m_TriangleStarts[zStart];
+
+        QuickSurfaceMeshDetail::SlabBuffer& buffer = m_Buffers[s];
+        buffer.vertices.resize(numNodes * 3);
+        buffer.nodeTypes.resize(numNodes);
+        buffer.triangles.resize(numTriangles * 3);
+        buffer.faceLabels.resize(numTriangles * 2);
+
+        QuickSurfaceMeshLayersImpl impl(m_FeatureIds, m_Dims, m_Grid, m_NodeStarts, m_TriangleStarts, m_NodeStarts[zStart], m_TriangleStarts[zStart], buffer.vertices.data(),
+                                        buffer.nodeTypes.data(), buffer.triangles.data(), buffer.faceLabels.data(), &noCopiers);
+        impl.convert(zStart, zEnd);
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+};
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -297,6 +915,33 @@ void QuickSurfaceMesh::dataCheck()
   }
 
   sm->createNonPrereqAttributeMatrix<AbstractFilter>(this, getFeatureAttributeMatrixName(), tDims, AttributeMatrix::Type::FaceFeature);
+
+  if(getStreamMeshToFiles())
+  {
+    if(getNodesFile().isEmpty())
+    {
+      setErrorCondition(-11007);
+      QString ss = QObject::tr("The Nodes file must be set when the mesh is streamed to binary files");
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    }
+    if(getTrianglesFile().isEmpty())
+    {
+      setErrorCondition(-11008);
+      QString ss = QObject::tr("The Triangles file must be set when the mesh is streamed to binary files");
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    }
+    else if(getTrianglesFile() == getNodesFile())
+    {
+      setErrorCondition(-11009);
+      QString ss = QObject::tr("The Nodes file and the Triangles file must be different files");
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    }
+    if(!m_SelectedWeakPtrVector.empty())
+    {
+      QString ss = QObject::tr("Attribute Arrays are not transferred when the mesh is streamed to binary files");
+      notifyWarningMessage(getHumanLabel(), ss, -11014);
+    }
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -312,18 +957,6 @@ void QuickSurfaceMesh::preflight()
   setInPreflight(false);
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void QuickSurfaceMesh::getGridCoordinates(IGeometryGrid::Pointer grid, size_t x, size_t y, size_t z, float *coords)
-{
-  float tmpCoords[3] = {0.0f, 0.0f, 0.0f};
-  grid->getPlaneCoords(x, y, z, tmpCoords);
-  coords[0] = tmpCoords[0];
-  coords[1] = tmpCoords[1];
-  coords[2] = tmpCoords[2];
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -359,298 +992,53 @@ void QuickSurfaceMesh::execute()
       static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
   };
 
-  int64_t xP = dims[0];
-  int64_t yP = dims[1];
   int64_t zP = dims[2];
 
-  std::vector<std::set<int32_t>> ownerLists;
-
-  int64_t possibleNumNodes = (xP + 1) * (yP + 1) * (zP + 1);
-  std::vector<int64_t> m_NodeIds(possibleNumNodes, -1);
-
-  int64_t nodeCount = 0;
-  int64_t triangleCount = 0;
-
-  int64_t point = 0, neigh1 = 0, neigh2 = 0, neigh3 = 0;
-
-  int64_t nodeId1 = 0, nodeId2 = 0, nodeId3 = 0, nodeId4 = 0;
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  // Every range of layers looks at one layer below and one layer above it again, so keep the ranges thick
+  size_t grainSize = static_cast<size_t>(zP) / (static_cast<size_t>(tbb::task_scheduler_init::default_num_threads()) * 4);
+  if(grainSize < 2)
+  {
+    grainSize = 2;
+  }
+#endif
 
-  // first determining which nodes are actually boundary nodes and
-  // count number of nodes and triangles that will be created
-  for(int64_t k = 0; k < zP; k++)
+  // First count the nodes that each layer of Cells numbers and the triangles it creates, so that every layer
+  // knows its first node and triangle Id and the layers can be meshed independently
+  std::vector<int64_t> nodeStarts(zP + 1, 0);
+  std::vector<int64_t> triangleStarts(zP + 1, 0);
   {
-    for(int64_t j = 0; j < yP; j++)
+    QuickSurfaceMeshCountImpl impl(m_FeatureIds, dims, nodeStarts.data() + 1, triangleStarts.data() + 1);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if(doParallel == true)
     {
-      for(int64_t i = 0; i < xP; i++)
-      {
-        point = (k * xP * yP) + (j * xP) + i;
-        neigh1 = point + 1;
-        neigh2 = point + xP;
-        neigh3 = point + (xP * yP);
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, zP, grainSize), impl, tbb::simple_partitioner());
+    }
+    else
+#endif
+    {
+      impl.convert(0, zP);
+    }
+  }
+  for(int64_t k = 0; k < zP; k++)
+  {
+    nodeStarts[k + 1] += nodeStarts[k];
+    triangleStarts[k + 1] += triangleStarts[k];
+  }
+  int64_t nodeCount = nodeStarts[zP];
+  int64_t triangleCount = triangleStarts[zP];
 
-        if(i == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(j == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(k == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(i == (xP - 1))
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(m_FeatureIds[point] != m_FeatureIds[neigh1])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(j == (yP - 1))
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(m_FeatureIds[point] != m_FeatureIds[neigh2])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(k == (zP - 1))
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(k < zP - 1 && m_FeatureIds[point] != m_FeatureIds[neigh3])
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-      }
+  if(getStreamMeshToFiles())
+  {
+    streamMeshToFiles(grid, dims, nodeStarts, triangleStarts);
+    if(getErrorCondition() < 0)
+    {
+      return;
     }
+    notifyStatusMessage(getHumanLabel(), "Complete");
+    return;
   }
 
   // now create node and triangle arrays knowing the number that will be needed
@@ -669,500 +1057,149 @@ void QuickSurfaceMesh::execute()
   updateVertexInstancePointers();
   updateFaceInstancePointers();
 
-  ownerLists.resize(nodeCount);
-
-  // Cycle through again assigning coordinates to each node and assigning node numbers and feature labels to each triangle
-  int64_t triangleIndex = 0;
-  for(int64_t k = 0; k < zP; k++)
+  QuickSurfaceMeshDetail::FaceArrayCopiers copiers;
+  for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
   {
-    for(int64_t j = 0; j < yP; j++)
-    {
-      for(int64_t i = 0; i < xP; i++)
-      {
-        point = (k * xP * yP) + (j * xP) + i;
-        neigh1 = point + 1;
-        neigh2 = point + xP;
-        neigh3 = point + (xP * yP);
-
-        if(i == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if(j == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if(k == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if(i == (xP - 1))
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId1];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        else if(m_FeatureIds[point] != m_FeatureIds[neigh1])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh1];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh1, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock())
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh1];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
+    EXECUTE_FUNCTION_TEMPLATE(this, createFaceArrayCopier, m_SelectedWeakPtrVector[i].lock(), m_SelectedWeakPtrVector[i].lock(), m_CreatedWeakPtrVector[i].lock(), copiers)
+  }
 
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh1, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock())
-          }
+  // Mesh the layers, assigning coordinates and types to each node and node numbers and feature labels to each triangle
+  QuickSurfaceMeshLayersImpl impl(m_FeatureIds, dims, grid.get(), nodeStarts.data(), triangleStarts.data(), 0, 0, vertex, m_NodeTypes, triangle, m_FaceLabels, &copiers);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, zP, grainSize), impl, tbb::simple_partitioner());
+  }
+  else
+#endif
+  {
+    impl.convert(0, zP);
+  }
 
-          triangleIndex++;
+  notifyStatusMessage(getHumanLabel(), "Complete");
+}
 
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[neigh1]);
-        }
-        if(j == (yP - 1))
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex + (m_NodeIds[nodeId1] * 3));
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void QuickSurfaceMesh::streamMeshToFiles(IGeometryGrid::Pointer grid, int64_t dims[3], const std::vector<int64_t>& nodeStarts, const std::vector<int64_t>& triangleStarts)
+{
+  int64_t zP = dims[2];
 
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex + (m_NodeIds[nodeId2] * 3));
+  QFileInfo nodesInfo(getNodesFile());
+  QFileInfo trianglesInfo(getTrianglesFile());
+  QDir().mkpath(nodesInfo.absolutePath());
+  QDir().mkpath(trianglesInfo.absolutePath());
 
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
+  FILE* nodesFile = fopen(getNodesFile().toLatin1().data(), "wb");
+  if(nullptr == nodesFile)
+  {
+    QString ss = QObject::tr("Error opening the Nodes file '%1'").arg(getNodesFile());
+    setErrorCondition(-11010);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+  ScopedFileMonitor nodesMonitor(nodesFile);
 
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
+  FILE* trianglesFile = fopen(getTrianglesFile().toLatin1().data(), "wb");
+  if(nullptr == trianglesFile)
+  {
+    QString ss = QObject::tr("Error opening the Triangles file '%1'").arg(getTrianglesFile());
+    setErrorCondition(-11011);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+  ScopedFileMonitor trianglesMonitor(trianglesFile);
 
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId1];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
+  // Group the layers into slabs of about the same number of triangles. One slab per thread is held in memory
+  // at a time.
+  const int64_t k_TrianglesPerSlab = 1000000;
+  std::vector<size_t> slabStarts(1, 0);
+  for(int64_t k = 0; k < zP; k++)
+  {
+    if(triangleStarts[k + 1] - triangleStarts[slabStarts.back()] >= k_TrianglesPerSlab || k == zP - 1)
+    {
+      slabStarts.push_back(k + 1);
+    }
+  }
+  size_t numSlabs = slabStarts.size() - 1;
 
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
+  size_t batchSize = 1;
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  batchSize = static_cast<size_t>(tbb::task_scheduler_init::default_num_threads());
+#endif
 
-          triangleIndex++;
+  SurfaceMesh::NodesFile::NodesFileRecord_t nodeRecord;
+  SurfaceMesh::TrianglesFile::TrianglesFileRecord_t triangleRecord;
 
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
+  for(size_t batchStart = 0; batchStart < numSlabs; batchStart += batchSize)
+  {
+    if(getCancel() == true)
+    {
+      return;
+    }
 
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
+    size_t batchEnd = std::min(numSlabs, batchStart + batchSize);
+    std::vector<QuickSurfaceMeshDetail::SlabBuffer> buffers(batchEnd - batchStart);
+    QuickSurfaceMeshSlabsImpl impl(m_FeatureIds, dims, grid.get(), nodeStarts.data(), triangleStarts.data(), slabStarts.data() + batchStart, buffers.data());
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, buffers.size(), 1), impl, tbb::simple_partitioner());
+    }
+    else
+#endif
+    {
+      impl.convert(0, buffers.size());
+    }
 
-          triangleIndex++;
+    for(size_t s = 0; s < buffers.size(); s++)
+    {
+      const QuickSurfaceMeshDetail::SlabBuffer& buffer = buffers[s];
+      int64_t firstNode = nodeStarts[slabStarts[batchStart + s]];
+      int64_t firstTriangle = triangleStarts[slabStarts[batchStart + s]];
 
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        else if(m_FeatureIds[point] != m_FeatureIds[neigh2])
+      for(size_t n = 0; n < buffer.nodeTypes.size(); n++)
+      {
+        nodeRecord.nodeId = firstNode + n;
+        nodeRecord.nodeKind = buffer.nodeTypes[n];
+        nodeRecord.x = buffer.vertices[n * 3];
+        nodeRecord.y = buffer.vertices[n * 3 + 1];
+        nodeRecord.z = buffer.vertices[n * 3 + 2];
+        if(fwrite(&nodeRecord, SurfaceMesh::NodesFile::ByteCount, 1, nodesFile) != 1)
         {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh2];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh2, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock())
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh2];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh2, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock())
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[neigh2]);
+          QString ss = QObject::tr("Error writing to the Nodes file '%1'").arg(getNodesFile());
+          setErrorCondition(-11012);
+          notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+          return;
         }
-        if(k == (zP - 1))
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId1];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-          m_FaceLabels[triangleIndex * 2 + 1] = -1;
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
+      }
 
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        else if(m_FeatureIds[point] != m_FeatureIds[neigh3])
+      size_t numTriangles = buffer.faceLabels.size() / 2;
+      for(size_t t = 0; t < numTriangles; t++)
+      {
+        triangleRecord.triId = firstTriangle + t;
+        triangleRecord.nodeId_0 = buffer.triangles[t * 3];
+        triangleRecord.nodeId_1 = buffer.triangles[t * 3 + 1];
+        triangleRecord.nodeId_2 = buffer.triangles[t * 3 + 2];
+        triangleRecord.label_0 = buffer.faceLabels[t * 2];
+        triangleRecord.label_1 = buffer.faceLabels[t * 2 + 1];
+        if(fwrite(&triangleRecord, SurfaceMesh::TrianglesFile::ByteCount, 1, trianglesFile) != 1)
         {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh3];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh3, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock())
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh3];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh3, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock())
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[neigh3]);
+          QString ss = QObject::tr("Error writing to the Triangles file '%1'").arg(getTrianglesFile());
+          setErrorCondition(-11013);
+          notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+          return;
         }
       }
     }
-  }
 
-  for(int64_t i = 0; i < nodeCount; i++)
-  {
-    m_NodeTypes[i] = ownerLists[i].size();
-    if(m_NodeTypes[i] > 4)
-    {
-      m_NodeTypes[i] = 4;
-    }
-    if(ownerLists[i].find(-1) != ownerLists[i].end())
-    {
-      m_NodeTypes[i] += 10;
-    }
+    QString ss = QObject::tr("Wrote %1 of %2 Z Slices").arg(slabStarts[batchEnd]).arg(zP);
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
   }
-
-  notifyStatusMessage(getHumanLabel(), "Complete");
 }
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -37,6 +37,8 @@
 #ifndef _quicksurfacemesh_h_
 #define _quicksurfacemesh_h_
 
+#include <vector>
+
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/Common/AbstractFilter.h"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
@@ -81,6 +83,15 @@ class QuickSurfaceMesh : public AbstractFilter
     SIMPL_FILTER_PARAMETER(QString, FeatureAttributeMatrixName)
     Q_PROPERTY(QString FeatureAttributeMatrixName READ getFeatureAttributeMatrixName WRITE setFeatureAttributeMatrixName)
 
+    SIMPL_FILTER_PARAMETER(bool, StreamMeshToFiles)
+    Q_PROPERTY(bool StreamMeshToFiles READ getStreamMeshToFiles WRITE setStreamMeshToFiles)
+
+    SIMPL_FILTER_PARAMETER(QString, NodesFile)
+    Q_PROPERTY(QString NodesFile READ getNodesFile WRITE setNodesFile)
+
+    SIMPL_FILTER_PARAMETER(QString, TrianglesFile)
+    Q_PROPERTY(QString TrianglesFile READ getTrianglesFile WRITE setTrianglesFile)
+
     /**
      * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
      */
@@ -184,14 +195,14 @@ class QuickSurfaceMesh : public AbstractFilter
     std::vector<IDataArray::WeakPointer> m_CreatedWeakPtrVector;
 
     /**
-     * @brief getGridCoordinates
-     * @param grid
-     * @param x
-     * @param y
-     * @param z
-     * @param coords
+     * @brief streamMeshToFiles Meshes the volume slab by slab and appends the nodes and triangles to the
+     * binary Nodes and Triangles files instead of filling the Triangle Geometry
+     * @param grid Grid Geometry being meshed
+     * @param dims Dimensions of the grid
+     * @param nodeStarts First node Id of each Z layer of Cells, followed by the total number of nodes
+     * @param triangleStarts First triangle Id of each Z layer of Cells, followed by the total number of triangles
      */
-    void getGridCoordinates(IGeometryGrid::Pointer grid, size_t x, size_t y, size_t z, float* coords);
+    void streamMeshToFiles(IGeometryGrid::Pointer grid, int64_t dims[3], const std::vector<int64_t>& nodeStarts, const std::vector<int64_t>& triangleStarts);
 
     /**
      * @brief updateFaceInstancePointers Updates raw Face pointers
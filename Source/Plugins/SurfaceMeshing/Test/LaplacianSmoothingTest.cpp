@@ -0,0 +1,303 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+class LaplacianSmoothingTest
+{
+
+  public:
+    LaplacianSmoothingTest() {}
+    virtual ~LaplacianSmoothingTest() {}
+
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the LaplacianSmoothing Filter from the FilterManager
+    QString filtName = "LaplacianSmoothing";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+    if (nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The SurfaceMeshing Requires the use of the " << filtName.toStdString() << " filter which is found in the SurfaceMeshing Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateTestData(int64_t dim)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+
+    DataContainer::Pointer tdc = DataContainer::New(SIMPL::Defaults::TriangleDataContainerName);
+    dca->addDataContainer(tdc);
+
+    // A square sheet of dim x dim vertices with a bumpy height, split into two triangles per square. The
+    // vertices around the border are outer points and stay in place with the default lambdas.
+    int64_t numVertices = dim * dim;
+    int64_t numTriangles = 2 * (dim - 1) * (dim - 1);
+    SharedVertexList::Pointer vertex = TriangleGeom::CreateSharedVertexList(numVertices);
+    TriangleGeom::Pointer triangle = TriangleGeom::CreateGeometry(numTriangles, vertex, SIMPL::Geometry::TriangleGeometry);
+    tdc->setGeometry(triangle);
+    float* vertices = triangle->getVertexPointer(0);
+    int64_t* tris = triangle->getTriPointer(0);
+
+    QVector<size_t> tDims(1, numVertices);
+    AttributeMatrix::Pointer vertexAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::VertexAttributeMatrixName, AttributeMatrix::Type::Vertex);
+    tdc->addAttributeMatrix(SIMPL::Defaults::VertexAttributeMatrixName, vertexAttrMat);
+    Int8ArrayType::Pointer nodeTypes = Int8ArrayType::CreateArray(numVertices, SIMPL::VertexData::SurfaceMeshNodeType);
+    vertexAttrMat->addAttributeArray(SIMPL::VertexData::SurfaceMeshNodeType, nodeTypes);
+
+    for(int64_t y = 0; y < dim; y++)
+    {
+      for(int64_t x = 0; x < dim; x++)
+      {
+        int64_t index = y * dim + x;
+        vertices[3 * index + 0] = static_cast<float>(x) + 0.3f * sinf(static_cast<float>(x * 7 + y * 3));
+        vertices[3 * index + 1] = static_cast<float>(y) + 0.3f * cosf(static_cast<float>(x * 5 - y * 11));
+        vertices[3 * index + 2] = sinf(static_cast<float>(x * x + 2 * y));
+        bool border = (x == 0 || y == 0 || x == dim - 1 || y == dim - 1);
+        nodeTypes->setValue(index, border ? SIMPL::SurfaceMesh::NodeType::SurfaceDefault : SIMPL::SurfaceMesh::NodeType::Default);
+      }
+    }
+
+    int64_t t = 0;
+    for(int64_t y = 0; y < dim - 1; y++)
+    {
+      for(int64_t x = 0; x < dim - 1; x++)
+      {
+        int64_t index = y * dim + x;
+        tris[3 * t + 0] = index;
+        tris[3 * t + 1] = index + 1;
+        tris[3 * t + 2] = index + dim + 1;
+        t++;
+        tris[3 * t + 0] = index;
+        tris[3 * t + 1] = index + dim + 1;
+        tris[3 * t + 2] = index + dim;
+        t++;
+      }
+    }
+
+    tDims[0] = numTriangles;
+    AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::FaceAttributeMatrixName, AttributeMatrix::Type::Face);
+    tdc->addAttributeMatrix(SIMPL::Defaults::FaceAttributeMatrixName, faceAttrMat);
+    QVector<size_t> cDims(1, 2);
+    Int32ArrayType::Pointer faceLabels = Int32ArrayType::CreateArray(numTriangles, cDims, SIMPL::FaceData::SurfaceMeshFaceLabels);
+    faceAttrMat->addAttributeArray(SIMPL::FaceData::SurfaceMeshFaceLabels, faceLabels);
+    for(int64_t i = 0; i < numTriangles; i++)
+    {
+      faceLabels->setComponent(i, 0, -1);
+      faceLabels->setComponent(i, 1, 1);
+    }
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Smooths the vertices the way the filter originally did, by scattering the
+  // differences along every edge into both of its vertices
+  // -----------------------------------------------------------------------------
+  int32_t ReferenceSmoothing(std::vector<float>& verts, const int64_t* uedges, int64_t nedges, const Int8ArrayType::Pointer& nodeTypes, float lambda, int32_t iterationSteps,
+                             bool useTaubinSmoothing, float muFactor, float tolerance)
+  {
+    int64_t nvert = static_cast<int64_t>(verts.size() / 3);
+    std::vector<int32_t> ncon(nvert, 0);
+    std::vector<double> delta(3 * nvert, 0.0);
+    for(int32_t q = 0; q < iterationSteps; q++)
+    {
+      std::vector<float> start = verts;
+      for(int32_t step = 0; step < (useTaubinSmoothing ? 2 : 1); step++)
+      {
+        for(int64_t i = 0; i < nedges; i++)
+        {
+          int64_t in1 = uedges[2 * i];
+          int64_t in2 = uedges[2 * i + 1];
+          for(int32_t j = 0; j < 3; j++)
+          {
+            double dlta = verts[3 * in2 + j] - verts[3 * in1 + j];
+            delta[3 * in1 + j] += dlta;
+            delta[3 * in2 + j] += -1.0 * dlta;
+          }
+          ncon[in1] += 1;
+          ncon[in2] += 1;
+        }
+        for(int64_t i = 0; i < nvert; i++)
+        {
+          float ll = (nodeTypes->getValue(i) == SIMPL::SurfaceMesh::NodeType::Default) ? lambda : 0.0f;
+          if(step == 1)
+          {
+            ll = ll * muFactor;
+          }
+          for(int32_t j = 0; j < 3; j++)
+          {
+            verts[3 * i + j] += ll * (delta[3 * i + j] / ncon[i]);
+            delta[3 * i + j] = 0.0;
+          }
+          ncon[i] = 0;
+        }
+      }
+
+      float maxDisplacement = 0.0f;
+      for(int64_t i = 0; i < nvert; i++)
+      {
+        float displacement = 0.0f;
+        for(int32_t j = 0; j < 3; j++)
+        {
+          float diff = verts[3 * i + j] - start[3 * i + j];
+          displacement += diff * diff;
+        }
+        maxDisplacement = std::max(maxDisplacement, displacement);
+      }
+      if(tolerance > 0.0f && maxDisplacement <= tolerance * tolerance)
+      {
+        return q + 1;
+      }
+    }
+    return iterationSteps;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestSmoothing()
+  {
+    const float lambda = 0.2f;
+    const float muFactor = -1.03f;
+    const int32_t iterationSteps = 400;
+    float tolerances[2] = {0.0f, 0.0005f};
+
+    for(int32_t taubin = 0; taubin < 2; taubin++)
+    {
+      for(int32_t t = 0; t < 2; t++)
+      {
+        DataContainerArray::Pointer dca = CreateTestData(24);
+        TriangleGeom::Pointer triangle = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName)->getGeometryAs<TriangleGeom>();
+        float* vertices = triangle->getVertexPointer(0);
+        std::vector<float> expected(vertices, vertices + 3 * triangle->getNumberOfVertices());
+
+        QString filtName = "LaplacianSmoothing";
+        FilterManager* fm = FilterManager::Instance();
+        IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+        AbstractFilter::Pointer filter = filterFactory->create();
+        filter->setDataContainerArray(dca);
+
+        bool ok = filter->setProperty("IterationSteps", iterationSteps);
+        DREAM3D_REQUIRE_EQUAL(ok, true)
+        ok = filter->setProperty("Lambda", lambda);
+        DREAM3D_REQUIRE_EQUAL(ok, true)
+        ok = filter->setProperty("UseTaubinSmoothing", taubin == 1);
+        DREAM3D_REQUIRE_EQUAL(ok, true)
+        ok = filter->setProperty("MuFactor", muFactor);
+        DREAM3D_REQUIRE_EQUAL(ok, true)
+        ok = filter->setProperty("ConvergenceTolerance", tolerances[t]);
+        DREAM3D_REQUIRE_EQUAL(ok, true)
+
+        filter->execute();
+        int err = filter->getErrorCondition();
+        DREAM3D_REQUIRE(err >= 0)
+
+        // The filter created the unique edges, so the reference can walk them in the same order
+        DREAM3D_REQUIRE_VALID_POINTER(triangle->getEdges().get())
+        Int8ArrayType::Pointer nodeTypes = dca->getAttributeMatrix(DataArrayPath(SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::VertexAttributeMatrixName, ""))
+                                               ->getAttributeArrayAs<Int8ArrayType>(SIMPL::VertexData::SurfaceMeshNodeType);
+        int32_t steps = ReferenceSmoothing(expected, triangle->getEdgePointer(0), triangle->getNumberOfEdges(), nodeTypes, lambda, iterationSteps, taubin == 1, muFactor, tolerances[t]);
+        if(tolerances[t] > 0.0f)
+        {
+          DREAM3D_REQUIRE(steps < iterationSteps)
+        }
+
+        vertices = triangle->getVertexPointer(0);
+        for(size_t i = 0; i < expected.size(); i++)
+        {
+          DREAM3D_REQUIRE_EQUAL(vertices[i], expected[i])
+        }
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST( TestFilterAvailability() );
+
+    DREAM3D_REGISTER_TEST( TestSmoothing() )
+
+    DREAM3D_REGISTER_TEST( RemoveTestFiles() )
+  }
+
+  private:
+    LaplacianSmoothingTest(const LaplacianSmoothingTest&); // Copy Constructor Not Implemented
+    void operator=(const LaplacianSmoothingTest&); // Operator '=' Not Implemented
+
+
+};
@@ -42,7 +42,9 @@
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/Common/TemplateHelpers.hpp"
 #include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Common/ScopedFileMonitor.hpp"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Geometry/MeshStructs.h"
 #include "SIMPLib/Geometry/RectGridGeom.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/Plugin/ISIMPLibPlugin.h"
@@ -526,6 +528,219 @@ public:
 
     return EXIT_SUCCESS;
   }
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestStreamMeshToFiles()
+  {
+    // A volume with several slices and Features so that the mesh crosses many layer seams
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New("ImageGeom3D");
+    dca->addDataContainer(dc);
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(5, 4, 9);
+    image->setResolution(0.5f, 1.0f, 2.0f);
+    dc->setGeometry(image);
+
+    QVector<size_t> tDims(1, 5 * 4 * 9);
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, "CellData", AttributeMatrix::Type::Cell);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(tDims[0], SIMPL::CellData::FeatureIds);
+    for(size_t i = 0; i < tDims[0]; i++)
+    {
+      featureIds->setValue(i, static_cast<int32_t>((i * 7 + (i / 20) * 3) % 5));
+    }
+    cellAttrMat->addAttributeArray(SIMPL::CellData::FeatureIds, featureIds);
+    dc->addAttributeMatrix("CellData", cellAttrMat);
+
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryForFilter("QuickSurfaceMesh");
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+
+    QVariant var;
+    bool propWasSet = false;
+    int err = 0;
+    DataArrayPath featureIdsPath("ImageGeom3D", "CellData", SIMPL::CellData::FeatureIds);
+
+    AbstractFilter::Pointer meshFilter = factory->create();
+    meshFilter->setDataContainerArray(dca);
+    SET_PROPERTIES_AND_CHECK(meshFilter, featureIdsPath, QString("InMemoryMesh"), err);
+
+    AbstractFilter::Pointer streamFilter = factory->create();
+    streamFilter->setDataContainerArray(dca);
+    var.setValue(true);
+    propWasSet = streamFilter->setProperty("StreamMeshToFiles", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(UnitTest::QuickSurfaceMeshTest::TestFile1);
+    propWasSet = streamFilter->setProperty("NodesFile", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(UnitTest::QuickSurfaceMeshTest::TestFile2);
+    propWasSet = streamFilter->setProperty("TrianglesFile", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    SET_PROPERTIES_AND_CHECK(streamFilter, featureIdsPath, QString("StreamedMesh"), err);
+
+    DataContainer::Pointer sm = dca->getDataContainer("InMemoryMesh");
+    TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
+    float* vertices = triangleGeom->getVertexPointer(0);
+    int64_t* triangles = triangleGeom->getTriPointer(0);
+    Int8ArrayType::Pointer nodeTypes = sm->getAttributeMatrix(SIMPL::Defaults::VertexAttributeMatrixName)->getAttributeArrayAs<Int8ArrayType>(SIMPL::VertexData::SurfaceMeshNodeType);
+    Int32ArrayType::Pointer faceLabels = sm->getAttributeMatrix(SIMPL::Defaults::FaceAttributeMatrixName)->getAttributeArrayAs<Int32ArrayType>(SIMPL::FaceData::SurfaceMeshFaceLabels);
+    DREAM3D_REQUIRE_VALID_POINTER(nodeTypes.get())
+    DREAM3D_REQUIRE_VALID_POINTER(faceLabels.get())
+
+    // The streamed files must hold exactly the in memory mesh
+    FILE* nodesFile = fopen(UnitTest::QuickSurfaceMeshTest::TestFile1.toLatin1().data(), "rb");
+    DREAM3D_REQUIRE_VALID_POINTER(nodesFile)
+    ScopedFileMonitor nodesMonitor(nodesFile);
+    SurfaceMesh::NodesFile::NodesFileRecord_t nodeRecord;
+    size_t numNodes = 0;
+    while(fread(&nodeRecord, SurfaceMesh::NodesFile::ByteCount, 1, nodesFile) == 1)
+    {
+      DREAM3D_REQUIRE(numNodes < triangleGeom->getNumberOfVertices())
+      DREAM3D_REQUIRE_EQUAL(nodeRecord.nodeId, numNodes)
+      DREAM3D_REQUIRE_EQUAL(nodeRecord.nodeKind, nodeTypes->getValue(numNodes))
+      DREAM3D_REQUIRE_EQUAL(nodeRecord.x, vertices[numNodes * 3])
+      DREAM3D_REQUIRE_EQUAL(nodeRecord.y, vertices[numNodes * 3 + 1])
+      DREAM3D_REQUIRE_EQUAL(nodeRecord.z, vertices[numNodes * 3 + 2])
+      numNodes++;
+    }
+    DREAM3D_REQUIRE_EQUAL(numNodes, triangleGeom->getNumberOfVertices())
+
+    FILE* trianglesFile = fopen(UnitTest::QuickSurfaceMeshTest::TestFile2.toLatin1().data(), "rb");
+    DREAM3D_REQUIRE_VALID_POINTER(trianglesFile)
+    ScopedFileMonitor trianglesMonitor(trianglesFile);
+    SurfaceMesh::TrianglesFile::TrianglesFileRecord_t triangleRecord;
+    size_t numTriangles = 0;
+    while(fread(&triangleRecord, SurfaceMesh::TrianglesFile::ByteCount, 1, trianglesFile) == 1)
+    {
+      DREAM3D_REQUIRE(numTriangles < triangleGeom->getNumberOfTris())
+      DREAM3D_REQUIRE_EQUAL(triangleRecord.triId, numTriangles)
+      DREAM3D_REQUIRE_EQUAL(triangleRecord.nodeId_0, triangles[numTriangles * 3])
+      DREAM3D_REQUIRE_EQUAL(triangleRecord.nodeId_1, triangles[numTriangles * 3 + 1])
+      DREAM3D_REQUIRE_EQUAL(triangleRecord.nodeId_2, triangles[numTriangles * 3 + 2])
+      DREAM3D_REQUIRE_EQUAL(triangleRecord.label_0, faceLabels->getValue(numTriangles * 2))
+      DREAM3D_REQUIRE_EQUAL(triangleRecord.label_1, faceLabels->getValue(numTriangles * 2 + 1))
+      numTriangles++;
+    }
+    DREAM3D_REQUIRE_EQUAL(numTriangles, triangleGeom->getNumberOfTris())
+
+    // Every node is shared by at least one Triangle and has the coordinates of a grid point
+    std::vector<int32_t> useCount(triangleGeom->getNumberOfVertices(), 0);
+    for(size_t i = 0; i < triangleGeom->getNumberOfTris() * 3; i++)
+    {
+      useCount[triangles[i]]++;
+    }
+    for(size_t i = 0; i < useCount.size(); i++)
+    {
+      DREAM3D_REQUIRE(useCount[i] > 0)
+      DREAM3D_REQUIRE_EQUAL(vertices[i * 3] * 2.0f, static_cast<float>(static_cast<int32_t>(vertices[i * 3] * 2.0f)))
+      DREAM3D_REQUIRE_EQUAL(vertices[i * 3 + 2] * 0.5f, static_cast<float>(static_cast<int32_t>(vertices[i * 3 + 2] * 0.5f)))
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestMinXFace()
+  {
+    // A single Cell thick slab in X so that every Cell has a -X face on the outside of the volume,
+    // placed away from the origin so that a node on the wrong side of the slab is easy to spot
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New("ImageGeom3D");
+    dca->addDataContainer(dc);
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(1, 3, 4);
+    image->setResolution(0.5f, 1.0f, 2.0f);
+    image->setOrigin(-1.5f, 2.0f, 0.5f);
+    dc->setGeometry(image);
+
+    QVector<size_t> tDims(1, 1 * 3 * 4);
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, "CellData", AttributeMatrix::Type::Cell);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(tDims[0], SIMPL::CellData::FeatureIds);
+    for(size_t i = 0; i < tDims[0]; i++)
+    {
+      featureIds->setValue(i, static_cast<int32_t>(1 + (i % 3 + i / 6) % 2));
+    }
+    cellAttrMat->addAttributeArray(SIMPL::CellData::FeatureIds, featureIds);
+    dc->addAttributeMatrix("CellData", cellAttrMat);
+
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryForFilter("QuickSurfaceMesh");
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+
+    QVariant var;
+    bool propWasSet = false;
+    int err = 0;
+    DataArrayPath featureIdsPath("ImageGeom3D", "CellData", SIMPL::CellData::FeatureIds);
+
+    AbstractFilter::Pointer meshFilter = factory->create();
+    meshFilter->setDataContainerArray(dca);
+    SET_PROPERTIES_AND_CHECK(meshFilter, featureIdsPath, QString("MinXMesh"), err);
+
+    DataContainer::Pointer sm = dca->getDataContainer("MinXMesh");
+    TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
+    float* vertices = triangleGeom->getVertexPointer(0);
+    int64_t* triangles = triangleGeom->getTriPointer(0);
+    Int32ArrayType::Pointer faceLabels = sm->getAttributeMatrix(SIMPL::Defaults::FaceAttributeMatrixName)->getAttributeArrayAs<Int32ArrayType>(SIMPL::FaceData::SurfaceMeshFaceLabels);
+    DREAM3D_REQUIRE_VALID_POINTER(faceLabels.get())
+
+    // The -X face of the first Cell is meshed first, and all 4 of its nodes lie on the -X side of the slab
+    const float minX = -1.5f;
+    const float maxX = -1.0f;
+    const float firstFace[6][3] = {{minX, 2.0f, 0.5f}, {minX, 3.0f, 0.5f}, {minX, 2.0f, 2.5f}, {minX, 3.0f, 0.5f}, {minX, 3.0f, 2.5f}, {minX, 2.0f, 2.5f}};
+    for(size_t n = 0; n < 6; n++)
+    {
+      float* vertex = vertices + triangles[n] * 3;
+      DREAM3D_REQUIRE_EQUAL(vertex[0], firstFace[n][0])
+      DREAM3D_REQUIRE_EQUAL(vertex[1], firstFace[n][1])
+      DREAM3D_REQUIRE_EQUAL(vertex[2], firstFace[n][2])
+    }
+    DREAM3D_REQUIRE_EQUAL(faceLabels->getValue(0), featureIds->getValue(0))
+    DREAM3D_REQUIRE_EQUAL(faceLabels->getValue(1), -1)
+
+    // Every grid point on the -X side of the slab is exactly one node
+    std::vector<int32_t> minXNodes(4 * 5, 0);
+    for(size_t i = 0; i < triangleGeom->getNumberOfVertices(); i++)
+    {
+      float* vertex = vertices + i * 3;
+      DREAM3D_REQUIRE(vertex[0] == minX || vertex[0] == maxX)
+      if(vertex[0] == minX)
+      {
+        int32_t y = static_cast<int32_t>(vertex[1] - 2.0f);
+        int32_t z = static_cast<int32_t>((vertex[2] - 0.5f) * 0.5f);
+        DREAM3D_REQUIRE(y >= 0 && y <= 3 && z >= 0 && z <= 4)
+        minXNodes[z * 4 + y]++;
+      }
+    }
+    for(size_t i = 0; i < minXNodes.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(minXNodes[i], 1)
+    }
+
+    // and the -X side of the slab is covered by 2 boundary Triangles per Cell
+    size_t numMinXTriangles = 0;
+    for(size_t t = 0; t < triangleGeom->getNumberOfTris(); t++)
+    {
+      int32_t onMinX = 0;
+      for(size_t n = 0; n < 3; n++)
+      {
+        if(vertices[triangles[t * 3 + n] * 3] == minX)
+        {
+          onMinX++;
+        }
+      }
+      if(onMinX == 3)
+      {
+        DREAM3D_REQUIRE_EQUAL(faceLabels->getValue(t * 2 + 1), -1)
+        numMinXTriangles++;
+      }
+    }
+    DREAM3D_REQUIRE_EQUAL(numMinXTriangles, 2 * tDims[0])
+
+    return EXIT_SUCCESS;
+  }
+
   /**
 * @brief
 */
@@ -535,6 +750,8 @@ public:
     DREAM3D_REGISTER_TEST(TestFilterAvailability());
 
     DREAM3D_REGISTER_TEST(RunTest())
+    DREAM3D_REGISTER_TEST(TestStreamMeshToFiles())
+    DREAM3D_REGISTER_TEST(TestMinXFace())
 
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
   }
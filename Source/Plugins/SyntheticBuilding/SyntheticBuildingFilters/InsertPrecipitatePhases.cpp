@@ -54,6 +54,7 @@
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
 #include "SyntheticBuilding/SyntheticBuildingConstants.h"
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/AvailablePoints.hpp"
 #include "SyntheticBuilding/SyntheticBuildingVersion.h"
 
 // Include the MOC generated file for this class
@@ -297,7 +298,6 @@ void InsertPrecipitatePhases::initialize()
 
   m_Seed = QDateTime::currentMSecsSinceEpoch();
 
-  m_FeatureSizeDist.clear();
   m_SimFeatureSizeDist.clear();
   m_RdfTargetDist.clear();
   m_RdfCurrentDist.clear();
@@ -307,12 +307,13 @@ void InsertPrecipitatePhases::initialize()
   m_FeatureSizeDistStep.clear();
   m_GSizes.clear();
 
-  m_AvailablePointsCount = 0;
   m_currentRDFerror = m_oldRDFerror = 0.0f;
   m_CurrentSizeDistError = m_OldSizeDistError = 0.0f;
   m_rdfMax = m_rdfMin = m_StepSize = 0.0f;
   m_numRDFbins = 0;
 
+  m_PrecipitateGrid.clear();
+
   m_PrecipitatePhases.clear();
   m_PrecipitatePhaseFractions.clear();
 }
@@ -795,44 +796,42 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
   }
 
   // This is the set that we are going to keep updated with the points that are not in an exclusion zone
-  std::map<size_t, size_t> availablePoints;
-  std::map<size_t, size_t> availablePointsInv;
+  AvailablePoints availablePoints;
 
   // Get a pointer to the Feature Owners that was just initialized in the initialize_packinggrid() method
   int32_t* exclusionZones = exclusionZonesPtr->getPointer(0);
   size_t featureOwnersIdx = 0;
 
   // initialize the sim and goal size distributions for the precipitate phases
-  m_FeatureSizeDist.resize(m_PrecipitatePhases.size());
   m_SimFeatureSizeDist.resize(m_PrecipitatePhases.size());
   m_FeatureSizeDistStep.resize(m_PrecipitatePhases.size());
   for(size_t i = 0; i < m_PrecipitatePhases.size(); i++)
   {
     phase = m_PrecipitatePhases[i];
     PrecipitateStatsData* pp = PrecipitateStatsData::SafePointerDownCast(statsDataArray[phase].get());
-    m_FeatureSizeDist[i].resize(40);
-    m_SimFeatureSizeDist[i].resize(40);
-    m_FeatureSizeDistStep[i] = static_cast<float>(((2.0f * pp->getMaxFeatureDiameter()) - (pp->getMinFeatureDiameter() / 2.0f)) / m_FeatureSizeDist[i].size());
+    std::vector<float> featureSizeDist(40, 0.0f);
+    m_FeatureSizeDistStep[i] = static_cast<float>(((2.0f * pp->getMaxFeatureDiameter()) - (pp->getMinFeatureDiameter() / 2.0f)) / featureSizeDist.size());
     float input = 0.0f;
     float previoustotal = 0.0f;
     VectorOfFloatArray GSdist = pp->getFeatureSizeDistribution();
     float avg = GSdist[0]->getValue(0);
     float stdev = GSdist[1]->getValue(0);
     float denominatorConst = sqrtf(2.0f * stdev * stdev); // Calculate it here rather than calculating the same thing multiple times below
-    for(size_t j = 0; j < m_FeatureSizeDist[i].size(); j++)
+    for(size_t j = 0; j < featureSizeDist.size(); j++)
     {
       input = (float(j + 1) * m_FeatureSizeDistStep[i]) + (pp->getMinFeatureDiameter() / 2.0f);
       float logInput = logf(input);
       if(logInput <= avg)
       {
-        m_FeatureSizeDist[i][j] = 0.5f - 0.5f * (SIMPLibMath::erf((avg - logInput) / denominatorConst)) - previoustotal;
+        featureSizeDist[j] = 0.5f - 0.5f * (SIMPLibMath::erf((avg - logInput) / denominatorConst)) - previoustotal;
       }
       if(logInput > avg)
       {
-        m_FeatureSizeDist[i][j] = 0.5f + 0.5f * (SIMPLibMath::erf((logInput - avg) / denominatorConst)) - previoustotal;
+        featureSizeDist[j] = 0.5f + 0.5f * (SIMPLibMath::erf((logInput - avg) / denominatorConst)) - previoustotal;
       }
-      previoustotal = previoustotal + m_FeatureSizeDist[i][j];
+      previoustotal = previoustotal + featureSizeDist[j];
     }
+    m_SimFeatureSizeDist[i].initialize(1, featureSizeDist.size(), featureSizeDist);
   }
 
   if(getCancel() == true)
@@ -871,6 +870,7 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
         m->getAttributeMatrix(getFeaturePhasesArrayPath().getAttributeMatrixName())->resizeAttributeArrays(tDims);
         updateFeatureInstancePointers();
         transfer_attributes(currentnumfeatures, &precip);
+        update_sizedist(&precip, 1);
         m_OldSizeDistError = m_CurrentSizeDistError;
         curphasevol[j] = curphasevol[j] + m_Volumes[currentnumfeatures];
         // FIXME: Initialize the Feature with some sort of default data
@@ -921,14 +921,12 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
   }
 
   // determine initial set of available points
-  m_AvailablePointsCount = 0;
+  availablePoints.reset(m_TotalPoints);
   for(int64_t i = 0; i < m_TotalPoints; i++)
   {
     if((exclusionZones[i] == 0 && m_UseMask == false) || (exclusionZones[i] == 0 && m_UseMask == true && m_Mask[i] == true))
     {
-      availablePoints[i] = m_AvailablePointsCount;
-      availablePointsInv[m_AvailablePointsCount] = i;
-      m_AvailablePointsCount++;
+      availablePoints.insert(i);
     }
   }
   // and clear the pointsToRemove and pointsToAdd vectors from the initial packing
@@ -1096,14 +1094,14 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
       if(random <= precipboundaryfraction)
       {
         // figure out if we want this to be a boundary centroid voxel or not for the proposed precipitate
-        if(m_AvailablePointsCount > 0)
+        if(availablePoints.size() > 0)
         {
-          key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-          featureOwnersIdx = availablePointsInv[key];
+          key = static_cast<size_t>(rg.genrand_res53() * (availablePoints.size() - 1));
+          featureOwnersIdx = availablePoints.at(key);
           while(m_BoundaryCells[featureOwnersIdx] == 0)
           {
-            key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-            featureOwnersIdx = availablePointsInv[key];
+            key = static_cast<size_t>(rg.genrand_res53() * (availablePoints.size() - 1));
+            featureOwnersIdx = availablePoints.at(key);
           }
         }
         else
@@ -1117,14 +1115,14 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
       }
       else if(random > precipboundaryfraction)
       {
-        if(m_AvailablePointsCount > 0)
+        if(availablePoints.size() > 0)
         {
-          key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-          featureOwnersIdx = availablePointsInv[key];
+          key = static_cast<size_t>(rg.genrand_res53() * (availablePoints.size() - 1));
+          featureOwnersIdx = availablePoints.at(key);
           while(m_BoundaryCells[featureOwnersIdx] != 0)
           {
-            key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-            featureOwnersIdx = availablePointsInv[key];
+            key = static_cast<size_t>(rg.genrand_res53() * (availablePoints.size() - 1));
+            featureOwnersIdx = availablePoints.at(key);
           }
         }
         else
@@ -1147,10 +1145,10 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
         notifyWarningMessage(getHumanLabel(), msg, -5010);
       }
 
-      if(m_AvailablePointsCount > 0)
+      if(availablePoints.size() > 0)
       {
-        key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-        featureOwnersIdx = availablePointsInv[key];
+        key = static_cast<size_t>(rg.genrand_res53() * (availablePoints.size() - 1));
+        featureOwnersIdx = availablePoints.at(key);
       }
       else
       {
@@ -1169,7 +1167,7 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
     m_Centroids[3 * i + 2] = zc;
     insert_precipitate(i);
     update_exclusionZones(i, -1000, exclusionZonesPtr);
-    update_availablepoints(availablePoints, availablePointsInv);
+    update_availablepoints(availablePoints);
   }
 
   notifyStatusMessage(getHumanLabel(), "Packing Features - Initial Feature Placement Complete");
@@ -1227,6 +1225,8 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
   if(m_MatchRDF == true)
   {
     // calculate the initial current RDF - this will change as we move particles around
+    build_precipitateGrid();
+    m_RdfCurrentDistNorm = normalizeRDF(m_RdfCurrentDist, m_numRDFbins, m_StepSize, m_rdfMin, 0);
     for(size_t i = size_t(m_FirstPrecipitateFeature); i < numfeatures; i++)
     {
       m_oldRDFerror = check_RDFerror(int32_t(i), -1000, false);
@@ -1283,14 +1283,14 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
           if(random <= precipboundaryfraction)
           {
             // figure out if we want this to be a boundary centroid voxel or not for the proposed precipitate
-            if(m_AvailablePointsCount > 0)
+            if(availablePoints.size() > 0)
             {
-              key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-              featureOwnersIdx = availablePointsInv[key];
+              key = static_cast<size_t>(rg.genrand_res53() * (availablePoints.size() - 1));
+              featureOwnersIdx = availablePoints.at(key);
               while(m_BoundaryCells[featureOwnersIdx] == 0)
               {
-                key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-                featureOwnersIdx = availablePointsInv[key];
+                key = static_cast<size_t>(rg.genrand_res53() * (availablePoints.size() - 1));
+                featureOwnersIdx = availablePoints.at(key);
               }
             }
             else
@@ -1304,14 +1304,14 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
           }
           else if(random > precipboundaryfraction)
           {
-            if(m_AvailablePointsCount > 0)
+            if(availablePoints.size() > 0)
             {
-              key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-              featureOwnersIdx = availablePointsInv[key];
+              key = static_cast<size_t>(rg.genrand_res53() * (availablePoints.size() - 1));
+              featureOwnersIdx = availablePoints.at(key);
               while(m_BoundaryCells[featureOwnersIdx] != 0)
               {
-                key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-                featureOwnersIdx = availablePointsInv[key];
+                key = static_cast<size_t>(rg.genrand_res53() * (availablePoints.size() - 1));
+                featureOwnersIdx = availablePoints.at(key);
               }
             }
             else
@@ -1334,10 +1334,10 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
             notifyWarningMessage(getHumanLabel(), msg, -5010);
           }
 
-          if(m_AvailablePointsCount > 0)
+          if(availablePoints.size() > 0)
           {
-            key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-            featureOwnersIdx = availablePointsInv[key];
+            key = static_cast<size_t>(rg.genrand_res53() * (availablePoints.size() - 1));
+            featureOwnersIdx = availablePoints.at(key);
           }
           else
           {
@@ -1361,7 +1361,7 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
         if(m_currentRDFerror >= m_oldRDFerror)
         {
           m_oldRDFerror = m_currentRDFerror;
-          update_availablepoints(availablePoints, availablePointsInv);
+          update_availablepoints(availablePoints);
           acceptedmoves++;
         }
         else
@@ -1564,6 +1564,10 @@ void InsertPrecipitatePhases::move_precipitate(int32_t gnum, float xc, float yc,
   m_Centroids[3 * gnum] = xc;
   m_Centroids[3 * gnum + 1] = yc;
   m_Centroids[3 * gnum + 2] = zc;
+  if(!m_PrecipitateGrid.isEmpty())
+  {
+    m_PrecipitateGrid.update(gnum, m_Centroids + 3 * gnum);
+  }
   size_t size = m_ColumnList[gnum].size();
 
   for(size_t i = 0; i < size; i++)
@@ -1762,32 +1766,17 @@ void InsertPrecipitatePhases::update_exclusionZones(int32_t gadd, int32_t gremov
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void InsertPrecipitatePhases::update_availablepoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv)
+void InsertPrecipitatePhases::update_availablepoints(AvailablePoints& availablePoints)
 {
   size_t removeSize = m_PointsToRemove.size();
   size_t addSize = m_PointsToAdd.size();
-  size_t featureOwnersIdx = 0;
-  size_t key = 0, val = 0;
   for(size_t i = 0; i < addSize; i++)
   {
-    featureOwnersIdx = m_PointsToAdd[i];
-    availablePoints[featureOwnersIdx] = m_AvailablePointsCount;
-    availablePointsInv[m_AvailablePointsCount] = featureOwnersIdx;
-    m_AvailablePointsCount++;
+    availablePoints.insert(m_PointsToAdd[i]);
   }
   for(size_t i = 0; i < removeSize; i++)
   {
-    featureOwnersIdx = m_PointsToRemove[i];
-    key = availablePoints[featureOwnersIdx];
-    //  availablePoints.erase(featureOwnersIdx);
-    val = availablePointsInv[m_AvailablePointsCount - 1];
-    //  availablePointsInv.erase(availablePointsCount-1);
-    if(key < m_AvailablePointsCount - 1)
-    {
-      availablePointsInv[key] = val;
-      availablePoints[val] = key;
-    }
-    m_AvailablePointsCount--;
+    availablePoints.remove(m_PointsToRemove[i]);
   }
   m_PointsToRemove.clear();
   m_PointsToAdd.clear();
@@ -1798,59 +1787,26 @@ void InsertPrecipitatePhases::update_availablepoints(std::map<size_t, size_t>& a
 // -----------------------------------------------------------------------------
 void InsertPrecipitatePhases::determine_currentRDF(int32_t gnum, int32_t add, bool double_count)
 {
-  float x = 0.0f, y = 0.0f, z = 0.0f;
-  float xn = 0.0f, yn = 0.0f, zn = 0.0f;
-  float r = 0.0f;
-
-  size_t iter = 0;
-  int32_t numPPTfeatures = 1;
-  int32_t rdfBin = 0;
-
-  int32_t phase = m_FeaturePhases[gnum];
-  while(phase != m_PrecipitatePhases[iter])
-  {
-    iter++;
-  }
+  // Only the bins up to the maximum distance of the target RDF are compared, and the grid cells are at least that
+  // large, so only the precipitates in the 27 cells around this one can land in a compared bin
+  float increment = (double_count == true) ? float(2 * add) : float(add);
+  m_PrecipitateGrid.accumulateRDF(gnum, m_Centroids, m_FeaturePhases, m_rdfMin, m_StepSize, m_numRDFbins, increment, m_RdfRandom, m_RdfCurrentDist, m_RdfCurrentDistNorm);
+}
 
-  x = m_Centroids[3 * gnum];
-  y = m_Centroids[3 * gnum + 1];
-  z = m_Centroids[3 * gnum + 2];
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void InsertPrecipitatePhases::build_precipitateGrid()
+{
+  // Pad the cutoff by one bin so that rounding in the bin computation can not miss a pair
+  float cutoff = m_rdfMax + m_StepSize;
+  float boxSize[3] = {m_SizeX, m_SizeY, m_SizeZ};
   size_t numFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
-
+  m_PrecipitateGrid.initialize(boxSize, cutoff, numFeatures);
   for(size_t n = size_t(m_FirstPrecipitateFeature); n < numFeatures; n++)
   {
-    if(m_FeaturePhases[n] == phase && n != gnum)
-    {
-      xn = m_Centroids[3 * n];
-      yn = m_Centroids[3 * n + 1];
-      zn = m_Centroids[3 * n + 2];
-      r = sqrtf((x - xn) * (x - xn) + (y - yn) * (y - yn) + (z - zn) * (z - zn));
-
-      rdfBin = (r - m_rdfMin) / m_StepSize;
-
-      if(r < m_rdfMin)
-      {
-        rdfBin = -1;
-      }
-      // if (r < 6.0)
-      //{
-      //  int stop = 0;
-      //}
-      // if (rdfBin >= m_numRDFbins) {rdfBin = m_numRDFbins;}
-      if(double_count == true)
-      {
-        m_RdfCurrentDist[rdfBin + 1] += 2 * add;
-      }
-      else if(double_count == false)
-      {
-        m_RdfCurrentDist[rdfBin + 1] += add;
-      }
-
-      numPPTfeatures += 1;
-    }
+    m_PrecipitateGrid.update(static_cast<int32_t>(n), m_Centroids + 3 * n);
   }
-
-  m_RdfCurrentDistNorm = normalizeRDF(m_RdfCurrentDist, m_numRDFbins, m_StepSize, m_rdfMin, numPPTfeatures);
 }
 
 // -----------------------------------------------------------------------------
@@ -1965,18 +1921,12 @@ float InsertPrecipitatePhases::check_RDFerror(int32_t gadd, int32_t gremove, boo
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void InsertPrecipitatePhases::compare_1Ddistributions(std::vector<float> array1, std::vector<float> array2, float& bhattdist)
+void InsertPrecipitatePhases::compare_1Ddistributions(const std::vector<float>& array1, const std::vector<float>& array2, float& bhattdist)
 {
   bhattdist = 0;
   float sum_array1 = 0.0f;
   float sum_array2 = 0.0f;
 
-  //  for (std::vector<float>::iterator j=array1.begin(); j!=array1.end(); j++)
-  //  {sum_array1 += *j;}
-
-  //  for (std::vector<float>::iterator j=array2.begin(); j!=array2.end(); j++)
-  //  {sum_array2 += *j;}
-
   size_t array1Size = array1.size();
   for(size_t i = 0; i < array1Size; i++)
   {
@@ -1984,18 +1934,19 @@ void InsertPrecipitatePhases::compare_1Ddistributions(std::vector<float> array1,
     sum_array2 = sum_array2 + array2[i];
   }
 
+  // Normalize on the fly instead of in copies of the arrays
   for(size_t i = 0; i < array1Size; i++)
   {
-    array1[i] = array1[i] / sum_array1;
-    array2[i] = array2[i] / sum_array2;
-    bhattdist = bhattdist + sqrtf((array1[i] * array2[i]));
+    float value1 = array1[i] / sum_array1;
+    float value2 = array2[i] / sum_array2;
+    bhattdist = bhattdist + sqrtf((value1 * value2));
   }
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void InsertPrecipitatePhases::compare_2Ddistributions(std::vector<std::vector<float>> array1, std::vector<std::vector<float>> array2, float& bhattdist)
+void InsertPrecipitatePhases::compare_2Ddistributions(const std::vector<std::vector<float>>& array1, const std::vector<std::vector<float>>& array2, float& bhattdist)
 {
   bhattdist = 0;
   size_t array1Size = array1.size();
@@ -2012,36 +1963,26 @@ void InsertPrecipitatePhases::compare_2Ddistributions(std::vector<std::vector<fl
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void InsertPrecipitatePhases::compare_3Ddistributions(std::vector<std::vector<std::vector<float>>> array1, std::vector<std::vector<std::vector<float>>> array2, float& bhattdist)
+void InsertPrecipitatePhases::compare_3Ddistributions(const std::vector<std::vector<std::vector<float>>>& array1, const std::vector<std::vector<std::vector<float>>>& array2, float& bhattdist)
 {
   bhattdist = 0;
-  std::vector<std::vector<float>> counts1(array1.size());
-  std::vector<std::vector<float>> counts2(array2.size());
   size_t array1Size = array1.size();
   for(size_t i = 0; i < array1Size; i++)
   {
-    counts1[i].resize(array1[i].size());
-    counts2[i].resize(array2[i].size());
     size_t array2Size = array1[i].size();
     for(size_t j = 0; j < array2Size; j++)
     {
+      float count1 = 0.0f;
+      float count2 = 0.0f;
       size_t array3Size = array1[i][j].size();
       for(size_t k = 0; k < array3Size; k++)
       {
-        counts1[i][j] += array1[i][j][k];
-        counts2[i][j] += array2[i][j][k];
+        count1 += array1[i][j][k];
+        count2 += array2[i][j][k];
       }
-    }
-  }
-  for(size_t i = 0; i < array1Size; i++)
-  {
-    size_t array2Size = array1[i].size();
-    for(size_t j = 0; j < array2Size; j++)
-    {
-      size_t array3Size = array1[i][j].size();
       for(size_t k = 0; k < array3Size; k++)
       {
-        bhattdist = bhattdist + sqrtf(((array1[i][j][k] / counts1[i][j]) * (array2[i][j][k] / counts2[i][j])));
+        bhattdist = bhattdist + sqrtf(((array1[i][j][k] / count1) * (array2[i][j][k] / count2)));
       }
     }
   }
@@ -2052,89 +1993,52 @@ void InsertPrecipitatePhases::compare_3Ddistributions(std::vector<std::vector<st
 // -----------------------------------------------------------------------------
 float InsertPrecipitatePhases::check_sizedisterror(Precip_t* precip)
 {
-  // DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
+  float sizedisterror = 0;
 
+  // The precipitates that are already packed stay binned, so only the bin of the new precipitate changes
+  update_sizedist(precip, 1);
+  size_t numPhases = m_SimFeatureSizeDist.size();
+  for(size_t iter = 0; iter < numPhases; ++iter)
+  {
+    sizedisterror = sizedisterror + m_SimFeatureSizeDist[iter].bhattacharyyaDistance();
+  }
+  update_sizedist(precip, -1);
+  return sizedisterror;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void InsertPrecipitatePhases::update_sizedist(Precip_t* precip, int32_t increment)
+{
   StatsDataArray& statsDataArray = *(m_StatsDataArray.lock());
 
-  float dia;
-  float sizedisterror = 0;
-  float bhattdist;
-  int index;
-  int count = 0;
-  int phase;
-  size_t featureSizeDist_Size = m_FeatureSizeDist.size();
-  for(size_t iter = 0; iter < featureSizeDist_Size; ++iter)
-  {
-    phase = m_PrecipitatePhases[iter];
-    PrecipitateStatsData* pp = PrecipitateStatsData::SafePointerDownCast(statsDataArray[phase].get());
-    count = 0;
-    std::vector<float>& curFeatureSizeDist = m_FeatureSizeDist[iter];
-    std::vector<float>::size_type curFeatureSizeDistSize = curFeatureSizeDist.size();
-    std::vector<float>& curSimFeatureSizeDist = m_SimFeatureSizeDist[iter];
-    // Initialize all Values to Zero
-    for(size_t i = 0; i < curFeatureSizeDistSize; i++)
+  size_t numPhases = m_SimFeatureSizeDist.size();
+  for(size_t iter = 0; iter < numPhases; ++iter)
+  {
+    int32_t phase = m_PrecipitatePhases[iter];
+    if(precip->m_FeaturePhases != phase)
     {
-      curSimFeatureSizeDist[i] = 0.0f;
+      continue;
     }
-
-    size_t nFeatureTuples = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
+    PrecipitateStatsData* pp = PrecipitateStatsData::SafePointerDownCast(statsDataArray[phase].get());
+    PackingDistribution& curSimFeatureSizeDist = m_SimFeatureSizeDist[iter];
+    float curFeatureSizeDistSize = static_cast<float>(curSimFeatureSizeDist.getNumColumns());
     float oneOverCurFeatureSizeDistStep = 1.0f / m_FeatureSizeDistStep[iter];
     float halfMinFeatureDiameter = pp->getMinFeatureDiameter() * 0.5f;
-    for(size_t b = m_FirstPrecipitateFeature; b < nFeatureTuples; b++)
-    {
-      index = b;
-      if(m_FeaturePhases[index] == phase)
-      {
-        dia = m_EquivalentDiameters[index];
-        dia = (dia - halfMinFeatureDiameter) * oneOverCurFeatureSizeDistStep;
-        if(dia < 0)
-        {
-          dia = 0;
-        }
-        if(dia > curFeatureSizeDistSize - 1.0f)
-        {
-          dia = curFeatureSizeDistSize - 1.0f;
-        }
-        curSimFeatureSizeDist[int(dia)]++;
-        count++;
-      }
-    }
 
-    if(precip->m_FeaturePhases == phase)
+    float dia = precip->m_EquivalentDiameters;
+    dia = (dia - halfMinFeatureDiameter) * oneOverCurFeatureSizeDistStep;
+    if(dia < 0)
     {
-      dia = precip->m_EquivalentDiameters;
-      dia = (dia - halfMinFeatureDiameter) * oneOverCurFeatureSizeDistStep;
-      if(dia < 0)
-      {
-        dia = 0;
-      }
-      if(dia > curFeatureSizeDistSize - 1.0f)
-      {
-        dia = curFeatureSizeDistSize - 1.0f;
-      }
-      curSimFeatureSizeDist[int(dia)]++;
-      count++;
-    }
-    float oneOverCount = 1.0f / count;
-
-    if(count == 0)
-    {
-      for(size_t i = 0; i < curFeatureSizeDistSize; i++)
-      {
-        curSimFeatureSizeDist[i] = 0.0;
-      }
+      dia = 0;
     }
-    else
+    if(dia > curFeatureSizeDistSize - 1.0f)
     {
-      for(size_t i = 0; i < curFeatureSizeDistSize; i++)
-      {
-        curSimFeatureSizeDist[i] = curSimFeatureSizeDist[i] * oneOverCount;
-      }
+      dia = curFeatureSizeDistSize - 1.0f;
     }
+    curSimFeatureSizeDist.add(static_cast<size_t>(dia), increment);
   }
-  compare_2Ddistributions(m_SimFeatureSizeDist, m_FeatureSizeDist, bhattdist);
-  sizedisterror = bhattdist;
-  return sizedisterror;
 }
 
 // -----------------------------------------------------------------------------
@@ -49,6 +49,11 @@
 #include "OrientationLib/LaueOps/LaueOps.h"
 #include "OrientationLib/LaueOps/OrthoRhombicOps.h"
 
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/PackingDistribution.hpp"
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/PrecipitateGrid.hpp"
+
+class AvailablePoints;
+
 typedef struct
 {
   float m_Volumes;
@@ -292,6 +297,13 @@ class InsertPrecipitatePhases : public AbstractFilter
      */
     float check_sizedisterror(Precip_t* precip);
 
+    /**
+     * @brief update_sizedist Adds a precipitate to or removes it from the current precipitate size distribution
+     * @param precip Precip_t struct pointer to be binned
+     * @param increment 1 to add the precipitate, -1 to remove it
+     */
+    void update_sizedist(Precip_t* precip, int32_t increment);
+
     /**
      * @brief update_exclusionZones Updates the exclusion owners pointer based on the associated incoming Ids
      * @param gadd Index used to determine which precipitate to add
@@ -308,11 +320,10 @@ class InsertPrecipitatePhases : public AbstractFilter
 //    bool check_for_overlap(size_t gNum, Int32ArrayType::Pointer exlusionZonesPtr);
 
     /**
-     * @brief update_availablepoints Updates the maps used to associate packing points with an "available" state
-     * @param availablePoints Map between precipitate owners and number of available points
-     * @param availablePointsInv Inverse associations for the availablePoints map
+     * @brief update_availablepoints Updates the set of packing points with an "available" state
+     * @param availablePoints Set of the packing points that are not in an exclusion zone
      */
-    void update_availablepoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv);
+    void update_availablepoints(AvailablePoints& availablePoints);
 
     /**
      * @brief determine_currentRDF Determines the radial distribution function about a given precipitate
@@ -353,6 +364,13 @@ class InsertPrecipitatePhases : public AbstractFilter
      */
     float check_RDFerror(int32_t gadd, int32_t gremove, bool double_count);
 
+    /**
+     * @brief build_precipitateGrid Sorts the precipitate centroids into a uniform grid of cells that are at least
+     * as large as the maximum distance of the target radial distribution function, so that the radial distribution
+     * function of a precipitate only needs to visit the precipitates in the surrounding cells
+     */
+    void build_precipitateGrid();
+
     /**
      * @brief assign_voxels Assigns precipitate Id values to voxels within the packing grid
      */
@@ -393,19 +411,19 @@ class InsertPrecipitatePhases : public AbstractFilter
      * @brief compare_1Ddistributions Computes the 1D Bhattacharyya distance
      * @param sqrerror Float 1D Bhattacharyya distance
      */
-    void compare_1Ddistributions(std::vector<float>, std::vector<float>, float& sqrerror);
+    void compare_1Ddistributions(const std::vector<float>&, const std::vector<float>&, float& sqrerror);
 
     /**
      * @brief compare_2Ddistributions Computes the 2D Bhattacharyya distance
      * @param sqrerror Float 1D Bhattacharyya distance
      */
-    void compare_2Ddistributions(std::vector<std::vector<float> >, std::vector<std::vector<float> >, float& sqrerror);
+    void compare_2Ddistributions(const std::vector<std::vector<float> >&, const std::vector<std::vector<float> >&, float& sqrerror);
 
     /**
      * @brief compare_3Ddistributions Computes the 3D Bhattacharyya distance
      * @param sqrerror Float 1D Bhattacharyya distance
      */
-    void compare_3Ddistributions(std::vector<std::vector<std::vector<float> > >, std::vector<std::vector<std::vector<float> > >, float& sqrerror);
+    void compare_3Ddistributions(const std::vector<std::vector<std::vector<float> > >&, const std::vector<std::vector<std::vector<float> > >&, float& sqrerror);
 
 
   private:
@@ -466,8 +484,7 @@ class InsertPrecipitatePhases : public AbstractFilter
 
     uint64_t m_Seed;
 
-    std::vector<std::vector<float> > m_FeatureSizeDist;
-    std::vector<std::vector<float> > m_SimFeatureSizeDist;
+    std::vector<PackingDistribution> m_SimFeatureSizeDist;
     std::vector<float> m_RdfTargetDist;
     std::vector<float> m_RdfCurrentDist;
     std::vector<float> m_RdfCurrentDistNorm;
@@ -479,7 +496,6 @@ class InsertPrecipitatePhases : public AbstractFilter
 
     std::vector<int64_t> m_GSizes;
 
-    size_t m_AvailablePointsCount;
     float m_currentRDFerror, m_oldRDFerror;
     float m_CurrentSizeDistError, m_OldSizeDistError;
     float m_rdfMax;
@@ -487,6 +503,8 @@ class InsertPrecipitatePhases : public AbstractFilter
     float m_StepSize;
     int32_t m_numRDFbins;
 
+    PrecipitateGrid m_PrecipitateGrid;
+
 
     std::vector<int32_t> m_PrecipitatePhases;
     std::vector<float> m_PrecipitatePhaseFractions;
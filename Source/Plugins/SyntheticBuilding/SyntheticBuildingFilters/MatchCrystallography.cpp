@@ -35,6 +35,13 @@
 
 #include "MatchCrystallography.h"
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -58,6 +65,50 @@
 
 #include "EbsdLib/EbsdConstants.h"
 
+/**
+ * @brief The MatchCrystallographySwapsImpl class evaluates a batch of orientation swaps and switches. Evaluating
+ * a swap only reads the current orientations, so the swaps of a batch are independent of each other
+ */
+class MatchCrystallographySwapsImpl
+{
+  MatchCrystallography* m_Filter;
+  OrientationSwap_t* m_Swaps;
+  size_t m_Ensem;
+
+public:
+  MatchCrystallographySwapsImpl(MatchCrystallography* filter, OrientationSwap_t* swaps, size_t ensem)
+  : m_Filter(filter)
+  , m_Swaps(swaps)
+  , m_Ensem(ensem)
+  {
+  }
+
+  virtual ~MatchCrystallographySwapsImpl()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t s = start; s < end; s++)
+    {
+      if(m_Swaps[s].m_Features[0] > 0)
+      {
+        m_Filter->evaluate_swap(m_Swaps[s], m_Ensem);
+      }
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+};
+
 // Include the MOC generated file for this class
 #include "moc_MatchCrystallography.cpp"
 
@@ -82,6 +133,8 @@ MatchCrystallography::MatchCrystallography()
 , m_FeatureEulerAnglesArrayName(SIMPL::FeatureData::EulerAngles)
 , m_AvgQuatsArrayName(SIMPL::FeatureData::AvgQuats)
 , m_MaxIterations(1)
+, m_UseFixedSeed(false)
+, m_FixedSeed(0)
 , m_FeatureIds(nullptr)
 , m_CellEulerAngles(nullptr)
 , m_SurfaceFeatures(nullptr)
@@ -99,6 +152,7 @@ MatchCrystallography::MatchCrystallography()
   m_StatsDataArray = StatsDataArray::NullPointer();
 
   m_MdfChange = m_OdfChange = 0.0f;
+  m_OdfError = m_MdfError = 0.0;
 
   m_ActualOdf = FloatArrayType::NullPointer();
   m_SimOdf = FloatArrayType::NullPointer();
@@ -227,6 +281,7 @@ void MatchCrystallography::initialize()
   m_StatsDataArray = StatsDataArray::NullPointer();
 
   m_MdfChange = m_OdfChange = 0.0f;
+  m_OdfError = m_MdfError = 0.0;
   m_UnbiasedVolume.clear();
   m_TotalSurfaceArea.clear();
 
@@ -234,7 +289,12 @@ void MatchCrystallography::initialize()
   m_SimOdf = FloatArrayType::NullPointer();
   m_ActualMdf = FloatArrayType::NullPointer();
   m_SimMdf = FloatArrayType::NullPointer();
-  m_MisorientationLists.clear();
+  m_BoundaryOffsets.clear();
+  m_BoundaryNeighbors.clear();
+  m_BoundaryReverse.clear();
+  m_BoundaryWeights.clear();
+  m_BoundaryMisoBins.clear();
+  m_Swaps.clear();
 
   m_OrientationOps = LaueOps::getOrientationOpsQVector();
 }
@@ -397,6 +457,8 @@ void MatchCrystallography::execute()
     return;
   }
 
+  initialize_boundaries();
+
   m_SyntheticCrystalStructures[0] = m_CrystalStructures[0];
   for(size_t i = 1; i < totalEnsembles; ++i)
   {
@@ -586,7 +648,7 @@ void MatchCrystallography::determine_boundary_areas()
 // -----------------------------------------------------------------------------
 void MatchCrystallography::assign_eulers(size_t ensem)
 {
-  uint64_t m_Seed = QDateTime::currentMSecsSinceEpoch();
+  uint64_t m_Seed = (m_UseFixedSeed == true) ? static_cast<uint64_t>(m_FixedSeed) : QDateTime::currentMSecsSinceEpoch();
   SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
 
   int32_t numbins = 0;
@@ -629,7 +691,7 @@ void MatchCrystallography::assign_eulers(size_t ensem)
       choose = pick_euler(random, numbins);
 
       FOrientArrayType eulers = m_OrientationOps[m_CrystalStructures[ensem]]->determineEulerAngles(m_Seed, choose);
-      eulers = m_OrientationOps[m_CrystalStructures[ensem]]->randomizeEulerAngles(eulers);
+      eulers = randomize_euler_angles(eulers, m_CrystalStructures[ensem], static_cast<float>(rg.genrand_res53()));
       m_FeatureEulerAngles[3 * i] = eulers[0];
       m_FeatureEulerAngles[3 * i + 1] = eulers[1];
       m_FeatureEulerAngles[3 * i + 2] = eulers[2];
@@ -670,83 +732,295 @@ int32_t MatchCrystallography::pick_euler(float random, int32_t numbins)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void MatchCrystallography::MC_LoopBody1(int32_t feature, size_t ensem, size_t j, float neighsurfarea, uint32_t sym, QuatF& q1, QuatF& q2)
+FOrientArrayType MatchCrystallography::randomize_euler_angles(FOrientArrayType eulers, uint32_t sym, float random)
 {
-  float w = 0.0f;
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  float curmiso1 = 0.0f, curmiso2 = 0.0f, curmiso3 = 0.0f;
-  size_t curmisobin = 0, newmisobin = 0;
+  int32_t numSymOps = m_OrientationOps[sym]->getNumSymOps();
+  int32_t symOp = static_cast<int32_t>(random * numSymOps);
+  if(symOp >= numSymOps)
+  {
+    symOp = numSymOps - 1;
+  }
+  QuatF symQuat;
+  m_OrientationOps[sym]->getQuatSymOp(symOp, symQuat);
+
+  FOrientArrayType quat(4, 0.0f);
+  FOrientTransformsType::eu2qu(eulers, quat);
+  QuatF q = quat.toQuaternion();
+  QuatF qc;
+  QuaternionMathF::Multiply(symQuat, q, qc);
+  quat.fromQuaternion(qc);
+  FOrientTransformsType::qu2eu(quat, eulers);
+  return eulers;
+}
 
-  curmiso1 = m_MisorientationLists[feature][3 * j];
-  curmiso2 = m_MisorientationLists[feature][3 * j + 1];
-  curmiso3 = m_MisorientationLists[feature][3 * j + 2];
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MatchCrystallography::initialize_boundaries()
+{
+  NeighborList<int32_t>& neighborlist = *(m_NeighborList.lock());
+  NeighborList<float>& neighborsurfacearealist = *(m_SharedSurfaceAreaList.lock());
+  size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
 
-  FOrientArrayType rod(curmiso1, curmiso2, curmiso3, 0.0f);
-  float mag = sqrt(curmiso1 * curmiso1 + curmiso2 * curmiso2 + curmiso3 * curmiso3);
-  if(mag == 0.0f)
+  m_BoundaryOffsets.assign(totalFeatures + 1, 0);
+  for(size_t i = 0; i < totalFeatures; i++)
   {
-    rod[3] = std::numeric_limits<float>::infinity();
+    m_BoundaryOffsets[i + 1] = m_BoundaryOffsets[i] + neighborlist[i].size();
   }
-  else
+  size_t numBoundaries = m_BoundaryOffsets[totalFeatures];
+  m_BoundaryNeighbors.assign(numBoundaries, -1);
+  m_BoundaryReverse.assign(numBoundaries, std::numeric_limits<size_t>::max());
+  m_BoundaryWeights.assign(numBoundaries, 0.0f);
+  m_BoundaryMisoBins.assign(numBoundaries, -1);
+
+  for(size_t i = 1; i < totalFeatures; i++)
   {
-    rod[3] = mag;
-    rod[0] = rod[0] / rod[3];
-    rod[1] = rod[1] / rod[3];
-    rod[2] = rod[2] / rod[3];
+    // Features without a shared surface area for every neighbor keep no boundaries, as before
+    if(neighborsurfacearealist[i].size() != neighborlist[i].size())
+    {
+      continue;
+    }
+    size_t first = m_BoundaryOffsets[i];
+    for(size_t j = 0; j < neighborlist[i].size(); j++)
+    {
+      m_BoundaryNeighbors[first + j] = neighborlist[i][j];
+      m_BoundaryWeights[first + j] = neighborsurfacearealist[i][j] / m_TotalSurfaceArea[m_FeaturePhases[i]];
+    }
   }
 
-  curmisobin = m_OrientationOps[sym]->getMisoBin(rod);
-  w = m_OrientationOps[sym]->getMisoQuat(q1, q2, n1, n2, n3);
-
-  FOrientTransformsType::ax2ro(FOrientArrayType(n1, n2, n3, w), rod);
-  newmisobin = m_OrientationOps[sym]->getMisoBin(rod);
-  m_MdfChange = m_MdfChange + (((m_ActualMdf->getValue(curmisobin) - m_SimMdf->getValue(curmisobin)) * (m_ActualMdf->getValue(curmisobin) - m_SimMdf->getValue(curmisobin))) -
-                               ((m_ActualMdf->getValue(curmisobin) - (m_SimMdf->getValue(curmisobin) - (neighsurfarea / m_TotalSurfaceArea[ensem]))) *
-                                (m_ActualMdf->getValue(curmisobin) - (m_SimMdf->getValue(curmisobin) - (neighsurfarea / m_TotalSurfaceArea[ensem])))));
-  m_MdfChange = m_MdfChange + (((m_ActualMdf->getValue(newmisobin) - m_SimMdf->getValue(newmisobin)) * (m_ActualMdf->getValue(newmisobin) - m_SimMdf->getValue(newmisobin))) -
-                               ((m_ActualMdf->getValue(newmisobin) - (m_SimMdf->getValue(newmisobin) + (neighsurfarea / m_TotalSurfaceArea[ensem]))) *
-                                (m_ActualMdf->getValue(newmisobin) - (m_SimMdf->getValue(newmisobin) + (neighsurfarea / m_TotalSurfaceArea[ensem])))));
+  // Link the entry of a boundary in one Feature's list to the entry in the neighbor's list, so that both
+  // Features see the misorientation bin of the boundary change
+  for(size_t i = 1; i < totalFeatures; i++)
+  {
+    for(size_t b = m_BoundaryOffsets[i]; b < m_BoundaryOffsets[i + 1]; b++)
+    {
+      int32_t nname = m_BoundaryNeighbors[b];
+      if(nname <= 0 || static_cast<size_t>(nname) >= totalFeatures)
+      {
+        continue;
+      }
+      for(size_t c = m_BoundaryOffsets[nname]; c < m_BoundaryOffsets[nname + 1]; c++)
+      {
+        if(m_BoundaryNeighbors[c] == static_cast<int32_t>(i))
+        {
+          m_BoundaryReverse[b] = c;
+          break;
+        }
+      }
+    }
+  }
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void MatchCrystallography::MC_LoopBody2(int32_t feature, size_t ensem, size_t j, float neighsurfarea, uint32_t sym, QuatF& q1, QuatF& q2)
+void MatchCrystallography::evaluate_swap(OrientationSwap_t& swap, size_t ensem)
 {
-  float w = 0.0f;
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  float curmiso1 = 0.0f, curmiso2 = 0.0f, curmiso3 = 0.0f;
-  size_t curmisobin = 0, newmisobin = 0;
-  float miso1 = 0.0f, miso2 = 0.0f, miso3 = 0.0f;
+  uint32_t sym = m_CrystalStructures[ensem];
+  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
+  int32_t numFeatures = (swap.m_Features[1] > 0) ? 2 : 1;
 
-  curmiso1 = m_MisorientationLists[feature][3 * j];
-  curmiso2 = m_MisorientationLists[feature][3 * j + 1];
-  curmiso3 = m_MisorientationLists[feature][3 * j + 2];
+  // Switching gives each Feature the current orientation of the other one
+  if(numFeatures == 2)
+  {
+    for(int32_t k = 0; k < 2; k++)
+    {
+      int32_t other = swap.m_Features[1 - k];
+      swap.m_Eulers[3 * k] = m_FeatureEulerAngles[3 * other];
+      swap.m_Eulers[3 * k + 1] = m_FeatureEulerAngles[3 * other + 1];
+      swap.m_Eulers[3 * k + 2] = m_FeatureEulerAngles[3 * other + 2];
+      QuaternionMathF::Copy(avgQuats[other], swap.m_Quats[k]);
+    }
+  }
 
-  FOrientArrayType rod(curmiso1, curmiso2, curmiso3, 0.0f);
-  float mag = sqrt(curmiso1 * curmiso1 + curmiso2 * curmiso2 + curmiso3 * curmiso3);
-  if(mag == 0.0f)
+  FOrientArrayType rod(4, 0.0f);
+  FOrientArrayType ax(4, 0.0f);
+  size_t entry = swap.m_BoundaryStart;
+  for(int32_t k = 0; k < numFeatures; k++)
   {
-    rod[3] = std::numeric_limits<float>::infinity();
+    int32_t feature = swap.m_Features[k];
+    FOrientTransformsType::eu2ro(FOrientArrayType(&(m_FeatureEulerAngles[3 * feature]), 3), rod);
+    swap.m_OdfBins[k] = m_OrientationOps[sym]->getOdfBin(rod);
+
+    // Gather the boundaries that change, leaving out the boundary between two switched Features
+    size_t count = 0;
+    for(size_t b = m_BoundaryOffsets[feature]; b < m_BoundaryOffsets[feature + 1]; b++)
+    {
+      int32_t neighbor = m_BoundaryNeighbors[b];
+      if(m_BoundaryMisoBins[b] < 0 || (numFeatures == 2 && neighbor == swap.m_Features[1 - k]))
+      {
+        continue;
+      }
+      m_SwapBoundaries[entry + count] = b;
+      QuaternionMathF::Copy(swap.m_Quats[k], m_SwapQuats1[entry + count]);
+      QuaternionMathF::Copy(avgQuats[neighbor], m_SwapQuats2[entry + count]);
+      count++;
+    }
+    swap.m_NumBoundaries[k] = count;
+
+    if(count == 0)
+    {
+      continue;
+    }
+    size_t numEntries = m_SwapAngles.size();
+    m_OrientationOps[sym]->getMisoQuats(&(m_SwapQuats1[entry]), &(m_SwapQuats2[entry]), count, &(m_SwapAngles[entry]), &(m_SwapAxes[entry]), &(m_SwapAxes[numEntries + entry]),
+                                        &(m_SwapAxes[2 * numEntries + entry]));
+    for(size_t e = entry; e < entry + count; e++)
+    {
+      ax[0] = m_SwapAxes[e];
+      ax[1] = m_SwapAxes[numEntries + e];
+      ax[2] = m_SwapAxes[2 * numEntries + e];
+      ax[3] = m_SwapAngles[e];
+      FOrientTransformsType::ax2ro(ax, rod);
+      m_SwapMisoBins[e] = m_OrientationOps[sym]->getMisoBin(rod);
+    }
+    entry = entry + count;
   }
-  else
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float MatchCrystallography::swap_error_change(const OrientationSwap_t& swap, size_t ensem)
+{
+  float* actualOdf = m_ActualOdf->getPointer(0);
+  float* simOdf = m_SimOdf->getPointer(0);
+  float* actualMdf = m_ActualMdf->getPointer(0);
+  float* simMdf = m_SimMdf->getPointer(0);
+  int32_t feature1 = swap.m_Features[0];
+  int32_t feature2 = swap.m_Features[1];
+  float vol1 = m_Volumes[feature1] / m_UnbiasedVolume[ensem];
+
+  if(feature2 <= 0) // SwapOutOrientation
+  {
+    int32_t choose = swap.m_Choose;
+    int32_t g1odfbin = swap.m_OdfBins[0];
+    m_OdfChange = ((actualOdf[choose] - simOdf[choose]) * (actualOdf[choose] - simOdf[choose])) - ((actualOdf[choose] - (simOdf[choose] + vol1)) * (actualOdf[choose] - (simOdf[choose] + vol1)));
+    m_OdfChange = m_OdfChange + (((actualOdf[g1odfbin] - simOdf[g1odfbin]) * (actualOdf[g1odfbin] - simOdf[g1odfbin])) -
+                                 ((actualOdf[g1odfbin] - (simOdf[g1odfbin] - vol1)) * (actualOdf[g1odfbin] - (simOdf[g1odfbin] - vol1))));
+  }
+  else // SwitchOrientation
+  {
+    float vol2 = m_Volumes[feature2] / m_UnbiasedVolume[ensem];
+    int32_t g1odfbin = swap.m_OdfBins[0];
+    int32_t g2odfbin = swap.m_OdfBins[1];
+    m_OdfChange = ((actualOdf[g1odfbin] - simOdf[g1odfbin]) * (actualOdf[g1odfbin] - simOdf[g1odfbin])) -
+                  ((actualOdf[g1odfbin] - (simOdf[g1odfbin] - vol1 + vol2)) * (actualOdf[g1odfbin] - (simOdf[g1odfbin] - vol1 + vol2)));
+    m_OdfChange = m_OdfChange + (((actualOdf[g2odfbin] - simOdf[g2odfbin]) * (actualOdf[g2odfbin] - simOdf[g2odfbin])) -
+                                 ((actualOdf[g2odfbin] - (simOdf[g2odfbin] - vol2 + vol1)) * (actualOdf[g2odfbin] - (simOdf[g2odfbin] - vol2 + vol1))));
+  }
+
+  m_MdfChange = 0.0f;
+  size_t end = swap.m_BoundaryStart + swap.m_NumBoundaries[0] + ((feature2 > 0) ? swap.m_NumBoundaries[1] : 0);
+  for(size_t e = swap.m_BoundaryStart; e < end; e++)
+  {
+    size_t b = m_SwapBoundaries[e];
+    int32_t curmisobin = m_BoundaryMisoBins[b];
+    int32_t newmisobin = m_SwapMisoBins[e];
+    float neighsurfarea = m_BoundaryWeights[b];
+    m_MdfChange = m_MdfChange + (((actualMdf[curmisobin] - simMdf[curmisobin]) * (actualMdf[curmisobin] - simMdf[curmisobin])) -
+                                 ((actualMdf[curmisobin] - (simMdf[curmisobin] - neighsurfarea)) * (actualMdf[curmisobin] - (simMdf[curmisobin] - neighsurfarea))));
+    m_MdfChange = m_MdfChange + (((actualMdf[newmisobin] - simMdf[newmisobin]) * (actualMdf[newmisobin] - simMdf[newmisobin])) -
+                                 ((actualMdf[newmisobin] - (simMdf[newmisobin] + neighsurfarea)) * (actualMdf[newmisobin] - (simMdf[newmisobin] + neighsurfarea))));
+  }
+
+  return (m_OdfChange / static_cast<float>(m_OdfError)) + (m_MdfChange / static_cast<float>(m_MdfError));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MatchCrystallography::apply_swap(const OrientationSwap_t& swap, size_t ensem)
+{
+  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
+  int32_t feature1 = swap.m_Features[0];
+  int32_t feature2 = swap.m_Features[1];
+  float vol1 = m_Volumes[feature1] / m_UnbiasedVolume[ensem];
+  int32_t numFeatures = 1;
+
+  if(feature2 <= 0) // SwapOutOrientation
+  {
+    change_odf_bin(swap.m_Choose, vol1);
+    change_odf_bin(swap.m_OdfBins[0], -vol1);
+  }
+  else // SwitchOrientation
   {
-    rod[3] = mag;
-    rod[0] = rod[0] / rod[3];
-    rod[1] = rod[1] / rod[3];
-    rod[2] = rod[2] / rod[3];
+    float vol2 = m_Volumes[feature2] / m_UnbiasedVolume[ensem];
+    change_odf_bin(swap.m_OdfBins[0], vol2 - vol1);
+    change_odf_bin(swap.m_OdfBins[1], vol1 - vol2);
+    numFeatures = 2;
   }
 
-  curmisobin = m_OrientationOps[sym]->getMisoBin(rod);
-  w = m_OrientationOps[sym]->getMisoQuat(q1, q2, n1, n2, n3);
+  for(int32_t k = 0; k < numFeatures; k++)
+  {
+    int32_t feature = swap.m_Features[k];
+    m_FeatureEulerAngles[3 * feature] = swap.m_Eulers[3 * k];
+    m_FeatureEulerAngles[3 * feature + 1] = swap.m_Eulers[3 * k + 1];
+    m_FeatureEulerAngles[3 * feature + 2] = swap.m_Eulers[3 * k + 2];
+    QuaternionMathF::Copy(swap.m_Quats[k], avgQuats[feature]);
+  }
+
+  size_t end = swap.m_BoundaryStart + swap.m_NumBoundaries[0] + ((numFeatures == 2) ? swap.m_NumBoundaries[1] : 0);
+  for(size_t e = swap.m_BoundaryStart; e < end; e++)
+  {
+    size_t b = m_SwapBoundaries[e];
+    int32_t curmisobin = m_BoundaryMisoBins[b];
+    int32_t newmisobin = m_SwapMisoBins[e];
+    if(newmisobin != curmisobin)
+    {
+      change_mdf_bin(curmisobin, -m_BoundaryWeights[b]);
+      change_mdf_bin(newmisobin, m_BoundaryWeights[b]);
+    }
+    m_BoundaryMisoBins[b] = newmisobin;
+    if(m_BoundaryReverse[b] != std::numeric_limits<size_t>::max())
+    {
+      m_BoundaryMisoBins[m_BoundaryReverse[b]] = newmisobin;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MatchCrystallography::change_odf_bin(int32_t bin, float value)
+{
+  float* actualOdf = m_ActualOdf->getPointer(0);
+  float* simOdf = m_SimOdf->getPointer(0);
+  float delta = actualOdf[bin] - simOdf[bin];
+  m_OdfError = m_OdfError - (delta * delta);
+  simOdf[bin] = simOdf[bin] + value;
+  delta = actualOdf[bin] - simOdf[bin];
+  m_OdfError = m_OdfError + (delta * delta);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MatchCrystallography::change_mdf_bin(int32_t bin, float value)
+{
+  float* actualMdf = m_ActualMdf->getPointer(0);
+  float* simMdf = m_SimMdf->getPointer(0);
+  float delta = actualMdf[bin] - simMdf[bin];
+  m_MdfError = m_MdfError - (delta * delta);
+  simMdf[bin] = simMdf[bin] + value;
+  delta = actualMdf[bin] - simMdf[bin];
+  m_MdfError = m_MdfError + (delta * delta);
+}
 
-  FOrientTransformsType::ax2ro(FOrientArrayType(n1, n2, n3, w), rod);
-  newmisobin = m_OrientationOps[sym]->getMisoBin(rod);
-  m_MisorientationLists[feature][3 * j] = miso1;
-  m_MisorientationLists[feature][3 * j + 1] = miso2;
-  m_MisorientationLists[feature][3 * j + 2] = miso3;
-  m_SimMdf->setValue(curmisobin, (m_SimMdf->getValue(curmisobin) - (neighsurfarea / m_TotalSurfaceArea[ensem])));
-  m_SimMdf->setValue(newmisobin, (m_SimMdf->getValue(newmisobin) + (neighsurfarea / m_TotalSurfaceArea[ensem])));
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double MatchCrystallography::getOdfError()
+{
+  return m_OdfError;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double MatchCrystallography::getMdfError()
+{
+  return m_MdfError;
 }
 
 // -----------------------------------------------------------------------------
@@ -754,34 +1028,18 @@ void MatchCrystallography::MC_LoopBody2(int32_t feature, size_t ensem, size_t j,
 // -----------------------------------------------------------------------------
 void MatchCrystallography::matchCrystallography(size_t ensem)
 {
-  // But since a pointer is difficult to use operators with we will now create a
-  // reference variable to the pointer with the correct variable name that allows
-  // us to use the same syntax as the "vector of vectors"
-  NeighborList<int32_t>& neighborlist = *(m_NeighborList.lock());
-  NeighborList<float>& neighborsurfacearealist = *(m_SharedSurfaceAreaList.lock());
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
 
-  uint64_t m_Seed = QDateTime::currentMSecsSinceEpoch();
+  uint64_t m_Seed = (m_UseFixedSeed == true) ? static_cast<uint64_t>(m_FixedSeed) : QDateTime::currentMSecsSinceEpoch();
   SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
 
   int32_t numbins = 0;
   int32_t iterations = 0, badtrycount = 0;
   float random = 0.0f;
   size_t counter = 0;
-
-  QuatF q1;
-  QuatF q2;
-  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
-
-  float ea1 = 0.0f, ea2 = 0.0f, ea3 = 0.0f;
-  float g1ea1 = 0.0f, g1ea2 = 0.0f, g1ea3 = 0.0f, g2ea1 = 0.0f, g2ea2 = 0.0f, g2ea3 = 0.0f;
-  int32_t g1odfbin = 0, g2odfbin = 0;
-  float deltaerror = 0.0f;
-  float currentodferror = 0.0f, currentmdferror = 0.0f;
   int32_t selectedfeature1 = 0, selectedfeature2 = 0;
-  iterations = 0;
-  badtrycount = 0;
+  uint32_t sym = m_CrystalStructures[ensem];
   if(Ebsd::CrystalStructure::Cubic_High == m_CrystalStructures[ensem])
   {
     numbins = 18 * 18 * 18;
@@ -791,12 +1049,37 @@ void MatchCrystallography::matchCrystallography(size_t ensem)
     numbins = 36 * 36 * 12;
   }
 
+  // The errors are kept up to date as the bins change instead of being summed over all of the bins for every swap
+  m_OdfError = 0.0;
+  m_MdfError = 0.0;
+  float delta = 0.0f;
+  for(int32_t i = 0; i < numbins; i++)
+  {
+    delta = m_ActualOdf->getValue(i) - m_SimOdf->getValue(i);
+    m_OdfError = m_OdfError + (delta * delta);
+  }
+  for(size_t i = 0; i < m_SimMdf->getSize(); i++)
+  {
+    delta = m_ActualMdf->getValue(i) - m_SimMdf->getValue(i);
+    m_MdfError = m_MdfError + (delta * delta);
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  // The swaps are drawn and evaluated in batches. A swap whose Features, or their neighbors, changed orientation
+  // earlier in its batch is evaluated again before it is judged, so the chain makes the same decisions as when
+  // every swap is drawn, evaluated and judged in turn
+  const size_t k_SwapBatchSize = 256;
+  std::vector<int32_t> changedInBatch(totalFeatures, -1);
+  int32_t batch = 0;
+
   uint64_t millis = QDateTime::currentMSecsSinceEpoch();
   uint64_t startMillis = millis;
-  int32_t lastIteration = 0;
   while(badtrycount < (m_MaxIterations / 10) && iterations < m_MaxIterations)
   {
-    m_Seed++;
     uint64_t currentMillis = QDateTime::currentMSecsSinceEpoch();
     if(currentMillis - millis > 1000)
     {
@@ -808,33 +1091,24 @@ void MatchCrystallography::matchCrystallography(size_t ensem)
       notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
 
       millis = QDateTime::currentMSecsSinceEpoch();
-      lastIteration = iterations;
-    }
-    currentodferror = 0;
-    currentmdferror = 0;
-    float* actualOdfPtr = m_ActualOdf->getPointer(0);
-    float* simOdfPtr = m_SimOdf->getPointer(0);
-    float delta = 0.0f;
-    for(int32_t i = 0; i < numbins; i++)
-    {
-      delta = actualOdfPtr[i] - simOdfPtr[i];
-      currentodferror = currentodferror + (delta * delta);
     }
-    for(int32_t i = 0; i < (numbins); i++)
-    {
-      currentmdferror = currentmdferror + ((m_ActualMdf->getValue(i) - m_SimMdf->getValue(i)) * (m_ActualMdf->getValue(i) - m_SimMdf->getValue(i)));
-    }
-    iterations++;
-    badtrycount++;
-    random = static_cast<float>(rg.genrand_res53());
 
     if(getCancel() == true)
     {
       return;
     }
 
-    if(random < 0.5) // SwapOutOrientation
+    size_t numSwaps = std::min(k_SwapBatchSize, static_cast<size_t>(m_MaxIterations - iterations));
+    m_Swaps.resize(numSwaps);
+    size_t numEntries = 0;
+    for(size_t s = 0; s < numSwaps; s++)
     {
+      OrientationSwap_t& swap = m_Swaps[s];
+      swap.m_Features[0] = -1;
+      swap.m_Features[1] = -1;
+      m_Seed++;
+      random = static_cast<float>(rg.genrand_res53());
+
       counter = 0;
       selectedfeature1 = int32_t(rg.genrand_res53() * totalFeatures);
       if(selectedfeature1 >= totalFeatures)
@@ -856,107 +1130,25 @@ void MatchCrystallography::matchCrystallography(size_t ensem)
       }
       if(counter == totalFeatures)
       {
-        badtrycount = 10 * m_NumFeatures[ensem];
+        continue;
       }
-      else
-      {
-        ea1 = m_FeatureEulerAngles[3 * selectedfeature1];
-        ea2 = m_FeatureEulerAngles[3 * selectedfeature1 + 1];
-        ea3 = m_FeatureEulerAngles[3 * selectedfeature1 + 2];
-        FOrientArrayType rod(4, 0.0);
-        FOrientTransformsType::eu2ro(FOrientArrayType(&(m_FeatureEulerAngles[3 * selectedfeature1]), 3), rod);
 
-        g1odfbin = m_OrientationOps[m_CrystalStructures[ensem]]->getOdfBin(rod);
+      if(random < 0.5) // SwapOutOrientation
+      {
         random = static_cast<float>(rg.genrand_res53());
-        int32_t choose = 0;
+        int32_t choose = pick_euler(random, numbins);
 
-        choose = pick_euler(random, numbins);
-
-        FOrientArrayType g1ea = m_OrientationOps[m_CrystalStructures[ensem]]->determineEulerAngles(m_Seed, choose);
-        g1ea = m_OrientationOps[m_CrystalStructures[ensem]]->randomizeEulerAngles(g1ea);
+        FOrientArrayType g1ea = m_OrientationOps[sym]->determineEulerAngles(m_Seed, choose);
+        g1ea = randomize_euler_angles(g1ea, sym, static_cast<float>(rg.genrand_res53()));
         FOrientArrayType quat(4, 0.0);
         FOrientTransformsType::eu2qu(g1ea, quat);
-        q1 = quat.toQuaternion();
-
-        m_OdfChange = ((m_ActualOdf->getValue(choose) - m_SimOdf->getValue(choose)) * (m_ActualOdf->getValue(choose) - m_SimOdf->getValue(choose))) -
-                      ((m_ActualOdf->getValue(choose) - (m_SimOdf->getValue(choose) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]))) *
-                       (m_ActualOdf->getValue(choose) - (m_SimOdf->getValue(choose) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]))));
-        m_OdfChange = m_OdfChange + (((m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin)) * (m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin))) -
-                                     ((m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]))) *
-                                      (m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])))));
-
-        m_MdfChange = 0;
-        size_t size = 0;
-        if(neighborlist[selectedfeature1].size() != 0)
-        {
-          size = neighborlist[selectedfeature1].size();
-        }
-        for(size_t j = 0; j < size; j++)
-        {
-          int32_t neighbor = neighborlist[selectedfeature1][j];
-          FOrientTransformsType::eu2qu(FOrientArrayType(&(m_FeatureEulerAngles[3 * neighbor]), 3), quat);
-          q1 = quat.toQuaternion();
-          float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-          MC_LoopBody1(selectedfeature1, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-        }
-
-        deltaerror = (m_OdfChange / currentodferror) + (m_MdfChange / currentmdferror);
-        if(deltaerror > 0)
-        {
-          badtrycount = 0;
-          m_FeatureEulerAngles[3 * selectedfeature1] = g1ea1;
-          m_FeatureEulerAngles[3 * selectedfeature1 + 1] = g1ea2;
-          m_FeatureEulerAngles[3 * selectedfeature1 + 2] = g1ea3;
-          QuaternionMathF::Copy(q1, avgQuats[selectedfeature1]);
-          m_SimOdf->setValue(choose, (m_SimOdf->getValue(choose) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])));
-          m_SimOdf->setValue(g1odfbin, (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])));
-          size = 0;
-          if(neighborlist[selectedfeature1].size() != 0)
-          {
-            size = neighborlist[selectedfeature1].size();
-          }
-          for(size_t j = 0; j < size; j++)
-          {
-            int neighbor = neighborlist[selectedfeature1][j];
-            FOrientArrayType quat(4);
-            FOrientTransformsType::eu2qu(FOrientArrayType(&(m_FeatureEulerAngles[3 * neighbor]), 3), quat);
-            q2 = quat.toQuaternion();
-            float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-            MC_LoopBody2(selectedfeature1, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-          }
-        }
-      }
-      if(getCancel() == true)
-      {
-        return;
-      }
-    }
-    else // SwitchOrientation
-    {
-      counter = 0;
-      selectedfeature1 = int32_t(rg.genrand_res53() * totalFeatures);
-      if(selectedfeature1 >= totalFeatures)
-      {
-        selectedfeature1 = selectedfeature1 - totalFeatures;
+        swap.m_Choose = choose;
+        swap.m_Eulers[0] = g1ea[0];
+        swap.m_Eulers[1] = g1ea[1];
+        swap.m_Eulers[2] = g1ea[2];
+        swap.m_Quats[0] = quat.toQuaternion();
       }
-      while((m_SurfaceFeatures[selectedfeature1] == true || m_FeaturePhases[selectedfeature1] != static_cast<int32_t>(ensem)) && counter < totalFeatures)
-      {
-        if(selectedfeature1 >= totalFeatures)
-        {
-          selectedfeature1 = selectedfeature1 - totalFeatures;
-        }
-        selectedfeature1++;
-        counter++;
-      }
-      if(selectedfeature1 >= totalFeatures)
-      {
-        selectedfeature1 = selectedfeature1 - totalFeatures;
-      }
-      if(counter == totalFeatures)
-      {
-        badtrycount = 10 * m_NumFeatures[ensem];
-      }
-      else
+      else // SwitchOrientation
       {
         counter = 0;
         selectedfeature2 = int32_t(rg.genrand_res53() * totalFeatures);
@@ -979,147 +1171,82 @@ void MatchCrystallography::matchCrystallography(size_t ensem)
         }
         if(counter == totalFeatures)
         {
-          badtrycount = 10 * m_NumFeatures[ensem];
+          continue;
         }
-        else
+        swap.m_Features[1] = selectedfeature2;
+      }
+      swap.m_Features[0] = selectedfeature1;
+      swap.m_BoundaryStart = numEntries;
+      for(int32_t k = 0; k < 2; k++)
+      {
+        if(swap.m_Features[k] > 0)
         {
-          g1ea1 = m_FeatureEulerAngles[3 * selectedfeature1];
-          g1ea2 = m_FeatureEulerAngles[3 * selectedfeature1 + 1];
-          g1ea3 = m_FeatureEulerAngles[3 * selectedfeature1 + 2];
-          g2ea1 = m_FeatureEulerAngles[3 * selectedfeature2];
-          g2ea2 = m_FeatureEulerAngles[3 * selectedfeature2 + 1];
-          g2ea3 = m_FeatureEulerAngles[3 * selectedfeature2 + 2];
-          QuaternionMathF::Copy(q1, avgQuats[selectedfeature1]);
-          FOrientArrayType rod(4);
-          FOrientTransformsType::eu2ro(FOrientArrayType(&(m_FeatureEulerAngles[3 * selectedfeature1]), 3), rod);
-
-          g1odfbin = m_OrientationOps[m_CrystalStructures[ensem]]->getOdfBin(rod);
-          QuaternionMathF::Copy(q1, avgQuats[selectedfeature2]);
-
-          FOrientTransformsType::eu2ro(FOrientArrayType(&(m_FeatureEulerAngles[3 * selectedfeature2]), 3), rod);
-          g2odfbin = m_OrientationOps[m_CrystalStructures[ensem]]->getOdfBin(rod);
-
-          m_OdfChange =
-              ((m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin)) * (m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin))) -
-              ((m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]) + (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]))) *
-               (m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]) + (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]))));
-          m_OdfChange =
-              m_OdfChange +
-              (((m_ActualOdf->getValue(g2odfbin) - m_SimOdf->getValue(g2odfbin)) * (m_ActualOdf->getValue(g2odfbin) - m_SimOdf->getValue(g2odfbin))) -
-               ((m_ActualOdf->getValue(g2odfbin) - (m_SimOdf->getValue(g2odfbin) - (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]))) *
-                (m_ActualOdf->getValue(g2odfbin) -
-                 (m_SimOdf->getValue(g2odfbin) - (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])))));
-
-          m_MdfChange = 0;
-
-          FOrientArrayType quat(4);
-          FOrientTransformsType::eu2qu(FOrientArrayType(g2ea1, g2ea2, g2ea3), quat);
-          q1 = quat.toQuaternion();
-
-          size_t size = 0;
-          if(neighborlist[selectedfeature1].size() != 0)
-          {
-            size = neighborlist[selectedfeature1].size();
-          }
-          for(size_t j = 0; j < size; j++)
-          {
-            int32_t neighbor = neighborlist[selectedfeature1][j];
-            FOrientTransformsType::eu2qu(FOrientArrayType(&(m_FeatureEulerAngles[3 * neighbor]), 3), quat);
-            q2 = quat.toQuaternion();
-            float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-            if(neighbor != static_cast<int>(selectedfeature2))
-            {
-              MC_LoopBody1(selectedfeature1, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-            }
-          }
+          numEntries = numEntries + (m_BoundaryOffsets[swap.m_Features[k] + 1] - m_BoundaryOffsets[swap.m_Features[k]]);
+        }
+      }
+    }
+    m_SwapBoundaries.resize(numEntries);
+    m_SwapQuats1.resize(numEntries);
+    m_SwapQuats2.resize(numEntries);
+    m_SwapAngles.resize(numEntries);
+    m_SwapAxes.resize(3 * numEntries);
+    m_SwapMisoBins.resize(numEntries);
+
+    MatchCrystallographySwapsImpl impl(this, m_Swaps.data(), ensem);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numSwaps, 16), impl, tbb::simple_partitioner());
+    }
+    else
+#endif
+    {
+      impl.convert(0, numSwaps);
+    }
 
-          FOrientTransformsType::eu2qu(FOrientArrayType(g1ea1, g1ea2, g1ea3), quat);
-          q1 = quat.toQuaternion();
-          size = 0;
-          if(neighborlist[selectedfeature2].size() != 0)
-          {
-            size = neighborlist[selectedfeature2].size();
-          }
-          for(size_t j = 0; j < size; j++)
-          {
-            size_t neighbor = neighborlist[selectedfeature2][j];
-
-            FOrientTransformsType::eu2qu(FOrientArrayType(&(m_FeatureEulerAngles[3 * neighbor]), 3), quat);
-            q2 = quat.toQuaternion();
-            float neighsurfarea = neighborsurfacearealist[selectedfeature2][j];
-            if(neighbor != selectedfeature1)
-            {
-              MC_LoopBody1(selectedfeature2, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-            }
-          }
+    // Judge the swaps in the order they were drawn
+    batch++;
+    for(size_t s = 0; s < numSwaps && badtrycount < (m_MaxIterations / 10); s++)
+    {
+      iterations++;
+      badtrycount++;
+      OrientationSwap_t& swap = m_Swaps[s];
+      if(swap.m_Features[0] <= 0)
+      {
+        badtrycount = 10 * m_NumFeatures[ensem];
+        continue;
+      }
 
-          deltaerror = (m_OdfChange / currentodferror) + (m_MdfChange / currentmdferror);
-          if(deltaerror > 0)
-          {
+      bool stale = false;
+      for(int32_t k = 0; k < 2 && stale == false; k++)
+      {
+        int32_t feature = swap.m_Features[k];
+        if(feature <= 0)
+        {
+          continue;
+        }
+        stale = (changedInBatch[feature] == batch);
+        for(size_t b = m_BoundaryOffsets[feature]; b < m_BoundaryOffsets[feature + 1] && stale == false; b++)
+        {
+          stale = (m_BoundaryNeighbors[b] > 0 && changedInBatch[m_BoundaryNeighbors[b]] == batch);
+        }
+      }
+      if(stale == true)
+      {
+        evaluate_swap(swap, ensem);
+      }
 
-            badtrycount = 0;
-            m_FeatureEulerAngles[3 * selectedfeature1] = g2ea1;
-            m_FeatureEulerAngles[3 * selectedfeature1 + 1] = g2ea2;
-            m_FeatureEulerAngles[3 * selectedfeature1 + 2] = g2ea3;
-            m_FeatureEulerAngles[3 * selectedfeature2] = g1ea1;
-            m_FeatureEulerAngles[3 * selectedfeature2 + 1] = g1ea2;
-            m_FeatureEulerAngles[3 * selectedfeature2 + 2] = g1ea3;
-            m_SimOdf->setValue(g1odfbin, (m_SimOdf->getValue(g1odfbin) + (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])));
-            m_SimOdf->setValue(g2odfbin, (m_SimOdf->getValue(g2odfbin) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]) - (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem])));
-
-            FOrientTransformsType::eu2qu(FOrientArrayType(g1ea1, g1ea2, g1ea3), quat);
-            q1 = quat.toQuaternion();
-            QuaternionMathF::Copy(q1, avgQuats[selectedfeature1]);
-            size = 0;
-            if(neighborlist[selectedfeature1].size() != 0)
-            {
-              size = neighborlist[selectedfeature1].size();
-            }
-            for(size_t j = 0; j < size; j++)
-            {
-              size_t neighbor = neighborlist[selectedfeature1][j];
-              ea1 = m_FeatureEulerAngles[3 * neighbor];
-              ea2 = m_FeatureEulerAngles[3 * neighbor + 1];
-              ea3 = m_FeatureEulerAngles[3 * neighbor + 2];
-              FOrientTransformsType::eu2qu(FOrientArrayType(ea1, ea2, ea3), quat);
-              q2 = quat.toQuaternion();
-              float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-              if(neighbor != selectedfeature2)
-              {
-                MC_LoopBody2(selectedfeature1, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-              }
-            }
-
-            FOrientTransformsType::eu2qu(FOrientArrayType(g1ea1, g1ea2, g1ea3), quat);
-            q1 = quat.toQuaternion();
-            QuaternionMathF::Copy(q1, avgQuats[selectedfeature2]);
-            size = 0;
-            if(neighborlist[selectedfeature2].size() != 0)
-            {
-              size = neighborlist[selectedfeature2].size();
-            }
-            for(size_t j = 0; j < size; j++)
-            {
-              size_t neighbor = neighborlist[selectedfeature2][j];
-              ea1 = m_FeatureEulerAngles[3 * neighbor];
-              ea2 = m_FeatureEulerAngles[3 * neighbor + 1];
-              ea3 = m_FeatureEulerAngles[3 * neighbor + 2];
-              FOrientTransformsType::eu2qu(FOrientArrayType(ea1, ea2, ea3), quat);
-              q2 = quat.toQuaternion();
-              float neighsurfarea = neighborsurfacearealist[selectedfeature2][j];
-              if(neighbor != selectedfeature1)
-              {
-                MC_LoopBody2(selectedfeature2, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-              }
-            }
-          }
+      if(swap_error_change(swap, ensem) > 0)
+      {
+        badtrycount = 0;
+        apply_swap(swap, ensem);
+        changedInBatch[swap.m_Features[0]] = batch;
+        if(swap.m_Features[1] > 0)
+        {
+          changedInBatch[swap.m_Features[1]] = batch;
         }
       }
     }
-    if(getCancel() == true)
-    {
-      return;
-    }
   }
 
   if(getCancel() == true)
@@ -1140,11 +1267,6 @@ void MatchCrystallography::matchCrystallography(size_t ensem)
 // -----------------------------------------------------------------------------
 void MatchCrystallography::measure_misorientations(size_t ensem)
 {
-  // But since a pointer is difficult to use operators with we will now create a
-  // reference variable to the pointer with the correct variable name that allows
-  // us to use the same syntax as the "vector of vectors"
-  NeighborList<int32_t>& neighborlist = *(m_NeighborList.lock());
-  NeighborList<float>& neighborsurfacearealist = *(m_SharedSurfaceAreaList.lock());
   size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
 
   float w = 0.0f;
@@ -1153,56 +1275,40 @@ void MatchCrystallography::measure_misorientations(size_t ensem)
   QuatF q2 = QuaternionMathF::New();
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
 
-  uint32_t crys1 = 0;
+  uint32_t crys1 = m_CrystalStructures[ensem];
   int32_t mbin = 0;
-
-  m_MisorientationLists.resize(totalFeatures);
+  FOrientArrayType rod(4);
 
   for(size_t i = 1; i < totalFeatures; i++)
   {
     if(m_FeaturePhases[i] == ensem)
     {
-      if(m_MisorientationLists[i].size() != 0)
-      {
-        m_MisorientationLists[i].clear();
-      }
-      if(neighborlist[i].size() != 0)
-      {
-        m_MisorientationLists[i].assign(neighborlist[i].size() * 3, 0.0f);
-      }
       QuaternionMathF::Copy(avgQuats[i], q1);
-      crys1 = m_CrystalStructures[ensem];
-      size_t size = 0;
-      if(neighborlist[i].size() != 0 && neighborsurfacearealist[i].size() == neighborlist[i].size())
+      for(size_t b = m_BoundaryOffsets[i]; b < m_BoundaryOffsets[i + 1]; b++)
       {
-        size = neighborlist[i].size();
-      }
-
-      for(size_t j = 0; j < size; j++)
-      {
-        int32_t nname = neighborlist[i][j];
-        if(m_FeaturePhases[nname] == ensem)
+        int32_t nname = m_BoundaryNeighbors[b];
+        if(nname <= 0 || m_FeaturePhases[nname] != ensem)
+        {
+          continue;
+        }
+        // Both Features of a boundary keep the bin measured from the first one, so that a bin added to the MDF
+        // is the bin removed again when either of them changes orientation
+        size_t reverse = m_BoundaryReverse[b];
+        if(reverse != std::numeric_limits<size_t>::max() && m_BoundaryMisoBins[reverse] >= 0)
+        {
+          mbin = m_BoundaryMisoBins[reverse];
+        }
+        else
         {
-          w = 10000.0f;
-          float neighsurfarea = neighborsurfacearealist[i][j];
           QuaternionMathF::Copy(avgQuats[nname], q2);
           w = m_OrientationOps[crys1]->getMisoQuat(q1, q2, n1, n2, n3);
-          FOrientArrayType rod(4);
           FOrientTransformsType::ax2ro(FOrientArrayType(n1, n2, n3, w), rod);
-          m_MisorientationLists[i][3 * j] = rod[0];
-          m_MisorientationLists[i][3 * j + 1] = rod[1];
-          m_MisorientationLists[i][3 * j + 2] = rod[2];
           mbin = m_OrientationOps[crys1]->getMisoBin(rod);
-          if(m_SurfaceFeatures[i] == false && (nname > static_cast<int32_t>(i) || m_SurfaceFeatures[nname] == true))
-          {
-            m_SimMdf->setValue(mbin, (m_SimMdf->getValue(mbin) + (neighsurfarea / m_TotalSurfaceArea[m_FeaturePhases[i]])));
-          }
         }
-        else
+        m_BoundaryMisoBins[b] = mbin;
+        if(m_SurfaceFeatures[i] == false && (nname > static_cast<int32_t>(i) || m_SurfaceFeatures[nname] == true))
         {
-          m_MisorientationLists[i][3 * j] = -100;
-          m_MisorientationLists[i][3 * j + 1] = -100;
-          m_MisorientationLists[i][3 * j + 2] = -100;
+          m_SimMdf->setValue(mbin, (m_SimMdf->getValue(mbin) + m_BoundaryWeights[b]));
         }
       }
     }
@@ -47,6 +47,21 @@
 #include "SyntheticBuilding/SyntheticBuildingConstants.h"
 #include "SyntheticBuilding/SyntheticBuildingVersion.h"
 
+/**
+ * @brief The OrientationSwap_t struct holds a proposed swap of the orientation of one Feature for a new
+ * orientation, or a switch of the orientations of two Features
+ */
+typedef struct
+{
+  int32_t m_Features[2];        // m_Features[1] is -1 when the orientation of m_Features[0] is swapped out
+  int32_t m_Choose;             // ODF bin of the new orientation when swapping out
+  int32_t m_OdfBins[2];         // ODF bins of the current orientations of the Features
+  float m_Eulers[6];            // New Euler angles of the Features
+  QuatF m_Quats[2];             // New orientations of the Features
+  size_t m_BoundaryStart;       // First entry of the Features' boundaries in the evaluated boundary buffers
+  size_t m_NumBoundaries[2];    // Number of evaluated boundaries of each Feature
+} OrientationSwap_t;
+
 /**
  * @brief The MatchCrystallography class. See [Filter documentation](@ref matchcrystallography) for details.
  */
@@ -105,6 +120,27 @@ class MatchCrystallography : public AbstractFilter
     SIMPL_FILTER_PARAMETER(int, MaxIterations)
     Q_PROPERTY(int MaxIterations READ getMaxIterations WRITE setMaxIterations)
 
+    // Not exposed as filter parameters: seeding with a fixed value instead of the clock makes a run reproducible
+    SIMPL_INSTANCE_PROPERTY(bool, UseFixedSeed)
+    Q_PROPERTY(bool UseFixedSeed READ getUseFixedSeed WRITE setUseFixedSeed)
+
+    SIMPL_INSTANCE_PROPERTY(quint64, FixedSeed)
+    Q_PROPERTY(quint64 FixedSeed READ getFixedSeed WRITE setFixedSeed)
+
+    /**
+     * @brief getOdfError Returns the ODF error that was kept up to date while matching the last phase
+     * @return Sum of the squared differences between the goal and simulated ODF bins
+     */
+    double getOdfError();
+    Q_PROPERTY(double OdfError READ getOdfError)
+
+    /**
+     * @brief getMdfError Returns the MDF error that was kept up to date while matching the last phase
+     * @return Sum of the squared differences between the goal and simulated MDF bins
+     */
+    double getMdfError();
+    Q_PROPERTY(double MdfError READ getMdfError)
+
     /**
      * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
      */
@@ -233,28 +269,60 @@ class MatchCrystallography : public AbstractFilter
     int32_t pick_euler(float random, int32_t numbins);
 
     /**
-     * @brief MC_LoopBody1 Determines the misorientation change after performing a swap
-     * @param feature Feature Id of Feature that has been swapped
+     * @brief randomize_euler_angles Applies a random symmetry operator to the Euler angles, as
+     * LaueOps::randomizeEulerAngles does, but picks the operator from a value of the filter's own random
+     * number generator so that a seeded run can be repeated
+     * @param eulers Euler angles
+     * @param sym Crystal structure of the current phase
+     * @param random Random value in [0, 1) that picks the symmetry operator
+     * @return Symmetrically equivalent Euler angles
+     */
+    FOrientArrayType randomize_euler_angles(FOrientArrayType eulers, uint32_t sym, float random);
+
+    /**
+     * @brief initialize_boundaries Lays the neighbor lists out flat, with one entry per Feature for every
+     * boundary, and links the two entries of each boundary
+     */
+    void initialize_boundaries();
+
+    /**
+     * @brief evaluate_swap Determines the ODF bins of the current orientations and the misorientation bins
+     * that the boundaries of the Features would have after a swap or switch. Only reads the current orientations,
+     * so that the swaps of a batch can be evaluated in parallel
+     * @param swap Swap to evaluate
+     * @param ensem Ensemble index of the current phase
+     */
+    void evaluate_swap(OrientationSwap_t& swap, size_t ensem);
+
+    /**
+     * @brief swap_error_change Determines the change of the ODF and MDF errors that an evaluated swap would cause
+     * @param swap Evaluated swap
      * @param ensem Ensemble index of the current phase
-     * @param j Neighbor index for the Feature
-     * @param neighsurfarea Surface area for the Feature neighbor
-     * @param sym Crystal structure index
-     * @param q1 Quaterions for the Feature
-     * @param q2 Quaterions for the Feature neighbor
+     * @return Relative improvement of the errors, the swap is accepted if it is positive
      */
-    void MC_LoopBody1(int32_t feature, size_t ensem, size_t j, float neighsurfarea, uint32_t sym, QuatF& q1, QuatF& q2);
+    float swap_error_change(const OrientationSwap_t& swap, size_t ensem);
 
     /**
-     * @brief MC_LoopBody2 Reinserts the swapped orientation if the swap did not improve the fit
-     * @param feature Feature Id of the Feature that has been swapped
-     * @param phase Ensemble index of the current phase
-     * @param j Neighbor index for the Feature
-     * @param neighsurfarea Surface area for the Feature neighbor
-     * @param sym Crystal structure index
-     * @param q1 Quaternions for the Feature
-     * @param q2 Quaternions for the Feature neighbor
+     * @brief apply_swap Gives the Features their new orientations and updates the ODF, the MDF and the
+     * misorientation bins of their boundaries
+     * @param swap Evaluated swap
+     * @param ensem Ensemble index of the current phase
      */
-    void MC_LoopBody2(int32_t feature, size_t phase, size_t j, float neighsurfarea, uint32_t sym, QuatF& q1, QuatF& q2);
+    void apply_swap(const OrientationSwap_t& swap, size_t ensem);
+
+    /**
+     * @brief change_odf_bin Adds a value to a bin of the simulated ODF and updates the ODF error
+     * @param bin ODF bin
+     * @param value Value to add
+     */
+    void change_odf_bin(int32_t bin, float value);
+
+    /**
+     * @brief change_mdf_bin Adds a value to a bin of the simulated MDF and updates the MDF error
+     * @param bin MDF bin
+     * @param value Value to add
+     */
+    void change_mdf_bin(int32_t bin, float value);
 
     /**
      * @brief matchCrystallography Swaps orientations for Features unitl convergence to
@@ -270,6 +338,8 @@ class MatchCrystallography : public AbstractFilter
     void measure_misorientations(size_t ensem);
 
   private:
+    friend class MatchCrystallographySwapsImpl;
+
     // Cell Data
     DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
     DEFINE_DATAARRAY_VARIABLE(float, CellEulerAngles)
@@ -302,7 +372,23 @@ class MatchCrystallography : public AbstractFilter
     FloatArrayType::Pointer m_ActualMdf;
     FloatArrayType::Pointer m_SimMdf;
 
-    std::vector<std::vector<float> > m_MisorientationLists;
+    double m_OdfError;
+    double m_MdfError;
+
+    // Every boundary has one entry in the flat lists of each of its Features, which start at m_BoundaryOffsets
+    std::vector<size_t> m_BoundaryOffsets;
+    std::vector<int32_t> m_BoundaryNeighbors;
+    std::vector<size_t> m_BoundaryReverse;
+    std::vector<float> m_BoundaryWeights;
+    std::vector<int32_t> m_BoundaryMisoBins;
+
+    std::vector<OrientationSwap_t> m_Swaps;
+    std::vector<size_t> m_SwapBoundaries;
+    std::vector<QuatF> m_SwapQuats1;
+    std::vector<QuatF> m_SwapQuats2;
+    std::vector<float> m_SwapAngles;
+    std::vector<float> m_SwapAxes;
+    std::vector<int32_t> m_SwapMisoBins;
 
     QVector<LaueOps::Pointer> m_OrientationOps;
 
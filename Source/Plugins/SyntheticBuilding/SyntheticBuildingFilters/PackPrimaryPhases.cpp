@@ -38,6 +38,7 @@
 #include <fstream>
 
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
 #include <tbb/blocked_range3d.h>
 #include <tbb/parallel_for.h>
 #include <tbb/partitioner.h>
@@ -68,6 +69,7 @@
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
 #include "SyntheticBuilding/SyntheticBuildingConstants.h"
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/AvailablePoints.hpp"
 #include "SyntheticBuilding/SyntheticBuildingVersion.h"
 
 // Macro to determine if we are going to show the Debugging Output files
@@ -228,6 +230,63 @@ public:
 private:
 };
 
+/**
+ * @brief The PackSlabsImpl class runs the Monte Carlo chains of the slabs of Z planes of the packing grid. Each
+ * chain only touches the packing points of its own slab, so the slabs can be packed in parallel
+ */
+class PackSlabsImpl
+{
+  PackPrimaryPhases* m_Filter;
+  int64_t* m_SlabStarts;
+  int64_t* m_SlabThicknesses;
+  std::vector<size_t>* m_SlabFeatures;
+  int64_t m_MovesPerFeature;
+  uint64_t m_Seed;
+  int32_t* m_FeatureOwners;
+  int32_t* m_ExclusionOwners;
+  int64_t* m_FillingChanges;
+  int64_t* m_AcceptedMoves;
+
+public:
+  PackSlabsImpl(PackPrimaryPhases* filter, int64_t* slabStarts, int64_t* slabThicknesses, std::vector<size_t>* slabFeatures, int64_t movesPerFeature, uint64_t seed, int32_t* featureOwners,
+                int32_t* exclusionOwners, int64_t* fillingChanges, int64_t* acceptedMoves)
+  : m_Filter(filter)
+  , m_SlabStarts(slabStarts)
+  , m_SlabThicknesses(slabThicknesses)
+  , m_SlabFeatures(slabFeatures)
+  , m_MovesPerFeature(movesPerFeature)
+  , m_Seed(seed)
+  , m_FeatureOwners(featureOwners)
+  , m_ExclusionOwners(exclusionOwners)
+  , m_FillingChanges(fillingChanges)
+  , m_AcceptedMoves(acceptedMoves)
+  {
+  }
+
+  virtual ~PackSlabsImpl()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t s = start; s < end; s++)
+    {
+      int64_t numMoves = m_MovesPerFeature * static_cast<int64_t>(m_SlabFeatures[s].size());
+      m_Filter->packSlab(m_SlabStarts[s], m_SlabThicknesses[s], m_SlabFeatures[s], numMoves, m_Seed + s, m_FeatureOwners, m_ExclusionOwners, m_FillingChanges[s], m_AcceptedMoves[s]);
+    }
+  }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+};
+
 // Include the MOC generated file for this class
 #include "moc_PackPrimaryPhases.cpp"
 
@@ -254,6 +313,9 @@ PackPrimaryPhases::PackPrimaryPhases()
 , m_CsvOutputFile("")
 , m_PeriodicBoundaries(false)
 , m_WriteGoalAttributes(false)
+, m_PackFeaturesInParallel(false)
+, m_UseFixedSeed(false)
+, m_FixedSeed(0)
 , m_NeighborhoodsArrayName(SIMPL::FeatureData::Neighborhoods)
 , m_CentroidsArrayName(SIMPL::FeatureData::Centroids)
 , m_VolumesArrayName(SIMPL::FeatureData::Volumes)
@@ -329,10 +391,10 @@ void PackPrimaryPhases::initialize()
   m_PackingPoints[0] = m_PackingPoints[1] = m_PackingPoints[2] = 1;
   m_TotalPackingPoints = 1;
 
-  m_FeatureSizeDist.clear();
   m_SimFeatureSizeDist.clear();
-  m_NeighborDist.clear();
   m_SimNeighborDist.clear();
+  m_NeighborDistPhases.clear();
+  m_NeighborDistBins.clear();
 
   m_FeatureSizeDistStep.clear();
   m_NeighborDistStep.clear();
@@ -343,7 +405,6 @@ void PackPrimaryPhases::initialize()
   m_PrimaryPhases.clear();
   m_PrimaryPhaseFractions.clear();
 
-  m_AvailablePointsCount = 1;
   m_FillingError = m_OldFillingError = 0.0f;
   m_CurrentNeighborhoodError = m_OldNeighborhoodError = 0.0f;
   m_CurrentSizeDistError = m_OldSizeDistError = 0.0f;
@@ -356,6 +417,7 @@ void PackPrimaryPhases::setupFilterParameters()
 {
   FilterParameterVector parameters;
   parameters.push_back(SIMPL_NEW_BOOL_FP("Periodic Boundaries", PeriodicBoundaries, FilterParameter::Parameter, PackPrimaryPhases));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Pack Features in Parallel", PackFeaturesInParallel, FilterParameter::Parameter, PackPrimaryPhases));
   QStringList linkedProps("MaskArrayPath");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask", UseMask, FilterParameter::Parameter, PackPrimaryPhases, linkedProps));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
@@ -450,6 +512,7 @@ void PackPrimaryPhases::readFilterParameters(AbstractFilterParametersReader* rea
   setNumFeaturesArrayName(reader->readString("NumFeaturesArrayName", getNumFeaturesArrayName()));
   setPeriodicBoundaries(reader->readValue("PeriodicBoundaries", false));
   setWriteGoalAttributes(reader->readValue("WriteGoalAttributes", false));
+  setPackFeaturesInParallel(reader->readValue("PackFeaturesInParallel", getPackFeaturesInParallel()));
   setUseMask(reader->readValue("UseMask", getUseMask()));
   setHaveFeatures(reader->readValue("HaveFeatures", getHaveFeatures()));
   setFeatureInputFile(reader->readString("FeatureInputFile", getFeatureInputFile()));
@@ -1016,7 +1079,7 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
   }
 
   setErrorCondition(0);
-  m_Seed = QDateTime::currentMSecsSinceEpoch();
+  m_Seed = (m_UseFixedSeed == true) ? static_cast<uint64_t>(m_FixedSeed) : QDateTime::currentMSecsSinceEpoch();
   SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
@@ -1101,8 +1164,7 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
   exclusionOwnersPtr->initializeWithValue(0);
 
   // This is the set that we are going to keep updated with the points that are not in an exclusion zone
-  std::map<size_t, size_t> availablePoints;
-  std::map<size_t, size_t> availablePointsInv;
+  AvailablePoints availablePoints;
 
   // Get a pointer to the Feature Owners that was just initialized in the initialize_packinggrid() method
   int32_t* featureOwners = featureOwnersPtr->getPointer(0);
@@ -1110,14 +1172,12 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
   int64_t featureOwnersIdx = 0;
 
   // determine initial set of available points
-  m_AvailablePointsCount = 0;
+  availablePoints.reset(m_TotalPackingPoints);
   for(int64_t i = 0; i < m_TotalPackingPoints; i++)
   {
     if((exclusionOwners[i] == 0 && m_UseMask == false) || (exclusionOwners[i] == 0 && m_UseMask == true && m_Mask[i] == true))
     {
-      availablePoints[i] = m_AvailablePointsCount;
-      availablePointsInv[m_AvailablePointsCount] = i;
-      m_AvailablePointsCount++;
+      availablePoints.insert(i);
     }
   }
   // and clear the pointsToRemove and pointsToAdd vectors from the initial packing
@@ -1125,7 +1185,6 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
   m_PointsToAdd.clear();
 
   // initialize the sim and goal size distributions for the primary phases
-  m_FeatureSizeDist.resize(m_PrimaryPhases.size());
   m_SimFeatureSizeDist.resize(m_PrimaryPhases.size());
   m_FeatureSizeDistStep.resize(m_PrimaryPhases.size());
   size_t numPrimaryPhases = m_PrimaryPhases.size();
@@ -1133,30 +1192,30 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
   {
     phase = m_PrimaryPhases[i];
     PrimaryStatsData* pp = PrimaryStatsData::SafePointerDownCast(statsDataArray[phase].get());
-    m_FeatureSizeDist[i].resize(40);
-    m_SimFeatureSizeDist[i].resize(40);
-    m_FeatureSizeDistStep[i] = static_cast<float>(((2 * pp->getMaxFeatureDiameter()) - (pp->getMinFeatureDiameter() / 2.0f)) / m_FeatureSizeDist[i].size());
+    std::vector<float> featureSizeDist(40, 0.0f);
+    m_FeatureSizeDistStep[i] = static_cast<float>(((2 * pp->getMaxFeatureDiameter()) - (pp->getMinFeatureDiameter() / 2.0f)) / featureSizeDist.size());
     float input = 0.0f;
     float previoustotal = 0.0f;
     VectorOfFloatArray GSdist = pp->getFeatureSizeDistribution();
     float avg = GSdist[0]->getValue(0);
     float stdev = GSdist[1]->getValue(0);
     float denominatorConst = 1.0f / sqrtf(2.0f * stdev * stdev); // Calculate it here rather than calculating the same thing multiple times below
-    size_t numFeatureSizeDist = m_FeatureSizeDist[i].size();
+    size_t numFeatureSizeDist = featureSizeDist.size();
     for(size_t j = 0; j < numFeatureSizeDist; j++)
     {
       input = (float(j + 1) * m_FeatureSizeDistStep[i]) + (pp->getMinFeatureDiameter() / 2.0f);
       float logInput = logf(input);
       if(logInput <= avg)
       {
-        m_FeatureSizeDist[i][j] = 0.5f - 0.5f * (SIMPLibMath::erf((avg - logInput) * denominatorConst)) - previoustotal;
+        featureSizeDist[j] = 0.5f - 0.5f * (SIMPLibMath::erf((avg - logInput) * denominatorConst)) - previoustotal;
       }
       if(logInput > avg)
       {
-        m_FeatureSizeDist[i][j] = 0.5f + 0.5f * (SIMPLibMath::erf((logInput - avg) * denominatorConst)) - previoustotal;
+        featureSizeDist[j] = 0.5f + 0.5f * (SIMPLibMath::erf((logInput - avg) * denominatorConst)) - previoustotal;
       }
-      previoustotal = previoustotal + m_FeatureSizeDist[i][j];
+      previoustotal = previoustotal + featureSizeDist[j];
     }
+    m_SimFeatureSizeDist[i].initialize(1, numFeatureSizeDist, featureSizeDist);
   }
 
   if(getCancel() == true)
@@ -1208,6 +1267,7 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
         }
 
         transferAttributes(gid, &feature);
+        updateSizeDist(&feature, 1);
         m_OldSizeDistError = m_CurrentSizeDistError;
         curphasevol[j] = curphasevol[j] + m_Volumes[gid];
         iter = 0;
@@ -1251,6 +1311,7 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
             updateFeatureInstancePointers();
           }
           transferAttributes(gid, &feature);
+          updateSizeDist(&feature, 1);
           m_OldSizeDistError = m_CurrentSizeDistError;
           curphasevol[j] = curphasevol[j] + m_Volumes[gid];
           iter = 0;
@@ -1279,21 +1340,19 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
   }
 
   // initialize the sim and goal neighbor distribution for the primary phases
-  m_NeighborDist.resize(m_PrimaryPhases.size());
   m_SimNeighborDist.resize(m_PrimaryPhases.size());
   m_NeighborDistStep.resize(m_PrimaryPhases.size());
   for(size_t i = 0; i < numPrimaryPhases; i++)
   {
     phase = m_PrimaryPhases[i];
     PrimaryStatsData* pp = PrimaryStatsData::SafePointerDownCast(statsDataArray[phase].get());
-    m_NeighborDist[i].resize(pp->getBinNumbers()->getSize());
-    m_SimNeighborDist[i].resize(pp->getBinNumbers()->getSize());
     VectorOfFloatArray Neighdist = pp->getFeatureSize_Neighbors();
     float normalizer = 0.0f;
-    size_t numNeighborDistBins = m_NeighborDist[i].size();
+    size_t numNeighborDistBins = pp->getBinNumbers()->getSize();
+    // One row of 40 neighborhood bins for each Feature size bin
+    std::vector<float> neighborDist(numNeighborDistBins * 40, 0.0f);
     for(size_t j = 0; j < numNeighborDistBins; j++)
     {
-      m_NeighborDist[i][j].resize(40);
       float input = 0.0f;
       float previoustotal = 0.0f;
       float avg = Neighdist[0]->getValue(j);
@@ -1306,13 +1365,13 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
         float logInput = logf(input);
         if(logInput <= avg)
         {
-          m_NeighborDist[i][j][k] = 0.5f - 0.5f * (SIMPLibMath::erf((avg - logInput) * denominatorConst)) - previoustotal;
+          neighborDist[j * 40 + k] = 0.5f - 0.5f * (SIMPLibMath::erf((avg - logInput) * denominatorConst)) - previoustotal;
         }
         if(logInput > avg)
         {
-          m_NeighborDist[i][j][k] = 0.5f + 0.5f * (SIMPLibMath::erf((logInput - avg) * denominatorConst)) - previoustotal;
+          neighborDist[j * 40 + k] = 0.5f + 0.5f * (SIMPLibMath::erf((logInput - avg) * denominatorConst)) - previoustotal;
         }
-        previoustotal = previoustotal + m_NeighborDist[i][j][k];
+        previoustotal = previoustotal + neighborDist[j * 40 + k];
       }
       normalizer = normalizer + previoustotal;
     }
@@ -1321,9 +1380,10 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
     {
       for(size_t k = 0; k < 40; k++)
       {
-        m_NeighborDist[i][j][k] = m_NeighborDist[i][j][k] * normalizer;
+        neighborDist[j * 40 + k] = neighborDist[j * 40 + k] * normalizer;
       }
     }
+    m_SimNeighborDist[i].initialize(numNeighborDistBins, 40, neighborDist);
   }
 
   if(getCancel() == true)
@@ -1428,218 +1488,246 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
     }
     determineNeighbors(i, true);
   }
+  initializeNeighborDist();
   m_OldNeighborhoodError = checkNeighborhoodError(-1000, -1000);
 
   // begin swaping/moving/adding/removing features to try to improve packing
   int32_t totalAdjustments = static_cast<int32_t>(100 * (totalFeatures - 1));
 
-  // determine initial set of available points
-  m_AvailablePointsCount = 0;
-  for(int64_t i = 0; i < m_TotalPackingPoints; i++)
+  uint64_t packingMillis = QDateTime::currentMSecsSinceEpoch();
+  int64_t triedMoves = totalAdjustments;
+  int64_t acceptedMoves = 0;
+  bool packedInSlabs = false;
+  if(m_PackFeaturesInParallel == true)
   {
-    if((exclusionOwners[i] == 0 && m_UseMask == false) || (exclusionOwners[i] == 0 && m_UseMask == true && m_Mask[i] == true))
+    packedInSlabs = packFeaturesInSlabs(featureOwnersPtr, exclusionOwnersPtr, totalAdjustments, triedMoves, acceptedMoves);
+    if(getCancel() == true)
     {
-      availablePoints[i] = m_AvailablePointsCount;
-      availablePointsInv[m_AvailablePointsCount] = i;
-      m_AvailablePointsCount++;
+      return;
     }
   }
+  if(packedInSlabs == false)
+  {
+    // determine initial set of available points
+    availablePoints.reset(m_TotalPackingPoints);
+    for(int64_t i = 0; i < m_TotalPackingPoints; i++)
+    {
+      if((exclusionOwners[i] == 0 && m_UseMask == false) || (exclusionOwners[i] == 0 && m_UseMask == true && m_Mask[i] == true))
+      {
+        availablePoints.insert(i);
+      }
+    }
 
-  // and clear the pointsToRemove and pointsToAdd vectors from the initial packing
-  m_PointsToRemove.clear();
-  m_PointsToAdd.clear();
+    // and clear the pointsToRemove and pointsToAdd vectors from the initial packing
+    m_PointsToRemove.clear();
+    m_PointsToAdd.clear();
 
-  millis = QDateTime::currentMSecsSinceEpoch();
-  startMillis = millis;
-  bool good = false;
-  size_t key = 0;
-  float xshift = 0.0f, yshift = 0.0f, zshift = 0.0f;
-  int32_t lastIteration = 0;
-  for(int32_t iteration = 0; iteration < totalAdjustments; ++iteration)
-  {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
+    millis = QDateTime::currentMSecsSinceEpoch();
+    startMillis = millis;
+    bool good = false;
+    size_t key = 0;
+    float xshift = 0.0f, yshift = 0.0f, zshift = 0.0f;
+    int32_t lastIteration = 0;
+    for(int32_t iteration = 0; iteration < totalAdjustments; ++iteration)
     {
-      QString ss = QObject::tr("Swapping/Moving/Adding/Removing Features Iteration %1/%2").arg(iteration).arg(totalAdjustments);
-      timeDiff = ((float)iteration / (float)(currentMillis - startMillis));
-      estimatedTime = (float)(totalAdjustments - iteration) / timeDiff;
+      currentMillis = QDateTime::currentMSecsSinceEpoch();
+      if(currentMillis - millis > 1000)
+      {
+        QString ss = QObject::tr("Swapping/Moving/Adding/Removing Features Iteration %1/%2").arg(iteration).arg(totalAdjustments);
+        timeDiff = ((float)iteration / (float)(currentMillis - startMillis));
+        estimatedTime = (float)(totalAdjustments - iteration) / timeDiff;
 
-      ss += QObject::tr(" || Est. Time Remain: %1 || Iterations/Sec: %2").arg(DREAM3D::convertMillisToHrsMinSecs(estimatedTime)).arg(timeDiff * 1000);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+        ss += QObject::tr(" || Est. Time Remain: %1 || Iterations/Sec: %2").arg(DREAM3D::convertMillisToHrsMinSecs(estimatedTime)).arg(timeDiff * 1000);
+        notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
 
-      millis = QDateTime::currentMSecsSinceEpoch();
-      lastIteration = iteration;
-    }
+        millis = QDateTime::currentMSecsSinceEpoch();
+        lastIteration = iteration;
+      }
 
-    if(getCancel() == true)
-    {
-      return;
-    }
+      if(getCancel() == true)
+      {
+        return;
+      }
 
-    int32_t option = iteration % 2;
+      int32_t option = iteration % 2;
 
-    if(writeErrorFile == true && iteration % 25 == 0)
-    {
-      outFile << iteration << " " << m_FillingError << "  " << availablePoints.size() << "  " << m_AvailablePointsCount << " " << totalFeatures << " " << acceptedmoves << "\n";
-    }
+      if(writeErrorFile == true && iteration % 25 == 0)
+      {
+        outFile << iteration << " " << m_FillingError << "  " << availablePoints.size() << " " << totalFeatures << " " << acceptedmoves << "\n";
+      }
 
-    // JUMP - this option moves one feature to a random spot in the volume
-    if(option == 0)
-    {
-      randomfeature = m_FirstPrimaryFeature + int32_t(rg.genrand_res53() * (totalFeatures - m_FirstPrimaryFeature));
-      good = false;
-      count = 0;
-      while(good == false && count < static_cast<int32_t>((totalFeatures - m_FirstPrimaryFeature)))
+      // JUMP - this option moves one feature to a random spot in the volume
+      if(option == 0)
       {
-        xc = m_Centroids[3 * randomfeature];
-        yc = m_Centroids[3 * randomfeature + 1];
-        zc = m_Centroids[3 * randomfeature + 2];
-        column = static_cast<int64_t>((xc - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0]);
-        row = static_cast<int64_t>((yc - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1]);
-        plane = static_cast<int64_t>((zc - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2]);
-        featureOwnersIdx = (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + column;
-        if(featureOwners[featureOwnersIdx] > 1)
+        randomfeature = m_FirstPrimaryFeature + int32_t(rg.genrand_res53() * (totalFeatures - m_FirstPrimaryFeature));
+        good = false;
+        count = 0;
+        while(good == false && count < static_cast<int32_t>((totalFeatures - m_FirstPrimaryFeature)))
         {
-          good = true;
+          xc = m_Centroids[3 * randomfeature];
+          yc = m_Centroids[3 * randomfeature + 1];
+          zc = m_Centroids[3 * randomfeature + 2];
+          column = static_cast<int64_t>((xc - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0]);
+          row = static_cast<int64_t>((yc - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1]);
+          plane = static_cast<int64_t>((zc - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2]);
+          featureOwnersIdx = (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + column;
+          if(featureOwners[featureOwnersIdx] > 1)
+          {
+            good = true;
+          }
+          else
+          {
+            randomfeature++;
+          }
+          if(static_cast<size_t>(randomfeature) >= totalFeatures)
+          {
+            randomfeature = m_FirstPrimaryFeature;
+          }
+          count++;
         }
-        else
+        m_Seed++;
+
+        if(availablePoints.size() > 0)
         {
-          randomfeature++;
+          key = static_cast<size_t>(rg.genrand_res53() * (availablePoints.size() - 1));
+          featureOwnersIdx = availablePoints.at(key);
         }
-        if(static_cast<size_t>(randomfeature) >= totalFeatures)
+        else
         {
-          randomfeature = m_FirstPrimaryFeature;
+          featureOwnersIdx = static_cast<size_t>(rg.genrand_res53() * m_TotalPackingPoints);
         }
-        count++;
-      }
-      m_Seed++;
-
-      if(availablePoints.size() > 0)
-      {
-        key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-        featureOwnersIdx = availablePointsInv[key];
-      }
-      else
-      {
-        featureOwnersIdx = static_cast<size_t>(rg.genrand_res53() * m_TotalPackingPoints);
-      }
 
-      // find the column row and plane of that point
-      column = static_cast<int64_t>(featureOwnersIdx % m_PackingPoints[0]);
-      row = static_cast<int64_t>(featureOwnersIdx / m_PackingPoints[0]) % m_PackingPoints[1];
-      plane = static_cast<int64_t>(featureOwnersIdx / (m_PackingPoints[0] * m_PackingPoints[1]));
-      xc = static_cast<float>((column * m_PackingRes[0]) + (m_PackingRes[0] * 0.5));
-      yc = static_cast<float>((row * m_PackingRes[1]) + (m_PackingRes[1] * 0.5));
-      zc = static_cast<float>((plane * m_PackingRes[2]) + (m_PackingRes[2] * 0.5));
-      oldxc = m_Centroids[3 * randomfeature];
-      oldyc = m_Centroids[3 * randomfeature + 1];
-      oldzc = m_Centroids[3 * randomfeature + 2];
-      m_OldFillingError = m_FillingError;
-      m_FillingError = checkFillingError(-1000, static_cast<int32_t>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
-      moveFeature(randomfeature, xc, yc, zc);
-      m_FillingError = checkFillingError(static_cast<int32_t>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
-      m_CurrentNeighborhoodError = checkNeighborhoodError(-1000, randomfeature);
-      if(m_FillingError <= m_OldFillingError)
-      {
-        m_OldNeighborhoodError = m_CurrentNeighborhoodError;
-        updateAvailablePoints(availablePoints, availablePointsInv);
-        acceptedmoves++;
-      }
-      else if(m_FillingError > m_OldFillingError)
-      {
+        // find the column row and plane of that point
+        column = static_cast<int64_t>(featureOwnersIdx % m_PackingPoints[0]);
+        row = static_cast<int64_t>(featureOwnersIdx / m_PackingPoints[0]) % m_PackingPoints[1];
+        plane = static_cast<int64_t>(featureOwnersIdx / (m_PackingPoints[0] * m_PackingPoints[1]));
+        xc = static_cast<float>((column * m_PackingRes[0]) + (m_PackingRes[0] * 0.5));
+        yc = static_cast<float>((row * m_PackingRes[1]) + (m_PackingRes[1] * 0.5));
+        zc = static_cast<float>((plane * m_PackingRes[2]) + (m_PackingRes[2] * 0.5));
+        oldxc = m_Centroids[3 * randomfeature];
+        oldyc = m_Centroids[3 * randomfeature + 1];
+        oldzc = m_Centroids[3 * randomfeature + 2];
+        m_OldFillingError = m_FillingError;
         m_FillingError = checkFillingError(-1000, static_cast<int32_t>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
-        moveFeature(randomfeature, oldxc, oldyc, oldzc);
+        moveFeature(randomfeature, xc, yc, zc);
         m_FillingError = checkFillingError(static_cast<int32_t>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
-        m_PointsToRemove.clear();
-        m_PointsToAdd.clear();
+        m_CurrentNeighborhoodError = checkNeighborhoodError(-1000, randomfeature);
+        if(m_FillingError <= m_OldFillingError)
+        {
+          m_OldNeighborhoodError = m_CurrentNeighborhoodError;
+          updateAvailablePoints(availablePoints);
+          acceptedmoves++;
+        }
+        else if(m_FillingError > m_OldFillingError)
+        {
+          m_FillingError = checkFillingError(-1000, static_cast<int32_t>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
+          moveFeature(randomfeature, oldxc, oldyc, oldzc);
+          m_FillingError = checkFillingError(static_cast<int32_t>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
+          m_PointsToRemove.clear();
+          m_PointsToAdd.clear();
+        }
       }
-    }
 
-    // NUDGE - this option moves one feature to a spot close to its current centroid
-    if(option == 1)
-    {
-      randomfeature = m_FirstPrimaryFeature + int32_t(rg.genrand_res53() * (totalFeatures - m_FirstPrimaryFeature));
-      good = false;
-      count = 0;
-      while(good == false && count < static_cast<int32_t>((totalFeatures - m_FirstPrimaryFeature)))
+      // NUDGE - this option moves one feature to a spot close to its current centroid
+      if(option == 1)
       {
-        xc = m_Centroids[3 * randomfeature];
-        yc = m_Centroids[3 * randomfeature + 1];
-        zc = m_Centroids[3 * randomfeature + 2];
-        column = static_cast<int64_t>((xc - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0]);
-        row = static_cast<int64_t>((yc - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1]);
-        plane = static_cast<int64_t>((zc - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2]);
-        featureOwnersIdx = (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + column;
-        if(featureOwners[featureOwnersIdx] > 1)
+        randomfeature = m_FirstPrimaryFeature + int32_t(rg.genrand_res53() * (totalFeatures - m_FirstPrimaryFeature));
+        good = false;
+        count = 0;
+        while(good == false && count < static_cast<int32_t>((totalFeatures - m_FirstPrimaryFeature)))
         {
-          good = true;
+          xc = m_Centroids[3 * randomfeature];
+          yc = m_Centroids[3 * randomfeature + 1];
+          zc = m_Centroids[3 * randomfeature + 2];
+          column = static_cast<int64_t>((xc - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0]);
+          row = static_cast<int64_t>((yc - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1]);
+          plane = static_cast<int64_t>((zc - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2]);
+          featureOwnersIdx = (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + column;
+          if(featureOwners[featureOwnersIdx] > 1)
+          {
+            good = true;
+          }
+          else
+          {
+            randomfeature++;
+          }
+          if(static_cast<size_t>(randomfeature) >= totalFeatures)
+          {
+            randomfeature = m_FirstPrimaryFeature;
+          }
+          count++;
+        }
+        m_Seed++;
+        oldxc = m_Centroids[3 * randomfeature];
+        oldyc = m_Centroids[3 * randomfeature + 1];
+        oldzc = m_Centroids[3 * randomfeature + 2];
+        xshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[0])));
+        yshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[1])));
+        zshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[2])));
+        if((oldxc + xshift) < m_SizeX && (oldxc + xshift) > 0)
+        {
+          xc = oldxc + xshift;
         }
         else
         {
-          randomfeature++;
+          xc = oldxc;
         }
-        if(static_cast<size_t>(randomfeature) >= totalFeatures)
+        if((oldyc + yshift) < m_SizeY && (oldyc + yshift) > 0)
         {
-          randomfeature = m_FirstPrimaryFeature;
+          yc = oldyc + yshift;
+        }
+        else
+        {
+          yc = oldyc;
+        }
+        if((oldzc + zshift) < m_SizeZ && (oldzc + zshift) > 0)
+        {
+          zc = oldzc + zshift;
+        }
+        else
+        {
+          zc = oldzc;
+        }
+        m_OldFillingError = m_FillingError;
+        m_FillingError = checkFillingError(-1000, static_cast<int32_t>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
+        moveFeature(randomfeature, xc, yc, zc);
+        m_FillingError = checkFillingError(static_cast<int32_t>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
+        m_CurrentNeighborhoodError = checkNeighborhoodError(-1000, randomfeature);
+        //      change2 = (currentneighborhooderror * currentneighborhooderror) - (oldneighborhooderror * oldneighborhooderror);
+        //      if(fillingerror <= oldfillingerror && currentneighborhooderror >= oldneighborhooderror)
+        if(m_FillingError <= m_OldFillingError)
+        {
+          m_OldNeighborhoodError = m_CurrentNeighborhoodError;
+          updateAvailablePoints(availablePoints);
+          acceptedmoves++;
+        }
+        //      else if(fillingerror > oldfillingerror || currentneighborhooderror < oldneighborhooderror)
+        else if(m_FillingError > m_OldFillingError)
+        {
+          m_FillingError = checkFillingError(-1000, static_cast<int>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
+          moveFeature(randomfeature, oldxc, oldyc, oldzc);
+          m_FillingError = checkFillingError(static_cast<int>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
+          m_PointsToRemove.clear();
+          m_PointsToAdd.clear();
         }
-        count++;
-      }
-      m_Seed++;
-      oldxc = m_Centroids[3 * randomfeature];
-      oldyc = m_Centroids[3 * randomfeature + 1];
-      oldzc = m_Centroids[3 * randomfeature + 2];
-      xshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[0])));
-      yshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[1])));
-      zshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[2])));
-      if((oldxc + xshift) < m_SizeX && (oldxc + xshift) > 0)
-      {
-        xc = oldxc + xshift;
-      }
-      else
-      {
-        xc = oldxc;
-      }
-      if((oldyc + yshift) < m_SizeY && (oldyc + yshift) > 0)
-      {
-        yc = oldyc + yshift;
-      }
-      else
-      {
-        yc = oldyc;
-      }
-      if((oldzc + zshift) < m_SizeZ && (oldzc + zshift) > 0)
-      {
-        zc = oldzc + zshift;
-      }
-      else
-      {
-        zc = oldzc;
-      }
-      m_OldFillingError = m_FillingError;
-      m_FillingError = checkFillingError(-1000, static_cast<int32_t>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
-      moveFeature(randomfeature, xc, yc, zc);
-      m_FillingError = checkFillingError(static_cast<int32_t>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
-      m_CurrentNeighborhoodError = checkNeighborhoodError(-1000, randomfeature);
-      //      change2 = (currentneighborhooderror * currentneighborhooderror) - (oldneighborhooderror * oldneighborhooderror);
-      //      if(fillingerror <= oldfillingerror && currentneighborhooderror >= oldneighborhooderror)
-      if(m_FillingError <= m_OldFillingError)
-      {
-        m_OldNeighborhoodError = m_CurrentNeighborhoodError;
-        updateAvailablePoints(availablePoints, availablePointsInv);
-        acceptedmoves++;
-      }
-      //      else if(fillingerror > oldfillingerror || currentneighborhooderror < oldneighborhooderror)
-      else if(m_FillingError > m_OldFillingError)
-      {
-        m_FillingError = checkFillingError(-1000, static_cast<int>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
-        moveFeature(randomfeature, oldxc, oldyc, oldzc);
-        m_FillingError = checkFillingError(static_cast<int>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
-        m_PointsToRemove.clear();
-        m_PointsToAdd.clear();
       }
     }
+
+    acceptedMoves = acceptedmoves;
   }
 
+  // Report the final errors and the throughput of the chain, so that the serial and the parallel packing can be compared
+  currentMillis = QDateTime::currentMSecsSinceEpoch();
+  float movesPerSec = static_cast<float>(triedMoves) * 1000.0f / static_cast<float>(std::max<uint64_t>(currentMillis - packingMillis, 1));
+  ss = QObject::tr("Packing Features || Filling Error: %1 || Size Distribution Error: %2 || Neighborhood Error: %3 || Accepted Moves: %4/%5 || Moves/Sec: %6")
+           .arg(m_FillingError)
+           .arg(m_OldSizeDistError)
+           .arg(m_OldNeighborhoodError)
+           .arg(acceptedMoves)
+           .arg(triedMoves)
+           .arg(movesPerSec);
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+
   if(m_VtkOutputFile.isEmpty() == false)
   {
     int32_t err = writeVtkFile(featureOwnersPtr->getPointer(0), exclusionOwnersPtr->getPointer(0));
@@ -1890,6 +1978,10 @@ void PackPrimaryPhases::determineNeighbors(size_t gnum, bool add)
   {
     increment = -1;
   }
+  // Once the neighbor distribution is binned, the Features of the same phase are moved to their new bins. The
+  // error of a phase only sees the neighborhoods that a Feature of that phase changes
+  bool updateDist = (m_NeighborDistBins.empty() == false);
+  int32_t phase = m_FeaturePhases[gnum];
   for(size_t n = m_FirstPrimaryFeature; n < totalFeatures; n++)
   {
     xn = m_Centroids[3 * n];
@@ -1902,10 +1994,18 @@ void PackPrimaryPhases::determineNeighbors(size_t gnum, bool add)
     if(dx < dia && dy < dia && dz < dia)
     {
       m_Neighborhoods[gnum] = m_Neighborhoods[gnum] + increment;
+      if(updateDist == true)
+      {
+        updateNeighborDist(gnum);
+      }
     }
     if(dx < dia2 && dy < dia2 && dz < dia2)
     {
       m_Neighborhoods[n] = m_Neighborhoods[n] + increment;
+      if(updateDist == true && m_FeaturePhases[n] == phase)
+      {
+        updateNeighborDist(n);
+      }
     }
   }
 }
@@ -1913,62 +2013,34 @@ void PackPrimaryPhases::determineNeighbors(size_t gnum, bool add)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-float PackPrimaryPhases::checkNeighborhoodError(int32_t gadd, int32_t gremove)
+void PackPrimaryPhases::initializeNeighborDist()
 {
-  // Optimized Code
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
 
   StatsDataArray& statsDataArray = *(m_StatsDataArray.lock().get());
 
-  float neighborerror = 0.0f;
-  float bhattdist = 0.0f;
-  float dia = 0.0f;
-  int32_t nnum = 0;
-  size_t diabin = 0;
-  size_t nnumbin = 0;
-  int32_t index = 0;
-  int32_t phase = 0;
+  size_t totalFeatures = m->getAttributeMatrix(m_OutputCellFeatureAttributeMatrixName)->getNumberOfTuples();
+  m_NeighborDistPhases.assign(totalFeatures, -1);
+  m_NeighborDistBins.assign(totalFeatures, 0);
 
-  typedef std::vector<std::vector<float>> VectOfVectFloat_t;
   size_t numPhases = m_SimNeighborDist.size();
   for(size_t iter = 0; iter < numPhases; ++iter)
   {
-    phase = m_PrimaryPhases[iter];
+    int32_t phase = m_PrimaryPhases[iter];
     PrimaryStatsData* pp = PrimaryStatsData::SafePointerDownCast(statsDataArray[phase].get());
-    VectOfVectFloat_t& curSimNeighborDist = m_SimNeighborDist[iter];
-    size_t curSImNeighborDist_Size = curSimNeighborDist.size();
-    float oneOverNeighborDistStep = 1.0f / m_NeighborDistStep[iter];
-
-    std::vector<int32_t> count(curSImNeighborDist_Size, 0);
-    for(size_t i = 0; i < curSImNeighborDist_Size; i++)
-    {
-      curSimNeighborDist[i].resize(40);
-      for(size_t j = 0; j < 40; j++)
-      {
-        curSimNeighborDist[i][j] = 0;
-      }
-    }
-    if(gadd > 0 && m_FeaturePhases[gadd] == phase)
-    {
-      determineNeighbors(gadd, true);
-    }
-    if(gremove > 0 && m_FeaturePhases[gremove] == phase)
-    {
-      determineNeighbors(gremove, false);
-    }
+    PackingDistribution& curSimNeighborDist = m_SimNeighborDist[iter];
+    size_t numColumns = curSimNeighborDist.getNumColumns();
+    size_t numRows = pp->getBinNumbers()->getSize();
 
     float maxFeatureDia = pp->getMaxFeatureDiameter();
     float minFeatureDia = pp->getMinFeatureDiameter();
     float oneOverBinStepSize = 1.0f / pp->getBinStepSize();
 
-    size_t totalFeatures = m->getAttributeMatrix(m_OutputCellFeatureAttributeMatrixName)->getNumberOfTuples();
     for(size_t i = m_FirstPrimaryFeature; i < totalFeatures; i++)
     {
-      nnum = 0;
-      index = static_cast<int32_t>(i);
-      if(index != gremove && m_FeaturePhases[index] == phase)
+      if(m_FeaturePhases[i] == phase)
       {
-        dia = m_EquivalentDiameters[index];
+        float dia = m_EquivalentDiameters[i];
         if(dia > maxFeatureDia)
         {
           dia = maxFeatureDia;
@@ -1977,96 +2049,98 @@ float PackPrimaryPhases::checkNeighborhoodError(int32_t gadd, int32_t gremove)
         {
           dia = minFeatureDia;
         }
-        diabin = static_cast<size_t>(((dia - minFeatureDia) * oneOverBinStepSize));
-        if(diabin >= curSImNeighborDist_Size)
-        {
-          diabin = curSImNeighborDist_Size - 1;
-        }
-        nnum = m_Neighborhoods[index];
-        nnumbin = static_cast<size_t>(nnum * oneOverNeighborDistStep);
-        if(nnumbin >= 40)
+        size_t diabin = static_cast<size_t>(((dia - minFeatureDia) * oneOverBinStepSize));
+        if(diabin >= numRows)
         {
-          nnumbin = 39;
+          diabin = numRows - 1;
         }
-        curSimNeighborDist[diabin][nnumbin]++;
-        count[diabin]++;
-      }
-    }
-    if(gadd > 0 && m_FeaturePhases[gadd] == phase)
-    {
-      dia = m_EquivalentDiameters[gadd];
-      if(dia > maxFeatureDia)
-      {
-        dia = maxFeatureDia;
-      }
-      if(dia < minFeatureDia)
-      {
-        dia = minFeatureDia;
-      }
-      diabin = static_cast<size_t>(((dia - minFeatureDia) * oneOverBinStepSize));
-      if(diabin >= curSImNeighborDist_Size)
-      {
-        diabin = curSImNeighborDist_Size - 1;
-      }
-      nnum = m_Neighborhoods[gadd];
-      nnumbin = static_cast<size_t>(nnum * oneOverNeighborDistStep);
-      if(nnumbin >= 40)
-      {
-        nnumbin = 39;
+        // Start the Feature in the first bin of its row, updateNeighborDist then moves it to its neighborhood
+        m_NeighborDistPhases[i] = static_cast<int32_t>(iter);
+        m_NeighborDistBins[i] = diabin * numColumns;
+        curSimNeighborDist.add(m_NeighborDistBins[i], 1);
+        updateNeighborDist(i);
       }
-      curSimNeighborDist[diabin][nnumbin]++;
-      count[diabin]++;
     }
-    float runningtotal = 0.0f;
+  }
+}
 
-    for(size_t i = 0; i < curSImNeighborDist_Size; i++)
-    {
-      if(count[i] == 0)
-      {
-        for(size_t j = 0; j < 40; j++)
-        {
-          curSimNeighborDist[i][j] = 0.0f;
-        }
-      }
-      else
-      {
-        float oneOverCount = 1.0f / (float)(count[i]);
-        for(size_t j = 0; j < 40; j++)
-        {
-          curSimNeighborDist[i][j] = curSimNeighborDist[i][j] * oneOverCount;
-          runningtotal = runningtotal + curSimNeighborDist[i][j];
-        }
-      }
-    }
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::updateNeighborDist(size_t gnum)
+{
+  int32_t iter = m_NeighborDistPhases[gnum];
+  if(iter < 0)
+  {
+    return;
+  }
+  PackingDistribution& curSimNeighborDist = m_SimNeighborDist[iter];
+  size_t numColumns = curSimNeighborDist.getNumColumns();
+  float oneOverNeighborDistStep = 1.0f / m_NeighborDistStep[iter];
 
-    runningtotal = 1.0f / runningtotal; // Flip this so that we have a multiply instead of a divide.
-    for(size_t i = 0; i < curSImNeighborDist_Size; i++)
-    {
-      for(size_t j = 0; j < 40; j++)
-      {
-        curSimNeighborDist[i][j] = curSimNeighborDist[i][j] * runningtotal;
-      }
-    }
+  int32_t nnum = m_Neighborhoods[gnum];
+  size_t nnumbin = 0;
+  if(nnum > 0)
+  {
+    nnumbin = static_cast<size_t>(nnum * oneOverNeighborDistStep);
+  }
+  if(nnumbin >= numColumns)
+  {
+    nnumbin = numColumns - 1;
+  }
+  size_t oldBin = m_NeighborDistBins[gnum];
+  size_t newBin = (oldBin / numColumns) * numColumns + nnumbin;
+  if(newBin != oldBin)
+  {
+    curSimNeighborDist.add(oldBin, -1);
+    curSimNeighborDist.add(newBin, 1);
+    m_NeighborDistBins[gnum] = newBin;
+  }
+}
 
-    if(gadd > 0 && m_FeaturePhases[gadd] == phase)
-    {
-      determineNeighbors(gadd, false);
-    }
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float PackPrimaryPhases::checkNeighborhoodError(int32_t gadd, int32_t gremove)
+{
+  float neighborerror = 0.0f;
 
-    if(gremove > 0 && m_FeaturePhases[gremove] == phase)
-    {
-      determineNeighbors(gremove, true);
-    }
+  // determineNeighbors moves the Features whose neighborhoods change, so only the bins touched by gadd and gremove
+  // are updated before the distributions are compared. gadd is counted once more and gremove is left out
+  if(gadd > 0 && m_NeighborDistPhases[gadd] >= 0)
+  {
+    determineNeighbors(gadd, true);
+    m_SimNeighborDist[m_NeighborDistPhases[gadd]].add(m_NeighborDistBins[gadd], 1);
+  }
+  if(gremove > 0 && m_NeighborDistPhases[gremove] >= 0)
+  {
+    determineNeighbors(gremove, false);
+    m_SimNeighborDist[m_NeighborDistPhases[gremove]].add(m_NeighborDistBins[gremove], -1);
+  }
+
+  size_t numPhases = m_SimNeighborDist.size();
+  for(size_t iter = 0; iter < numPhases; ++iter)
+  {
+    neighborerror = neighborerror + m_SimNeighborDist[iter].bhattacharyyaDistance();
+  }
+
+  if(gremove > 0 && m_NeighborDistPhases[gremove] >= 0)
+  {
+    m_SimNeighborDist[m_NeighborDistPhases[gremove]].add(m_NeighborDistBins[gremove], 1);
+    determineNeighbors(gremove, true);
+  }
+  if(gadd > 0 && m_NeighborDistPhases[gadd] >= 0)
+  {
+    m_SimNeighborDist[m_NeighborDistPhases[gadd]].add(m_NeighborDistBins[gadd], -1);
+    determineNeighbors(gadd, false);
   }
-  compare3dDistributions(m_SimNeighborDist, m_NeighborDist, bhattdist);
-  neighborerror = bhattdist;
   return neighborerror;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void PackPrimaryPhases::compare1dDistributions(std::vector<float> array1, std::vector<float> array2, float& bhattdist)
+void PackPrimaryPhases::compare1dDistributions(const std::vector<float>& array1, const std::vector<float>& array2, float& bhattdist)
 {
   bhattdist = 0.0f;
   size_t array1Size = array1.size();
@@ -2079,7 +2153,7 @@ void PackPrimaryPhases::compare1dDistributions(std::vector<float> array1, std::v
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void PackPrimaryPhases::compare2dDistributions(std::vector<std::vector<float>> array1, std::vector<std::vector<float>> array2, float& bhattdist)
+void PackPrimaryPhases::compare2dDistributions(const std::vector<std::vector<float>>& array1, const std::vector<std::vector<float>>& array2, float& bhattdist)
 {
   bhattdist = 0.0f;
   size_t array1Size = array1.size();
@@ -2096,7 +2170,7 @@ void PackPrimaryPhases::compare2dDistributions(std::vector<std::vector<float>> a
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void PackPrimaryPhases::compare3dDistributions(std::vector<std::vector<std::vector<float>>> array1, std::vector<std::vector<std::vector<float>>> array2, float& bhattdist)
+void PackPrimaryPhases::compare3dDistributions(const std::vector<std::vector<std::vector<float>>>& array1, const std::vector<std::vector<std::vector<float>>>& array2, float& bhattdist)
 {
   bhattdist = 0.0f;
   size_t array1Size = array1.size();
@@ -2119,88 +2193,52 @@ void PackPrimaryPhases::compare3dDistributions(std::vector<std::vector<std::vect
 // -----------------------------------------------------------------------------
 float PackPrimaryPhases::checkSizeDistError(Feature_t* feature)
 {
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
+  float sizedisterror = 0.0f;
 
+  // The Features that are already packed stay binned, so only the bin of the new Feature changes
+  updateSizeDist(feature, 1);
+  size_t numPhases = m_SimFeatureSizeDist.size();
+  for(size_t iter = 0; iter < numPhases; ++iter)
+  {
+    sizedisterror = sizedisterror + m_SimFeatureSizeDist[iter].bhattacharyyaDistance();
+  }
+  updateSizeDist(feature, -1);
+  return sizedisterror;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::updateSizeDist(Feature_t* feature, int32_t increment)
+{
   StatsDataArray& statsDataArray = *(m_StatsDataArray.lock().get());
 
-  float dia = 0.0f;
-  float sizedisterror = 0.0f;
-  float bhattdist = 0.0f;
-  int32_t index = 0;
-  int32_t count = 0;
-  int32_t phase = 0;
-  size_t featureSizeDist_Size = m_FeatureSizeDist.size();
-  for(size_t iter = 0; iter < featureSizeDist_Size; ++iter)
+  size_t numPhases = m_SimFeatureSizeDist.size();
+  for(size_t iter = 0; iter < numPhases; ++iter)
   {
-    phase = m_PrimaryPhases[iter];
-    PrimaryStatsData* pp = PrimaryStatsData::SafePointerDownCast(statsDataArray[phase].get());
-    count = 0;
-    std::vector<float>& curFeatureSizeDist = m_FeatureSizeDist[iter];
-    std::vector<float>::size_type curFeatureSizeDistSize = curFeatureSizeDist.size();
-    std::vector<float>& curSimFeatureSizeDist = m_SimFeatureSizeDist[iter];
-    // Initialize all Values to Zero
-    for(size_t i = 0; i < curFeatureSizeDistSize; i++)
+    int32_t phase = m_PrimaryPhases[iter];
+    if(feature->m_FeaturePhases != phase)
     {
-      curSimFeatureSizeDist[i] = 0.0f;
+      continue;
     }
-    int64_t totalFeatures = m->getAttributeMatrix(m_OutputCellFeatureAttributeMatrixName)->getNumberOfTuples();
+    PrimaryStatsData* pp = PrimaryStatsData::SafePointerDownCast(statsDataArray[phase].get());
+    PackingDistribution& curSimFeatureSizeDist = m_SimFeatureSizeDist[iter];
+    float curFeatureSizeDistSize = static_cast<float>(curSimFeatureSizeDist.getNumColumns());
     float oneOverCurFeatureSizeDistStep = 1.0f / m_FeatureSizeDistStep[iter];
     float halfMinFeatureDiameter = pp->getMinFeatureDiameter() * 0.5f;
-    for(int32_t b = m_FirstPrimaryFeature; b < totalFeatures; b++)
-    {
-      index = b;
-      if(m_FeaturePhases[index] == phase)
-      {
-        dia = m_EquivalentDiameters[index];
-        dia = (dia - halfMinFeatureDiameter) * oneOverCurFeatureSizeDistStep;
-        if(dia < 0)
-        {
-          dia = 0.0f;
-        }
-        if(dia > curFeatureSizeDistSize - 1.0f)
-        {
-          dia = curFeatureSizeDistSize - 1.0f;
-        }
-        curSimFeatureSizeDist[int32_t(dia)]++;
-        count++;
-      }
-    }
 
-    if(feature->m_FeaturePhases == phase)
+    float dia = feature->m_EquivalentDiameters;
+    dia = (dia - halfMinFeatureDiameter) * oneOverCurFeatureSizeDistStep;
+    if(dia < 0)
     {
-      dia = feature->m_EquivalentDiameters;
-      dia = (dia - halfMinFeatureDiameter) * oneOverCurFeatureSizeDistStep;
-      if(dia < 0)
-      {
-        dia = 0.0f;
-      }
-      if(dia > curFeatureSizeDistSize - 1.0f)
-      {
-        dia = curFeatureSizeDistSize - 1.0f;
-      }
-      curSimFeatureSizeDist[int32_t(dia)]++;
-      count++;
+      dia = 0.0f;
     }
-    float oneOverCount = 1.0f / count;
-
-    if(count == 0)
+    if(dia > curFeatureSizeDistSize - 1.0f)
     {
-      for(size_t i = 0; i < curFeatureSizeDistSize; i++)
-      {
-        curSimFeatureSizeDist[i] = 0.0;
-      }
-    }
-    else
-    {
-      for(size_t i = 0; i < curFeatureSizeDistSize; i++)
-      {
-        curSimFeatureSizeDist[i] = curSimFeatureSizeDist[i] * oneOverCount;
-      }
+      dia = curFeatureSizeDistSize - 1.0f;
     }
+    curSimFeatureSizeDist.add(static_cast<size_t>(dia), increment);
   }
-  compare2dDistributions(m_SimFeatureSizeDist, m_FeatureSizeDist, bhattdist);
-  sizedisterror = bhattdist;
-  return sizedisterror;
 }
 
 // -----------------------------------------------------------------------------
@@ -2208,11 +2246,20 @@ float PackPrimaryPhases::checkSizeDistError(Feature_t* feature)
 // -----------------------------------------------------------------------------
 float PackPrimaryPhases::checkFillingError(int32_t gadd, int32_t gremove, Int32ArrayType::Pointer featureOwnersPtr, Int32ArrayType::Pointer exclusionOwnersPtr)
 {
-  size_t featureOwnersIdx = 0;
-  int32_t* featureOwners = featureOwnersPtr->getPointer(0);
-  int32_t* exclusionOwners = exclusionOwnersPtr->getPointer(0);
-
   m_FillingError = m_FillingError * float(m_TotalPackingPoints);
+  updatePackingGrid(gadd, gremove, featureOwnersPtr->getPointer(0), exclusionOwnersPtr->getPointer(0), &m_PointsToRemove, &m_PointsToAdd, &m_FillingError);
+  m_FillingError = m_FillingError / float(m_TotalPackingPoints);
+  return m_FillingError;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t PackPrimaryPhases::updatePackingGrid(int32_t gadd, int32_t gremove, int32_t* featureOwners, int32_t* exclusionOwners, std::vector<size_t>* pointsToRemove, std::vector<size_t>* pointsToAdd,
+                                             float* fillingError)
+{
+  size_t featureOwnersIdx = 0;
+  int64_t fillingChange = 0;
   int64_t col = 0, row = 0, plane = 0;
   int32_t k1 = 0, k2 = 0, k3 = 0;
   if(gadd > 0)
@@ -2261,13 +2308,17 @@ float PackPrimaryPhases::checkFillingError(int32_t gadd, int32_t gremove, Int32A
         int32_t currentFeatureOwner = featureOwners[featureOwnersIdx];
         if(efl[i] > 0.1f)
         {
-          if(exclusionOwners[featureOwnersIdx] == 0)
+          if(exclusionOwners[featureOwnersIdx] == 0 && nullptr != pointsToRemove)
           {
-            m_PointsToRemove.push_back(featureOwnersIdx);
+            pointsToRemove->push_back(featureOwnersIdx);
           }
           exclusionOwners[featureOwnersIdx]++;
         }
-        m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
+        fillingChange = fillingChange + (k1 * currentFeatureOwner + k2);
+        if(nullptr != fillingError)
+        {
+          *fillingError = static_cast<float>(*fillingError + ((k1 * currentFeatureOwner + k2)));
+        }
         //        fillingerror = fillingerror + (multiplier * (k1 * currentFeatureOwner  + k2));
         featureOwners[featureOwnersIdx] = currentFeatureOwner + k3;
         packquality = static_cast<float>(packquality + ((currentFeatureOwner) * (currentFeatureOwner)));
@@ -2283,13 +2334,17 @@ float PackPrimaryPhases::checkFillingError(int32_t gadd, int32_t gremove, Int32A
           }
           if(efl[i] > 0.1f)
           {
-            if(exclusionOwners[featureOwnersIdx] == 0)
+            if(exclusionOwners[featureOwnersIdx] == 0 && nullptr != pointsToRemove)
             {
-              m_PointsToRemove.push_back(featureOwnersIdx);
+              pointsToRemove->push_back(featureOwnersIdx);
             }
             exclusionOwners[featureOwnersIdx]++;
           }
-          m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
+          fillingChange = fillingChange + (k1 * currentFeatureOwner + k2);
+          if(nullptr != fillingError)
+          {
+            *fillingError = static_cast<float>(*fillingError + ((k1 * currentFeatureOwner + k2)));
+          }
           //        fillingerror = fillingerror + (multiplier * (k1 * currentFeatureOwner  + k2));
           featureOwners[featureOwnersIdx] = currentFeatureOwner + k3;
           packquality = static_cast<float>(packquality + ((currentFeatureOwner) * (currentFeatureOwner)));
@@ -2344,12 +2399,16 @@ float PackPrimaryPhases::checkFillingError(int32_t gadd, int32_t gremove, Int32A
         if(efl[i] > 0.1f)
         {
           exclusionOwners[featureOwnersIdx]--;
-          if(exclusionOwners[featureOwnersIdx] == 0)
+          if(exclusionOwners[featureOwnersIdx] == 0 && nullptr != pointsToAdd)
           {
-            m_PointsToAdd.push_back(featureOwnersIdx);
+            pointsToAdd->push_back(featureOwnersIdx);
           }
         }
-        m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
+        fillingChange = fillingChange + (k1 * currentFeatureOwner + k2);
+        if(nullptr != fillingError)
+        {
+          *fillingError = static_cast<float>(*fillingError + ((k1 * currentFeatureOwner + k2)));
+        }
         //        fillingerror = fillingerror + (multiplier * (k1 * currentFeatureOwner  + k2));
         featureOwners[featureOwnersIdx] = currentFeatureOwner + k3;
       }
@@ -2362,51 +2421,309 @@ float PackPrimaryPhases::checkFillingError(int32_t gadd, int32_t gremove, Int32A
           if(efl[i] > 0.1f)
           {
             exclusionOwners[featureOwnersIdx]--;
-            if(exclusionOwners[featureOwnersIdx] == 0)
+            if(exclusionOwners[featureOwnersIdx] == 0 && nullptr != pointsToAdd)
             {
-              m_PointsToAdd.push_back(featureOwnersIdx);
+              pointsToAdd->push_back(featureOwnersIdx);
             }
           }
-          m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
+          fillingChange = fillingChange + (k1 * currentFeatureOwner + k2);
+          if(nullptr != fillingError)
+          {
+            *fillingError = static_cast<float>(*fillingError + ((k1 * currentFeatureOwner + k2)));
+          }
           //          fillingerror = fillingerror + (multiplier * (k1 * currentFeatureOwner  + k2));
           featureOwners[featureOwnersIdx] = currentFeatureOwner + k3;
         }
       }
     }
   }
-  m_FillingError = m_FillingError / float(m_TotalPackingPoints);
-  return m_FillingError;
+  return fillingChange;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void PackPrimaryPhases::updateAvailablePoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv)
+bool PackPrimaryPhases::packFeaturesInSlabs(Int32ArrayType::Pointer featureOwnersPtr, Int32ArrayType::Pointer exclusionOwnersPtr, int64_t totalAdjustments, int64_t& triedMoves,
+                                            int64_t& acceptedMoves)
 {
-  size_t removeSize = m_PointsToRemove.size();
-  size_t addSize = m_PointsToAdd.size();
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
+
+  size_t totalFeatures = m->getAttributeMatrix(m_OutputCellFeatureAttributeMatrixName)->getNumberOfTuples();
+  int32_t* featureOwners = featureOwnersPtr->getPointer(0);
+  int32_t* exclusionOwners = exclusionOwnersPtr->getPointer(0);
+  int64_t numPlanes = m_PackingPoints[2];
+
+  if(totalFeatures <= static_cast<size_t>(m_FirstPrimaryFeature))
+  {
+    triedMoves = 0;
+    acceptedMoves = 0;
+    return true;
+  }
+
+  // Moving a Feature shifts all of its planes together, so how far it reaches below and above the plane
+  // of its centroid never changes
+  m_PlaneExtents.assign(2 * totalFeatures, 0);
+  int64_t maxExtent = 1;
+  for(size_t i = m_FirstPrimaryFeature; i < totalFeatures; i++)
+  {
+    int64_t centroidPlane = static_cast<int64_t>((m_Centroids[3 * i + 2] - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2]);
+    int64_t lo = 0, hi = 0;
+    for(size_t j = 0; j < m_PlaneList[i].size(); j++)
+    {
+      lo = std::min(lo, m_PlaneList[i][j] - centroidPlane);
+      hi = std::max(hi, m_PlaneList[i][j] - centroidPlane);
+    }
+    m_PlaneExtents[2 * i] = lo;
+    m_PlaneExtents[2 * i + 1] = hi;
+    maxExtent = std::max(maxExtent, hi - lo + 1);
+  }
+
+  // Each slab is at least twice as thick as the largest Feature, and every other round the slabs are shifted by
+  // half a slab so that the Features lying across a slab border in one round are moved in the next. The number
+  // of slabs does not depend on the number of threads, so a seed always gives the same packing
+  const int32_t k_NumRounds = 20;
+  int64_t numSlabs = numPlanes / (2 * maxExtent);
+  if(numSlabs < 2)
+  {
+    // The slabs are stacked along Z only, so a volume that is thin in Z compared to its largest Feature is packed by the serial chain
+    QString ss = QObject::tr("The volume is %1 packing planes thick along Z, which is less than 4 times the %2 planes of the largest Feature. The Features will be packed serially")
+                     .arg(numPlanes)
+                     .arg(maxExtent);
+    notifyWarningMessage(getHumanLabel(), ss, -1010);
+    return false;
+  }
+  int64_t slabThickness = numPlanes / numSlabs;
+  int64_t movesPerFeature = std::max<int64_t>(1, totalAdjustments / (k_NumRounds * static_cast<int64_t>(totalFeatures - m_FirstPrimaryFeature)));
+
+  std::vector<int64_t> slabStarts(numSlabs, 0);
+  std::vector<int64_t> slabThicknesses(numSlabs, slabThickness);
+  slabThicknesses[numSlabs - 1] = numPlanes - (numSlabs - 1) * slabThickness;
+  std::vector<std::vector<size_t>> slabFeatures(numSlabs);
+  std::vector<int64_t> fillingChanges(numSlabs, 0);
+  std::vector<int64_t> slabAcceptedMoves(numSlabs, 0);
+  triedMoves = 0;
+  acceptedMoves = 0;
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  for(int32_t round = 0; round < k_NumRounds; round++)
+  {
+    if(getCancel() == true)
+    {
+      return true;
+    }
+
+    int64_t offset = (round % 2) * (slabThickness / 2);
+    for(int64_t s = 0; s < numSlabs; s++)
+    {
+      slabStarts[s] = (offset + s * slabThickness) % numPlanes;
+      slabFeatures[s].clear();
+    }
+    for(size_t i = m_FirstPrimaryFeature; i < totalFeatures; i++)
+    {
+      int64_t centroidPlane = static_cast<int64_t>((m_Centroids[3 * i + 2] - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2]);
+      int64_t rel = (centroidPlane - offset) % numPlanes;
+      if(rel < 0)
+      {
+        rel = rel + numPlanes;
+      }
+      int64_t s = std::min(rel / slabThickness, numSlabs - 1);
+      if(isInsideSlab(i, centroidPlane, slabStarts[s], slabThicknesses[s]) == true)
+      {
+        slabFeatures[s].push_back(i);
+      }
+    }
+
+    PackSlabsImpl impl(this, slabStarts.data(), slabThicknesses.data(), slabFeatures.data(), movesPerFeature, m_Seed + static_cast<uint64_t>(round * numSlabs) + 1, featureOwners, exclusionOwners,
+                       fillingChanges.data(), slabAcceptedMoves.data());
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1), impl, tbb::simple_partitioner());
+    }
+    else
+#endif
+    {
+      impl.convert(0, numSlabs);
+    }
+
+    int64_t fillingChange = 0;
+    for(int64_t s = 0; s < numSlabs; s++)
+    {
+      fillingChange += fillingChanges[s];
+      acceptedMoves += slabAcceptedMoves[s];
+      triedMoves += movesPerFeature * static_cast<int64_t>(slabFeatures[s].size());
+    }
+    m_FillingError = m_FillingError * float(m_TotalPackingPoints);
+    m_FillingError = static_cast<float>(m_FillingError + fillingChange);
+    m_FillingError = m_FillingError / float(m_TotalPackingPoints);
+
+    QString ss = QObject::tr("Swapping/Moving Features in %1 Slabs || Round %2/%3 || Filling Error: %4").arg(numSlabs).arg(round + 1).arg(k_NumRounds).arg(m_FillingError);
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+  }
+  m_Seed = m_Seed + static_cast<uint64_t>(k_NumRounds * numSlabs) + 1;
+
+  // The chains do not follow the neighborhoods of the moved Features, so they are determined again
+  m_NeighborDistBins.clear();
+  for(size_t i = m_FirstPrimaryFeature; i < totalFeatures; i++)
+  {
+    m_Neighborhoods[i] = 0;
+  }
+  for(size_t i = m_FirstPrimaryFeature; i < totalFeatures; i++)
+  {
+    determineNeighbors(i, true);
+  }
+  for(size_t i = 0; i < m_SimNeighborDist.size(); i++)
+  {
+    m_SimNeighborDist[i].clear();
+  }
+  initializeNeighborDist();
+  m_OldNeighborhoodError = checkNeighborhoodError(-1000, -1000);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::packSlab(int64_t slabStart, int64_t slabThickness, const std::vector<size_t>& features, int64_t numMoves, uint64_t seed, int32_t* featureOwners, int32_t* exclusionOwners,
+                                 int64_t& fillingChange, int64_t& acceptedMoves)
+{
+  fillingChange = 0;
+  acceptedMoves = 0;
+  size_t numFeatures = features.size();
+  if(numFeatures == 0)
+  {
+    return;
+  }
+
+  SIMPL_RANDOMNG_NEW_SEEDED(seed)
+
+  const int32_t k_JumpAttempts = 100;
   size_t featureOwnersIdx = 0;
-  size_t key = 0, val = 0;
-  for(size_t i = 0; i < removeSize; i++)
+  int64_t column = 0, row = 0, plane = 0;
+  float xc = 0.0f, yc = 0.0f, zc = 0.0f;
+  for(int64_t move = 0; move < numMoves; move++)
   {
-    featureOwnersIdx = m_PointsToRemove[i];
-    key = availablePoints[featureOwnersIdx];
-    //  availablePoints.erase(featureOwnersIdx);
-    val = availablePointsInv[m_AvailablePointsCount - 1];
-    //  availablePointsInv.erase(availablePointsCount-1);
-    if(key < m_AvailablePointsCount - 1)
+    if(move % 1000 == 0 && getCancel() == true)
     {
-      availablePointsInv[key] = val;
-      availablePoints[val] = key;
+      return;
     }
-    m_AvailablePointsCount--;
+
+    // Like the serial chain, prefer a Feature that overlaps another Feature at its centroid
+    size_t first = static_cast<size_t>(rg.genrand_res53() * numFeatures);
+    size_t gnum = features[first];
+    for(size_t count = 0; count < numFeatures; count++)
+    {
+      gnum = features[(first + count) % numFeatures];
+      column = static_cast<int64_t>((m_Centroids[3 * gnum] - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0]);
+      row = static_cast<int64_t>((m_Centroids[3 * gnum + 1] - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1]);
+      plane = static_cast<int64_t>((m_Centroids[3 * gnum + 2] - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2]);
+      featureOwnersIdx = (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + column;
+      if(featureOwners[featureOwnersIdx] > 1)
+      {
+        break;
+      }
+    }
+    float oldxc = m_Centroids[3 * gnum];
+    float oldyc = m_Centroids[3 * gnum + 1];
+    float oldzc = m_Centroids[3 * gnum + 2];
+
+    // JUMP - this option moves the feature to a random available spot in the slab
+    if(move % 2 == 0)
+    {
+      for(int32_t attempt = 0; attempt < k_JumpAttempts; attempt++)
+      {
+        column = static_cast<int64_t>(rg.genrand_res53() * m_PackingPoints[0]);
+        row = static_cast<int64_t>(rg.genrand_res53() * m_PackingPoints[1]);
+        plane = (slabStart + static_cast<int64_t>(rg.genrand_res53() * slabThickness)) % m_PackingPoints[2];
+        featureOwnersIdx = (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + column;
+        if(exclusionOwners[featureOwnersIdx] == 0 && (m_UseMask == false || m_Mask[featureOwnersIdx] == true))
+        {
+          break;
+        }
+      }
+      xc = static_cast<float>((column * m_PackingRes[0]) + (m_PackingRes[0] * 0.5));
+      yc = static_cast<float>((row * m_PackingRes[1]) + (m_PackingRes[1] * 0.5));
+      zc = static_cast<float>((plane * m_PackingRes[2]) + (m_PackingRes[2] * 0.5));
+    }
+    // NUDGE - this option moves the feature to a spot close to its current centroid
+    else
+    {
+      float xshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[0])));
+      float yshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[1])));
+      float zshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[2])));
+      xc = ((oldxc + xshift) < m_SizeX && (oldxc + xshift) > 0) ? oldxc + xshift : oldxc;
+      yc = ((oldyc + yshift) < m_SizeY && (oldyc + yshift) > 0) ? oldyc + yshift : oldyc;
+      zc = ((oldzc + zshift) < m_SizeZ && (oldzc + zshift) > 0) ? oldzc + zshift : oldzc;
+    }
+
+    // A Feature that would reach out of the slab could touch the packing points of another chain
+    plane = static_cast<int64_t>((zc - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2]);
+    if(isInsideSlab(gnum, plane, slabStart, slabThickness) == false)
+    {
+      continue;
+    }
+
+    int64_t change = updatePackingGrid(-1000, static_cast<int32_t>(gnum), featureOwners, exclusionOwners, nullptr, nullptr, nullptr);
+    moveFeature(gnum, xc, yc, zc);
+    change = change + updatePackingGrid(static_cast<int32_t>(gnum), -1000, featureOwners, exclusionOwners, nullptr, nullptr, nullptr);
+    if(change <= 0)
+    {
+      fillingChange = fillingChange + change;
+      acceptedMoves++;
+    }
+    else
+    {
+      updatePackingGrid(-1000, static_cast<int32_t>(gnum), featureOwners, exclusionOwners, nullptr, nullptr, nullptr);
+      moveFeature(gnum, oldxc, oldyc, oldzc);
+      updatePackingGrid(static_cast<int32_t>(gnum), -1000, featureOwners, exclusionOwners, nullptr, nullptr, nullptr);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PackPrimaryPhases::isInsideSlab(size_t gnum, int64_t plane, int64_t slabStart, int64_t slabThickness)
+{
+  int64_t numPlanes = m_PackingPoints[2];
+  int64_t lo = plane + m_PlaneExtents[2 * gnum];
+  int64_t hi = plane + m_PlaneExtents[2 * gnum + 1];
+  if(m_PeriodicBoundaries == false)
+  {
+    // Planes outside of the packing grid are not filled
+    lo = std::max<int64_t>(lo, 0);
+    hi = std::min<int64_t>(hi, numPlanes - 1);
+    if(lo > hi)
+    {
+      return true;
+    }
+  }
+  int64_t rel = (lo - slabStart) % numPlanes;
+  if(rel < 0)
+  {
+    rel = rel + numPlanes;
+  }
+  return (rel + (hi - lo)) < slabThickness;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::updateAvailablePoints(AvailablePoints& availablePoints)
+{
+  size_t removeSize = m_PointsToRemove.size();
+  size_t addSize = m_PointsToAdd.size();
+  for(size_t i = 0; i < removeSize; i++)
+  {
+    availablePoints.remove(m_PointsToRemove[i]);
   }
   for(size_t i = 0; i < addSize; i++)
   {
-    featureOwnersIdx = m_PointsToAdd[i];
-    availablePoints[featureOwnersIdx] = m_AvailablePointsCount;
-    availablePointsInv[m_AvailablePointsCount] = featureOwnersIdx;
-    m_AvailablePointsCount++;
+    availablePoints.insert(m_PointsToAdd[i]);
   }
   m_PointsToRemove.clear();
   m_PointsToAdd.clear();
@@ -44,6 +44,10 @@
 #include "SIMPLib/Geometry/ShapeOps/ShapeOps.h"
 #include "SIMPLib/SIMPLib.h"
 
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/PackingDistribution.hpp"
+
+class AvailablePoints;
+
 typedef struct
 {
   float m_Volumes;
@@ -122,6 +126,16 @@ public:
   SIMPL_FILTER_PARAMETER(bool, WriteGoalAttributes)
   Q_PROPERTY(bool WriteGoalAttributes READ getWriteGoalAttributes WRITE setWriteGoalAttributes)
 
+  SIMPL_FILTER_PARAMETER(bool, PackFeaturesInParallel)
+  Q_PROPERTY(bool PackFeaturesInParallel READ getPackFeaturesInParallel WRITE setPackFeaturesInParallel)
+
+  // Not exposed as filter parameters: seeding with a fixed value instead of the clock makes a run reproducible
+  SIMPL_INSTANCE_PROPERTY(bool, UseFixedSeed)
+  Q_PROPERTY(bool UseFixedSeed READ getUseFixedSeed WRITE setUseFixedSeed)
+
+  SIMPL_INSTANCE_PROPERTY(quint64, FixedSeed)
+  Q_PROPERTY(quint64 FixedSeed READ getFixedSeed WRITE setFixedSeed)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -285,6 +299,13 @@ protected:
    */
   float checkSizeDistError(Feature_t* feature);
 
+  /**
+   * @brief updateSizeDist Adds a Feature to or removes it from the current Feature size distribution
+   * @param feature Feature_t struct pointer to be binned
+   * @param increment 1 to add the Feature, -1 to remove it
+   */
+  void updateSizeDist(Feature_t* feature, int32_t increment);
+
   /**
    * @brief determine_neighbors Determines the neighbors for a given Feature
    * @param gnum Id for the Feature for which to find neighboring Features
@@ -293,6 +314,18 @@ protected:
    */
   void determineNeighbors(size_t gnum, bool add);
 
+  /**
+   * @brief initializeNeighborDist Bins every Feature into the current Feature neighbor distribution, after
+   * which determineNeighbors keeps the distribution up to date
+   */
+  void initializeNeighborDist();
+
+  /**
+   * @brief updateNeighborDist Moves a Feature to the bin of its current neighborhood
+   * @param gnum Id for the Feature to be moved
+   */
+  void updateNeighborDist(size_t gnum);
+
   /**
    * @brief check_neighborhooderror Computes the error between the current Feature neighbor distribution
    * and the goal Feature neighbor distribution
@@ -313,11 +346,63 @@ protected:
   float checkFillingError(int32_t gadd, int32_t gremove, Int32ArrayType::Pointer featureOwnersPtr, Int32ArrayType::Pointer exclusionOwnersPtr);
 
   /**
-   * @brief update_availablepoints Updates the maps used to associate packing points with an "available" state
-   * @param availablePoints Map between Feature owners and number of available points
-   * @param availablePointsInv Inverse associations for the availablePoints map
+   * @brief updatePackingGrid Adds a Feature to or removes it from the packing grid
+   * @param gadd Id of the Feature to add, or a value <= 0 to add none
+   * @param gremove Id of the Feature to remove, or a value <= 0 to remove none
+   * @param featureOwners Number of Features owning each packing point
+   * @param exclusionOwners Number of exclusion zones covering each packing point
+   * @param pointsToRemove Receives the points that enter an exclusion zone, may be nullptr
+   * @param pointsToAdd Receives the points that leave all exclusion zones, may be nullptr
+   * @param fillingError Unnormalized filling error that the change of each packing point is added to in turn, the
+   * same float rounding the serial chain has always had, may be nullptr
+   * @return Change of the number of unassigned or multiple assigned packing points
    */
-  void updateAvailablePoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv);
+  int64_t updatePackingGrid(int32_t gadd, int32_t gremove, int32_t* featureOwners, int32_t* exclusionOwners, std::vector<size_t>* pointsToRemove, std::vector<size_t>* pointsToAdd,
+                            float* fillingError);
+
+  /**
+   * @brief packFeaturesInSlabs Swaps/moves Features with one Monte Carlo chain per slab of Z planes, running
+   * the slabs in parallel
+   * @param featureOwnersPtr Array of Feature Ids for each packing point
+   * @param exclusionOwnersPtr Array of exlusion Ids for each packing point
+   * @param totalAdjustments Number of moves that the serial chain would try
+   * @param triedMoves Receives the number of moves tried by all chains
+   * @param acceptedMoves Receives the number of moves accepted by all chains
+   * @return False, without moving any Feature, if the volume is too thin in Z to hold two slabs
+   */
+  bool packFeaturesInSlabs(Int32ArrayType::Pointer featureOwnersPtr, Int32ArrayType::Pointer exclusionOwnersPtr, int64_t totalAdjustments, int64_t& triedMoves, int64_t& acceptedMoves);
+
+  /**
+   * @brief packSlab Runs the Monte Carlo chain of one slab. Only the Features of the slab are moved, and they
+   * are kept inside the slab, so that the chains of different slabs never touch the same packing point
+   * @param slabStart First Z plane of the slab
+   * @param slabThickness Number of Z planes in the slab
+   * @param features Ids of the Features that lie inside the slab
+   * @param numMoves Number of moves to try
+   * @param seed Seed of the random number generator of the chain
+   * @param featureOwners Number of Features owning each packing point
+   * @param exclusionOwners Number of exclusion zones covering each packing point
+   * @param fillingChange Receives the change of the number of unassigned or multiple assigned packing points
+   * @param acceptedMoves Receives the number of accepted moves
+   */
+  void packSlab(int64_t slabStart, int64_t slabThickness, const std::vector<size_t>& features, int64_t numMoves, uint64_t seed, int32_t* featureOwners, int32_t* exclusionOwners,
+                int64_t& fillingChange, int64_t& acceptedMoves);
+
+  /**
+   * @brief isInsideSlab Returns whether all the packing points of a Feature lie inside a slab of Z planes
+   * @param gnum Id of the Feature
+   * @param plane Z plane of the centroid of the Feature
+   * @param slabStart First Z plane of the slab
+   * @param slabThickness Number of Z planes in the slab
+   * @return Whether the Feature is inside the slab
+   */
+  bool isInsideSlab(size_t gnum, int64_t plane, int64_t slabStart, int64_t slabThickness);
+
+  /**
+   * @brief update_availablepoints Updates the set of packing points with an "available" state
+   * @param availablePoints Set of the packing points that are not in an exclusion zone
+   */
+  void updateAvailablePoints(AvailablePoints& availablePoints);
 
   /**
    * @brief assign_voxels Assigns Feature Id values to voxels within the packing grid
@@ -343,19 +428,19 @@ protected:
    * @brief compare_1Ddistributions Computes the 1D Bhattacharyya distance
    * @param sqrerror Float 1D Bhattacharyya distance
    */
-  void compare1dDistributions(std::vector<float>, std::vector<float>, float& sqrerror);
+  void compare1dDistributions(const std::vector<float>&, const std::vector<float>&, float& sqrerror);
 
   /**
    * @brief compare_2Ddistributions Computes the 2D Bhattacharyya distance
    * @param sqrerror Float 1D Bhattacharyya distance
    */
-  void compare2dDistributions(std::vector<std::vector<float>>, std::vector<std::vector<float>>, float& sqrerror);
+  void compare2dDistributions(const std::vector<std::vector<float>>&, const std::vector<std::vector<float>>&, float& sqrerror);
 
   /**
    * @brief compare_3Ddistributions Computes the 3D Bhattacharyya distance
    * @param sqrerror Float 1D Bhattacharyya distance
    */
-  void compare3dDistributions(std::vector<std::vector<std::vector<float>>>, std::vector<std::vector<std::vector<float>>>, float& sqrerror);
+  void compare3dDistributions(const std::vector<std::vector<std::vector<float>>>&, const std::vector<std::vector<std::vector<float>>>&, float& sqrerror);
 
   /**
    * @brief writeVtkFile Outputs a debug VTK file for visualization
@@ -378,6 +463,8 @@ protected:
   int32_t estimateNumFeatures(size_t xpoints, size_t ypoints, size_t zpoints, float xres, float yres, float zres);
 
 private:
+  friend class PackSlabsImpl;
+
   // Names for the arrays used by the packing algorithm
   // These arrays are temporary and are removed from the Feature Attribute Matrix after completion
   QString m_NeighborhoodsArrayName;
@@ -425,6 +512,7 @@ private:
   std::vector<std::vector<int64_t>> m_RowList;
   std::vector<std::vector<int64_t>> m_PlaneList;
   std::vector<std::vector<float>> m_EllipFuncList;
+  std::vector<int64_t> m_PlaneExtents;
 
   std::vector<size_t> m_PointsToAdd;
   std::vector<size_t> m_PointsToRemove;
@@ -445,10 +533,10 @@ private:
   int64_t m_PackingPoints[3];
   int64_t m_TotalPackingPoints;
 
-  std::vector<std::vector<float>> m_FeatureSizeDist;
-  std::vector<std::vector<float>> m_SimFeatureSizeDist;
-  std::vector<std::vector<std::vector<float>>> m_NeighborDist;
-  std::vector<std::vector<std::vector<float>>> m_SimNeighborDist;
+  std::vector<PackingDistribution> m_SimFeatureSizeDist;
+  std::vector<PackingDistribution> m_SimNeighborDist;
+  std::vector<int32_t> m_NeighborDistPhases;
+  std::vector<size_t> m_NeighborDistBins;
 
   std::vector<float> m_FeatureSizeDistStep;
   std::vector<float> m_NeighborDistStep;
@@ -459,7 +547,6 @@ private:
   std::vector<int32_t> m_PrimaryPhases;
   std::vector<float> m_PrimaryPhaseFractions;
 
-  size_t m_AvailablePointsCount;
   float m_FillingError, m_OldFillingError;
   float m_CurrentNeighborhoodError, m_OldNeighborhoodError;
   float m_CurrentSizeDistError, m_OldSizeDistError;
@@ -55,6 +55,9 @@ endforeach()
 
 
 
+ADD_SIMPL_SUPPORT_HEADER(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} util/AvailablePoints.hpp)
+ADD_SIMPL_SUPPORT_HEADER(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} util/PackingDistribution.hpp)
+ADD_SIMPL_SUPPORT_HEADER(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} util/PrecipitateGrid.hpp)
 
 SIMPL_END_FILTER_GROUP(${SyntheticBuilding_BINARY_DIR} "${_filterGroupName}" "SyntheticBuilding Filters")
 
@@ -0,0 +1,275 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _availablepoints_hpp_
+#define _availablepoints_hpp_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The AvailablePoints class holds the set of packing points that are not inside the exclusion zone of a
+ * Feature, as used by the Pack Primary Phases and Insert Precipitate Phases filters. Points are added, removed and
+ * drawn by their position in the set in constant time.
+ *
+ * By default the set is a dense array of the available points together with the position of every point in that
+ * array (a "sparse set"). A point is removed by moving the last available point into its position, so the order
+ * of the set, and with it the points drawn for a given random sequence, is the same as with the maps the filters
+ * used before. This takes two integers per packing point. For very large packing grids the set can instead be
+ * kept as one bit per packing point plus a count of the set bits for every 64 points. Adding, removing and
+ * drawing then take logarithmic time and the points are ordered by their index.
+ */
+class AvailablePoints
+{
+public:
+  /**
+   * @brief Packing grids with more points than this use the bitmap, which needs about 0.25 bytes instead of
+   * 16 bytes per point
+   */
+  static const size_t k_BitmapThreshold = static_cast<size_t>(1) << 27;
+
+  /**
+   * @param bitmapThreshold Packing grids with more points than this keep the set as a bitmap
+   */
+  AvailablePoints(size_t bitmapThreshold = k_BitmapThreshold)
+  : m_BitmapThreshold(bitmapThreshold)
+  , m_UseBitmap(false)
+  , m_Count(0)
+  , m_TopStep(0)
+  {
+  }
+
+  virtual ~AvailablePoints()
+  {
+  }
+
+  /**
+   * @brief Empties the set for a packing grid of numPoints points
+   * @param numPoints Number of points in the packing grid
+   */
+  void reset(size_t numPoints)
+  {
+    m_UseBitmap = (numPoints > m_BitmapThreshold);
+    m_Count = 0;
+    m_Dense.clear();
+    m_Sparse.clear();
+    m_Bits.clear();
+    m_Tree.clear();
+    if(m_UseBitmap)
+    {
+      size_t numWords = (numPoints + 63) / 64;
+      m_Bits.assign(numWords, 0);
+      m_Tree.assign(numWords + 1, 0);
+      m_TopStep = 1;
+      while(m_TopStep * 2 <= numWords)
+      {
+        m_TopStep *= 2;
+      }
+    }
+    else
+    {
+      size_t notAvailable = k_NotAvailable;
+      m_Dense.resize(numPoints);
+      m_Sparse.assign(numPoints, notAvailable);
+    }
+  }
+
+  /**
+   * @brief Returns whether the set is kept as a bitmap
+   */
+  bool usesBitmap() const
+  {
+    return m_UseBitmap;
+  }
+
+  /**
+   * @brief Returns the number of available points
+   */
+  size_t size() const
+  {
+    return m_Count;
+  }
+
+  /**
+   * @brief Returns whether point is available
+   */
+  bool contains(size_t point) const
+  {
+    if(m_UseBitmap)
+    {
+      return (m_Bits[point / 64] >> (point % 64)) & 1;
+    }
+    return m_Sparse[point] != k_NotAvailable;
+  }
+
+  /**
+   * @brief Makes point available. Points that are already available are left where they are.
+   */
+  void insert(size_t point)
+  {
+    if(contains(point))
+    {
+      return;
+    }
+    if(m_UseBitmap)
+    {
+      m_Bits[point / 64] |= (static_cast<uint64_t>(1) << (point % 64));
+      updateTree(point / 64, 1);
+    }
+    else
+    {
+      m_Dense[m_Count] = point;
+      m_Sparse[point] = m_Count;
+    }
+    m_Count++;
+  }
+
+  /**
+   * @brief Removes point from the available points. Points that are not available are ignored.
+   */
+  void remove(size_t point)
+  {
+    if(!contains(point))
+    {
+      return;
+    }
+    if(m_UseBitmap)
+    {
+      m_Bits[point / 64] &= ~(static_cast<uint64_t>(1) << (point % 64));
+      updateTree(point / 64, -1);
+    }
+    else
+    {
+      size_t key = m_Sparse[point];
+      size_t last = m_Dense[m_Count - 1];
+      m_Dense[key] = last;
+      m_Sparse[last] = key;
+      m_Sparse[point] = k_NotAvailable;
+    }
+    m_Count--;
+  }
+
+  /**
+   * @brief Returns the available point at position key of the set, where key < size()
+   */
+  size_t at(size_t key) const
+  {
+    if(!m_UseBitmap)
+    {
+      return m_Dense[key];
+    }
+
+    // Walk down the Fenwick tree to the word that holds the key'th set bit
+    size_t word = 0;
+    for(size_t step = m_TopStep; step > 0; step /= 2)
+    {
+      if(word + step < m_Tree.size() && m_Tree[word + step] <= key)
+      {
+        word += step;
+        key -= m_Tree[word];
+      }
+    }
+
+    // Then find the remaining set bit inside that word, one byte at a time
+    uint64_t bits = m_Bits[word];
+    size_t bit = 0;
+    while(true)
+    {
+      size_t byteCount = CountBits(bits & 0xFF);
+      if(key < byteCount)
+      {
+        break;
+      }
+      key -= byteCount;
+      bits >>= 8;
+      bit += 8;
+    }
+    while(true)
+    {
+      if((bits & 1) != 0)
+      {
+        if(key == 0)
+        {
+          break;
+        }
+        key--;
+      }
+      bits >>= 1;
+      bit++;
+    }
+    return word * 64 + bit;
+  }
+
+protected:
+  /**
+   * @brief Returns the number of set bits in value
+   */
+  static size_t CountBits(uint64_t value)
+  {
+    value = value - ((value >> 1) & 0x5555555555555555ULL);
+    value = (value & 0x3333333333333333ULL) + ((value >> 2) & 0x3333333333333333ULL);
+    value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<size_t>((value * 0x0101010101010101ULL) >> 56);
+  }
+
+  /**
+   * @brief Adds delta to the set bit count of word in the Fenwick tree
+   */
+  void updateTree(size_t word, int32_t delta)
+  {
+    for(size_t i = word + 1; i < m_Tree.size(); i += (i & (~i + 1)))
+    {
+      m_Tree[i] += delta;
+    }
+  }
+
+private:
+  static const size_t k_NotAvailable = static_cast<size_t>(-1);
+
+  size_t m_BitmapThreshold;
+  bool m_UseBitmap;
+  size_t m_Count;
+
+  std::vector<size_t> m_Dense;
+  std::vector<size_t> m_Sparse;
+
+  std::vector<uint64_t> m_Bits;
+  std::vector<size_t> m_Tree;
+  size_t m_TopStep;
+};
+
+#endif /* _availablepoints_hpp_ */
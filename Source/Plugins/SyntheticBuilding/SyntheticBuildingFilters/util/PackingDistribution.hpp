@@ -0,0 +1,165 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _packingdistribution_hpp_
+#define _packingdistribution_hpp_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The PackingDistribution class holds a histogram of packed Features next to the goal distribution it is
+ * compared against, as used by the Pack Primary Phases and Insert Precipitate Phases filters. The histogram is a
+ * flat array of rows, each row is normalized by the number of Features in it and the filled rows are weighted
+ * equally. The Bhattacharyya coefficient of every row is kept up to date as Features are added and removed, so
+ * moving a Feature between bins only touches those bins and the distance only needs a pass over the rows.
+ */
+class PackingDistribution
+{
+public:
+  PackingDistribution()
+  : m_NumColumns(0)
+  , m_FilledRows(0)
+  {
+  }
+
+  virtual ~PackingDistribution()
+  {
+  }
+
+  /**
+   * @brief Empties the histogram and sets the goal distribution
+   * @param numRows Number of rows
+   * @param numColumns Number of bins per row
+   * @param goal Goal distribution, stored row after row
+   */
+  void initialize(size_t numRows, size_t numColumns, const std::vector<float>& goal)
+  {
+    m_NumColumns = numColumns;
+    m_FilledRows = 0;
+    m_Counts.assign(numRows * numColumns, 0);
+    m_RowCounts.assign(numRows, 0);
+    m_RowCoefficients.assign(numRows, 0.0);
+    m_SqrtGoal.resize(numRows * numColumns);
+    for(size_t i = 0; i < m_SqrtGoal.size(); i++)
+    {
+      m_SqrtGoal[i] = (i < goal.size() && goal[i] > 0.0f) ? sqrt(static_cast<double>(goal[i])) : 0.0;
+    }
+  }
+
+  /**
+   * @brief Removes every Feature from the distribution, keeping the bins and the goal distribution
+   */
+  void clear()
+  {
+    m_FilledRows = 0;
+    std::fill(m_Counts.begin(), m_Counts.end(), 0);
+    std::fill(m_RowCounts.begin(), m_RowCounts.end(), 0);
+    std::fill(m_RowCoefficients.begin(), m_RowCoefficients.end(), 0.0);
+  }
+
+  /**
+   * @brief Returns the number of bins per row
+   */
+  size_t getNumColumns() const
+  {
+    return m_NumColumns;
+  }
+
+  /**
+   * @brief Adds increment Features to bin, which counts the bins of all rows
+   */
+  void add(size_t bin, int32_t increment)
+  {
+    size_t row = bin / m_NumColumns;
+    int32_t oldCount = m_Counts[bin];
+    int32_t newCount = oldCount + increment;
+    m_Counts[bin] = newCount;
+
+    int32_t oldRowCount = m_RowCounts[row];
+    m_RowCounts[row] = oldRowCount + increment;
+    if(oldRowCount == 0 && m_RowCounts[row] != 0)
+    {
+      m_FilledRows++;
+    }
+    if(m_RowCounts[row] == 0)
+    {
+      if(oldRowCount != 0)
+      {
+        m_FilledRows--;
+      }
+      // Start the empty row over so that rounding does not pile up
+      m_RowCoefficients[row] = 0.0;
+      return;
+    }
+    m_RowCoefficients[row] += m_SqrtGoal[bin] * (sqrt(static_cast<double>(newCount)) - sqrt(static_cast<double>(oldCount)));
+  }
+
+  /**
+   * @brief Returns the Bhattacharyya distance, the sum of sqrt(p * q) over all bins, between the normalized
+   * histogram and the goal distribution
+   */
+  float bhattacharyyaDistance() const
+  {
+    if(m_FilledRows == 0)
+    {
+      return 0.0f;
+    }
+    double bhattdist = 0.0;
+    for(size_t i = 0; i < m_RowCounts.size(); i++)
+    {
+      if(m_RowCounts[i] > 0)
+      {
+        bhattdist += m_RowCoefficients[i] / sqrt(static_cast<double>(m_RowCounts[i]) * static_cast<double>(m_FilledRows));
+      }
+    }
+    return static_cast<float>(bhattdist);
+  }
+
+private:
+  size_t m_NumColumns;
+  size_t m_FilledRows;
+
+  std::vector<int32_t> m_Counts;
+  std::vector<int32_t> m_RowCounts;
+  std::vector<double> m_RowCoefficients;
+  std::vector<double> m_SqrtGoal;
+};
+
+#endif /* _packingdistribution_hpp_ */
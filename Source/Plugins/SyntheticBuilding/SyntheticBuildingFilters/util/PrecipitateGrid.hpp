@@ -0,0 +1,278 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _precipitategrid_hpp_
+#define _precipitategrid_hpp_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The PrecipitateGrid class sorts the precipitate centroids of the Insert Precipitate Phases filter into a
+ * uniform grid of cells, with one doubly linked list of Features per cell. The cells are at least as large as the
+ * largest distance that the radial distribution function counts, so the radial distribution function of a
+ * precipitate only needs to visit the precipitates in the 27 cells around it.
+ */
+class PrecipitateGrid
+{
+public:
+  PrecipitateGrid()
+  : m_CellSize(0.0f)
+  {
+    m_Dims[0] = m_Dims[1] = m_Dims[2] = 0;
+  }
+
+  virtual ~PrecipitateGrid()
+  {
+  }
+
+  /**
+   * @brief Largest number of cells along each axis, so that a small cutoff does not create a huge, mostly empty grid
+   */
+  static const int64_t k_MaxGridDim = 128;
+
+  /**
+   * @brief Creates an empty grid over the box [0, boxSize) whose cells are at least cutoff large
+   * @param boxSize Size of the box along X, Y and Z
+   * @param cutoff Smallest cell size
+   * @param numFeatures Number of Features, including the ones that are never put into the grid
+   */
+  void initialize(const float boxSize[3], float cutoff, size_t numFeatures)
+  {
+    m_CellSize = cutoff;
+    for(int32_t d = 0; d < 3; d++)
+    {
+      if(boxSize[d] / float(k_MaxGridDim) > m_CellSize)
+      {
+        m_CellSize = boxSize[d] / float(k_MaxGridDim);
+      }
+    }
+    if(m_CellSize <= 0.0f)
+    {
+      m_CellSize = 1.0f;
+    }
+    for(int32_t d = 0; d < 3; d++)
+    {
+      m_Dims[d] = static_cast<int64_t>(boxSize[d] / m_CellSize) + 1;
+    }
+
+    m_Heads.assign(m_Dims[0] * m_Dims[1] * m_Dims[2], -1);
+    m_Next.assign(numFeatures, -1);
+    m_Prev.assign(numFeatures, -1);
+    m_FeatureCells.assign(numFeatures, -1);
+  }
+
+  /**
+   * @brief Removes all Features and cells
+   */
+  void clear()
+  {
+    m_CellSize = 0.0f;
+    m_Dims[0] = m_Dims[1] = m_Dims[2] = 0;
+    m_Heads.clear();
+    m_Next.clear();
+    m_Prev.clear();
+    m_FeatureCells.clear();
+  }
+
+  /**
+   * @brief Returns whether the grid has been initialized
+   */
+  bool isEmpty() const
+  {
+    return m_FeatureCells.empty();
+  }
+
+  /**
+   * @brief Returns the size of the cells
+   */
+  float getCellSize() const
+  {
+    return m_CellSize;
+  }
+
+  /**
+   * @brief Finds the cell that holds point. Points outside of the box are clamped to the cells on its faces.
+   */
+  void findCell(const float* point, int64_t cell[3]) const
+  {
+    for(int32_t d = 0; d < 3; d++)
+    {
+      cell[d] = static_cast<int64_t>(point[d] / m_CellSize);
+      if(cell[d] < 0)
+      {
+        cell[d] = 0;
+      }
+      if(cell[d] >= m_Dims[d])
+      {
+        cell[d] = m_Dims[d] - 1;
+      }
+    }
+  }
+
+  /**
+   * @brief Moves Feature gnum to the cell of its centroid, adding it to the grid if it is not in it yet
+   */
+  void update(int32_t gnum, const float* centroid)
+  {
+    int64_t cell[3] = {0, 0, 0};
+    findCell(centroid, cell);
+    int64_t gridCell = (cell[2] * m_Dims[1] + cell[1]) * m_Dims[0] + cell[0];
+    int64_t oldCell = m_FeatureCells[gnum];
+    if(gridCell == oldCell)
+    {
+      return;
+    }
+
+    // Unlink the precipitate from its old cell
+    if(oldCell != -1)
+    {
+      if(m_Prev[gnum] != -1)
+      {
+        m_Next[m_Prev[gnum]] = m_Next[gnum];
+      }
+      else
+      {
+        m_Heads[oldCell] = m_Next[gnum];
+      }
+      if(m_Next[gnum] != -1)
+      {
+        m_Prev[m_Next[gnum]] = m_Prev[gnum];
+      }
+    }
+
+    // Link it in front of the new cell
+    m_Prev[gnum] = -1;
+    m_Next[gnum] = m_Heads[gridCell];
+    if(m_Heads[gridCell] != -1)
+    {
+      m_Prev[m_Heads[gridCell]] = gnum;
+    }
+    m_Heads[gridCell] = gnum;
+    m_FeatureCells[gnum] = gridCell;
+  }
+
+  /**
+   * @brief Calls the function with the Id of every Feature in the 27 cells around the cell of point
+   */
+  template <typename Function> void forEachNeighbor(const float* point, Function function) const
+  {
+    int64_t cell[3] = {0, 0, 0};
+    findCell(point, cell);
+    int64_t start[3] = {0, 0, 0};
+    int64_t end[3] = {0, 0, 0};
+    for(int32_t d = 0; d < 3; d++)
+    {
+      start[d] = (cell[d] > 0) ? cell[d] - 1 : 0;
+      end[d] = (cell[d] < m_Dims[d] - 1) ? cell[d] + 1 : m_Dims[d] - 1;
+    }
+    for(int64_t k = start[2]; k <= end[2]; k++)
+    {
+      for(int64_t j = start[1]; j <= end[1]; j++)
+      {
+        for(int64_t i = start[0]; i <= end[0]; i++)
+        {
+          int64_t gridCell = (k * m_Dims[1] + j) * m_Dims[0] + i;
+          for(int32_t n = m_Heads[gridCell]; n != -1; n = m_Next[n])
+          {
+            function(n);
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Adds increment to the radial distribution function bins of the distances between Feature gnum and the
+   * other Features of its phase, and keeps the normalized bins in step with the counts. Bin 0 holds the distances
+   * below rdfMin and only the distances of the first numBins bins above it are counted, which requires the cells
+   * to be larger than rdfMin + numBins * stepSize.
+   * @param gnum Feature to add or remove
+   * @param centroids X, Y and Z centroid of every Feature
+   * @param phases Phase of every Feature
+   * @param rdfMin Smallest distance of bin 1
+   * @param stepSize Width of the bins
+   * @param numBins Number of bins above rdfMin
+   * @param increment Value to add to the bins
+   * @param rdfRandom Radial distribution function of random points that normalizes the counts
+   * @param rdf Counts of the distances
+   * @param rdfNorm Normalized counts of the distances
+   */
+  void accumulateRDF(int32_t gnum, const float* centroids, const int32_t* phases, float rdfMin, float stepSize, int32_t numBins, float increment, const std::vector<float>& rdfRandom,
+                     std::vector<float>& rdf, std::vector<float>& rdfNorm) const
+  {
+    const float* point = centroids + 3 * gnum;
+    int32_t phase = phases[gnum];
+    forEachNeighbor(point, [&](int32_t n) {
+      if(phases[n] != phase || n == gnum)
+      {
+        return;
+      }
+      float xn = centroids[3 * n];
+      float yn = centroids[3 * n + 1];
+      float zn = centroids[3 * n + 2];
+      float r = sqrtf((point[0] - xn) * (point[0] - xn) + (point[1] - yn) * (point[1] - yn) + (point[2] - zn) * (point[2] - zn));
+
+      int32_t rdfBin = (r - rdfMin) / stepSize;
+      if(r < rdfMin)
+      {
+        rdfBin = -1;
+      }
+      if(rdfBin >= numBins)
+      {
+        return;
+      }
+
+      rdf[rdfBin + 1] += increment;
+      rdfNorm[rdfBin + 1] = rdf[rdfBin + 1] / rdfRandom[rdfBin + 1];
+    });
+  }
+
+private:
+  PrecipitateGrid(const PrecipitateGrid&); // Copy Constructor Not Implemented
+  void operator=(const PrecipitateGrid&);  // Operator '=' Not Implemented
+
+  float m_CellSize;
+  int64_t m_Dims[3];
+  std::vector<int32_t> m_Heads;
+  std::vector<int32_t> m_Next;
+  std::vector<int32_t> m_Prev;
+  std::vector<int64_t> m_FeatureCells;
+};
+
+#endif /* _precipitategrid_hpp_ */
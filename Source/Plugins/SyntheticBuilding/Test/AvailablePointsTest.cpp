@@ -0,0 +1,206 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/AvailablePoints.hpp"
+
+class AvailablePointsTest
+{
+public:
+  AvailablePointsTest()
+  {
+  }
+  virtual ~AvailablePointsTest()
+  {
+  }
+  SIMPL_TYPE_MACRO(AvailablePointsTest)
+
+  // -----------------------------------------------------------------------------
+  // Checks the set against the reference, which lists the available points in the order of the set
+  // -----------------------------------------------------------------------------
+  void CompareToReference(const AvailablePoints& points, const std::vector<size_t>& reference, size_t numPoints)
+  {
+    DREAM3D_REQUIRE_EQUAL(points.size(), reference.size())
+    for(size_t key = 0; key < reference.size(); key++)
+    {
+      DREAM3D_REQUIRE_EQUAL(points.at(key), reference[key])
+    }
+    std::vector<bool> available(numPoints, false);
+    for(size_t key = 0; key < reference.size(); key++)
+    {
+      available[reference[key]] = true;
+    }
+    for(size_t point = 0; point < numPoints; point++)
+    {
+      DREAM3D_REQUIRE_EQUAL(points.contains(point), available[point])
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Inserts and removes random points. The sparse set keeps the points in the order the filters used to draw
+  // them from: a removed point is replaced by the last one. The bitmap keeps them ordered by their index.
+  // -----------------------------------------------------------------------------
+  void RunRandomOperations(AvailablePoints& points, size_t numPoints, bool useBitmap)
+  {
+    std::mt19937 generator(5489u);
+    std::uniform_int_distribution<size_t> pointDistribution(0, numPoints - 1);
+    std::uniform_int_distribution<int32_t> operationDistribution(0, 2);
+
+    points.reset(numPoints);
+    DREAM3D_REQUIRE_EQUAL(points.usesBitmap(), useBitmap)
+    std::vector<size_t> reference;
+    std::vector<bool> available(numPoints, false);
+    std::vector<size_t> position(numPoints, 0);
+    CompareToReference(points, reference, numPoints);
+
+    for(int32_t step = 0; step < 20000; step++)
+    {
+      size_t point = pointDistribution(generator);
+      if(operationDistribution(generator) != 0)
+      {
+        points.insert(point);
+        if(available[point] == false)
+        {
+          available[point] = true;
+          if(useBitmap)
+          {
+            reference.insert(std::lower_bound(reference.begin(), reference.end(), point), point);
+          }
+          else
+          {
+            position[point] = reference.size();
+            reference.push_back(point);
+          }
+        }
+      }
+      else
+      {
+        points.remove(point);
+        if(available[point] == true)
+        {
+          available[point] = false;
+          if(useBitmap)
+          {
+            reference.erase(std::lower_bound(reference.begin(), reference.end(), point));
+          }
+          else
+          {
+            size_t last = reference.back();
+            reference[position[point]] = last;
+            position[last] = position[point];
+            reference.pop_back();
+          }
+        }
+      }
+
+      if(step % 1000 == 0)
+      {
+        CompareToReference(points, reference, numPoints);
+      }
+    }
+    CompareToReference(points, reference, numPoints);
+
+    // Resetting empties the set
+    points.reset(numPoints);
+    DREAM3D_REQUIRE_EQUAL(points.size(), 0)
+    CompareToReference(points, std::vector<size_t>(), numPoints);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestSparseSet()
+  {
+    AvailablePoints points;
+    RunRandomOperations(points, 1000, false);
+    RunRandomOperations(points, 1, false);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // A threshold of zero makes every packing grid use the bitmap. The sizes cover a single word, whole words and
+  // a partial last word of the bitmap.
+  // -----------------------------------------------------------------------------
+  int TestBitmap()
+  {
+    AvailablePoints points(0);
+    RunRandomOperations(points, 1000, true);
+    RunRandomOperations(points, 64, true);
+    RunRandomOperations(points, 1, true);
+    RunRandomOperations(points, 4096 + 5, true);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestBitmapThreshold()
+  {
+    AvailablePoints points(100);
+    points.reset(100);
+    DREAM3D_REQUIRE_EQUAL(points.usesBitmap(), false)
+    points.reset(101);
+    DREAM3D_REQUIRE_EQUAL(points.usesBitmap(), true)
+
+    AvailablePoints defaultPoints;
+    defaultPoints.reset(1000);
+    DREAM3D_REQUIRE_EQUAL(defaultPoints.usesBitmap(), false)
+    return EXIT_SUCCESS;
+  }
+
+  /**
+  * @brief
+  */
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestSparseSet())
+    DREAM3D_REGISTER_TEST(TestBitmap())
+    DREAM3D_REGISTER_TEST(TestBitmapThreshold())
+  }
+
+private:
+  AvailablePointsTest(const AvailablePointsTest&); // Copy Constructor Not Implemented
+  void operator=(const AvailablePointsTest&);      // Operator '=' Not Implemented
+};
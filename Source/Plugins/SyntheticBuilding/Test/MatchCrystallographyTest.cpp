@@ -0,0 +1,359 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/DataArrays/StatsDataArray.h"
+#include "SIMPLib/FilterParameters/FloatVec3FilterParameter.h"
+#include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
+#include "SIMPLib/FilterParameters/JsonFilterParametersReader.h"
+#include "SIMPLib/StatsData/PrimaryStatsData.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "OrientationLib/LaueOps/LaueOps.h"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
+#include "SyntheticBuildingTestFileLocations.h"
+
+namespace MatchCrystallographyTestConsts
+{
+const QString k_StatsDataContainerName("StatsGeneratorDataContainer");
+const QString k_DataContainerName("SyntheticVolumeDataContainer");
+const QString k_CellAttributeMatrixName("CellData");
+const QString k_CellFeatureAttributeMatrixName("CellFeatureData");
+const QString k_CellEnsembleAttributeMatrixName("CellEnsembleData");
+const quint64 k_PackingSeed = 5489;
+const quint64 k_MatchingSeed = 1234;
+const int k_MaxIterations = 20000;
+}
+
+class MatchCrystallographyTest
+{
+public:
+  MatchCrystallographyTest()
+  {
+  }
+  virtual ~MatchCrystallographyTest()
+  {
+  }
+  SIMPL_TYPE_MACRO(MatchCrystallographyTest)
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the MatchCrystallography Filter from the FilterManager
+    QString filtName = "MatchCrystallography";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The MatchCrystallographyTest requires the use of the " << filtName.toStdString() << " filter which is found in the SyntheticBuilding Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs the single cubic phase example pipeline up to and including the matching on a small volume. The packing
+  // and the matching are both seeded, so the same seeds always build the same volume
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer MatchOrientations(DataContainerArray::Pointer dca, quint64 seed)
+  {
+    FilterPipeline::Pointer pipeline = JsonFilterParametersReader::ReadPipelineFromFile(UnitTest::MatchCrystallographyTest::SyntheticPipelineFile);
+    DREAM3D_REQUIRE_VALID_POINTER(pipeline.get())
+    FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+    DREAM3D_REQUIRE(filters.size() > 5)
+
+    IntVec3_t dims = {32, 32, 32};
+    FloatVec3_t res = {2.0f, 2.0f, 2.0f};
+    QVariant var;
+    var.setValue(dims);
+    bool ok = filters[1]->setProperty("Dimensions", var);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+    var.setValue(res);
+    ok = filters[1]->setProperty("Resolution", var);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+
+    AbstractFilter::Pointer packer = filters[3];
+    DREAM3D_REQUIRE_EQUAL(packer->getNameOfClass(), QString("PackPrimaryPhases"))
+    ok = packer->setProperty("UseFixedSeed", true);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+    ok = packer->setProperty("FixedSeed", MatchCrystallographyTestConsts::k_PackingSeed);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+
+    AbstractFilter::Pointer matcher = filters[5];
+    DREAM3D_REQUIRE_EQUAL(matcher->getNameOfClass(), QString("MatchCrystallography"))
+    ok = matcher->setProperty("UseFixedSeed", true);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+    ok = matcher->setProperty("FixedSeed", seed);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+    ok = matcher->setProperty("MaxIterations", MatchCrystallographyTestConsts::k_MaxIterations);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+
+    for(int32_t i = 0; i < 6; i++)
+    {
+      filters[i]->setDataContainerArray(dca);
+      filters[i]->execute();
+      DREAM3D_REQUIRE(filters[i]->getErrorCondition() >= 0)
+    }
+    return matcher;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AttributeMatrix::Pointer GetAttributeMatrix(DataContainerArray::Pointer dca, const QString& dcName, const QString& amName)
+  {
+    AttributeMatrix::Pointer attrMat = dca->getAttributeMatrix(DataArrayPath(dcName, amName, ""));
+    DREAM3D_REQUIRE_VALID_POINTER(attrMat.get())
+    return attrMat;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Bins the matched orientations into a new ODF and MDF, the way the filter sets them up before it starts
+  // swapping, and returns the squared errors against the goal distributions
+  // -----------------------------------------------------------------------------
+  void RecomputeErrors(DataContainerArray::Pointer dca, double& odfError, double& mdfError)
+  {
+    AttributeMatrix::Pointer featureAttrMat =
+        GetAttributeMatrix(dca, MatchCrystallographyTestConsts::k_DataContainerName, MatchCrystallographyTestConsts::k_CellFeatureAttributeMatrixName);
+    AttributeMatrix::Pointer ensembleAttrMat =
+        GetAttributeMatrix(dca, MatchCrystallographyTestConsts::k_StatsDataContainerName, MatchCrystallographyTestConsts::k_CellEnsembleAttributeMatrixName);
+
+    FloatArrayType::Pointer eulersPtr = featureAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::EulerAngles);
+    FloatArrayType::Pointer avgQuatsPtr = featureAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::AvgQuats);
+    FloatArrayType::Pointer volumesPtr = featureAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::Volumes);
+    Int32ArrayType::Pointer phasesPtr = featureAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::FeatureData::Phases);
+    BoolArrayType::Pointer surfaceFeaturesPtr = featureAttrMat->getAttributeArrayAs<BoolArrayType>(SIMPL::FeatureData::SurfaceFeatures);
+    NeighborList<int32_t>::Pointer neighborListPtr = featureAttrMat->getAttributeArrayAs<NeighborList<int32_t>>(SIMPL::FeatureData::NeighborList);
+    NeighborList<float>::Pointer sharedSurfaceAreaListPtr = featureAttrMat->getAttributeArrayAs<NeighborList<float>>(SIMPL::FeatureData::SharedSurfaceAreaList);
+    DREAM3D_REQUIRE_VALID_POINTER(eulersPtr.get())
+    DREAM3D_REQUIRE_VALID_POINTER(avgQuatsPtr.get())
+    DREAM3D_REQUIRE_VALID_POINTER(volumesPtr.get())
+    DREAM3D_REQUIRE_VALID_POINTER(phasesPtr.get())
+    DREAM3D_REQUIRE_VALID_POINTER(surfaceFeaturesPtr.get())
+    DREAM3D_REQUIRE_VALID_POINTER(neighborListPtr.get())
+    DREAM3D_REQUIRE_VALID_POINTER(sharedSurfaceAreaListPtr.get())
+
+    StatsDataArray::Pointer statsDataArray = ensembleAttrMat->getAttributeArrayAs<StatsDataArray>(SIMPL::EnsembleData::Statistics);
+    UInt32ArrayType::Pointer crystalStructures = ensembleAttrMat->getAttributeArrayAs<UInt32ArrayType>(SIMPL::EnsembleData::CrystalStructures);
+    DREAM3D_REQUIRE_VALID_POINTER(statsDataArray.get())
+    DREAM3D_REQUIRE_VALID_POINTER(crystalStructures.get())
+
+    // The example pipeline has a single primary phase, which is the phase the filter matched last
+    DREAM3D_REQUIRE_EQUAL(crystalStructures->getNumberOfTuples(), 2)
+    int32_t ensem = 1;
+    PrimaryStatsData* pp = PrimaryStatsData::SafePointerDownCast(statsDataArray->getStatsData(ensem).get());
+    DREAM3D_REQUIRE_VALID_POINTER(pp)
+    FloatArrayType::Pointer actualOdf = pp->getODF();
+    FloatArrayType::Pointer actualMdf = pp->getMisorientationBins();
+    LaueOps::Pointer ops = LaueOps::getOrientationOpsQVector()[crystalStructures->getValue(ensem)];
+
+    float* eulers = eulersPtr->getPointer(0);
+    QuatF* avgQuats = reinterpret_cast<QuatF*>(avgQuatsPtr->getPointer(0));
+    float* volumes = volumesPtr->getPointer(0);
+    int32_t* phases = phasesPtr->getPointer(0);
+    bool* surfaceFeatures = surfaceFeaturesPtr->getPointer(0);
+    NeighborList<int32_t>& neighborlist = *neighborListPtr;
+    NeighborList<float>& neighborsurfacearealist = *sharedSurfaceAreaListPtr;
+    size_t totalFeatures = phasesPtr->getNumberOfTuples();
+    DREAM3D_REQUIRE(totalFeatures > 10)
+
+    double unbiasedVolume = 0.0;
+    double totalSurfaceArea = 0.0;
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      if(phases[i] != ensem)
+      {
+        continue;
+      }
+      if(surfaceFeatures[i] == false)
+      {
+        unbiasedVolume += volumes[i];
+      }
+      DREAM3D_REQUIRE_EQUAL(neighborsurfacearealist[i].size(), neighborlist[i].size())
+      for(size_t j = 0; j < neighborlist[i].size(); j++)
+      {
+        if(phases[neighborlist[i][j]] == ensem)
+        {
+          totalSurfaceArea += neighborsurfacearealist[i][j];
+        }
+      }
+    }
+    DREAM3D_REQUIRE(unbiasedVolume > 0.0)
+    DREAM3D_REQUIRE(totalSurfaceArea > 0.0)
+
+    std::vector<double> simOdf(actualOdf->getNumberOfTuples(), 0.0);
+    std::vector<double> simMdf(actualMdf->getNumberOfTuples(), 0.0);
+    FOrientArrayType rod(4);
+    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      if(phases[i] != ensem || surfaceFeatures[i] == true)
+      {
+        continue;
+      }
+      FOrientTransformsType::eu2ro(FOrientArrayType(&(eulers[3 * i]), 3), rod);
+      int32_t odfBin = ops->getOdfBin(rod);
+      DREAM3D_REQUIRE(odfBin >= 0 && static_cast<size_t>(odfBin) < simOdf.size())
+      simOdf[odfBin] += volumes[i] / unbiasedVolume;
+
+      // Each boundary is counted once, from the first of its Features that is not on the surface
+      for(size_t j = 0; j < neighborlist[i].size(); j++)
+      {
+        int32_t nname = neighborlist[i][j];
+        if(nname <= 0 || phases[nname] != ensem || (nname < static_cast<int32_t>(i) && surfaceFeatures[nname] == false))
+        {
+          continue;
+        }
+        float w = ops->getMisoQuat(avgQuats[i], avgQuats[nname], n1, n2, n3);
+        FOrientTransformsType::ax2ro(FOrientArrayType(n1, n2, n3, w), rod);
+        int32_t mdfBin = ops->getMisoBin(rod);
+        DREAM3D_REQUIRE(mdfBin >= 0 && static_cast<size_t>(mdfBin) < simMdf.size())
+        simMdf[mdfBin] += neighborsurfacearealist[i][j] / totalSurfaceArea;
+      }
+    }
+
+    odfError = 0.0;
+    for(size_t i = 0; i < simOdf.size(); i++)
+    {
+      double delta = actualOdf->getValue(i) - simOdf[i];
+      odfError += delta * delta;
+    }
+    mdfError = 0.0;
+    for(size_t i = 0; i < simMdf.size(); i++)
+    {
+      double delta = actualMdf->getValue(i) - simMdf[i];
+      mdfError += delta * delta;
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // The filter only updates the bins and errors that a swap changes, so after thousands of swaps the errors it
+  // tracked must still be those of the orientations it ends up with
+  // -----------------------------------------------------------------------------
+  int TestTrackedErrors()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    AbstractFilter::Pointer matcher = MatchOrientations(dca, MatchCrystallographyTestConsts::k_MatchingSeed);
+
+    double trackedOdfError = matcher->property("OdfError").toDouble();
+    double trackedMdfError = matcher->property("MdfError").toDouble();
+    double odfError = 0.0;
+    double mdfError = 0.0;
+    RecomputeErrors(dca, odfError, mdfError);
+
+    DREAM3D_REQUIRE(odfError > 0.0)
+    DREAM3D_REQUIRE(mdfError > 0.0)
+    // The filter keeps the bins in floats, so allow for their rounding
+    DREAM3D_REQUIRED(std::fabs(trackedOdfError - odfError), <=, 1.0e-4 * odfError + 1.0e-7)
+    DREAM3D_REQUIRED(std::fabs(trackedMdfError - mdfError), <=, 1.0e-4 * mdfError + 1.0e-7)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The swaps are evaluated in parallel batches but judged in the order they were drawn, so a seed always gives
+  // the same orientations
+  // -----------------------------------------------------------------------------
+  int TestFixedSeed()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    AbstractFilter::Pointer matcher = MatchOrientations(dca, MatchCrystallographyTestConsts::k_MatchingSeed);
+    DataContainerArray::Pointer repeatedDca = DataContainerArray::New();
+    AbstractFilter::Pointer repeatedMatcher = MatchOrientations(repeatedDca, MatchCrystallographyTestConsts::k_MatchingSeed);
+
+    DREAM3D_REQUIRE_EQUAL(matcher->property("OdfError").toDouble(), repeatedMatcher->property("OdfError").toDouble())
+    DREAM3D_REQUIRE_EQUAL(matcher->property("MdfError").toDouble(), repeatedMatcher->property("MdfError").toDouble())
+
+    AttributeMatrix::Pointer featureAttrMat =
+        GetAttributeMatrix(dca, MatchCrystallographyTestConsts::k_DataContainerName, MatchCrystallographyTestConsts::k_CellFeatureAttributeMatrixName);
+    AttributeMatrix::Pointer repeatedFeatureAttrMat =
+        GetAttributeMatrix(repeatedDca, MatchCrystallographyTestConsts::k_DataContainerName, MatchCrystallographyTestConsts::k_CellFeatureAttributeMatrixName);
+    AttributeMatrix::Pointer cellAttrMat = GetAttributeMatrix(dca, MatchCrystallographyTestConsts::k_DataContainerName, MatchCrystallographyTestConsts::k_CellAttributeMatrixName);
+    AttributeMatrix::Pointer repeatedCellAttrMat =
+        GetAttributeMatrix(repeatedDca, MatchCrystallographyTestConsts::k_DataContainerName, MatchCrystallographyTestConsts::k_CellAttributeMatrixName);
+
+    QVector<FloatArrayType::Pointer> arrays;
+    QVector<FloatArrayType::Pointer> repeatedArrays;
+    arrays << featureAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::EulerAngles) << featureAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::AvgQuats)
+           << cellAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::EulerAngles);
+    repeatedArrays << repeatedFeatureAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::EulerAngles)
+                   << repeatedFeatureAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::AvgQuats)
+                   << repeatedCellAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::EulerAngles);
+    for(int32_t a = 0; a < arrays.size(); a++)
+    {
+      DREAM3D_REQUIRE_VALID_POINTER(arrays[a].get())
+      DREAM3D_REQUIRE_VALID_POINTER(repeatedArrays[a].get())
+      DREAM3D_REQUIRE_EQUAL(arrays[a]->getSize(), repeatedArrays[a]->getSize())
+      for(size_t i = 0; i < arrays[a]->getSize(); i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(arrays[a]->getValue(i), repeatedArrays[a]->getValue(i))
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestTrackedErrors())
+    DREAM3D_REGISTER_TEST(TestFixedSeed())
+  }
+
+private:
+  MatchCrystallographyTest(const MatchCrystallographyTest&); // Copy Constructor Not Implemented
+  void operator=(const MatchCrystallographyTest&);           // Operator '=' Not Implemented
+};
@@ -0,0 +1,223 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/FilterParameters/FloatVec3FilterParameter.h"
+#include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
+#include "SIMPLib/FilterParameters/JsonFilterParametersReader.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "SyntheticBuildingTestFileLocations.h"
+
+namespace PackPrimaryPhasesTestConsts
+{
+const QString k_DataContainerName("SyntheticVolumeDataContainer");
+const QString k_CellAttributeMatrixName("CellData");
+const QString k_CellFeatureAttributeMatrixName("CellFeatureData");
+const quint64 k_Seed = 5489;
+const float k_Resolution = 2.0f;
+}
+
+class PackPrimaryPhasesTest
+{
+public:
+  PackPrimaryPhasesTest()
+  {
+  }
+  virtual ~PackPrimaryPhasesTest()
+  {
+  }
+  SIMPL_TYPE_MACRO(PackPrimaryPhasesTest)
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the PackPrimaryPhases Filter from the FilterManager
+    QString filtName = "PackPrimaryPhases";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The PackPrimaryPhasesTest requires the use of the " << filtName.toStdString() << " filter which is found in the SyntheticBuilding Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs the statistics, volume, shape type and packing filters of the single cubic phase
+  // example pipeline on a volume that is long enough in Z to hold several slabs
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer PackFeatures(bool inParallel)
+  {
+    FilterPipeline::Pointer pipeline = JsonFilterParametersReader::ReadPipelineFromFile(UnitTest::PackPrimaryPhasesTest::SyntheticPipelineFile);
+    DREAM3D_REQUIRE_VALID_POINTER(pipeline.get())
+    FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+    DREAM3D_REQUIRE(filters.size() > 4)
+
+    IntVec3_t dims = {32, 32, 96};
+    FloatVec3_t res = {PackPrimaryPhasesTestConsts::k_Resolution, PackPrimaryPhasesTestConsts::k_Resolution, PackPrimaryPhasesTestConsts::k_Resolution};
+    QVariant var;
+    var.setValue(dims);
+    bool ok = filters[1]->setProperty("Dimensions", var);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+    var.setValue(res);
+    ok = filters[1]->setProperty("Resolution", var);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+
+    AbstractFilter::Pointer packer = filters[3];
+    DREAM3D_REQUIRE_EQUAL(packer->getNameOfClass(), QString("PackPrimaryPhases"))
+    ok = packer->setProperty("PackFeaturesInParallel", inParallel);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+    ok = packer->setProperty("UseFixedSeed", true);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+    ok = packer->setProperty("FixedSeed", PackPrimaryPhasesTestConsts::k_Seed);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    for(int32_t i = 0; i < 4; i++)
+    {
+      filters[i]->setDataContainerArray(dca);
+      filters[i]->execute();
+      DREAM3D_REQUIRE(filters[i]->getErrorCondition() >= 0)
+    }
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  Int32ArrayType::Pointer GetFeatureIds(DataContainerArray::Pointer dca)
+  {
+    AttributeMatrix::Pointer cellAttrMat = dca->getAttributeMatrix(DataArrayPath(PackPrimaryPhasesTestConsts::k_DataContainerName, PackPrimaryPhasesTestConsts::k_CellAttributeMatrixName, ""));
+    DREAM3D_REQUIRE_VALID_POINTER(cellAttrMat.get())
+    Int32ArrayType::Pointer featureIds = cellAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds);
+    DREAM3D_REQUIRE_VALID_POINTER(featureIds.get())
+    return featureIds;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Overlapping Features lose cells to each other and gaps are grown into, so the volume
+  // each Feature ends up with differs from its goal volume by how badly the volume was packed
+  // -----------------------------------------------------------------------------
+  float PackingError(DataContainerArray::Pointer dca)
+  {
+    AttributeMatrix::Pointer featureAttrMat =
+        dca->getAttributeMatrix(DataArrayPath(PackPrimaryPhasesTestConsts::k_DataContainerName, PackPrimaryPhasesTestConsts::k_CellFeatureAttributeMatrixName, ""));
+    DREAM3D_REQUIRE_VALID_POINTER(featureAttrMat.get())
+
+    Int32ArrayType::Pointer featureIds = GetFeatureIds(dca);
+    FloatArrayType::Pointer volumes = featureAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::Volumes);
+    DREAM3D_REQUIRE_VALID_POINTER(volumes.get())
+
+    size_t numFeatures = volumes->getNumberOfTuples();
+    DREAM3D_REQUIRE(numFeatures > 10)
+    std::vector<size_t> counts(numFeatures, 0);
+    for(size_t i = 0; i < featureIds->getNumberOfTuples(); i++)
+    {
+      int32_t gnum = featureIds->getValue(i);
+      DREAM3D_REQUIRE(gnum >= 0 && static_cast<size_t>(gnum) < numFeatures)
+      counts[gnum]++;
+    }
+
+    float cellVolume = PackPrimaryPhasesTestConsts::k_Resolution * PackPrimaryPhasesTestConsts::k_Resolution * PackPrimaryPhasesTestConsts::k_Resolution;
+    double difference = 0.0;
+    double goal = 0.0;
+    for(size_t i = 1; i < numFeatures; i++)
+    {
+      difference += std::fabs(counts[i] * cellVolume - volumes->getValue(i));
+      goal += volumes->getValue(i);
+    }
+    DREAM3D_REQUIRE(goal > 0.0)
+    return static_cast<float>(difference / goal);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestParallelPackingQuality()
+  {
+    float serialError = PackingError(PackFeatures(false));
+
+    // The slabs do not depend on the number of threads, so a seed always gives the same packing
+    DataContainerArray::Pointer parallel = PackFeatures(true);
+    DataContainerArray::Pointer repeated = PackFeatures(true);
+    Int32ArrayType::Pointer featureIds = GetFeatureIds(parallel);
+    Int32ArrayType::Pointer repeatedIds = GetFeatureIds(repeated);
+    DREAM3D_REQUIRE_EQUAL(featureIds->getNumberOfTuples(), repeatedIds->getNumberOfTuples())
+    for(size_t i = 0; i < featureIds->getNumberOfTuples(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(featureIds->getValue(i), repeatedIds->getValue(i))
+    }
+
+    // The slab chains only accept moves on the filling criterion, so they may pack a little differently
+    // than the serial chain, but not worse than a few percent of the goal volume
+    float parallelError = PackingError(parallel);
+    DREAM3D_REQUIRE(parallelError <= serialError + 0.05f)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestParallelPackingQuality())
+  }
+
+private:
+  PackPrimaryPhasesTest(const PackPrimaryPhasesTest&); // Copy Constructor Not Implemented
+  void operator=(const PackPrimaryPhasesTest&);        // Operator '=' Not Implemented
+};
@@ -0,0 +1,286 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/PackingDistribution.hpp"
+
+class PackingDistributionTest
+{
+public:
+  PackingDistributionTest()
+  {
+  }
+  virtual ~PackingDistributionTest()
+  {
+  }
+  SIMPL_TYPE_MACRO(PackingDistributionTest)
+
+  // -----------------------------------------------------------------------------
+  // Builds a goal distribution over all rows that sums to one, with a few empty bins
+  // -----------------------------------------------------------------------------
+  std::vector<std::vector<float>> CreateGoal(size_t numRows, size_t numColumns, std::mt19937& generator)
+  {
+    std::uniform_real_distribution<float> valueDistribution(0.0f, 1.0f);
+    std::vector<std::vector<float>> goal(numRows, std::vector<float>(numColumns, 0.0f));
+    float total = 0.0f;
+    for(size_t i = 0; i < numRows; i++)
+    {
+      for(size_t j = 0; j < numColumns; j++)
+      {
+        float value = valueDistribution(generator);
+        goal[i][j] = (value < 0.2f) ? 0.0f : value;
+        total = total + goal[i][j];
+      }
+    }
+    for(size_t i = 0; i < numRows; i++)
+    {
+      for(size_t j = 0; j < numColumns; j++)
+      {
+        goal[i][j] = goal[i][j] / total;
+      }
+    }
+    return goal;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The comparison of compare_1Ddistributions, which normalizes both arrays before comparing them
+  // -----------------------------------------------------------------------------
+  float Compare1DDistributions(const std::vector<float>& array1, const std::vector<float>& array2)
+  {
+    float bhattdist = 0.0f;
+    float sum_array1 = 0.0f;
+    float sum_array2 = 0.0f;
+    for(size_t i = 0; i < array1.size(); i++)
+    {
+      sum_array1 = sum_array1 + array1[i];
+      sum_array2 = sum_array2 + array2[i];
+    }
+    if(sum_array1 == 0.0f)
+    {
+      return 0.0f;
+    }
+    for(size_t i = 0; i < array1.size(); i++)
+    {
+      bhattdist = bhattdist + sqrtf((array1[i] / sum_array1) * (array2[i] / sum_array2));
+    }
+    return bhattdist;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The full rescan the filters made before the distributions were kept incrementally: every row of the histogram
+  // is normalized by its count, the filled rows are weighted equally and the result is compared bin by bin with
+  // the goal, as compare_3Ddistributions does. An empty histogram has no distance.
+  // -----------------------------------------------------------------------------
+  float NormalizeAndCompare(const std::vector<std::vector<int32_t>>& counts, const std::vector<std::vector<float>>& goal)
+  {
+    std::vector<std::vector<float>> simDist(counts.size());
+    float runningtotal = 0.0f;
+    for(size_t i = 0; i < counts.size(); i++)
+    {
+      simDist[i].assign(counts[i].size(), 0.0f);
+      int32_t count = 0;
+      for(size_t j = 0; j < counts[i].size(); j++)
+      {
+        count = count + counts[i][j];
+      }
+      if(count == 0)
+      {
+        continue;
+      }
+      float oneOverCount = 1.0f / static_cast<float>(count);
+      for(size_t j = 0; j < counts[i].size(); j++)
+      {
+        simDist[i][j] = static_cast<float>(counts[i][j]) * oneOverCount;
+        runningtotal = runningtotal + simDist[i][j];
+      }
+    }
+    if(runningtotal == 0.0f)
+    {
+      return 0.0f;
+    }
+
+    runningtotal = 1.0f / runningtotal;
+    float bhattdist = 0.0f;
+    for(size_t i = 0; i < simDist.size(); i++)
+    {
+      for(size_t j = 0; j < simDist[i].size(); j++)
+      {
+        bhattdist = bhattdist + sqrtf((simDist[i][j] * runningtotal) * goal[i][j]);
+      }
+    }
+    return bhattdist;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void CompareToReference(const PackingDistribution& distribution, const std::vector<std::vector<int32_t>>& counts, const std::vector<std::vector<float>>& goal)
+  {
+    float bhattdist = distribution.bhattacharyyaDistance();
+    float reference = NormalizeAndCompare(counts, goal);
+    DREAM3D_REQUIRED(std::fabs(bhattdist - reference), <=, 1.0e-5f)
+    if(counts.size() == 1)
+    {
+      std::vector<float> simDist(counts[0].begin(), counts[0].end());
+      DREAM3D_REQUIRED(std::fabs(bhattdist - Compare1DDistributions(simDist, goal[0])), <=, 1.0e-5f)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Adds, removes and moves Features in random order, the way the packing filters bin their Features, and checks
+  // the distance against the full rescan after every change. With few Features the rows keep emptying and filling.
+  // -----------------------------------------------------------------------------
+  void RunRandomOperations(size_t numRows, size_t numColumns, size_t maxFeatures, uint32_t seed)
+  {
+    std::mt19937 generator(seed);
+    std::vector<std::vector<float>> goal = CreateGoal(numRows, numColumns, generator);
+    std::vector<float> flatGoal;
+    for(size_t i = 0; i < numRows; i++)
+    {
+      flatGoal.insert(flatGoal.end(), goal[i].begin(), goal[i].end());
+    }
+
+    PackingDistribution distribution;
+    distribution.initialize(numRows, numColumns, flatGoal);
+    DREAM3D_REQUIRE_EQUAL(distribution.getNumColumns(), numColumns)
+
+    std::vector<std::vector<int32_t>> counts(numRows, std::vector<int32_t>(numColumns, 0));
+    std::vector<size_t> featureBins;
+    CompareToReference(distribution, counts, goal);
+
+    std::uniform_int_distribution<size_t> binDistribution(0, numRows * numColumns - 1);
+    std::uniform_int_distribution<int32_t> operationDistribution(0, 3);
+    for(int32_t step = 0; step < 20000; step++)
+    {
+      int32_t operation = operationDistribution(generator);
+      size_t bin = binDistribution(generator);
+      if(featureBins.empty() == true || (operation == 0 && featureBins.size() < maxFeatures))
+      {
+        // Add a Feature
+        distribution.add(bin, 1);
+        counts[bin / numColumns][bin % numColumns]++;
+        featureBins.push_back(bin);
+      }
+      else if(operation == 1)
+      {
+        // Remove a Feature
+        size_t feature = bin % featureBins.size();
+        size_t oldBin = featureBins[feature];
+        distribution.add(oldBin, -1);
+        counts[oldBin / numColumns][oldBin % numColumns]--;
+        featureBins[feature] = featureBins.back();
+        featureBins.pop_back();
+      }
+      else if(operation == 2)
+      {
+        // Move a Feature to a new bin of its row, as a changed neighborhood does
+        size_t feature = bin % featureBins.size();
+        size_t oldBin = featureBins[feature];
+        size_t newBin = (oldBin / numColumns) * numColumns + bin % numColumns;
+        distribution.add(oldBin, -1);
+        distribution.add(newBin, 1);
+        counts[oldBin / numColumns][oldBin % numColumns]--;
+        counts[newBin / numColumns][newBin % numColumns]++;
+        featureBins[feature] = newBin;
+      }
+      else
+      {
+        // Check a candidate Feature and take it out again
+        distribution.add(bin, 1);
+        counts[bin / numColumns][bin % numColumns]++;
+        CompareToReference(distribution, counts, goal);
+        distribution.add(bin, -1);
+        counts[bin / numColumns][bin % numColumns]--;
+      }
+      CompareToReference(distribution, counts, goal);
+    }
+
+    // Emptying the distribution leaves no distance, and refilling it starts from scratch
+    distribution.clear();
+    counts.assign(numRows, std::vector<int32_t>(numColumns, 0));
+    DREAM3D_REQUIRE_EQUAL(distribution.bhattacharyyaDistance(), 0.0f)
+    for(size_t i = 0; i < featureBins.size(); i++)
+    {
+      distribution.add(featureBins[i], 1);
+      counts[featureBins[i] / numColumns][featureBins[i] % numColumns]++;
+    }
+    CompareToReference(distribution, counts, goal);
+  }
+
+  // -----------------------------------------------------------------------------
+  // A single row holds the Feature size distribution of a phase
+  // -----------------------------------------------------------------------------
+  int TestSizeDistribution()
+  {
+    RunRandomOperations(1, 40, 5, 5489u);
+    RunRandomOperations(1, 40, 500, 1234u);
+    RunRandomOperations(1, 1, 50, 42u);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // One row for each Feature size bin holds the neighbor distribution of a phase
+  // -----------------------------------------------------------------------------
+  int TestNeighborDistribution()
+  {
+    RunRandomOperations(7, 40, 10, 5489u);
+    RunRandomOperations(7, 40, 2000, 1234u);
+    RunRandomOperations(25, 3, 60, 42u);
+    return EXIT_SUCCESS;
+  }
+
+  /**
+  * @brief
+  */
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestSizeDistribution())
+    DREAM3D_REGISTER_TEST(TestNeighborDistribution())
+  }
+
+private:
+  PackingDistributionTest(const PackingDistributionTest&); // Copy Constructor Not Implemented
+  void operator=(const PackingDistributionTest&);          // Operator '=' Not Implemented
+};
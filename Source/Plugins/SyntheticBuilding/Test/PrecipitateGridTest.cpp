@@ -0,0 +1,291 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/PrecipitateGrid.hpp"
+
+class PrecipitateGridTest
+{
+public:
+  PrecipitateGridTest()
+  : m_RdfMin(2.0f)
+  , m_StepSize(0.5f)
+  , m_NumBins(16)
+  {
+    m_BoxSize[0] = 50.0f;
+    m_BoxSize[1] = 40.0f;
+    m_BoxSize[2] = 30.0f;
+  }
+  virtual ~PrecipitateGridTest()
+  {
+  }
+  SIMPL_TYPE_MACRO(PrecipitateGridTest)
+
+  // -----------------------------------------------------------------------------
+  // Sets up the bins the same way as the Insert Precipitate Phases filter: bin 0 holds the distances below the
+  // minimum, the target covers m_NumBins bins above it and the current distribution covers the whole box
+  // -----------------------------------------------------------------------------
+  void InitializeRDF()
+  {
+    float maxBoxDistance = sqrtf((m_BoxSize[0] * m_BoxSize[0]) + (m_BoxSize[1] * m_BoxSize[1]) + (m_BoxSize[2] * m_BoxSize[2]));
+    int32_t currentNumBins = static_cast<int32_t>(ceil((maxBoxDistance - m_RdfMin) / m_StepSize));
+    m_RdfRandom.resize(currentNumBins + 1);
+    for(size_t i = 0; i < m_RdfRandom.size(); i++)
+    {
+      m_RdfRandom[i] = 3.0f + 0.25f * static_cast<float>(i);
+    }
+    m_Rdf.assign(currentNumBins + 1, 0.0f);
+    m_RdfNorm.resize(m_Rdf.size());
+    for(size_t i = 0; i < m_Rdf.size(); i++)
+    {
+      m_RdfNorm[i] = m_Rdf[i] / m_RdfRandom[i];
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // The distribution the filter computed before the grid: every ordered pair of Features of the same phase,
+  // found by looking at all the other Features
+  // -----------------------------------------------------------------------------
+  std::vector<float> RescanRDF()
+  {
+    std::vector<float> rdf(m_Rdf.size(), 0.0f);
+    size_t numFeatures = m_Phases.size();
+    for(size_t gnum = 1; gnum < numFeatures; gnum++)
+    {
+      float x = m_Centroids[3 * gnum];
+      float y = m_Centroids[3 * gnum + 1];
+      float z = m_Centroids[3 * gnum + 2];
+      for(size_t n = 1; n < numFeatures; n++)
+      {
+        if(m_Phases[n] != m_Phases[gnum] || n == gnum)
+        {
+          continue;
+        }
+        float xn = m_Centroids[3 * n];
+        float yn = m_Centroids[3 * n + 1];
+        float zn = m_Centroids[3 * n + 2];
+        float r = sqrtf((x - xn) * (x - xn) + (y - yn) * (y - yn) + (z - zn) * (z - zn));
+        int32_t rdfBin = (r - m_RdfMin) / m_StepSize;
+        if(r < m_RdfMin)
+        {
+          rdfBin = -1;
+        }
+        rdf[rdfBin + 1] += 1.0f;
+      }
+    }
+    return rdf;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The bins up to the maximum distance of the target are the ones that get compared to the target
+  // -----------------------------------------------------------------------------
+  void CompareToRescan()
+  {
+    std::vector<float> rescan = RescanRDF();
+    for(int32_t i = 0; i <= m_NumBins; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(m_Rdf[i], rescan[i])
+      DREAM3D_REQUIRE_EQUAL(m_RdfNorm[i], rescan[i] / m_RdfRandom[i])
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void AccumulateRDF(const PrecipitateGrid& grid, int32_t gnum, float increment)
+  {
+    grid.accumulateRDF(gnum, m_Centroids.data(), m_Phases.data(), m_RdfMin, m_StepSize, m_NumBins, increment, m_RdfRandom, m_Rdf, m_RdfNorm);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void AddFeature(float x, float y, float z, int32_t phase)
+  {
+    m_Centroids.push_back(x);
+    m_Centroids.push_back(y);
+    m_Centroids.push_back(z);
+    m_Phases.push_back(phase);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestPlaceAndMovePrecipitates()
+  {
+    std::mt19937 generator(5489u);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    std::uniform_int_distribution<int32_t> phaseDistribution(2, 3);
+
+    float rdfMax = m_RdfMin + m_NumBins * m_StepSize;
+    float cutoff = rdfMax + m_StepSize;
+
+    // Feature 0 is not a precipitate and never goes into the grid
+    m_Centroids.clear();
+    m_Phases.clear();
+    AddFeature(0.0f, 0.0f, 0.0f, 0);
+    for(int32_t i = 0; i < 300; i++)
+    {
+      AddFeature(m_BoxSize[0] * distribution(generator), m_BoxSize[1] * distribution(generator), m_BoxSize[2] * distribution(generator), phaseDistribution(generator));
+    }
+
+    // A phase of Features placed right on a cell boundary, with neighbors just inside and exactly at the
+    // maximum distance of the target across that boundary
+    int32_t boundaryFeature = static_cast<int32_t>(m_Phases.size());
+    AddFeature(cutoff, 12.0f, 12.0f, 4);
+    AddFeature(cutoff - rdfMax * 0.999f, 12.0f, 12.0f, 4);
+    AddFeature(cutoff + rdfMax, 12.0f, 12.0f, 4);
+    AddFeature(cutoff, 12.0f, 12.0f + rdfMax * 0.999f, 4);
+    AddFeature(cutoff, 12.0f - rdfMax, 12.0f, 4);
+
+    size_t numFeatures = m_Phases.size();
+    PrecipitateGrid grid;
+    DREAM3D_REQUIRE(grid.isEmpty())
+    grid.initialize(m_BoxSize, cutoff, numFeatures);
+    DREAM3D_REQUIRE(grid.isEmpty() == false)
+    DREAM3D_REQUIRE_EQUAL(grid.getCellSize(), cutoff)
+    for(size_t n = 1; n < numFeatures; n++)
+    {
+      grid.update(static_cast<int32_t>(n), m_Centroids.data() + 3 * n);
+    }
+
+    int64_t cell[3] = {0, 0, 0};
+    int64_t neighborCell[3] = {0, 0, 0};
+    grid.findCell(m_Centroids.data() + 3 * boundaryFeature, cell);
+    grid.findCell(m_Centroids.data() + 3 * (boundaryFeature + 1), neighborCell);
+    DREAM3D_REQUIRE_EQUAL(cell[0], 1)
+    DREAM3D_REQUIRE_EQUAL(neighborCell[0], 0)
+
+    InitializeRDF();
+    for(size_t n = 1; n < numFeatures; n++)
+    {
+      AccumulateRDF(grid, static_cast<int32_t>(n), 1.0f);
+    }
+    CompareToRescan();
+
+    // Move precipitates the way the filter does: remove it from the distribution, move it, add it back, and
+    // sometimes move it back again. Some moves land exactly on cell boundaries.
+    std::uniform_int_distribution<int32_t> featureDistribution(1, static_cast<int32_t>(numFeatures) - 1);
+    std::uniform_int_distribution<int32_t> cellDistribution(0, 5);
+    for(int32_t move = 0; move < 2000; move++)
+    {
+      int32_t gnum = featureDistribution(generator);
+      float oldCentroid[3] = {m_Centroids[3 * gnum], m_Centroids[3 * gnum + 1], m_Centroids[3 * gnum + 2]};
+      float newCentroid[3] = {0.0f, 0.0f, 0.0f};
+      for(int32_t d = 0; d < 3; d++)
+      {
+        newCentroid[d] = (move % 5 == 0) ? std::min(cutoff * cellDistribution(generator), m_BoxSize[d]) : m_BoxSize[d] * distribution(generator);
+      }
+
+      AccumulateRDF(grid, gnum, -2.0f);
+      for(int32_t d = 0; d < 3; d++)
+      {
+        m_Centroids[3 * gnum + d] = newCentroid[d];
+      }
+      grid.update(gnum, m_Centroids.data() + 3 * gnum);
+      AccumulateRDF(grid, gnum, 2.0f);
+
+      if(move % 3 == 0)
+      {
+        AccumulateRDF(grid, gnum, -2.0f);
+        for(int32_t d = 0; d < 3; d++)
+        {
+          m_Centroids[3 * gnum + d] = oldCentroid[d];
+        }
+        grid.update(gnum, m_Centroids.data() + 3 * gnum);
+        AccumulateRDF(grid, gnum, 2.0f);
+      }
+
+      if(move % 100 == 0)
+      {
+        CompareToRescan();
+      }
+    }
+    CompareToRescan();
+
+    // Every Feature but the first has to be in exactly one cell
+    std::vector<int32_t> visits(numFeatures, 0);
+    float everywhere[3] = {0.0f, 0.0f, 0.0f};
+    grid.clear();
+    DREAM3D_REQUIRE(grid.isEmpty())
+    float hugeCutoff = m_BoxSize[0] + m_BoxSize[1] + m_BoxSize[2];
+    grid.initialize(m_BoxSize, hugeCutoff, numFeatures);
+    for(size_t n = 1; n < numFeatures; n++)
+    {
+      grid.update(static_cast<int32_t>(n), m_Centroids.data() + 3 * n);
+    }
+    grid.forEachNeighbor(everywhere, [&](int32_t n) { visits[n]++; });
+    DREAM3D_REQUIRE_EQUAL(visits[0], 0)
+    for(size_t n = 1; n < numFeatures; n++)
+    {
+      DREAM3D_REQUIRE_EQUAL(visits[n], 1)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  /**
+  * @brief
+  */
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestPlaceAndMovePrecipitates())
+  }
+
+private:
+  float m_BoxSize[3];
+  float m_RdfMin;
+  float m_StepSize;
+  int32_t m_NumBins;
+  std::vector<float> m_Centroids;
+  std::vector<int32_t> m_Phases;
+  std::vector<float> m_RdfRandom;
+  std::vector<float> m_Rdf;
+  std::vector<float> m_RdfNorm;
+
+  PrecipitateGridTest(const PrecipitateGridTest&); // Copy Constructor Not Implemented
+  void operator=(const PrecipitateGridTest&);      // Operator '=' Not Implemented
+};